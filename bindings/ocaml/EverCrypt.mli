@@ -9,6 +9,7 @@ module Error : sig
     | AuthenticationFailure
     | InvalidIVLength
     | DecodeError
+    | MaximumLengthExceeded
   type 'a result =
     | Success of 'a
     | Error of error_code
@@ -70,6 +70,7 @@ typedef uint8_t Spec_Agile_AEAD_alg;
 #define EverCrypt_Error_AuthenticationFailure 3
 #define EverCrypt_Error_InvalidIVLength 4
 #define EverCrypt_Error_DecodeError 5
+#define EverCrypt_Error_MaximumLengthExceeded 6
 
 typedef uint8_t EverCrypt_Error_error_code;
 
@@ -414,6 +415,16 @@ extern Spec_Agile_AEAD_alg EverCrypt_AEAD_alg_of_state(EverCrypt_AEAD_state_s *a
 extern EverCrypt_Error_error_code
 EverCrypt_AEAD_create_in(Spec_Agile_AEAD_alg a, EverCrypt_AEAD_state_s **r, uint8_t *dst);
 
+extern uint32_t EverCrypt_AEAD_state_size(Spec_Agile_AEAD_alg a);
+
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_init_in_place(
+  Spec_Agile_AEAD_alg a,
+  uint8_t *mem,
+  uint8_t *k,
+  EverCrypt_AEAD_state_s **dst
+);
+
 extern EverCrypt_Error_error_code
 EverCrypt_AEAD_encrypt(
   EverCrypt_AEAD_state_s *a,
@@ -546,6 +557,82 @@ EverCrypt_AEAD_decrypt_expand(
   uint8_t *dst
 );
 
+typedef struct EverCrypt_AEAD_record_s_s EverCrypt_AEAD_record_s;
+
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_record_create_in(
+  Spec_Agile_AEAD_alg a,
+  EverCrypt_AEAD_record_s **dst,
+  uint8_t *k,
+  uint8_t *static_iv
+);
+
+extern uint64_t EverCrypt_AEAD_record_next_seq(EverCrypt_AEAD_record_s *r);
+
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_next(
+  EverCrypt_AEAD_record_s *r,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst
+);
+
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **plain,
+  uint32_t *plain_len,
+  uint8_t **cipher,
+  uint8_t **tag
+);
+
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **cipher,
+  uint32_t *cipher_len,
+  uint8_t **tag,
+  uint8_t **dst,
+  EverCrypt_Error_error_code *res
+);
+
+extern void EverCrypt_AEAD_record_free(EverCrypt_AEAD_record_s *r);
+
 extern void EverCrypt_AEAD_free(EverCrypt_AEAD_state_s *a);
 
 extern bool EverCrypt_AutoConfig2_has_shaext();
@@ -1131,6 +1218,17 @@ EverCrypt_Cipher_chacha20(
   uint32_t ctr
 );
 
+extern void
+EverCrypt_Cipher_chacha20_multi(
+  uint32_t num,
+  uint32_t *len,
+  uint8_t **dst,
+  uint8_t **src,
+  uint8_t **key,
+  uint8_t **iv,
+  uint32_t *ctr
+);
+
 extern void
 EverCrypt_Poly1305_poly1305(uint8_t *dst, uint8_t *src, uint32_t len, uint8_t *key);
 
@@ -1158,6 +1256,33 @@ EverCrypt_Chacha20Poly1305_aead_decrypt(
   uint8_t *tag
 );
 
+extern void
+EverCrypt_Chacha20Poly1305_aead_encrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+);
+
+extern uint32_t
+EverCrypt_Chacha20Poly1305_aead_decrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+);
+
 extern void EverCrypt_Curve25519_secret_to_public(uint8_t *pub, uint8_t *priv);
 
 extern void
@@ -66,6 +66,14 @@ Spec_Agile_AEAD_alg EverCrypt_AEAD_alg_of_state(EverCrypt_AEAD_state_s *s)
       {
         return Spec_Agile_AEAD_AES256_GCM;
       }
+    case Spec_Cipher_Expansion_Hacl_AES128:
+      {
+        return Spec_Agile_AEAD_AES128_GCM;
+      }
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        return Spec_Agile_AEAD_AES256_GCM;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -74,94 +82,195 @@ Spec_Agile_AEAD_alg EverCrypt_AEAD_alg_of_state(EverCrypt_AEAD_state_s *s)
   }
 }
 
-static EverCrypt_Error_error_code
-create_in_chacha20_poly1305(EverCrypt_AEAD_state_s **dst, uint8_t *k)
+static uint32_t aes_ct_rounds(Spec_Cipher_Expansion_impl impl)
 {
-  uint8_t *ek = KRML_HOST_CALLOC((uint32_t)32U, sizeof (uint8_t));
-  KRML_CHECK_SIZE(sizeof (EverCrypt_AEAD_state_s), (uint32_t)1U);
-  EverCrypt_AEAD_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_state_s));
-  p[0U] = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_Hacl_CHACHA20, .ek = ek });
-  memcpy(ek, k, (uint32_t)32U * sizeof (uint8_t));
-  dst[0U] = p;
-  return EverCrypt_Error_Success;
+  if (impl == Spec_Cipher_Expansion_Hacl_AES128)
+  {
+    return (uint32_t)10U;
+  }
+  return (uint32_t)14U;
 }
 
-static EverCrypt_Error_error_code
-create_in_aes128_gcm(EverCrypt_AEAD_state_s **dst, uint8_t *k)
+/* The implementation that create_in and init_in_place pick for a on this CPU:
+   Vale AES-GCM when AES-NI and PCLMULQDQ are available, and otherwise the
+   bitsliced, constant-time AES-GCM, for CPUs without them. */
+static Spec_Cipher_Expansion_impl impl_of_alg(Spec_Agile_AEAD_alg a)
 {
   bool has_aesni = EverCrypt_AutoConfig2_has_aesni();
   bool has_pclmulqdq = EverCrypt_AutoConfig2_has_pclmulqdq();
   bool has_avx = EverCrypt_AutoConfig2_has_avx();
   bool has_sse = EverCrypt_AutoConfig2_has_sse();
   bool has_movbe = EverCrypt_AutoConfig2_has_movbe();
+  bool vale = false;
   #if EVERCRYPT_TARGETCONFIG_X64
-  if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
+  vale = has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe;
+  #endif
+  if (a == Spec_Agile_AEAD_CHACHA20_POLY1305)
   {
-    uint8_t *ek = KRML_HOST_CALLOC((uint32_t)480U, sizeof (uint8_t));
-    uint8_t *keys_b = ek;
-    uint8_t *hkeys_b = ek + (uint32_t)176U;
-    uint64_t scrut = aes128_key_expansion(k, keys_b);
-    uint64_t scrut0 = aes128_keyhash_init(keys_b, hkeys_b);
-    KRML_CHECK_SIZE(sizeof (EverCrypt_AEAD_state_s), (uint32_t)1U);
-    EverCrypt_AEAD_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_state_s));
-    p[0U] = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_Vale_AES128, .ek = ek });
-    *dst = p;
-    return EverCrypt_Error_Success;
+    return Spec_Cipher_Expansion_Hacl_CHACHA20;
   }
-  #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  if (a == Spec_Agile_AEAD_AES128_GCM)
+  {
+    if (vale)
+    {
+      return Spec_Cipher_Expansion_Vale_AES128;
+    }
+    return Spec_Cipher_Expansion_Hacl_AES128;
+  }
+  if (vale)
+  {
+    return Spec_Cipher_Expansion_Vale_AES256;
+  }
+  return Spec_Cipher_Expansion_Hacl_AES256;
 }
 
-static EverCrypt_Error_error_code
-create_in_aes256_gcm(EverCrypt_AEAD_state_s **dst, uint8_t *k)
+/* The length of the expanded key. For Vale, the round keys then the powers of
+   H; for the bitsliced AES, the bitsliced round keys then H. */
+static uint32_t ek_len(Spec_Cipher_Expansion_impl impl)
 {
-  bool has_aesni = EverCrypt_AutoConfig2_has_aesni();
-  bool has_pclmulqdq = EverCrypt_AutoConfig2_has_pclmulqdq();
-  bool has_avx = EverCrypt_AutoConfig2_has_avx();
-  bool has_sse = EverCrypt_AutoConfig2_has_sse();
-  bool has_movbe = EverCrypt_AutoConfig2_has_movbe();
-  #if EVERCRYPT_TARGETCONFIG_X64
-  if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
+  switch (impl)
   {
-    uint8_t *ek = KRML_HOST_CALLOC((uint32_t)544U, sizeof (uint8_t));
-    uint8_t *keys_b = ek;
-    uint8_t *hkeys_b = ek + (uint32_t)240U;
-    uint64_t scrut = aes256_key_expansion(k, keys_b);
-    uint64_t scrut0 = aes256_keyhash_init(keys_b, hkeys_b);
-    KRML_CHECK_SIZE(sizeof (EverCrypt_AEAD_state_s), (uint32_t)1U);
-    EverCrypt_AEAD_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_state_s));
-    p[0U] = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_Vale_AES256, .ek = ek });
-    *dst = p;
-    return EverCrypt_Error_Success;
+    case Spec_Cipher_Expansion_Hacl_CHACHA20:
+      {
+        return (uint32_t)32U;
+      }
+    case Spec_Cipher_Expansion_Vale_AES128:
+      {
+        return (uint32_t)480U;
+      }
+    case Spec_Cipher_Expansion_Vale_AES256:
+      {
+        return (uint32_t)544U;
+      }
+    default:
+      {
+        return (aes_ct_rounds(impl) + (uint32_t)1U) * (uint32_t)64U + (uint32_t)16U;
+      }
   }
-  #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+}
+
+static void expand(Spec_Cipher_Expansion_impl impl, uint8_t *ek, uint8_t *k)
+{
+  switch (impl)
+  {
+    case Spec_Cipher_Expansion_Hacl_CHACHA20:
+      {
+        memcpy(ek, k, (uint32_t)32U * sizeof (uint8_t));
+        break;
+      }
+    #if EVERCRYPT_TARGETCONFIG_X64
+    case Spec_Cipher_Expansion_Vale_AES128:
+      {
+        uint64_t scrut = aes128_key_expansion(k, ek);
+        uint64_t scrut0 = aes128_keyhash_init(ek, ek + (uint32_t)176U);
+        break;
+      }
+    case Spec_Cipher_Expansion_Vale_AES256:
+      {
+        uint64_t scrut = aes256_key_expansion(k, ek);
+        uint64_t scrut0 = aes256_keyhash_init(ek, ek + (uint32_t)240U);
+        break;
+      }
+    #endif
+    default:
+      {
+        uint32_t nr = aes_ct_rounds(impl);
+        uint32_t skey_len = (nr + (uint32_t)1U) * (uint32_t)64U;
+        uint64_t *skey = (uint64_t *)ek;
+        if (impl == Spec_Cipher_Expansion_Hacl_AES128)
+        {
+          Hacl_AES_Bitslice_aes128_key_expansion(skey, k);
+        }
+        else
+        {
+          Hacl_AES_Bitslice_aes256_key_expansion(skey, k);
+        }
+        uint8_t zero[16U] = { 0U };
+        Hacl_AES_Bitslice_ctr(nr, skey, zero, (uint32_t)0U, (uint32_t)16U, ek + skey_len, zero);
+      }
+  }
+}
+
+static bool is_supported_alg(Spec_Agile_AEAD_alg a)
+{
+  return
+    a == Spec_Agile_AEAD_AES128_GCM
+    || a == Spec_Agile_AEAD_AES256_GCM
+    || a == Spec_Agile_AEAD_CHACHA20_POLY1305;
 }
 
 EverCrypt_Error_error_code
 EverCrypt_AEAD_create_in(Spec_Agile_AEAD_alg a, EverCrypt_AEAD_state_s **dst, uint8_t *k)
+{
+  if (!is_supported_alg(a))
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  Spec_Cipher_Expansion_impl impl = impl_of_alg(a);
+  uint8_t *ek = KRML_HOST_CALLOC(ek_len(impl), sizeof (uint8_t));
+  expand(impl, ek, k);
+  KRML_CHECK_SIZE(sizeof (EverCrypt_AEAD_state_s), (uint32_t)1U);
+  EverCrypt_AEAD_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_state_s));
+  p[0U] = ((EverCrypt_AEAD_state_s){ .impl = impl, .ek = ek });
+  *dst = p;
+  return EverCrypt_Error_Success;
+}
+
+/* In caller-owned memory, the expanded key follows the state, at an offset
+   that keeps it 16-byte aligned. */
+static uint32_t state_hdr_len(void)
+{
+  return ((uint32_t)sizeof (EverCrypt_AEAD_state_s) + (uint32_t)15U) & ~(uint32_t)15U;
+}
+
+uint32_t EverCrypt_AEAD_state_size(Spec_Agile_AEAD_alg a)
 {
   switch (a)
   {
     case Spec_Agile_AEAD_AES128_GCM:
       {
-        return create_in_aes128_gcm(dst, k);
+        return state_hdr_len() + ek_len(Spec_Cipher_Expansion_Hacl_AES128);
       }
     case Spec_Agile_AEAD_AES256_GCM:
       {
-        return create_in_aes256_gcm(dst, k);
+        return state_hdr_len() + ek_len(Spec_Cipher_Expansion_Hacl_AES256);
       }
     case Spec_Agile_AEAD_CHACHA20_POLY1305:
       {
-        return create_in_chacha20_poly1305(dst, k);
+        return state_hdr_len() + ek_len(Spec_Cipher_Expansion_Hacl_CHACHA20);
       }
     default:
       {
-        return EverCrypt_Error_UnsupportedAlgorithm;
+        return (uint32_t)0U;
       }
   }
 }
 
+EverCrypt_Error_error_code
+EverCrypt_AEAD_init_in_place(
+  Spec_Agile_AEAD_alg a,
+  uint8_t *mem,
+  uint8_t *k,
+  EverCrypt_AEAD_state_s **dst
+)
+{
+  if (!is_supported_alg(a))
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  if ((uintptr_t)mem % (uintptr_t)16U != (uintptr_t)0U)
+  {
+    return EverCrypt_Error_InvalidKey;
+  }
+  Spec_Cipher_Expansion_impl impl = impl_of_alg(a);
+  EverCrypt_AEAD_state_s *p = (EverCrypt_AEAD_state_s *)mem;
+  uint8_t *ek = mem + state_hdr_len();
+  expand(impl, ek, k);
+  p[0U] = ((EverCrypt_AEAD_state_s){ .impl = impl, .ek = ek });
+  *dst = p;
+  return EverCrypt_Error_Success;
+}
+
 static EverCrypt_Error_error_code
 encrypt_aes128_gcm(
   EverCrypt_AEAD_state_s *s,
@@ -449,6 +558,23 @@ EverCrypt_AEAD_encrypt(
         EverCrypt_Chacha20Poly1305_aead_encrypt(ek, iv, ad_len, ad, plain_len, plain, cipher, tag);
         return EverCrypt_Error_Success;
       }
+    case Spec_Cipher_Expansion_Hacl_AES128:
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        /* The bitsliced implementation goes through the streaming engine. */
+        EverCrypt_AEAD_iovec ad_v = { .base = ad, .len = ad_len };
+        EverCrypt_AEAD_iovec plain_v = { .base = plain, .len = plain_len };
+        return
+          EverCrypt_AEAD_encrypt_iov(s,
+            iv,
+            iv_len,
+            &ad_v,
+            (uint32_t)1U,
+            &plain_v,
+            (uint32_t)1U,
+            &cipher,
+            tag);
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -457,6 +583,27 @@ EverCrypt_AEAD_encrypt(
   }
 }
 
+static EverCrypt_Error_error_code
+encrypt_expand_aes_gcm_ct(
+  Spec_Cipher_Expansion_impl impl,
+  uint8_t *k,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  uint64_t ek[122U] = { 0U };
+  expand(impl, (uint8_t *)ek, k);
+  EverCrypt_AEAD_state_s p = { .impl = impl, .ek = (uint8_t *)ek };
+  EverCrypt_AEAD_state_s *s = &p;
+  return EverCrypt_AEAD_encrypt(s, iv, iv_len, ad, ad_len, plain, plain_len, cipher, tag);
+}
+
 EverCrypt_Error_error_code
 EverCrypt_AEAD_encrypt_expand_aes128_gcm(
   uint8_t *k,
@@ -593,7 +740,17 @@ EverCrypt_AEAD_encrypt_expand_aes128_gcm(
     return EverCrypt_Error_Success;
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  return
+    encrypt_expand_aes_gcm_ct(Spec_Cipher_Expansion_Hacl_AES128,
+      k,
+      iv,
+      iv_len,
+      ad,
+      ad_len,
+      plain,
+      plain_len,
+      cipher,
+      tag);
 }
 
 EverCrypt_Error_error_code
@@ -732,7 +889,17 @@ EverCrypt_AEAD_encrypt_expand_aes256_gcm(
     return EverCrypt_Error_Success;
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  return
+    encrypt_expand_aes_gcm_ct(Spec_Cipher_Expansion_Hacl_AES256,
+      k,
+      iv,
+      iv_len,
+      ad,
+      ad_len,
+      plain,
+      plain_len,
+      cipher,
+      tag);
 }
 
 EverCrypt_Error_error_code
@@ -1154,6 +1321,22 @@ EverCrypt_AEAD_decrypt(
       {
         return decrypt_chacha20_poly1305(s, iv, iv_len, ad, ad_len, cipher, cipher_len, tag, dst);
       }
+    case Spec_Cipher_Expansion_Hacl_AES128:
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        EverCrypt_AEAD_iovec ad_v = { .base = ad, .len = ad_len };
+        EverCrypt_AEAD_iovec cipher_v = { .base = cipher, .len = cipher_len };
+        return
+          EverCrypt_AEAD_decrypt_iov(s,
+            iv,
+            iv_len,
+            &ad_v,
+            (uint32_t)1U,
+            &cipher_v,
+            (uint32_t)1U,
+            tag,
+            &dst);
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -1162,6 +1345,27 @@ EverCrypt_AEAD_decrypt(
   }
 }
 
+static EverCrypt_Error_error_code
+decrypt_expand_aes_gcm_ct(
+  Spec_Cipher_Expansion_impl impl,
+  uint8_t *k,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst
+)
+{
+  uint64_t ek[122U] = { 0U };
+  expand(impl, (uint8_t *)ek, k);
+  EverCrypt_AEAD_state_s p = { .impl = impl, .ek = (uint8_t *)ek };
+  EverCrypt_AEAD_state_s *s = &p;
+  return EverCrypt_AEAD_decrypt(s, iv, iv_len, ad, ad_len, cipher, cipher_len, tag, dst);
+}
+
 EverCrypt_Error_error_code
 EverCrypt_AEAD_decrypt_expand_aes128_gcm(
   uint8_t *k,
@@ -1309,7 +1513,17 @@ EverCrypt_AEAD_decrypt_expand_aes128_gcm(
     }
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  return
+    decrypt_expand_aes_gcm_ct(Spec_Cipher_Expansion_Hacl_AES128,
+      k,
+      iv,
+      iv_len,
+      ad,
+      ad_len,
+      cipher,
+      cipher_len,
+      tag,
+      dst);
 }
 
 EverCrypt_Error_error_code
@@ -1459,7 +1673,17 @@ EverCrypt_AEAD_decrypt_expand_aes256_gcm(
     }
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  return
+    decrypt_expand_aes_gcm_ct(Spec_Cipher_Expansion_Hacl_AES256,
+      k,
+      iv,
+      iv_len,
+      ad,
+      ad_len,
+      cipher,
+      cipher_len,
+      tag,
+      dst);
 }
 
 EverCrypt_Error_error_code
@@ -1547,6 +1771,1324 @@ EverCrypt_AEAD_decrypt_expand(
   }
 }
 
+typedef struct EverCrypt_AEAD_stream_s_s
+{
+  void *mem;
+  EverCrypt_AEAD_state_s *key;
+  bool verified;
+  bool seek;
+  uint64_t released_len;
+  Spec_Cipher_Expansion_impl impl;
+  bool avx2;
+  bool avx;
+  uint8_t *ek;
+  uint8_t iv[16U];
+  uint32_t ctr;
+  uint8_t ks[512U];
+  uint32_t ks_len;
+  uint32_t ks_off;
+  uint8_t buf[16U];
+  uint32_t buf_len;
+  uint64_t ad_len;
+  uint64_t text_len;
+  uint8_t poly_key[32U];
+  union {
+    uint64_t case_poly32[25U];
+    Lib_IntVector_Intrinsics_vec128 case_poly128[25U];
+    #if EVERCRYPT_TARGETCONFIG_X64
+    Lib_IntVector_Intrinsics_vec256 case_poly256[25U];
+    #endif
+    Lib_IntVector_Intrinsics_vec128 case_gf128[9U];
+    struct
+    {
+      uint64_t ctx[4U];
+      #if EVERCRYPT_TARGETCONFIG_X64
+      Lib_IntVector_Intrinsics_vec256 tbl[36U];
+      #endif
+    }
+    case_gf128_ct;
+  }
+  auth;
+}
+EverCrypt_AEAD_stream_s;
+
+static bool stream_is_ct(EverCrypt_AEAD_stream_s *st)
+{
+  return
+    st->impl == Spec_Cipher_Expansion_Hacl_AES128 || st->impl == Spec_Cipher_Expansion_Hacl_AES256;
+}
+
+static uint32_t stream_block_len(EverCrypt_AEAD_stream_s *st)
+{
+  if (st->impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+  {
+    return (uint32_t)64U;
+  }
+  return (uint32_t)16U;
+}
+
+/* Encrypts len bytes (a multiple of the block length) with the keystream
+   blocks starting at st->ctr. */
+static void
+stream_cipher_blocks(EverCrypt_AEAD_stream_s *st, uint32_t len, uint8_t *dst, uint8_t *src)
+{
+  if (len == (uint32_t)0U)
+  {
+    return;
+  }
+  switch (st->impl)
+  {
+    case Spec_Cipher_Expansion_Hacl_CHACHA20:
+      {
+        #if EVERCRYPT_TARGETCONFIG_X64
+        if (st->avx2)
+        {
+          Hacl_Chacha20_Vec256_chacha20_encrypt_256(len, dst, src, st->ek, st->iv, st->ctr);
+          break;
+        }
+        if (st->avx)
+        {
+          Hacl_Chacha20_Vec128_chacha20_encrypt_128(len, dst, src, st->ek, st->iv, st->ctr);
+          break;
+        }
+        #endif
+        Hacl_Chacha20_chacha20_encrypt(len, dst, src, st->ek, st->iv, st->ctr);
+        break;
+      }
+    #if EVERCRYPT_TARGETCONFIG_X64
+    case Spec_Cipher_Expansion_Vale_AES128:
+    case Spec_Cipher_Expansion_Vale_AES256:
+      {
+        /* The counter block is kept byte-reversed, as in gctr128_bytes; its
+           low 32 bits are the first four bytes. */
+        uint8_t ctr_block[16U] = { 0U };
+        memcpy(ctr_block, st->iv, (uint32_t)16U * sizeof (uint8_t));
+        store32_le(ctr_block, load32_le(ctr_block) + st->ctr);
+        uint8_t inout_b[16U] = { 0U };
+        uint64_t num_blocks = (uint64_t)(len / (uint32_t)16U);
+        if (st->impl == Spec_Cipher_Expansion_Vale_AES128)
+        {
+          uint64_t
+          scrut = gctr128_bytes(src, (uint64_t)len, dst, inout_b, st->ek, ctr_block, num_blocks);
+        }
+        else
+        {
+          uint64_t
+          scrut = gctr256_bytes(src, (uint64_t)len, dst, inout_b, st->ek, ctr_block, num_blocks);
+        }
+        break;
+      }
+    #endif
+    case Spec_Cipher_Expansion_Hacl_AES128:
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        /* Here the counter block is J0, in the byte order of the spec. */
+        uint32_t nr = aes_ct_rounds(st->impl);
+        uint64_t *skey = (uint64_t *)st->ek;
+        #if EVERCRYPT_TARGETCONFIG_X64
+        if (st->avx2)
+        {
+          Hacl_AES_Bitslice_256_ctr(nr, skey, st->iv, st->ctr, len, dst, src);
+          break;
+        }
+        if (st->avx)
+        {
+          Hacl_AES_Bitslice_128_ctr(nr, skey, st->iv, st->ctr, len, dst, src);
+          break;
+        }
+        #endif
+        Hacl_AES_Bitslice_ctr(nr, skey, st->iv, st->ctr, len, dst, src);
+        break;
+      }
+    default:
+      {
+        KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
+        KRML_HOST_EXIT(253U);
+      }
+  }
+  st->ctr = st->ctr + len / stream_block_len(st);
+}
+
+static void
+stream_xor_ks(EverCrypt_AEAD_stream_s *st, uint32_t len, uint8_t *dst, uint8_t *src)
+{
+  uint8_t *ks = st->ks + st->ks_off;
+  uint32_t i = (uint32_t)0U;
+  for (; i + (uint32_t)8U <= len; i = i + (uint32_t)8U)
+  {
+    store64_le(dst + i, load64_le(src + i) ^ load64_le(ks + i));
+  }
+  for (; i < len; i++)
+  {
+    dst[i] = src[i] ^ ks[i];
+  }
+  st->ks_off = st->ks_off + len;
+}
+
+/* Xors len bytes with the keystream, starting with what is left of the
+   keystream buffer. Whole batches of the cipher kernel go straight to dst;
+   what remains is xored with a freshly generated batch, whose unused part
+   carries over to the next fragment. */
+static void
+stream_xor(EverCrypt_AEAD_stream_s *st, uint32_t len, uint8_t *dst, uint8_t *src)
+{
+  uint32_t n = st->ks_len - st->ks_off;
+  if (len < n)
+  {
+    n = len;
+  }
+  stream_xor_ks(st, n, dst, src);
+  uint32_t len0 = (len - n) / st->ks_len * st->ks_len;
+  stream_cipher_blocks(st, len0, dst + n, src + n);
+  uint32_t i = n + len0;
+  if (i < len)
+  {
+    memset(st->ks, 0U, st->ks_len * sizeof (uint8_t));
+    stream_cipher_blocks(st, st->ks_len, st->ks, st->ks);
+    st->ks_off = (uint32_t)0U;
+    stream_xor_ks(st, len - i, dst + i, src + i);
+  }
+}
+
+static void stream_auth_blocks(EverCrypt_AEAD_stream_s *st, uint32_t len, uint8_t *text)
+{
+  if (len == (uint32_t)0U)
+  {
+    return;
+  }
+  if (stream_is_ct(st))
+  {
+    #if EVERCRYPT_TARGETCONFIG_X64
+    if (st->avx2)
+    {
+      Hacl_Gf128_CT_256_gcm_update_blocks(st->auth.case_gf128_ct.ctx,
+        st->auth.case_gf128_ct.tbl,
+        len,
+        text);
+      return;
+    }
+    if (st->avx)
+    {
+      Hacl_Gf128_CT_128_gcm_update_blocks(st->auth.case_gf128_ct.ctx,
+        (Lib_IntVector_Intrinsics_vec128 *)st->auth.case_gf128_ct.tbl,
+        len,
+        text);
+      return;
+    }
+    #endif
+    Hacl_Gf128_CT_64_gcm_update_blocks(st->auth.case_gf128_ct.ctx, len, text);
+    return;
+  }
+  if (st->impl != Spec_Cipher_Expansion_Hacl_CHACHA20)
+  {
+    #if EVERCRYPT_TARGETCONFIG_X64
+    Hacl_Gf128_NI_gcm_update_blocks(st->auth.case_gf128, len, text);
+    #endif
+    return;
+  }
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (st->avx2)
+  {
+    Hacl_Poly1305_256_poly1305_update(st->auth.case_poly256, len, text);
+    return;
+  }
+  if (st->avx)
+  {
+    Hacl_Poly1305_128_poly1305_update(st->auth.case_poly128, len, text);
+    return;
+  }
+  #endif
+  Hacl_Poly1305_32_poly1305_update(st->auth.case_poly32, len, text);
+}
+
+/* Authenticates len bytes, buffering a partial block until the next call. */
+static void stream_auth(EverCrypt_AEAD_stream_s *st, uint32_t len, uint8_t *text)
+{
+  uint32_t i = (uint32_t)0U;
+  if (st->buf_len > (uint32_t)0U)
+  {
+    uint32_t n = (uint32_t)16U - st->buf_len;
+    if (len < n)
+    {
+      n = len;
+    }
+    memcpy(st->buf + st->buf_len, text, n * sizeof (uint8_t));
+    st->buf_len = st->buf_len + n;
+    i = n;
+    if (st->buf_len < (uint32_t)16U)
+    {
+      return;
+    }
+    stream_auth_blocks(st, (uint32_t)16U, st->buf);
+    st->buf_len = (uint32_t)0U;
+  }
+  uint32_t len0 = (len - i) / (uint32_t)16U * (uint32_t)16U;
+  stream_auth_blocks(st, len0, text + i);
+  i = i + len0;
+  memcpy(st->buf, text + i, (len - i) * sizeof (uint8_t));
+  st->buf_len = len - i;
+}
+
+/* Zero-pads the buffered partial block, at the end of the associated data and
+   of the text. */
+static void stream_auth_pad(EverCrypt_AEAD_stream_s *st)
+{
+  if (st->buf_len > (uint32_t)0U)
+  {
+    memset(st->buf + st->buf_len, 0U, ((uint32_t)16U - st->buf_len) * sizeof (uint8_t));
+    stream_auth_blocks(st, (uint32_t)16U, st->buf);
+    st->buf_len = (uint32_t)0U;
+  }
+}
+
+static EverCrypt_Error_error_code
+stream_init(EverCrypt_AEAD_stream_s *st, EverCrypt_AEAD_state_s *s, uint8_t *iv, uint32_t iv_len)
+{
+  if (s == NULL)
+  {
+    return EverCrypt_Error_InvalidKey;
+  }
+  EverCrypt_AEAD_state_s scrut = *s;
+  Spec_Cipher_Expansion_impl impl = scrut.impl;
+  uint8_t *ek = scrut.ek;
+  st->impl = impl;
+  st->avx2 = EverCrypt_AutoConfig2_has_avx2();
+  st->avx = EverCrypt_AutoConfig2_has_avx();
+  st->ek = ek;
+  st->buf_len = (uint32_t)0U;
+  st->ad_len = (uint64_t)0U;
+  st->text_len = (uint64_t)0U;
+  /* One batch of the widest cipher kernel: 8 ChaCha20 blocks with AVX2, 4 with
+     AVX, 8 AES blocks, and 16, 8 or 4 blocks of bitsliced AES. */
+  st->ks_len = stream_block_len(st);
+  if (impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+  {
+    if (st->avx2)
+    {
+      st->ks_len = (uint32_t)512U;
+    }
+    else if (st->avx)
+    {
+      st->ks_len = (uint32_t)256U;
+    }
+  }
+  else if (stream_is_ct(st))
+  {
+    st->ks_len = (uint32_t)64U;
+    #if EVERCRYPT_TARGETCONFIG_X64
+    if (st->avx2)
+    {
+      st->ks_len = (uint32_t)256U;
+    }
+    else if (st->avx)
+    {
+      st->ks_len = (uint32_t)128U;
+    }
+    #endif
+  }
+  else
+  {
+    st->ks_len = (uint32_t)128U;
+  }
+  st->ks_off = st->ks_len;
+  switch (impl)
+  {
+    case Spec_Cipher_Expansion_Hacl_CHACHA20:
+      {
+        if (iv_len != (uint32_t)12U)
+        {
+          return EverCrypt_Error_InvalidIVLength;
+        }
+        memcpy(st->iv, iv, (uint32_t)12U * sizeof (uint8_t));
+        uint8_t tmp[64U] = { 0U };
+        st->ctr = (uint32_t)0U;
+        stream_cipher_blocks(st, (uint32_t)64U, tmp, tmp);
+        memcpy(st->poly_key, tmp, (uint32_t)32U * sizeof (uint8_t));
+        #if EVERCRYPT_TARGETCONFIG_X64
+        if (st->avx2)
+        {
+          Hacl_Poly1305_256_poly1305_init(st->auth.case_poly256, st->poly_key);
+          return EverCrypt_Error_Success;
+        }
+        if (st->avx)
+        {
+          Hacl_Poly1305_128_poly1305_init(st->auth.case_poly128, st->poly_key);
+          return EverCrypt_Error_Success;
+        }
+        #endif
+        Hacl_Poly1305_32_poly1305_init(st->auth.case_poly32, st->poly_key);
+        return EverCrypt_Error_Success;
+      }
+    #if EVERCRYPT_TARGETCONFIG_X64
+    case Spec_Cipher_Expansion_Vale_AES128:
+    case Spec_Cipher_Expansion_Vale_AES256:
+      {
+        if (iv_len == (uint32_t)0U)
+        {
+          return EverCrypt_Error_InvalidIVLength;
+        }
+        uint8_t *hkeys_b;
+        if (impl == Spec_Cipher_Expansion_Vale_AES128)
+        {
+          hkeys_b = ek + (uint32_t)176U;
+        }
+        else
+        {
+          hkeys_b = ek + (uint32_t)240U;
+        }
+        uint8_t tmp_iv[16U] = { 0U };
+        uint32_t len = iv_len / (uint32_t)16U;
+        uint32_t bytes_len = len * (uint32_t)16U;
+        memcpy(tmp_iv, iv + bytes_len, iv_len % (uint32_t)16U * sizeof (uint8_t));
+        uint64_t
+        uu____0 = compute_iv_stdcall(iv, (uint64_t)iv_len, (uint64_t)len, tmp_iv, tmp_iv, hkeys_b);
+        /* H is the encryption of the zero block, i.e. of counter block 0 with
+           a zero IV. */
+        uint8_t h[16U] = { 0U };
+        memset(st->iv, 0U, (uint32_t)16U * sizeof (uint8_t));
+        st->ctr = (uint32_t)0U;
+        stream_cipher_blocks(st, (uint32_t)16U, h, h);
+        Hacl_Gf128_NI_gcm_init(st->auth.case_gf128, h);
+        memcpy(st->iv, tmp_iv, (uint32_t)16U * sizeof (uint8_t));
+        st->ctr = (uint32_t)1U;
+        return EverCrypt_Error_Success;
+      }
+    #endif
+    case Spec_Cipher_Expansion_Hacl_AES128:
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        if (iv_len == (uint32_t)0U)
+        {
+          return EverCrypt_Error_InvalidIVLength;
+        }
+        uint64_t *ctx = st->auth.case_gf128_ct.ctx;
+        Hacl_Gf128_CT_64_gcm_init(ctx, ek + (aes_ct_rounds(impl) + (uint32_t)1U) * (uint32_t)64U);
+        #if EVERCRYPT_TARGETCONFIG_X64
+        if (st->avx2)
+        {
+          Hacl_Gf128_CT_256_gcm_init(st->auth.case_gf128_ct.tbl, ctx);
+        }
+        else if (st->avx)
+        {
+          Hacl_Gf128_CT_128_gcm_init((Lib_IntVector_Intrinsics_vec128 *)st->auth.case_gf128_ct.tbl,
+            ctx);
+        }
+        #endif
+        if (iv_len == (uint32_t)12U)
+        {
+          memcpy(st->iv, iv, (uint32_t)12U * sizeof (uint8_t));
+          store32_be(st->iv + (uint32_t)12U, (uint32_t)1U);
+        }
+        else
+        {
+          /* J0 is the GHASH of the zero-padded IV and its length in bits. */
+          uint8_t lengths[16U] = { 0U };
+          store64_be(lengths + (uint32_t)8U, (uint64_t)iv_len * (uint64_t)8U);
+          Hacl_Gf128_CT_64_gcm_update_padded(ctx, iv_len, iv);
+          Hacl_Gf128_CT_64_gcm_update_blocks(ctx, (uint32_t)16U, lengths);
+          Hacl_Gf128_CT_64_gcm_emit(st->iv, ctx);
+          ctx[0U] = (uint64_t)0U;
+          ctx[1U] = (uint64_t)0U;
+        }
+        st->ctr = (uint32_t)1U;
+        return EverCrypt_Error_Success;
+      }
+    default:
+      {
+        return EverCrypt_Error_UnsupportedAlgorithm;
+      }
+  }
+}
+
+/* The text must fit in the 32-bit block counter, which starts at 1. */
+static uint64_t stream_max_text_len(EverCrypt_AEAD_stream_s *st)
+{
+  if (st->impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+  {
+    return (uint64_t)0xffffffffU * (uint64_t)64U;
+  }
+  return (uint64_t)0xfffffffeU * (uint64_t)16U;
+}
+
+/* Moves the keystream to byte off of the text. */
+static void stream_seek(EverCrypt_AEAD_stream_s *st, uint64_t off)
+{
+  uint32_t bl = stream_block_len(st);
+  st->ctr = (uint32_t)1U + (uint32_t)(off / (uint64_t)bl);
+  st->ks_off = st->ks_len;
+  uint32_t rem = (uint32_t)(off % (uint64_t)bl);
+  if (rem > (uint32_t)0U)
+  {
+    memset(st->ks, 0U, st->ks_len * sizeof (uint8_t));
+    stream_cipher_blocks(st, st->ks_len, st->ks, st->ks);
+    st->ks_off = rem;
+  }
+}
+
+static void stream_ad(EverCrypt_AEAD_stream_s *st, uint32_t len, uint8_t *ad)
+{
+  stream_auth(st, len, ad);
+  st->ad_len = st->ad_len + (uint64_t)len;
+}
+
+/* Encrypts (or decrypts) len bytes, authenticating the ciphertext. Long texts
+   are processed in 4KB slices, so that each slice is still in cache when it is
+   authenticated. */
+static void
+stream_text(EverCrypt_AEAD_stream_s *st, bool encrypt, uint32_t len, uint8_t *dst, uint8_t *src)
+{
+  uint32_t i = (uint32_t)0U;
+  while (i < len)
+  {
+    uint32_t n = len - i;
+    if (n > (uint32_t)4096U)
+    {
+      n = (uint32_t)4096U;
+    }
+    if (encrypt)
+    {
+      stream_xor(st, n, dst + i, src + i);
+      stream_auth(st, n, dst + i);
+    }
+    else
+    {
+      stream_auth(st, n, src + i);
+      stream_xor(st, n, dst + i, src + i);
+    }
+    i = i + n;
+  }
+  st->text_len = st->text_len + (uint64_t)len;
+}
+
+static void stream_finish(EverCrypt_AEAD_stream_s *st, uint8_t *tag)
+{
+  stream_auth_pad(st);
+  uint8_t lengths[16U] = { 0U };
+  if (st->impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+  {
+    store64_le(lengths, st->ad_len);
+    store64_le(lengths + (uint32_t)8U, st->text_len);
+    stream_auth_blocks(st, (uint32_t)16U, lengths);
+    #if EVERCRYPT_TARGETCONFIG_X64
+    if (st->avx2)
+    {
+      Hacl_Poly1305_256_poly1305_finish(tag, st->poly_key, st->auth.case_poly256);
+      return;
+    }
+    if (st->avx)
+    {
+      Hacl_Poly1305_128_poly1305_finish(tag, st->poly_key, st->auth.case_poly128);
+      return;
+    }
+    #endif
+    Hacl_Poly1305_32_poly1305_finish(tag, st->poly_key, st->auth.case_poly32);
+    return;
+  }
+  store64_be(lengths, st->ad_len * (uint64_t)8U);
+  store64_be(lengths + (uint32_t)8U, st->text_len * (uint64_t)8U);
+  stream_auth_blocks(st, (uint32_t)16U, lengths);
+  uint8_t s0[16U] = { 0U };
+  if (stream_is_ct(st))
+  {
+    Hacl_Gf128_CT_64_gcm_emit(s0, st->auth.case_gf128_ct.ctx);
+  }
+  else
+  {
+    #if EVERCRYPT_TARGETCONFIG_X64
+    Hacl_Gf128_NI_gcm_emit(s0, st->auth.case_gf128);
+    #endif
+  }
+  /* The tag is the GHASH value masked with the encryption of J0. */
+  st->ctr = (uint32_t)0U;
+  stream_cipher_blocks(st, (uint32_t)16U, tag, s0);
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_encrypt_iov(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_iovec *ad,
+  uint32_t ad_cnt,
+  EverCrypt_AEAD_iovec *plain,
+  uint32_t plain_cnt,
+  uint8_t **cipher,
+  uint8_t *tag
+)
+{
+  EverCrypt_AEAD_stream_s st;
+  EverCrypt_Error_error_code r = stream_init(&st, s, iv, iv_len);
+  if (r != EverCrypt_Error_Success)
+  {
+    return r;
+  }
+  for (uint32_t i = (uint32_t)0U; i < ad_cnt; i++)
+  {
+    stream_ad(&st, ad[i].len, ad[i].base);
+  }
+  stream_auth_pad(&st);
+  uint64_t len = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < plain_cnt; i++)
+  {
+    len = len + (uint64_t)plain[i].len;
+  }
+  if (len > stream_max_text_len(&st))
+  {
+    return EverCrypt_Error_MaximumLengthExceeded;
+  }
+  for (uint32_t i = (uint32_t)0U; i < plain_cnt; i++)
+  {
+    stream_text(&st, true, plain[i].len, cipher[i], plain[i].base);
+  }
+  stream_finish(&st, tag);
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_decrypt_iov(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_iovec *ad,
+  uint32_t ad_cnt,
+  EverCrypt_AEAD_iovec *cipher,
+  uint32_t cipher_cnt,
+  uint8_t *tag,
+  uint8_t **dst
+)
+{
+  EverCrypt_AEAD_stream_s st;
+  EverCrypt_Error_error_code r = stream_init(&st, s, iv, iv_len);
+  if (r != EverCrypt_Error_Success)
+  {
+    return r;
+  }
+  for (uint32_t i = (uint32_t)0U; i < ad_cnt; i++)
+  {
+    stream_ad(&st, ad[i].len, ad[i].base);
+  }
+  stream_auth_pad(&st);
+  uint64_t len = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < cipher_cnt; i++)
+  {
+    len = len + (uint64_t)cipher[i].len;
+  }
+  if (len > stream_max_text_len(&st))
+  {
+    return EverCrypt_Error_MaximumLengthExceeded;
+  }
+  for (uint32_t i = (uint32_t)0U; i < cipher_cnt; i++)
+  {
+    stream_text(&st, false, cipher[i].len, dst[i], cipher[i].base);
+  }
+  uint8_t computed_tag[16U] = { 0U };
+  stream_finish(&st, computed_tag);
+  uint8_t res = (uint8_t)255U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    uint8_t uu____0 = FStar_UInt8_eq_mask(computed_tag[i], tag[i]);
+    res = uu____0 & res;
+  }
+  if (res == (uint8_t)255U)
+  {
+    return EverCrypt_Error_Success;
+  }
+  for (uint32_t i = (uint32_t)0U; i < cipher_cnt; i++)
+  {
+    memset(dst[i], 0U, cipher[i].len * sizeof (uint8_t));
+  }
+  return EverCrypt_Error_AuthenticationFailure;
+}
+
+/* Parallel encryption. The text is cut into segments that are encrypted and
+   authenticated independently, each by a copy of the stream positioned at the
+   segment and with a zero authenticator. The authenticator of the text after
+   segments 0..i is then acc * X^n + acc_i, where X is H (GHASH) or r
+   (Poly1305) and n is the number of blocks of segment i. */
+
+static void poly_fmul(uint64_t *out, uint64_t *a, uint64_t *b)
+{
+  uint64_t b15 = b[1U] * (uint64_t)5U;
+  uint64_t b25 = b[2U] * (uint64_t)5U;
+  uint64_t b35 = b[3U] * (uint64_t)5U;
+  uint64_t b45 = b[4U] * (uint64_t)5U;
+  uint64_t t[5U] = { 0U };
+  t[0U] = a[0U] * b[0U] + a[1U] * b45 + a[2U] * b35 + a[3U] * b25 + a[4U] * b15;
+  t[1U] = a[0U] * b[1U] + a[1U] * b[0U] + a[2U] * b45 + a[3U] * b35 + a[4U] * b25;
+  t[2U] = a[0U] * b[2U] + a[1U] * b[1U] + a[2U] * b[0U] + a[3U] * b45 + a[4U] * b35;
+  t[3U] = a[0U] * b[3U] + a[1U] * b[2U] + a[2U] * b[1U] + a[3U] * b[0U] + a[4U] * b45;
+  t[4U] = a[0U] * b[4U] + a[1U] * b[3U] + a[2U] * b[2U] + a[3U] * b[1U] + a[4U] * b[0U];
+  uint64_t c = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    t[i] = t[i] + c;
+    c = t[i] >> (uint32_t)26U;
+    t[i] = t[i] & (uint64_t)0x3ffffffU;
+  }
+  t[0U] = t[0U] + c * (uint64_t)5U;
+  t[1U] = t[1U] + (t[0U] >> (uint32_t)26U);
+  t[0U] = t[0U] & (uint64_t)0x3ffffffU;
+  memcpy(out, t, (uint32_t)5U * sizeof (uint64_t));
+}
+
+/* The Poly1305 accumulator and r, as 26-bit limbs; the vectorized states keep
+   them in the first lane. */
+static uint64_t *poly_limb(EverCrypt_AEAD_stream_s *st, uint32_t i)
+{
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (st->avx2)
+  {
+    return (uint64_t *)(st->auth.case_poly256 + i);
+  }
+  if (st->avx)
+  {
+    return (uint64_t *)(st->auth.case_poly128 + i);
+  }
+  #endif
+  return st->auth.case_poly32 + i;
+}
+
+static void
+stream_merge(EverCrypt_AEAD_stream_s *st, EverCrypt_AEAD_stream_s *st1)
+{
+  uint64_t n1 = st1->text_len / (uint64_t)16U;
+  st->text_len = st->text_len + st1->text_len;
+  if (stream_is_ct(st))
+  {
+    Hacl_Gf128_CT_64_gcm_merge(st->auth.case_gf128_ct.ctx, st1->auth.case_gf128_ct.ctx, n1);
+    return;
+  }
+  if (st->impl != Spec_Cipher_Expansion_Hacl_CHACHA20)
+  {
+    #if EVERCRYPT_TARGETCONFIG_X64
+    Hacl_Gf128_NI_gcm_merge(st->auth.case_gf128, st1->auth.case_gf128, n1);
+    #endif
+    return;
+  }
+  uint64_t r[5U] = { 0U };
+  uint64_t p[5U] = { 0U };
+  uint64_t acc[5U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    r[i] = poly_limb(st, (uint32_t)5U + i)[0U];
+    acc[i] = poly_limb(st, i)[0U];
+  }
+  p[0U] = (uint64_t)1U;
+  for (uint32_t i = (uint32_t)64U; i > (uint32_t)0U; i--)
+  {
+    poly_fmul(p, p, p);
+    if ((n1 >> (i - (uint32_t)1U) & (uint64_t)1U) == (uint64_t)1U)
+    {
+      poly_fmul(p, p, r);
+    }
+  }
+  poly_fmul(acc, acc, p);
+  uint64_t c = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    uint64_t x = acc[i] + poly_limb(st1, i)[0U] + c;
+    c = x >> (uint32_t)26U;
+    poly_limb(st, i)[0U] = x & (uint64_t)0x3ffffffU;
+  }
+  poly_limb(st, (uint32_t)0U)[0U] = poly_limb(st, (uint32_t)0U)[0U] + c * (uint64_t)5U;
+}
+
+typedef struct stream_par_s
+{
+  EverCrypt_AEAD_stream_s *st;
+  EverCrypt_AEAD_stream_s *segs;
+  bool encrypt;
+  uint32_t seg_len;
+  uint32_t len;
+  uint8_t *src;
+  uint8_t *dst;
+}
+stream_par;
+
+static void stream_par_segment(void *ctx, uint32_t i)
+{
+  stream_par *job = (stream_par *)ctx;
+  EverCrypt_AEAD_stream_s *seg = job->segs + i;
+  uint32_t off = i * job->seg_len;
+  uint32_t n = job->len - off;
+  if (n > job->seg_len)
+  {
+    n = job->seg_len;
+  }
+  memcpy(seg, job->st, sizeof (EverCrypt_AEAD_stream_s));
+  stream_seek(seg, (uint64_t)off);
+  seg->text_len = (uint64_t)0U;
+  if (seg->impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+  {
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)5U; j++)
+    {
+      poly_limb(seg, j)[0U] = (uint64_t)0U;
+    }
+  }
+  else if (stream_is_ct(seg))
+  {
+    seg->auth.case_gf128_ct.ctx[0U] = (uint64_t)0U;
+    seg->auth.case_gf128_ct.ctx[1U] = (uint64_t)0U;
+  }
+  else
+  {
+    memset(seg->auth.case_gf128, 0U, sizeof (seg->auth.case_gf128[0U]));
+  }
+  stream_text(seg, job->encrypt, n, job->dst + off, job->src + off);
+}
+
+/* Runs the text through st on up to nthreads threads; the segments are large
+   enough for the merges to be negligible, and numerous enough to balance the
+   load. */
+static void
+stream_text_par(
+  EverCrypt_AEAD_stream_s *st,
+  bool encrypt,
+  uint32_t len,
+  uint8_t *dst,
+  uint8_t *src,
+  uint32_t nthreads
+)
+{
+  uint32_t seg_len = (uint32_t)0x100000U;
+  if (len / seg_len > (uint32_t)16U * nthreads)
+  {
+    seg_len = (len / ((uint32_t)16U * nthreads) + (uint32_t)0xfffU) & ~(uint32_t)0xfffU;
+  }
+  uint32_t nsegs = (len + seg_len - (uint32_t)1U) / seg_len;
+  if (nthreads <= (uint32_t)1U || nsegs <= (uint32_t)1U)
+  {
+    stream_text(st, encrypt, len, dst, src);
+    return;
+  }
+  uint8_t *mem = KRML_HOST_MALLOC(nsegs * sizeof (EverCrypt_AEAD_stream_s) + (uint32_t)32U);
+  uintptr_t moff = (uint32_t)32U - (uintptr_t)mem % (uintptr_t)32U;
+  stream_par
+  job =
+    {
+      .st = st, .segs = (EverCrypt_AEAD_stream_s *)(mem + moff), .encrypt = encrypt,
+      .seg_len = seg_len, .len = len, .src = src, .dst = dst
+    };
+  Lib_Parallel_run(nthreads, nsegs, stream_par_segment, &job);
+  for (uint32_t i = (uint32_t)0U; i < nsegs; i++)
+  {
+    stream_merge(st, job.segs + i);
+  }
+  /* Only the last segment can end with a partial block. */
+  EverCrypt_AEAD_stream_s *last = job.segs + nsegs - (uint32_t)1U;
+  memcpy(st->buf, last->buf, (uint32_t)16U * sizeof (uint8_t));
+  st->buf_len = last->buf_len;
+  KRML_HOST_FREE(mem);
+}
+
+static bool stream_check_tag(EverCrypt_AEAD_stream_s *st, uint8_t *tag)
+{
+  uint8_t computed_tag[16U] = { 0U };
+  stream_finish(st, computed_tag);
+  uint8_t res = (uint8_t)255U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    uint8_t uu____0 = FStar_UInt8_eq_mask(computed_tag[i], tag[i]);
+    res = uu____0 & res;
+  }
+  return res == (uint8_t)255U;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_encrypt_par(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag,
+  uint32_t nthreads
+)
+{
+  if (nthreads <= (uint32_t)1U || plain_len < (uint32_t)0x200000U)
+  {
+    return EverCrypt_AEAD_encrypt(s, iv, iv_len, ad, ad_len, plain, plain_len, cipher, tag);
+  }
+  uint8_t *mem = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_stream_s) + (uint32_t)32U);
+  uintptr_t off = (uint32_t)32U - (uintptr_t)mem % (uintptr_t)32U;
+  EverCrypt_AEAD_stream_s *st = (EverCrypt_AEAD_stream_s *)(mem + off);
+  EverCrypt_Error_error_code r = stream_init(st, s, iv, iv_len);
+  if (r == EverCrypt_Error_Success)
+  {
+    stream_ad(st, ad_len, ad);
+    stream_auth_pad(st);
+    stream_text_par(st, true, plain_len, cipher, plain, nthreads);
+    stream_finish(st, tag);
+  }
+  KRML_HOST_FREE(mem);
+  return r;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_decrypt_par(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst,
+  uint32_t nthreads
+)
+{
+  if (nthreads <= (uint32_t)1U || cipher_len < (uint32_t)0x200000U)
+  {
+    return EverCrypt_AEAD_decrypt(s, iv, iv_len, ad, ad_len, cipher, cipher_len, tag, dst);
+  }
+  uint8_t *mem = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_stream_s) + (uint32_t)32U);
+  uintptr_t off = (uint32_t)32U - (uintptr_t)mem % (uintptr_t)32U;
+  EverCrypt_AEAD_stream_s *st = (EverCrypt_AEAD_stream_s *)(mem + off);
+  EverCrypt_Error_error_code r = stream_init(st, s, iv, iv_len);
+  if (r == EverCrypt_Error_Success)
+  {
+    stream_ad(st, ad_len, ad);
+    stream_auth_pad(st);
+    stream_text_par(st, false, cipher_len, dst, cipher, nthreads);
+    if (!stream_check_tag(st, tag))
+    {
+      memset(dst, 0U, cipher_len * sizeof (uint8_t));
+      r = EverCrypt_Error_AuthenticationFailure;
+    }
+  }
+  KRML_HOST_FREE(mem);
+  return r;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_create_in(EverCrypt_AEAD_state_s *s, EverCrypt_AEAD_stream_s **dst)
+{
+  if (s == NULL)
+  {
+    return EverCrypt_Error_InvalidKey;
+  }
+  EverCrypt_AEAD_state_s scrut = *s;
+  Spec_Cipher_Expansion_impl impl = scrut.impl;
+  #if !EVERCRYPT_TARGETCONFIG_X64
+  if (impl == Spec_Cipher_Expansion_Vale_AES128 || impl == Spec_Cipher_Expansion_Vale_AES256)
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  #endif
+  /* The Poly1305 and GHASH states hold vectors that need more alignment than
+     KRML_HOST_MALLOC guarantees. */
+  uint8_t *mem = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_stream_s) + (uint32_t)32U);
+  uintptr_t off = (uint32_t)32U - (uintptr_t)mem % (uintptr_t)32U;
+  EverCrypt_AEAD_stream_s *st = (EverCrypt_AEAD_stream_s *)(mem + off);
+  memset(st, 0U, sizeof (EverCrypt_AEAD_stream_s));
+  st->mem = mem;
+  st->key = s;
+  st->impl = impl;
+  *dst = st;
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_init(
+  EverCrypt_AEAD_stream_s *st,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len
+)
+{
+  EverCrypt_Error_error_code r = stream_init(st, st->key, iv, iv_len);
+  if (r != EverCrypt_Error_Success)
+  {
+    return r;
+  }
+  stream_ad(st, ad_len, ad);
+  stream_auth_pad(st);
+  st->verified = false;
+  st->seek = false;
+  st->released_len = (uint64_t)0U;
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_encrypt_update(
+  EverCrypt_AEAD_stream_s *st,
+  uint8_t *plain,
+  uint32_t len,
+  uint8_t *cipher
+)
+{
+  if (st->text_len + (uint64_t)len > stream_max_text_len(st))
+  {
+    return EverCrypt_Error_MaximumLengthExceeded;
+  }
+  stream_text(st, true, len, cipher, plain);
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_encrypt_finish(EverCrypt_AEAD_stream_s *st, uint8_t *tag)
+{
+  stream_finish(st, tag);
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_decrypt_update(
+  EverCrypt_AEAD_stream_s *st,
+  uint8_t *cipher,
+  uint32_t len,
+  uint8_t *dst
+)
+{
+  if (st->text_len + (uint64_t)len > stream_max_text_len(st))
+  {
+    return EverCrypt_Error_MaximumLengthExceeded;
+  }
+  if (dst == NULL)
+  {
+    stream_auth(st, len, cipher);
+    st->text_len = st->text_len + (uint64_t)len;
+    st->seek = true;
+    return EverCrypt_Error_Success;
+  }
+  if (st->seek)
+  {
+    stream_seek(st, st->text_len);
+    st->seek = false;
+  }
+  stream_text(st, false, len, dst, cipher);
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_decrypt_finish(EverCrypt_AEAD_stream_s *st, uint8_t *tag)
+{
+  uint8_t computed_tag[16U] = { 0U };
+  stream_finish(st, computed_tag);
+  uint8_t res = (uint8_t)255U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    uint8_t uu____0 = FStar_UInt8_eq_mask(computed_tag[i], tag[i]);
+    res = uu____0 & res;
+  }
+  if (res != (uint8_t)255U)
+  {
+    return EverCrypt_Error_AuthenticationFailure;
+  }
+  st->verified = true;
+  st->released_len = (uint64_t)0U;
+  stream_seek(st, (uint64_t)0U);
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_decrypt_release(
+  EverCrypt_AEAD_stream_s *st,
+  uint8_t *cipher,
+  uint32_t len,
+  uint8_t *dst
+)
+{
+  if (!st->verified || st->released_len + (uint64_t)len > st->text_len)
+  {
+    return EverCrypt_Error_AuthenticationFailure;
+  }
+  stream_xor(st, len, dst, cipher);
+  st->released_len = st->released_len + (uint64_t)len;
+  return EverCrypt_Error_Success;
+}
+
+void EverCrypt_AEAD_stream_free(EverCrypt_AEAD_stream_s *st)
+{
+  KRML_HOST_FREE(st->mem);
+}
+
+typedef struct EverCrypt_AEAD_record_s_s
+{
+  EverCrypt_AEAD_state_s *s;
+  uint8_t static_iv[12U];
+  uint64_t seq;
+}
+EverCrypt_AEAD_record_s;
+
+/* The key state follows the record in the same allocation. */
+static uint32_t record_hdr_len(void)
+{
+  return ((uint32_t)sizeof (EverCrypt_AEAD_record_s) + (uint32_t)15U) & ~(uint32_t)15U;
+}
+
+/* The nonce of record seq: the static IV, with the last 8 bytes XORed with seq
+   in big-endian order (TLS 1.3, QUIC). */
+static void record_nonce(EverCrypt_AEAD_record_s *r, uint64_t seq, uint8_t *iv)
+{
+  memcpy(iv, r->static_iv, (uint32_t)12U * sizeof (uint8_t));
+  uint64_t x = load64_be(iv + (uint32_t)4U);
+  store64_be(iv + (uint32_t)4U, x ^ seq);
+}
+
+/* Records are processed in groups of at most RECORD_BATCH, which bounds the
+   nonces and pointer arrays kept on the stack. */
+#define RECORD_BATCH ((uint32_t)32U)
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_create_in(
+  Spec_Agile_AEAD_alg a,
+  EverCrypt_AEAD_record_s **dst,
+  uint8_t *k,
+  uint8_t *static_iv
+)
+{
+  uint32_t size = EverCrypt_AEAD_state_size(a);
+  if (size == (uint32_t)0U)
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  uint8_t *mem = KRML_HOST_MALLOC(record_hdr_len() + size);
+  EverCrypt_AEAD_record_s *r = (EverCrypt_AEAD_record_s *)mem;
+  EverCrypt_Error_error_code res = EverCrypt_AEAD_init_in_place(a, mem + record_hdr_len(), k, &r->s);
+  if (res != EverCrypt_Error_Success)
+  {
+    KRML_HOST_FREE(mem);
+    return res;
+  }
+  memcpy(r->static_iv, static_iv, (uint32_t)12U * sizeof (uint8_t));
+  r->seq = (uint64_t)0U;
+  *dst = r;
+  return EverCrypt_Error_Success;
+}
+
+uint64_t EverCrypt_AEAD_record_next_seq(EverCrypt_AEAD_record_s *r)
+{
+  return r->seq;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  uint8_t iv[12U];
+  record_nonce(r, seq, iv);
+  return EverCrypt_AEAD_encrypt(r->s, iv, (uint32_t)12U, ad, ad_len, plain, plain_len, cipher, tag);
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_next(
+  EverCrypt_AEAD_record_s *r,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  if (r->seq == (uint64_t)0xffffffffffffffffU)
+  {
+    return EverCrypt_Error_MaximumLengthExceeded;
+  }
+  EverCrypt_Error_error_code
+  res = EverCrypt_AEAD_record_seal_at(r, r->seq, ad, ad_len, plain, plain_len, cipher, tag);
+  if (res == EverCrypt_Error_Success)
+  {
+    r->seq = r->seq + (uint64_t)1U;
+  }
+  return res;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst
+)
+{
+  uint8_t iv[12U];
+  record_nonce(r, seq, iv);
+  return EverCrypt_AEAD_decrypt(r->s, iv, (uint32_t)12U, ad, ad_len, cipher, cipher_len, tag, dst);
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **plain,
+  uint32_t *plain_len,
+  uint8_t **cipher,
+  uint8_t **tag
+)
+{
+  uint64_t seq0 = r->seq;
+  if (seq == NULL && (uint64_t)num > (uint64_t)0xffffffffffffffffU - seq0)
+  {
+    return EverCrypt_Error_MaximumLengthExceeded;
+  }
+  uint8_t iv[RECORD_BATCH][12U];
+  uint8_t *k[RECORD_BATCH];
+  uint8_t *n[RECORD_BATCH];
+  for (uint32_t i = (uint32_t)0U; i < num; i = i + RECORD_BATCH)
+  {
+    uint32_t m = num - i < RECORD_BATCH ? num - i : RECORD_BATCH;
+    for (uint32_t j = (uint32_t)0U; j < m; j++)
+    {
+      uint64_t sj = seq == NULL ? seq0 + (uint64_t)(i + j) : seq[i + j];
+      record_nonce(r, sj, iv[j]);
+      k[j] = r->s->ek;
+      n[j] = iv[j];
+    }
+    if (r->s->impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+    {
+      EverCrypt_Chacha20Poly1305_aead_encrypt_multi(m,
+        k,
+        n,
+        ad_len + i,
+        ad + i,
+        plain_len + i,
+        plain + i,
+        cipher + i,
+        tag + i);
+    }
+    else
+    {
+      for (uint32_t j = (uint32_t)0U; j < m; j++)
+      {
+        uint32_t l = i + j;
+        EverCrypt_Error_error_code
+        res =
+          EverCrypt_AEAD_encrypt(r->s,
+            n[j],
+            (uint32_t)12U,
+            ad[l],
+            ad_len[l],
+            plain[l],
+            plain_len[l],
+            cipher[l],
+            tag[l]);
+        if (res != EverCrypt_Error_Success)
+        {
+          if (seq == NULL)
+          {
+            r->seq = seq0 + (uint64_t)l;
+          }
+          return res;
+        }
+      }
+    }
+  }
+  if (seq == NULL)
+  {
+    r->seq = seq0 + (uint64_t)num;
+  }
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **cipher,
+  uint32_t *cipher_len,
+  uint8_t **tag,
+  uint8_t **dst,
+  EverCrypt_Error_error_code *res
+)
+{
+  EverCrypt_Error_error_code all = EverCrypt_Error_Success;
+  uint8_t iv[RECORD_BATCH][12U];
+  uint8_t *k[RECORD_BATCH];
+  uint8_t *n[RECORD_BATCH];
+  uint32_t r1[RECORD_BATCH];
+  for (uint32_t i = (uint32_t)0U; i < num; i = i + RECORD_BATCH)
+  {
+    uint32_t m = num - i < RECORD_BATCH ? num - i : RECORD_BATCH;
+    for (uint32_t j = (uint32_t)0U; j < m; j++)
+    {
+      record_nonce(r, seq[i + j], iv[j]);
+      k[j] = r->s->ek;
+      n[j] = iv[j];
+    }
+    if (r->s->impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+    {
+      EverCrypt_Chacha20Poly1305_aead_decrypt_multi(m,
+        k,
+        n,
+        ad_len + i,
+        ad + i,
+        cipher_len + i,
+        dst + i,
+        cipher + i,
+        tag + i,
+        r1);
+      for (uint32_t j = (uint32_t)0U; j < m; j++)
+      {
+        if (r1[j] == (uint32_t)0U)
+        {
+          res[i + j] = EverCrypt_Error_Success;
+        }
+        else
+        {
+          res[i + j] = EverCrypt_Error_AuthenticationFailure;
+        }
+      }
+    }
+    else
+    {
+      for (uint32_t j = (uint32_t)0U; j < m; j++)
+      {
+        uint32_t l = i + j;
+        res[l] =
+          EverCrypt_AEAD_decrypt(r->s,
+            n[j],
+            (uint32_t)12U,
+            ad[l],
+            ad_len[l],
+            cipher[l],
+            cipher_len[l],
+            tag[l],
+            dst[l]);
+      }
+    }
+    for (uint32_t j = (uint32_t)0U; j < m; j++)
+    {
+      if (res[i + j] != EverCrypt_Error_Success)
+      {
+        all = EverCrypt_Error_AuthenticationFailure;
+      }
+    }
+  }
+  return all;
+}
+
+void EverCrypt_AEAD_record_free(EverCrypt_AEAD_record_s *r)
+{
+  Spec_Agile_AEAD_alg a = EverCrypt_AEAD_alg_of_state(r->s);
+  Lib_Memzero0_memzero((uint8_t *)r, record_hdr_len() + EverCrypt_AEAD_state_size(a));
+  KRML_HOST_FREE(r);
+}
+
 void EverCrypt_AEAD_free(EverCrypt_AEAD_state_s *s)
 {
   EverCrypt_AEAD_state_s scrut = *s;
@@ -43,6 +43,13 @@ extern "C" {
 #include "EverCrypt_AutoConfig2.h"
 #include "EverCrypt_Error.h"
 #include "Hacl_Spec.h"
+#include "Hacl_Gf128_NI.h"
+#include "Hacl_AES_Bitslice_256.h"
+#include "Hacl_AES_Bitslice_128.h"
+#include "Hacl_Gf128_CT_256.h"
+#include "Hacl_Gf128_CT_128.h"
+#include "Lib_Parallel.h"
+#include "Lib_Memzero0.h"
 
 typedef struct EverCrypt_AEAD_state_s_s EverCrypt_AEAD_state_s;
 
@@ -59,6 +66,27 @@ Spec_Agile_AEAD_alg EverCrypt_AEAD_alg_of_state(EverCrypt_AEAD_state_s *s);
 EverCrypt_Error_error_code
 EverCrypt_AEAD_create_in(Spec_Agile_AEAD_alg a, EverCrypt_AEAD_state_s **dst, uint8_t *k);
 
+/* The number of bytes that EverCrypt_AEAD_init_in_place needs for a state of
+   algorithm a, whatever implementation this CPU selects; 0 if a is not
+   supported. */
+uint32_t EverCrypt_AEAD_state_size(Spec_Agile_AEAD_alg a);
+
+/* Same as EverCrypt_AEAD_create_in, with the state and its expanded key laid
+   out in caller-owned memory: mem holds EverCrypt_AEAD_state_size(a) bytes and
+   is 16-byte aligned, and *dst is set to a state within mem that is valid as
+   long as mem is. Such a state is not passed to EverCrypt_AEAD_free; the
+   caller releases (and should zero) mem itself, and may call this function
+   again on the same memory to load another key. Returns
+   EverCrypt_Error_InvalidKey, leaving mem and *dst untouched, if mem is not
+   16-byte aligned. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_init_in_place(
+  Spec_Agile_AEAD_alg a,
+  uint8_t *mem,
+  uint8_t *k,
+  EverCrypt_AEAD_state_s **dst
+);
+
 EverCrypt_Error_error_code
 EverCrypt_AEAD_encrypt(
   EverCrypt_AEAD_state_s *s,
@@ -191,6 +219,255 @@ EverCrypt_AEAD_decrypt_expand(
   uint8_t *dst
 );
 
+/* A fragment of a scattered buffer. */
+typedef struct EverCrypt_AEAD_iovec_s
+{
+  uint8_t *base;
+  uint32_t len;
+}
+EverCrypt_AEAD_iovec;
+
+/* Same as EverCrypt_AEAD_encrypt, for an associated data and a plaintext
+   scattered over ad_cnt and plain_cnt fragments. The ciphertext of plain[i] is
+   written to cipher[i], which is either plain[i].base (in-place encryption) or
+   a buffer of plain[i].len bytes that does not overlap any input fragment.
+   Fragments may have any length; no fragment is copied, and blocks that
+   straddle two fragments are carried over internally. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_encrypt_iov(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_iovec *ad,
+  uint32_t ad_cnt,
+  EverCrypt_AEAD_iovec *plain,
+  uint32_t plain_cnt,
+  uint8_t **cipher,
+  uint8_t *tag
+);
+
+/* Same as EverCrypt_AEAD_decrypt, for scattered buffers; the plaintext of
+   cipher[i] is written to dst[i], with the aliasing rules of
+   EverCrypt_AEAD_encrypt_iov. If authentication fails, all dst fragments are
+   zeroed. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_decrypt_iov(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_iovec *ad,
+  uint32_t ad_cnt,
+  EverCrypt_AEAD_iovec *cipher,
+  uint32_t cipher_cnt,
+  uint8_t *tag,
+  uint8_t **dst
+);
+
+/* Same as EverCrypt_AEAD_encrypt, on up to nthreads threads. The text is cut
+   into segments of at least 1MB that are encrypted and authenticated in
+   parallel, and the authenticators of the segments are combined; the result
+   is identical to that of EverCrypt_AEAD_encrypt. Texts shorter than 2MB are
+   encrypted on the calling thread. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_encrypt_par(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag,
+  uint32_t nthreads
+);
+
+/* Same as EverCrypt_AEAD_decrypt, on up to nthreads threads. If authentication
+   fails, dst is zeroed. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_decrypt_par(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst,
+  uint32_t nthreads
+);
+
+/* Incremental encryption and decryption, for texts that are not held in
+   memory at once. A stream is bound to a key state, which must outlive it,
+   and is started for each message with EverCrypt_AEAD_stream_init, which
+   takes the IV and the associated data. The text is then passed in chunks of
+   any length, up to 2^36 - 32 bytes in total for AES-GCM and 2^38 - 64 bytes
+   for ChaCha20-Poly1305; longer texts fail with
+   EverCrypt_Error_MaximumLengthExceeded. Chunks go through the same wide
+   kernels as the one-shot functions, and partial blocks are carried over to
+   the next chunk. The resulting ciphertext and tag are those of
+   EverCrypt_AEAD_encrypt on the concatenation of the chunks. */
+typedef struct EverCrypt_AEAD_stream_s_s EverCrypt_AEAD_stream_s;
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_create_in(EverCrypt_AEAD_state_s *s, EverCrypt_AEAD_stream_s **dst);
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_init(
+  EverCrypt_AEAD_stream_s *st,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len
+);
+
+/* Encrypts the next len bytes of plaintext to cipher, which is either plain or
+   does not overlap it. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_encrypt_update(
+  EverCrypt_AEAD_stream_s *st,
+  uint8_t *plain,
+  uint32_t len,
+  uint8_t *cipher
+);
+
+/* Writes the tag; the stream must then be restarted with
+   EverCrypt_AEAD_stream_init. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_encrypt_finish(EverCrypt_AEAD_stream_s *st, uint8_t *tag);
+
+/* Decrypts the next len bytes of ciphertext to dst. The plaintext is not
+   authenticated until EverCrypt_AEAD_stream_decrypt_finish succeeds, and must
+   not be released before. With a NULL dst, the chunk is only authenticated:
+   a caller that cannot hold back the plaintext authenticates the whole text
+   first, and decrypts it in a second pass with
+   EverCrypt_AEAD_stream_decrypt_release. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_decrypt_update(
+  EverCrypt_AEAD_stream_s *st,
+  uint8_t *cipher,
+  uint32_t len,
+  uint8_t *dst
+);
+
+/* Checks the tag; returns EverCrypt_Error_AuthenticationFailure if it does not
+   match. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_decrypt_finish(EverCrypt_AEAD_stream_s *st, uint8_t *tag);
+
+/* Second pass of a staged decryption: decrypts the next len bytes of a text
+   whose tag was accepted by EverCrypt_AEAD_stream_decrypt_finish, starting
+   from its beginning. The caller must pass the same ciphertext as in the first
+   pass. Fails with EverCrypt_Error_AuthenticationFailure if the tag has not
+   been checked, or if the chunks go past the authenticated length. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_stream_decrypt_release(
+  EverCrypt_AEAD_stream_s *st,
+  uint8_t *cipher,
+  uint32_t len,
+  uint8_t *dst
+);
+
+void EverCrypt_AEAD_stream_free(EverCrypt_AEAD_stream_s *st);
+
+/* Record protection, as in TLS 1.3 and QUIC: an object that owns an expanded
+   key, a 12-byte static IV and a sequence counter, starting at 0. The nonce of
+   record seq is the static IV with its last 8 bytes XORed with seq, in
+   big-endian order. Each call costs one nonce computation on top of
+   EverCrypt_AEAD_encrypt or EverCrypt_AEAD_decrypt, with no allocation. */
+typedef struct EverCrypt_AEAD_record_s_s EverCrypt_AEAD_record_s;
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_create_in(
+  Spec_Agile_AEAD_alg a,
+  EverCrypt_AEAD_record_s **dst,
+  uint8_t *k,
+  uint8_t *static_iv
+);
+
+/* The sequence number that the next EverCrypt_AEAD_record_seal_next uses. */
+uint64_t EverCrypt_AEAD_record_next_seq(EverCrypt_AEAD_record_s *r);
+
+/* Encrypts the next record and advances the counter. Fails with
+   EverCrypt_Error_MaximumLengthExceeded once the counter reaches 2^64 - 1. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_next(
+  EverCrypt_AEAD_record_s *r,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+/* Encrypts record seq, for protocols that choose their sequence numbers, such
+   as QUIC packet numbers. The counter is left unchanged; the caller must never
+   seal two records with the same seq. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+/* Decrypts record seq; see EverCrypt_AEAD_decrypt. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst
+);
+
+/* Encrypts num records: record i has sequence number seq[i], or, if seq is
+   NULL, the next num sequence numbers are taken from the counter.
+   ChaCha20-Poly1305 records are processed several at a time, one per vector
+   lane. Stops at the first record that fails to encrypt and returns its error:
+   the records before it are sealed, and the counter only moves past them. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **plain,
+  uint32_t *plain_len,
+  uint8_t **cipher,
+  uint8_t **tag
+);
+
+/* Decrypts num records with sequence numbers seq[i]. res[i] is the result of
+   record i, as for EverCrypt_AEAD_record_open_at; returns
+   EverCrypt_Error_AuthenticationFailure unless all records authenticate. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **cipher,
+  uint32_t *cipher_len,
+  uint8_t **tag,
+  uint8_t **dst,
+  EverCrypt_Error_error_code *res
+);
+
+/* Zeroes and frees the record object, including its key. */
+void EverCrypt_AEAD_record_free(EverCrypt_AEAD_record_s *r);
+
 void EverCrypt_AEAD_free(EverCrypt_AEAD_state_s *s);
 
 #if defined(__cplusplus)
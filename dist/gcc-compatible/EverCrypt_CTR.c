@@ -31,6 +31,8 @@ typedef struct EverCrypt_CTR_state_s_s
   uint32_t iv_len;
   uint8_t *xkey;
   uint32_t ctr;
+  uint8_t *ks;
+  uint32_t ks_len;
 }
 EverCrypt_CTR_state_s;
 
@@ -85,6 +87,24 @@ EverCrypt_CTR___proj__State__item__ctr(
   return projectee.ctr;
 }
 
+uint8_t
+*EverCrypt_CTR___proj__State__item__ks(
+  Spec_Agile_Cipher_cipher_alg a,
+  EverCrypt_CTR_state_s projectee
+)
+{
+  return projectee.ks;
+}
+
+uint32_t
+EverCrypt_CTR___proj__State__item__ks_len(
+  Spec_Agile_Cipher_cipher_alg a,
+  EverCrypt_CTR_state_s projectee
+)
+{
+  return projectee.ks_len;
+}
+
 uint8_t EverCrypt_CTR_xor8(uint8_t a, uint8_t b)
 {
   return a ^ b;
@@ -149,6 +169,7 @@ EverCrypt_CTR_create_in(
           uint64_t scrut0 = aes128_keyhash_init(keys_b, hkeys_b);
           uint8_t *iv_ = KRML_HOST_CALLOC((uint32_t)16U, sizeof (uint8_t));
           memcpy(iv_, iv, iv_len * sizeof (uint8_t));
+          uint8_t *ks = KRML_HOST_CALLOC((uint32_t)16U, sizeof (uint8_t));
           KRML_CHECK_SIZE(sizeof (EverCrypt_CTR_state_s), (uint32_t)1U);
           EverCrypt_CTR_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_CTR_state_s));
           p[0U]
@@ -159,7 +180,9 @@ EverCrypt_CTR_create_in(
                 .iv = iv_,
                 .iv_len = iv_len,
                 .xkey = ek,
-                .ctr = c
+                .ctr = c,
+                .ks = ks,
+                .ks_len = (uint32_t)0U
               }
             );
           *dst = p;
@@ -188,6 +211,7 @@ EverCrypt_CTR_create_in(
           uint64_t scrut0 = aes256_keyhash_init(keys_b, hkeys_b);
           uint8_t *iv_ = KRML_HOST_CALLOC((uint32_t)16U, sizeof (uint8_t));
           memcpy(iv_, iv, iv_len * sizeof (uint8_t));
+          uint8_t *ks = KRML_HOST_CALLOC((uint32_t)16U, sizeof (uint8_t));
           KRML_CHECK_SIZE(sizeof (EverCrypt_CTR_state_s), (uint32_t)1U);
           EverCrypt_CTR_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_CTR_state_s));
           p[0U]
@@ -198,7 +222,9 @@ EverCrypt_CTR_create_in(
                 .iv = iv_,
                 .iv_len = iv_len,
                 .xkey = ek,
-                .ctr = c
+                .ctr = c,
+                .ks = ks,
+                .ks_len = (uint32_t)0U
               }
             );
           *dst = p;
@@ -214,6 +240,7 @@ EverCrypt_CTR_create_in(
         KRML_CHECK_SIZE(sizeof (uint8_t), iv_len);
         uint8_t *iv_ = KRML_HOST_CALLOC(iv_len, sizeof (uint8_t));
         memcpy(iv_, iv, iv_len * sizeof (uint8_t));
+        uint8_t *ks = KRML_HOST_CALLOC((uint32_t)64U, sizeof (uint8_t));
         KRML_CHECK_SIZE(sizeof (EverCrypt_CTR_state_s), (uint32_t)1U);
         EverCrypt_CTR_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_CTR_state_s));
         p[0U]
@@ -224,7 +251,9 @@ EverCrypt_CTR_create_in(
               .iv = iv_,
               .iv_len = (uint32_t)12U,
               .xkey = ek,
-              .ctr = c
+              .ctr = c,
+              .ks = ks,
+              .ks_len = (uint32_t)0U
             }
           );
         *dst = p;
@@ -250,6 +279,7 @@ EverCrypt_CTR_init(
   EverCrypt_CTR_state_s scrut0 = *p;
   uint8_t *ek = scrut0.xkey;
   uint8_t *iv_ = scrut0.iv;
+  uint8_t *ks = scrut0.ks;
   Spec_Cipher_Expansion_impl i = scrut0.i;
   memcpy(iv_, iv, iv_len * sizeof (uint8_t));
   switch (i)
@@ -285,7 +315,19 @@ EverCrypt_CTR_init(
         KRML_HOST_EXIT(253U);
       }
   }
-  *p = ((EverCrypt_CTR_state_s){ .i = i, .iv = iv_, .iv_len = iv_len, .xkey = ek, .ctr = c });
+  *p
+  =
+    (
+      (EverCrypt_CTR_state_s){
+        .i = i,
+        .iv = iv_,
+        .iv_len = iv_len,
+        .xkey = ek,
+        .ctr = c,
+        .ks = ks,
+        .ks_len = (uint32_t)0U
+      }
+    );
 }
 
 void EverCrypt_CTR_update_block(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t *src)
@@ -341,7 +383,9 @@ void EverCrypt_CTR_update_block(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t
               .iv = iv1,
               .iv_len = iv_len1,
               .xkey = ek1,
-              .ctr = c1
+              .ctr = c1,
+              .ks = scrut0.ks,
+              .ks_len = (uint32_t)0U
             }
           );
         #endif
@@ -391,7 +435,9 @@ void EverCrypt_CTR_update_block(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t
               .iv = iv1,
               .iv_len = iv_len1,
               .xkey = ek1,
-              .ctr = c1
+              .ctr = c1,
+              .ks = scrut0.ks,
+              .ks_len = (uint32_t)0U
             }
           );
         #endif
@@ -402,6 +448,20 @@ void EverCrypt_CTR_update_block(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t
         uint32_t ctx[16U] = { 0U };
         Hacl_Impl_Chacha20_chacha20_init(ctx, ek, iv, (uint32_t)0U);
         Hacl_Impl_Chacha20_chacha20_encrypt_block(ctx, dst, c0, src);
+        uint32_t c1 = c0 + (uint32_t)1U;
+        *p
+        =
+          (
+            (EverCrypt_CTR_state_s){
+              .i = Spec_Cipher_Expansion_Hacl_CHACHA20,
+              .iv = iv,
+              .iv_len = scrut.iv_len,
+              .xkey = ek,
+              .ctr = c1,
+              .ks = scrut.ks,
+              .ks_len = (uint32_t)0U
+            }
+          );
         break;
       }
     default:
@@ -412,13 +472,264 @@ void EverCrypt_CTR_update_block(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t
   }
 }
 
+static uint32_t block_len_of_impl(Spec_Cipher_Expansion_impl i)
+{
+  switch (i)
+  {
+    case Spec_Cipher_Expansion_Hacl_CHACHA20:
+      {
+        return (uint32_t)64U;
+      }
+    case Spec_Cipher_Expansion_Vale_AES128:
+      {
+        return (uint32_t)16U;
+      }
+    case Spec_Cipher_Expansion_Vale_AES256:
+      {
+        return (uint32_t)16U;
+      }
+    default:
+      {
+        KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
+        KRML_HOST_EXIT(253U);
+      }
+  }
+}
+
+uint32_t EverCrypt_CTR_block_len(EverCrypt_CTR_state_s *s)
+{
+  EverCrypt_CTR_state_s scrut = *s;
+  Spec_Cipher_Expansion_impl i = scrut.i;
+  return block_len_of_impl(i);
+}
+
+static void
+update_blocks_vale(
+  Spec_Cipher_Expansion_impl i,
+  uint8_t *ek,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint32_t c0,
+  uint8_t *dst,
+  uint8_t *src,
+  uint32_t num_blocks
+)
+{
+  #if EVERCRYPT_TARGETCONFIG_X64
+  uint32_t c = c0;
+  uint32_t rem = num_blocks;
+  uint8_t *in_b = src;
+  uint8_t *out_b = dst;
+  while (rem > (uint32_t)0U)
+  {
+    uint8_t ctr_block[16U] = { 0U };
+    memcpy(ctr_block, iv, iv_len * sizeof (uint8_t));
+    FStar_UInt128_uint128 uu____0 = load128_be(ctr_block);
+    FStar_UInt128_uint128
+    c1 = FStar_UInt128_add_mod(uu____0, FStar_UInt128_uint64_to_uint128((uint64_t)c));
+    store128_le(ctr_block, c1);
+    uint64_t lo = FStar_UInt128_uint128_to_uint64(c1) & (uint64_t)0xffffffffU;
+    uint64_t max_inc32 = (uint64_t)0x100000000U - lo;
+    uint64_t max_ctr = (uint64_t)0x100000000U - (uint64_t)c;
+    uint64_t n0 = (uint64_t)rem;
+    if (max_inc32 < n0)
+    {
+      n0 = max_inc32;
+    }
+    if (max_ctr < n0)
+    {
+      n0 = max_ctr;
+    }
+    uint32_t n = (uint32_t)n0;
+    uint8_t inout_b[16U] = { 0U };
+    switch (i)
+    {
+      case Spec_Cipher_Expansion_Vale_AES128:
+        {
+          uint64_t
+          scrut =
+            gctr128_bytes(in_b,
+              (uint64_t)n * (uint64_t)16U,
+              out_b,
+              inout_b,
+              ek,
+              ctr_block,
+              (uint64_t)n);
+          break;
+        }
+      case Spec_Cipher_Expansion_Vale_AES256:
+        {
+          uint64_t
+          scrut =
+            gctr256_bytes(in_b,
+              (uint64_t)n * (uint64_t)16U,
+              out_b,
+              inout_b,
+              ek,
+              ctr_block,
+              (uint64_t)n);
+          break;
+        }
+      default:
+        {
+          KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
+          KRML_HOST_EXIT(253U);
+        }
+    }
+    in_b = in_b + n * (uint32_t)16U;
+    out_b = out_b + n * (uint32_t)16U;
+    c = c + n;
+    rem = rem - n;
+  }
+  #endif
+}
+
+void
+EverCrypt_CTR_update_blocks(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t *src, uint32_t len)
+{
+  EverCrypt_CTR_state_s scrut = *p;
+  Spec_Cipher_Expansion_impl i = scrut.i;
+  uint8_t *iv = scrut.iv;
+  uint32_t iv_len = scrut.iv_len;
+  uint8_t *ek = scrut.xkey;
+  uint32_t c0 = scrut.ctr;
+  uint32_t num_blocks = len / block_len_of_impl(i);
+  switch (i)
+  {
+    case Spec_Cipher_Expansion_Vale_AES128:
+      {
+        update_blocks_vale(i, ek, iv, iv_len, c0, dst, src, num_blocks);
+        break;
+      }
+    case Spec_Cipher_Expansion_Vale_AES256:
+      {
+        update_blocks_vale(i, ek, iv, iv_len, c0, dst, src, num_blocks);
+        break;
+      }
+    case Spec_Cipher_Expansion_Hacl_CHACHA20:
+      {
+        uint32_t len1 = num_blocks * (uint32_t)64U;
+        bool avx2 = EverCrypt_AutoConfig2_has_avx2();
+        bool avx = EverCrypt_AutoConfig2_has_avx();
+        #if EVERCRYPT_TARGETCONFIG_X64
+        if (avx2)
+        {
+          Hacl_Chacha20_Vec256_chacha20_encrypt_256(len1, dst, src, ek, iv, c0);
+          break;
+        }
+        #endif
+        #if EVERCRYPT_TARGETCONFIG_X64
+        if (avx)
+        {
+          Hacl_Chacha20_Vec128_chacha20_encrypt_128(len1, dst, src, ek, iv, c0);
+          break;
+        }
+        #endif
+        Hacl_Chacha20_chacha20_encrypt(len1, dst, src, ek, iv, c0);
+        break;
+      }
+    default:
+      {
+        KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
+        KRML_HOST_EXIT(253U);
+      }
+  }
+  *p
+  =
+    (
+      (EverCrypt_CTR_state_s){
+        .i = i,
+        .iv = iv,
+        .iv_len = iv_len,
+        .xkey = ek,
+        .ctr = c0 + num_blocks,
+        .ks = scrut.ks,
+        .ks_len = (uint32_t)0U
+      }
+    );
+}
+
+void
+EverCrypt_CTR_update(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t *src, uint32_t len)
+{
+  EverCrypt_CTR_state_s scrut = *p;
+  uint8_t *ks = scrut.ks;
+  uint32_t ks_len = scrut.ks_len;
+  uint32_t bl = block_len_of_impl(scrut.i);
+  uint32_t n0;
+  if (ks_len < len)
+  {
+    n0 = ks_len;
+  }
+  else
+  {
+    n0 = len;
+  }
+  uint8_t *ks0 = ks + bl - ks_len;
+  for (uint32_t i = (uint32_t)0U; i < n0; i++)
+  {
+    dst[i] = EverCrypt_CTR_xor8(src[i], ks0[i]);
+  }
+  uint32_t len1 = len - n0;
+  uint32_t n_blocks = len1 / bl;
+  uint32_t rem = len1 % bl;
+  if (n_blocks > (uint32_t)0U)
+  {
+    EverCrypt_CTR_update_blocks(p, dst + n0, src + n0, n_blocks * bl);
+  }
+  if (rem > (uint32_t)0U)
+  {
+    uint8_t zeros[64U] = { 0U };
+    EverCrypt_CTR_update_blocks(p, ks, zeros, bl);
+    uint8_t *src1 = src + n0 + n_blocks * bl;
+    uint8_t *dst1 = dst + n0 + n_blocks * bl;
+    for (uint32_t i = (uint32_t)0U; i < rem; i++)
+    {
+      dst1[i] = EverCrypt_CTR_xor8(src1[i], ks[i]);
+    }
+    EverCrypt_CTR_state_s scrut0 = *p;
+    *p
+    =
+      (
+        (EverCrypt_CTR_state_s){
+          .i = scrut0.i,
+          .iv = scrut0.iv,
+          .iv_len = scrut0.iv_len,
+          .xkey = scrut0.xkey,
+          .ctr = scrut0.ctr,
+          .ks = ks,
+          .ks_len = bl - rem
+        }
+      );
+  }
+  else if (n_blocks == (uint32_t)0U)
+  {
+    EverCrypt_CTR_state_s scrut0 = *p;
+    *p
+    =
+      (
+        (EverCrypt_CTR_state_s){
+          .i = scrut0.i,
+          .iv = scrut0.iv,
+          .iv_len = scrut0.iv_len,
+          .xkey = scrut0.xkey,
+          .ctr = scrut0.ctr,
+          .ks = ks,
+          .ks_len = ks_len - n0
+        }
+      );
+  }
+}
+
 void EverCrypt_CTR_free(EverCrypt_CTR_state_s *p)
 {
   EverCrypt_CTR_state_s scrut = *p;
   uint8_t *iv = scrut.iv;
   uint8_t *ek = scrut.xkey;
+  uint8_t *ks = scrut.ks;
   KRML_HOST_FREE(iv);
   KRML_HOST_FREE(ek);
+  KRML_HOST_FREE(ks);
   KRML_HOST_FREE(p);
 }
 
@@ -39,6 +39,8 @@ extern "C" {
 
 #include "Hacl_Chacha20.h"
 #include "Hacl_Kremlib.h"
+#include "Hacl_Chacha20_Vec128.h"
+#include "Hacl_Chacha20_Vec256.h"
 #include "Vale.h"
 #include "EverCrypt_AutoConfig2.h"
 #include "EverCrypt_Error.h"
@@ -79,6 +81,18 @@ EverCrypt_CTR___proj__State__item__ctr(
   EverCrypt_CTR_state_s projectee
 );
 
+uint8_t
+*EverCrypt_CTR___proj__State__item__ks(
+  Spec_Agile_Cipher_cipher_alg a,
+  EverCrypt_CTR_state_s projectee
+);
+
+uint32_t
+EverCrypt_CTR___proj__State__item__ks_len(
+  Spec_Agile_Cipher_cipher_alg a,
+  EverCrypt_CTR_state_s projectee
+);
+
 typedef uint8_t EverCrypt_CTR_uint8;
 
 uint8_t EverCrypt_CTR_xor8(uint8_t a, uint8_t b);
@@ -108,6 +122,14 @@ EverCrypt_CTR_init(
 
 void EverCrypt_CTR_update_block(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t *src);
 
+uint32_t EverCrypt_CTR_block_len(EverCrypt_CTR_state_s *s);
+
+void
+EverCrypt_CTR_update_blocks(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t *src, uint32_t len);
+
+void
+EverCrypt_CTR_update(EverCrypt_CTR_state_s *p, uint8_t *dst, uint8_t *src, uint32_t len);
+
 void EverCrypt_CTR_free(EverCrypt_CTR_state_s *p);
 
 #if defined(__cplusplus)
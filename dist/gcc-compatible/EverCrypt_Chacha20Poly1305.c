@@ -36,9 +36,17 @@ EverCrypt_Chacha20Poly1305_aead_encrypt(
   uint8_t *tag
 )
 {
+  bool avx512 = EverCrypt_AutoConfig2_has_avx512();
   bool avx2 = EverCrypt_AutoConfig2_has_avx2();
   bool avx = EverCrypt_AutoConfig2_has_avx();
   #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx512)
+  {
+    Hacl_Chacha20Poly1305_512_aead_encrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
+    return;
+  }
+  #endif
+  #if EVERCRYPT_TARGETCONFIG_X64
   if (avx2)
   {
     Hacl_Chacha20Poly1305_256_aead_encrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
@@ -67,9 +75,16 @@ EverCrypt_Chacha20Poly1305_aead_decrypt(
   uint8_t *tag
 )
 {
+  bool avx512 = EverCrypt_AutoConfig2_has_avx512();
   bool avx2 = EverCrypt_AutoConfig2_has_avx2();
   bool avx = EverCrypt_AutoConfig2_has_avx();
   #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx512)
+  {
+    return Hacl_Chacha20Poly1305_512_aead_decrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
+  }
+  #endif
+  #if EVERCRYPT_TARGETCONFIG_X64
   if (avx2)
   {
     return Hacl_Chacha20Poly1305_256_aead_decrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
@@ -84,3 +99,125 @@ EverCrypt_Chacha20Poly1305_aead_decrypt(
   return Hacl_Chacha20Poly1305_32_aead_decrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
 }
 
+/* The 2-lane Poly1305 of the 128-bit batch implementation is slower than the
+   single-message one beyond a few blocks: only use it for short records. */
+static bool short_records(uint32_t num, uint32_t *mlen)
+{
+  uint64_t total = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < num; i++)
+  {
+    total = total + (uint64_t)mlen[i];
+  }
+  return total <= (uint64_t)512U * (uint64_t)num;
+}
+
+void
+EverCrypt_Chacha20Poly1305_aead_encrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+)
+{
+  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
+  bool avx = EverCrypt_AutoConfig2_has_avx();
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx2)
+  {
+    Hacl_Chacha20Poly1305_256_aead_encrypt_multi(num, k, n, aadlen, aad, mlen, m, cipher, tag);
+    return;
+  }
+  #endif
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx && short_records(num, mlen))
+  {
+    Hacl_Chacha20Poly1305_128_aead_encrypt_multi(num, k, n, aadlen, aad, mlen, m, cipher, tag);
+    return;
+  }
+  #endif
+  for (uint32_t i = (uint32_t)0U; i < num; i++)
+  {
+    EverCrypt_Chacha20Poly1305_aead_encrypt(k[i],
+      n[i],
+      aadlen[i],
+      aad[i],
+      mlen[i],
+      m[i],
+      cipher[i],
+      tag[i]);
+  }
+}
+
+uint32_t
+EverCrypt_Chacha20Poly1305_aead_decrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+)
+{
+  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
+  bool avx = EverCrypt_AutoConfig2_has_avx();
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx2)
+  {
+    return
+      Hacl_Chacha20Poly1305_256_aead_decrypt_multi(num,
+        k,
+        n,
+        aadlen,
+        aad,
+        mlen,
+        m,
+        cipher,
+        tag,
+        res);
+  }
+  #endif
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx && short_records(num, mlen))
+  {
+    return
+      Hacl_Chacha20Poly1305_128_aead_decrypt_multi(num,
+        k,
+        n,
+        aadlen,
+        aad,
+        mlen,
+        m,
+        cipher,
+        tag,
+        res);
+  }
+  #endif
+  uint32_t r = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < num; i++)
+  {
+    res[i] =
+      EverCrypt_Chacha20Poly1305_aead_decrypt(k[i],
+        n[i],
+        aadlen[i],
+        aad[i],
+        mlen[i],
+        m[i],
+        cipher[i],
+        tag[i]);
+    if (res[i] != (uint32_t)0U)
+    {
+      memset(m[i], 0U, mlen[i] * sizeof (uint8_t));
+    }
+    r = r | res[i];
+  }
+  return r;
+}
@@ -66,3 +66,24 @@ bool EverCrypt_Curve25519_ecdh(uint8_t *shared, uint8_t *my_priv, uint8_t *their
   return Hacl_Curve25519_51_ecdh(shared, my_priv, their_pub);
 }
 
+void
+EverCrypt_Curve25519_batch_scalarmult(
+  uint32_t n,
+  uint8_t **shared,
+  uint8_t **my_priv,
+  uint8_t **their_pub
+)
+{
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (EverCrypt_AutoConfig2_has_avx2())
+  {
+    Hacl_Curve25519_256_batch_scalarmult(n, shared, my_priv, their_pub);
+    return;
+  }
+  #endif
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    EverCrypt_Curve25519_scalarmult(shared[i], my_priv[i], their_pub[i]);
+  }
+}
+
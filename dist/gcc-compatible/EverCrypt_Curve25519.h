@@ -40,6 +40,7 @@ extern "C" {
 #include "EverCrypt_AutoConfig2.h"
 #include "Hacl_Curve25519_64.h"
 #include "Hacl_Curve25519_51.h"
+#include "Hacl_Curve25519_256.h"
 
 void EverCrypt_Curve25519_secret_to_public(uint8_t *pub, uint8_t *priv);
 
@@ -47,6 +48,14 @@ void EverCrypt_Curve25519_scalarmult(uint8_t *shared, uint8_t *my_priv, uint8_t
 
 bool EverCrypt_Curve25519_ecdh(uint8_t *shared, uint8_t *my_priv, uint8_t *their_pub);
 
+void
+EverCrypt_Curve25519_batch_scalarmult(
+  uint32_t n,
+  uint8_t **shared,
+  uint8_t **my_priv,
+  uint8_t **their_pub
+);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -34,6 +34,19 @@ bool EverCrypt_Ed25519_verify(uint8_t *output, uint32_t len, uint8_t *msg, uint8
   return Hacl_Ed25519_verify(output, len, msg, signature);
 }
 
+bool
+EverCrypt_Ed25519_verify_batch(
+  uint32_t n,
+  uint8_t **pub,
+  uint32_t *len,
+  uint8_t **msg,
+  uint8_t **signature,
+  bool *res
+)
+{
+  return Hacl_Ed25519_verify_batch(n, pub, len, msg, signature, res);
+}
+
 void EverCrypt_Ed25519_secret_to_public(uint8_t *output, uint8_t *secret)
 {
   Hacl_Ed25519_secret_to_public(output, secret);
@@ -1210,6 +1210,96 @@ void EverCrypt_Hash_hash_224(uint8_t *input, uint32_t input_len, uint8_t *dst)
   Hacl_Hash_Core_SHA2_finish_224(s, dst);
 }
 
+void
+EverCrypt_Hash_hash_256_multi(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst)
+{
+  bool shaext = EverCrypt_AutoConfig2_has_shaext();
+  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
+  bool avx = EverCrypt_AutoConfig2_has_avx();
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx2 && !shaext && n > (uint32_t)4U)
+  {
+    Hacl_SHA2_Vec256_sha256_multi(n, inputs, lens, dst);
+    return;
+  }
+  #endif
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx && !shaext && n > (uint32_t)1U)
+  {
+    Hacl_SHA2_Vec128_sha256_multi(n, inputs, lens, dst);
+    return;
+  }
+  #endif
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    EverCrypt_Hash_hash_256(inputs[i], lens[i], dst[i]);
+  }
+}
+
+static void
+hash_512_multi(
+  bool is384,
+  uint32_t n,
+  uint8_t **inputs,
+  uint32_t *lens,
+  uint8_t **dst
+)
+{
+  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
+  bool avx = EverCrypt_AutoConfig2_has_avx();
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx2 && n > (uint32_t)2U)
+  {
+    if (is384)
+    {
+      Hacl_SHA2_Vec256_sha384_multi(n, inputs, lens, dst);
+    }
+    else
+    {
+      Hacl_SHA2_Vec256_sha512_multi(n, inputs, lens, dst);
+    }
+    return;
+  }
+  #endif
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx && n > (uint32_t)1U)
+  {
+    if (is384)
+    {
+      Hacl_SHA2_Vec128_sha384_multi(n, inputs, lens, dst);
+    }
+    else
+    {
+      Hacl_SHA2_Vec128_sha512_multi(n, inputs, lens, dst);
+    }
+    return;
+  }
+  #endif
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    if (is384)
+    {
+      Hacl_Hash_SHA2_hash_384(inputs[i], lens[i], dst[i]);
+    }
+    else
+    {
+      Hacl_Hash_SHA2_hash_512(inputs[i], lens[i], dst[i]);
+    }
+  }
+}
+
+void
+EverCrypt_Hash_hash_384_multi(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst)
+{
+  hash_512_multi(true, n, inputs, lens, dst);
+}
+
+void
+EverCrypt_Hash_hash_512_multi(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst)
+{
+  hash_512_multi(false, n, inputs, lens, dst);
+}
+
 void
 EverCrypt_Hash_hash(
   Spec_Hash_Definitions_hash_alg a,
@@ -1268,6 +1358,42 @@ EverCrypt_Hash_hash(
   }
 }
 
+void
+EverCrypt_Hash_hash_multi(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t n,
+  uint8_t **inputs,
+  uint32_t *lens,
+  uint8_t **dst
+)
+{
+  switch (a)
+  {
+    case Spec_Hash_Definitions_SHA2_256:
+      {
+        EverCrypt_Hash_hash_256_multi(n, inputs, lens, dst);
+        break;
+      }
+    case Spec_Hash_Definitions_SHA2_384:
+      {
+        EverCrypt_Hash_hash_384_multi(n, inputs, lens, dst);
+        break;
+      }
+    case Spec_Hash_Definitions_SHA2_512:
+      {
+        EverCrypt_Hash_hash_512_multi(n, inputs, lens, dst);
+        break;
+      }
+    default:
+      {
+        for (uint32_t i = (uint32_t)0U; i < n; i++)
+        {
+          EverCrypt_Hash_hash(a, dst[i], inputs[i], lens[i]);
+        }
+      }
+  }
+}
+
 typedef struct Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s_____s
 {
   EverCrypt_Hash_state_s *block_state;
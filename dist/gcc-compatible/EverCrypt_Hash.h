@@ -41,6 +41,8 @@ extern "C" {
 #include "Hacl_Impl_Blake2_Constants.h"
 #include "Vale.h"
 #include "Hacl_Hash.h"
+#include "Hacl_SHA2_Vec256.h"
+#include "Hacl_SHA2_Vec128.h"
 #include "EverCrypt_AutoConfig2.h"
 #include "Hacl_Spec.h"
 
@@ -236,6 +238,20 @@ void EverCrypt_Hash_hash_256(uint8_t *input, uint32_t input_len, uint8_t *dst);
 
 void EverCrypt_Hash_hash_224(uint8_t *input, uint32_t input_len, uint8_t *dst);
 
+/* Hashes n independent messages with SHA2-256: dst[i] receives the digest of
+   the lens[i] bytes at inputs[i]. On CPUs without SHA extensions, messages are
+   interleaved across the lanes of 128-bit or 256-bit vectors. */
+void
+EverCrypt_Hash_hash_256_multi(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst);
+
+/* Same as EverCrypt_Hash_hash_256_multi, for SHA2-384 and SHA2-512, with 2
+   or 4 lanes of 64-bit words. */
+void
+EverCrypt_Hash_hash_384_multi(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst);
+
+void
+EverCrypt_Hash_hash_512_multi(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst);
+
 void
 EverCrypt_Hash_hash(
   Spec_Hash_Definitions_hash_alg a,
@@ -244,6 +260,18 @@ EverCrypt_Hash_hash(
   uint32_t len
 );
 
+/* Batch hashing: dst[i] receives the hash of the lens[i] bytes at inputs[i].
+   SHA2-256, SHA2-384 and SHA2-512 use the multi-buffer implementations above;
+   other algorithms hash one message at a time. */
+void
+EverCrypt_Hash_hash_multi(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t n,
+  uint8_t **inputs,
+  uint32_t *lens,
+  uint8_t **dst
+);
+
 typedef struct Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s_____s
 Hacl_Streaming_Functor_state_s___EverCrypt_Hash_state_s____;
 
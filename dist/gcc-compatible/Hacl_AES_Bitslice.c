@@ -0,0 +1,491 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_AES_Bitslice.h"
+
+
+static inline void aes_sbox(uint64_t *q)
+{
+  uint64_t x0 = q[7U];
+  uint64_t x1 = q[6U];
+  uint64_t x2 = q[5U];
+  uint64_t x3 = q[4U];
+  uint64_t x4 = q[3U];
+  uint64_t x5 = q[2U];
+  uint64_t x6 = q[1U];
+  uint64_t x7 = q[0U];
+  uint64_t y14 = x3 ^ x5;
+  uint64_t y13 = x0 ^ x6;
+  uint64_t y9 = x0 ^ x3;
+  uint64_t y8 = x0 ^ x5;
+  uint64_t t0 = x1 ^ x2;
+  uint64_t y1 = t0 ^ x7;
+  uint64_t y4 = y1 ^ x3;
+  uint64_t y12 = y13 ^ y14;
+  uint64_t y2 = y1 ^ x0;
+  uint64_t y5 = y1 ^ x6;
+  uint64_t y3 = y5 ^ y8;
+  uint64_t t1 = x4 ^ y12;
+  uint64_t y15 = t1 ^ x5;
+  uint64_t y20 = t1 ^ x1;
+  uint64_t y6 = y15 ^ x7;
+  uint64_t y10 = y15 ^ t0;
+  uint64_t y11 = y20 ^ y9;
+  uint64_t y7 = x7 ^ y11;
+  uint64_t y17 = y10 ^ y11;
+  uint64_t y19 = y10 ^ y8;
+  uint64_t y16 = t0 ^ y11;
+  uint64_t y21 = y13 ^ y16;
+  uint64_t y18 = x0 ^ y16;
+  uint64_t t2 = y12 & y15;
+  uint64_t t3 = y3 & y6;
+  uint64_t t4 = t3 ^ t2;
+  uint64_t t5 = y4 & x7;
+  uint64_t t6 = t5 ^ t2;
+  uint64_t t7 = y13 & y16;
+  uint64_t t8 = y5 & y1;
+  uint64_t t9 = t8 ^ t7;
+  uint64_t t10 = y2 & y7;
+  uint64_t t11 = t10 ^ t7;
+  uint64_t t12 = y9 & y11;
+  uint64_t t13 = y14 & y17;
+  uint64_t t14 = t13 ^ t12;
+  uint64_t t15 = y8 & y10;
+  uint64_t t16 = t15 ^ t12;
+  uint64_t t17 = t4 ^ t14;
+  uint64_t t18 = t6 ^ t16;
+  uint64_t t19 = t9 ^ t14;
+  uint64_t t20 = t11 ^ t16;
+  uint64_t t21 = t17 ^ y20;
+  uint64_t t22 = t18 ^ y19;
+  uint64_t t23 = t19 ^ y21;
+  uint64_t t24 = t20 ^ y18;
+  uint64_t t25 = t21 ^ t22;
+  uint64_t t26 = t21 & t23;
+  uint64_t t27 = t24 ^ t26;
+  uint64_t t28 = t25 & t27;
+  uint64_t t29 = t28 ^ t22;
+  uint64_t t30 = t23 ^ t24;
+  uint64_t t31 = t22 ^ t26;
+  uint64_t t32 = t31 & t30;
+  uint64_t t33 = t32 ^ t24;
+  uint64_t t34 = t23 ^ t33;
+  uint64_t t35 = t27 ^ t33;
+  uint64_t t36 = t24 & t35;
+  uint64_t t37 = t36 ^ t34;
+  uint64_t t38 = t27 ^ t36;
+  uint64_t t39 = t29 & t38;
+  uint64_t t40 = t25 ^ t39;
+  uint64_t t41 = t40 ^ t37;
+  uint64_t t42 = t29 ^ t33;
+  uint64_t t43 = t29 ^ t40;
+  uint64_t t44 = t33 ^ t37;
+  uint64_t t45 = t42 ^ t41;
+  uint64_t z0 = t44 & y15;
+  uint64_t z1 = t37 & y6;
+  uint64_t z2 = t33 & x7;
+  uint64_t z3 = t43 & y16;
+  uint64_t z4 = t40 & y1;
+  uint64_t z5 = t29 & y7;
+  uint64_t z6 = t42 & y11;
+  uint64_t z7 = t45 & y17;
+  uint64_t z8 = t41 & y10;
+  uint64_t z9 = t44 & y12;
+  uint64_t z10 = t37 & y3;
+  uint64_t z11 = t33 & y4;
+  uint64_t z12 = t43 & y13;
+  uint64_t z13 = t40 & y5;
+  uint64_t z14 = t29 & y2;
+  uint64_t z15 = t42 & y9;
+  uint64_t z16 = t45 & y14;
+  uint64_t z17 = t41 & y8;
+  uint64_t t46 = z15 ^ z16;
+  uint64_t t47 = z10 ^ z11;
+  uint64_t t48 = z5 ^ z13;
+  uint64_t t49 = z9 ^ z10;
+  uint64_t t50 = z2 ^ z12;
+  uint64_t t51 = z2 ^ z5;
+  uint64_t t52 = z7 ^ z8;
+  uint64_t t53 = z0 ^ z3;
+  uint64_t t54 = z6 ^ z7;
+  uint64_t t55 = z16 ^ z17;
+  uint64_t t56 = z12 ^ t48;
+  uint64_t t57 = t50 ^ t53;
+  uint64_t t58 = z4 ^ t46;
+  uint64_t t59 = z3 ^ t54;
+  uint64_t t60 = t46 ^ t57;
+  uint64_t t61 = z14 ^ t57;
+  uint64_t t62 = t52 ^ t58;
+  uint64_t t63 = t49 ^ t58;
+  uint64_t t64 = z4 ^ t59;
+  uint64_t t65 = t61 ^ t62;
+  uint64_t t66 = z1 ^ t63;
+  uint64_t s0 = t59 ^ t63;
+  uint64_t s6 = t56 ^ (~t62);
+  uint64_t s7 = t48 ^ (~t60);
+  uint64_t t67 = t64 ^ t65;
+  uint64_t s3 = t53 ^ t66;
+  uint64_t s4 = t51 ^ t66;
+  uint64_t s5 = t47 ^ t65;
+  uint64_t s1 = t64 ^ (~s3);
+  uint64_t s2 = t55 ^ (~t67);
+  q[7U] = s0;
+  q[6U] = s1;
+  q[5U] = s2;
+  q[4U] = s3;
+  q[3U] = s4;
+  q[2U] = s5;
+  q[1U] = s6;
+  q[0U] = s7;
+}
+
+static inline void aes_shift_rows(uint64_t *q)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    uint64_t x = q[i];
+    q[i] =
+      (x & (uint64_t)0xffffU)
+      | ((x & (uint64_t)0xfff00000U) >> (uint32_t)4U)
+      | ((x & (uint64_t)0xf0000U) << (uint32_t)12U)
+      | ((x & (uint64_t)0xff0000000000U) >> (uint32_t)8U)
+      | ((x & (uint64_t)0xff00000000U) << (uint32_t)8U)
+      | ((x & (uint64_t)0xf000000000000000U) >> (uint32_t)12U)
+      | ((x & (uint64_t)0xfff000000000000U) << (uint32_t)4U);
+  }
+}
+
+static inline void aes_mix_columns(uint64_t *q)
+{
+  uint64_t q0 = q[0U];
+  uint64_t q1 = q[1U];
+  uint64_t q2 = q[2U];
+  uint64_t q3 = q[3U];
+  uint64_t q4 = q[4U];
+  uint64_t q5 = q[5U];
+  uint64_t q6 = q[6U];
+  uint64_t q7 = q[7U];
+  uint64_t r0 = (q0 >> (uint32_t)16U) | (q0 << (uint32_t)48U);
+  uint64_t r1 = (q1 >> (uint32_t)16U) | (q1 << (uint32_t)48U);
+  uint64_t r2 = (q2 >> (uint32_t)16U) | (q2 << (uint32_t)48U);
+  uint64_t r3 = (q3 >> (uint32_t)16U) | (q3 << (uint32_t)48U);
+  uint64_t r4 = (q4 >> (uint32_t)16U) | (q4 << (uint32_t)48U);
+  uint64_t r5 = (q5 >> (uint32_t)16U) | (q5 << (uint32_t)48U);
+  uint64_t r6 = (q6 >> (uint32_t)16U) | (q6 << (uint32_t)48U);
+  uint64_t r7 = (q7 >> (uint32_t)16U) | (q7 << (uint32_t)48U);
+  uint64_t u0 = q0 ^ r0;
+  uint64_t u1 = q1 ^ r1;
+  uint64_t u2 = q2 ^ r2;
+  uint64_t u3 = q3 ^ r3;
+  uint64_t u4 = q4 ^ r4;
+  uint64_t u5 = q5 ^ r5;
+  uint64_t u6 = q6 ^ r6;
+  uint64_t u7 = q7 ^ r7;
+  q[0U] = q7 ^ r7 ^ r0 ^ ((u0 << (uint32_t)32U) | (u0 >> (uint32_t)32U));
+  q[1U] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ ((u1 << (uint32_t)32U) | (u1 >> (uint32_t)32U));
+  q[2U] = q1 ^ r1 ^ r2 ^ ((u2 << (uint32_t)32U) | (u2 >> (uint32_t)32U));
+  q[3U] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ ((u3 << (uint32_t)32U) | (u3 >> (uint32_t)32U));
+  q[4U] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ ((u4 << (uint32_t)32U) | (u4 >> (uint32_t)32U));
+  q[5U] = q4 ^ r4 ^ r5 ^ ((u5 << (uint32_t)32U) | (u5 >> (uint32_t)32U));
+  q[6U] = q5 ^ r5 ^ r6 ^ ((u6 << (uint32_t)32U) | (u6 >> (uint32_t)32U));
+  q[7U] = q6 ^ r6 ^ r7 ^ ((u7 << (uint32_t)32U) | (u7 >> (uint32_t)32U));
+}
+
+static inline void aes_add_round_key(uint64_t *q, uint64_t *skey)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    q[i] = q[i] ^ skey[i];
+  }
+}
+
+static inline void aes_encrypt(uint32_t nr, uint64_t *skey, uint64_t *q)
+{
+  aes_add_round_key(q, skey);
+  for (uint32_t i = (uint32_t)1U; i < nr; i++)
+  {
+    aes_sbox(q);
+    aes_shift_rows(q);
+    aes_mix_columns(q);
+    aes_add_round_key(q, skey + (uint32_t)8U * i);
+  }
+  aes_sbox(q);
+  aes_shift_rows(q);
+  aes_add_round_key(q, skey + (uint32_t)8U * nr);
+}
+
+void Hacl_AES_Bitslice_ortho(uint64_t *q)
+{
+  uint64_t cl1 = (uint64_t)0x5555555555555555U;
+  uint64_t ch1 = (uint64_t)0xaaaaaaaaaaaaaaaaU;
+  uint64_t a01 = q[0U];
+  uint64_t b01 = q[1U];
+  q[0U] = (a01 & cl1) | ((b01 & cl1) << (uint32_t)1U);
+  q[1U] = ((a01 & ch1) >> (uint32_t)1U) | (b01 & ch1);
+  uint64_t a23 = q[2U];
+  uint64_t b23 = q[3U];
+  q[2U] = (a23 & cl1) | ((b23 & cl1) << (uint32_t)1U);
+  q[3U] = ((a23 & ch1) >> (uint32_t)1U) | (b23 & ch1);
+  uint64_t a45 = q[4U];
+  uint64_t b45 = q[5U];
+  q[4U] = (a45 & cl1) | ((b45 & cl1) << (uint32_t)1U);
+  q[5U] = ((a45 & ch1) >> (uint32_t)1U) | (b45 & ch1);
+  uint64_t a67 = q[6U];
+  uint64_t b67 = q[7U];
+  q[6U] = (a67 & cl1) | ((b67 & cl1) << (uint32_t)1U);
+  q[7U] = ((a67 & ch1) >> (uint32_t)1U) | (b67 & ch1);
+  uint64_t cl2 = (uint64_t)0x3333333333333333U;
+  uint64_t ch2 = (uint64_t)0xccccccccccccccccU;
+  uint64_t a02 = q[0U];
+  uint64_t b02 = q[2U];
+  q[0U] = (a02 & cl2) | ((b02 & cl2) << (uint32_t)2U);
+  q[2U] = ((a02 & ch2) >> (uint32_t)2U) | (b02 & ch2);
+  uint64_t a13 = q[1U];
+  uint64_t b13 = q[3U];
+  q[1U] = (a13 & cl2) | ((b13 & cl2) << (uint32_t)2U);
+  q[3U] = ((a13 & ch2) >> (uint32_t)2U) | (b13 & ch2);
+  uint64_t a46 = q[4U];
+  uint64_t b46 = q[6U];
+  q[4U] = (a46 & cl2) | ((b46 & cl2) << (uint32_t)2U);
+  q[6U] = ((a46 & ch2) >> (uint32_t)2U) | (b46 & ch2);
+  uint64_t a57 = q[5U];
+  uint64_t b57 = q[7U];
+  q[5U] = (a57 & cl2) | ((b57 & cl2) << (uint32_t)2U);
+  q[7U] = ((a57 & ch2) >> (uint32_t)2U) | (b57 & ch2);
+  uint64_t cl4 = (uint64_t)0xf0f0f0f0f0f0f0fU;
+  uint64_t ch4 = (uint64_t)0xf0f0f0f0f0f0f0f0U;
+  uint64_t a04 = q[0U];
+  uint64_t b04 = q[4U];
+  q[0U] = (a04 & cl4) | ((b04 & cl4) << (uint32_t)4U);
+  q[4U] = ((a04 & ch4) >> (uint32_t)4U) | (b04 & ch4);
+  uint64_t a15 = q[1U];
+  uint64_t b15 = q[5U];
+  q[1U] = (a15 & cl4) | ((b15 & cl4) << (uint32_t)4U);
+  q[5U] = ((a15 & ch4) >> (uint32_t)4U) | (b15 & ch4);
+  uint64_t a26 = q[2U];
+  uint64_t b26 = q[6U];
+  q[2U] = (a26 & cl4) | ((b26 & cl4) << (uint32_t)4U);
+  q[6U] = ((a26 & ch4) >> (uint32_t)4U) | (b26 & ch4);
+  uint64_t a37 = q[3U];
+  uint64_t b37 = q[7U];
+  q[3U] = (a37 & cl4) | ((b37 & cl4) << (uint32_t)4U);
+  q[7U] = ((a37 & ch4) >> (uint32_t)4U) | (b37 & ch4);
+}
+
+static const
+uint32_t
+aes_rcon[10U] =
+  {
+    (uint32_t)0x01U, (uint32_t)0x02U, (uint32_t)0x04U, (uint32_t)0x08U, (uint32_t)0x10U,
+    (uint32_t)0x20U, (uint32_t)0x40U, (uint32_t)0x80U, (uint32_t)0x1bU, (uint32_t)0x36U
+  };
+
+/* Spreads the bytes of a block over two words: each word holds two of its
+   columns, one byte every 16 bits, leaving room for three more blocks. */
+static inline void aes_interleave_in(uint64_t *q0, uint64_t *q1, uint8_t *b)
+{
+  uint64_t x0 = (uint64_t)load32_le(b);
+  uint64_t x1 = (uint64_t)load32_le(b + (uint32_t)4U);
+  uint64_t x2 = (uint64_t)load32_le(b + (uint32_t)8U);
+  uint64_t x3 = (uint64_t)load32_le(b + (uint32_t)12U);
+  x0 = (x0 | x0 << (uint32_t)16U) & (uint64_t)0x0000ffff0000ffffU;
+  x1 = (x1 | x1 << (uint32_t)16U) & (uint64_t)0x0000ffff0000ffffU;
+  x2 = (x2 | x2 << (uint32_t)16U) & (uint64_t)0x0000ffff0000ffffU;
+  x3 = (x3 | x3 << (uint32_t)16U) & (uint64_t)0x0000ffff0000ffffU;
+  x0 = (x0 | x0 << (uint32_t)8U) & (uint64_t)0x00ff00ff00ff00ffU;
+  x1 = (x1 | x1 << (uint32_t)8U) & (uint64_t)0x00ff00ff00ff00ffU;
+  x2 = (x2 | x2 << (uint32_t)8U) & (uint64_t)0x00ff00ff00ff00ffU;
+  x3 = (x3 | x3 << (uint32_t)8U) & (uint64_t)0x00ff00ff00ff00ffU;
+  q0[0U] = x0 | x2 << (uint32_t)8U;
+  q1[0U] = x1 | x3 << (uint32_t)8U;
+}
+
+static inline void aes_interleave_out(uint8_t *b, uint64_t q0, uint64_t q1)
+{
+  uint64_t x0 = q0 & (uint64_t)0x00ff00ff00ff00ffU;
+  uint64_t x1 = q1 & (uint64_t)0x00ff00ff00ff00ffU;
+  uint64_t x2 = q0 >> (uint32_t)8U & (uint64_t)0x00ff00ff00ff00ffU;
+  uint64_t x3 = q1 >> (uint32_t)8U & (uint64_t)0x00ff00ff00ff00ffU;
+  x0 = (x0 | x0 >> (uint32_t)8U) & (uint64_t)0x0000ffff0000ffffU;
+  x1 = (x1 | x1 >> (uint32_t)8U) & (uint64_t)0x0000ffff0000ffffU;
+  x2 = (x2 | x2 >> (uint32_t)8U) & (uint64_t)0x0000ffff0000ffffU;
+  x3 = (x3 | x3 >> (uint32_t)8U) & (uint64_t)0x0000ffff0000ffffU;
+  store32_le(b, (uint32_t)x0 | (uint32_t)(x0 >> (uint32_t)16U));
+  store32_le(b + (uint32_t)4U, (uint32_t)x1 | (uint32_t)(x1 >> (uint32_t)16U));
+  store32_le(b + (uint32_t)8U, (uint32_t)x2 | (uint32_t)(x2 >> (uint32_t)16U));
+  store32_le(b + (uint32_t)12U, (uint32_t)x3 | (uint32_t)(x3 >> (uint32_t)16U));
+}
+
+static uint32_t aes_sub_word(uint32_t x)
+{
+  uint64_t q[8U] = { 0U };
+  q[0U] = (uint64_t)x;
+  Hacl_AES_Bitslice_ortho(q);
+  aes_sbox(q);
+  Hacl_AES_Bitslice_ortho(q);
+  return (uint32_t)q[0U];
+}
+
+/* The round keys are stored bitsliced, as the state: 8 words per round, each
+   holding the same key bit for all four blocks. */
+static void aes_key_expansion(uint32_t nk, uint32_t nr, uint64_t *skey, uint8_t *key)
+{
+  uint32_t w[60U] = { 0U };
+  uint32_t nkf = (nr + (uint32_t)1U) * (uint32_t)4U;
+  for (uint32_t i = (uint32_t)0U; i < nk; i++)
+  {
+    w[i] = load32_le(key + (uint32_t)4U * i);
+  }
+  uint32_t tmp = w[nk - (uint32_t)1U];
+  uint32_t j = (uint32_t)0U;
+  uint32_t k = (uint32_t)0U;
+  for (uint32_t i = nk; i < nkf; i++)
+  {
+    if (j == (uint32_t)0U)
+    {
+      tmp = tmp << (uint32_t)24U | tmp >> (uint32_t)8U;
+      tmp = aes_sub_word(tmp) ^ aes_rcon[k];
+    }
+    else if (nk > (uint32_t)6U && j == (uint32_t)4U)
+    {
+      tmp = aes_sub_word(tmp);
+    }
+    tmp = tmp ^ w[i - nk];
+    w[i] = tmp;
+    j++;
+    if (j == nk)
+    {
+      j = (uint32_t)0U;
+      k++;
+    }
+  }
+  for (uint32_t i = (uint32_t)0U; i <= nr; i++)
+  {
+    uint8_t b[16U] = { 0U };
+    for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+    {
+      store32_le(b + (uint32_t)4U * l, w[(uint32_t)4U * i + l]);
+    }
+    uint64_t q[8U] = { 0U };
+    aes_interleave_in(q, q + (uint32_t)4U, b);
+    q[1U] = q[0U];
+    q[2U] = q[0U];
+    q[3U] = q[0U];
+    q[5U] = q[4U];
+    q[6U] = q[4U];
+    q[7U] = q[4U];
+    Hacl_AES_Bitslice_ortho(q);
+    for (uint32_t h = (uint32_t)0U; h < (uint32_t)2U; h++)
+    {
+      uint64_t *q0 = q + (uint32_t)4U * h;
+      uint64_t
+      comp =
+        (q0[0U] & (uint64_t)0x1111111111111111U)
+        | (q0[1U] & (uint64_t)0x2222222222222222U)
+        | (q0[2U] & (uint64_t)0x4444444444444444U)
+        | (q0[3U] & (uint64_t)0x8888888888888888U);
+      for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+      {
+        uint64_t x = comp >> l & (uint64_t)0x1111111111111111U;
+        skey[(uint32_t)8U * i + (uint32_t)4U * h + l] = (x << (uint32_t)4U) - x;
+      }
+    }
+  }
+}
+
+void Hacl_AES_Bitslice_aes128_key_expansion(uint64_t *skey, uint8_t *key)
+{
+  aes_key_expansion((uint32_t)4U, (uint32_t)10U, skey, key);
+}
+
+void Hacl_AES_Bitslice_aes256_key_expansion(uint64_t *skey, uint8_t *key)
+{
+  aes_key_expansion((uint32_t)8U, (uint32_t)14U, skey, key);
+}
+
+/* Loads the four counter blocks ctr_block + ctr .. ctr_block + ctr + 3, where
+   the counter is the last 32 bits of the block, big-endian. */
+void Hacl_AES_Bitslice_load_ctr(uint64_t *q, uint8_t *ctr_block, uint32_t ctr)
+{
+  uint8_t b[16U] = { 0U };
+  memcpy(b, ctr_block, (uint32_t)12U * sizeof (uint8_t));
+  uint32_t c0 = load32_be(ctr_block + (uint32_t)12U);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    store32_be(b + (uint32_t)12U, c0 + ctr + i);
+    aes_interleave_in(q + i, q + i + (uint32_t)4U, b);
+  }
+}
+
+/* Xors len <= 64 bytes with the four keystream blocks in q. */
+void Hacl_AES_Bitslice_xor_blocks(uint32_t len, uint8_t *out, uint8_t *inp, uint64_t *q)
+{
+  uint8_t ks[64U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    aes_interleave_out(ks + (uint32_t)16U * i, q[i], q[i + (uint32_t)4U]);
+  }
+  uint32_t i = (uint32_t)0U;
+  for (; i + (uint32_t)8U <= len; i = i + (uint32_t)8U)
+  {
+    store64_le(out + i, load64_le(inp + i) ^ load64_le(ks + i));
+  }
+  for (; i < len; i++)
+  {
+    out[i] = inp[i] ^ ks[i];
+  }
+}
+
+void
+Hacl_AES_Bitslice_ctr(
+  uint32_t nr,
+  uint64_t *skey,
+  uint8_t *ctr_block,
+  uint32_t ctr,
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *inp
+)
+{
+  uint32_t nb = len / (uint32_t)64U;
+  uint32_t rem = len % (uint32_t)64U;
+  for (uint32_t i = (uint32_t)0U; i <= nb; i++)
+  {
+    uint32_t n = (uint32_t)64U;
+    if (i == nb)
+    {
+      n = rem;
+    }
+    if (n > (uint32_t)0U)
+    {
+      uint64_t q[8U] = { 0U };
+      Hacl_AES_Bitslice_load_ctr(q, ctr_block, ctr + (uint32_t)4U * i);
+      Hacl_AES_Bitslice_ortho(q);
+      aes_encrypt(nr, skey, q);
+      Hacl_AES_Bitslice_ortho(q);
+      Hacl_AES_Bitslice_xor_blocks(n, out + (uint32_t)64U * i, inp + (uint32_t)64U * i, q);
+    }
+  }
+}
+
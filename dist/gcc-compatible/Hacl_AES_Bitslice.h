@@ -0,0 +1,68 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __Hacl_AES_Bitslice_H
+#define __Hacl_AES_Bitslice_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_Kremlib.h"
+
+void Hacl_AES_Bitslice_ortho(uint64_t *q);
+
+void Hacl_AES_Bitslice_aes128_key_expansion(uint64_t *skey, uint8_t *key);
+
+void Hacl_AES_Bitslice_aes256_key_expansion(uint64_t *skey, uint8_t *key);
+
+void Hacl_AES_Bitslice_load_ctr(uint64_t *q, uint8_t *ctr_block, uint32_t ctr);
+
+void Hacl_AES_Bitslice_xor_blocks(uint32_t len, uint8_t *out, uint8_t *inp, uint64_t *q);
+
+void
+Hacl_AES_Bitslice_ctr(
+  uint32_t nr,
+  uint64_t *skey,
+  uint8_t *ctr_block,
+  uint32_t ctr,
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *inp
+);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_AES_Bitslice_H_DEFINED
+#endif
@@ -0,0 +1,378 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_AES_Bitslice_128.h"
+
+static inline void aes_sbox(Lib_IntVector_Intrinsics_vec128 *q)
+{
+  Lib_IntVector_Intrinsics_vec128 x0 = q[7U];
+  Lib_IntVector_Intrinsics_vec128 x1 = q[6U];
+  Lib_IntVector_Intrinsics_vec128 x2 = q[5U];
+  Lib_IntVector_Intrinsics_vec128 x3 = q[4U];
+  Lib_IntVector_Intrinsics_vec128 x4 = q[3U];
+  Lib_IntVector_Intrinsics_vec128 x5 = q[2U];
+  Lib_IntVector_Intrinsics_vec128 x6 = q[1U];
+  Lib_IntVector_Intrinsics_vec128 x7 = q[0U];
+  Lib_IntVector_Intrinsics_vec128 y14 = Lib_IntVector_Intrinsics_vec128_xor(x3, x5);
+  Lib_IntVector_Intrinsics_vec128 y13 = Lib_IntVector_Intrinsics_vec128_xor(x0, x6);
+  Lib_IntVector_Intrinsics_vec128 y9 = Lib_IntVector_Intrinsics_vec128_xor(x0, x3);
+  Lib_IntVector_Intrinsics_vec128 y8 = Lib_IntVector_Intrinsics_vec128_xor(x0, x5);
+  Lib_IntVector_Intrinsics_vec128 t0 = Lib_IntVector_Intrinsics_vec128_xor(x1, x2);
+  Lib_IntVector_Intrinsics_vec128 y1 = Lib_IntVector_Intrinsics_vec128_xor(t0, x7);
+  Lib_IntVector_Intrinsics_vec128 y4 = Lib_IntVector_Intrinsics_vec128_xor(y1, x3);
+  Lib_IntVector_Intrinsics_vec128 y12 = Lib_IntVector_Intrinsics_vec128_xor(y13, y14);
+  Lib_IntVector_Intrinsics_vec128 y2 = Lib_IntVector_Intrinsics_vec128_xor(y1, x0);
+  Lib_IntVector_Intrinsics_vec128 y5 = Lib_IntVector_Intrinsics_vec128_xor(y1, x6);
+  Lib_IntVector_Intrinsics_vec128 y3 = Lib_IntVector_Intrinsics_vec128_xor(y5, y8);
+  Lib_IntVector_Intrinsics_vec128 t1 = Lib_IntVector_Intrinsics_vec128_xor(x4, y12);
+  Lib_IntVector_Intrinsics_vec128 y15 = Lib_IntVector_Intrinsics_vec128_xor(t1, x5);
+  Lib_IntVector_Intrinsics_vec128 y20 = Lib_IntVector_Intrinsics_vec128_xor(t1, x1);
+  Lib_IntVector_Intrinsics_vec128 y6 = Lib_IntVector_Intrinsics_vec128_xor(y15, x7);
+  Lib_IntVector_Intrinsics_vec128 y10 = Lib_IntVector_Intrinsics_vec128_xor(y15, t0);
+  Lib_IntVector_Intrinsics_vec128 y11 = Lib_IntVector_Intrinsics_vec128_xor(y20, y9);
+  Lib_IntVector_Intrinsics_vec128 y7 = Lib_IntVector_Intrinsics_vec128_xor(x7, y11);
+  Lib_IntVector_Intrinsics_vec128 y17 = Lib_IntVector_Intrinsics_vec128_xor(y10, y11);
+  Lib_IntVector_Intrinsics_vec128 y19 = Lib_IntVector_Intrinsics_vec128_xor(y10, y8);
+  Lib_IntVector_Intrinsics_vec128 y16 = Lib_IntVector_Intrinsics_vec128_xor(t0, y11);
+  Lib_IntVector_Intrinsics_vec128 y21 = Lib_IntVector_Intrinsics_vec128_xor(y13, y16);
+  Lib_IntVector_Intrinsics_vec128 y18 = Lib_IntVector_Intrinsics_vec128_xor(x0, y16);
+  Lib_IntVector_Intrinsics_vec128 t2 = Lib_IntVector_Intrinsics_vec128_and(y12, y15);
+  Lib_IntVector_Intrinsics_vec128 t3 = Lib_IntVector_Intrinsics_vec128_and(y3, y6);
+  Lib_IntVector_Intrinsics_vec128 t4 = Lib_IntVector_Intrinsics_vec128_xor(t3, t2);
+  Lib_IntVector_Intrinsics_vec128 t5 = Lib_IntVector_Intrinsics_vec128_and(y4, x7);
+  Lib_IntVector_Intrinsics_vec128 t6 = Lib_IntVector_Intrinsics_vec128_xor(t5, t2);
+  Lib_IntVector_Intrinsics_vec128 t7 = Lib_IntVector_Intrinsics_vec128_and(y13, y16);
+  Lib_IntVector_Intrinsics_vec128 t8 = Lib_IntVector_Intrinsics_vec128_and(y5, y1);
+  Lib_IntVector_Intrinsics_vec128 t9 = Lib_IntVector_Intrinsics_vec128_xor(t8, t7);
+  Lib_IntVector_Intrinsics_vec128 t10 = Lib_IntVector_Intrinsics_vec128_and(y2, y7);
+  Lib_IntVector_Intrinsics_vec128 t11 = Lib_IntVector_Intrinsics_vec128_xor(t10, t7);
+  Lib_IntVector_Intrinsics_vec128 t12 = Lib_IntVector_Intrinsics_vec128_and(y9, y11);
+  Lib_IntVector_Intrinsics_vec128 t13 = Lib_IntVector_Intrinsics_vec128_and(y14, y17);
+  Lib_IntVector_Intrinsics_vec128 t14 = Lib_IntVector_Intrinsics_vec128_xor(t13, t12);
+  Lib_IntVector_Intrinsics_vec128 t15 = Lib_IntVector_Intrinsics_vec128_and(y8, y10);
+  Lib_IntVector_Intrinsics_vec128 t16 = Lib_IntVector_Intrinsics_vec128_xor(t15, t12);
+  Lib_IntVector_Intrinsics_vec128 t17 = Lib_IntVector_Intrinsics_vec128_xor(t4, t14);
+  Lib_IntVector_Intrinsics_vec128 t18 = Lib_IntVector_Intrinsics_vec128_xor(t6, t16);
+  Lib_IntVector_Intrinsics_vec128 t19 = Lib_IntVector_Intrinsics_vec128_xor(t9, t14);
+  Lib_IntVector_Intrinsics_vec128 t20 = Lib_IntVector_Intrinsics_vec128_xor(t11, t16);
+  Lib_IntVector_Intrinsics_vec128 t21 = Lib_IntVector_Intrinsics_vec128_xor(t17, y20);
+  Lib_IntVector_Intrinsics_vec128 t22 = Lib_IntVector_Intrinsics_vec128_xor(t18, y19);
+  Lib_IntVector_Intrinsics_vec128 t23 = Lib_IntVector_Intrinsics_vec128_xor(t19, y21);
+  Lib_IntVector_Intrinsics_vec128 t24 = Lib_IntVector_Intrinsics_vec128_xor(t20, y18);
+  Lib_IntVector_Intrinsics_vec128 t25 = Lib_IntVector_Intrinsics_vec128_xor(t21, t22);
+  Lib_IntVector_Intrinsics_vec128 t26 = Lib_IntVector_Intrinsics_vec128_and(t21, t23);
+  Lib_IntVector_Intrinsics_vec128 t27 = Lib_IntVector_Intrinsics_vec128_xor(t24, t26);
+  Lib_IntVector_Intrinsics_vec128 t28 = Lib_IntVector_Intrinsics_vec128_and(t25, t27);
+  Lib_IntVector_Intrinsics_vec128 t29 = Lib_IntVector_Intrinsics_vec128_xor(t28, t22);
+  Lib_IntVector_Intrinsics_vec128 t30 = Lib_IntVector_Intrinsics_vec128_xor(t23, t24);
+  Lib_IntVector_Intrinsics_vec128 t31 = Lib_IntVector_Intrinsics_vec128_xor(t22, t26);
+  Lib_IntVector_Intrinsics_vec128 t32 = Lib_IntVector_Intrinsics_vec128_and(t31, t30);
+  Lib_IntVector_Intrinsics_vec128 t33 = Lib_IntVector_Intrinsics_vec128_xor(t32, t24);
+  Lib_IntVector_Intrinsics_vec128 t34 = Lib_IntVector_Intrinsics_vec128_xor(t23, t33);
+  Lib_IntVector_Intrinsics_vec128 t35 = Lib_IntVector_Intrinsics_vec128_xor(t27, t33);
+  Lib_IntVector_Intrinsics_vec128 t36 = Lib_IntVector_Intrinsics_vec128_and(t24, t35);
+  Lib_IntVector_Intrinsics_vec128 t37 = Lib_IntVector_Intrinsics_vec128_xor(t36, t34);
+  Lib_IntVector_Intrinsics_vec128 t38 = Lib_IntVector_Intrinsics_vec128_xor(t27, t36);
+  Lib_IntVector_Intrinsics_vec128 t39 = Lib_IntVector_Intrinsics_vec128_and(t29, t38);
+  Lib_IntVector_Intrinsics_vec128 t40 = Lib_IntVector_Intrinsics_vec128_xor(t25, t39);
+  Lib_IntVector_Intrinsics_vec128 t41 = Lib_IntVector_Intrinsics_vec128_xor(t40, t37);
+  Lib_IntVector_Intrinsics_vec128 t42 = Lib_IntVector_Intrinsics_vec128_xor(t29, t33);
+  Lib_IntVector_Intrinsics_vec128 t43 = Lib_IntVector_Intrinsics_vec128_xor(t29, t40);
+  Lib_IntVector_Intrinsics_vec128 t44 = Lib_IntVector_Intrinsics_vec128_xor(t33, t37);
+  Lib_IntVector_Intrinsics_vec128 t45 = Lib_IntVector_Intrinsics_vec128_xor(t42, t41);
+  Lib_IntVector_Intrinsics_vec128 z0 = Lib_IntVector_Intrinsics_vec128_and(t44, y15);
+  Lib_IntVector_Intrinsics_vec128 z1 = Lib_IntVector_Intrinsics_vec128_and(t37, y6);
+  Lib_IntVector_Intrinsics_vec128 z2 = Lib_IntVector_Intrinsics_vec128_and(t33, x7);
+  Lib_IntVector_Intrinsics_vec128 z3 = Lib_IntVector_Intrinsics_vec128_and(t43, y16);
+  Lib_IntVector_Intrinsics_vec128 z4 = Lib_IntVector_Intrinsics_vec128_and(t40, y1);
+  Lib_IntVector_Intrinsics_vec128 z5 = Lib_IntVector_Intrinsics_vec128_and(t29, y7);
+  Lib_IntVector_Intrinsics_vec128 z6 = Lib_IntVector_Intrinsics_vec128_and(t42, y11);
+  Lib_IntVector_Intrinsics_vec128 z7 = Lib_IntVector_Intrinsics_vec128_and(t45, y17);
+  Lib_IntVector_Intrinsics_vec128 z8 = Lib_IntVector_Intrinsics_vec128_and(t41, y10);
+  Lib_IntVector_Intrinsics_vec128 z9 = Lib_IntVector_Intrinsics_vec128_and(t44, y12);
+  Lib_IntVector_Intrinsics_vec128 z10 = Lib_IntVector_Intrinsics_vec128_and(t37, y3);
+  Lib_IntVector_Intrinsics_vec128 z11 = Lib_IntVector_Intrinsics_vec128_and(t33, y4);
+  Lib_IntVector_Intrinsics_vec128 z12 = Lib_IntVector_Intrinsics_vec128_and(t43, y13);
+  Lib_IntVector_Intrinsics_vec128 z13 = Lib_IntVector_Intrinsics_vec128_and(t40, y5);
+  Lib_IntVector_Intrinsics_vec128 z14 = Lib_IntVector_Intrinsics_vec128_and(t29, y2);
+  Lib_IntVector_Intrinsics_vec128 z15 = Lib_IntVector_Intrinsics_vec128_and(t42, y9);
+  Lib_IntVector_Intrinsics_vec128 z16 = Lib_IntVector_Intrinsics_vec128_and(t45, y14);
+  Lib_IntVector_Intrinsics_vec128 z17 = Lib_IntVector_Intrinsics_vec128_and(t41, y8);
+  Lib_IntVector_Intrinsics_vec128 t46 = Lib_IntVector_Intrinsics_vec128_xor(z15, z16);
+  Lib_IntVector_Intrinsics_vec128 t47 = Lib_IntVector_Intrinsics_vec128_xor(z10, z11);
+  Lib_IntVector_Intrinsics_vec128 t48 = Lib_IntVector_Intrinsics_vec128_xor(z5, z13);
+  Lib_IntVector_Intrinsics_vec128 t49 = Lib_IntVector_Intrinsics_vec128_xor(z9, z10);
+  Lib_IntVector_Intrinsics_vec128 t50 = Lib_IntVector_Intrinsics_vec128_xor(z2, z12);
+  Lib_IntVector_Intrinsics_vec128 t51 = Lib_IntVector_Intrinsics_vec128_xor(z2, z5);
+  Lib_IntVector_Intrinsics_vec128 t52 = Lib_IntVector_Intrinsics_vec128_xor(z7, z8);
+  Lib_IntVector_Intrinsics_vec128 t53 = Lib_IntVector_Intrinsics_vec128_xor(z0, z3);
+  Lib_IntVector_Intrinsics_vec128 t54 = Lib_IntVector_Intrinsics_vec128_xor(z6, z7);
+  Lib_IntVector_Intrinsics_vec128 t55 = Lib_IntVector_Intrinsics_vec128_xor(z16, z17);
+  Lib_IntVector_Intrinsics_vec128 t56 = Lib_IntVector_Intrinsics_vec128_xor(z12, t48);
+  Lib_IntVector_Intrinsics_vec128 t57 = Lib_IntVector_Intrinsics_vec128_xor(t50, t53);
+  Lib_IntVector_Intrinsics_vec128 t58 = Lib_IntVector_Intrinsics_vec128_xor(z4, t46);
+  Lib_IntVector_Intrinsics_vec128 t59 = Lib_IntVector_Intrinsics_vec128_xor(z3, t54);
+  Lib_IntVector_Intrinsics_vec128 t60 = Lib_IntVector_Intrinsics_vec128_xor(t46, t57);
+  Lib_IntVector_Intrinsics_vec128 t61 = Lib_IntVector_Intrinsics_vec128_xor(z14, t57);
+  Lib_IntVector_Intrinsics_vec128 t62 = Lib_IntVector_Intrinsics_vec128_xor(t52, t58);
+  Lib_IntVector_Intrinsics_vec128 t63 = Lib_IntVector_Intrinsics_vec128_xor(t49, t58);
+  Lib_IntVector_Intrinsics_vec128 t64 = Lib_IntVector_Intrinsics_vec128_xor(z4, t59);
+  Lib_IntVector_Intrinsics_vec128 t65 = Lib_IntVector_Intrinsics_vec128_xor(t61, t62);
+  Lib_IntVector_Intrinsics_vec128 t66 = Lib_IntVector_Intrinsics_vec128_xor(z1, t63);
+  Lib_IntVector_Intrinsics_vec128 s0 = Lib_IntVector_Intrinsics_vec128_xor(t59, t63);
+  Lib_IntVector_Intrinsics_vec128 s6 = Lib_IntVector_Intrinsics_vec128_xor(t56, Lib_IntVector_Intrinsics_vec128_lognot(t62));
+  Lib_IntVector_Intrinsics_vec128 s7 = Lib_IntVector_Intrinsics_vec128_xor(t48, Lib_IntVector_Intrinsics_vec128_lognot(t60));
+  Lib_IntVector_Intrinsics_vec128 t67 = Lib_IntVector_Intrinsics_vec128_xor(t64, t65);
+  Lib_IntVector_Intrinsics_vec128 s3 = Lib_IntVector_Intrinsics_vec128_xor(t53, t66);
+  Lib_IntVector_Intrinsics_vec128 s4 = Lib_IntVector_Intrinsics_vec128_xor(t51, t66);
+  Lib_IntVector_Intrinsics_vec128 s5 = Lib_IntVector_Intrinsics_vec128_xor(t47, t65);
+  Lib_IntVector_Intrinsics_vec128 s1 = Lib_IntVector_Intrinsics_vec128_xor(t64, Lib_IntVector_Intrinsics_vec128_lognot(s3));
+  Lib_IntVector_Intrinsics_vec128 s2 = Lib_IntVector_Intrinsics_vec128_xor(t55, Lib_IntVector_Intrinsics_vec128_lognot(t67));
+  q[7U] = s0;
+  q[6U] = s1;
+  q[5U] = s2;
+  q[4U] = s3;
+  q[3U] = s4;
+  q[2U] = s5;
+  q[1U] = s6;
+  q[0U] = s7;
+}
+
+static inline void aes_shift_rows(Lib_IntVector_Intrinsics_vec128 *q)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec128 x = q[i];
+    q[i] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(x, Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xffffU)), Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(x, Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xfff00000U)), (uint32_t)4U)), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(x, Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xf0000U)), (uint32_t)12U)), Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(x, Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xff0000000000U)), (uint32_t)8U)), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(x, Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xff00000000U)), (uint32_t)8U)), Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(x, Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xf000000000000000U)), (uint32_t)12U)), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(x, Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xfff000000000000U)), (uint32_t)4U));
+  }
+}
+
+static inline void aes_mix_columns(Lib_IntVector_Intrinsics_vec128 *q)
+{
+  Lib_IntVector_Intrinsics_vec128 q0 = q[0U];
+  Lib_IntVector_Intrinsics_vec128 q1 = q[1U];
+  Lib_IntVector_Intrinsics_vec128 q2 = q[2U];
+  Lib_IntVector_Intrinsics_vec128 q3 = q[3U];
+  Lib_IntVector_Intrinsics_vec128 q4 = q[4U];
+  Lib_IntVector_Intrinsics_vec128 q5 = q[5U];
+  Lib_IntVector_Intrinsics_vec128 q6 = q[6U];
+  Lib_IntVector_Intrinsics_vec128 q7 = q[7U];
+  Lib_IntVector_Intrinsics_vec128 r0 = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(q0, (uint32_t)16U), Lib_IntVector_Intrinsics_vec128_shift_left64(q0, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec128 r1 = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(q1, (uint32_t)16U), Lib_IntVector_Intrinsics_vec128_shift_left64(q1, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec128 r2 = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(q2, (uint32_t)16U), Lib_IntVector_Intrinsics_vec128_shift_left64(q2, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec128 r3 = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(q3, (uint32_t)16U), Lib_IntVector_Intrinsics_vec128_shift_left64(q3, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec128 r4 = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(q4, (uint32_t)16U), Lib_IntVector_Intrinsics_vec128_shift_left64(q4, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec128 r5 = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(q5, (uint32_t)16U), Lib_IntVector_Intrinsics_vec128_shift_left64(q5, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec128 r6 = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(q6, (uint32_t)16U), Lib_IntVector_Intrinsics_vec128_shift_left64(q6, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec128 r7 = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(q7, (uint32_t)16U), Lib_IntVector_Intrinsics_vec128_shift_left64(q7, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec128 u0 = Lib_IntVector_Intrinsics_vec128_xor(q0, r0);
+  Lib_IntVector_Intrinsics_vec128 u1 = Lib_IntVector_Intrinsics_vec128_xor(q1, r1);
+  Lib_IntVector_Intrinsics_vec128 u2 = Lib_IntVector_Intrinsics_vec128_xor(q2, r2);
+  Lib_IntVector_Intrinsics_vec128 u3 = Lib_IntVector_Intrinsics_vec128_xor(q3, r3);
+  Lib_IntVector_Intrinsics_vec128 u4 = Lib_IntVector_Intrinsics_vec128_xor(q4, r4);
+  Lib_IntVector_Intrinsics_vec128 u5 = Lib_IntVector_Intrinsics_vec128_xor(q5, r5);
+  Lib_IntVector_Intrinsics_vec128 u6 = Lib_IntVector_Intrinsics_vec128_xor(q6, r6);
+  Lib_IntVector_Intrinsics_vec128 u7 = Lib_IntVector_Intrinsics_vec128_xor(q7, r7);
+  q[0U] = Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(q7, r7), r0), Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_left64(u0, (uint32_t)32U), Lib_IntVector_Intrinsics_vec128_shift_right64(u0, (uint32_t)32U)));
+  q[1U] = Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(q0, r0), q7), r7), r1), Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_left64(u1, (uint32_t)32U), Lib_IntVector_Intrinsics_vec128_shift_right64(u1, (uint32_t)32U)));
+  q[2U] = Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(q1, r1), r2), Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_left64(u2, (uint32_t)32U), Lib_IntVector_Intrinsics_vec128_shift_right64(u2, (uint32_t)32U)));
+  q[3U] = Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(q2, r2), q7), r7), r3), Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_left64(u3, (uint32_t)32U), Lib_IntVector_Intrinsics_vec128_shift_right64(u3, (uint32_t)32U)));
+  q[4U] = Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(q3, r3), q7), r7), r4), Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_left64(u4, (uint32_t)32U), Lib_IntVector_Intrinsics_vec128_shift_right64(u4, (uint32_t)32U)));
+  q[5U] = Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(q4, r4), r5), Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_left64(u5, (uint32_t)32U), Lib_IntVector_Intrinsics_vec128_shift_right64(u5, (uint32_t)32U)));
+  q[6U] = Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(q5, r5), r6), Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_left64(u6, (uint32_t)32U), Lib_IntVector_Intrinsics_vec128_shift_right64(u6, (uint32_t)32U)));
+  q[7U] = Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_xor(q6, r6), r7), Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_left64(u7, (uint32_t)32U), Lib_IntVector_Intrinsics_vec128_shift_right64(u7, (uint32_t)32U)));
+}
+
+static inline void aes_add_round_key(Lib_IntVector_Intrinsics_vec128 *q, uint64_t *skey)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    q[i] = Lib_IntVector_Intrinsics_vec128_xor(q[i], Lib_IntVector_Intrinsics_vec128_load64(skey[i]));
+  }
+}
+
+static inline void aes_encrypt(uint32_t nr, uint64_t *skey, Lib_IntVector_Intrinsics_vec128 *q)
+{
+  aes_add_round_key(q, skey);
+  for (uint32_t i = (uint32_t)1U; i < nr; i++)
+  {
+    aes_sbox(q);
+    aes_shift_rows(q);
+    aes_mix_columns(q);
+    aes_add_round_key(q, skey + (uint32_t)8U * i);
+  }
+  aes_sbox(q);
+  aes_shift_rows(q);
+  aes_add_round_key(q, skey + (uint32_t)8U * nr);
+}
+
+static inline void aes_ortho(Lib_IntVector_Intrinsics_vec128 *q)
+{
+  Lib_IntVector_Intrinsics_vec128 cl1 = Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0x5555555555555555U);
+  Lib_IntVector_Intrinsics_vec128 ch1 = Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xaaaaaaaaaaaaaaaaU);
+  Lib_IntVector_Intrinsics_vec128 a01 = q[0U];
+  Lib_IntVector_Intrinsics_vec128 b01 = q[1U];
+  q[0U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a01, cl1), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b01, cl1), (uint32_t)1U));
+  q[1U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a01, ch1), (uint32_t)1U), Lib_IntVector_Intrinsics_vec128_and(b01, ch1));
+  Lib_IntVector_Intrinsics_vec128 a23 = q[2U];
+  Lib_IntVector_Intrinsics_vec128 b23 = q[3U];
+  q[2U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a23, cl1), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b23, cl1), (uint32_t)1U));
+  q[3U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a23, ch1), (uint32_t)1U), Lib_IntVector_Intrinsics_vec128_and(b23, ch1));
+  Lib_IntVector_Intrinsics_vec128 a45 = q[4U];
+  Lib_IntVector_Intrinsics_vec128 b45 = q[5U];
+  q[4U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a45, cl1), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b45, cl1), (uint32_t)1U));
+  q[5U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a45, ch1), (uint32_t)1U), Lib_IntVector_Intrinsics_vec128_and(b45, ch1));
+  Lib_IntVector_Intrinsics_vec128 a67 = q[6U];
+  Lib_IntVector_Intrinsics_vec128 b67 = q[7U];
+  q[6U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a67, cl1), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b67, cl1), (uint32_t)1U));
+  q[7U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a67, ch1), (uint32_t)1U), Lib_IntVector_Intrinsics_vec128_and(b67, ch1));
+  Lib_IntVector_Intrinsics_vec128 cl2 = Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0x3333333333333333U);
+  Lib_IntVector_Intrinsics_vec128 ch2 = Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xccccccccccccccccU);
+  Lib_IntVector_Intrinsics_vec128 a02 = q[0U];
+  Lib_IntVector_Intrinsics_vec128 b02 = q[2U];
+  q[0U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a02, cl2), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b02, cl2), (uint32_t)2U));
+  q[2U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a02, ch2), (uint32_t)2U), Lib_IntVector_Intrinsics_vec128_and(b02, ch2));
+  Lib_IntVector_Intrinsics_vec128 a13 = q[1U];
+  Lib_IntVector_Intrinsics_vec128 b13 = q[3U];
+  q[1U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a13, cl2), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b13, cl2), (uint32_t)2U));
+  q[3U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a13, ch2), (uint32_t)2U), Lib_IntVector_Intrinsics_vec128_and(b13, ch2));
+  Lib_IntVector_Intrinsics_vec128 a46 = q[4U];
+  Lib_IntVector_Intrinsics_vec128 b46 = q[6U];
+  q[4U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a46, cl2), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b46, cl2), (uint32_t)2U));
+  q[6U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a46, ch2), (uint32_t)2U), Lib_IntVector_Intrinsics_vec128_and(b46, ch2));
+  Lib_IntVector_Intrinsics_vec128 a57 = q[5U];
+  Lib_IntVector_Intrinsics_vec128 b57 = q[7U];
+  q[5U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a57, cl2), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b57, cl2), (uint32_t)2U));
+  q[7U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a57, ch2), (uint32_t)2U), Lib_IntVector_Intrinsics_vec128_and(b57, ch2));
+  Lib_IntVector_Intrinsics_vec128 cl4 = Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xf0f0f0f0f0f0f0fU);
+  Lib_IntVector_Intrinsics_vec128 ch4 = Lib_IntVector_Intrinsics_vec128_load64((uint64_t)0xf0f0f0f0f0f0f0f0U);
+  Lib_IntVector_Intrinsics_vec128 a04 = q[0U];
+  Lib_IntVector_Intrinsics_vec128 b04 = q[4U];
+  q[0U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a04, cl4), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b04, cl4), (uint32_t)4U));
+  q[4U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a04, ch4), (uint32_t)4U), Lib_IntVector_Intrinsics_vec128_and(b04, ch4));
+  Lib_IntVector_Intrinsics_vec128 a15 = q[1U];
+  Lib_IntVector_Intrinsics_vec128 b15 = q[5U];
+  q[1U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a15, cl4), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b15, cl4), (uint32_t)4U));
+  q[5U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a15, ch4), (uint32_t)4U), Lib_IntVector_Intrinsics_vec128_and(b15, ch4));
+  Lib_IntVector_Intrinsics_vec128 a26 = q[2U];
+  Lib_IntVector_Intrinsics_vec128 b26 = q[6U];
+  q[2U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a26, cl4), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b26, cl4), (uint32_t)4U));
+  q[6U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a26, ch4), (uint32_t)4U), Lib_IntVector_Intrinsics_vec128_and(b26, ch4));
+  Lib_IntVector_Intrinsics_vec128 a37 = q[3U];
+  Lib_IntVector_Intrinsics_vec128 b37 = q[7U];
+  q[3U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_and(a37, cl4), Lib_IntVector_Intrinsics_vec128_shift_left64(Lib_IntVector_Intrinsics_vec128_and(b37, cl4), (uint32_t)4U));
+  q[7U] = Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_right64(Lib_IntVector_Intrinsics_vec128_and(a37, ch4), (uint32_t)4U), Lib_IntVector_Intrinsics_vec128_and(b37, ch4));
+}
+
+/* Encrypts len <= 128 bytes: each lane holds the bitsliced state of four
+   counter blocks. */
+static inline void
+aes_ctr_batch(
+  uint32_t nr,
+  uint64_t *skey,
+  uint8_t *ctr_block,
+  uint32_t ctr,
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *inp
+)
+{
+  uint64_t qs[8U * 2U] = { 0U };
+  uint8_t tmp[128U] = { 0U };
+  Lib_IntVector_Intrinsics_vec128 q[8U];
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)2U; l++)
+  {
+    Hacl_AES_Bitslice_load_ctr(qs + (uint32_t)8U * l, ctr_block, ctr + (uint32_t)4U * l);
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+    {
+      store64_le(tmp + (uint32_t)8U * ((uint32_t)2U * j + l), qs[(uint32_t)8U * l + j]);
+    }
+  }
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+  {
+    q[j] = Lib_IntVector_Intrinsics_vec128_load_le(tmp + (uint32_t)8U * (uint32_t)2U * j);
+  }
+  aes_ortho(q);
+  aes_encrypt(nr, skey, q);
+  aes_ortho(q);
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+  {
+    Lib_IntVector_Intrinsics_vec128_store_le(tmp + (uint32_t)8U * (uint32_t)2U * j, q[j]);
+  }
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)2U; l++)
+  {
+    if ((uint32_t)64U * l < len)
+    {
+      uint32_t n = len - (uint32_t)64U * l;
+      if (n > (uint32_t)64U)
+      {
+        n = (uint32_t)64U;
+      }
+      for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+      {
+        qs[(uint32_t)8U * l + j] = load64_le(tmp + (uint32_t)8U * ((uint32_t)2U * j + l));
+      }
+      Hacl_AES_Bitslice_xor_blocks(n,
+        out + (uint32_t)64U * l,
+        inp + (uint32_t)64U * l,
+        qs + (uint32_t)8U * l);
+    }
+  }
+}
+
+void
+Hacl_AES_Bitslice_128_ctr(
+  uint32_t nr,
+  uint64_t *skey,
+  uint8_t *ctr_block,
+  uint32_t ctr,
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *inp
+)
+{
+  uint32_t nb = len / (uint32_t)128U;
+  uint32_t rem = len % (uint32_t)128U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    aes_ctr_batch(nr,
+      skey,
+      ctr_block,
+      ctr + (uint32_t)8U * i,
+      (uint32_t)128U,
+      out + (uint32_t)128U * i,
+      inp + (uint32_t)128U * i);
+  }
+  if (rem > (uint32_t)0U)
+  {
+    aes_ctr_batch(nr,
+      skey,
+      ctr_block,
+      ctr + (uint32_t)8U * nb,
+      rem,
+      out + (uint32_t)128U * nb,
+      inp + (uint32_t)128U * nb);
+  }
+}
+
@@ -0,0 +1,378 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_AES_Bitslice_256.h"
+
+static inline void aes_sbox(Lib_IntVector_Intrinsics_vec256 *q)
+{
+  Lib_IntVector_Intrinsics_vec256 x0 = q[7U];
+  Lib_IntVector_Intrinsics_vec256 x1 = q[6U];
+  Lib_IntVector_Intrinsics_vec256 x2 = q[5U];
+  Lib_IntVector_Intrinsics_vec256 x3 = q[4U];
+  Lib_IntVector_Intrinsics_vec256 x4 = q[3U];
+  Lib_IntVector_Intrinsics_vec256 x5 = q[2U];
+  Lib_IntVector_Intrinsics_vec256 x6 = q[1U];
+  Lib_IntVector_Intrinsics_vec256 x7 = q[0U];
+  Lib_IntVector_Intrinsics_vec256 y14 = Lib_IntVector_Intrinsics_vec256_xor(x3, x5);
+  Lib_IntVector_Intrinsics_vec256 y13 = Lib_IntVector_Intrinsics_vec256_xor(x0, x6);
+  Lib_IntVector_Intrinsics_vec256 y9 = Lib_IntVector_Intrinsics_vec256_xor(x0, x3);
+  Lib_IntVector_Intrinsics_vec256 y8 = Lib_IntVector_Intrinsics_vec256_xor(x0, x5);
+  Lib_IntVector_Intrinsics_vec256 t0 = Lib_IntVector_Intrinsics_vec256_xor(x1, x2);
+  Lib_IntVector_Intrinsics_vec256 y1 = Lib_IntVector_Intrinsics_vec256_xor(t0, x7);
+  Lib_IntVector_Intrinsics_vec256 y4 = Lib_IntVector_Intrinsics_vec256_xor(y1, x3);
+  Lib_IntVector_Intrinsics_vec256 y12 = Lib_IntVector_Intrinsics_vec256_xor(y13, y14);
+  Lib_IntVector_Intrinsics_vec256 y2 = Lib_IntVector_Intrinsics_vec256_xor(y1, x0);
+  Lib_IntVector_Intrinsics_vec256 y5 = Lib_IntVector_Intrinsics_vec256_xor(y1, x6);
+  Lib_IntVector_Intrinsics_vec256 y3 = Lib_IntVector_Intrinsics_vec256_xor(y5, y8);
+  Lib_IntVector_Intrinsics_vec256 t1 = Lib_IntVector_Intrinsics_vec256_xor(x4, y12);
+  Lib_IntVector_Intrinsics_vec256 y15 = Lib_IntVector_Intrinsics_vec256_xor(t1, x5);
+  Lib_IntVector_Intrinsics_vec256 y20 = Lib_IntVector_Intrinsics_vec256_xor(t1, x1);
+  Lib_IntVector_Intrinsics_vec256 y6 = Lib_IntVector_Intrinsics_vec256_xor(y15, x7);
+  Lib_IntVector_Intrinsics_vec256 y10 = Lib_IntVector_Intrinsics_vec256_xor(y15, t0);
+  Lib_IntVector_Intrinsics_vec256 y11 = Lib_IntVector_Intrinsics_vec256_xor(y20, y9);
+  Lib_IntVector_Intrinsics_vec256 y7 = Lib_IntVector_Intrinsics_vec256_xor(x7, y11);
+  Lib_IntVector_Intrinsics_vec256 y17 = Lib_IntVector_Intrinsics_vec256_xor(y10, y11);
+  Lib_IntVector_Intrinsics_vec256 y19 = Lib_IntVector_Intrinsics_vec256_xor(y10, y8);
+  Lib_IntVector_Intrinsics_vec256 y16 = Lib_IntVector_Intrinsics_vec256_xor(t0, y11);
+  Lib_IntVector_Intrinsics_vec256 y21 = Lib_IntVector_Intrinsics_vec256_xor(y13, y16);
+  Lib_IntVector_Intrinsics_vec256 y18 = Lib_IntVector_Intrinsics_vec256_xor(x0, y16);
+  Lib_IntVector_Intrinsics_vec256 t2 = Lib_IntVector_Intrinsics_vec256_and(y12, y15);
+  Lib_IntVector_Intrinsics_vec256 t3 = Lib_IntVector_Intrinsics_vec256_and(y3, y6);
+  Lib_IntVector_Intrinsics_vec256 t4 = Lib_IntVector_Intrinsics_vec256_xor(t3, t2);
+  Lib_IntVector_Intrinsics_vec256 t5 = Lib_IntVector_Intrinsics_vec256_and(y4, x7);
+  Lib_IntVector_Intrinsics_vec256 t6 = Lib_IntVector_Intrinsics_vec256_xor(t5, t2);
+  Lib_IntVector_Intrinsics_vec256 t7 = Lib_IntVector_Intrinsics_vec256_and(y13, y16);
+  Lib_IntVector_Intrinsics_vec256 t8 = Lib_IntVector_Intrinsics_vec256_and(y5, y1);
+  Lib_IntVector_Intrinsics_vec256 t9 = Lib_IntVector_Intrinsics_vec256_xor(t8, t7);
+  Lib_IntVector_Intrinsics_vec256 t10 = Lib_IntVector_Intrinsics_vec256_and(y2, y7);
+  Lib_IntVector_Intrinsics_vec256 t11 = Lib_IntVector_Intrinsics_vec256_xor(t10, t7);
+  Lib_IntVector_Intrinsics_vec256 t12 = Lib_IntVector_Intrinsics_vec256_and(y9, y11);
+  Lib_IntVector_Intrinsics_vec256 t13 = Lib_IntVector_Intrinsics_vec256_and(y14, y17);
+  Lib_IntVector_Intrinsics_vec256 t14 = Lib_IntVector_Intrinsics_vec256_xor(t13, t12);
+  Lib_IntVector_Intrinsics_vec256 t15 = Lib_IntVector_Intrinsics_vec256_and(y8, y10);
+  Lib_IntVector_Intrinsics_vec256 t16 = Lib_IntVector_Intrinsics_vec256_xor(t15, t12);
+  Lib_IntVector_Intrinsics_vec256 t17 = Lib_IntVector_Intrinsics_vec256_xor(t4, t14);
+  Lib_IntVector_Intrinsics_vec256 t18 = Lib_IntVector_Intrinsics_vec256_xor(t6, t16);
+  Lib_IntVector_Intrinsics_vec256 t19 = Lib_IntVector_Intrinsics_vec256_xor(t9, t14);
+  Lib_IntVector_Intrinsics_vec256 t20 = Lib_IntVector_Intrinsics_vec256_xor(t11, t16);
+  Lib_IntVector_Intrinsics_vec256 t21 = Lib_IntVector_Intrinsics_vec256_xor(t17, y20);
+  Lib_IntVector_Intrinsics_vec256 t22 = Lib_IntVector_Intrinsics_vec256_xor(t18, y19);
+  Lib_IntVector_Intrinsics_vec256 t23 = Lib_IntVector_Intrinsics_vec256_xor(t19, y21);
+  Lib_IntVector_Intrinsics_vec256 t24 = Lib_IntVector_Intrinsics_vec256_xor(t20, y18);
+  Lib_IntVector_Intrinsics_vec256 t25 = Lib_IntVector_Intrinsics_vec256_xor(t21, t22);
+  Lib_IntVector_Intrinsics_vec256 t26 = Lib_IntVector_Intrinsics_vec256_and(t21, t23);
+  Lib_IntVector_Intrinsics_vec256 t27 = Lib_IntVector_Intrinsics_vec256_xor(t24, t26);
+  Lib_IntVector_Intrinsics_vec256 t28 = Lib_IntVector_Intrinsics_vec256_and(t25, t27);
+  Lib_IntVector_Intrinsics_vec256 t29 = Lib_IntVector_Intrinsics_vec256_xor(t28, t22);
+  Lib_IntVector_Intrinsics_vec256 t30 = Lib_IntVector_Intrinsics_vec256_xor(t23, t24);
+  Lib_IntVector_Intrinsics_vec256 t31 = Lib_IntVector_Intrinsics_vec256_xor(t22, t26);
+  Lib_IntVector_Intrinsics_vec256 t32 = Lib_IntVector_Intrinsics_vec256_and(t31, t30);
+  Lib_IntVector_Intrinsics_vec256 t33 = Lib_IntVector_Intrinsics_vec256_xor(t32, t24);
+  Lib_IntVector_Intrinsics_vec256 t34 = Lib_IntVector_Intrinsics_vec256_xor(t23, t33);
+  Lib_IntVector_Intrinsics_vec256 t35 = Lib_IntVector_Intrinsics_vec256_xor(t27, t33);
+  Lib_IntVector_Intrinsics_vec256 t36 = Lib_IntVector_Intrinsics_vec256_and(t24, t35);
+  Lib_IntVector_Intrinsics_vec256 t37 = Lib_IntVector_Intrinsics_vec256_xor(t36, t34);
+  Lib_IntVector_Intrinsics_vec256 t38 = Lib_IntVector_Intrinsics_vec256_xor(t27, t36);
+  Lib_IntVector_Intrinsics_vec256 t39 = Lib_IntVector_Intrinsics_vec256_and(t29, t38);
+  Lib_IntVector_Intrinsics_vec256 t40 = Lib_IntVector_Intrinsics_vec256_xor(t25, t39);
+  Lib_IntVector_Intrinsics_vec256 t41 = Lib_IntVector_Intrinsics_vec256_xor(t40, t37);
+  Lib_IntVector_Intrinsics_vec256 t42 = Lib_IntVector_Intrinsics_vec256_xor(t29, t33);
+  Lib_IntVector_Intrinsics_vec256 t43 = Lib_IntVector_Intrinsics_vec256_xor(t29, t40);
+  Lib_IntVector_Intrinsics_vec256 t44 = Lib_IntVector_Intrinsics_vec256_xor(t33, t37);
+  Lib_IntVector_Intrinsics_vec256 t45 = Lib_IntVector_Intrinsics_vec256_xor(t42, t41);
+  Lib_IntVector_Intrinsics_vec256 z0 = Lib_IntVector_Intrinsics_vec256_and(t44, y15);
+  Lib_IntVector_Intrinsics_vec256 z1 = Lib_IntVector_Intrinsics_vec256_and(t37, y6);
+  Lib_IntVector_Intrinsics_vec256 z2 = Lib_IntVector_Intrinsics_vec256_and(t33, x7);
+  Lib_IntVector_Intrinsics_vec256 z3 = Lib_IntVector_Intrinsics_vec256_and(t43, y16);
+  Lib_IntVector_Intrinsics_vec256 z4 = Lib_IntVector_Intrinsics_vec256_and(t40, y1);
+  Lib_IntVector_Intrinsics_vec256 z5 = Lib_IntVector_Intrinsics_vec256_and(t29, y7);
+  Lib_IntVector_Intrinsics_vec256 z6 = Lib_IntVector_Intrinsics_vec256_and(t42, y11);
+  Lib_IntVector_Intrinsics_vec256 z7 = Lib_IntVector_Intrinsics_vec256_and(t45, y17);
+  Lib_IntVector_Intrinsics_vec256 z8 = Lib_IntVector_Intrinsics_vec256_and(t41, y10);
+  Lib_IntVector_Intrinsics_vec256 z9 = Lib_IntVector_Intrinsics_vec256_and(t44, y12);
+  Lib_IntVector_Intrinsics_vec256 z10 = Lib_IntVector_Intrinsics_vec256_and(t37, y3);
+  Lib_IntVector_Intrinsics_vec256 z11 = Lib_IntVector_Intrinsics_vec256_and(t33, y4);
+  Lib_IntVector_Intrinsics_vec256 z12 = Lib_IntVector_Intrinsics_vec256_and(t43, y13);
+  Lib_IntVector_Intrinsics_vec256 z13 = Lib_IntVector_Intrinsics_vec256_and(t40, y5);
+  Lib_IntVector_Intrinsics_vec256 z14 = Lib_IntVector_Intrinsics_vec256_and(t29, y2);
+  Lib_IntVector_Intrinsics_vec256 z15 = Lib_IntVector_Intrinsics_vec256_and(t42, y9);
+  Lib_IntVector_Intrinsics_vec256 z16 = Lib_IntVector_Intrinsics_vec256_and(t45, y14);
+  Lib_IntVector_Intrinsics_vec256 z17 = Lib_IntVector_Intrinsics_vec256_and(t41, y8);
+  Lib_IntVector_Intrinsics_vec256 t46 = Lib_IntVector_Intrinsics_vec256_xor(z15, z16);
+  Lib_IntVector_Intrinsics_vec256 t47 = Lib_IntVector_Intrinsics_vec256_xor(z10, z11);
+  Lib_IntVector_Intrinsics_vec256 t48 = Lib_IntVector_Intrinsics_vec256_xor(z5, z13);
+  Lib_IntVector_Intrinsics_vec256 t49 = Lib_IntVector_Intrinsics_vec256_xor(z9, z10);
+  Lib_IntVector_Intrinsics_vec256 t50 = Lib_IntVector_Intrinsics_vec256_xor(z2, z12);
+  Lib_IntVector_Intrinsics_vec256 t51 = Lib_IntVector_Intrinsics_vec256_xor(z2, z5);
+  Lib_IntVector_Intrinsics_vec256 t52 = Lib_IntVector_Intrinsics_vec256_xor(z7, z8);
+  Lib_IntVector_Intrinsics_vec256 t53 = Lib_IntVector_Intrinsics_vec256_xor(z0, z3);
+  Lib_IntVector_Intrinsics_vec256 t54 = Lib_IntVector_Intrinsics_vec256_xor(z6, z7);
+  Lib_IntVector_Intrinsics_vec256 t55 = Lib_IntVector_Intrinsics_vec256_xor(z16, z17);
+  Lib_IntVector_Intrinsics_vec256 t56 = Lib_IntVector_Intrinsics_vec256_xor(z12, t48);
+  Lib_IntVector_Intrinsics_vec256 t57 = Lib_IntVector_Intrinsics_vec256_xor(t50, t53);
+  Lib_IntVector_Intrinsics_vec256 t58 = Lib_IntVector_Intrinsics_vec256_xor(z4, t46);
+  Lib_IntVector_Intrinsics_vec256 t59 = Lib_IntVector_Intrinsics_vec256_xor(z3, t54);
+  Lib_IntVector_Intrinsics_vec256 t60 = Lib_IntVector_Intrinsics_vec256_xor(t46, t57);
+  Lib_IntVector_Intrinsics_vec256 t61 = Lib_IntVector_Intrinsics_vec256_xor(z14, t57);
+  Lib_IntVector_Intrinsics_vec256 t62 = Lib_IntVector_Intrinsics_vec256_xor(t52, t58);
+  Lib_IntVector_Intrinsics_vec256 t63 = Lib_IntVector_Intrinsics_vec256_xor(t49, t58);
+  Lib_IntVector_Intrinsics_vec256 t64 = Lib_IntVector_Intrinsics_vec256_xor(z4, t59);
+  Lib_IntVector_Intrinsics_vec256 t65 = Lib_IntVector_Intrinsics_vec256_xor(t61, t62);
+  Lib_IntVector_Intrinsics_vec256 t66 = Lib_IntVector_Intrinsics_vec256_xor(z1, t63);
+  Lib_IntVector_Intrinsics_vec256 s0 = Lib_IntVector_Intrinsics_vec256_xor(t59, t63);
+  Lib_IntVector_Intrinsics_vec256 s6 = Lib_IntVector_Intrinsics_vec256_xor(t56, Lib_IntVector_Intrinsics_vec256_lognot(t62));
+  Lib_IntVector_Intrinsics_vec256 s7 = Lib_IntVector_Intrinsics_vec256_xor(t48, Lib_IntVector_Intrinsics_vec256_lognot(t60));
+  Lib_IntVector_Intrinsics_vec256 t67 = Lib_IntVector_Intrinsics_vec256_xor(t64, t65);
+  Lib_IntVector_Intrinsics_vec256 s3 = Lib_IntVector_Intrinsics_vec256_xor(t53, t66);
+  Lib_IntVector_Intrinsics_vec256 s4 = Lib_IntVector_Intrinsics_vec256_xor(t51, t66);
+  Lib_IntVector_Intrinsics_vec256 s5 = Lib_IntVector_Intrinsics_vec256_xor(t47, t65);
+  Lib_IntVector_Intrinsics_vec256 s1 = Lib_IntVector_Intrinsics_vec256_xor(t64, Lib_IntVector_Intrinsics_vec256_lognot(s3));
+  Lib_IntVector_Intrinsics_vec256 s2 = Lib_IntVector_Intrinsics_vec256_xor(t55, Lib_IntVector_Intrinsics_vec256_lognot(t67));
+  q[7U] = s0;
+  q[6U] = s1;
+  q[5U] = s2;
+  q[4U] = s3;
+  q[3U] = s4;
+  q[2U] = s5;
+  q[1U] = s6;
+  q[0U] = s7;
+}
+
+static inline void aes_shift_rows(Lib_IntVector_Intrinsics_vec256 *q)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 x = q[i];
+    q[i] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xffffU)), Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xfff00000U)), (uint32_t)4U)), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xf0000U)), (uint32_t)12U)), Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xff0000000000U)), (uint32_t)8U)), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xff00000000U)), (uint32_t)8U)), Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xf000000000000000U)), (uint32_t)12U)), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xfff000000000000U)), (uint32_t)4U));
+  }
+}
+
+static inline void aes_mix_columns(Lib_IntVector_Intrinsics_vec256 *q)
+{
+  Lib_IntVector_Intrinsics_vec256 q0 = q[0U];
+  Lib_IntVector_Intrinsics_vec256 q1 = q[1U];
+  Lib_IntVector_Intrinsics_vec256 q2 = q[2U];
+  Lib_IntVector_Intrinsics_vec256 q3 = q[3U];
+  Lib_IntVector_Intrinsics_vec256 q4 = q[4U];
+  Lib_IntVector_Intrinsics_vec256 q5 = q[5U];
+  Lib_IntVector_Intrinsics_vec256 q6 = q[6U];
+  Lib_IntVector_Intrinsics_vec256 q7 = q[7U];
+  Lib_IntVector_Intrinsics_vec256 r0 = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(q0, (uint32_t)16U), Lib_IntVector_Intrinsics_vec256_shift_left64(q0, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec256 r1 = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(q1, (uint32_t)16U), Lib_IntVector_Intrinsics_vec256_shift_left64(q1, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec256 r2 = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(q2, (uint32_t)16U), Lib_IntVector_Intrinsics_vec256_shift_left64(q2, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec256 r3 = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(q3, (uint32_t)16U), Lib_IntVector_Intrinsics_vec256_shift_left64(q3, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec256 r4 = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(q4, (uint32_t)16U), Lib_IntVector_Intrinsics_vec256_shift_left64(q4, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec256 r5 = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(q5, (uint32_t)16U), Lib_IntVector_Intrinsics_vec256_shift_left64(q5, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec256 r6 = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(q6, (uint32_t)16U), Lib_IntVector_Intrinsics_vec256_shift_left64(q6, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec256 r7 = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(q7, (uint32_t)16U), Lib_IntVector_Intrinsics_vec256_shift_left64(q7, (uint32_t)48U));
+  Lib_IntVector_Intrinsics_vec256 u0 = Lib_IntVector_Intrinsics_vec256_xor(q0, r0);
+  Lib_IntVector_Intrinsics_vec256 u1 = Lib_IntVector_Intrinsics_vec256_xor(q1, r1);
+  Lib_IntVector_Intrinsics_vec256 u2 = Lib_IntVector_Intrinsics_vec256_xor(q2, r2);
+  Lib_IntVector_Intrinsics_vec256 u3 = Lib_IntVector_Intrinsics_vec256_xor(q3, r3);
+  Lib_IntVector_Intrinsics_vec256 u4 = Lib_IntVector_Intrinsics_vec256_xor(q4, r4);
+  Lib_IntVector_Intrinsics_vec256 u5 = Lib_IntVector_Intrinsics_vec256_xor(q5, r5);
+  Lib_IntVector_Intrinsics_vec256 u6 = Lib_IntVector_Intrinsics_vec256_xor(q6, r6);
+  Lib_IntVector_Intrinsics_vec256 u7 = Lib_IntVector_Intrinsics_vec256_xor(q7, r7);
+  q[0U] = Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(q7, r7), r0), Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_left64(u0, (uint32_t)32U), Lib_IntVector_Intrinsics_vec256_shift_right64(u0, (uint32_t)32U)));
+  q[1U] = Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(q0, r0), q7), r7), r1), Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_left64(u1, (uint32_t)32U), Lib_IntVector_Intrinsics_vec256_shift_right64(u1, (uint32_t)32U)));
+  q[2U] = Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(q1, r1), r2), Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_left64(u2, (uint32_t)32U), Lib_IntVector_Intrinsics_vec256_shift_right64(u2, (uint32_t)32U)));
+  q[3U] = Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(q2, r2), q7), r7), r3), Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_left64(u3, (uint32_t)32U), Lib_IntVector_Intrinsics_vec256_shift_right64(u3, (uint32_t)32U)));
+  q[4U] = Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(q3, r3), q7), r7), r4), Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_left64(u4, (uint32_t)32U), Lib_IntVector_Intrinsics_vec256_shift_right64(u4, (uint32_t)32U)));
+  q[5U] = Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(q4, r4), r5), Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_left64(u5, (uint32_t)32U), Lib_IntVector_Intrinsics_vec256_shift_right64(u5, (uint32_t)32U)));
+  q[6U] = Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(q5, r5), r6), Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_left64(u6, (uint32_t)32U), Lib_IntVector_Intrinsics_vec256_shift_right64(u6, (uint32_t)32U)));
+  q[7U] = Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_xor(q6, r6), r7), Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_left64(u7, (uint32_t)32U), Lib_IntVector_Intrinsics_vec256_shift_right64(u7, (uint32_t)32U)));
+}
+
+static inline void aes_add_round_key(Lib_IntVector_Intrinsics_vec256 *q, uint64_t *skey)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    q[i] = Lib_IntVector_Intrinsics_vec256_xor(q[i], Lib_IntVector_Intrinsics_vec256_load64(skey[i]));
+  }
+}
+
+static inline void aes_encrypt(uint32_t nr, uint64_t *skey, Lib_IntVector_Intrinsics_vec256 *q)
+{
+  aes_add_round_key(q, skey);
+  for (uint32_t i = (uint32_t)1U; i < nr; i++)
+  {
+    aes_sbox(q);
+    aes_shift_rows(q);
+    aes_mix_columns(q);
+    aes_add_round_key(q, skey + (uint32_t)8U * i);
+  }
+  aes_sbox(q);
+  aes_shift_rows(q);
+  aes_add_round_key(q, skey + (uint32_t)8U * nr);
+}
+
+static inline void aes_ortho(Lib_IntVector_Intrinsics_vec256 *q)
+{
+  Lib_IntVector_Intrinsics_vec256 cl1 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x5555555555555555U);
+  Lib_IntVector_Intrinsics_vec256 ch1 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xaaaaaaaaaaaaaaaaU);
+  Lib_IntVector_Intrinsics_vec256 a01 = q[0U];
+  Lib_IntVector_Intrinsics_vec256 b01 = q[1U];
+  q[0U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a01, cl1), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b01, cl1), (uint32_t)1U));
+  q[1U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a01, ch1), (uint32_t)1U), Lib_IntVector_Intrinsics_vec256_and(b01, ch1));
+  Lib_IntVector_Intrinsics_vec256 a23 = q[2U];
+  Lib_IntVector_Intrinsics_vec256 b23 = q[3U];
+  q[2U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a23, cl1), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b23, cl1), (uint32_t)1U));
+  q[3U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a23, ch1), (uint32_t)1U), Lib_IntVector_Intrinsics_vec256_and(b23, ch1));
+  Lib_IntVector_Intrinsics_vec256 a45 = q[4U];
+  Lib_IntVector_Intrinsics_vec256 b45 = q[5U];
+  q[4U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a45, cl1), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b45, cl1), (uint32_t)1U));
+  q[5U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a45, ch1), (uint32_t)1U), Lib_IntVector_Intrinsics_vec256_and(b45, ch1));
+  Lib_IntVector_Intrinsics_vec256 a67 = q[6U];
+  Lib_IntVector_Intrinsics_vec256 b67 = q[7U];
+  q[6U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a67, cl1), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b67, cl1), (uint32_t)1U));
+  q[7U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a67, ch1), (uint32_t)1U), Lib_IntVector_Intrinsics_vec256_and(b67, ch1));
+  Lib_IntVector_Intrinsics_vec256 cl2 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3333333333333333U);
+  Lib_IntVector_Intrinsics_vec256 ch2 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xccccccccccccccccU);
+  Lib_IntVector_Intrinsics_vec256 a02 = q[0U];
+  Lib_IntVector_Intrinsics_vec256 b02 = q[2U];
+  q[0U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a02, cl2), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b02, cl2), (uint32_t)2U));
+  q[2U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a02, ch2), (uint32_t)2U), Lib_IntVector_Intrinsics_vec256_and(b02, ch2));
+  Lib_IntVector_Intrinsics_vec256 a13 = q[1U];
+  Lib_IntVector_Intrinsics_vec256 b13 = q[3U];
+  q[1U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a13, cl2), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b13, cl2), (uint32_t)2U));
+  q[3U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a13, ch2), (uint32_t)2U), Lib_IntVector_Intrinsics_vec256_and(b13, ch2));
+  Lib_IntVector_Intrinsics_vec256 a46 = q[4U];
+  Lib_IntVector_Intrinsics_vec256 b46 = q[6U];
+  q[4U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a46, cl2), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b46, cl2), (uint32_t)2U));
+  q[6U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a46, ch2), (uint32_t)2U), Lib_IntVector_Intrinsics_vec256_and(b46, ch2));
+  Lib_IntVector_Intrinsics_vec256 a57 = q[5U];
+  Lib_IntVector_Intrinsics_vec256 b57 = q[7U];
+  q[5U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a57, cl2), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b57, cl2), (uint32_t)2U));
+  q[7U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a57, ch2), (uint32_t)2U), Lib_IntVector_Intrinsics_vec256_and(b57, ch2));
+  Lib_IntVector_Intrinsics_vec256 cl4 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xf0f0f0f0f0f0f0fU);
+  Lib_IntVector_Intrinsics_vec256 ch4 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0xf0f0f0f0f0f0f0f0U);
+  Lib_IntVector_Intrinsics_vec256 a04 = q[0U];
+  Lib_IntVector_Intrinsics_vec256 b04 = q[4U];
+  q[0U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a04, cl4), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b04, cl4), (uint32_t)4U));
+  q[4U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a04, ch4), (uint32_t)4U), Lib_IntVector_Intrinsics_vec256_and(b04, ch4));
+  Lib_IntVector_Intrinsics_vec256 a15 = q[1U];
+  Lib_IntVector_Intrinsics_vec256 b15 = q[5U];
+  q[1U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a15, cl4), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b15, cl4), (uint32_t)4U));
+  q[5U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a15, ch4), (uint32_t)4U), Lib_IntVector_Intrinsics_vec256_and(b15, ch4));
+  Lib_IntVector_Intrinsics_vec256 a26 = q[2U];
+  Lib_IntVector_Intrinsics_vec256 b26 = q[6U];
+  q[2U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a26, cl4), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b26, cl4), (uint32_t)4U));
+  q[6U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a26, ch4), (uint32_t)4U), Lib_IntVector_Intrinsics_vec256_and(b26, ch4));
+  Lib_IntVector_Intrinsics_vec256 a37 = q[3U];
+  Lib_IntVector_Intrinsics_vec256 b37 = q[7U];
+  q[3U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_and(a37, cl4), Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(b37, cl4), (uint32_t)4U));
+  q[7U] = Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(Lib_IntVector_Intrinsics_vec256_and(a37, ch4), (uint32_t)4U), Lib_IntVector_Intrinsics_vec256_and(b37, ch4));
+}
+
+/* Encrypts len <= 256 bytes: each lane holds the bitsliced state of four
+   counter blocks. */
+static inline void
+aes_ctr_batch(
+  uint32_t nr,
+  uint64_t *skey,
+  uint8_t *ctr_block,
+  uint32_t ctr,
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *inp
+)
+{
+  uint64_t qs[8U * 4U] = { 0U };
+  uint8_t tmp[256U] = { 0U };
+  Lib_IntVector_Intrinsics_vec256 q[8U];
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+  {
+    Hacl_AES_Bitslice_load_ctr(qs + (uint32_t)8U * l, ctr_block, ctr + (uint32_t)4U * l);
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+    {
+      store64_le(tmp + (uint32_t)8U * ((uint32_t)4U * j + l), qs[(uint32_t)8U * l + j]);
+    }
+  }
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+  {
+    q[j] = Lib_IntVector_Intrinsics_vec256_load_le(tmp + (uint32_t)8U * (uint32_t)4U * j);
+  }
+  aes_ortho(q);
+  aes_encrypt(nr, skey, q);
+  aes_ortho(q);
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+  {
+    Lib_IntVector_Intrinsics_vec256_store_le(tmp + (uint32_t)8U * (uint32_t)4U * j, q[j]);
+  }
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+  {
+    if ((uint32_t)64U * l < len)
+    {
+      uint32_t n = len - (uint32_t)64U * l;
+      if (n > (uint32_t)64U)
+      {
+        n = (uint32_t)64U;
+      }
+      for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+      {
+        qs[(uint32_t)8U * l + j] = load64_le(tmp + (uint32_t)8U * ((uint32_t)4U * j + l));
+      }
+      Hacl_AES_Bitslice_xor_blocks(n,
+        out + (uint32_t)64U * l,
+        inp + (uint32_t)64U * l,
+        qs + (uint32_t)8U * l);
+    }
+  }
+}
+
+void
+Hacl_AES_Bitslice_256_ctr(
+  uint32_t nr,
+  uint64_t *skey,
+  uint8_t *ctr_block,
+  uint32_t ctr,
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *inp
+)
+{
+  uint32_t nb = len / (uint32_t)256U;
+  uint32_t rem = len % (uint32_t)256U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    aes_ctr_batch(nr,
+      skey,
+      ctr_block,
+      ctr + (uint32_t)16U * i,
+      (uint32_t)256U,
+      out + (uint32_t)256U * i,
+      inp + (uint32_t)256U * i);
+  }
+  if (rem > (uint32_t)0U)
+  {
+    aes_ctr_batch(nr,
+      skey,
+      ctr_block,
+      ctr + (uint32_t)16U * nb,
+      rem,
+      out + (uint32_t)256U * nb,
+      inp + (uint32_t)256U * nb);
+  }
+}
+
@@ -403,20 +403,9 @@ static inline void poly1305_padded_32(uint64_t *ctx, uint32_t len, uint8_t *text
 }
 
 static inline void
-poly1305_do_32(
-  uint8_t *k,
-  uint32_t aadlen,
-  uint8_t *aad,
-  uint32_t mlen,
-  uint8_t *m,
-  uint8_t *out
-)
+poly1305_lengths_32(uint64_t *ctx, uint32_t aadlen, uint32_t mlen)
 {
-  uint64_t ctx[25U] = { 0U };
   uint8_t block[16U] = { 0U };
-  Hacl_Poly1305_32_poly1305_init(ctx, k);
-  poly1305_padded_32(ctx, aadlen, aad);
-  poly1305_padded_32(ctx, mlen, m);
   store64_le(block, (uint64_t)aadlen);
   store64_le(block + (uint32_t)8U, (uint64_t)mlen);
   uint64_t *pre = ctx + (uint32_t)5U;
@@ -537,7 +526,39 @@ poly1305_do_32(
   acc[2U] = o2;
   acc[3U] = o3;
   acc[4U] = o4;
-  Hacl_Poly1305_32_poly1305_finish(out, k, ctx);
+}
+
+/* Same threshold as Hacl_Chacha20Poly1305_256.c. */
+#define CHUNKED_MIN_LEN ((uint32_t)0x2000000U)
+
+static inline void
+chacha20_poly1305_32(
+  uint64_t *ctx,
+  uint8_t *k,
+  uint8_t *n,
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *text
+)
+{
+  uint32_t nc = len / (uint32_t)4096U;
+  uint32_t rem = len % (uint32_t)4096U;
+  for (uint32_t i = (uint32_t)0U; i < nc; i++)
+  {
+    uint8_t *o = out + i * (uint32_t)4096U;
+    uint8_t *t = text + i * (uint32_t)4096U;
+    uint32_t ctr = (uint32_t)1U + i * (uint32_t)64U;
+    Hacl_Chacha20_chacha20_encrypt((uint32_t)4096U, o, t, k, n, ctr);
+    poly1305_padded_32(ctx, (uint32_t)4096U, o);
+  }
+  if (rem > (uint32_t)0U)
+  {
+    uint8_t *o = out + nc * (uint32_t)4096U;
+    uint8_t *t = text + nc * (uint32_t)4096U;
+    uint32_t ctr = (uint32_t)1U + nc * (uint32_t)64U;
+    Hacl_Chacha20_chacha20_encrypt(rem, o, t, k, n, ctr);
+    poly1305_padded_32(ctx, rem, o);
+  }
 }
 
 void
@@ -552,11 +573,23 @@ Hacl_Chacha20Poly1305_32_aead_encrypt(
   uint8_t *mac
 )
 {
-  Hacl_Chacha20_chacha20_encrypt(mlen, cipher, m, k, n, (uint32_t)1U);
   uint8_t tmp[64U] = { 0U };
   Hacl_Chacha20_chacha20_encrypt((uint32_t)64U, tmp, tmp, k, n, (uint32_t)0U);
   uint8_t *key = tmp;
-  poly1305_do_32(key, aadlen, aad, mlen, cipher, mac);
+  uint64_t ctx[25U] = { 0U };
+  Hacl_Poly1305_32_poly1305_init(ctx, key);
+  poly1305_padded_32(ctx, aadlen, aad);
+  if (mlen >= CHUNKED_MIN_LEN)
+  {
+    chacha20_poly1305_32(ctx, k, n, mlen, cipher, m);
+  }
+  else
+  {
+    Hacl_Chacha20_chacha20_encrypt(mlen, cipher, m, k, n, (uint32_t)1U);
+    poly1305_padded_32(ctx, mlen, cipher);
+  }
+  poly1305_lengths_32(ctx, aadlen, mlen);
+  Hacl_Poly1305_32_poly1305_finish(mac, key, ctx);
 }
 
 uint32_t
@@ -575,7 +608,12 @@ Hacl_Chacha20Poly1305_32_aead_decrypt(
   uint8_t tmp[64U] = { 0U };
   Hacl_Chacha20_chacha20_encrypt((uint32_t)64U, tmp, tmp, k, n, (uint32_t)0U);
   uint8_t *key = tmp;
-  poly1305_do_32(key, aadlen, aad, mlen, cipher, computed_mac);
+  uint64_t ctx[25U] = { 0U };
+  Hacl_Poly1305_32_poly1305_init(ctx, key);
+  poly1305_padded_32(ctx, aadlen, aad);
+  poly1305_padded_32(ctx, mlen, cipher);
+  poly1305_lengths_32(ctx, aadlen, mlen);
+  Hacl_Poly1305_32_poly1305_finish(computed_mac, key, ctx);
   uint8_t res = (uint8_t)255U;
   for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
   {
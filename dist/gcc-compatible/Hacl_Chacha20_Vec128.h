@@ -60,6 +60,28 @@ Hacl_Chacha20_Vec128_chacha20_decrypt_128(
   uint32_t ctr
 );
 
+void
+Hacl_Chacha20_Vec128_chacha20_encrypt_multi_128(
+  uint32_t num,
+  uint32_t *len,
+  uint8_t **out,
+  uint8_t **text,
+  uint8_t **key,
+  uint8_t **n,
+  uint32_t ctr
+);
+
+void
+Hacl_Chacha20_Vec128_chacha20_encrypt_multi_ctr_128(
+  uint32_t num,
+  uint32_t *len,
+  uint8_t **out,
+  uint8_t **text,
+  uint8_t **key,
+  uint8_t **n,
+  uint32_t *ctr
+);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -891,3 +891,289 @@ Hacl_Chacha20_Vec256_chacha20_decrypt_256(
   }
 }
 
+
+static inline void
+chacha20_core_multi_256(
+  Lib_IntVector_Intrinsics_vec256 *k,
+  Lib_IntVector_Intrinsics_vec256 *ctx,
+  uint32_t ctr
+)
+{
+  memcpy(k, ctx, (uint32_t)16U * sizeof (Lib_IntVector_Intrinsics_vec256));
+  Lib_IntVector_Intrinsics_vec256 cv = Lib_IntVector_Intrinsics_vec256_load32(ctr);
+  k[12U] = Lib_IntVector_Intrinsics_vec256_add32(k[12U], cv);
+  double_round_256(k);
+  double_round_256(k);
+  double_round_256(k);
+  double_round_256(k);
+  double_round_256(k);
+  double_round_256(k);
+  double_round_256(k);
+  double_round_256(k);
+  double_round_256(k);
+  double_round_256(k);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 *os = k;
+    Lib_IntVector_Intrinsics_vec256 x = Lib_IntVector_Intrinsics_vec256_add32(k[i], ctx[i]);
+    os[i] = x;
+  }
+  k[12U] = Lib_IntVector_Intrinsics_vec256_add32(k[12U], cv);
+}
+
+void
+Hacl_Chacha20_Vec256_chacha20_encrypt_multi_ctr_256(
+  uint32_t num,
+  uint32_t *len,
+  uint8_t **out,
+  uint8_t **text,
+  uint8_t **key,
+  uint8_t **n,
+  uint32_t *ctr
+)
+{
+  uint32_t st[128U] = { 0U };
+  uint32_t nb = (uint32_t)0U;
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+  {
+    uint32_t l = j < num ? j : (uint32_t)0U;
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+    {
+      st[(uint32_t)8U * i + j] = Hacl_Impl_Chacha20_Vec_chacha20_constants[i];
+    }
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+    {
+      st[(uint32_t)8U * ((uint32_t)4U + i) + j] = load32_le(key[l] + i * (uint32_t)4U);
+    }
+    st[(uint32_t)96U + j] = ctr[l];
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)3U; i++)
+    {
+      st[(uint32_t)8U * ((uint32_t)13U + i) + j] = load32_le(n[l] + i * (uint32_t)4U);
+    }
+    if (j < num)
+    {
+      uint32_t nbj = (len[j] + (uint32_t)63U) / (uint32_t)64U;
+      if (nbj > nb)
+      {
+        nb = nbj;
+      }
+    }
+  }
+  Lib_IntVector_Intrinsics_vec256 ctx[16U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    uint32_t *sti = st + (uint32_t)8U * i;
+    ctx[i] =
+      Lib_IntVector_Intrinsics_vec256_load32s(sti[0U],
+        sti[1U],
+        sti[2U],
+        sti[3U],
+        sti[4U],
+        sti[5U],
+        sti[6U],
+        sti[7U]);
+  }
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 k[16U];
+    for (uint32_t _i = 0U; _i < (uint32_t)16U; ++_i)
+      k[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+    chacha20_core_multi_256(k, ctx, i);
+    Lib_IntVector_Intrinsics_vec256 v00 = k[0U];
+    Lib_IntVector_Intrinsics_vec256 v16 = k[1U];
+    Lib_IntVector_Intrinsics_vec256 v20 = k[2U];
+    Lib_IntVector_Intrinsics_vec256 v30 = k[3U];
+    Lib_IntVector_Intrinsics_vec256 v40 = k[4U];
+    Lib_IntVector_Intrinsics_vec256 v50 = k[5U];
+    Lib_IntVector_Intrinsics_vec256 v60 = k[6U];
+    Lib_IntVector_Intrinsics_vec256 v70 = k[7U];
+    Lib_IntVector_Intrinsics_vec256
+    v0_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v00, v16);
+    Lib_IntVector_Intrinsics_vec256
+    v1_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v00, v16);
+    Lib_IntVector_Intrinsics_vec256
+    v2_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v20, v30);
+    Lib_IntVector_Intrinsics_vec256
+    v3_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v20, v30);
+    Lib_IntVector_Intrinsics_vec256
+    v4_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v40, v50);
+    Lib_IntVector_Intrinsics_vec256
+    v5_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v40, v50);
+    Lib_IntVector_Intrinsics_vec256
+    v6_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v60, v70);
+    Lib_IntVector_Intrinsics_vec256
+    v7_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v60, v70);
+    Lib_IntVector_Intrinsics_vec256
+    v0__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v0_, v2_);
+    Lib_IntVector_Intrinsics_vec256
+    v1__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v0_, v2_);
+    Lib_IntVector_Intrinsics_vec256
+    v2__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v1_, v3_);
+    Lib_IntVector_Intrinsics_vec256
+    v3__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v1_, v3_);
+    Lib_IntVector_Intrinsics_vec256
+    v4__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v4_, v6_);
+    Lib_IntVector_Intrinsics_vec256
+    v5__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v4_, v6_);
+    Lib_IntVector_Intrinsics_vec256
+    v6__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v5_, v7_);
+    Lib_IntVector_Intrinsics_vec256
+    v7__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v5_, v7_);
+    Lib_IntVector_Intrinsics_vec256
+    v0___ = Lib_IntVector_Intrinsics_vec256_interleave_low128(v0__, v4__);
+    Lib_IntVector_Intrinsics_vec256
+    v1___ = Lib_IntVector_Intrinsics_vec256_interleave_high128(v0__, v4__);
+    Lib_IntVector_Intrinsics_vec256
+    v2___ = Lib_IntVector_Intrinsics_vec256_interleave_low128(v1__, v5__);
+    Lib_IntVector_Intrinsics_vec256
+    v3___ = Lib_IntVector_Intrinsics_vec256_interleave_high128(v1__, v5__);
+    Lib_IntVector_Intrinsics_vec256
+    v4___ = Lib_IntVector_Intrinsics_vec256_interleave_low128(v2__, v6__);
+    Lib_IntVector_Intrinsics_vec256
+    v5___ = Lib_IntVector_Intrinsics_vec256_interleave_high128(v2__, v6__);
+    Lib_IntVector_Intrinsics_vec256
+    v6___ = Lib_IntVector_Intrinsics_vec256_interleave_low128(v3__, v7__);
+    Lib_IntVector_Intrinsics_vec256
+    v7___ = Lib_IntVector_Intrinsics_vec256_interleave_high128(v3__, v7__);
+    Lib_IntVector_Intrinsics_vec256 v0 = v0___;
+    Lib_IntVector_Intrinsics_vec256 v1 = v2___;
+    Lib_IntVector_Intrinsics_vec256 v2 = v4___;
+    Lib_IntVector_Intrinsics_vec256 v3 = v6___;
+    Lib_IntVector_Intrinsics_vec256 v4 = v1___;
+    Lib_IntVector_Intrinsics_vec256 v5 = v3___;
+    Lib_IntVector_Intrinsics_vec256 v6 = v5___;
+    Lib_IntVector_Intrinsics_vec256 v7 = v7___;
+    Lib_IntVector_Intrinsics_vec256 v01 = k[8U];
+    Lib_IntVector_Intrinsics_vec256 v110 = k[9U];
+    Lib_IntVector_Intrinsics_vec256 v21 = k[10U];
+    Lib_IntVector_Intrinsics_vec256 v31 = k[11U];
+    Lib_IntVector_Intrinsics_vec256 v41 = k[12U];
+    Lib_IntVector_Intrinsics_vec256 v51 = k[13U];
+    Lib_IntVector_Intrinsics_vec256 v61 = k[14U];
+    Lib_IntVector_Intrinsics_vec256 v71 = k[15U];
+    Lib_IntVector_Intrinsics_vec256
+    v0_0 = Lib_IntVector_Intrinsics_vec256_interleave_low32(v01, v110);
+    Lib_IntVector_Intrinsics_vec256
+    v1_0 = Lib_IntVector_Intrinsics_vec256_interleave_high32(v01, v110);
+    Lib_IntVector_Intrinsics_vec256
+    v2_0 = Lib_IntVector_Intrinsics_vec256_interleave_low32(v21, v31);
+    Lib_IntVector_Intrinsics_vec256
+    v3_0 = Lib_IntVector_Intrinsics_vec256_interleave_high32(v21, v31);
+    Lib_IntVector_Intrinsics_vec256
+    v4_0 = Lib_IntVector_Intrinsics_vec256_interleave_low32(v41, v51);
+    Lib_IntVector_Intrinsics_vec256
+    v5_0 = Lib_IntVector_Intrinsics_vec256_interleave_high32(v41, v51);
+    Lib_IntVector_Intrinsics_vec256
+    v6_0 = Lib_IntVector_Intrinsics_vec256_interleave_low32(v61, v71);
+    Lib_IntVector_Intrinsics_vec256
+    v7_0 = Lib_IntVector_Intrinsics_vec256_interleave_high32(v61, v71);
+    Lib_IntVector_Intrinsics_vec256
+    v0__0 = Lib_IntVector_Intrinsics_vec256_interleave_low64(v0_0, v2_0);
+    Lib_IntVector_Intrinsics_vec256
+    v1__0 = Lib_IntVector_Intrinsics_vec256_interleave_high64(v0_0, v2_0);
+    Lib_IntVector_Intrinsics_vec256
+    v2__0 = Lib_IntVector_Intrinsics_vec256_interleave_low64(v1_0, v3_0);
+    Lib_IntVector_Intrinsics_vec256
+    v3__0 = Lib_IntVector_Intrinsics_vec256_interleave_high64(v1_0, v3_0);
+    Lib_IntVector_Intrinsics_vec256
+    v4__0 = Lib_IntVector_Intrinsics_vec256_interleave_low64(v4_0, v6_0);
+    Lib_IntVector_Intrinsics_vec256
+    v5__0 = Lib_IntVector_Intrinsics_vec256_interleave_high64(v4_0, v6_0);
+    Lib_IntVector_Intrinsics_vec256
+    v6__0 = Lib_IntVector_Intrinsics_vec256_interleave_low64(v5_0, v7_0);
+    Lib_IntVector_Intrinsics_vec256
+    v7__0 = Lib_IntVector_Intrinsics_vec256_interleave_high64(v5_0, v7_0);
+    Lib_IntVector_Intrinsics_vec256
+    v0___0 = Lib_IntVector_Intrinsics_vec256_interleave_low128(v0__0, v4__0);
+    Lib_IntVector_Intrinsics_vec256
+    v1___0 = Lib_IntVector_Intrinsics_vec256_interleave_high128(v0__0, v4__0);
+    Lib_IntVector_Intrinsics_vec256
+    v2___0 = Lib_IntVector_Intrinsics_vec256_interleave_low128(v1__0, v5__0);
+    Lib_IntVector_Intrinsics_vec256
+    v3___0 = Lib_IntVector_Intrinsics_vec256_interleave_high128(v1__0, v5__0);
+    Lib_IntVector_Intrinsics_vec256
+    v4___0 = Lib_IntVector_Intrinsics_vec256_interleave_low128(v2__0, v6__0);
+    Lib_IntVector_Intrinsics_vec256
+    v5___0 = Lib_IntVector_Intrinsics_vec256_interleave_high128(v2__0, v6__0);
+    Lib_IntVector_Intrinsics_vec256
+    v6___0 = Lib_IntVector_Intrinsics_vec256_interleave_low128(v3__0, v7__0);
+    Lib_IntVector_Intrinsics_vec256
+    v7___0 = Lib_IntVector_Intrinsics_vec256_interleave_high128(v3__0, v7__0);
+    Lib_IntVector_Intrinsics_vec256 v8 = v0___0;
+    Lib_IntVector_Intrinsics_vec256 v9 = v2___0;
+    Lib_IntVector_Intrinsics_vec256 v10 = v4___0;
+    Lib_IntVector_Intrinsics_vec256 v11 = v6___0;
+    Lib_IntVector_Intrinsics_vec256 v12 = v1___0;
+    Lib_IntVector_Intrinsics_vec256 v13 = v3___0;
+    Lib_IntVector_Intrinsics_vec256 v14 = v5___0;
+    Lib_IntVector_Intrinsics_vec256 v15 = v7___0;
+    k[0U] = v0;
+    k[1U] = v8;
+    k[2U] = v1;
+    k[3U] = v9;
+    k[4U] = v2;
+    k[5U] = v10;
+    k[6U] = v3;
+    k[7U] = v11;
+    k[8U] = v4;
+    k[9U] = v12;
+    k[10U] = v5;
+    k[11U] = v13;
+    k[12U] = v6;
+    k[13U] = v14;
+    k[14U] = v7;
+    k[15U] = v15;
+    for (uint32_t j = (uint32_t)0U; j < num; j++)
+    {
+      if (i * (uint32_t)64U < len[j])
+      {
+        uint32_t rem = len[j] - i * (uint32_t)64U;
+        uint8_t *o = out[j] + i * (uint32_t)64U;
+        uint8_t *t = text[j] + i * (uint32_t)64U;
+        Lib_IntVector_Intrinsics_vec256 *kj = k + (uint32_t)2U * j;
+        if (rem >= (uint32_t)64U)
+        {
+          for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)2U; i0++)
+          {
+            Lib_IntVector_Intrinsics_vec256
+            x = Lib_IntVector_Intrinsics_vec256_load_le(t + i0 * (uint32_t)32U);
+            Lib_IntVector_Intrinsics_vec256 y = Lib_IntVector_Intrinsics_vec256_xor(x, kj[i0]);
+            Lib_IntVector_Intrinsics_vec256_store_le(o + i0 * (uint32_t)32U, y);
+          }
+        }
+        else
+        {
+          uint8_t plain[64U] = { 0U };
+          memcpy(plain, t, rem * sizeof (uint8_t));
+          for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)2U; i0++)
+          {
+            Lib_IntVector_Intrinsics_vec256
+            x = Lib_IntVector_Intrinsics_vec256_load_le(plain + i0 * (uint32_t)32U);
+            Lib_IntVector_Intrinsics_vec256 y = Lib_IntVector_Intrinsics_vec256_xor(x, kj[i0]);
+            Lib_IntVector_Intrinsics_vec256_store_le(plain + i0 * (uint32_t)32U, y);
+          }
+          memcpy(o, plain, rem * sizeof (uint8_t));
+        }
+      }
+    }
+  }
+}
+
+void
+Hacl_Chacha20_Vec256_chacha20_encrypt_multi_256(
+  uint32_t num,
+  uint32_t *len,
+  uint8_t **out,
+  uint8_t **text,
+  uint8_t **key,
+  uint8_t **n,
+  uint32_t ctr
+)
+{
+  uint32_t ctrs[8U];
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+  {
+    ctrs[j] = ctr;
+  }
+  Hacl_Chacha20_Vec256_chacha20_encrypt_multi_ctr_256(num, len, out, text, key, n, ctrs);
+}
@@ -0,0 +1,445 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_Chacha20_Vec512.h"
+
+static inline void double_round_512(Lib_IntVector_Intrinsics_vec512 *st)
+{
+  st[0U] = Lib_IntVector_Intrinsics_vec512_add32(st[0U], st[4U]);
+  Lib_IntVector_Intrinsics_vec512 std = Lib_IntVector_Intrinsics_vec512_xor(st[12U], st[0U]);
+  st[12U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std, (uint32_t)16U);
+  st[8U] = Lib_IntVector_Intrinsics_vec512_add32(st[8U], st[12U]);
+  Lib_IntVector_Intrinsics_vec512 std0 = Lib_IntVector_Intrinsics_vec512_xor(st[4U], st[8U]);
+  st[4U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std0, (uint32_t)12U);
+  st[0U] = Lib_IntVector_Intrinsics_vec512_add32(st[0U], st[4U]);
+  Lib_IntVector_Intrinsics_vec512 std1 = Lib_IntVector_Intrinsics_vec512_xor(st[12U], st[0U]);
+  st[12U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std1, (uint32_t)8U);
+  st[8U] = Lib_IntVector_Intrinsics_vec512_add32(st[8U], st[12U]);
+  Lib_IntVector_Intrinsics_vec512 std2 = Lib_IntVector_Intrinsics_vec512_xor(st[4U], st[8U]);
+  st[4U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std2, (uint32_t)7U);
+  st[1U] = Lib_IntVector_Intrinsics_vec512_add32(st[1U], st[5U]);
+  Lib_IntVector_Intrinsics_vec512 std3 = Lib_IntVector_Intrinsics_vec512_xor(st[13U], st[1U]);
+  st[13U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std3, (uint32_t)16U);
+  st[9U] = Lib_IntVector_Intrinsics_vec512_add32(st[9U], st[13U]);
+  Lib_IntVector_Intrinsics_vec512 std4 = Lib_IntVector_Intrinsics_vec512_xor(st[5U], st[9U]);
+  st[5U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std4, (uint32_t)12U);
+  st[1U] = Lib_IntVector_Intrinsics_vec512_add32(st[1U], st[5U]);
+  Lib_IntVector_Intrinsics_vec512 std5 = Lib_IntVector_Intrinsics_vec512_xor(st[13U], st[1U]);
+  st[13U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std5, (uint32_t)8U);
+  st[9U] = Lib_IntVector_Intrinsics_vec512_add32(st[9U], st[13U]);
+  Lib_IntVector_Intrinsics_vec512 std6 = Lib_IntVector_Intrinsics_vec512_xor(st[5U], st[9U]);
+  st[5U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std6, (uint32_t)7U);
+  st[2U] = Lib_IntVector_Intrinsics_vec512_add32(st[2U], st[6U]);
+  Lib_IntVector_Intrinsics_vec512 std7 = Lib_IntVector_Intrinsics_vec512_xor(st[14U], st[2U]);
+  st[14U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std7, (uint32_t)16U);
+  st[10U] = Lib_IntVector_Intrinsics_vec512_add32(st[10U], st[14U]);
+  Lib_IntVector_Intrinsics_vec512 std8 = Lib_IntVector_Intrinsics_vec512_xor(st[6U], st[10U]);
+  st[6U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std8, (uint32_t)12U);
+  st[2U] = Lib_IntVector_Intrinsics_vec512_add32(st[2U], st[6U]);
+  Lib_IntVector_Intrinsics_vec512 std9 = Lib_IntVector_Intrinsics_vec512_xor(st[14U], st[2U]);
+  st[14U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std9, (uint32_t)8U);
+  st[10U] = Lib_IntVector_Intrinsics_vec512_add32(st[10U], st[14U]);
+  Lib_IntVector_Intrinsics_vec512 std10 = Lib_IntVector_Intrinsics_vec512_xor(st[6U], st[10U]);
+  st[6U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std10, (uint32_t)7U);
+  st[3U] = Lib_IntVector_Intrinsics_vec512_add32(st[3U], st[7U]);
+  Lib_IntVector_Intrinsics_vec512 std11 = Lib_IntVector_Intrinsics_vec512_xor(st[15U], st[3U]);
+  st[15U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std11, (uint32_t)16U);
+  st[11U] = Lib_IntVector_Intrinsics_vec512_add32(st[11U], st[15U]);
+  Lib_IntVector_Intrinsics_vec512 std12 = Lib_IntVector_Intrinsics_vec512_xor(st[7U], st[11U]);
+  st[7U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std12, (uint32_t)12U);
+  st[3U] = Lib_IntVector_Intrinsics_vec512_add32(st[3U], st[7U]);
+  Lib_IntVector_Intrinsics_vec512 std13 = Lib_IntVector_Intrinsics_vec512_xor(st[15U], st[3U]);
+  st[15U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std13, (uint32_t)8U);
+  st[11U] = Lib_IntVector_Intrinsics_vec512_add32(st[11U], st[15U]);
+  Lib_IntVector_Intrinsics_vec512 std14 = Lib_IntVector_Intrinsics_vec512_xor(st[7U], st[11U]);
+  st[7U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std14, (uint32_t)7U);
+  st[0U] = Lib_IntVector_Intrinsics_vec512_add32(st[0U], st[5U]);
+  Lib_IntVector_Intrinsics_vec512 std15 = Lib_IntVector_Intrinsics_vec512_xor(st[15U], st[0U]);
+  st[15U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std15, (uint32_t)16U);
+  st[10U] = Lib_IntVector_Intrinsics_vec512_add32(st[10U], st[15U]);
+  Lib_IntVector_Intrinsics_vec512 std16 = Lib_IntVector_Intrinsics_vec512_xor(st[5U], st[10U]);
+  st[5U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std16, (uint32_t)12U);
+  st[0U] = Lib_IntVector_Intrinsics_vec512_add32(st[0U], st[5U]);
+  Lib_IntVector_Intrinsics_vec512 std17 = Lib_IntVector_Intrinsics_vec512_xor(st[15U], st[0U]);
+  st[15U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std17, (uint32_t)8U);
+  st[10U] = Lib_IntVector_Intrinsics_vec512_add32(st[10U], st[15U]);
+  Lib_IntVector_Intrinsics_vec512 std18 = Lib_IntVector_Intrinsics_vec512_xor(st[5U], st[10U]);
+  st[5U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std18, (uint32_t)7U);
+  st[1U] = Lib_IntVector_Intrinsics_vec512_add32(st[1U], st[6U]);
+  Lib_IntVector_Intrinsics_vec512 std19 = Lib_IntVector_Intrinsics_vec512_xor(st[12U], st[1U]);
+  st[12U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std19, (uint32_t)16U);
+  st[11U] = Lib_IntVector_Intrinsics_vec512_add32(st[11U], st[12U]);
+  Lib_IntVector_Intrinsics_vec512 std20 = Lib_IntVector_Intrinsics_vec512_xor(st[6U], st[11U]);
+  st[6U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std20, (uint32_t)12U);
+  st[1U] = Lib_IntVector_Intrinsics_vec512_add32(st[1U], st[6U]);
+  Lib_IntVector_Intrinsics_vec512 std21 = Lib_IntVector_Intrinsics_vec512_xor(st[12U], st[1U]);
+  st[12U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std21, (uint32_t)8U);
+  st[11U] = Lib_IntVector_Intrinsics_vec512_add32(st[11U], st[12U]);
+  Lib_IntVector_Intrinsics_vec512 std22 = Lib_IntVector_Intrinsics_vec512_xor(st[6U], st[11U]);
+  st[6U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std22, (uint32_t)7U);
+  st[2U] = Lib_IntVector_Intrinsics_vec512_add32(st[2U], st[7U]);
+  Lib_IntVector_Intrinsics_vec512 std23 = Lib_IntVector_Intrinsics_vec512_xor(st[13U], st[2U]);
+  st[13U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std23, (uint32_t)16U);
+  st[8U] = Lib_IntVector_Intrinsics_vec512_add32(st[8U], st[13U]);
+  Lib_IntVector_Intrinsics_vec512 std24 = Lib_IntVector_Intrinsics_vec512_xor(st[7U], st[8U]);
+  st[7U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std24, (uint32_t)12U);
+  st[2U] = Lib_IntVector_Intrinsics_vec512_add32(st[2U], st[7U]);
+  Lib_IntVector_Intrinsics_vec512 std25 = Lib_IntVector_Intrinsics_vec512_xor(st[13U], st[2U]);
+  st[13U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std25, (uint32_t)8U);
+  st[8U] = Lib_IntVector_Intrinsics_vec512_add32(st[8U], st[13U]);
+  Lib_IntVector_Intrinsics_vec512 std26 = Lib_IntVector_Intrinsics_vec512_xor(st[7U], st[8U]);
+  st[7U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std26, (uint32_t)7U);
+  st[3U] = Lib_IntVector_Intrinsics_vec512_add32(st[3U], st[4U]);
+  Lib_IntVector_Intrinsics_vec512 std27 = Lib_IntVector_Intrinsics_vec512_xor(st[14U], st[3U]);
+  st[14U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std27, (uint32_t)16U);
+  st[9U] = Lib_IntVector_Intrinsics_vec512_add32(st[9U], st[14U]);
+  Lib_IntVector_Intrinsics_vec512 std28 = Lib_IntVector_Intrinsics_vec512_xor(st[4U], st[9U]);
+  st[4U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std28, (uint32_t)12U);
+  st[3U] = Lib_IntVector_Intrinsics_vec512_add32(st[3U], st[4U]);
+  Lib_IntVector_Intrinsics_vec512 std29 = Lib_IntVector_Intrinsics_vec512_xor(st[14U], st[3U]);
+  st[14U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std29, (uint32_t)8U);
+  st[9U] = Lib_IntVector_Intrinsics_vec512_add32(st[9U], st[14U]);
+  Lib_IntVector_Intrinsics_vec512 std30 = Lib_IntVector_Intrinsics_vec512_xor(st[4U], st[9U]);
+  st[4U] = Lib_IntVector_Intrinsics_vec512_rotate_left32(std30, (uint32_t)7U);
+}
+
+static inline void
+chacha20_core_512(
+  Lib_IntVector_Intrinsics_vec512 *k,
+  Lib_IntVector_Intrinsics_vec512 *ctx,
+  uint32_t ctr
+)
+{
+  memcpy(k, ctx, (uint32_t)16U * sizeof (Lib_IntVector_Intrinsics_vec512));
+  uint32_t ctr_u32 = (uint32_t)16U * ctr;
+  Lib_IntVector_Intrinsics_vec512 cv = Lib_IntVector_Intrinsics_vec512_load32(ctr_u32);
+  k[12U] = Lib_IntVector_Intrinsics_vec512_add32(k[12U], cv);
+  double_round_512(k);
+  double_round_512(k);
+  double_round_512(k);
+  double_round_512(k);
+  double_round_512(k);
+  double_round_512(k);
+  double_round_512(k);
+  double_round_512(k);
+  double_round_512(k);
+  double_round_512(k);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512 *os = k;
+    Lib_IntVector_Intrinsics_vec512 x = Lib_IntVector_Intrinsics_vec512_add32(k[i], ctx[i]);
+    os[i] = x;
+  }
+  k[12U] = Lib_IntVector_Intrinsics_vec512_add32(k[12U], cv);
+}
+
+static inline void
+chacha20_init_512(Lib_IntVector_Intrinsics_vec512 *ctx, uint8_t *k, uint8_t *n, uint32_t ctr)
+{
+  uint32_t ctx1[16U] = { 0U };
+  uint32_t *uu____0 = ctx1;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    uint32_t *os = uu____0;
+    uint32_t x = Hacl_Impl_Chacha20_Vec_chacha20_constants[i];
+    os[i] = x;
+  }
+  uint32_t *uu____1 = ctx1 + (uint32_t)4U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    uint32_t *os = uu____1;
+    uint8_t *bj = k + i * (uint32_t)4U;
+    uint32_t u = load32_le(bj);
+    uint32_t r = u;
+    uint32_t x = r;
+    os[i] = x;
+  }
+  ctx1[12U] = ctr;
+  uint32_t *uu____2 = ctx1 + (uint32_t)13U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)3U; i++)
+  {
+    uint32_t *os = uu____2;
+    uint8_t *bj = n + i * (uint32_t)4U;
+    uint32_t u = load32_le(bj);
+    uint32_t r = u;
+    uint32_t x = r;
+    os[i] = x;
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512 *os = ctx;
+    uint32_t x = ctx1[i];
+    Lib_IntVector_Intrinsics_vec512 x0 = Lib_IntVector_Intrinsics_vec512_load32(x);
+    os[i] = x0;
+  }
+  Lib_IntVector_Intrinsics_vec512
+  ctr1 =
+    Lib_IntVector_Intrinsics_vec512_load32s((uint32_t)0U,
+      (uint32_t)1U,
+      (uint32_t)2U,
+      (uint32_t)3U,
+      (uint32_t)4U,
+      (uint32_t)5U,
+      (uint32_t)6U,
+      (uint32_t)7U,
+      (uint32_t)8U,
+      (uint32_t)9U,
+      (uint32_t)10U,
+      (uint32_t)11U,
+      (uint32_t)12U,
+      (uint32_t)13U,
+      (uint32_t)14U,
+      (uint32_t)15U);
+  Lib_IntVector_Intrinsics_vec512 c12 = ctx[12U];
+  ctx[12U] = Lib_IntVector_Intrinsics_vec512_add32(c12, ctr1);
+}
+
+static inline void transpose16_512(Lib_IntVector_Intrinsics_vec512 *k)
+{
+  Lib_IntVector_Intrinsics_vec512
+  v0_0 = Lib_IntVector_Intrinsics_vec512_interleave_low32(k[0U], k[1U]);
+  Lib_IntVector_Intrinsics_vec512
+  v1_0 = Lib_IntVector_Intrinsics_vec512_interleave_high32(k[0U], k[1U]);
+  Lib_IntVector_Intrinsics_vec512
+  v2_0 = Lib_IntVector_Intrinsics_vec512_interleave_low32(k[2U], k[3U]);
+  Lib_IntVector_Intrinsics_vec512
+  v3_0 = Lib_IntVector_Intrinsics_vec512_interleave_high32(k[2U], k[3U]);
+  Lib_IntVector_Intrinsics_vec512
+  x00 = Lib_IntVector_Intrinsics_vec512_interleave_low64(v0_0, v2_0);
+  Lib_IntVector_Intrinsics_vec512
+  x01 = Lib_IntVector_Intrinsics_vec512_interleave_high64(v0_0, v2_0);
+  Lib_IntVector_Intrinsics_vec512
+  x02 = Lib_IntVector_Intrinsics_vec512_interleave_low64(v1_0, v3_0);
+  Lib_IntVector_Intrinsics_vec512
+  x03 = Lib_IntVector_Intrinsics_vec512_interleave_high64(v1_0, v3_0);
+  Lib_IntVector_Intrinsics_vec512
+  v0_1 = Lib_IntVector_Intrinsics_vec512_interleave_low32(k[4U], k[5U]);
+  Lib_IntVector_Intrinsics_vec512
+  v1_1 = Lib_IntVector_Intrinsics_vec512_interleave_high32(k[4U], k[5U]);
+  Lib_IntVector_Intrinsics_vec512
+  v2_1 = Lib_IntVector_Intrinsics_vec512_interleave_low32(k[6U], k[7U]);
+  Lib_IntVector_Intrinsics_vec512
+  v3_1 = Lib_IntVector_Intrinsics_vec512_interleave_high32(k[6U], k[7U]);
+  Lib_IntVector_Intrinsics_vec512
+  x10 = Lib_IntVector_Intrinsics_vec512_interleave_low64(v0_1, v2_1);
+  Lib_IntVector_Intrinsics_vec512
+  x11 = Lib_IntVector_Intrinsics_vec512_interleave_high64(v0_1, v2_1);
+  Lib_IntVector_Intrinsics_vec512
+  x12 = Lib_IntVector_Intrinsics_vec512_interleave_low64(v1_1, v3_1);
+  Lib_IntVector_Intrinsics_vec512
+  x13 = Lib_IntVector_Intrinsics_vec512_interleave_high64(v1_1, v3_1);
+  Lib_IntVector_Intrinsics_vec512
+  v0_2 = Lib_IntVector_Intrinsics_vec512_interleave_low32(k[8U], k[9U]);
+  Lib_IntVector_Intrinsics_vec512
+  v1_2 = Lib_IntVector_Intrinsics_vec512_interleave_high32(k[8U], k[9U]);
+  Lib_IntVector_Intrinsics_vec512
+  v2_2 = Lib_IntVector_Intrinsics_vec512_interleave_low32(k[10U], k[11U]);
+  Lib_IntVector_Intrinsics_vec512
+  v3_2 = Lib_IntVector_Intrinsics_vec512_interleave_high32(k[10U], k[11U]);
+  Lib_IntVector_Intrinsics_vec512
+  x20 = Lib_IntVector_Intrinsics_vec512_interleave_low64(v0_2, v2_2);
+  Lib_IntVector_Intrinsics_vec512
+  x21 = Lib_IntVector_Intrinsics_vec512_interleave_high64(v0_2, v2_2);
+  Lib_IntVector_Intrinsics_vec512
+  x22 = Lib_IntVector_Intrinsics_vec512_interleave_low64(v1_2, v3_2);
+  Lib_IntVector_Intrinsics_vec512
+  x23 = Lib_IntVector_Intrinsics_vec512_interleave_high64(v1_2, v3_2);
+  Lib_IntVector_Intrinsics_vec512
+  v0_3 = Lib_IntVector_Intrinsics_vec512_interleave_low32(k[12U], k[13U]);
+  Lib_IntVector_Intrinsics_vec512
+  v1_3 = Lib_IntVector_Intrinsics_vec512_interleave_high32(k[12U], k[13U]);
+  Lib_IntVector_Intrinsics_vec512
+  v2_3 = Lib_IntVector_Intrinsics_vec512_interleave_low32(k[14U], k[15U]);
+  Lib_IntVector_Intrinsics_vec512
+  v3_3 = Lib_IntVector_Intrinsics_vec512_interleave_high32(k[14U], k[15U]);
+  Lib_IntVector_Intrinsics_vec512
+  x30 = Lib_IntVector_Intrinsics_vec512_interleave_low64(v0_3, v2_3);
+  Lib_IntVector_Intrinsics_vec512
+  x31 = Lib_IntVector_Intrinsics_vec512_interleave_high64(v0_3, v2_3);
+  Lib_IntVector_Intrinsics_vec512
+  x32 = Lib_IntVector_Intrinsics_vec512_interleave_low64(v1_3, v3_3);
+  Lib_IntVector_Intrinsics_vec512
+  x33 = Lib_IntVector_Intrinsics_vec512_interleave_high64(v1_3, v3_3);
+  Lib_IntVector_Intrinsics_vec512
+  t0_0 = Lib_IntVector_Intrinsics_vec512_interleave_low128(x00, x10);
+  Lib_IntVector_Intrinsics_vec512
+  t1_0 = Lib_IntVector_Intrinsics_vec512_interleave_high128(x00, x10);
+  Lib_IntVector_Intrinsics_vec512
+  t2_0 = Lib_IntVector_Intrinsics_vec512_interleave_low128(x20, x30);
+  Lib_IntVector_Intrinsics_vec512
+  t3_0 = Lib_IntVector_Intrinsics_vec512_interleave_high128(x20, x30);
+  Lib_IntVector_Intrinsics_vec512
+  t0_1 = Lib_IntVector_Intrinsics_vec512_interleave_low128(x01, x11);
+  Lib_IntVector_Intrinsics_vec512
+  t1_1 = Lib_IntVector_Intrinsics_vec512_interleave_high128(x01, x11);
+  Lib_IntVector_Intrinsics_vec512
+  t2_1 = Lib_IntVector_Intrinsics_vec512_interleave_low128(x21, x31);
+  Lib_IntVector_Intrinsics_vec512
+  t3_1 = Lib_IntVector_Intrinsics_vec512_interleave_high128(x21, x31);
+  Lib_IntVector_Intrinsics_vec512
+  t0_2 = Lib_IntVector_Intrinsics_vec512_interleave_low128(x02, x12);
+  Lib_IntVector_Intrinsics_vec512
+  t1_2 = Lib_IntVector_Intrinsics_vec512_interleave_high128(x02, x12);
+  Lib_IntVector_Intrinsics_vec512
+  t2_2 = Lib_IntVector_Intrinsics_vec512_interleave_low128(x22, x32);
+  Lib_IntVector_Intrinsics_vec512
+  t3_2 = Lib_IntVector_Intrinsics_vec512_interleave_high128(x22, x32);
+  Lib_IntVector_Intrinsics_vec512
+  t0_3 = Lib_IntVector_Intrinsics_vec512_interleave_low128(x03, x13);
+  Lib_IntVector_Intrinsics_vec512
+  t1_3 = Lib_IntVector_Intrinsics_vec512_interleave_high128(x03, x13);
+  Lib_IntVector_Intrinsics_vec512
+  t2_3 = Lib_IntVector_Intrinsics_vec512_interleave_low128(x23, x33);
+  Lib_IntVector_Intrinsics_vec512
+  t3_3 = Lib_IntVector_Intrinsics_vec512_interleave_high128(x23, x33);
+  k[0U] = Lib_IntVector_Intrinsics_vec512_interleave_low256(t0_0, t2_0);
+  k[4U] = Lib_IntVector_Intrinsics_vec512_interleave_low256(t1_0, t3_0);
+  k[8U] = Lib_IntVector_Intrinsics_vec512_interleave_high256(t0_0, t2_0);
+  k[12U] = Lib_IntVector_Intrinsics_vec512_interleave_high256(t1_0, t3_0);
+  k[1U] = Lib_IntVector_Intrinsics_vec512_interleave_low256(t0_1, t2_1);
+  k[5U] = Lib_IntVector_Intrinsics_vec512_interleave_low256(t1_1, t3_1);
+  k[9U] = Lib_IntVector_Intrinsics_vec512_interleave_high256(t0_1, t2_1);
+  k[13U] = Lib_IntVector_Intrinsics_vec512_interleave_high256(t1_1, t3_1);
+  k[2U] = Lib_IntVector_Intrinsics_vec512_interleave_low256(t0_2, t2_2);
+  k[6U] = Lib_IntVector_Intrinsics_vec512_interleave_low256(t1_2, t3_2);
+  k[10U] = Lib_IntVector_Intrinsics_vec512_interleave_high256(t0_2, t2_2);
+  k[14U] = Lib_IntVector_Intrinsics_vec512_interleave_high256(t1_2, t3_2);
+  k[3U] = Lib_IntVector_Intrinsics_vec512_interleave_low256(t0_3, t2_3);
+  k[7U] = Lib_IntVector_Intrinsics_vec512_interleave_low256(t1_3, t3_3);
+  k[11U] = Lib_IntVector_Intrinsics_vec512_interleave_high256(t0_3, t2_3);
+  k[15U] = Lib_IntVector_Intrinsics_vec512_interleave_high256(t1_3, t3_3);
+}
+
+void
+Hacl_Chacha20_Vec512_chacha20_encrypt_512(
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *text,
+  uint8_t *key,
+  uint8_t *n,
+  uint32_t ctr
+)
+{
+  Lib_IntVector_Intrinsics_vec512 ctx[16U];
+  for (uint32_t _i = 0U; _i < (uint32_t)16U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  chacha20_init_512(ctx, key, n, ctr);
+  uint32_t rem = len % (uint32_t)1024U;
+  uint32_t nb = len / (uint32_t)1024U;
+  uint32_t rem1 = len % (uint32_t)1024U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    uint8_t *uu____0 = out + i * (uint32_t)1024U;
+    uint8_t *uu____1 = text + i * (uint32_t)1024U;
+    Lib_IntVector_Intrinsics_vec512 k[16U];
+    for (uint32_t _i = 0U; _i < (uint32_t)16U; ++_i)
+      k[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+    chacha20_core_512(k, ctx, i);
+    transpose16_512(k);
+    for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)16U; i0++)
+    {
+      Lib_IntVector_Intrinsics_vec512
+      x = Lib_IntVector_Intrinsics_vec512_load_le(uu____1 + i0 * (uint32_t)64U);
+      Lib_IntVector_Intrinsics_vec512 y = Lib_IntVector_Intrinsics_vec512_xor(x, k[i0]);
+      Lib_IntVector_Intrinsics_vec512_store_le(uu____0 + i0 * (uint32_t)64U, y);
+    }
+  }
+  if (rem1 > (uint32_t)0U)
+  {
+    uint8_t *uu____2 = out + nb * (uint32_t)1024U;
+    uint8_t *uu____3 = text + nb * (uint32_t)1024U;
+    uint8_t plain[1024U] = { 0U };
+    memcpy(plain, uu____3, rem * sizeof (uint8_t));
+    Lib_IntVector_Intrinsics_vec512 k[16U];
+    for (uint32_t _i = 0U; _i < (uint32_t)16U; ++_i)
+      k[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+    chacha20_core_512(k, ctx, nb);
+    transpose16_512(k);
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+    {
+      Lib_IntVector_Intrinsics_vec512
+      x = Lib_IntVector_Intrinsics_vec512_load_le(plain + i * (uint32_t)64U);
+      Lib_IntVector_Intrinsics_vec512 y = Lib_IntVector_Intrinsics_vec512_xor(x, k[i]);
+      Lib_IntVector_Intrinsics_vec512_store_le(plain + i * (uint32_t)64U, y);
+    }
+    memcpy(uu____2, plain, rem * sizeof (uint8_t));
+  }
+}
+
+void
+Hacl_Chacha20_Vec512_chacha20_decrypt_512(
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *cipher,
+  uint8_t *key,
+  uint8_t *n,
+  uint32_t ctr
+)
+{
+  Lib_IntVector_Intrinsics_vec512 ctx[16U];
+  for (uint32_t _i = 0U; _i < (uint32_t)16U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  chacha20_init_512(ctx, key, n, ctr);
+  uint32_t rem = len % (uint32_t)1024U;
+  uint32_t nb = len / (uint32_t)1024U;
+  uint32_t rem1 = len % (uint32_t)1024U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    uint8_t *uu____0 = out + i * (uint32_t)1024U;
+    uint8_t *uu____1 = cipher + i * (uint32_t)1024U;
+    Lib_IntVector_Intrinsics_vec512 k[16U];
+    for (uint32_t _i = 0U; _i < (uint32_t)16U; ++_i)
+      k[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+    chacha20_core_512(k, ctx, i);
+    transpose16_512(k);
+    for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)16U; i0++)
+    {
+      Lib_IntVector_Intrinsics_vec512
+      x = Lib_IntVector_Intrinsics_vec512_load_le(uu____1 + i0 * (uint32_t)64U);
+      Lib_IntVector_Intrinsics_vec512 y = Lib_IntVector_Intrinsics_vec512_xor(x, k[i0]);
+      Lib_IntVector_Intrinsics_vec512_store_le(uu____0 + i0 * (uint32_t)64U, y);
+    }
+  }
+  if (rem1 > (uint32_t)0U)
+  {
+    uint8_t *uu____2 = out + nb * (uint32_t)1024U;
+    uint8_t *uu____3 = cipher + nb * (uint32_t)1024U;
+    uint8_t plain[1024U] = { 0U };
+    memcpy(plain, uu____3, rem * sizeof (uint8_t));
+    Lib_IntVector_Intrinsics_vec512 k[16U];
+    for (uint32_t _i = 0U; _i < (uint32_t)16U; ++_i)
+      k[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+    chacha20_core_512(k, ctx, nb);
+    transpose16_512(k);
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+    {
+      Lib_IntVector_Intrinsics_vec512
+      x = Lib_IntVector_Intrinsics_vec512_load_le(plain + i * (uint32_t)64U);
+      Lib_IntVector_Intrinsics_vec512 y = Lib_IntVector_Intrinsics_vec512_xor(x, k[i]);
+      Lib_IntVector_Intrinsics_vec512_store_le(plain + i * (uint32_t)64U, y);
+    }
+    memcpy(uu____2, plain, rem * sizeof (uint8_t));
+  }
+}
+
@@ -0,0 +1,1263 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include "Hacl_Curve25519_256.h"
+
+static inline void
+fadd(
+  Lib_IntVector_Intrinsics_vec256 *out,
+  Lib_IntVector_Intrinsics_vec256 *f1,
+  Lib_IntVector_Intrinsics_vec256 *f2
+)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)10U; i++)
+  {
+    out[i] = Lib_IntVector_Intrinsics_vec256_add64(f1[i], f2[i]);
+  }
+}
+
+static inline void
+fsub(
+  Lib_IntVector_Intrinsics_vec256 *out,
+  Lib_IntVector_Intrinsics_vec256 *f1,
+  Lib_IntVector_Intrinsics_vec256 *f2
+)
+{
+  Lib_IntVector_Intrinsics_vec256
+  p0_2 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x7ffffdaU);
+  Lib_IntVector_Intrinsics_vec256
+  p25_2 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3fffffeU);
+  Lib_IntVector_Intrinsics_vec256
+  p26_2 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x7fffffeU);
+  out[0U] =
+    Lib_IntVector_Intrinsics_vec256_sub64(Lib_IntVector_Intrinsics_vec256_add64(f1[0U], p0_2),
+      f2[0U]);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)10U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 p_2;
+    if (i % (uint32_t)2U == (uint32_t)0U)
+    {
+      p_2 = p26_2;
+    }
+    else
+    {
+      p_2 = p25_2;
+    }
+    out[i] =
+      Lib_IntVector_Intrinsics_vec256_sub64(Lib_IntVector_Intrinsics_vec256_add64(f1[i], p_2),
+        f2[i]);
+  }
+}
+
+static inline void
+carry_wide(
+  Lib_IntVector_Intrinsics_vec256 *out,
+  Lib_IntVector_Intrinsics_vec256 h0,
+  Lib_IntVector_Intrinsics_vec256 h1,
+  Lib_IntVector_Intrinsics_vec256 h2,
+  Lib_IntVector_Intrinsics_vec256 h3,
+  Lib_IntVector_Intrinsics_vec256 h4,
+  Lib_IntVector_Intrinsics_vec256 h5,
+  Lib_IntVector_Intrinsics_vec256 h6,
+  Lib_IntVector_Intrinsics_vec256 h7,
+  Lib_IntVector_Intrinsics_vec256 h8,
+  Lib_IntVector_Intrinsics_vec256 h9
+)
+{
+  Lib_IntVector_Intrinsics_vec256
+  mask26 =
+    Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU);
+  Lib_IntVector_Intrinsics_vec256
+  mask25 =
+    Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x1ffffffU);
+  Lib_IntVector_Intrinsics_vec256
+  c0 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h0, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 h01 = Lib_IntVector_Intrinsics_vec256_and(h0, mask26);
+  Lib_IntVector_Intrinsics_vec256 h11 = Lib_IntVector_Intrinsics_vec256_add64(h1, c0);
+  Lib_IntVector_Intrinsics_vec256
+  c1 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h4, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 h41 = Lib_IntVector_Intrinsics_vec256_and(h4, mask26);
+  Lib_IntVector_Intrinsics_vec256 h51 = Lib_IntVector_Intrinsics_vec256_add64(h5, c1);
+  Lib_IntVector_Intrinsics_vec256
+  c2 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h11, (uint32_t)25U);
+  Lib_IntVector_Intrinsics_vec256 h12 = Lib_IntVector_Intrinsics_vec256_and(h11, mask25);
+  Lib_IntVector_Intrinsics_vec256 h21 = Lib_IntVector_Intrinsics_vec256_add64(h2, c2);
+  Lib_IntVector_Intrinsics_vec256
+  c3 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h51, (uint32_t)25U);
+  Lib_IntVector_Intrinsics_vec256 h52 = Lib_IntVector_Intrinsics_vec256_and(h51, mask25);
+  Lib_IntVector_Intrinsics_vec256 h61 = Lib_IntVector_Intrinsics_vec256_add64(h6, c3);
+  Lib_IntVector_Intrinsics_vec256
+  c4 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h21, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 h22 = Lib_IntVector_Intrinsics_vec256_and(h21, mask26);
+  Lib_IntVector_Intrinsics_vec256 h31 = Lib_IntVector_Intrinsics_vec256_add64(h3, c4);
+  Lib_IntVector_Intrinsics_vec256
+  c5 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h61, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 h62 = Lib_IntVector_Intrinsics_vec256_and(h61, mask26);
+  Lib_IntVector_Intrinsics_vec256 h71 = Lib_IntVector_Intrinsics_vec256_add64(h7, c5);
+  Lib_IntVector_Intrinsics_vec256
+  c6 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h31, (uint32_t)25U);
+  Lib_IntVector_Intrinsics_vec256 h32 = Lib_IntVector_Intrinsics_vec256_and(h31, mask25);
+  Lib_IntVector_Intrinsics_vec256 h42 = Lib_IntVector_Intrinsics_vec256_add64(h41, c6);
+  Lib_IntVector_Intrinsics_vec256
+  c7 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h71, (uint32_t)25U);
+  Lib_IntVector_Intrinsics_vec256 h72 = Lib_IntVector_Intrinsics_vec256_and(h71, mask25);
+  Lib_IntVector_Intrinsics_vec256 h81 = Lib_IntVector_Intrinsics_vec256_add64(h8, c7);
+  Lib_IntVector_Intrinsics_vec256
+  c8 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h42, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 h43 = Lib_IntVector_Intrinsics_vec256_and(h42, mask26);
+  Lib_IntVector_Intrinsics_vec256 h53 = Lib_IntVector_Intrinsics_vec256_add64(h52, c8);
+  Lib_IntVector_Intrinsics_vec256
+  c9 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h81, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 h82 = Lib_IntVector_Intrinsics_vec256_and(h81, mask26);
+  Lib_IntVector_Intrinsics_vec256 h91 = Lib_IntVector_Intrinsics_vec256_add64(h9, c9);
+  Lib_IntVector_Intrinsics_vec256
+  c10 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h91, (uint32_t)25U);
+  Lib_IntVector_Intrinsics_vec256 h92 = Lib_IntVector_Intrinsics_vec256_and(h91, mask25);
+  Lib_IntVector_Intrinsics_vec256
+  c10_2 =
+    Lib_IntVector_Intrinsics_vec256_shift_left64(c10, (uint32_t)1U);
+  Lib_IntVector_Intrinsics_vec256
+  c10_16 =
+    Lib_IntVector_Intrinsics_vec256_shift_left64(c10, (uint32_t)4U);
+  Lib_IntVector_Intrinsics_vec256 c10_3 = Lib_IntVector_Intrinsics_vec256_add64(c10, c10_2);
+  Lib_IntVector_Intrinsics_vec256 c10_19 = Lib_IntVector_Intrinsics_vec256_add64(c10_3, c10_16);
+  Lib_IntVector_Intrinsics_vec256 h02 = Lib_IntVector_Intrinsics_vec256_add64(h01, c10_19);
+  Lib_IntVector_Intrinsics_vec256
+  c11 =
+    Lib_IntVector_Intrinsics_vec256_shift_right64(h02, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 h03 = Lib_IntVector_Intrinsics_vec256_and(h02, mask26);
+  Lib_IntVector_Intrinsics_vec256 h13 = Lib_IntVector_Intrinsics_vec256_add64(h12, c11);
+  out[0U] = h03;
+  out[1U] = h13;
+  out[2U] = h22;
+  out[3U] = h32;
+  out[4U] = h43;
+  out[5U] = h53;
+  out[6U] = h62;
+  out[7U] = h72;
+  out[8U] = h82;
+  out[9U] = h92;
+}
+
+static inline void
+fmul(
+  Lib_IntVector_Intrinsics_vec256 *out,
+  Lib_IntVector_Intrinsics_vec256 *f,
+  Lib_IntVector_Intrinsics_vec256 *g
+)
+{
+  Lib_IntVector_Intrinsics_vec256 f0 = f[0U];
+  Lib_IntVector_Intrinsics_vec256 f1 = f[1U];
+  Lib_IntVector_Intrinsics_vec256 f2 = f[2U];
+  Lib_IntVector_Intrinsics_vec256 f3 = f[3U];
+  Lib_IntVector_Intrinsics_vec256 f4 = f[4U];
+  Lib_IntVector_Intrinsics_vec256 f5 = f[5U];
+  Lib_IntVector_Intrinsics_vec256 f6 = f[6U];
+  Lib_IntVector_Intrinsics_vec256 f7 = f[7U];
+  Lib_IntVector_Intrinsics_vec256 f8 = f[8U];
+  Lib_IntVector_Intrinsics_vec256 f9 = f[9U];
+  Lib_IntVector_Intrinsics_vec256 g0 = g[0U];
+  Lib_IntVector_Intrinsics_vec256 g1 = g[1U];
+  Lib_IntVector_Intrinsics_vec256 g2 = g[2U];
+  Lib_IntVector_Intrinsics_vec256 g3 = g[3U];
+  Lib_IntVector_Intrinsics_vec256 g4 = g[4U];
+  Lib_IntVector_Intrinsics_vec256 g5 = g[5U];
+  Lib_IntVector_Intrinsics_vec256 g6 = g[6U];
+  Lib_IntVector_Intrinsics_vec256 g7 = g[7U];
+  Lib_IntVector_Intrinsics_vec256 g8 = g[8U];
+  Lib_IntVector_Intrinsics_vec256 g9 = g[9U];
+  Lib_IntVector_Intrinsics_vec256 f1_2 = Lib_IntVector_Intrinsics_vec256_add64(f1, f1);
+  Lib_IntVector_Intrinsics_vec256 f3_2 = Lib_IntVector_Intrinsics_vec256_add64(f3, f3);
+  Lib_IntVector_Intrinsics_vec256 f5_2 = Lib_IntVector_Intrinsics_vec256_add64(f5, f5);
+  Lib_IntVector_Intrinsics_vec256 f7_2 = Lib_IntVector_Intrinsics_vec256_add64(f7, f7);
+  Lib_IntVector_Intrinsics_vec256 f9_2 = Lib_IntVector_Intrinsics_vec256_add64(f9, f9);
+  Lib_IntVector_Intrinsics_vec256 g1_19 = Lib_IntVector_Intrinsics_vec256_smul64(g1, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 g2_19 = Lib_IntVector_Intrinsics_vec256_smul64(g2, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 g3_19 = Lib_IntVector_Intrinsics_vec256_smul64(g3, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 g4_19 = Lib_IntVector_Intrinsics_vec256_smul64(g4, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 g5_19 = Lib_IntVector_Intrinsics_vec256_smul64(g5, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 g6_19 = Lib_IntVector_Intrinsics_vec256_smul64(g6, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 g7_19 = Lib_IntVector_Intrinsics_vec256_smul64(g7, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 g8_19 = Lib_IntVector_Intrinsics_vec256_smul64(g8, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 g9_19 = Lib_IntVector_Intrinsics_vec256_smul64(g9, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 a0_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g0);
+  Lib_IntVector_Intrinsics_vec256 a1_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g1);
+  Lib_IntVector_Intrinsics_vec256 a2_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g2);
+  Lib_IntVector_Intrinsics_vec256 a3_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g3);
+  Lib_IntVector_Intrinsics_vec256 a4_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g4);
+  Lib_IntVector_Intrinsics_vec256 a5_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g5);
+  Lib_IntVector_Intrinsics_vec256 a6_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g6);
+  Lib_IntVector_Intrinsics_vec256 a7_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g7);
+  Lib_IntVector_Intrinsics_vec256 a8_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g8);
+  Lib_IntVector_Intrinsics_vec256 a9_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, g9);
+  Lib_IntVector_Intrinsics_vec256
+  a0_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, g9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1, g0));
+  Lib_IntVector_Intrinsics_vec256
+  a2_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, g1));
+  Lib_IntVector_Intrinsics_vec256
+  a3_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1, g2));
+  Lib_IntVector_Intrinsics_vec256
+  a4_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, g3));
+  Lib_IntVector_Intrinsics_vec256
+  a5_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1, g4));
+  Lib_IntVector_Intrinsics_vec256
+  a6_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, g5));
+  Lib_IntVector_Intrinsics_vec256
+  a7_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1, g6));
+  Lib_IntVector_Intrinsics_vec256
+  a8_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, g7));
+  Lib_IntVector_Intrinsics_vec256
+  a9_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1, g8));
+  Lib_IntVector_Intrinsics_vec256
+  a0_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g0));
+  Lib_IntVector_Intrinsics_vec256
+  a3_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g1));
+  Lib_IntVector_Intrinsics_vec256
+  a4_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g2));
+  Lib_IntVector_Intrinsics_vec256
+  a5_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g3));
+  Lib_IntVector_Intrinsics_vec256
+  a6_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g4));
+  Lib_IntVector_Intrinsics_vec256
+  a7_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g5));
+  Lib_IntVector_Intrinsics_vec256
+  a8_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g6));
+  Lib_IntVector_Intrinsics_vec256
+  a9_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, g7));
+  Lib_IntVector_Intrinsics_vec256
+  a0_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_2, g7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3, g8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_2, g9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3, g0));
+  Lib_IntVector_Intrinsics_vec256
+  a4_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_2, g1));
+  Lib_IntVector_Intrinsics_vec256
+  a5_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3, g2));
+  Lib_IntVector_Intrinsics_vec256
+  a6_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_2, g3));
+  Lib_IntVector_Intrinsics_vec256
+  a7_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3, g4));
+  Lib_IntVector_Intrinsics_vec256
+  a8_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_2, g5));
+  Lib_IntVector_Intrinsics_vec256
+  a9_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3, g6));
+  Lib_IntVector_Intrinsics_vec256
+  a0_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g6_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g0));
+  Lib_IntVector_Intrinsics_vec256
+  a5_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g1));
+  Lib_IntVector_Intrinsics_vec256
+  a6_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g2));
+  Lib_IntVector_Intrinsics_vec256
+  a7_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g3));
+  Lib_IntVector_Intrinsics_vec256
+  a8_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g4));
+  Lib_IntVector_Intrinsics_vec256
+  a9_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, g5));
+  Lib_IntVector_Intrinsics_vec256
+  a0_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_2, g5_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5, g6_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_2, g7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5, g8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_2, g9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a5_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5, g0));
+  Lib_IntVector_Intrinsics_vec256
+  a6_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_2, g1));
+  Lib_IntVector_Intrinsics_vec256
+  a7_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5, g2));
+  Lib_IntVector_Intrinsics_vec256
+  a8_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_2, g3));
+  Lib_IntVector_Intrinsics_vec256
+  a9_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5, g4));
+  Lib_IntVector_Intrinsics_vec256
+  a0_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g4_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g5_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g6_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a5_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a6_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g0));
+  Lib_IntVector_Intrinsics_vec256
+  a7_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g1));
+  Lib_IntVector_Intrinsics_vec256
+  a8_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g2));
+  Lib_IntVector_Intrinsics_vec256
+  a9_6 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_5,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, g3));
+  Lib_IntVector_Intrinsics_vec256
+  a0_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7_2, g3_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7, g4_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7_2, g5_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7, g6_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7_2, g7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a5_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7, g8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a6_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7_2, g9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a7_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7, g0));
+  Lib_IntVector_Intrinsics_vec256
+  a8_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7_2, g1));
+  Lib_IntVector_Intrinsics_vec256
+  a9_7 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_6,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7, g2));
+  Lib_IntVector_Intrinsics_vec256
+  a0_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g2_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g3_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g4_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g5_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g6_19));
+  Lib_IntVector_Intrinsics_vec256
+  a5_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a6_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a7_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a8_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g0));
+  Lib_IntVector_Intrinsics_vec256
+  a9_8 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_7,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, g1));
+  Lib_IntVector_Intrinsics_vec256
+  a0_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9_2, g1_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9, g2_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9_2, g3_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9, g4_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9_2, g5_19));
+  Lib_IntVector_Intrinsics_vec256
+  a5_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9, g6_19));
+  Lib_IntVector_Intrinsics_vec256
+  a6_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9_2, g7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a7_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9, g8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a8_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9_2, g9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a9_9 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_8,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9, g0));
+  carry_wide(out,
+    a0_9,
+    a1_9,
+    a2_9,
+    a3_9,
+    a4_9,
+    a5_9,
+    a6_9,
+    a7_9,
+    a8_9,
+    a9_9);
+}
+
+static inline void
+fmul1(Lib_IntVector_Intrinsics_vec256 *out, Lib_IntVector_Intrinsics_vec256 *f1, uint64_t f2)
+{
+  carry_wide(out,
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[0U], f2),
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[1U], f2),
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[2U], f2),
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[3U], f2),
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[4U], f2),
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[5U], f2),
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[6U], f2),
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[7U], f2),
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[8U], f2),
+    Lib_IntVector_Intrinsics_vec256_smul64(f1[9U], f2));
+}
+
+static inline void fsqr(Lib_IntVector_Intrinsics_vec256 *out, Lib_IntVector_Intrinsics_vec256 *f)
+{
+  Lib_IntVector_Intrinsics_vec256 f0 = f[0U];
+  Lib_IntVector_Intrinsics_vec256 f1 = f[1U];
+  Lib_IntVector_Intrinsics_vec256 f2 = f[2U];
+  Lib_IntVector_Intrinsics_vec256 f3 = f[3U];
+  Lib_IntVector_Intrinsics_vec256 f4 = f[4U];
+  Lib_IntVector_Intrinsics_vec256 f5 = f[5U];
+  Lib_IntVector_Intrinsics_vec256 f6 = f[6U];
+  Lib_IntVector_Intrinsics_vec256 f7 = f[7U];
+  Lib_IntVector_Intrinsics_vec256 f8 = f[8U];
+  Lib_IntVector_Intrinsics_vec256 f9 = f[9U];
+  Lib_IntVector_Intrinsics_vec256 f0_2 = Lib_IntVector_Intrinsics_vec256_add64(f0, f0);
+  Lib_IntVector_Intrinsics_vec256 f1_2 = Lib_IntVector_Intrinsics_vec256_add64(f1, f1);
+  Lib_IntVector_Intrinsics_vec256 f2_2 = Lib_IntVector_Intrinsics_vec256_add64(f2, f2);
+  Lib_IntVector_Intrinsics_vec256 f3_2 = Lib_IntVector_Intrinsics_vec256_add64(f3, f3);
+  Lib_IntVector_Intrinsics_vec256 f4_2 = Lib_IntVector_Intrinsics_vec256_add64(f4, f4);
+  Lib_IntVector_Intrinsics_vec256 f5_2 = Lib_IntVector_Intrinsics_vec256_add64(f5, f5);
+  Lib_IntVector_Intrinsics_vec256 f6_2 = Lib_IntVector_Intrinsics_vec256_add64(f6, f6);
+  Lib_IntVector_Intrinsics_vec256 f7_2 = Lib_IntVector_Intrinsics_vec256_add64(f7, f7);
+  Lib_IntVector_Intrinsics_vec256 f8_2 = Lib_IntVector_Intrinsics_vec256_add64(f8, f8);
+  Lib_IntVector_Intrinsics_vec256 f9_2 = Lib_IntVector_Intrinsics_vec256_add64(f9, f9);
+  Lib_IntVector_Intrinsics_vec256 f1_4 = Lib_IntVector_Intrinsics_vec256_add64(f1_2, f1_2);
+  Lib_IntVector_Intrinsics_vec256 f3_4 = Lib_IntVector_Intrinsics_vec256_add64(f3_2, f3_2);
+  Lib_IntVector_Intrinsics_vec256 f5_4 = Lib_IntVector_Intrinsics_vec256_add64(f5_2, f5_2);
+  Lib_IntVector_Intrinsics_vec256 f7_4 = Lib_IntVector_Intrinsics_vec256_add64(f7_2, f7_2);
+  Lib_IntVector_Intrinsics_vec256 f9_4 = Lib_IntVector_Intrinsics_vec256_add64(f9_2, f9_2);
+  Lib_IntVector_Intrinsics_vec256 f1_19 = Lib_IntVector_Intrinsics_vec256_smul64(f1, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 f2_19 = Lib_IntVector_Intrinsics_vec256_smul64(f2, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 f3_19 = Lib_IntVector_Intrinsics_vec256_smul64(f3, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 f4_19 = Lib_IntVector_Intrinsics_vec256_smul64(f4, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 f5_19 = Lib_IntVector_Intrinsics_vec256_smul64(f5, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 f6_19 = Lib_IntVector_Intrinsics_vec256_smul64(f6, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 f7_19 = Lib_IntVector_Intrinsics_vec256_smul64(f7, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 f8_19 = Lib_IntVector_Intrinsics_vec256_smul64(f8, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 f9_19 = Lib_IntVector_Intrinsics_vec256_smul64(f9, (uint64_t)19U);
+  Lib_IntVector_Intrinsics_vec256 a0_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0, f0);
+  Lib_IntVector_Intrinsics_vec256 a1_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0_2, f1);
+  Lib_IntVector_Intrinsics_vec256 a2_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0_2, f2);
+  Lib_IntVector_Intrinsics_vec256 a3_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0_2, f3);
+  Lib_IntVector_Intrinsics_vec256 a4_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0_2, f4);
+  Lib_IntVector_Intrinsics_vec256 a5_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0_2, f5);
+  Lib_IntVector_Intrinsics_vec256 a6_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0_2, f6);
+  Lib_IntVector_Intrinsics_vec256 a7_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0_2, f7);
+  Lib_IntVector_Intrinsics_vec256 a8_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0_2, f8);
+  Lib_IntVector_Intrinsics_vec256 a9_0 = Lib_IntVector_Intrinsics_vec256_mul64(f0_2, f9);
+  Lib_IntVector_Intrinsics_vec256
+  a0_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_4, f9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2_2, f9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, f1));
+  Lib_IntVector_Intrinsics_vec256
+  a3_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, f2));
+  Lib_IntVector_Intrinsics_vec256
+  a4_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_4, f3));
+  Lib_IntVector_Intrinsics_vec256
+  a5_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, f4));
+  Lib_IntVector_Intrinsics_vec256
+  a6_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_4, f5));
+  Lib_IntVector_Intrinsics_vec256
+  a7_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, f6));
+  Lib_IntVector_Intrinsics_vec256
+  a8_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_4, f7));
+  Lib_IntVector_Intrinsics_vec256
+  a9_1 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_0,
+      Lib_IntVector_Intrinsics_vec256_mul64(f1_2, f8));
+  Lib_IntVector_Intrinsics_vec256
+  a0_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2_2, f8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_2, f8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_4, f9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4_2, f9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2, f2));
+  Lib_IntVector_Intrinsics_vec256
+  a5_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2_2, f3));
+  Lib_IntVector_Intrinsics_vec256
+  a6_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2_2, f4));
+  Lib_IntVector_Intrinsics_vec256
+  a7_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2_2, f5));
+  Lib_IntVector_Intrinsics_vec256
+  a8_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2_2, f6));
+  Lib_IntVector_Intrinsics_vec256
+  a9_2 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_1,
+      Lib_IntVector_Intrinsics_vec256_mul64(f2_2, f7));
+  Lib_IntVector_Intrinsics_vec256
+  a0_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_4, f7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4_2, f7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4_2, f8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_2, f8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_4, f9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a5_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6_2, f9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a6_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_2, f3));
+  Lib_IntVector_Intrinsics_vec256
+  a7_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_2, f4));
+  Lib_IntVector_Intrinsics_vec256
+  a8_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_4, f5));
+  Lib_IntVector_Intrinsics_vec256
+  a9_3 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_2,
+      Lib_IntVector_Intrinsics_vec256_mul64(f3_2, f6));
+  Lib_IntVector_Intrinsics_vec256
+  a0_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4_2, f6_19));
+  Lib_IntVector_Intrinsics_vec256
+  a1_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a1_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_2, f6_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_4, f7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a3_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a3_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6_2, f7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6_2, f8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a5_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a5_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7_2, f8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a6_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7_4, f9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a7_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a7_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8_2, f9_19));
+  Lib_IntVector_Intrinsics_vec256
+  a8_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4, f4));
+  Lib_IntVector_Intrinsics_vec256
+  a9_4 =
+    Lib_IntVector_Intrinsics_vec256_add64(a9_3,
+      Lib_IntVector_Intrinsics_vec256_mul64(f4_2, f5));
+  Lib_IntVector_Intrinsics_vec256
+  a0_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a0_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f5_2, f5_19));
+  Lib_IntVector_Intrinsics_vec256
+  a2_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a2_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f6, f6_19));
+  Lib_IntVector_Intrinsics_vec256
+  a4_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a4_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f7_2, f7_19));
+  Lib_IntVector_Intrinsics_vec256
+  a6_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a6_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f8, f8_19));
+  Lib_IntVector_Intrinsics_vec256
+  a8_5 =
+    Lib_IntVector_Intrinsics_vec256_add64(a8_4,
+      Lib_IntVector_Intrinsics_vec256_mul64(f9_2, f9_19));
+  carry_wide(out,
+    a0_5,
+    a1_4,
+    a2_5,
+    a3_4,
+    a4_5,
+    a5_4,
+    a6_5,
+    a7_4,
+    a8_5,
+    a9_4);
+}
+
+
+static inline void
+fmul2(
+  Lib_IntVector_Intrinsics_vec256 *out,
+  Lib_IntVector_Intrinsics_vec256 *f1,
+  Lib_IntVector_Intrinsics_vec256 *f2
+)
+{
+  fmul(out, f1, f2);
+  fmul(out + (uint32_t)10U, f1 + (uint32_t)10U, f2 + (uint32_t)10U);
+}
+
+static inline void fsqr2(Lib_IntVector_Intrinsics_vec256 *out, Lib_IntVector_Intrinsics_vec256 *f)
+{
+  fsqr(out, f);
+  fsqr(out + (uint32_t)10U, f + (uint32_t)10U);
+}
+
+static void store_felem(uint64_t *u64s, uint64_t *f)
+{
+  uint64_t f0 = f[0U];
+  uint64_t f1 = f[1U];
+  uint64_t f2 = f[2U];
+  uint64_t f3 = f[3U];
+  uint64_t f4 = f[4U];
+  uint64_t f5 = f[5U];
+  uint64_t f6 = f[6U];
+  uint64_t f7 = f[7U];
+  uint64_t f8 = f[8U];
+  uint64_t f9 = f[9U];
+  uint64_t l_ = f0;
+  uint64_t tmp0 = l_ & (uint64_t)0x3ffffffU;
+  uint64_t c0 = l_ >> (uint32_t)26U;
+  uint64_t l_0 = f1 + c0;
+  uint64_t tmp1 = l_0 & (uint64_t)0x1ffffffU;
+  uint64_t c1 = l_0 >> (uint32_t)25U;
+  uint64_t l_1 = f2 + c1;
+  uint64_t tmp2 = l_1 & (uint64_t)0x3ffffffU;
+  uint64_t c2 = l_1 >> (uint32_t)26U;
+  uint64_t l_2 = f3 + c2;
+  uint64_t tmp3 = l_2 & (uint64_t)0x1ffffffU;
+  uint64_t c3 = l_2 >> (uint32_t)25U;
+  uint64_t l_3 = f4 + c3;
+  uint64_t tmp4 = l_3 & (uint64_t)0x3ffffffU;
+  uint64_t c4 = l_3 >> (uint32_t)26U;
+  uint64_t l_4 = f5 + c4;
+  uint64_t tmp5 = l_4 & (uint64_t)0x1ffffffU;
+  uint64_t c5 = l_4 >> (uint32_t)25U;
+  uint64_t l_5 = f6 + c5;
+  uint64_t tmp6 = l_5 & (uint64_t)0x3ffffffU;
+  uint64_t c6 = l_5 >> (uint32_t)26U;
+  uint64_t l_6 = f7 + c6;
+  uint64_t tmp7 = l_6 & (uint64_t)0x1ffffffU;
+  uint64_t c7 = l_6 >> (uint32_t)25U;
+  uint64_t l_7 = f8 + c7;
+  uint64_t tmp8 = l_7 & (uint64_t)0x3ffffffU;
+  uint64_t c8 = l_7 >> (uint32_t)26U;
+  uint64_t l_8 = f9 + c8;
+  uint64_t tmp9 = l_8 & (uint64_t)0x1ffffffU;
+  uint64_t c9 = l_8 >> (uint32_t)25U;
+  uint64_t l_9 = tmp0 + c9 * (uint64_t)19U;
+  uint64_t tmp0_ = l_9 & (uint64_t)0x3ffffffU;
+  uint64_t c10 = l_9 >> (uint32_t)26U;
+  uint64_t f01 = tmp0_;
+  uint64_t f11 = tmp1 + c10;
+  uint64_t q0 = (f01 + (uint64_t)19U) >> (uint32_t)26U;
+  uint64_t q1 = (f11 + q0) >> (uint32_t)25U;
+  uint64_t q2 = (tmp2 + q1) >> (uint32_t)26U;
+  uint64_t q3 = (tmp3 + q2) >> (uint32_t)25U;
+  uint64_t q4 = (tmp4 + q3) >> (uint32_t)26U;
+  uint64_t q5 = (tmp5 + q4) >> (uint32_t)25U;
+  uint64_t q6 = (tmp6 + q5) >> (uint32_t)26U;
+  uint64_t q7 = (tmp7 + q6) >> (uint32_t)25U;
+  uint64_t q8 = (tmp8 + q7) >> (uint32_t)26U;
+  uint64_t q = (tmp9 + q8) >> (uint32_t)25U;
+  uint64_t l_10 = f01 + q * (uint64_t)19U;
+  uint64_t f02 = l_10 & (uint64_t)0x3ffffffU;
+  uint64_t d0 = l_10 >> (uint32_t)26U;
+  uint64_t l_11 = f11 + d0;
+  uint64_t f12 = l_11 & (uint64_t)0x1ffffffU;
+  uint64_t d1 = l_11 >> (uint32_t)25U;
+  uint64_t l_12 = tmp2 + d1;
+  uint64_t f22 = l_12 & (uint64_t)0x3ffffffU;
+  uint64_t d2 = l_12 >> (uint32_t)26U;
+  uint64_t l_13 = tmp3 + d2;
+  uint64_t f32 = l_13 & (uint64_t)0x1ffffffU;
+  uint64_t d3 = l_13 >> (uint32_t)25U;
+  uint64_t l_14 = tmp4 + d3;
+  uint64_t f42 = l_14 & (uint64_t)0x3ffffffU;
+  uint64_t d4 = l_14 >> (uint32_t)26U;
+  uint64_t l_15 = tmp5 + d4;
+  uint64_t f52 = l_15 & (uint64_t)0x1ffffffU;
+  uint64_t d5 = l_15 >> (uint32_t)25U;
+  uint64_t l_16 = tmp6 + d5;
+  uint64_t f62 = l_16 & (uint64_t)0x3ffffffU;
+  uint64_t d6 = l_16 >> (uint32_t)26U;
+  uint64_t l_17 = tmp7 + d6;
+  uint64_t f72 = l_17 & (uint64_t)0x1ffffffU;
+  uint64_t d7 = l_17 >> (uint32_t)25U;
+  uint64_t l_18 = tmp8 + d7;
+  uint64_t f82 = l_18 & (uint64_t)0x3ffffffU;
+  uint64_t d8 = l_18 >> (uint32_t)26U;
+  uint64_t f92 = (tmp9 + d8) & (uint64_t)0x1ffffffU;
+  uint64_t o0 = (f02 | f12 << (uint32_t)26U) | f22 << (uint32_t)51U;
+  uint64_t o1 = (f22 >> (uint32_t)13U | f32 << (uint32_t)13U) | f42 << (uint32_t)38U;
+  uint64_t o2 = (f52 | f62 << (uint32_t)25U) | f72 << (uint32_t)51U;
+  uint64_t o3 = (f72 >> (uint32_t)13U | f82 << (uint32_t)12U) | f92 << (uint32_t)38U;
+  u64s[0U] = o0;
+  u64s[1U] = o1;
+  u64s[2U] = o2;
+  u64s[3U] = o3;
+}
+
+static inline void
+cswap2(
+  Lib_IntVector_Intrinsics_vec256 bit,
+  Lib_IntVector_Intrinsics_vec256 *p1,
+  Lib_IntVector_Intrinsics_vec256 *p2
+)
+{
+  Lib_IntVector_Intrinsics_vec256
+  mask = Lib_IntVector_Intrinsics_vec256_sub64(Lib_IntVector_Intrinsics_vec256_zero, bit);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)20U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256
+    dummy =
+      Lib_IntVector_Intrinsics_vec256_and(mask,
+        Lib_IntVector_Intrinsics_vec256_xor(p1[i], p2[i]));
+    p1[i] = Lib_IntVector_Intrinsics_vec256_xor(p1[i], dummy);
+    p2[i] = Lib_IntVector_Intrinsics_vec256_xor(p2[i], dummy);
+  }
+}
+
+static void
+point_add_and_double(Lib_IntVector_Intrinsics_vec256 *q, Lib_IntVector_Intrinsics_vec256 *p01_tmp1)
+{
+  Lib_IntVector_Intrinsics_vec256 *nq = p01_tmp1;
+  Lib_IntVector_Intrinsics_vec256 *nq_p1 = p01_tmp1 + (uint32_t)20U;
+  Lib_IntVector_Intrinsics_vec256 *tmp1 = p01_tmp1 + (uint32_t)40U;
+  Lib_IntVector_Intrinsics_vec256 *x1 = q;
+  Lib_IntVector_Intrinsics_vec256 *x2 = nq;
+  Lib_IntVector_Intrinsics_vec256 *z2 = nq + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec256 *z3 = nq_p1 + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec256 *a = tmp1;
+  Lib_IntVector_Intrinsics_vec256 *b = tmp1 + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec256 *ab = tmp1;
+  Lib_IntVector_Intrinsics_vec256 *dc = tmp1 + (uint32_t)20U;
+  fadd(a, x2, z2);
+  fsub(b, x2, z2);
+  Lib_IntVector_Intrinsics_vec256 *x3 = nq_p1;
+  Lib_IntVector_Intrinsics_vec256 *z31 = nq_p1 + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec256 *d0 = dc;
+  Lib_IntVector_Intrinsics_vec256 *c0 = dc + (uint32_t)10U;
+  fadd(c0, x3, z31);
+  fsub(d0, x3, z31);
+  fmul2(dc, dc, ab);
+  fadd(x3, d0, c0);
+  fsub(z31, d0, c0);
+  Lib_IntVector_Intrinsics_vec256 *a1 = tmp1;
+  Lib_IntVector_Intrinsics_vec256 *b1 = tmp1 + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec256 *d = tmp1 + (uint32_t)20U;
+  Lib_IntVector_Intrinsics_vec256 *c = tmp1 + (uint32_t)30U;
+  Lib_IntVector_Intrinsics_vec256 *ab1 = tmp1;
+  Lib_IntVector_Intrinsics_vec256 *dc1 = tmp1 + (uint32_t)20U;
+  fsqr2(dc1, ab1);
+  fsqr2(nq_p1, nq_p1);
+  memcpy(a1, c, (uint32_t)10U * sizeof (Lib_IntVector_Intrinsics_vec256));
+  fsub(c, d, c);
+  fmul1(b1, c, (uint64_t)121665U);
+  fadd(b1, b1, d);
+  fmul2(nq, dc1, ab1);
+  fmul(z3, z3, x1);
+}
+
+static void point_double(Lib_IntVector_Intrinsics_vec256 *nq, Lib_IntVector_Intrinsics_vec256 *tmp1)
+{
+  Lib_IntVector_Intrinsics_vec256 *x2 = nq;
+  Lib_IntVector_Intrinsics_vec256 *z2 = nq + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec256 *a = tmp1;
+  Lib_IntVector_Intrinsics_vec256 *b = tmp1 + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec256 *d = tmp1 + (uint32_t)20U;
+  Lib_IntVector_Intrinsics_vec256 *c = tmp1 + (uint32_t)30U;
+  Lib_IntVector_Intrinsics_vec256 *ab = tmp1;
+  Lib_IntVector_Intrinsics_vec256 *dc = tmp1 + (uint32_t)20U;
+  fadd(a, x2, z2);
+  fsub(b, x2, z2);
+  fsqr2(dc, ab);
+  memcpy(a, c, (uint32_t)10U * sizeof (Lib_IntVector_Intrinsics_vec256));
+  fsub(c, d, c);
+  fmul1(b, c, (uint64_t)121665U);
+  fadd(b, b, d);
+  fmul2(nq, dc, ab);
+}
+
+static void
+montgomery_ladder(
+  Lib_IntVector_Intrinsics_vec256 *out,
+  uint8_t *key,
+  Lib_IntVector_Intrinsics_vec256 *init
+)
+{
+  Lib_IntVector_Intrinsics_vec256 p01_tmp1_swap[81U];
+  for (uint32_t _i = 0U; _i < (uint32_t)81U; ++_i)
+    p01_tmp1_swap[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  Lib_IntVector_Intrinsics_vec256 *p0 = p01_tmp1_swap;
+  Lib_IntVector_Intrinsics_vec256 *p01 = p01_tmp1_swap;
+  Lib_IntVector_Intrinsics_vec256 *p03 = p01;
+  Lib_IntVector_Intrinsics_vec256 *p11 = p01 + (uint32_t)20U;
+  memcpy(p11, init, (uint32_t)20U * sizeof (Lib_IntVector_Intrinsics_vec256));
+  Lib_IntVector_Intrinsics_vec256 *x0 = p03;
+  x0[0U] = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)1U);
+  Lib_IntVector_Intrinsics_vec256 *p01_tmp1 = p01_tmp1_swap;
+  Lib_IntVector_Intrinsics_vec256 *p01_tmp11 = p01_tmp1_swap;
+  Lib_IntVector_Intrinsics_vec256 *nq1 = p01_tmp1_swap;
+  Lib_IntVector_Intrinsics_vec256 *nq_p11 = p01_tmp1_swap + (uint32_t)20U;
+  Lib_IntVector_Intrinsics_vec256 *swap = p01_tmp1_swap + (uint32_t)80U;
+  cswap2(Lib_IntVector_Intrinsics_vec256_load64((uint64_t)1U), nq1, nq_p11);
+  point_add_and_double(init, p01_tmp11);
+  swap[0U] = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)1U);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)251U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 *p01_tmp12 = p01_tmp1_swap;
+    Lib_IntVector_Intrinsics_vec256 *swap1 = p01_tmp1_swap + (uint32_t)80U;
+    Lib_IntVector_Intrinsics_vec256 *nq2 = p01_tmp12;
+    Lib_IntVector_Intrinsics_vec256 *nq_p12 = p01_tmp12 + (uint32_t)20U;
+    uint32_t k = ((uint32_t)253U - i) / (uint32_t)8U;
+    uint32_t s = ((uint32_t)253U - i) % (uint32_t)8U;
+    uint64_t b0 = (uint64_t)(key[k] >> s & (uint8_t)1U);
+    uint64_t b1 = (uint64_t)(key[(uint32_t)32U + k] >> s & (uint8_t)1U);
+    uint64_t b2 = (uint64_t)(key[(uint32_t)64U + k] >> s & (uint8_t)1U);
+    uint64_t b3 = (uint64_t)(key[(uint32_t)96U + k] >> s & (uint8_t)1U);
+    Lib_IntVector_Intrinsics_vec256 bit = Lib_IntVector_Intrinsics_vec256_load64s(b0, b1, b2, b3);
+    Lib_IntVector_Intrinsics_vec256 sw = Lib_IntVector_Intrinsics_vec256_xor(swap1[0U], bit);
+    cswap2(sw, nq2, nq_p12);
+    point_add_and_double(init, p01_tmp12);
+    swap1[0U] = bit;
+  }
+  Lib_IntVector_Intrinsics_vec256 sw = swap[0U];
+  cswap2(sw, nq1, nq_p11);
+  Lib_IntVector_Intrinsics_vec256 *nq10 = p01_tmp1;
+  Lib_IntVector_Intrinsics_vec256 *tmp1 = p01_tmp1 + (uint32_t)40U;
+  point_double(nq10, tmp1);
+  point_double(nq10, tmp1);
+  point_double(nq10, tmp1);
+  memcpy(out, p0, (uint32_t)20U * sizeof (Lib_IntVector_Intrinsics_vec256));
+}
+
+static void
+fsquare_times(
+  Lib_IntVector_Intrinsics_vec256 *o,
+  Lib_IntVector_Intrinsics_vec256 *inp,
+  uint32_t n
+)
+{
+  fsqr(o, inp);
+  for (uint32_t i = (uint32_t)0U; i < n - (uint32_t)1U; i++)
+  {
+    fsqr(o, o);
+  }
+}
+
+static void finv(Lib_IntVector_Intrinsics_vec256 *o, Lib_IntVector_Intrinsics_vec256 *i)
+{
+  Lib_IntVector_Intrinsics_vec256 t1[40U];
+  for (uint32_t _i = 0U; _i < (uint32_t)40U; ++_i)
+    t1[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  Lib_IntVector_Intrinsics_vec256 *a = t1;
+  Lib_IntVector_Intrinsics_vec256 *b = t1 + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec256 *c = t1 + (uint32_t)20U;
+  Lib_IntVector_Intrinsics_vec256 *t00 = t1 + (uint32_t)30U;
+  fsquare_times(a, i, (uint32_t)1U);
+  fsquare_times(t00, a, (uint32_t)2U);
+  fmul(b, t00, i);
+  fmul(a, b, a);
+  fsquare_times(t00, a, (uint32_t)1U);
+  fmul(b, t00, b);
+  fsquare_times(t00, b, (uint32_t)5U);
+  fmul(b, t00, b);
+  fsquare_times(t00, b, (uint32_t)10U);
+  fmul(c, t00, b);
+  fsquare_times(t00, c, (uint32_t)20U);
+  fmul(t00, t00, c);
+  fsquare_times(t00, t00, (uint32_t)10U);
+  fmul(b, t00, b);
+  fsquare_times(t00, b, (uint32_t)50U);
+  fmul(c, t00, b);
+  fsquare_times(t00, c, (uint32_t)100U);
+  fmul(t00, t00, c);
+  fsquare_times(t00, t00, (uint32_t)50U);
+  fmul(t00, t00, b);
+  fsquare_times(t00, t00, (uint32_t)5U);
+  Lib_IntVector_Intrinsics_vec256 *a0 = t1;
+  Lib_IntVector_Intrinsics_vec256 *t0 = t1 + (uint32_t)30U;
+  fmul(o, t0, a0);
+}
+
+static void encode_point(uint8_t *o, Lib_IntVector_Intrinsics_vec256 *i)
+{
+  Lib_IntVector_Intrinsics_vec256 *x = i;
+  Lib_IntVector_Intrinsics_vec256 *z = i + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec256 tmp[10U];
+  for (uint32_t _i = 0U; _i < (uint32_t)10U; ++_i)
+    tmp[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  uint8_t lanes[320U] = { 0U };
+  finv(tmp, z);
+  fmul(tmp, tmp, x);
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)10U; i0++)
+  {
+    Lib_IntVector_Intrinsics_vec256_store_le(lanes + i0 * (uint32_t)32U, tmp[i0]);
+  }
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
+  {
+    uint64_t f[10U] = { 0U };
+    uint64_t u64s[4U] = { 0U };
+    for (uint32_t i1 = (uint32_t)0U; i1 < (uint32_t)10U; i1++)
+    {
+      f[i1] = load64_le(lanes + i1 * (uint32_t)32U + i0 * (uint32_t)8U);
+    }
+    store_felem(u64s, f);
+    for (uint32_t i1 = (uint32_t)0U; i1 < (uint32_t)4U; i1++)
+    {
+      store64_le(o + i0 * (uint32_t)32U + i1 * (uint32_t)8U, u64s[i1]);
+    }
+  }
+}
+
+static void load_felem(uint64_t *f, uint8_t *b)
+{
+  uint64_t u0 = load64_le(b);
+  uint64_t u1 = load64_le(b + (uint32_t)8U);
+  uint64_t u2 = load64_le(b + (uint32_t)16U);
+  uint64_t u3 = load64_le(b + (uint32_t)24U) & (uint64_t)0x7fffffffffffffffU;
+  f[0U] = u0 & (uint64_t)0x3ffffffU;
+  f[1U] = u0 >> (uint32_t)26U & (uint64_t)0x1ffffffU;
+  f[2U] = u0 >> (uint32_t)51U | (u1 & (uint64_t)0x1fffU) << (uint32_t)13U;
+  f[3U] = u1 >> (uint32_t)13U & (uint64_t)0x1ffffffU;
+  f[4U] = u1 >> (uint32_t)38U;
+  f[5U] = u2 & (uint64_t)0x1ffffffU;
+  f[6U] = u2 >> (uint32_t)25U & (uint64_t)0x3ffffffU;
+  f[7U] = u2 >> (uint32_t)51U | (u3 & (uint64_t)0xfffU) << (uint32_t)13U;
+  f[8U] = u3 >> (uint32_t)12U & (uint64_t)0x3ffffffU;
+  f[9U] = u3 >> (uint32_t)38U;
+}
+
+static void scalarmult4(uint8_t *out, uint8_t *priv, uint8_t *pub)
+{
+  Lib_IntVector_Intrinsics_vec256 init[20U];
+  for (uint32_t _i = 0U; _i < (uint32_t)20U; ++_i)
+    init[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  uint64_t tmp[40U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    load_felem(tmp + i * (uint32_t)10U, pub + i * (uint32_t)32U);
+  }
+  Lib_IntVector_Intrinsics_vec256 *x = init;
+  Lib_IntVector_Intrinsics_vec256 *z = init + (uint32_t)10U;
+  z[0U] = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)1U);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)10U; i++)
+  {
+    x[i] =
+      Lib_IntVector_Intrinsics_vec256_load64s(tmp[i],
+        tmp[(uint32_t)10U + i],
+        tmp[(uint32_t)20U + i],
+        tmp[(uint32_t)30U + i]);
+  }
+  montgomery_ladder(init, priv, init);
+  encode_point(out, init);
+}
+
+void
+Hacl_Curve25519_256_batch_scalarmult(
+  uint32_t n,
+  uint8_t **out,
+  uint8_t **priv,
+  uint8_t **pub
+)
+{
+  uint32_t groups = (n + (uint32_t)3U) / (uint32_t)4U;
+  for (uint32_t i = (uint32_t)0U; i < groups; i++)
+  {
+    uint8_t out4[128U] = { 0U };
+    uint8_t priv4[128U] = { 0U };
+    uint8_t pub4[128U] = { 0U };
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      uint32_t k = i * (uint32_t)4U + j;
+      uint32_t k1;
+      if (k < n)
+      {
+        k1 = k;
+      }
+      else
+      {
+        k1 = n - (uint32_t)1U;
+      }
+      memcpy(priv4 + j * (uint32_t)32U, priv[k1], (uint32_t)32U * sizeof (uint8_t));
+      memcpy(pub4 + j * (uint32_t)32U, pub[k1], (uint32_t)32U * sizeof (uint8_t));
+    }
+    scalarmult4(out4, priv4, pub4);
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      uint32_t k = i * (uint32_t)4U + j;
+      if (k < n)
+      {
+        memcpy(out[k], out4 + j * (uint32_t)32U, (uint32_t)32U * sizeof (uint8_t));
+      }
+    }
+  }
+}
+
@@ -648,8 +648,6 @@ static inline void cswap20(uint64_t bit, uint64_t *p1, uint64_t *p2)
   }
 }
 
-static const uint8_t g25519[32U] = { (uint8_t)9U };
-
 static void point_add_and_double(uint64_t *q, uint64_t *p01_tmp1, FStar_UInt128_uint128 *tmp2)
 {
   uint64_t *nq = p01_tmp1;
@@ -884,14 +882,11 @@ void Hacl_Curve25519_51_scalarmult(uint8_t *out, uint8_t *priv, uint8_t *pub)
 
 void Hacl_Curve25519_51_secret_to_public(uint8_t *pub, uint8_t *priv)
 {
-  uint8_t basepoint[32U] = { 0U };
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)32U; i++)
-  {
-    uint8_t *os = basepoint;
-    uint8_t x = g25519[i];
-    os[i] = x;
-  }
-  Hacl_Curve25519_51_scalarmult(pub, priv, basepoint);
+  uint8_t scalar[32U] = { 0U };
+  memcpy(scalar, priv, (uint32_t)32U * sizeof (uint8_t));
+  scalar[0U] = scalar[0U] & (uint8_t)248U;
+  scalar[31U] = (scalar[31U] & (uint8_t)127U) | (uint8_t)64U;
+  Hacl_Ed25519_point_mul_g_montgomery(pub, scalar);
 }
 
 bool Hacl_Curve25519_51_ecdh(uint8_t *out, uint8_t *priv, uint8_t *pub)
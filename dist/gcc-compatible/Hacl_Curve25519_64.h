@@ -41,6 +41,7 @@ extern "C" {
 #include "Hacl_Kremlib.h"
 #include "Vale.h"
 #include "Vale_Inline.h"
+#include "Hacl_Ed25519.h"
 
 void Hacl_Curve25519_64_scalarmult(uint8_t *out, uint8_t *priv, uint8_t *pub);
 
@@ -24,6 +24,8 @@
 
 #include "Hacl_Ed25519.h"
 
+#include "Lib_RandomBuffer_System.h"
+
 static void fsum(uint64_t *a, uint64_t *b)
 {
   Hacl_Impl_Curve25519_Field51_fadd(a, a, b);
@@ -393,155 +395,1414 @@ static void point_double(uint64_t *out, uint64_t *p)
   fmul0(z3, tmp4, tmp2);
 }
 
-static void
-swap_conditional_step(uint64_t *a_, uint64_t *b_, uint64_t *a, uint64_t *b, uint64_t swap)
+static void point_identity(uint64_t *out)
 {
-  uint64_t a0 = a[0U];
-  uint64_t a1 = a[1U];
-  uint64_t a2 = a[2U];
-  uint64_t a3 = a[3U];
-  uint64_t a4 = a[4U];
-  uint64_t b0 = b[0U];
-  uint64_t b1 = b[1U];
-  uint64_t b2 = b[2U];
-  uint64_t b3 = b[3U];
-  uint64_t b4 = b[4U];
-  uint64_t x0 = (a0 ^ b0) & swap;
-  uint64_t x1 = (a1 ^ b1) & swap;
-  uint64_t x2 = (a2 ^ b2) & swap;
-  uint64_t x3 = (a3 ^ b3) & swap;
-  uint64_t x4 = (a4 ^ b4) & swap;
-  a_[0U] = a0 ^ x0;
-  b_[0U] = b0 ^ x0;
-  a_[1U] = a1 ^ x1;
-  b_[1U] = b1 ^ x1;
-  a_[2U] = a2 ^ x2;
-  b_[2U] = b2 ^ x2;
-  a_[3U] = a3 ^ x3;
-  b_[3U] = b3 ^ x3;
-  a_[4U] = a4 ^ x4;
-  b_[4U] = b4 ^ x4;
+  memset(out, 0U, (uint32_t)20U * sizeof (uint64_t));
+  out[5U] = (uint64_t)1U;
+  out[10U] = (uint64_t)1U;
 }
 
-static void
-swap_conditional(uint64_t *a_, uint64_t *b_, uint64_t *a, uint64_t *b, uint64_t iswap)
-{
-  uint64_t swap = (uint64_t)0U - iswap;
-  swap_conditional_step(a_, b_, a, b, swap);
-  swap_conditional_step(a_ + (uint32_t)5U,
-    b_ + (uint32_t)5U,
-    a + (uint32_t)5U,
-    b + (uint32_t)5U,
-    swap);
-  swap_conditional_step(a_ + (uint32_t)10U,
-    b_ + (uint32_t)10U,
-    a + (uint32_t)10U,
-    b + (uint32_t)10U,
-    swap);
-  swap_conditional_step(a_ + (uint32_t)15U,
-    b_ + (uint32_t)15U,
-    a + (uint32_t)15U,
-    b + (uint32_t)15U,
-    swap);
-}
-
-static void swap_conditional_inplace(uint64_t *a, uint64_t *b, uint64_t iswap)
-{
-  uint64_t swap = (uint64_t)0U - iswap;
-  swap_conditional_step(a, b, a, b, swap);
-  swap_conditional_step(a + (uint32_t)5U,
-    b + (uint32_t)5U,
-    a + (uint32_t)5U,
-    b + (uint32_t)5U,
-    swap);
-  swap_conditional_step(a + (uint32_t)10U,
-    b + (uint32_t)10U,
-    a + (uint32_t)10U,
-    b + (uint32_t)10U,
-    swap);
-  swap_conditional_step(a + (uint32_t)15U,
-    b + (uint32_t)15U,
-    a + (uint32_t)15U,
-    b + (uint32_t)15U,
-    swap);
-}
-
-static void point_mul(uint64_t *result, uint8_t *scalar, uint64_t *q)
-{
-  uint64_t b[80U] = { 0U };
-  uint64_t *nq = b;
-  uint64_t *nqpq = b + (uint32_t)20U;
-  uint64_t *x = nq;
-  uint64_t *y = nq + (uint32_t)5U;
-  uint64_t *z = nq + (uint32_t)10U;
-  uint64_t *t = nq + (uint32_t)15U;
-  x[0U] = (uint64_t)0U;
-  x[1U] = (uint64_t)0U;
-  x[2U] = (uint64_t)0U;
-  x[3U] = (uint64_t)0U;
-  x[4U] = (uint64_t)0U;
-  y[0U] = (uint64_t)1U;
-  y[1U] = (uint64_t)0U;
-  y[2U] = (uint64_t)0U;
-  y[3U] = (uint64_t)0U;
-  y[4U] = (uint64_t)0U;
-  z[0U] = (uint64_t)1U;
-  z[1U] = (uint64_t)0U;
-  z[2U] = (uint64_t)0U;
-  z[3U] = (uint64_t)0U;
-  z[4U] = (uint64_t)0U;
-  t[0U] = (uint64_t)0U;
-  t[1U] = (uint64_t)0U;
-  t[2U] = (uint64_t)0U;
-  t[3U] = (uint64_t)0U;
-  t[4U] = (uint64_t)0U;
-  memcpy(nqpq, q, (uint32_t)20U * sizeof (uint64_t));
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)256U; i++)
+static void fnegate(uint64_t *out, uint64_t *a)
+{
+  uint64_t tmp[5U] = { 0U };
+  memcpy(tmp, a, (uint32_t)5U * sizeof (uint64_t));
+  reduce(tmp);
+  out[0U] = (uint64_t)0x7ffffffffffedU - tmp[0U];
+  out[1U] = (uint64_t)0x7ffffffffffffU - tmp[1U];
+  out[2U] = (uint64_t)0x7ffffffffffffU - tmp[2U];
+  out[3U] = (uint64_t)0x7ffffffffffffU - tmp[3U];
+  out[4U] = (uint64_t)0x7ffffffffffffU - tmp[4U];
+}
+
+/* Fixed-base scalar multiplication, in constant time: row i of the table holds (y+x, y-x, 2dxy)
+   for [j 256^i]B, j = 1..8, and the scalar is recoded into 64 signed radix-16 digits. */
+
+static const
+uint64_t
+radix16_table_g[3840U] =
+  {
+    (uint64_t)0x000493c6f58c3b85U, (uint64_t)0x0000df7181c325f7U, (uint64_t)0x0000f50b0b3e4cb7U,
+    (uint64_t)0x0005329385a44c32U, (uint64_t)0x00007cf9d3a33d4bU, (uint64_t)0x00003905d740913eU,
+    (uint64_t)0x0000ba2817d673a2U, (uint64_t)0x00023e2827f4e67cU, (uint64_t)0x000133d2e0c21a34U,
+    (uint64_t)0x00044fd2f9298f81U, (uint64_t)0x00011205877aaa68U, (uint64_t)0x000479955893d579U,
+    (uint64_t)0x00050d66309b67a0U, (uint64_t)0x0002d42d0dbee5eeU, (uint64_t)0x0006f117b689f0c6U,
+    (uint64_t)0x0004e7fc933c71d7U, (uint64_t)0x0002cf41feb6b244U, (uint64_t)0x0007581c0a7d1a76U,
+    (uint64_t)0x0007172d534d32f0U, (uint64_t)0x000590c063fa87d2U, (uint64_t)0x0001a56042b4d5a8U,
+    (uint64_t)0x000189cc159ed153U, (uint64_t)0x0005b8deaa3cae04U, (uint64_t)0x0002aaf04f11b5d8U,
+    (uint64_t)0x0006bb595a669c92U, (uint64_t)0x0002a8b3a59b7a5fU, (uint64_t)0x0003abb359ef087fU,
+    (uint64_t)0x0004f5a8c4db05afU, (uint64_t)0x0005b9a807d04205U, (uint64_t)0x000701af5b13ea50U,
+    (uint64_t)0x0005b0a84cee9730U, (uint64_t)0x00061d10c97155e4U, (uint64_t)0x0004059cc8096a10U,
+    (uint64_t)0x00047a608da8014fU, (uint64_t)0x0007a164e1b9a80fU, (uint64_t)0x00011fe8a4fcd265U,
+    (uint64_t)0x0007bcb8374faaccU, (uint64_t)0x00052f5af4ef4d4fU, (uint64_t)0x0005314098f98d10U,
+    (uint64_t)0x0002ab91587555bdU, (uint64_t)0x0006933f0dd0d889U, (uint64_t)0x00044386bb4c4295U,
+    (uint64_t)0x0003cb6d3162508cU, (uint64_t)0x00026368b872a2c6U, (uint64_t)0x0005a2826af12b9bU,
+    (uint64_t)0x000351b98efc099fU, (uint64_t)0x00068fbfa4a7050eU, (uint64_t)0x00042a49959d971bU,
+    (uint64_t)0x000393e51a469efdU, (uint64_t)0x000680e910321e58U, (uint64_t)0x0006050a056818bfU,
+    (uint64_t)0x00062acc1f5532bfU, (uint64_t)0x00028141ccc9fa25U, (uint64_t)0x00024d61f471e683U,
+    (uint64_t)0x00027933f4c7445aU, (uint64_t)0x0003fbe9c476ff09U, (uint64_t)0x0000af6b982e4b42U,
+    (uint64_t)0x0000ad1251ba78e5U, (uint64_t)0x000715aeedee7c88U, (uint64_t)0x0007f9d0cbf63553U,
+    (uint64_t)0x0002bc4408a5bb33U, (uint64_t)0x000078ebdda05442U, (uint64_t)0x0002ffb112354123U,
+    (uint64_t)0x000375ee8df5862dU, (uint64_t)0x0002945ccf146e20U, (uint64_t)0x000182c3a447d6baU,
+    (uint64_t)0x00022964e536eff2U, (uint64_t)0x000192821f540053U, (uint64_t)0x0002f9f19e788e5cU,
+    (uint64_t)0x000154a7e73eb1b5U, (uint64_t)0x0003dbf1812a8285U, (uint64_t)0x0000fa17ba3f9797U,
+    (uint64_t)0x0006f69cb49c3820U, (uint64_t)0x00034d5a0db3858dU, (uint64_t)0x00043aabe696b3bbU,
+    (uint64_t)0x0004eeeb77157131U, (uint64_t)0x0001201915f10741U, (uint64_t)0x0001669cda6c9c56U,
+    (uint64_t)0x00045ec032db346dU, (uint64_t)0x00051e57bb6a2cc3U, (uint64_t)0x000006b67b7d8ca4U,
+    (uint64_t)0x000084fa44e72933U, (uint64_t)0x0001154ee55d6f8aU, (uint64_t)0x0004425d842e7390U,
+    (uint64_t)0x00038b64c41ae417U, (uint64_t)0x0004326702ea4b71U, (uint64_t)0x00006834376030b5U,
+    (uint64_t)0x0000ef0512f9c380U, (uint64_t)0x0000f1a9f2512584U, (uint64_t)0x00010b8e91a9f0d6U,
+    (uint64_t)0x00025cd0944ea3bfU, (uint64_t)0x00075673b81a4d63U, (uint64_t)0x000150b925d1c0d4U,
+    (uint64_t)0x00013f38d9294114U, (uint64_t)0x000461bea69283c9U, (uint64_t)0x00072c9aaa3221b1U,
+    (uint64_t)0x000267774474f74dU, (uint64_t)0x000064b0e9b28085U, (uint64_t)0x0003f04ef53b27c9U,
+    (uint64_t)0x0001d6edd5d2e531U, (uint64_t)0x00036dc801b8b3a2U, (uint64_t)0x0000e0a7d4935e30U,
+    (uint64_t)0x0001deb7cecc0d7dU, (uint64_t)0x000053a94e20dd2cU, (uint64_t)0x0007a9fbb1c6a0f9U,
+    (uint64_t)0x0007596604dd3e8fU, (uint64_t)0x0006fc510e058b36U, (uint64_t)0x0003670c8db2cc0dU,
+    (uint64_t)0x000297d899ce332fU, (uint64_t)0x0000915e76061bceU, (uint64_t)0x00075dedf39234d9U,
+    (uint64_t)0x00001c36ab1f3c54U, (uint64_t)0x0000f08fee58f5daU, (uint64_t)0x0000e19613a0d637U,
+    (uint64_t)0x0003a9024a1320e0U, (uint64_t)0x0001f5d9c9a2911aU, (uint64_t)0x0007117994fafcf8U,
+    (uint64_t)0x0002d8a8cae28dc5U, (uint64_t)0x00074ab1b2090c87U, (uint64_t)0x00026907c5c2ecc4U,
+    (uint64_t)0x0004dd0e632f9c1dU, (uint64_t)0x0002ced12622a5d9U, (uint64_t)0x00018de9614742daU,
+    (uint64_t)0x00079ca96fdbb5d4U, (uint64_t)0x0006dd37d49a00eeU, (uint64_t)0x0003635449aa515eU,
+    (uint64_t)0x0003e178d0475dabU, (uint64_t)0x00050b4712a19712U, (uint64_t)0x0002dcc2860ff4adU,
+    (uint64_t)0x00030d76d6f03d31U, (uint64_t)0x000444172106e4c7U, (uint64_t)0x00001251afed2d88U,
+    (uint64_t)0x000534fc9bed4f5aU, (uint64_t)0x0005d85a39cf5234U, (uint64_t)0x00010c697112e864U,
+    (uint64_t)0x00062aa08358c805U, (uint64_t)0x00046f440848e194U, (uint64_t)0x000447b771a8f52bU,
+    (uint64_t)0x000377ba3269d31dU, (uint64_t)0x00003bf9baf55080U, (uint64_t)0x0003c4277dbe5fdeU,
+    (uint64_t)0x0005a335afd44c92U, (uint64_t)0x0000c1164099753eU, (uint64_t)0x00070487006fe423U,
+    (uint64_t)0x00025e61cabed66fU, (uint64_t)0x0003e128cc586604U, (uint64_t)0x0005968b2e8fc7e2U,
+    (uint64_t)0x000049a3d5bd61cfU, (uint64_t)0x000116505b1ef6e6U, (uint64_t)0x000566d78634586eU,
+    (uint64_t)0x00054285c65a2fd0U, (uint64_t)0x00055e62ccf87420U, (uint64_t)0x00046bb961b19044U,
+    (uint64_t)0x0001153405712039U, (uint64_t)0x00014fba5f34793bU, (uint64_t)0x0007a49f9cc10834U,
+    (uint64_t)0x0002b513788a22c6U, (uint64_t)0x0005ff4b6ef2395bU, (uint64_t)0x0002ec8e5af607bfU,
+    (uint64_t)0x00033975bca5ecc3U, (uint64_t)0x000746166985f7d4U, (uint64_t)0x00009939000ae79aU,
+    (uint64_t)0x0005844c7964f97aU, (uint64_t)0x00013617e1f95b3dU, (uint64_t)0x00014829cea83fc5U,
+    (uint64_t)0x00070b2f4e71ecb8U, (uint64_t)0x000728148efc643cU, (uint64_t)0x0000753e03995b76U,
+    (uint64_t)0x0005bf5fb2ab6767U, (uint64_t)0x00005fc3bc4535d7U, (uint64_t)0x00037b8497dd95c2U,
+    (uint64_t)0x00061549d6b4ffe8U, (uint64_t)0x000217a22db1d138U, (uint64_t)0x0000b9cf062eb09eU,
+    (uint64_t)0x0002fd9c71e5f758U, (uint64_t)0x0000b3ae52afdeddU, (uint64_t)0x00019da76619e497U,
+    (uint64_t)0x0006fa0654d2558eU, (uint64_t)0x00078219d25e41d4U, (uint64_t)0x000373767475c651U,
+    (uint64_t)0x000095cb14246590U, (uint64_t)0x000002d82aa6ac68U, (uint64_t)0x000442f183bc4851U,
+    (uint64_t)0x0006464f1c0a0644U, (uint64_t)0x0006bf5905730907U, (uint64_t)0x000299fd40d1add9U,
+    (uint64_t)0x0005f2de9a04e5f7U, (uint64_t)0x0007c0eebacc1c59U, (uint64_t)0x0004cca1b1f8290aU,
+    (uint64_t)0x0001fbea56c3b18fU, (uint64_t)0x000778f1e1415b8aU, (uint64_t)0x0006f75874efc1f4U,
+    (uint64_t)0x00028a694019027fU, (uint64_t)0x00052b37a96bdc4dU, (uint64_t)0x00002521cf67a635U,
+    (uint64_t)0x00046720772f5ee4U, (uint64_t)0x000632c0f359d622U, (uint64_t)0x0002b2092ba3e252U,
+    (uint64_t)0x000662257c112680U, (uint64_t)0x000001753d9f7cd6U, (uint64_t)0x0007ee0b0a9d5294U,
+    (uint64_t)0x000381fbeb4cca27U, (uint64_t)0x0007841f3a3e639dU, (uint64_t)0x000676ea30c3445fU,
+    (uint64_t)0x0003fa00a7e71382U, (uint64_t)0x0001232d963ddb34U, (uint64_t)0x00035692e70b078dU,
+    (uint64_t)0x000247ca14777a1fU, (uint64_t)0x0006db556be8fcd0U, (uint64_t)0x00012b5fe2fa048eU,
+    (uint64_t)0x00037c26ad6f1e92U, (uint64_t)0x00046a0971227be5U, (uint64_t)0x0004722f0d2d9b4cU,
+    (uint64_t)0x0003dc46204ee03aU, (uint64_t)0x0006f7e93c20796cU, (uint64_t)0x0000fbc496fce34dU,
+    (uint64_t)0x000575be6b7dae3eU, (uint64_t)0x0004a31585cee609U, (uint64_t)0x000037e9023930ffU,
+    (uint64_t)0x000749b76f96fb12U, (uint64_t)0x0002f604aea6ae05U, (uint64_t)0x000637dc939323ebU,
+    (uint64_t)0x0003fdad9b048d47U, (uint64_t)0x0000a8b0d4045af7U, (uint64_t)0x0000fcec10f01e02U,
+    (uint64_t)0x0002d29dc4244e45U, (uint64_t)0x0006927b1bc147beU, (uint64_t)0x0000308534ac0839U,
+    (uint64_t)0x0004853664033f41U, (uint64_t)0x000413779166feabU, (uint64_t)0x000558a649fe1e44U,
+    (uint64_t)0x00044635aeefcc89U, (uint64_t)0x0001ff434887f2baU, (uint64_t)0x0000f981220e2d44U,
+    (uint64_t)0x0004901aa7183c51U, (uint64_t)0x0001b7548c1af8f0U, (uint64_t)0x0007848c53368116U,
+    (uint64_t)0x00001b64e7383de9U, (uint64_t)0x000109fbb0587c8fU, (uint64_t)0x00041bb887b726d1U,
+    (uint64_t)0x00034c597c6691aeU, (uint64_t)0x0007a150b6990fc4U, (uint64_t)0x00052beb9d922274U,
+    (uint64_t)0x00070eed7164861aU, (uint64_t)0x0000a871e070c6a9U, (uint64_t)0x00007d44744346beU,
+    (uint64_t)0x000282b6a564a81dU, (uint64_t)0x0004ed80f875236bU, (uint64_t)0x0006fbbe1d450c50U,
+    (uint64_t)0x0004eb728c12fcdbU, (uint64_t)0x0001b5994bbc8989U, (uint64_t)0x00074b7ba84c0660U,
+    (uint64_t)0x00075678f1cdaeb8U, (uint64_t)0x00023206b0d6f10cU, (uint64_t)0x0003ee7300f2685dU,
+    (uint64_t)0x00027947841e7518U, (uint64_t)0x00032c7388dae87fU, (uint64_t)0x000414add3971be9U,
+    (uint64_t)0x00001850832f0ef1U, (uint64_t)0x0007d47c6a2cfb89U, (uint64_t)0x000255e49e7dd6b7U,
+    (uint64_t)0x00038c2163d59ebaU, (uint64_t)0x0003861f2a005845U, (uint64_t)0x0002e11e4ccbaec9U,
+    (uint64_t)0x0001381576297912U, (uint64_t)0x0002d0148ef0d6e0U, (uint64_t)0x0003522a8de787fbU,
+    (uint64_t)0x0002ee055e74f9d2U, (uint64_t)0x00064038f6310813U, (uint64_t)0x000148cf58d34c9eU,
+    (uint64_t)0x00072f7d9ae4756dU, (uint64_t)0x0007711e690ffc4aU, (uint64_t)0x000582a2355b0d16U,
+    (uint64_t)0x0000dccfe885b6b4U, (uint64_t)0x000278febad4eaeaU, (uint64_t)0x000492f67934f027U,
+    (uint64_t)0x0007ded0815528d4U, (uint64_t)0x00058461511a6612U, (uint64_t)0x0005ea2e50de1544U,
+    (uint64_t)0x0003ff2fa1ebd5dbU, (uint64_t)0x0002681f8c933966U, (uint64_t)0x0003840521931635U,
+    (uint64_t)0x000674f14a308652U, (uint64_t)0x0003bd9c88a94890U, (uint64_t)0x0004104dd02fe9c6U,
+    (uint64_t)0x00014e06db096ab8U, (uint64_t)0x0001219c89e6b024U, (uint64_t)0x000278abd486a2dbU,
+    (uint64_t)0x000240b292609520U, (uint64_t)0x0000165b5a48efcaU, (uint64_t)0x0002bf5e1124422aU,
+    (uint64_t)0x000673146756ae56U, (uint64_t)0x00014ad99a87e830U, (uint64_t)0x0001eaca65b080fdU,
+    (uint64_t)0x0002c863b00afaf5U, (uint64_t)0x0000a474a0846a76U, (uint64_t)0x000099a5ef981e32U,
+    (uint64_t)0x0002a8ae3c4bbfe6U, (uint64_t)0x00045c34af14832cU, (uint64_t)0x000591b67d9bffecU,
+    (uint64_t)0x0001b3719f18b55dU, (uint64_t)0x000754318c83d337U, (uint64_t)0x00027c17b7919797U,
+    (uint64_t)0x000145b084089b61U, (uint64_t)0x000489b4f8670301U, (uint64_t)0x00070d1c80b49bfaU,
+    (uint64_t)0x0003d57e7d914625U, (uint64_t)0x0003c0722165e545U, (uint64_t)0x0005e5b93819e04fU,
+    (uint64_t)0x0003de02ec7ca8f7U, (uint64_t)0x0002102d3aeb92efU, (uint64_t)0x00068c22d50c3a46U,
+    (uint64_t)0x00042ea89385894eU, (uint64_t)0x00075f9ebf55f38cU, (uint64_t)0x00049f5fbba496cbU,
+    (uint64_t)0x0005628c1e9c572eU, (uint64_t)0x000598b108e822abU, (uint64_t)0x00055d8fae29361aU,
+    (uint64_t)0x0000adc8d1a97b28U, (uint64_t)0x00006a1a6c288675U, (uint64_t)0x00049a108a5bcfd4U,
+    (uint64_t)0x0006178c8e7d6612U, (uint64_t)0x0001f03473710375U, (uint64_t)0x00073a49614a6098U,
+    (uint64_t)0x0005604a86dcbfa6U, (uint64_t)0x0000d1d47c1764b6U, (uint64_t)0x00001c08316a2e51U,
+    (uint64_t)0x0002b3db45c95045U, (uint64_t)0x0001634f818d300cU, (uint64_t)0x00020989e89fe274U,
+    (uint64_t)0x0004278b85eaec2eU, (uint64_t)0x0000ef59657be2ceU, (uint64_t)0x00072fd169588770U,
+    (uint64_t)0x0002e9b205260b30U, (uint64_t)0x000730b9950f7059U, (uint64_t)0x000777fd3a2dcc7fU,
+    (uint64_t)0x000594a9fb124932U, (uint64_t)0x00001f8e80ca15f0U, (uint64_t)0x000714d13cec3269U,
+    (uint64_t)0x0000403ed1d0ca67U, (uint64_t)0x00032d35874ec552U, (uint64_t)0x0001f3048df1b929U,
+    (uint64_t)0x000300d73b179b23U, (uint64_t)0x0006e67be5a37d0bU, (uint64_t)0x0005bd7454308303U,
+    (uint64_t)0x0004932115e7792aU, (uint64_t)0x000457b9bbb930b8U, (uint64_t)0x00068f5d8b193226U,
+    (uint64_t)0x0004164e8f1ed456U, (uint64_t)0x0005bb7db123067fU, (uint64_t)0x0002d19528b24cc2U,
+    (uint64_t)0x0004ac66b8302ff3U, (uint64_t)0x000701c8d9fdad51U, (uint64_t)0x0006c1b35c5b3727U,
+    (uint64_t)0x000133a78007380aU, (uint64_t)0x0001f467c6ca62beU, (uint64_t)0x0002c4232a5dc12cU,
+    (uint64_t)0x0007551dc013b087U, (uint64_t)0x0000690c11b03bcdU, (uint64_t)0x000740dca6d58f0eU,
+    (uint64_t)0x00028c570478433cU, (uint64_t)0x0001d8502873a463U, (uint64_t)0x0007641e7eded49cU,
+    (uint64_t)0x0001ecedd54cf571U, (uint64_t)0x0002c03f5256c2b0U, (uint64_t)0x0000ee0752cfce4eU,
+    (uint64_t)0x000660dd8116fbe9U, (uint64_t)0x00055167130fffebU, (uint64_t)0x0001c682b885955cU,
+    (uint64_t)0x000161d25fa963eaU, (uint64_t)0x000718757b53a47dU, (uint64_t)0x000619e18b0f2f21U,
+    (uint64_t)0x0005fbdfe4c1ec04U, (uint64_t)0x0005d798c81ebb92U, (uint64_t)0x000699468bdbd96bU,
+    (uint64_t)0x00053de66aa91948U, (uint64_t)0x000045f81a599b1bU, (uint64_t)0x0003f7a8bd214193U,
+    (uint64_t)0x00071d4da412331aU, (uint64_t)0x000293e1c4e6c4a2U, (uint64_t)0x00072f46f4dafecfU,
+    (uint64_t)0x0002948ffadef7a3U, (uint64_t)0x00011ecdfdf3bc04U, (uint64_t)0x0003c2e98ffeed25U,
+    (uint64_t)0x000525219a473905U, (uint64_t)0x0006134b925112e1U, (uint64_t)0x0006bb942bb406edU,
+    (uint64_t)0x000070c445c0dde2U, (uint64_t)0x000411d822c4d7a3U, (uint64_t)0x0005b605c447f032U,
+    (uint64_t)0x0001fec6f0e7f04cU, (uint64_t)0x0003cebc692c477dU, (uint64_t)0x000077986a19a95eU,
+    (uint64_t)0x0006eaaaa1778b0fU, (uint64_t)0x0002f12fef4cc5abU, (uint64_t)0x0005805920c47c89U,
+    (uint64_t)0x0001924771f9972cU, (uint64_t)0x00038bbddf9fc040U, (uint64_t)0x0001f7000092b281U,
+    (uint64_t)0x00024a76dcea8aebU, (uint64_t)0x000522b2dfc0c740U, (uint64_t)0x0007e8193480e148U,
+    (uint64_t)0x00033fd9a04341b9U, (uint64_t)0x0003c863678a20bcU, (uint64_t)0x0005e607b2518a43U,
+    (uint64_t)0x0004431ca596cf14U, (uint64_t)0x000015da7c801405U, (uint64_t)0x00003c9b6f8f10b5U,
+    (uint64_t)0x0000346922934017U, (uint64_t)0x000201f33139e457U, (uint64_t)0x00031d8f6cdf1818U,
+    (uint64_t)0x0001f86c4b144b16U, (uint64_t)0x00039875b8d73e9dU, (uint64_t)0x0002fbf0d9ffa7b3U,
+    (uint64_t)0x0005067acab6ccddU, (uint64_t)0x00027f6b08039d51U, (uint64_t)0x0004802f8000dfaaU,
+    (uint64_t)0x00009692a062c525U, (uint64_t)0x0001baea91075817U, (uint64_t)0x000397cba8862460U,
+    (uint64_t)0x0005c3fbc81379e7U, (uint64_t)0x00041bbc255e2f02U, (uint64_t)0x0006a3f756998650U,
+    (uint64_t)0x0001297fd4e07c42U, (uint64_t)0x000771b4022c1e1cU, (uint64_t)0x00013093f05959b2U,
+    (uint64_t)0x0001bd352f2ec618U, (uint64_t)0x000075789b88ea86U, (uint64_t)0x00061d1117ea48b9U,
+    (uint64_t)0x0002339d320766e6U, (uint64_t)0x0005d986513a2fa7U, (uint64_t)0x00063f3a99e11b0fU,
+    (uint64_t)0x00028a0ecfd6b26dU, (uint64_t)0x00053b6835e18d8fU, (uint64_t)0x000331a189219971U,
+    (uint64_t)0x00012f3a9d7572afU, (uint64_t)0x00010d00e953c4caU, (uint64_t)0x000603df116f2f8aU,
+    (uint64_t)0x00033dc276e0e088U, (uint64_t)0x0001ac9619ff649aU, (uint64_t)0x00066f45fb4f80c6U,
+    (uint64_t)0x0003cc38eeb9fea2U, (uint64_t)0x000107647270db1fU, (uint64_t)0x000710f1ea740dc8U,
+    (uint64_t)0x00031167c6b83bdfU, (uint64_t)0x00033842524b1068U, (uint64_t)0x00077dd39d30fe45U,
+    (uint64_t)0x000189432141a0d0U, (uint64_t)0x000088fe4eb8c225U, (uint64_t)0x000612436341f08bU,
+    (uint64_t)0x000349e31a2d2638U, (uint64_t)0x0000137a7fa6b16cU, (uint64_t)0x000681ae92777edcU,
+    (uint64_t)0x000222bfc5f8dc51U, (uint64_t)0x0001522aa3178d90U, (uint64_t)0x000541db874e898dU,
+    (uint64_t)0x00062d80fb841b33U, (uint64_t)0x00003e6ef027fa97U, (uint64_t)0x0007a03c9e9633e8U,
+    (uint64_t)0x00046ebe2309e5efU, (uint64_t)0x00002f5369614938U, (uint64_t)0x000356e5ada20587U,
+    (uint64_t)0x00011bc89f6bf902U, (uint64_t)0x000036746419c8dbU, (uint64_t)0x00045fe70f505243U,
+    (uint64_t)0x00024920c8951491U, (uint64_t)0x000107ec61944c5eU, (uint64_t)0x00072752e017c01fU,
+    (uint64_t)0x000122b7dda2e97aU, (uint64_t)0x00016619f6db57a2U, (uint64_t)0x000075a6960c0b8cU,
+    (uint64_t)0x0006dde1c5e41b49U, (uint64_t)0x00042e3f516da341U, (uint64_t)0x00016a03fda8e79eU,
+    (uint64_t)0x000428d1623a0e39U, (uint64_t)0x00074a4401a308fdU, (uint64_t)0x00006ed4b9558109U,
+    (uint64_t)0x000746f1f6a08867U, (uint64_t)0x0004636f5c6f2321U, (uint64_t)0x0001d81592d60bd3U,
+    (uint64_t)0x0005b69f7b85c5e8U, (uint64_t)0x00017a2d175650ecU, (uint64_t)0x0004cc3e6dbfc19eU,
+    (uint64_t)0x00073e1d3873be0eU, (uint64_t)0x0003a5f6d51b0af8U, (uint64_t)0x00068756a60dac5fU,
+    (uint64_t)0x00055d757b8aec26U, (uint64_t)0x0003383df45f80bdU, (uint64_t)0x0006783f8c9f96a6U,
+    (uint64_t)0x00020234a7789ecdU, (uint64_t)0x00020db67178b252U, (uint64_t)0x00073aa3da2c0edaU,
+    (uint64_t)0x00079045c01c70d3U, (uint64_t)0x0001b37b15251059U, (uint64_t)0x0007cd682353cffeU,
+    (uint64_t)0x0005cd6068acf4f3U, (uint64_t)0x0003079afc7a74ccU, (uint64_t)0x00058097650b64b4U,
+    (uint64_t)0x00047fabac9c4e99U, (uint64_t)0x0003ef0253b2b2cdU, (uint64_t)0x0001a45bd887fab6U,
+    (uint64_t)0x00065748076dc17cU, (uint64_t)0x0005b98000aa11a8U, (uint64_t)0x0004a1ecc9080974U,
+    (uint64_t)0x0002838c8863bdc0U, (uint64_t)0x0003b0cf4a465030U, (uint64_t)0x000022b8aef57a2dU,
+    (uint64_t)0x0002ad0677e925adU, (uint64_t)0x0004094167d7457aU, (uint64_t)0x00021dcb8a606a82U,
+    (uint64_t)0x000500fabe7731baU, (uint64_t)0x0007cc53c3113351U, (uint64_t)0x0007cf65fe080d81U,
+    (uint64_t)0x0003c5d966011ba1U, (uint64_t)0x0005d840dbf6c6f6U, (uint64_t)0x000004468c9d9fc8U,
+    (uint64_t)0x0005da8554796b8cU, (uint64_t)0x0003b8be70950025U, (uint64_t)0x0006d5892da6a609U,
+    (uint64_t)0x0000bc3d08194a31U, (uint64_t)0x0006380d309fe18bU, (uint64_t)0x0004d73c2cb8ee0dU,
+    (uint64_t)0x0006b882adbac0b6U, (uint64_t)0x00036eabdddd4cbeU, (uint64_t)0x0003a4276232ac19U,
+    (uint64_t)0x0000c172db447ecbU, (uint64_t)0x0003f8c505b7a77fU, (uint64_t)0x0006a857f97f3f10U,
+    (uint64_t)0x0004fcc0567fe03aU, (uint64_t)0x0000770c9e824e1aU, (uint64_t)0x0002432c8a7084faU,
+    (uint64_t)0x00047bf73ca8a968U, (uint64_t)0x0001639176262867U, (uint64_t)0x0005e8df4f8010ceU,
+    (uint64_t)0x0001ff177cea16deU, (uint64_t)0x0001d99a45b5b5fdU, (uint64_t)0x000523674f2499ecU,
+    (uint64_t)0x0000f8fa26182613U, (uint64_t)0x00058f7398048c98U, (uint64_t)0x00039f264fd41500U,
+    (uint64_t)0x00034aabfe097be1U, (uint64_t)0x00043bfc03253a33U, (uint64_t)0x00029bc7fe91b7f3U,
+    (uint64_t)0x0000a761e4844a16U, (uint64_t)0x00065c621272c35fU, (uint64_t)0x00053417dbe7e29cU,
+    (uint64_t)0x00054573827394f5U, (uint64_t)0x000565eea6f650ddU, (uint64_t)0x00042050748dc749U,
+    (uint64_t)0x0001712d73468889U, (uint64_t)0x000389f8ce3193ddU, (uint64_t)0x0002d424b8177ce5U,
+    (uint64_t)0x000073fa0d3440cdU, (uint64_t)0x000139020cd49e97U, (uint64_t)0x00022f9800ab19ceU,
+    (uint64_t)0x00029fdd9a6efdacU, (uint64_t)0x0007c694a9282840U, (uint64_t)0x0006f7cdeee44b3aU,
+    (uint64_t)0x00055a3207b25cc3U, (uint64_t)0x0004171a4d38598cU, (uint64_t)0x0002368a3e9ef8cbU,
+    (uint64_t)0x000454aa08e2ac0bU, (uint64_t)0x000490923f8fa700U, (uint64_t)0x000372aa9ea4582fU,
+    (uint64_t)0x00013f416cd64762U, (uint64_t)0x000758aa99c94c8cU, (uint64_t)0x0005f6001700ff44U,
+    (uint64_t)0x0007694e488c01bdU, (uint64_t)0x0000d5fde948eed6U, (uint64_t)0x000508214fa574bdU,
+    (uint64_t)0x000215bb53d003d6U, (uint64_t)0x0001179e792ca8c3U, (uint64_t)0x0001a0e96ac840a2U,
+    (uint64_t)0x00022393e2bb3ab6U, (uint64_t)0x0003a7758a4c86cbU, (uint64_t)0x000269153ed6fe4bU,
+    (uint64_t)0x00072a23aef89840U, (uint64_t)0x000052be5299699cU, (uint64_t)0x0003a5e5ef132316U,
+    (uint64_t)0x00022f960ec6fabaU, (uint64_t)0x000111f693ae5076U, (uint64_t)0x0003e3bfaa94ca90U,
+    (uint64_t)0x000445799476b887U, (uint64_t)0x00024a0912464879U, (uint64_t)0x0005d9fd15f8de7fU,
+    (uint64_t)0x00044d2aeed7521eU, (uint64_t)0x00050865d2c2a7e4U, (uint64_t)0x0002705b5238ea40U,
+    (uint64_t)0x00046c70b25d3b97U, (uint64_t)0x0003bc187fa47eb9U, (uint64_t)0x000408d36d63727fU,
+    (uint64_t)0x0005faf8f6a66062U, (uint64_t)0x0002bb892da8de6bU, (uint64_t)0x000769d4f0c7e2e6U,
+    (uint64_t)0x000332f35914f8fbU, (uint64_t)0x00070115ea86c20cU, (uint64_t)0x00016d88da24ada8U,
+    (uint64_t)0x0001980622662adfU, (uint64_t)0x000501ebbc195a9dU, (uint64_t)0x000450d81ce906fbU,
+    (uint64_t)0x0004d8961cae743fU, (uint64_t)0x0006bdc38c7dba0eU, (uint64_t)0x0007d3b4a7e1b463U,
+    (uint64_t)0x0000844bdee2adf3U, (uint64_t)0x0004cbad279663abU, (uint64_t)0x0003b6a1a6205275U,
+    (uint64_t)0x0002e82791d06dcfU, (uint64_t)0x00023d72caa93c87U, (uint64_t)0x0005f0b7ab68aaf4U,
+    (uint64_t)0x0002de25d4ba6345U, (uint64_t)0x00019024a0d71fcdU, (uint64_t)0x00015f65115f101aU,
+    (uint64_t)0x0004e99067149708U, (uint64_t)0x000119d8d1cba5afU, (uint64_t)0x0007d7fbcefe2007U,
+    (uint64_t)0x00045dc5f3c29094U, (uint64_t)0x0003455220b579afU, (uint64_t)0x000070c1631e068aU,
+    (uint64_t)0x00026bc0630e9b21U, (uint64_t)0x0004f9cd196dcd8dU, (uint64_t)0x00071e6a266b2801U,
+    (uint64_t)0x00009aae73e2df5dU, (uint64_t)0x00040dd8b219b1a3U, (uint64_t)0x000546fb4517de0dU,
+    (uint64_t)0x0005975435e87b75U, (uint64_t)0x000297d86a7b3768U, (uint64_t)0x0004835a2f4c6332U,
+    (uint64_t)0x000070305f434160U, (uint64_t)0x000183dd014e56aeU, (uint64_t)0x0007ccdd084387a0U,
+    (uint64_t)0x000484186760cc93U, (uint64_t)0x0007435665533361U, (uint64_t)0x00002f686336b801U,
+    (uint64_t)0x0005225446f64331U, (uint64_t)0x0003593ca848190cU, (uint64_t)0x0006422c6d260417U,
+    (uint64_t)0x000212904817bb94U, (uint64_t)0x0005a319deb854f5U, (uint64_t)0x0007a9d4e060da7dU,
+    (uint64_t)0x000428bd0ed61d0cU, (uint64_t)0x0003189a5e849aa7U, (uint64_t)0x0006acbb1f59b242U,
+    (uint64_t)0x0007f6ef4753630cU, (uint64_t)0x0001f346292a2da9U, (uint64_t)0x00027398308da2d6U,
+    (uint64_t)0x00010e4c0a702453U, (uint64_t)0x0004daafa37bd734U, (uint64_t)0x00049f6bdc3e8961U,
+    (uint64_t)0x0001feffdcecdae6U, (uint64_t)0x000572c2945492c3U, (uint64_t)0x00038d28435ed413U,
+    (uint64_t)0x0004064f19992858U, (uint64_t)0x0007680fbef543cdU, (uint64_t)0x0001aadd83d58d3cU,
+    (uint64_t)0x000269597aebe8c3U, (uint64_t)0x0007c745d6cd30beU, (uint64_t)0x00027c7755df78efU,
+    (uint64_t)0x0001776833937fa3U, (uint64_t)0x0005405116441855U, (uint64_t)0x0007f985498c05bcU,
+    (uint64_t)0x000615520fbf6363U, (uint64_t)0x0000b9e9bf74da6aU, (uint64_t)0x0004fe8308201169U,
+    (uint64_t)0x000173f76127de43U, (uint64_t)0x00030f2653cd69b1U, (uint64_t)0x0001ce889f0be117U,
+    (uint64_t)0x00036f6a94510709U, (uint64_t)0x0007f248720016b4U, (uint64_t)0x0001821ed1e1cf91U,
+    (uint64_t)0x00076c2ec470a31fU, (uint64_t)0x0000c938aac10c85U, (uint64_t)0x00041b64ed797141U,
+    (uint64_t)0x0001beb1c1185e6dU, (uint64_t)0x0001ed5490600f07U, (uint64_t)0x0002f1273f159647U,
+    (uint64_t)0x00008bd755a70bc0U, (uint64_t)0x00049e3a885ce609U, (uint64_t)0x00016585881b5ad6U,
+    (uint64_t)0x0003c27568d34f5eU, (uint64_t)0x00038ac1997edc5fU, (uint64_t)0x0001fc7c8ae01e11U,
+    (uint64_t)0x0002094d5573e8e7U, (uint64_t)0x0005ca3cbbf549d2U, (uint64_t)0x0004f920ecc54143U,
+    (uint64_t)0x0005d9e572ad85b6U, (uint64_t)0x0006b517a751b13bU, (uint64_t)0x0000cfd370b180ccU,
+    (uint64_t)0x0005377925d1f41aU, (uint64_t)0x00034e56566008a2U, (uint64_t)0x00022dfcd9cbfe9eU,
+    (uint64_t)0x000459b4103be0a1U, (uint64_t)0x00059a4b3f2d2addU, (uint64_t)0x0007d734c8bb8eebU,
+    (uint64_t)0x0002393cbe594a09U, (uint64_t)0x0000fe9877824cdeU, (uint64_t)0x0003d2e0c30d0cd9U,
+    (uint64_t)0x0003f597686671bbU, (uint64_t)0x0000aa587eb63999U, (uint64_t)0x0000e3c7b592c619U,
+    (uint64_t)0x0006b2916c05448cU, (uint64_t)0x000334d10aba913bU, (uint64_t)0x000045cdb581cfdbU,
+    (uint64_t)0x0005e3e0553a8f36U, (uint64_t)0x00050bb3041effb2U, (uint64_t)0x0004c303f307ff00U,
+    (uint64_t)0x000403580dd94500U, (uint64_t)0x00048df77d92653fU, (uint64_t)0x00038a9fe3b349eaU,
+    (uint64_t)0x0000ea89850aafe1U, (uint64_t)0x000416b151ab706aU, (uint64_t)0x00023bd617b28c85U,
+    (uint64_t)0x0006e72ee77d5a61U, (uint64_t)0x0001a972ff174ddeU, (uint64_t)0x0003e2636373c60fU,
+    (uint64_t)0x0000d61b8f78b2abU, (uint64_t)0x0000d7efe9c136b0U, (uint64_t)0x0001ab1c89640ad5U,
+    (uint64_t)0x00055f82aef41f97U, (uint64_t)0x00046957f317ed0dU, (uint64_t)0x000191a2af74277eU,
+    (uint64_t)0x00062b434f460efbU, (uint64_t)0x000294c6c0fad3fcU, (uint64_t)0x00068368937b4c0fU,
+    (uint64_t)0x0005c9f82910875bU, (uint64_t)0x000237e7dbe00545U, (uint64_t)0x0006f74bc53c1431U,
+    (uint64_t)0x0001c40e5dbbd9c2U, (uint64_t)0x0006c8fb9cae5c97U, (uint64_t)0x0004845c5ce1b7daU,
+    (uint64_t)0x0007e2e0e450b5ccU, (uint64_t)0x000575ed6701b430U, (uint64_t)0x0004d3e17fa20026U,
+    (uint64_t)0x000791fc888c4253U, (uint64_t)0x0002f1ba99078ac1U, (uint64_t)0x00071afa699b1115U,
+    (uint64_t)0x00023c1c473b50d6U, (uint64_t)0x0003e7671de21d48U, (uint64_t)0x000326fa5547a1e8U,
+    (uint64_t)0x00050e4dc25fafd9U, (uint64_t)0x00000731fbc78f89U, (uint64_t)0x00066f9b3953b61dU,
+    (uint64_t)0x000555f4283cccb9U, (uint64_t)0x0007dd67fb1960e7U, (uint64_t)0x00014707a1affed4U,
+    (uint64_t)0x000021142e9c2b1cU, (uint64_t)0x0000c71848f81880U, (uint64_t)0x00044bd9d8233c86U,
+    (uint64_t)0x0006e8578efe5830U, (uint64_t)0x0004045b6d7041b5U, (uint64_t)0x0004c4d6f3347e15U,
+    (uint64_t)0x0004ddfc988f1970U, (uint64_t)0x0004f6173ea365e1U, (uint64_t)0x000645daf9ae4588U,
+    (uint64_t)0x0007d43763db623bU, (uint64_t)0x00038bf9500a88f9U, (uint64_t)0x0007eccfc17d1fc9U,
+    (uint64_t)0x0004ca280782831eU, (uint64_t)0x0007b8337db1d7d6U, (uint64_t)0x0005116def3895fbU,
+    (uint64_t)0x000193fddaaa7e47U, (uint64_t)0x0002c93c37e8876fU, (uint64_t)0x0003431a28c583faU,
+    (uint64_t)0x00049049da8bd879U, (uint64_t)0x0004b4a8407ac11cU, (uint64_t)0x0006a6fb99ebf0d4U,
+    (uint64_t)0x000122b5b6e423c6U, (uint64_t)0x00021e50dff1ddd6U, (uint64_t)0x00073d76324e75c0U,
+    (uint64_t)0x000588485495418eU, (uint64_t)0x000136fda9f42c5eU, (uint64_t)0x0006c1bb560855ebU,
+    (uint64_t)0x00071f127e13ad48U, (uint64_t)0x0005c6b304905aecU, (uint64_t)0x0003756b8e889bc7U,
+    (uint64_t)0x00075f76914a3189U, (uint64_t)0x0004dfb1a305bdd1U, (uint64_t)0x0003b3ff05811f29U,
+    (uint64_t)0x0006ed62283cd92eU, (uint64_t)0x00065d1543ec52e1U, (uint64_t)0x000022183510be8dU,
+    (uint64_t)0x0002710143307a7fU, (uint64_t)0x0003d88fb48bf3abU, (uint64_t)0x000249eb4ec18f7aU,
+    (uint64_t)0x000136115dff295fU, (uint64_t)0x0001387c441fd404U, (uint64_t)0x000766385ead2d14U,
+    (uint64_t)0x0000194f8b06095eU, (uint64_t)0x00008478f6823b62U, (uint64_t)0x0006018689d37308U,
+    (uint64_t)0x0006a071ce17b806U, (uint64_t)0x0003c3d187978af8U, (uint64_t)0x0007afe1c88276baU,
+    (uint64_t)0x00051df281c8ad68U, (uint64_t)0x00064906bda4245dU, (uint64_t)0x0003171b26aaf1edU,
+    (uint64_t)0x0005b7d8b28a47d1U, (uint64_t)0x0002c2ee149e34c1U, (uint64_t)0x000776f5629afc53U,
+    (uint64_t)0x0001f4ea50fc49a9U, (uint64_t)0x0006c514a6334424U, (uint64_t)0x0007319097564ca8U,
+    (uint64_t)0x0001844ebc233525U, (uint64_t)0x00021d4543fdeee1U, (uint64_t)0x0001ad27aaff1bd2U,
+    (uint64_t)0x000221fd4873cf08U, (uint64_t)0x0002204f3a156341U, (uint64_t)0x000537414065a464U,
+    (uint64_t)0x00043c0c3bedcf83U, (uint64_t)0x0005557e706ea620U, (uint64_t)0x00048daa596fb924U,
+    (uint64_t)0x00061d5dc84c9793U, (uint64_t)0x00047de83040c29eU, (uint64_t)0x000189deb26507e7U,
+    (uint64_t)0x0004d4e6fadc479aU, (uint64_t)0x00058c837fa0e8a7U, (uint64_t)0x00028e665ca59cc7U,
+    (uint64_t)0x000165c715940dd9U, (uint64_t)0x0000785f3aa11c95U, (uint64_t)0x00057b98d7e38469U,
+    (uint64_t)0x000676dd6fccad84U, (uint64_t)0x0001688596fc9058U, (uint64_t)0x00066f6ad403619fU,
+    (uint64_t)0x0004d759a87772efU, (uint64_t)0x0007856e6173bea4U, (uint64_t)0x0001c4f73f2c6a57U,
+    (uint64_t)0x0006706efc7c3484U, (uint64_t)0x0006987839ec366dU, (uint64_t)0x0000731f95cf7f26U,
+    (uint64_t)0x0003ae758ebce4bcU, (uint64_t)0x00070459adb7daf6U, (uint64_t)0x00024fbd305fa0bbU,
+    (uint64_t)0x00040a98cc75a1cfU, (uint64_t)0x00078ce1220a7533U, (uint64_t)0x0006217a10e1c197U,
+    (uint64_t)0x000795ac80d1bf64U, (uint64_t)0x0001db4991b42bb3U, (uint64_t)0x000469605b994372U,
+    (uint64_t)0x000631e3715c9a58U, (uint64_t)0x0007e9cfefcf728fU, (uint64_t)0x0005fe162848ce21U,
+    (uint64_t)0x0001852d5d7cb208U, (uint64_t)0x00060d0fbe5ce50fU, (uint64_t)0x0005a1e246e37b75U,
+    (uint64_t)0x00051aee05ffd590U, (uint64_t)0x0002b44c043677daU, (uint64_t)0x0001214fe194961aU,
+    (uint64_t)0x0000e1ae39a9e9cbU, (uint64_t)0x000543c8b526f9f7U, (uint64_t)0x000119498067e91dU,
+    (uint64_t)0x0004789d446fc917U, (uint64_t)0x000487ab074eb78eU, (uint64_t)0x0001d33b5e8ce343U,
+    (uint64_t)0x00013e419feb1b46U, (uint64_t)0x0002721f565de6a4U, (uint64_t)0x00060c52eef2bb9aU,
+    (uint64_t)0x0003c5c27cae6d11U, (uint64_t)0x00036a9491956e05U, (uint64_t)0x000124bac9131da6U,
+    (uint64_t)0x0003b6f7de202b5dU, (uint64_t)0x00070d77248d9b66U, (uint64_t)0x000589bc3bfd8bf1U,
+    (uint64_t)0x0006f93e6aa3416bU, (uint64_t)0x0004c0a3d6c1ae48U, (uint64_t)0x00055587260b586aU,
+    (uint64_t)0x00010bc9c312ccfcU, (uint64_t)0x0002e84b3ec2a05bU, (uint64_t)0x00069da2f03c1551U,
+    (uint64_t)0x00023a174661a67bU, (uint64_t)0x000209bca289f238U, (uint64_t)0x00063755bd3a976fU,
+    (uint64_t)0x0007101897f1acb7U, (uint64_t)0x0003d82cb77b07b8U, (uint64_t)0x000684083d7769f5U,
+    (uint64_t)0x00052b28472dce07U, (uint64_t)0x0002763751737c52U, (uint64_t)0x0007a03e2ad10853U,
+    (uint64_t)0x000213dcc6ad36abU, (uint64_t)0x0001a6e240d5bdd6U, (uint64_t)0x0007c24ffcf8fedfU,
+    (uint64_t)0x0000d8cc1c48bc16U, (uint64_t)0x000402d36eb419a9U, (uint64_t)0x0007cef68c14a052U,
+    (uint64_t)0x0000f1255bc2d139U, (uint64_t)0x000373e7d431186aU, (uint64_t)0x00070c2dd8a7ad16U,
+    (uint64_t)0x0004967db8ed7e13U, (uint64_t)0x00015aeed02f523aU, (uint64_t)0x0006149591d094bcU,
+    (uint64_t)0x000672f204c17006U, (uint64_t)0x00032b8613816a53U, (uint64_t)0x000194509f6fec0eU,
+    (uint64_t)0x000528d8ca31acacU, (uint64_t)0x0007826d73b8b9faU, (uint64_t)0x00024acb99e0f9b3U,
+    (uint64_t)0x0002e0fac6363948U, (uint64_t)0x0007f7bee448cd64U, (uint64_t)0x0004e10f10da0f3cU,
+    (uint64_t)0x0003936cb9ab20e9U, (uint64_t)0x0007a0fc4fea6cd0U, (uint64_t)0x0004179215c735a4U,
+    (uint64_t)0x000633b9286bcd34U, (uint64_t)0x0006cab3badb9c95U, (uint64_t)0x00074e387edfbdfaU,
+    (uint64_t)0x00014313c58a0fd9U, (uint64_t)0x00031fa85662241cU, (uint64_t)0x000094e7d7dced2aU,
+    (uint64_t)0x000068fa738e118eU, (uint64_t)0x00041b640a5fee2bU, (uint64_t)0x0006bb709df019d4U,
+    (uint64_t)0x000700344a30cd99U, (uint64_t)0x00026c422e3622f4U, (uint64_t)0x0000f3066a05b5f0U,
+    (uint64_t)0x0004e2448f0480a6U, (uint64_t)0x000244cde0dbf095U, (uint64_t)0x00024bb2312a9952U,
+    (uint64_t)0x00000c2af5f85c6bU, (uint64_t)0x0000609f4cf2883fU, (uint64_t)0x0006e86eb5a1ca13U,
+    (uint64_t)0x00068b44a2efccd1U, (uint64_t)0x0000d1d2af9ffeb5U, (uint64_t)0x0000ed1732de67c3U,
+    (uint64_t)0x000308c369291635U, (uint64_t)0x00033ef348f2d250U, (uint64_t)0x000004475ea1a1bbU,
+    (uint64_t)0x0000fee3e871e188U, (uint64_t)0x00028aa132621edfU, (uint64_t)0x00042b244caf353bU,
+    (uint64_t)0x00066b064cc2e08aU, (uint64_t)0x0006bb20020cbdd3U, (uint64_t)0x00016acd79718531U,
+    (uint64_t)0x0001c6c57887b6adU, (uint64_t)0x0005abf21fd7592bU, (uint64_t)0x00050bd41253867aU,
+    (uint64_t)0x0003800b71273151U, (uint64_t)0x000164ed34b18161U, (uint64_t)0x000772af2d9b1d3dU,
+    (uint64_t)0x0006d486448b4e5bU, (uint64_t)0x0002ce58dd8d18a8U, (uint64_t)0x0001849f67503c8bU,
+    (uint64_t)0x000123e0ef6b9302U, (uint64_t)0x0006d94c192fe69aU, (uint64_t)0x0005475222a2690fU,
+    (uint64_t)0x000693789d86b8b3U, (uint64_t)0x0001f5c3bdfb69dcU, (uint64_t)0x00078da0fc61073fU,
+    (uint64_t)0x000780f1680c3a94U, (uint64_t)0x0002a35d3cfcd453U, (uint64_t)0x000005e5cdc7ddf8U,
+    (uint64_t)0x0006ee888078ac24U, (uint64_t)0x000054aa4b316b38U, (uint64_t)0x00015d28e52bc66aU,
+    (uint64_t)0x00030e1e0351cb7eU, (uint64_t)0x00030a2f74b11f8cU, (uint64_t)0x00039d120cd7de03U,
+    (uint64_t)0x0002d25deeb256b1U, (uint64_t)0x0000468d19267cb8U, (uint64_t)0x00038cdca9b5fbf9U,
+    (uint64_t)0x0001bbb05c2ca1e2U, (uint64_t)0x0003b015758e9533U, (uint64_t)0x000134610a6ab7daU,
+    (uint64_t)0x000265e777d1f515U, (uint64_t)0x0000f1f54c1e39a5U, (uint64_t)0x0002f01b95522646U,
+    (uint64_t)0x0004fdd8db9dde6dU, (uint64_t)0x000654878cba97ccU, (uint64_t)0x00038ec78df6b0feU,
+    (uint64_t)0x00013caebea36a22U, (uint64_t)0x0005ebc6e54e5f6aU, (uint64_t)0x00032804903d0eb8U,
+    (uint64_t)0x0002102fdba2b20dU, (uint64_t)0x0006e405055ce6a1U, (uint64_t)0x0005024a35a532d3U,
+    (uint64_t)0x0001f69054daf29dU, (uint64_t)0x00015d1d0d7a8bd5U, (uint64_t)0x0000ad725db29ecbU,
+    (uint64_t)0x0007bc0c9b056f85U, (uint64_t)0x00051cfebffaffd8U, (uint64_t)0x00044abbe94df549U,
+    (uint64_t)0x0007ecbbd7e33121U, (uint64_t)0x0004f675f5302399U, (uint64_t)0x000267b1834e2457U,
+    (uint64_t)0x0006ae19c378bb88U, (uint64_t)0x0007457b5ed9d512U, (uint64_t)0x0003280d783d05fbU,
+    (uint64_t)0x0004aefcffb71a03U, (uint64_t)0x000536360415171eU, (uint64_t)0x0002313309077865U,
+    (uint64_t)0x000251444334afbcU, (uint64_t)0x0002b0c3853756e8U, (uint64_t)0x0000bccbb72a2a86U,
+    (uint64_t)0x00055e4c50fe1296U, (uint64_t)0x00005fdd13efc30dU, (uint64_t)0x0001c0c6c380e5eeU,
+    (uint64_t)0x0003e11de3fb62a8U, (uint64_t)0x0006678fd69108f3U, (uint64_t)0x0006962feab1a9c8U,
+    (uint64_t)0x0006aca28fb9a30bU, (uint64_t)0x00056db7ca1b9f98U, (uint64_t)0x00039f58497018ddU,
+    (uint64_t)0x0004024f0ab59d6bU, (uint64_t)0x0006fa31636863c2U, (uint64_t)0x00010ae5a67e42b0U,
+    (uint64_t)0x00027abbf01fda31U, (uint64_t)0x000380a7b9e64fbcU, (uint64_t)0x0002d42e2108ead4U,
+    (uint64_t)0x00017b0d0f537593U, (uint64_t)0x00016263c0c9842eU, (uint64_t)0x0004ab827e4539a4U,
+    (uint64_t)0x0006370ddb43d73aU, (uint64_t)0x000420bf3a79b423U, (uint64_t)0x0005131594dfd29bU,
+    (uint64_t)0x0003a627e98d52feU, (uint64_t)0x0001154041855661U, (uint64_t)0x00019175d09f8384U,
+    (uint64_t)0x000676b2608b8d2dU, (uint64_t)0x0000ba651c5b2b47U, (uint64_t)0x0005862363701027U,
+    (uint64_t)0x0000c4d6c219c6dbU, (uint64_t)0x0000f03dff8658deU, (uint64_t)0x000745d2ffa9c0cfU,
+    (uint64_t)0x0006df5721d34e6aU, (uint64_t)0x0004f32f767a0c06U, (uint64_t)0x0001d5abeac76e20U,
+    (uint64_t)0x00041ce9e104e1e4U, (uint64_t)0x00006e15be54c1dcU, (uint64_t)0x00025a1e2bc9c8bdU,
+    (uint64_t)0x000104c8f3b037eaU, (uint64_t)0x000405576fa96c98U, (uint64_t)0x0002e86a88e3876fU,
+    (uint64_t)0x0001ae23ceb960cfU, (uint64_t)0x00025d871932994aU, (uint64_t)0x0006b9d63b560b6eU,
+    (uint64_t)0x0002df2814c8d472U, (uint64_t)0x0000fbbee20aa4edU, (uint64_t)0x00058ded861278ecU,
+    (uint64_t)0x00035ba8b6c2c9a8U, (uint64_t)0x0001dea58b3185bfU, (uint64_t)0x0004b455cd23bbbeU,
+    (uint64_t)0x0005ec19c04883f8U, (uint64_t)0x00008ba696b531d5U, (uint64_t)0x00073793f266c55cU,
+    (uint64_t)0x0000b988a9c93b02U, (uint64_t)0x00009b0ea32325dbU, (uint64_t)0x00037cae71c17c5eU,
+    (uint64_t)0x0002ff39de85485fU, (uint64_t)0x00053eeec3efc57aU, (uint64_t)0x0002fa9fe9022efdU,
+    (uint64_t)0x000699c72c138154U, (uint64_t)0x00072a751ebd1ff8U, (uint64_t)0x000120633b4947cfU,
+    (uint64_t)0x000531474912100aU, (uint64_t)0x0005afcdf7c0d057U, (uint64_t)0x0007a9e71b788dedU,
+    (uint64_t)0x0005ef708f3b0c88U, (uint64_t)0x00007433be3cb393U, (uint64_t)0x0004987891610042U,
+    (uint64_t)0x00079d9d7f5d0172U, (uint64_t)0x0003c293013b9ec4U, (uint64_t)0x0000c2b85f39cacaU,
+    (uint64_t)0x00035d30a99b4d59U, (uint64_t)0x000144c05ce997f4U, (uint64_t)0x0004960b8a347fefU,
+    (uint64_t)0x0001da11f15d74f7U, (uint64_t)0x00054fac19c0feadU, (uint64_t)0x0002d873ede7af6dU,
+    (uint64_t)0x000202e14e5df981U, (uint64_t)0x0002ea02bc3eb54cU, (uint64_t)0x00038875b2883564U,
+    (uint64_t)0x0001298c513ae9ddU, (uint64_t)0x0000543618a01600U, (uint64_t)0x0002316443373409U,
+    (uint64_t)0x0005de95503b22afU, (uint64_t)0x000699201beae2dfU, (uint64_t)0x0003db5849ff737aU,
+    (uint64_t)0x0002e773654707faU, (uint64_t)0x0002bdf4974c23c1U, (uint64_t)0x0004b3b9c8d261bdU,
+    (uint64_t)0x00026ae8b2a9bc28U, (uint64_t)0x0003068210165c51U, (uint64_t)0x0004b1443362d079U,
+    (uint64_t)0x000454e91c529ccbU, (uint64_t)0x00024c98c6bf72cfU, (uint64_t)0x0000486594c3d89aU,
+    (uint64_t)0x0007ae13a3d7fa3cU, (uint64_t)0x00017038418eaf66U, (uint64_t)0x0004b7c7b66e1f7aU,
+    (uint64_t)0x0004bea185efd998U, (uint64_t)0x0004fabc711055f8U, (uint64_t)0x0001fb9f7836fe38U,
+    (uint64_t)0x000582f446752da6U, (uint64_t)0x00017bd320324ce4U, (uint64_t)0x00051489117898c6U,
+    (uint64_t)0x0001684d92a0410bU, (uint64_t)0x0006e4d90f78c5a7U, (uint64_t)0x0000c2a1c4bcda28U,
+    (uint64_t)0x0004814869bd6945U, (uint64_t)0x0007b7c391a45db8U, (uint64_t)0x00057316ac35b641U,
+    (uint64_t)0x000641e31de9096aU, (uint64_t)0x0005a6a9b30a314dU, (uint64_t)0x0005c7d06f1f0447U,
+    (uint64_t)0x0007db70f80b3a49U, (uint64_t)0x0006cb4a3ec89a78U, (uint64_t)0x00043be8ad81397dU,
+    (uint64_t)0x0007c558bd1c6f64U, (uint64_t)0x00041524d396463dU, (uint64_t)0x0001586b449e1a1dU,
+    (uint64_t)0x0002f17e904aed8aU, (uint64_t)0x0007e1d2861d3c8eU, (uint64_t)0x0000404a5ca0afbaU,
+    (uint64_t)0x00049e1b2a416fd1U, (uint64_t)0x00051c6a0b316c57U, (uint64_t)0x000575a59ed71bdcU,
+    (uint64_t)0x00074c021a1fec1eU, (uint64_t)0x00039527516e7f8eU, (uint64_t)0x000740070aa743d6U,
+    (uint64_t)0x00016b64cbdd1183U, (uint64_t)0x00023f4b7b32eb43U, (uint64_t)0x000319aba58235b3U,
+    (uint64_t)0x00046395bfdcadd9U, (uint64_t)0x0007db2d1a5d9a9cU, (uint64_t)0x00079a200b85422fU,
+    (uint64_t)0x000355bfaa71dd16U, (uint64_t)0x00000b77ea5f78aaU, (uint64_t)0x00076579a29e822dU,
+    (uint64_t)0x0004b51352b434f2U, (uint64_t)0x0001327bd01c2667U, (uint64_t)0x000434d73b60c8a1U,
+    (uint64_t)0x0003e0daa89443baU, (uint64_t)0x00002c514bb2a277U, (uint64_t)0x00068e7e49c02a17U,
+    (uint64_t)0x00045795346fe8b6U, (uint64_t)0x000089306c8f3546U, (uint64_t)0x0006d89f6b2f88f6U,
+    (uint64_t)0x00043a384dc9e05bU, (uint64_t)0x0003d5da8bf1b645U, (uint64_t)0x0007ded6a96a6d09U,
+    (uint64_t)0x0006c3494fee2f4dU, (uint64_t)0x00002c989c8b6bd4U, (uint64_t)0x0001160920961548U,
+    (uint64_t)0x00005616369b4dcdU, (uint64_t)0x0004ecab86ac6f47U, (uint64_t)0x0003c60085d700b2U,
+    (uint64_t)0x0000213ee10dfceaU, (uint64_t)0x0002f637d7491e6eU, (uint64_t)0x0005166929dacfaaU,
+    (uint64_t)0x000190826b31f689U, (uint64_t)0x0004f55567694a7dU, (uint64_t)0x000705f4f7b1e522U,
+    (uint64_t)0x000351e125bc5698U, (uint64_t)0x00049b461af67bbeU, (uint64_t)0x00075915712c3a96U,
+    (uint64_t)0x00069a67ef580c0dU, (uint64_t)0x00054d38ef70cffcU, (uint64_t)0x0007f182d06e7ce2U,
+    (uint64_t)0x00054b728e217522U, (uint64_t)0x00069a90971b0128U, (uint64_t)0x00051a40f2a963a3U,
+    (uint64_t)0x00010be9ac12a6bfU, (uint64_t)0x00044acc043241c5U, (uint64_t)0x00048e64ab0168ecU,
+    (uint64_t)0x0002a2bdb8a86f4fU, (uint64_t)0x0007343b6b2d6929U, (uint64_t)0x0001d804aa8ce9a3U,
+    (uint64_t)0x00067d4ac8c343e9U, (uint64_t)0x00056bbb4f7a5777U, (uint64_t)0x00029230627c238fU,
+    (uint64_t)0x0005ad1a122cd7fbU, (uint64_t)0x0000dea56e50e364U, (uint64_t)0x000556d1c8312ad7U,
+    (uint64_t)0x00006756b11be821U, (uint64_t)0x000462147e7bb03eU, (uint64_t)0x00026519743ebfe0U,
+    (uint64_t)0x000782fc59682ab5U, (uint64_t)0x000097abe38cc8c7U, (uint64_t)0x000740e30c8d3982U,
+    (uint64_t)0x0007c2b47f4682fdU, (uint64_t)0x0005cd91b8c7dc1cU, (uint64_t)0x00077fa790f9e583U,
+    (uint64_t)0x000746c6c6d1d824U, (uint64_t)0x0001c9877ea52da4U, (uint64_t)0x0002b37b83a86189U,
+    (uint64_t)0x000733af49310da5U, (uint64_t)0x00025e81161c04fbU, (uint64_t)0x000577e14a34bee8U,
+    (uint64_t)0x0006cebebd4dd72bU, (uint64_t)0x000340c1e442329fU, (uint64_t)0x00032347ffd1a93fU,
+    (uint64_t)0x00014a89252cbbe0U, (uint64_t)0x000705304b8fb009U, (uint64_t)0x000268ac61a73b0aU,
+    (uint64_t)0x000206f234bebe1cU, (uint64_t)0x0005b403a7cbebe8U, (uint64_t)0x0007a160f09f4135U,
+    (uint64_t)0x00060fa7ee96fd78U, (uint64_t)0x00051d354d296ec6U, (uint64_t)0x0007cbf5a63b16c7U,
+    (uint64_t)0x0002f50bb3cf0c14U, (uint64_t)0x0001feb385cac65aU, (uint64_t)0x00021398e0ca1635U,
+    (uint64_t)0x0000aaf9b4b75601U, (uint64_t)0x00026b91b5ae44f3U, (uint64_t)0x0006de808d7ab1c8U,
+    (uint64_t)0x0006a769675530b0U, (uint64_t)0x0001bbfb284e98f7U, (uint64_t)0x0005058a382b33f3U,
+    (uint64_t)0x000175a91816913eU, (uint64_t)0x0004f6cdb96b8ae8U, (uint64_t)0x00017347c9da81d2U,
+    (uint64_t)0x0005aa3ed9d95a23U, (uint64_t)0x000777e9c7d96561U, (uint64_t)0x00028e58f006ccacU,
+    (uint64_t)0x000541bbbb2cac49U, (uint64_t)0x0003e63282994cecU, (uint64_t)0x0004a07e14e5e895U,
+    (uint64_t)0x000358cdc477a49bU, (uint64_t)0x0003cc88fe02e481U, (uint64_t)0x000721aab7f4e36bU,
+    (uint64_t)0x0000408cc9469953U, (uint64_t)0x00050af7aed84afaU, (uint64_t)0x000412cb980df999U,
+    (uint64_t)0x0005e78dd8ee29dcU, (uint64_t)0x000171dff68c575dU, (uint64_t)0x0002015dd2f6ef49U,
+    (uint64_t)0x0003f0bac391d313U, (uint64_t)0x0007de0115f65be5U, (uint64_t)0x0004242c21364dc9U,
+    (uint64_t)0x0006b75b64a66098U, (uint64_t)0x0000033c0102c085U, (uint64_t)0x0001921a316baebdU,
+    (uint64_t)0x0002ad9ad9f3c18bU, (uint64_t)0x0005ec1638339aebU, (uint64_t)0x0005703b6559a83bU,
+    (uint64_t)0x0003fa9f4d05d612U, (uint64_t)0x0007b049deca062cU, (uint64_t)0x00022f7edfb870fcU,
+    (uint64_t)0x000569eed677b128U, (uint64_t)0x00030937dcb0a5afU, (uint64_t)0x000758039c78ea1bU,
+    (uint64_t)0x0006458df41e273aU, (uint64_t)0x0003e37a35444483U, (uint64_t)0x000661fdb7d27b99U,
+    (uint64_t)0x000317761dd621e4U, (uint64_t)0x0007323c30026189U, (uint64_t)0x0006093dccbc2950U,
+    (uint64_t)0x0006eebe6084034bU, (uint64_t)0x0006cf01f70a8d7bU, (uint64_t)0x0000b41a54c6670aU,
+    (uint64_t)0x0006c84b99bb55dbU, (uint64_t)0x0006e3180c98b647U, (uint64_t)0x00039a8585e0706dU,
+    (uint64_t)0x0003167ce72663feU, (uint64_t)0x00063d14ecdb4297U, (uint64_t)0x0004be21dcf970b8U,
+    (uint64_t)0x00057d1ea084827aU, (uint64_t)0x0002b6e7a128b071U, (uint64_t)0x0005b27511755dcfU,
+    (uint64_t)0x00008584c2930565U, (uint64_t)0x00068c7bda6f4159U, (uint64_t)0x000363e999ddd97bU,
+    (uint64_t)0x000048dce24baec6U, (uint64_t)0x0002b75795ec05e3U, (uint64_t)0x0003bfa4c5da6dc9U,
+    (uint64_t)0x0001aac8659e371eU, (uint64_t)0x000231f979bc6f9bU, (uint64_t)0x000043c135ee1fc4U,
+    (uint64_t)0x0002a11c9919f2d5U, (uint64_t)0x0006334cc25dbacdU, (uint64_t)0x000295da17b400daU,
+    (uint64_t)0x00048ee9b78693a0U, (uint64_t)0x0001de4bcc2af3c6U, (uint64_t)0x00061fc411a3eb86U,
+    (uint64_t)0x00053ed19ac12ec0U, (uint64_t)0x000209dbc6b804e0U, (uint64_t)0x000079bfa9b08792U,
+    (uint64_t)0x0001ed80a2d54245U, (uint64_t)0x00070efec72a5e79U, (uint64_t)0x00042151d42a822dU,
+    (uint64_t)0x0001b5ebb6d631e8U, (uint64_t)0x0001ef4fb1594706U, (uint64_t)0x00003a51da300df4U,
+    (uint64_t)0x000467b52b561c72U, (uint64_t)0x0004d5920210e590U, (uint64_t)0x0000ca769e789685U,
+    (uint64_t)0x000038c77f684817U, (uint64_t)0x00065ee65b167becU, (uint64_t)0x000052da19b850a9U,
+    (uint64_t)0x0000408665656429U, (uint64_t)0x0007ab39596f9a4cU, (uint64_t)0x000575ee92a4a0bfU,
+    (uint64_t)0x0006bc450aa4d801U, (uint64_t)0x0004f4a6773b0ba8U, (uint64_t)0x0006241b0b0ebc48U,
+    (uint64_t)0x00040d9c4f1d9315U, (uint64_t)0x000200a1e7e382f5U, (uint64_t)0x000080908a182fcfU,
+    (uint64_t)0x0000532913b7ba98U, (uint64_t)0x0003dccf78c385c3U, (uint64_t)0x00068002dd5eaba9U,
+    (uint64_t)0x00043d4e7112cd3fU, (uint64_t)0x0005b967eaf93ac5U, (uint64_t)0x000360acca580a31U,
+    (uint64_t)0x0001c65fd5c6f262U, (uint64_t)0x00071c7f15c2ecabU, (uint64_t)0x000050eca52651e4U,
+    (uint64_t)0x0004397660e668eaU, (uint64_t)0x0007c2a75692f2f5U, (uint64_t)0x0003b29e7e6c66efU,
+    (uint64_t)0x00072ba658bcda9aU, (uint64_t)0x0006151c09fa131aU, (uint64_t)0x00031ade453f0c9cU,
+    (uint64_t)0x0003dfee07737868U, (uint64_t)0x000611ecf7a7d411U, (uint64_t)0x0002637e6cbd64f6U,
+    (uint64_t)0x0004b0ee6c21c58fU, (uint64_t)0x00055c0dfdf05d96U, (uint64_t)0x000405569dcf475eU,
+    (uint64_t)0x00005c5c277498bbU, (uint64_t)0x00018588d95dc389U, (uint64_t)0x0001fef24fa800f0U,
+    (uint64_t)0x0002aff530976b86U, (uint64_t)0x0000d85a48c0845aU, (uint64_t)0x000796eb963642e0U,
+    (uint64_t)0x00060bee50c4b626U, (uint64_t)0x00028005fe6c8340U, (uint64_t)0x000653fb1aa73196U,
+    (uint64_t)0x000607faec8306faU, (uint64_t)0x0004e85ec83e5254U, (uint64_t)0x00009f56900584fdU,
+    (uint64_t)0x000544d49292fc86U, (uint64_t)0x0007ba9f34528688U, (uint64_t)0x000284a20fb42d5dU,
+    (uint64_t)0x0003652cd9706ffeU, (uint64_t)0x0006fd7baddde6b3U, (uint64_t)0x00072e472930f316U,
+    (uint64_t)0x0003f635d32a7627U, (uint64_t)0x0000cbecacde00feU, (uint64_t)0x0003411141eaa936U,
+    (uint64_t)0x00021c1e42f3cb94U, (uint64_t)0x0001fee7f000fe06U, (uint64_t)0x0005208c9781084fU,
+    (uint64_t)0x00016468a1dc24d2U, (uint64_t)0x0007bf780ac540a8U, (uint64_t)0x0001a67eced75301U,
+    (uint64_t)0x0005a9d2e8c2733aU, (uint64_t)0x000305da03dbf7e5U, (uint64_t)0x0001228699b7aecaU,
+    (uint64_t)0x00012a23b2936bc9U, (uint64_t)0x0002a1bda56ae6e9U, (uint64_t)0x00000f94051ee040U,
+    (uint64_t)0x000793bb07af9753U, (uint64_t)0x0001e7b6ecd4fafdU, (uint64_t)0x00002c7b1560fb43U,
+    (uint64_t)0x0002296734cc5fb7U, (uint64_t)0x00047b7ffd25dd40U, (uint64_t)0x00056b23c3d330b2U,
+    (uint64_t)0x00037608e360d1a6U, (uint64_t)0x00010ae0f3c8722eU, (uint64_t)0x000086d9b618b637U,
+    (uint64_t)0x00007d79c7e8beabU, (uint64_t)0x0003fb9cbc08dd12U, (uint64_t)0x00075c3dd85370ffU,
+    (uint64_t)0x00047f06fe2819acU, (uint64_t)0x0005db06ab9215edU, (uint64_t)0x0001c3520a35ea64U,
+    (uint64_t)0x00006f40216bc059U, (uint64_t)0x0003a2579b0fd9b5U, (uint64_t)0x00071c26407eec8cU,
+    (uint64_t)0x00072ada4ab54f0bU, (uint64_t)0x00038750c3b66d12U, (uint64_t)0x000253a6bccba34aU,
+    (uint64_t)0x000427070433701aU, (uint64_t)0x00020b8e58f9870eU, (uint64_t)0x000337c861db00ccU,
+    (uint64_t)0x0001c3d05775d0eeU, (uint64_t)0x0006f1409422e51aU, (uint64_t)0x0007856bbece2d25U,
+    (uint64_t)0x00013380a72f031cU, (uint64_t)0x00043e1080a7f3baU, (uint64_t)0x0000621e2c7d3304U,
+    (uint64_t)0x00061796b0dbf0f3U, (uint64_t)0x00073c2f9c32d6f5U, (uint64_t)0x0006aa8ed1537ebeU,
+    (uint64_t)0x00074e92c91838f4U, (uint64_t)0x0005d8e589ca1002U, (uint64_t)0x000060cc8259838dU,
+    (uint64_t)0x000038d3f35b95f3U, (uint64_t)0x00056078c243a923U, (uint64_t)0x0002de3293241bb2U,
+    (uint64_t)0x0000007d6097bd3aU, (uint64_t)0x00071d950842a94bU, (uint64_t)0x00046b11e5c7d817U,
+    (uint64_t)0x0005478bbecb4f0dU, (uint64_t)0x0007c3054b0a1c5dU, (uint64_t)0x0001583d7783c1cbU,
+    (uint64_t)0x00034704cc9d28c7U, (uint64_t)0x0003dee598b1f200U, (uint64_t)0x00016e1c98746d9eU,
+    (uint64_t)0x0004050b7095afdfU, (uint64_t)0x0004958064e83c55U, (uint64_t)0x0006a2ef5da27ae1U,
+    (uint64_t)0x00028aace02e9d9dU, (uint64_t)0x00002459e965f0e8U, (uint64_t)0x0007b864d3150933U,
+    (uint64_t)0x000252a5f2e81ed8U, (uint64_t)0x000094265066e80dU, (uint64_t)0x0000a60f918d61a5U,
+    (uint64_t)0x0000444bf7f30fdeU, (uint64_t)0x0001c40da9ed3c06U, (uint64_t)0x000079c170bd843bU,
+    (uint64_t)0x0006cd50c0d5d056U, (uint64_t)0x0005b7606ae779baU, (uint64_t)0x00070fbd226bdda1U,
+    (uint64_t)0x0005661e53391ff9U, (uint64_t)0x0006768c0d7317b8U, (uint64_t)0x0006ece464fa6fffU,
+    (uint64_t)0x0003cc40bca460a0U, (uint64_t)0x0006e3a90afb8d0cU, (uint64_t)0x0005801abca11228U,
+    (uint64_t)0x0006dec05e34ac9fU, (uint64_t)0x000625e5f155c1b3U, (uint64_t)0x0004f32f6f723296U,
+    (uint64_t)0x0005ac980105efceU, (uint64_t)0x00017a61165eee36U, (uint64_t)0x00051445e14ddcd5U,
+    (uint64_t)0x000147ab2bbea455U, (uint64_t)0x0001f240f2253126U, (uint64_t)0x0000c3de9e314e89U,
+    (uint64_t)0x00021ea5a4fca45fU, (uint64_t)0x00012e990086e4fdU, (uint64_t)0x00002b4b3b144951U,
+    (uint64_t)0x0005688977966aeaU, (uint64_t)0x00018e176e399ffdU, (uint64_t)0x0002e45c5eb4938bU,
+    (uint64_t)0x00013186f31e3929U, (uint64_t)0x000496b37fdfbb2eU, (uint64_t)0x0003c2439d5f3e21U,
+    (uint64_t)0x00016e60fe7e6a4dU, (uint64_t)0x0004d7ef889b621dU, (uint64_t)0x00077b2e3f05d3e9U,
+    (uint64_t)0x0000639c12ddb0a4U, (uint64_t)0x0006180490cd7ab3U, (uint64_t)0x0003f3918297467cU,
+    (uint64_t)0x00074568be1781acU, (uint64_t)0x00007a195152e095U, (uint64_t)0x0007a9c59c2ec4deU,
+    (uint64_t)0x0007e9f09e79652dU, (uint64_t)0x0006a3e422f22d86U, (uint64_t)0x0002ae8e3b836c8bU,
+    (uint64_t)0x00063b795fc7ad32U, (uint64_t)0x00068f02389e5fc8U, (uint64_t)0x000059f1bc877506U,
+    (uint64_t)0x000504990e410cecU, (uint64_t)0x00009bd7d0feaee2U, (uint64_t)0x0003e8fe83d032f0U,
+    (uint64_t)0x00004c8de8efd13cU, (uint64_t)0x0001c67c06e6210eU, (uint64_t)0x000183378f7f146aU,
+    (uint64_t)0x00064352ceaed289U, (uint64_t)0x00022d60899a6258U, (uint64_t)0x000315b90570a294U,
+    (uint64_t)0x00060ce108a925f1U, (uint64_t)0x0006eff61253c909U, (uint64_t)0x000003ef0e2d70b0U,
+    (uint64_t)0x00075ba3b797fac4U, (uint64_t)0x0001dbc070cdd196U, (uint64_t)0x00016d8fb1534c47U,
+    (uint64_t)0x000500498183fa2aU, (uint64_t)0x00072f59c423de75U, (uint64_t)0x0000904d07b87779U,
+    (uint64_t)0x00022d6648f940b9U, (uint64_t)0x000197a5a1873e86U, (uint64_t)0x000207e4c41a54bcU,
+    (uint64_t)0x0005360b3b4bd6d0U, (uint64_t)0x0006240aacebaf72U, (uint64_t)0x00061fd4ddba919cU,
+    (uint64_t)0x0007d8e991b55699U, (uint64_t)0x00061b31473cc76cU, (uint64_t)0x0007039631e631d6U,
+    (uint64_t)0x00043e2143fbc1ddU, (uint64_t)0x0004749c5ba295a0U, (uint64_t)0x00037946fa4b5f06U,
+    (uint64_t)0x000724c5ab5a51f1U, (uint64_t)0x00065633789dd3f3U, (uint64_t)0x00056bdaf238db40U,
+    (uint64_t)0x0000d36cc19d3bb2U, (uint64_t)0x0006ec4470d72262U, (uint64_t)0x0006853d7018a9aeU,
+    (uint64_t)0x0003aa3e4dc2c8ebU, (uint64_t)0x00003aa31507e1e5U, (uint64_t)0x0002b9e3f53533ebU,
+    (uint64_t)0x0002add727a806c5U, (uint64_t)0x00056955c8ce15a3U, (uint64_t)0x00018c4f070a290eU,
+    (uint64_t)0x0001d24a86d83741U, (uint64_t)0x00047648ffd4ce1fU, (uint64_t)0x00060a9591839e9dU,
+    (uint64_t)0x000424d5f38117abU, (uint64_t)0x00042cc46912c10eU, (uint64_t)0x00043b261dc9aeb4U,
+    (uint64_t)0x00013d8b6c951364U, (uint64_t)0x0004c0017e8f632aU, (uint64_t)0x00053e559e53f9c4U,
+    (uint64_t)0x0004b20146886eeaU, (uint64_t)0x00002b4d5e242940U, (uint64_t)0x00031e1988bb79bbU,
+    (uint64_t)0x0007b82f46b3bcabU, (uint64_t)0x0000f7a8ce827b41U, (uint64_t)0x0005e15816177130U,
+    (uint64_t)0x000326055cf5b276U, (uint64_t)0x000155cb28d18df2U, (uint64_t)0x0000c30d9ca11694U,
+    (uint64_t)0x0002090e27ab3119U, (uint64_t)0x000208624e7a49b6U, (uint64_t)0x00027a6c809ae5d3U,
+    (uint64_t)0x0004270ac43d6954U, (uint64_t)0x0002ed4cd95659a5U, (uint64_t)0x00075c0db37528f9U,
+    (uint64_t)0x0002ccbcfd2c9234U, (uint64_t)0x000221503603d8c2U, (uint64_t)0x0006ebcd1f0db188U,
+    (uint64_t)0x00074ceb4b7d1174U, (uint64_t)0x0007d56168df4f5cU, (uint64_t)0x0000bf79176fd18aU,
+    (uint64_t)0x0002cb67174ff60aU, (uint64_t)0x0006cdf9390be1d0U, (uint64_t)0x00008e519c7e2b3dU,
+    (uint64_t)0x000253c3d2a50881U, (uint64_t)0x00021b41448e333dU, (uint64_t)0x0007b1df4b73890fU,
+    (uint64_t)0x0006221807f8f58cU, (uint64_t)0x0003fa92813a8be5U, (uint64_t)0x0006da98c38d5572U,
+    (uint64_t)0x00001ed95554468fU, (uint64_t)0x00068698245d352eU, (uint64_t)0x0002f2e0b3b2a224U,
+    (uint64_t)0x0000c56aa22c1c92U, (uint64_t)0x0005fdec39f1b278U, (uint64_t)0x0004c90af5c7f106U,
+    (uint64_t)0x00061fcef2658fc5U, (uint64_t)0x00015d852a18187aU, (uint64_t)0x000270dbb59afb76U,
+    (uint64_t)0x0007db120bcf92abU, (uint64_t)0x0000e7a25d714087U, (uint64_t)0x00046cf4c473daf0U,
+    (uint64_t)0x00046ea7f1498140U, (uint64_t)0x00070725690a8427U, (uint64_t)0x0000a73ae9f079fbU,
+    (uint64_t)0x0002dd924461c62bU, (uint64_t)0x0001065aae50d8ccU, (uint64_t)0x000525ed9ec4e5f9U,
+    (uint64_t)0x000022d20660684cU, (uint64_t)0x0007972b70397b68U, (uint64_t)0x0007a03958d3f965U,
+    (uint64_t)0x00029387bcd14eb5U, (uint64_t)0x00044525df200d57U, (uint64_t)0x0002d7f94ce94385U,
+    (uint64_t)0x00060d00c170ecb7U, (uint64_t)0x00038b0503f3d8f0U, (uint64_t)0x00069a198e64f1ceU,
+    (uint64_t)0x00014434dcc5caedU, (uint64_t)0x0002c7909f667c20U, (uint64_t)0x00061a839d1fb576U,
+    (uint64_t)0x0004f23800cabb76U, (uint64_t)0x00025b2697bd267fU, (uint64_t)0x0002b2e0d91a78bcU,
+    (uint64_t)0x0003990a12ccf20cU, (uint64_t)0x000141c2e11f2622U, (uint64_t)0x0000dfcefaa53320U,
+    (uint64_t)0x0007369e6a92493aU, (uint64_t)0x00073ffb13986864U, (uint64_t)0x0003282bb8f713acU,
+    (uint64_t)0x00049ced78f297efU, (uint64_t)0x0006697027661defU, (uint64_t)0x0001420683db54e4U,
+    (uint64_t)0x0006bb6fc1cc5ad0U, (uint64_t)0x000532c8d591669dU, (uint64_t)0x0001af794da86c33U,
+    (uint64_t)0x0000e0e9d86d24d3U, (uint64_t)0x00031e83b4161d08U, (uint64_t)0x0000bd1e249dd197U,
+    (uint64_t)0x00000bcb1820568fU, (uint64_t)0x0002eab1718830d4U, (uint64_t)0x000396fd816997e6U,
+    (uint64_t)0x00060b63bebf508aU, (uint64_t)0x0000c7129e062b4fU, (uint64_t)0x0001e526415b12fdU,
+    (uint64_t)0x000461a0fd27923dU, (uint64_t)0x00018badf670a5b7U, (uint64_t)0x00055cf1eb62d550U,
+    (uint64_t)0x0006b5e37df58c52U, (uint64_t)0x0003bcf33986c60eU, (uint64_t)0x00044fb8835ceae7U,
+    (uint64_t)0x000099dec18e71a4U, (uint64_t)0x0001a56fbaa62ba0U, (uint64_t)0x0001101065c23d58U,
+    (uint64_t)0x0005aa1290338b0fU, (uint64_t)0x0003157e9e2e7421U, (uint64_t)0x0000ea712017d489U,
+    (uint64_t)0x000669a656457089U, (uint64_t)0x00066b505c9dc9ecU, (uint64_t)0x000774ef86e35287U,
+    (uint64_t)0x0004d1d944c0955eU, (uint64_t)0x00052e4c39d72b20U, (uint64_t)0x00013c4836799c58U,
+    (uint64_t)0x0004fb6a5d8bd080U, (uint64_t)0x00058ae34908589bU, (uint64_t)0x0003954d977baf13U,
+    (uint64_t)0x000413ea597441dcU, (uint64_t)0x00050bdc87dc8e5bU, (uint64_t)0x00025d465ab3e1b9U,
+    (uint64_t)0x0000f8fe27ec2847U, (uint64_t)0x0002d6e6dbf04f06U, (uint64_t)0x0003038cfc1b3276U,
+    (uint64_t)0x00066f80c93a637bU, (uint64_t)0x000537836edfe111U, (uint64_t)0x0002be02357b2c0dU,
+    (uint64_t)0x0006dcee58c8d4f8U, (uint64_t)0x0002d732581d6192U, (uint64_t)0x0001dd56444725fdU,
+    (uint64_t)0x0007e60008bac89aU, (uint64_t)0x00023d5c387c1852U, (uint64_t)0x00079e5df1f533a8U,
+    (uint64_t)0x0002e6f9f1c5f0cfU, (uint64_t)0x0003a3a450f63a30U, (uint64_t)0x00047ff83362127dU,
+    (uint64_t)0x00008e39af82b1f4U, (uint64_t)0x000488322ef27dabU, (uint64_t)0x0001973738a2a1a4U,
+    (uint64_t)0x0000e645912219f7U, (uint64_t)0x00072f31d8394627U, (uint64_t)0x00007bd294a200f1U,
+    (uint64_t)0x000665be00e274c6U, (uint64_t)0x00043de8f1b6368bU, (uint64_t)0x000318c8d9393a9aU,
+    (uint64_t)0x00069e29ab1dd398U, (uint64_t)0x00030685b3c76bacU, (uint64_t)0x000565cf37f24859U,
+    (uint64_t)0x00057b2ac28efef9U, (uint64_t)0x000509a41c325950U, (uint64_t)0x00045d032afffe19U,
+    (uint64_t)0x00012fe49b6cde4eU, (uint64_t)0x00021663bc327cf1U, (uint64_t)0x00018a5e4c69f1ddU,
+    (uint64_t)0x000224c7c679a1d5U, (uint64_t)0x00006edca6f925e9U, (uint64_t)0x00068c8363e677b8U,
+    (uint64_t)0x00060cfa25e4fbcfU, (uint64_t)0x0001c4c17609404eU, (uint64_t)0x00005bff02328a11U,
+    (uint64_t)0x0001a0dd0dc512e4U, (uint64_t)0x00010894bf5fcd10U, (uint64_t)0x00052949013f9c37U,
+    (uint64_t)0x0001f50fba4735c7U, (uint64_t)0x000576277cdee01aU, (uint64_t)0x0002137023cae00bU,
+    (uint64_t)0x00015a3599eb26c6U, (uint64_t)0x0000687221512b3cU, (uint64_t)0x000253cb3a0824e9U,
+    (uint64_t)0x000780b8cc3fa2a4U, (uint64_t)0x00038abc234f305fU, (uint64_t)0x0007a280bbc103deU,
+    (uint64_t)0x000398a836695dfeU, (uint64_t)0x0003d0af41528a1aU, (uint64_t)0x0005ff418726271bU,
+    (uint64_t)0x000347e813b69540U, (uint64_t)0x00076864c21c3cbbU, (uint64_t)0x0001e049dbcd74a8U,
+    (uint64_t)0x0005b4d60f93749cU, (uint64_t)0x00029d4db8ca0a0cU, (uint64_t)0x0006080c1789db9dU,
+    (uint64_t)0x0004be7cef1ea731U, (uint64_t)0x0002f40d769d8080U, (uint64_t)0x00035f7d4c44a603U,
+    (uint64_t)0x000106a03dc25a96U, (uint64_t)0x00050aaf333353d0U, (uint64_t)0x0004b59a613cbb35U,
+    (uint64_t)0x000223dfc0e19a76U, (uint64_t)0x00077d1e2bb2c564U, (uint64_t)0x0004ab38a51052cbU,
+    (uint64_t)0x0007d1ef5fddc09cU, (uint64_t)0x0007beeaebb9dad9U, (uint64_t)0x000058d30ba0acfbU,
+    (uint64_t)0x0005cd92eab5ae90U, (uint64_t)0x0003041c6bb04ed2U, (uint64_t)0x00042b256768d593U,
+    (uint64_t)0x0002e88459427b4fU, (uint64_t)0x00002b3876630701U, (uint64_t)0x00034878d405eae5U,
+    (uint64_t)0x00029cdd1adc088aU, (uint64_t)0x0002f2f9d956e148U, (uint64_t)0x0006b3e6ad65c1feU,
+    (uint64_t)0x0005b00972b79e5dU, (uint64_t)0x00053d8d234c5dafU, (uint64_t)0x000104bbd6814049U,
+    (uint64_t)0x00059a5fd67ff163U, (uint64_t)0x0003a998ead0352bU, (uint64_t)0x000083c95fa4af9aU,
+    (uint64_t)0x0006fadbfc01266fU, (uint64_t)0x000204f2a20fb072U, (uint64_t)0x0000fd3168f1ed67U,
+    (uint64_t)0x0001bb0de7784a3eU, (uint64_t)0x00034bcb78b20477U, (uint64_t)0x0000a4a26e2e2182U,
+    (uint64_t)0x0005be8cc57092a7U, (uint64_t)0x00043b3d30ebb079U, (uint64_t)0x000357aca5c61902U,
+    (uint64_t)0x0005b570c5d62455U, (uint64_t)0x00030fb29e1e18c7U, (uint64_t)0x0002570fb17c2791U,
+    (uint64_t)0x0006a9550bb8245aU, (uint64_t)0x000511f20a1a2325U, (uint64_t)0x00029324d7239beeU,
+    (uint64_t)0x0003343cc37516c4U, (uint64_t)0x000241c5f91de018U, (uint64_t)0x0002367f2cb61575U,
+    (uint64_t)0x0006c39ac04d87dfU, (uint64_t)0x0006d4958bd7e5bdU, (uint64_t)0x000566f4638a1532U,
+    (uint64_t)0x0003dcb65ea53030U, (uint64_t)0x0000172940de6caaU, (uint64_t)0x0006045b2e67451bU,
+    (uint64_t)0x00056c07463efcb3U, (uint64_t)0x0000728b6bfe6e91U, (uint64_t)0x00008420edd5fcdfU,
+    (uint64_t)0x0000c34e04f410ceU, (uint64_t)0x000344edc0d0a06bU, (uint64_t)0x0006e45486d84d6dU,
+    (uint64_t)0x00044e2ecb3863f5U, (uint64_t)0x00004d654f321db8U, (uint64_t)0x000720ab8362fa4aU,
+    (uint64_t)0x00029c4347cdd9bfU, (uint64_t)0x0000e798ad5f8463U, (uint64_t)0x0004fef18bcb0bfeU,
+    (uint64_t)0x0000d9a53efbc176U, (uint64_t)0x0005c116ddbdb5d5U, (uint64_t)0x0006d1b4bba5abcfU,
+    (uint64_t)0x0004d28a48a5537aU, (uint64_t)0x00056b8e5b040b99U, (uint64_t)0x0004a7a4f2618991U,
+    (uint64_t)0x0003b291af372a4bU, (uint64_t)0x00060e3028fe4498U, (uint64_t)0x0002267bca4f6a09U,
+    (uint64_t)0x000719eec242b243U, (uint64_t)0x0004a96314223e0eU, (uint64_t)0x000718025fb15f95U,
+    (uint64_t)0x00068d6b8371fe94U, (uint64_t)0x0003804448f7d97cU, (uint64_t)0x00042466fe784280U,
+    (uint64_t)0x00011b50c4cddd31U, (uint64_t)0x0000274408a4ffd6U, (uint64_t)0x0007d382aedb34ddU,
+    (uint64_t)0x00040acfc9ce385dU, (uint64_t)0x000628bb99a45b1eU, (uint64_t)0x0004f4bce4dce6bcU,
+    (uint64_t)0x0002616ec49d0b6fU, (uint64_t)0x0001f95d8462e61cU, (uint64_t)0x0001ad3e9b9159c6U,
+    (uint64_t)0x00079ba475a04df9U, (uint64_t)0x0003042cee561595U, (uint64_t)0x0007ce5ae2242584U,
+    (uint64_t)0x0002d25eb153d4e3U, (uint64_t)0x0003a8f3d09ba9c9U, (uint64_t)0x0000f3690d04eb8eU,
+    (uint64_t)0x00073fcdd14b71c0U, (uint64_t)0x00067079449bac41U, (uint64_t)0x0005b79c4621484fU,
+    (uint64_t)0x00061069f2156b8dU, (uint64_t)0x0000eb26573b10afU, (uint64_t)0x000389e740c9a9ceU,
+    (uint64_t)0x000578f6570eac28U, (uint64_t)0x000644f2339c3937U, (uint64_t)0x00066e47b7956c2cU,
+    (uint64_t)0x00034832fe1f55d0U, (uint64_t)0x00025c425e5d6263U, (uint64_t)0x0004b3ae34dcb9ceU,
+    (uint64_t)0x00047c691a15ac9fU, (uint64_t)0x000318e06e5d400cU, (uint64_t)0x0003c422d9f83eb1U,
+    (uint64_t)0x00061545379465a6U, (uint64_t)0x000606a6f1d7de6eU, (uint64_t)0x0004f1c0c46107e7U,
+    (uint64_t)0x000229b1dcfbe5d8U, (uint64_t)0x0003acc60a7b1327U, (uint64_t)0x0006539a08915484U,
+    (uint64_t)0x0004dbd414bb4a19U, (uint64_t)0x0007930849f1dbb8U, (uint64_t)0x000329c5a466caf0U,
+    (uint64_t)0x0006c824544feb9bU, (uint64_t)0x0000f65320ef019bU, (uint64_t)0x00021f74c3d2f773U,
+    (uint64_t)0x000024b88d08bd3aU, (uint64_t)0x0006e678cf054151U, (uint64_t)0x00043631272e747cU,
+    (uint64_t)0x00011c5e4aac5cd1U, (uint64_t)0x0006d1b1cafde0c6U, (uint64_t)0x000462c76a303a90U,
+    (uint64_t)0x0003ca4e693cff9bU, (uint64_t)0x0003952cd45786fdU, (uint64_t)0x0004cabc7bdec330U,
+    (uint64_t)0x0007788f3f78d289U, (uint64_t)0x0005942809b3f811U, (uint64_t)0x0005973277f8c29cU,
+    (uint64_t)0x000010f93bc5fe67U, (uint64_t)0x0007ee498165acb2U, (uint64_t)0x00069624089c0a2eU,
+    (uint64_t)0x0000075fc8e70473U, (uint64_t)0x00013e84ab1d2313U, (uint64_t)0x0002c10bedf6953bU,
+    (uint64_t)0x000639b93f0321c8U, (uint64_t)0x000508e39111a1c3U, (uint64_t)0x000290120e912f7aU,
+    (uint64_t)0x0001cbf464acae43U, (uint64_t)0x00015373e9576157U, (uint64_t)0x0000edf493c85b60U,
+    (uint64_t)0x0007c4d284764113U, (uint64_t)0x0007fefebf06acecU, (uint64_t)0x00039afb7a824100U,
+    (uint64_t)0x0001b48e47e7fd65U, (uint64_t)0x00004c00c54d1dfaU, (uint64_t)0x00048158599b5a68U,
+    (uint64_t)0x0001fd75bc41d5d9U, (uint64_t)0x0002d9fc1fa95d3cU, (uint64_t)0x0007da27f20eba11U,
+    (uint64_t)0x000403b92e3019d4U, (uint64_t)0x00022f818b465cf8U, (uint64_t)0x000342901dff09b8U,
+    (uint64_t)0x00031f595dc683cdU, (uint64_t)0x00037a57745fd682U, (uint64_t)0x000355bb12ab2617U,
+    (uint64_t)0x0001dac75a8c7318U, (uint64_t)0x0003b679d5423460U, (uint64_t)0x0006b8fcb7b6400eU,
+    (uint64_t)0x0006c73783be5f9dU, (uint64_t)0x0007518eaf8e052aU, (uint64_t)0x000664cc7493bbf4U,
+    (uint64_t)0x00033d94761874e3U, (uint64_t)0x0000179e1796f613U, (uint64_t)0x0001890535e2867dU,
+    (uint64_t)0x0000f9b8132182ecU, (uint64_t)0x000059c41b7f6c32U, (uint64_t)0x00079e8706531491U,
+    (uint64_t)0x0006c747643cb582U, (uint64_t)0x0002e20c0ad494e4U, (uint64_t)0x00047c3871bbb175U,
+    (uint64_t)0x00065d50c85066b0U, (uint64_t)0x0006167453361f7cU, (uint64_t)0x00006ba3818bb312U,
+    (uint64_t)0x0006aff29baa7522U, (uint64_t)0x00008fea02ce8d48U, (uint64_t)0x0004539771ec4f48U,
+    (uint64_t)0x0007b9318badca28U, (uint64_t)0x00070f19afe016c5U, (uint64_t)0x0004ee7bb1608d23U,
+    (uint64_t)0x00000b89b8576469U, (uint64_t)0x0005dd7668deead0U, (uint64_t)0x0004096d0ba47049U,
+    (uint64_t)0x0006275997219114U, (uint64_t)0x00029bda8a67e6aeU, (uint64_t)0x000473829a74f75dU,
+    (uint64_t)0x0001533aad3902c9U, (uint64_t)0x0001dde06b11e47bU, (uint64_t)0x000784bed1930b77U,
+    (uint64_t)0x0001c80a92b9c867U, (uint64_t)0x0006c668b4d44e4dU, (uint64_t)0x0002da754679c418U,
+    (uint64_t)0x0003164c31be105aU, (uint64_t)0x00011fac2b98ef5fU, (uint64_t)0x00035a1aaf779256U,
+    (uint64_t)0x0002078684c4833cU, (uint64_t)0x0000cf217a78820cU, (uint64_t)0x00065024e7d2e769U,
+    (uint64_t)0x00023bb5efdda82aU, (uint64_t)0x00019fd4b632d3c6U, (uint64_t)0x0007411a6054f8a4U,
+    (uint64_t)0x0002e53d18b175b4U, (uint64_t)0x00033e7254204af3U, (uint64_t)0x0003bcd7d5a1c4c5U,
+    (uint64_t)0x0004c7c22af65d0fU, (uint64_t)0x0001ec9a872458c3U, (uint64_t)0x00059d32b99dc86dU,
+    (uint64_t)0x0006ac075e22a9acU, (uint64_t)0x00030b9220113371U, (uint64_t)0x00027fd9a638966eU,
+    (uint64_t)0x0007c136574fb813U, (uint64_t)0x0006a4d400a2509bU, (uint64_t)0x000041791056971cU,
+    (uint64_t)0x000655d5866e075cU, (uint64_t)0x0002302bf3e64df8U, (uint64_t)0x0003add88a5c7cd6U,
+    (uint64_t)0x000298d459393046U, (uint64_t)0x00030bfecb3d90b8U, (uint64_t)0x0003d9b8ea3df8d6U,
+    (uint64_t)0x0003900e96511579U, (uint64_t)0x00061ba1131a406aU, (uint64_t)0x00015770b635dcf2U,
+    (uint64_t)0x00059ecd83f79571U, (uint64_t)0x0002db461c0b7fbdU, (uint64_t)0x00073a42a981345fU,
+    (uint64_t)0x000249929fccc879U, (uint64_t)0x0000a0f116959029U, (uint64_t)0x0005974fd7b1347aU,
+    (uint64_t)0x0001e0cc1c08edadU, (uint64_t)0x000673bdf8ad1f13U, (uint64_t)0x0005620310cbbd8eU,
+    (uint64_t)0x0006b5f477e285d6U, (uint64_t)0x0004ed91ec326cc8U, (uint64_t)0x0006d6537503a3fdU,
+    (uint64_t)0x000626d3763988d5U, (uint64_t)0x0007ec846f3658ceU, (uint64_t)0x000193434934d643U,
+    (uint64_t)0x0000d4a2445eaa51U, (uint64_t)0x0007d0708ae76fe0U, (uint64_t)0x00039847b6c3c7e1U,
+    (uint64_t)0x00037676a2a4d9d9U, (uint64_t)0x00068f3f1da22ec7U, (uint64_t)0x0006ed8039a2736bU,
+    (uint64_t)0x0002627ee04c3c75U, (uint64_t)0x0006ea90a647e7d1U, (uint64_t)0x0006daaf723399b9U,
+    (uint64_t)0x000304bfacad8ea2U, (uint64_t)0x000502917d108b07U, (uint64_t)0x000043176ca6dd0fU,
+    (uint64_t)0x0005d5158f2c1d84U, (uint64_t)0x0002b5449e58eb3bU, (uint64_t)0x00027562eb3dbe47U,
+    (uint64_t)0x000291d7b4170be7U, (uint64_t)0x0005d1ca67dfa8e1U, (uint64_t)0x0002a88061f298a2U,
+    (uint64_t)0x0001304e9e71627dU, (uint64_t)0x000014d26adc9cfeU, (uint64_t)0x0007f1691ba16f13U,
+    (uint64_t)0x0005e71828f06eacU, (uint64_t)0x000349ed07f0fffcU, (uint64_t)0x0004468de2d7c2ddU,
+    (uint64_t)0x0002d8c6f86307ceU, (uint64_t)0x0006286ba1850973U, (uint64_t)0x0005e9dcb08444d4U,
+    (uint64_t)0x0001a96a543362b2U, (uint64_t)0x0005da6427e63247U, (uint64_t)0x0003355e9419469eU,
+    (uint64_t)0x0001847bb8ea8a37U, (uint64_t)0x0001fe6588cf9b71U, (uint64_t)0x0006b1c9d2db6b22U,
+    (uint64_t)0x0006cce7c6ffb44bU, (uint64_t)0x0004c688deac22caU, (uint64_t)0x0006f775c3ff0352U,
+    (uint64_t)0x000565603ee419bbU, (uint64_t)0x0006544456c61c46U, (uint64_t)0x00058f29abfe79f2U,
+    (uint64_t)0x000264bf710ecdf6U, (uint64_t)0x000708c58527896bU, (uint64_t)0x00042ceae6c53394U,
+    (uint64_t)0x0004381b21e82b6aU, (uint64_t)0x0006af93724185b4U, (uint64_t)0x0006cfab8de73e68U,
+    (uint64_t)0x0003e6efced4bd21U, (uint64_t)0x0000056609500dbeU, (uint64_t)0x00071b7824ad85dfU,
+    (uint64_t)0x000577629c4a7f41U, (uint64_t)0x0000024509c6a888U, (uint64_t)0x0002696ab12e6644U,
+    (uint64_t)0x0000cca27f4b80d8U, (uint64_t)0x0000c7c1f11b119eU, (uint64_t)0x000701f25bb0caecU,
+    (uint64_t)0x0000f6d97cbec113U, (uint64_t)0x0004ce97fb7c93a3U, (uint64_t)0x000139835a11281bU,
+    (uint64_t)0x000728907ada9156U, (uint64_t)0x000720a5bc050955U, (uint64_t)0x0000b0f8e4616cedU,
+    (uint64_t)0x0001d3c4b50fb875U, (uint64_t)0x0002f29673dc0198U, (uint64_t)0x0005f4b0f1830ffaU,
+    (uint64_t)0x0002e0c92bfbdc40U, (uint64_t)0x000709439b805a35U, (uint64_t)0x0006ec48557f8187U,
+    (uint64_t)0x00008a4d1ba13a2cU, (uint64_t)0x000076348a0bf9aeU, (uint64_t)0x0000e9b9cbb144efU,
+    (uint64_t)0x00069bd55db1beeeU, (uint64_t)0x0006e14e47f731bdU, (uint64_t)0x0001a35e47270eacU,
+    (uint64_t)0x00066f225478df8eU, (uint64_t)0x000366d44191cfd3U, (uint64_t)0x0002d48ffb5720adU,
+    (uint64_t)0x00057b7f21a1df77U, (uint64_t)0x0005550effba0645U, (uint64_t)0x0005ec6a4098a931U,
+    (uint64_t)0x000221104eb3f337U, (uint64_t)0x00041743f2bc8c14U, (uint64_t)0x000796b0ad8773c7U,
+    (uint64_t)0x00029fee5cbb689bU, (uint64_t)0x000122665c178734U, (uint64_t)0x0004167a4e6bc593U,
+    (uint64_t)0x00062665f8ce8feeU, (uint64_t)0x00029d101ac59857U, (uint64_t)0x0004d93bbba59ffcU,
+    (uint64_t)0x00017b7897373f17U, (uint64_t)0x00034b33370cb7edU, (uint64_t)0x00039d2876f62700U,
+    (uint64_t)0x000001cecd1d6c87U, (uint64_t)0x0007f01a11747675U, (uint64_t)0x0002350da5a18190U,
+    (uint64_t)0x0007938bb7e22552U, (uint64_t)0x000591ee8681d6ccU, (uint64_t)0x00039db0b4ea79b8U,
+    (uint64_t)0x000202220f380842U, (uint64_t)0x0002f276ba42e0acU, (uint64_t)0x0001176fc6e2dfe6U,
+    (uint64_t)0x0000e28949770eb8U, (uint64_t)0x0005559e88147b72U, (uint64_t)0x00035e1e6e63ef30U,
+    (uint64_t)0x00035b109aa7ff6fU, (uint64_t)0x0001f6a3e54f2690U, (uint64_t)0x00076cd05b9c619bU,
+    (uint64_t)0x00069654b0901695U, (uint64_t)0x0007a53710b77f27U, (uint64_t)0x00079a1ea7d28175U,
+    (uint64_t)0x00008fc3a4c677d5U, (uint64_t)0x0004c199d30734eaU, (uint64_t)0x0006c622cb9acc14U,
+    (uint64_t)0x0005660a55030216U, (uint64_t)0x000068f1199f11fbU, (uint64_t)0x0004f2fad0116b90U,
+    (uint64_t)0x0004d91db73bb638U, (uint64_t)0x00055f82538112c5U, (uint64_t)0x0006d85a279815deU,
+    (uint64_t)0x000740b7b0cd9cf9U, (uint64_t)0x0003451995f2944eU, (uint64_t)0x0006b24194ae4e54U,
+    (uint64_t)0x0002230afded8897U, (uint64_t)0x00023412617d5071U, (uint64_t)0x0003d5d30f35969bU,
+    (uint64_t)0x000445484a4972efU, (uint64_t)0x0002fcd09fea7d7cU, (uint64_t)0x000296126b9ed22aU,
+    (uint64_t)0x0004a171012a05b2U, (uint64_t)0x0001db92c74d5523U, (uint64_t)0x00010b89ca604289U,
+    (uint64_t)0x000141be5a45f06eU, (uint64_t)0x0005adb38becaea7U, (uint64_t)0x0003fd46db41f2bbU,
+    (uint64_t)0x0006d488bbb5ce39U, (uint64_t)0x00017d2d1d9ef0d4U, (uint64_t)0x000147499718289cU,
+    (uint64_t)0x0000a48a67e4c7abU, (uint64_t)0x00030fbc544bafe3U, (uint64_t)0x0000c701315fe58aU,
+    (uint64_t)0x00020b878d577b75U, (uint64_t)0x0002af18073f3e6aU, (uint64_t)0x00033aea420d24feU,
+    (uint64_t)0x000298008bf4ff94U, (uint64_t)0x0003539171db961eU, (uint64_t)0x00072214f63cc65cU,
+    (uint64_t)0x0005b7b9f43b29c9U, (uint64_t)0x000149ea31eea3b3U, (uint64_t)0x0004be7713581609U,
+    (uint64_t)0x0002d87960395e98U, (uint64_t)0x0001f24ac855a154U, (uint64_t)0x00037f405307a693U,
+    (uint64_t)0x0002e5e66cf2b69cU, (uint64_t)0x0005d84266ae9c53U, (uint64_t)0x0005e4eb7de853b9U,
+    (uint64_t)0x0005fdf48c58171cU, (uint64_t)0x000608328e9505aaU, (uint64_t)0x00022182841dc49aU,
+    (uint64_t)0x0003ec96891d2307U, (uint64_t)0x0002f363fff22e03U, (uint64_t)0x00000ba739e2ae39U,
+    (uint64_t)0x000426f5ea88bb26U, (uint64_t)0x00033092e77f75c8U, (uint64_t)0x0001a53940d819e7U,
+    (uint64_t)0x0001132e4f818613U, (uint64_t)0x00072297de7d518dU, (uint64_t)0x000698de5c8790d6U,
+    (uint64_t)0x000268b8545beb25U, (uint64_t)0x0006d2648b96fedfU, (uint64_t)0x00047988ad1db07cU,
+    (uint64_t)0x00003283a3e67ad7U, (uint64_t)0x00041dc7be0cb939U, (uint64_t)0x0001b16c66100904U,
+    (uint64_t)0x0000a24c20cbc66dU, (uint64_t)0x0004a2e9efe48681U, (uint64_t)0x00005e1296846271U,
+    (uint64_t)0x0007bbc8242c4550U, (uint64_t)0x00059a06103b35b7U, (uint64_t)0x0007237e4af32033U,
+    (uint64_t)0x000726421ab3537aU, (uint64_t)0x00078cf25d38258cU, (uint64_t)0x0002eeb32d9c495aU,
+    (uint64_t)0x00079e25772f9750U, (uint64_t)0x0006d747833bbf23U, (uint64_t)0x0006cdd816d5d749U,
+    (uint64_t)0x00039c00c9c13698U, (uint64_t)0x00066b8e31489d68U, (uint64_t)0x000573857e10e2b5U,
+    (uint64_t)0x00013be816aa1472U, (uint64_t)0x00041964d3ad4bf8U, (uint64_t)0x000006b52076b3ffU,
+    (uint64_t)0x00037e16b9ce082dU, (uint64_t)0x0001882f57853eb9U, (uint64_t)0x0007d29eacd01fc5U,
+    (uint64_t)0x0002e76a59b5e715U, (uint64_t)0x0007de2e9561a9f7U, (uint64_t)0x0000cfe19d95781cU,
+    (uint64_t)0x000312cc621c453cU, (uint64_t)0x000145ace6da077cU, (uint64_t)0x0000912bef9ce9b8U,
+    (uint64_t)0x0004d57e3443bc76U, (uint64_t)0x0000d4f4b6a55ecbU, (uint64_t)0x0007ebb0bb733bceU,
+    (uint64_t)0x0007ba6a05200549U, (uint64_t)0x0004f6ede4e22069U, (uint64_t)0x0006b2a90af1a602U,
+    (uint64_t)0x0003f3245bb2d80aU, (uint64_t)0x0000e5f720f36efdU, (uint64_t)0x0003b9cccf60c06dU,
+    (uint64_t)0x000084e323f37926U, (uint64_t)0x000465812c8276c2U, (uint64_t)0x0003f4fc9ae61e97U,
+    (uint64_t)0x0003bc07ebfa2d24U, (uint64_t)0x0003b744b55cd4a0U, (uint64_t)0x00072553b25721f3U,
+    (uint64_t)0x0005fd8f4e9d12d3U, (uint64_t)0x0003beb22a1062d9U, (uint64_t)0x0006a7063b82c9a8U,
+    (uint64_t)0x0000a5a35dc197edU, (uint64_t)0x0003c80c06a53defU, (uint64_t)0x00005b32c2b1cb16U,
+    (uint64_t)0x0004a42c7ad58195U, (uint64_t)0x0005c8667e799effU, (uint64_t)0x00002e5e74c850a1U,
+    (uint64_t)0x0003f0db614e869aU, (uint64_t)0x00031771a4856730U, (uint64_t)0x00005eccd24da8fdU,
+    (uint64_t)0x000580bbfdf07918U, (uint64_t)0x0007e73586873c6aU, (uint64_t)0x00074ceddf77f93eU,
+    (uint64_t)0x0003b5556a37b471U, (uint64_t)0x0000c524e14dd482U, (uint64_t)0x000283457496c656U,
+    (uint64_t)0x0000ad6bcfb6cd45U, (uint64_t)0x000375d1e8b02414U, (uint64_t)0x0004fc079d27a733U,
+    (uint64_t)0x00048b440c86c50dU, (uint64_t)0x000139929cca3b86U, (uint64_t)0x0000f8f2e44cdf2fU,
+    (uint64_t)0x00068432117ba6b2U, (uint64_t)0x000241170c2bae3cU, (uint64_t)0x000138b089bf2f7fU,
+    (uint64_t)0x0004a05bfd34ea39U, (uint64_t)0x000203914c925ef5U, (uint64_t)0x0007497fffe04e3cU,
+    (uint64_t)0x000124567cecaf98U, (uint64_t)0x0001ab860ac473b4U, (uint64_t)0x0005c0227c86a7ffU,
+    (uint64_t)0x00071b12bfc24477U, (uint64_t)0x000006a573a83075U, (uint64_t)0x0003f8612966c870U,
+    (uint64_t)0x0000fcfa36048d13U, (uint64_t)0x00066e7133bbb383U, (uint64_t)0x00064b42a8a45676U,
+    (uint64_t)0x0004ea6e4f9a85cfU, (uint64_t)0x00026f57eee878a1U, (uint64_t)0x00020cc9782a0ddeU,
+    (uint64_t)0x00065d4e3070aab3U, (uint64_t)0x0007bc8e31547736U, (uint64_t)0x00009ebfb1432d98U,
+    (uint64_t)0x000504aa77679736U, (uint64_t)0x00032cd55687efb1U, (uint64_t)0x0004448f5e2f6195U,
+    (uint64_t)0x000568919d460345U, (uint64_t)0x000034c2e0ad1a27U, (uint64_t)0x0004041943d9dba3U,
+    (uint64_t)0x00017743a26caaddU, (uint64_t)0x00048c9156f9c964U, (uint64_t)0x0007ef278d1e9ad0U,
+    (uint64_t)0x00000ce58ea7bd01U, (uint64_t)0x00012d931429800dU, (uint64_t)0x0000eeba43ebcc96U,
+    (uint64_t)0x000384dd5395f878U, (uint64_t)0x0001df331a35d272U, (uint64_t)0x000207ecfd4af70eU,
+    (uint64_t)0x0001420a1d976843U, (uint64_t)0x00067799d337594fU, (uint64_t)0x00001647548f6018U,
+    (uint64_t)0x00057fce5578f145U, (uint64_t)0x000009220c142a71U, (uint64_t)0x0001b4f92314359aU,
+    (uint64_t)0x00073030a49866b1U, (uint64_t)0x0002442be90b2679U, (uint64_t)0x00077bd3d8947dcfU,
+    (uint64_t)0x0001fb55c1552028U, (uint64_t)0x0005ff191d56f9a2U, (uint64_t)0x0004109d89150951U,
+    (uint64_t)0x000225bd2d2d47cbU, (uint64_t)0x00057cc080e73beaU, (uint64_t)0x0006d71075721fcbU,
+    (uint64_t)0x000239b572a7f132U, (uint64_t)0x0006d433ac2d9068U, (uint64_t)0x00072bf930a47033U,
+    (uint64_t)0x00064facf4a20eadU, (uint64_t)0x000365f7a2b9402aU, (uint64_t)0x000020c526a758f3U,
+    (uint64_t)0x0001ef59f042cc89U, (uint64_t)0x0003b1c24976dd26U, (uint64_t)0x00031d665cb16272U,
+    (uint64_t)0x00028656e470c557U, (uint64_t)0x000452cfe0a5602cU, (uint64_t)0x000034f89ed8dbbcU,
+    (uint64_t)0x00073b8f948d8ef3U, (uint64_t)0x000786c1d323caabU, (uint64_t)0x00043bd4a9266e51U,
+    (uint64_t)0x00002aacc4615313U, (uint64_t)0x0000f7a0647877dfU, (uint64_t)0x0004e1cc0f93f0d4U,
+    (uint64_t)0x0007ec4726ef1190U, (uint64_t)0x0003bdd58bf512f8U, (uint64_t)0x0004cfb7d7b304b8U,
+    (uint64_t)0x000699c29789ef12U, (uint64_t)0x00063beae321bc50U, (uint64_t)0x000325c340adbb35U,
+    (uint64_t)0x000562e1a1e42bf6U, (uint64_t)0x0005b1d4cbc434d3U, (uint64_t)0x00043d6cb89b75feU,
+    (uint64_t)0x0003338d5b900e56U, (uint64_t)0x00038d327d531a53U, (uint64_t)0x0001b25c61d51b9fU,
+    (uint64_t)0x00014b4622b39075U, (uint64_t)0x00032615cc0a9f26U, (uint64_t)0x00057711b99cb6dfU,
+    (uint64_t)0x0005a69c14e93c38U, (uint64_t)0x0006e88980a4c599U, (uint64_t)0x0002f98f71258592U,
+    (uint64_t)0x0002ae444f54a701U, (uint64_t)0x000615397afbc5c2U, (uint64_t)0x00060d7783f3f8fbU,
+    (uint64_t)0x0002aa675fc486baU, (uint64_t)0x0001d8062e9e7614U, (uint64_t)0x0004a74cb50f9e56U,
+    (uint64_t)0x000531d1c2640192U, (uint64_t)0x0000c03d9d6c7fd2U, (uint64_t)0x00057ccd156610c1U,
+    (uint64_t)0x0003a6ae249d806aU, (uint64_t)0x0002da85a9907c5aU, (uint64_t)0x0006b23721ec4cafU,
+    (uint64_t)0x0004d2d3a4683aa2U, (uint64_t)0x0007f9c6870efdefU, (uint64_t)0x000298b8ce8aef25U,
+    (uint64_t)0x000272ea0a2165deU, (uint64_t)0x00068179ef3ed06fU, (uint64_t)0x0004e2b9c0feac1eU,
+    (uint64_t)0x0003ee290b1b63bbU, (uint64_t)0x0006ba6271803a7dU, (uint64_t)0x00027953eff70cb2U,
+    (uint64_t)0x00054f22ae0ec552U, (uint64_t)0x00029f3da92e2724U, (uint64_t)0x000242ca0c22bd18U,
+    (uint64_t)0x00034b8a8404d5ceU, (uint64_t)0x0006ecb583693335U, (uint64_t)0x0003ec76bfdfb84dU,
+    (uint64_t)0x0002c895cf56a04fU, (uint64_t)0x0006355149d54d52U, (uint64_t)0x00071d62bdd465e1U,
+    (uint64_t)0x0005b5dab1f75ef5U, (uint64_t)0x0001e2d60cbeb9a5U, (uint64_t)0x000527c2175dfe57U,
+    (uint64_t)0x00059e8a2b8ff51fU, (uint64_t)0x0001c333621262b2U, (uint64_t)0x0003cc28d378df80U,
+    (uint64_t)0x00072141f4968ca6U, (uint64_t)0x000407696bdb6d0dU, (uint64_t)0x0005d271b22ffcfbU,
+    (uint64_t)0x00074d5f317f3172U, (uint64_t)0x0007e55467d9ca81U, (uint64_t)0x0006a5653186f50dU,
+    (uint64_t)0x0006b188ece62df1U, (uint64_t)0x0004c66d36844971U, (uint64_t)0x0004aebcc4547e9dU,
+    (uint64_t)0x00008d9e7354b610U, (uint64_t)0x00026b750b6dc168U, (uint64_t)0x000162881e01acc9U,
+    (uint64_t)0x0007966df31d01a5U, (uint64_t)0x000173bd9ddc9a1dU, (uint64_t)0x0000071b276d01c9U,
+    (uint64_t)0x0000b0d8918e025eU, (uint64_t)0x00075beea79ee2ebU, (uint64_t)0x0003c92984094db8U,
+    (uint64_t)0x0005d88fbf95a3dbU, (uint64_t)0x00000f1efe5872dfU, (uint64_t)0x0005da872318256aU,
+    (uint64_t)0x00059ceb81635960U, (uint64_t)0x00018cf37693c764U, (uint64_t)0x00006e1cd13b19eaU,
+    (uint64_t)0x0003af629e5b0353U, (uint64_t)0x000204f1a088e8e5U, (uint64_t)0x00010efc9ceea82eU,
+    (uint64_t)0x000589863c2fa34bU, (uint64_t)0x0007f3a6a1a8d837U, (uint64_t)0x0000ad516f166f23U,
+    (uint64_t)0x000263f56d57c81aU, (uint64_t)0x00013422384638caU, (uint64_t)0x0001331ff1af0a50U,
+    (uint64_t)0x0003080603526e16U, (uint64_t)0x000644395d3d800bU, (uint64_t)0x0002b9203dbedefcU,
+    (uint64_t)0x0004b18ce656a355U, (uint64_t)0x00003f3466bc182cU, (uint64_t)0x00030d0fded2e513U,
+    (uint64_t)0x0004971e68b84750U, (uint64_t)0x00052ccc9779f396U, (uint64_t)0x0003e904ae8255c8U,
+    (uint64_t)0x0004ecae46f39339U, (uint64_t)0x0004615084351c58U, (uint64_t)0x00014d1af21233b3U,
+    (uint64_t)0x0001de1989b39c0bU, (uint64_t)0x00052669dc6f6f9eU, (uint64_t)0x00043434b28c3fc7U,
+    (uint64_t)0x0000a9214202c099U, (uint64_t)0x000019c0aeb9a02eU, (uint64_t)0x0001a2c06995d792U,
+    (uint64_t)0x000664cbb1571c44U, (uint64_t)0x0006ff0736fa80b2U, (uint64_t)0x0003bca0d2895ca5U,
+    (uint64_t)0x00008eb69ecc01bfU, (uint64_t)0x0005b4c8912df38dU, (uint64_t)0x0005ea7f8bc2f20eU,
+    (uint64_t)0x000120e516caafafU, (uint64_t)0x0004ea8b4038df28U, (uint64_t)0x000031bc3c5d62a4U,
+    (uint64_t)0x0007d9fe0f4c081eU, (uint64_t)0x00043ed51467f22cU, (uint64_t)0x0001e6cc0c1ed109U,
+    (uint64_t)0x0005631deddae8f1U, (uint64_t)0x0005460af1cad202U, (uint64_t)0x0000b4919dd0655dU,
+    (uint64_t)0x0007c4697d18c14cU, (uint64_t)0x000231c890bba2a4U, (uint64_t)0x00024ce0930542caU,
+    (uint64_t)0x0007a155fdf30b85U, (uint64_t)0x0001c6c6e5d487f9U, (uint64_t)0x00024be1134bdc5aU,
+    (uint64_t)0x0001405970326f32U, (uint64_t)0x000549928a7324f4U, (uint64_t)0x000090f5fd06c106U,
+    (uint64_t)0x0006abb1021e43fdU, (uint64_t)0x000232bcfad711a0U, (uint64_t)0x0003a5c13c047f37U,
+    (uint64_t)0x00041d4e3c28a06dU, (uint64_t)0x000632a763ee1a2eU, (uint64_t)0x0006fa4bffbd5e4dU,
+    (uint64_t)0x0005fd35a6ba4792U, (uint64_t)0x0007b55e1de99de8U, (uint64_t)0x000491b66dec0dcfU,
+    (uint64_t)0x00004a8ed0da64a1U, (uint64_t)0x0005ecfc45096ebeU, (uint64_t)0x0005edee93b488b2U,
+    (uint64_t)0x0005b3c11a51bc8fU, (uint64_t)0x0004cf6b8b0b7018U, (uint64_t)0x0005b13dc7ea32a7U,
+    (uint64_t)0x00018fc2db73131eU, (uint64_t)0x0007e3651f8f57e3U, (uint64_t)0x00025656055fa965U,
+    (uint64_t)0x00008f338d0c85eeU, (uint64_t)0x0003a821991a73bdU, (uint64_t)0x00003be6418f5870U,
+    (uint64_t)0x0001ddc18eac9ef0U, (uint64_t)0x00054ce09e998dc2U, (uint64_t)0x000530d4a82eb078U,
+    (uint64_t)0x000173456c9abf9eU, (uint64_t)0x0007892015100dadU, (uint64_t)0x00033ee14095fecbU,
+    (uint64_t)0x0006ad95d67a0964U, (uint64_t)0x0000db3e7e00cbfbU, (uint64_t)0x00043630e1f94825U,
+    (uint64_t)0x0004d1956a6b4009U, (uint64_t)0x000213fe2df8b5e0U, (uint64_t)0x00005ce3a41191e6U,
+    (uint64_t)0x00065ea753f10177U, (uint64_t)0x0006fc3ee2096363U, (uint64_t)0x0007ec36b96d67acU,
+    (uint64_t)0x000510ec6a0758b1U, (uint64_t)0x0000ed87df022109U, (uint64_t)0x00002a4ec1921e1aU,
+    (uint64_t)0x00006162f1cf795fU, (uint64_t)0x000324ddcafe5eb9U, (uint64_t)0x000018d5e0463218U,
+    (uint64_t)0x0007e78b9092428eU, (uint64_t)0x00036d12b5dec067U, (uint64_t)0x0006259a3b24b8a2U,
+    (uint64_t)0x000188b5f4170b9cU, (uint64_t)0x000681c0dee15debU, (uint64_t)0x0004dfe665f37445U,
+    (uint64_t)0x0003d143c5112780U, (uint64_t)0x0005279179154557U, (uint64_t)0x00039f8f0741424dU,
+    (uint64_t)0x00045e6eb357923dU, (uint64_t)0x00042c9b5edb746fU, (uint64_t)0x0002ef517885ba82U,
+    (uint64_t)0x0006bffb305b2f51U, (uint64_t)0x0005b112b2d712ddU, (uint64_t)0x00035774974fe4e2U,
+    (uint64_t)0x00004af87a96e3a3U, (uint64_t)0x00057968290bb3a0U, (uint64_t)0x0007974e8c58aedcU,
+    (uint64_t)0x0007757e083488c6U, (uint64_t)0x000601c62ae7bc8bU, (uint64_t)0x00045370c2ecab74U,
+    (uint64_t)0x0002f1b78fab143aU, (uint64_t)0x0002b8430a20e101U, (uint64_t)0x0001a49e1d88fee3U,
+    (uint64_t)0x00038bbb47ce4d96U, (uint64_t)0x0001f0e7ba84d437U, (uint64_t)0x0007dc43e35dc2aaU,
+    (uint64_t)0x00002a5c273e9718U, (uint64_t)0x00032bc9dfb28b4fU, (uint64_t)0x00048df4f8d5db1aU,
+    (uint64_t)0x00054c87976c028fU, (uint64_t)0x000044fb81d82d50U, (uint64_t)0x00066665887dd9c3U,
+    (uint64_t)0x000629760a6ab0b2U, (uint64_t)0x000481e6c7243e6cU, (uint64_t)0x000097e37046fc77U,
+    (uint64_t)0x0007ef72016758ccU, (uint64_t)0x000718c5a907e3d9U, (uint64_t)0x0003b9c98c6b383bU,
+    (uint64_t)0x000006ed255eccdcU, (uint64_t)0x0006976538229a59U, (uint64_t)0x0007f79823f9c30dU,
+    (uint64_t)0x00041ff068f587baU, (uint64_t)0x0001c00a191bcd53U, (uint64_t)0x0007b56f9c209e25U,
+    (uint64_t)0x0003781e5fccaabeU, (uint64_t)0x00064a9b0431c06dU, (uint64_t)0x0004d239a3b513e8U,
+    (uint64_t)0x00029723f51b1066U, (uint64_t)0x000642f4cf04d9c3U, (uint64_t)0x0004da095aa09b7aU,
+    (uint64_t)0x0000a4e0373d784dU, (uint64_t)0x0003d6a15b7d2919U, (uint64_t)0x00041aa75046a5d6U,
+    (uint64_t)0x000691751ec2d3daU, (uint64_t)0x00023638ab6721c4U, (uint64_t)0x000071a7d0ace183U,
+    (uint64_t)0x0004355220e14431U, (uint64_t)0x0000e1362a283981U, (uint64_t)0x0002757cd8359654U,
+    (uint64_t)0x0002e9cd7ab10d90U, (uint64_t)0x0007c69bcf761775U, (uint64_t)0x00072daac887ba0bU,
+    (uint64_t)0x0000b7f4ac5dda60U, (uint64_t)0x0003bdda2c0498a4U, (uint64_t)0x00074e67aa180160U,
+    (uint64_t)0x0002c3bcc7146ea7U, (uint64_t)0x0000d7eb04e8295fU, (uint64_t)0x0004a5ea1e6fa0feU,
+    (uint64_t)0x00045e635c436c60U, (uint64_t)0x00028ef4a8d4d18bU, (uint64_t)0x0006f5a9a7322acaU,
+    (uint64_t)0x0001d4eba3d944beU, (uint64_t)0x0000100f15f3dce5U, (uint64_t)0x00061a700e367825U,
+    (uint64_t)0x0005922292ab3d23U, (uint64_t)0x00002ab9680ee8d3U, (uint64_t)0x0001000c2f41c6c5U,
+    (uint64_t)0x0000219fdf737174U, (uint64_t)0x000314727f127de7U, (uint64_t)0x0007e5277d23b81eU,
+    (uint64_t)0x000494e21a2e147aU, (uint64_t)0x00048a85dde50d9aU, (uint64_t)0x0001c1f734493df4U,
+    (uint64_t)0x00047bdb64866889U, (uint64_t)0x00059a7d048f8eecU, (uint64_t)0x0006b5d76cbea46bU,
+    (uint64_t)0x000141171e782522U, (uint64_t)0x0006806d26da7c1fU, (uint64_t)0x0003f31d1bc79ab9U,
+    (uint64_t)0x00009f20459f5168U, (uint64_t)0x00016fb869c03dd3U, (uint64_t)0x0007556cec0cd994U,
+    (uint64_t)0x0005eb9a03b7510aU, (uint64_t)0x00050ad1dd91cb71U, (uint64_t)0x0001aa5780b48a47U,
+    (uint64_t)0x0000ae333f685277U, (uint64_t)0x0006199733b60962U, (uint64_t)0x00069b157c266511U,
+    (uint64_t)0x00064740f893f1caU, (uint64_t)0x00003aa408fbf684U, (uint64_t)0x0003f81e38b8f70dU,
+    (uint64_t)0x00037f355f17c824U, (uint64_t)0x00007ae85334815bU, (uint64_t)0x0007e3abddd2e48fU,
+    (uint64_t)0x00061eeabe1f45e5U, (uint64_t)0x0000ad3e2d34cdedU, (uint64_t)0x00010fcc7ed9affeU,
+    (uint64_t)0x0004248cb0e96ff2U, (uint64_t)0x0004311c115172e2U, (uint64_t)0x0004c9d41cbf6925U,
+    (uint64_t)0x00050510fc104f50U, (uint64_t)0x00040fc5336e249dU, (uint64_t)0x0003386639fb2de1U,
+    (uint64_t)0x0007bbf871d17b78U, (uint64_t)0x00075f796b7e8004U, (uint64_t)0x000127c158bf0fa1U,
+    (uint64_t)0x00028fc4ae51b974U, (uint64_t)0x00026e89bfd2dbd4U, (uint64_t)0x0004e122a07665cfU,
+    (uint64_t)0x0007cab1203405c3U, (uint64_t)0x0004ed82479d167dU, (uint64_t)0x00017c422e9879a2U,
+    (uint64_t)0x00028a5946c8fec3U, (uint64_t)0x00053ab32e912b77U, (uint64_t)0x0007b44da09fe0a5U,
+    (uint64_t)0x000354ef87d07ef4U, (uint64_t)0x0003b52260c5d975U, (uint64_t)0x00079d6836171fdcU,
+    (uint64_t)0x0007d994f140d4bbU, (uint64_t)0x0001b6c404561854U, (uint64_t)0x000302d92d205392U,
+    (uint64_t)0x00046fb6e4e0f177U, (uint64_t)0x00053497ad5265b7U, (uint64_t)0x0001ebdba01386fcU,
+    (uint64_t)0x0000302f0cb36a3cU, (uint64_t)0x0000edc5f5eb426dU, (uint64_t)0x0003c1a2bca4283dU,
+    (uint64_t)0x00023430c7bb2f02U, (uint64_t)0x0001a3ea1bb58bc2U, (uint64_t)0x0007265763de5c61U,
+    (uint64_t)0x00010e5d3b76f1caU, (uint64_t)0x0003bfd653da8e67U, (uint64_t)0x000584953ec82a8aU,
+    (uint64_t)0x00055e288fa7707bU, (uint64_t)0x0005395fc3931d81U, (uint64_t)0x00045b46c51361cbU,
+    (uint64_t)0x00054ddd8a7fe3e4U, (uint64_t)0x0002cecc41c619d3U, (uint64_t)0x00043a6562ac4d91U,
+    (uint64_t)0x0004efa5aca7bdd9U, (uint64_t)0x0005c1c0aef32122U, (uint64_t)0x00002abf314f7fa1U,
+    (uint64_t)0x000391d19e8a1528U, (uint64_t)0x0006a2fa13895fc7U, (uint64_t)0x00009d8eddeaa591U,
+    (uint64_t)0x0002177bfa36dcb7U, (uint64_t)0x00001bbcfa79db8fU, (uint64_t)0x0003d84beb3666e1U,
+    (uint64_t)0x00020c921d812204U, (uint64_t)0x0002dd843d3b32ceU, (uint64_t)0x0004ae619387d8abU,
+    (uint64_t)0x00017e44985bfb83U, (uint64_t)0x00054e32c626cc22U, (uint64_t)0x000096412ff38118U,
+    (uint64_t)0x0006b241d61a246aU, (uint64_t)0x00075685abe5ba43U, (uint64_t)0x0003f6aa5344a32eU,
+    (uint64_t)0x00069683680f11bbU, (uint64_t)0x00004c3581f623aaU, (uint64_t)0x000701af5875cba5U,
+    (uint64_t)0x0001a00d91b17bf3U, (uint64_t)0x00060933eb61f2b2U, (uint64_t)0x0005193fe92a4dd2U,
+    (uint64_t)0x0003d995a550f43eU, (uint64_t)0x0003556fb93a883dU, (uint64_t)0x000135529b623b0eU,
+    (uint64_t)0x000716bce22e83feU, (uint64_t)0x00033d0130b83eb8U, (uint64_t)0x0000952abad0afacU,
+    (uint64_t)0x000309f64ed31b8aU, (uint64_t)0x0005972ea051590aU, (uint64_t)0x0000dbd7add1d518U,
+    (uint64_t)0x000119f823e2231eU, (uint64_t)0x000451d66e5e7de2U, (uint64_t)0x000500c39970f838U,
+    (uint64_t)0x00079b5b81a65ca3U, (uint64_t)0x0004ac20dc8f7811U, (uint64_t)0x00029589a9f501faU,
+    (uint64_t)0x0004d810d26a6b4aU, (uint64_t)0x0005ede00d96b259U, (uint64_t)0x0004f7e9c95905f3U,
+    (uint64_t)0x0000443d355299feU, (uint64_t)0x00039b7d7d5aee39U, (uint64_t)0x000692519a2f34ecU,
+    (uint64_t)0x0006e4404924cf78U, (uint64_t)0x0001942eec4a144aU, (uint64_t)0x00074bbc5781302eU,
+    (uint64_t)0x00073135bb81ec4cU, (uint64_t)0x0007ef671b61483cU, (uint64_t)0x0007264614ccd729U,
+    (uint64_t)0x00031993ad92e638U, (uint64_t)0x00045319ae234992U, (uint64_t)0x0002219d47d24fb5U,
+    (uint64_t)0x0004f04488b06cf6U, (uint64_t)0x00053aaa9e724a12U, (uint64_t)0x0002a0a65314ef9cU,
+    (uint64_t)0x00061acd3c1c793aU, (uint64_t)0x00058b46b78779e6U, (uint64_t)0x0003369aacbe7af2U,
+    (uint64_t)0x000509b0743074d4U, (uint64_t)0x000055dc39b6dea1U, (uint64_t)0x0007937ff7f927c2U,
+    (uint64_t)0x0000c2fa14c6a5b6U, (uint64_t)0x000556bddb6dd07cU, (uint64_t)0x0006f6acc179d108U,
+    (uint64_t)0x0004cf6e218647c2U, (uint64_t)0x0001227cc28d5bb6U, (uint64_t)0x00078ee9bff57623U,
+    (uint64_t)0x00028cb2241f893aU, (uint64_t)0x00025b541e3c6772U, (uint64_t)0x000121a307710aa2U,
+    (uint64_t)0x0001713ec77483c9U, (uint64_t)0x0006f70572d5facbU, (uint64_t)0x00025ef34e22ff81U,
+    (uint64_t)0x00054d944f141188U, (uint64_t)0x000527bb94a6ced3U, (uint64_t)0x00035d5e9f034a97U,
+    (uint64_t)0x000126069785bc9bU, (uint64_t)0x0005474ec7854ff0U, (uint64_t)0x000296a302a348caU,
+    (uint64_t)0x000333fc76c7a40eU, (uint64_t)0x0005992a995b482eU, (uint64_t)0x00078dc707002ac7U,
+    (uint64_t)0x0005936394d01741U, (uint64_t)0x0004fba4281aef17U, (uint64_t)0x0006b89069b20a7aU,
+    (uint64_t)0x0002fa8cb5c7db77U, (uint64_t)0x000718e6982aa810U, (uint64_t)0x00039e95f81a1a1bU,
+    (uint64_t)0x0005e794f3646cfbU, (uint64_t)0x0000473d308a7639U, (uint64_t)0x0002a0416270220dU,
+    (uint64_t)0x00075f248b69d025U, (uint64_t)0x0001cbbc16656a27U, (uint64_t)0x0005b9ffd6e26728U,
+    (uint64_t)0x00023bc2103aa73eU, (uint64_t)0x0006792603589e05U, (uint64_t)0x000248db9892595dU,
+    (uint64_t)0x000006a53cad2d08U, (uint64_t)0x00020d0150f7ba73U, (uint64_t)0x000102f73bfde043U,
+    (uint64_t)0x0004dae0b5511c9aU, (uint64_t)0x0005257fffe0d456U, (uint64_t)0x00054108d1eb2180U,
+    (uint64_t)0x000096cc0f9baefaU, (uint64_t)0x0003f6bd725da4eaU, (uint64_t)0x0000b9ab7f5745c6U,
+    (uint64_t)0x0005caf0f8d21d63U, (uint64_t)0x0007debea408ea2bU, (uint64_t)0x00009edb93896d16U,
+    (uint64_t)0x00036597d25ea5c0U, (uint64_t)0x00058d7b106058acU, (uint64_t)0x0003cdf8d20bee69U,
+    (uint64_t)0x00000a4cb765015eU, (uint64_t)0x00036832337c7cc9U, (uint64_t)0x0007b7ecc19da60dU,
+    (uint64_t)0x00064a51a77cfa9bU, (uint64_t)0x00029cf470ca0db5U, (uint64_t)0x0004b60b6e0898d9U,
+    (uint64_t)0x00055d04ddffe6c7U, (uint64_t)0x00003bedc661bf5cU, (uint64_t)0x0002373c695c690dU,
+    (uint64_t)0x0004c0c8520dcf18U, (uint64_t)0x000384af4b7494b9U, (uint64_t)0x0004ab4a8ea22225U,
+    (uint64_t)0x0004235ad7601743U, (uint64_t)0x0000cb0d078975f5U, (uint64_t)0x000292313e530c4bU,
+    (uint64_t)0x00038dbb9124a509U, (uint64_t)0x000350d0655a11f1U, (uint64_t)0x0000e7ce2b0cdf06U,
+    (uint64_t)0x0006fedfd94b70f9U, (uint64_t)0x0002383f9745bfd4U, (uint64_t)0x0004beae27c4c301U,
+    (uint64_t)0x00075aa4416a3f3fU, (uint64_t)0x000615256138aeceU, (uint64_t)0x0004643ac48c85a3U,
+    (uint64_t)0x0006878c2735b892U, (uint64_t)0x0003a53523f4d877U, (uint64_t)0x0003a504ed8bee9dU,
+    (uint64_t)0x000666e0a5d8fb46U, (uint64_t)0x0003f64e4870cb0dU, (uint64_t)0x00061548b16d6557U,
+    (uint64_t)0x0007a261773596f3U, (uint64_t)0x0007724d5f275d3aU, (uint64_t)0x0007f0bc810d514dU,
+    (uint64_t)0x00049dad737213a0U, (uint64_t)0x000745dee5d31075U, (uint64_t)0x0007b1a55e7fdbe2U,
+    (uint64_t)0x0005ba988f176ea1U, (uint64_t)0x0001d3a907ddec5aU, (uint64_t)0x00006ba426f4136fU,
+    (uint64_t)0x0003cafc0606b720U, (uint64_t)0x000518f0a2359cdaU, (uint64_t)0x0005fae5e46feca7U,
+    (uint64_t)0x0000d1f8dbcf8eedU, (uint64_t)0x000693313ed081dcU, (uint64_t)0x0005b0a366901742U,
+    (uint64_t)0x00040c872ca4ca7eU, (uint64_t)0x0006f18094009e01U, (uint64_t)0x00000011b44a31bfU,
+    (uint64_t)0x00061f696a0aa75cU, (uint64_t)0x00038b0a57ad42caU, (uint64_t)0x0001e59ab706fdc9U,
+    (uint64_t)0x00001308d46ebfcdU, (uint64_t)0x00063d988a2d2851U, (uint64_t)0x0007a06c3fc66c0cU,
+    (uint64_t)0x0001c9bac1ba47fbU, (uint64_t)0x00023935c575038eU, (uint64_t)0x0003f0bd71c59c13U,
+    (uint64_t)0x0003ac48d916e835U, (uint64_t)0x00020753afbd232eU, (uint64_t)0x00071fbb1ed06002U,
+    (uint64_t)0x00039cae47a4af3aU, (uint64_t)0x0000337c0b34d9c2U, (uint64_t)0x00033fad52b2368aU,
+    (uint64_t)0x0004c8d0c422cfe8U, (uint64_t)0x000760b4275971a5U, (uint64_t)0x0003da95bc1cad3dU,
+    (uint64_t)0x0000f151ff5b7376U, (uint64_t)0x0003cc355ccb90a7U, (uint64_t)0x000649c6c5e41e16U,
+    (uint64_t)0x00060667eee6aa80U, (uint64_t)0x0004179d182be190U, (uint64_t)0x000653d9567e6979U,
+    (uint64_t)0x00016c0f429a256dU, (uint64_t)0x00069443903e9131U, (uint64_t)0x00016f4ac6f9dd36U,
+    (uint64_t)0x0002ea4912e29253U, (uint64_t)0x0002b4643e68d25dU, (uint64_t)0x000631eaf426bae7U,
+    (uint64_t)0x000175b9a3700de8U, (uint64_t)0x00077c5f00aa48fbU, (uint64_t)0x0003917785ca0317U,
+    (uint64_t)0x00005aa9b2c79399U, (uint64_t)0x000431f2c7f665f8U, (uint64_t)0x00010410da66fe9fU,
+    (uint64_t)0x00024d82dcb4d67dU, (uint64_t)0x0003e6fe0e17752dU, (uint64_t)0x0004dade1ecbb08fU,
+    (uint64_t)0x0005599648b1ea91U, (uint64_t)0x00026344858f7b19U, (uint64_t)0x0005f43d4a295ac0U,
+    (uint64_t)0x000242a75c52acd4U, (uint64_t)0x0005934480220d10U, (uint64_t)0x0007b04715f91253U,
+    (uint64_t)0x0006c280c4e6bac6U, (uint64_t)0x0003ada3b361766eU, (uint64_t)0x00042fe5125c3b4fU,
+    (uint64_t)0x000111d84d4aac22U, (uint64_t)0x00048d0acfa57cdeU, (uint64_t)0x0005bd28acf6ae43U,
+    (uint64_t)0x00016fab8f56907dU, (uint64_t)0x0007acb11218d5f2U, (uint64_t)0x00041fe02023b4dbU,
+    (uint64_t)0x00059b37bf5c2f65U, (uint64_t)0x000726e47dabe671U, (uint64_t)0x0002ec45e746f6c1U,
+    (uint64_t)0x0006580e53c74686U, (uint64_t)0x0005eda104673f74U, (uint64_t)0x00016234191336d3U,
+    (uint64_t)0x00019cd61ff38640U, (uint64_t)0x000060c6c4b41ba9U, (uint64_t)0x00075cf70ca7366fU,
+    (uint64_t)0x000118a8f16c011eU, (uint64_t)0x0004a25707a203b9U, (uint64_t)0x000499def6267ff6U,
+    (uint64_t)0x00076e858108773cU, (uint64_t)0x000693cac5ddcb29U, (uint64_t)0x00000311d00a9ff4U,
+    (uint64_t)0x0002cdfdfecd5d05U, (uint64_t)0x0007668a53f6ed6aU, (uint64_t)0x000303ba2e142556U,
+    (uint64_t)0x0003880584c10909U, (uint64_t)0x0004fe20000a261dU, (uint64_t)0x0005721896d248e4U,
+    (uint64_t)0x00055091a1d0da4eU, (uint64_t)0x0004f6bfc7c1050bU, (uint64_t)0x00064e4ecd2ea9beU,
+    (uint64_t)0x00007eb1f28bbe70U, (uint64_t)0x00003c935afc4b03U, (uint64_t)0x00065517fd181baeU,
+    (uint64_t)0x0003e5772c76816dU, (uint64_t)0x000019189640898aU, (uint64_t)0x0001ed2a84de7499U,
+    (uint64_t)0x000578edd74f63c1U, (uint64_t)0x000276c6492b0c3dU, (uint64_t)0x00009bfc40bf932eU,
+    (uint64_t)0x000588e8f11f330bU, (uint64_t)0x0003d16e694dc26eU, (uint64_t)0x0003ec2ab590288cU,
+    (uint64_t)0x00013a09ae32d1cbU, (uint64_t)0x0003e81eb85ab4e4U, (uint64_t)0x00007aaca43cae1fU,
+    (uint64_t)0x00062f05d7526374U, (uint64_t)0x0000e1bf66c6adbaU, (uint64_t)0x0000d27be4d87bb9U,
+    (uint64_t)0x00056c27235db434U, (uint64_t)0x00072e6e0ea62d37U, (uint64_t)0x0005674cd06ee839U,
+    (uint64_t)0x0002dd5c25a200fcU, (uint64_t)0x0003d5e9792c887eU, (uint64_t)0x000319724dabbc55U,
+    (uint64_t)0x0002b97c78680800U, (uint64_t)0x0007afdfdd34e6ddU, (uint64_t)0x000730548b35ae88U,
+    (uint64_t)0x0003094ba1d6e334U, (uint64_t)0x0006e126a7e3300bU, (uint64_t)0x000089c0aefcfbc5U,
+    (uint64_t)0x0002eea11f836583U, (uint64_t)0x000585a2277d8784U, (uint64_t)0x000551a3cba8b8eeU,
+    (uint64_t)0x0003b6422be2d886U, (uint64_t)0x000630e1419689bcU, (uint64_t)0x0004653b07a7a955U,
+    (uint64_t)0x0003043443b411dbU, (uint64_t)0x00025f8233d48962U, (uint64_t)0x0006bd8f04aff431U,
+    (uint64_t)0x0004f907fd9a6312U, (uint64_t)0x00040fd3c737d29bU, (uint64_t)0x0007656278950ef9U,
+    (uint64_t)0x000073a3ea86cf9dU, (uint64_t)0x0006e0e2abfb9c2eU, (uint64_t)0x00060e2a38ea33eeU,
+    (uint64_t)0x00030b2429f3fe18U, (uint64_t)0x00028bbf484b613fU, (uint64_t)0x0003cf59d51fc8c0U,
+    (uint64_t)0x0007a0a0d6de4718U, (uint64_t)0x00055c3a3e6fb74bU, (uint64_t)0x000353135f884fd5U,
+    (uint64_t)0x0003f4160a8c1b84U, (uint64_t)0x00012f5c6f136c7cU, (uint64_t)0x0000fedba237de4cU,
+    (uint64_t)0x000779bccebfab44U, (uint64_t)0x0003aea93f4d6909U, (uint64_t)0x0001e79cb358188fU,
+    (uint64_t)0x000153d8f5e08181U, (uint64_t)0x00008533bbdb2efdU, (uint64_t)0x0001149796129431U,
+    (uint64_t)0x00017a6e36168643U, (uint64_t)0x000478ab52d39d1fU, (uint64_t)0x000436c3eef7e3f1U,
+    (uint64_t)0x0007ffd3c21f0026U, (uint64_t)0x0003e77bf20a2da9U, (uint64_t)0x000418bffc8472deU,
+    (uint64_t)0x00065d7951b3a3b3U, (uint64_t)0x0006a4d39252d159U, (uint64_t)0x000790e35900ecd4U,
+    (uint64_t)0x00030725bf977786U, (uint64_t)0x00010a5c1635a053U, (uint64_t)0x00016d87a411a212U,
+    (uint64_t)0x0004d5e2d54e0583U, (uint64_t)0x0002e5d7b33f5f74U, (uint64_t)0x0003a5de3f887ebfU,
+    (uint64_t)0x0006ef24bd6139b7U, (uint64_t)0x0001f990b577a5a6U, (uint64_t)0x00057e5a42066215U,
+    (uint64_t)0x0001a18b44983677U, (uint64_t)0x0003e652de1e6f8fU, (uint64_t)0x0006532be02ed8ebU,
+    (uint64_t)0x00028f87c8165f38U, (uint64_t)0x00044ead1be8f7d6U, (uint64_t)0x0005759d4f31f466U,
+    (uint64_t)0x0000378149f47943U, (uint64_t)0x00069f3be32b4f29U, (uint64_t)0x00045882fe1534d6U,
+    (uint64_t)0x00049929943c6fe4U, (uint64_t)0x0004347072545b15U, (uint64_t)0x0003226bced7e7c5U,
+    (uint64_t)0x00003a134ced89dfU, (uint64_t)0x0007dcf843ce405fU, (uint64_t)0x0001345d757983d6U,
+    (uint64_t)0x000222f54234cccdU, (uint64_t)0x0001784a3d8adbb4U, (uint64_t)0x00036ebeee8c2bccU,
+    (uint64_t)0x000688fe5b8f626fU, (uint64_t)0x0000d6484a4732c0U, (uint64_t)0x0007b94ac6532d92U,
+    (uint64_t)0x0005771b8754850fU, (uint64_t)0x00048dd9df1461c8U, (uint64_t)0x0006739687e73271U,
+    (uint64_t)0x0005cc9dc80c1ac0U, (uint64_t)0x000683671486d4cdU, (uint64_t)0x00076f5f1a5e8173U,
+    (uint64_t)0x0006d5d3f5f9df4aU, (uint64_t)0x0007da0b8f68d7e7U, (uint64_t)0x00002014385675a6U,
+    (uint64_t)0x0006155fb53d1defU, (uint64_t)0x00037ea32e89927cU, (uint64_t)0x000059a668f5a82eU,
+    (uint64_t)0x00046115aba1d4dcU, (uint64_t)0x00071953c3b5da76U, (uint64_t)0x0006642233d37a81U,
+    (uint64_t)0x0002c9658076b1bdU, (uint64_t)0x0005a581e63010ffU, (uint64_t)0x0005a5f887e83674U,
+    (uint64_t)0x000628d3a0a643b9U, (uint64_t)0x00001cd8640c93d2U, (uint64_t)0x0000b7b0cad70f2cU,
+    (uint64_t)0x0003864da98144beU, (uint64_t)0x00043e37ae2d5d1cU, (uint64_t)0x000301cf70a13d11U,
+    (uint64_t)0x0002a6a1ba1891ecU, (uint64_t)0x0002f291fb3f3ae0U, (uint64_t)0x00021a7b814bea52U,
+    (uint64_t)0x0003669b656e44d1U, (uint64_t)0x00063f06eda6e133U, (uint64_t)0x000233342758070fU,
+    (uint64_t)0x000098e0459cc075U, (uint64_t)0x0004df5ead6c7c1bU, (uint64_t)0x0006a21e6cd4fd5eU,
+    (uint64_t)0x000129126699b2e3U, (uint64_t)0x0000ee11a2603de8U, (uint64_t)0x00060ac2f5c74c21U,
+    (uint64_t)0x00059b192a196808U, (uint64_t)0x00045371b07001e8U, (uint64_t)0x0006170a3046e65fU,
+    (uint64_t)0x0005401a46a49e38U, (uint64_t)0x00020add5561c4a8U, (uint64_t)0x0007abb4edde9e46U,
+    (uint64_t)0x000586bf9f1a195fU, (uint64_t)0x0003088d5ef8790bU, (uint64_t)0x00038c2126fcb4dbU,
+    (uint64_t)0x000685bae149e3c3U, (uint64_t)0x0000bcd601a4e930U, (uint64_t)0x0000eafb03790e52U,
+    (uint64_t)0x0000805e0f75ae1dU, (uint64_t)0x000464cc59860a28U, (uint64_t)0x000248e5b7b00befU,
+    (uint64_t)0x0005d99675ef8f75U, (uint64_t)0x00044ae3344c5435U, (uint64_t)0x000555c13748042fU,
+    (uint64_t)0x0004d041754232c0U, (uint64_t)0x000521b430866907U, (uint64_t)0x0003308e40fb9c39U,
+    (uint64_t)0x000309acc675a02cU, (uint64_t)0x000289b9bba543eeU, (uint64_t)0x0003ab592e28539eU,
+    (uint64_t)0x00064d82abcdd83aU, (uint64_t)0x0003c78ec172e327U, (uint64_t)0x00062d5221b7f946U,
+    (uint64_t)0x0005d4263af77a3cU, (uint64_t)0x00023fdd2289aeb0U, (uint64_t)0x0007dc64f77eb9ecU,
+    (uint64_t)0x00001bd28338402cU, (uint64_t)0x00014f29a5383922U, (uint64_t)0x0004299c18d0936dU,
+    (uint64_t)0x0005914183418a49U, (uint64_t)0x00052a18c721aed5U, (uint64_t)0x0002b151ba82976dU,
+    (uint64_t)0x0005c0efde4bc754U, (uint64_t)0x00017edc25b2d7f5U, (uint64_t)0x00037336a6081beeU,
+    (uint64_t)0x0007b5318887e5c3U, (uint64_t)0x00049f6d491a5be1U, (uint64_t)0x0005e72365c7bee0U,
+    (uint64_t)0x000339062f08b33eU, (uint64_t)0x0004bbf3e657cfb2U, (uint64_t)0x00067af7f56e5967U,
+    (uint64_t)0x0004dbd67f9ed68fU, (uint64_t)0x00070b20555cb734U, (uint64_t)0x0003fc074571217fU,
+    (uint64_t)0x0003a0d29b2b6aebU, (uint64_t)0x00006478ccdde59dU, (uint64_t)0x00055e4d051bddfaU,
+    (uint64_t)0x00077f1104c47b4eU, (uint64_t)0x000113c555112c4cU, (uint64_t)0x0007535103f9b7caU,
+    (uint64_t)0x000140ed1d9a2108U, (uint64_t)0x00002522333bc2afU, (uint64_t)0x0000e34398f4a064U,
+    (uint64_t)0x00030b093e4b1928U, (uint64_t)0x0001ce7e7ec80312U, (uint64_t)0x0004e575bdf78f84U,
+    (uint64_t)0x00061f7a190bed39U, (uint64_t)0x0006f8aded6ca379U, (uint64_t)0x000522d93ecebde8U,
+    (uint64_t)0x000024f045e0f6cfU, (uint64_t)0x00016db63426cfa1U, (uint64_t)0x0001b93a1fd30fd8U,
+    (uint64_t)0x0005e5405368a362U, (uint64_t)0x0000123dfdb7b29aU, (uint64_t)0x0004344356523c68U,
+    (uint64_t)0x00079a527921ee5fU, (uint64_t)0x00074bfccb3e817eU, (uint64_t)0x000780de72ec8d3dU,
+    (uint64_t)0x0007eaf300f42772U, (uint64_t)0x0005455188354ce3U, (uint64_t)0x0004dcca4a3dcbacU,
+    (uint64_t)0x0003d314d0bfebcbU, (uint64_t)0x0001defc6ad32b58U, (uint64_t)0x00028545089ae7bcU,
+    (uint64_t)0x0001e38fe9a0c15cU, (uint64_t)0x00012046e0e2377bU, (uint64_t)0x0006721c560aa885U,
+    (uint64_t)0x0000eb28bf671928U, (uint64_t)0x0003be1aef5195a7U, (uint64_t)0x0006f22f62bdb5ebU,
+    (uint64_t)0x00039768b8523049U, (uint64_t)0x00043394c8fbfdbdU, (uint64_t)0x000467d201bf8dd2U,
+    (uint64_t)0x0006f4bd567ae7a9U, (uint64_t)0x00065ac89317b783U, (uint64_t)0x00007d3b20fd8932U,
+    (uint64_t)0x000000f208326916U, (uint64_t)0x0002ef9c5a5ba384U, (uint64_t)0x0006919a74ef4fadU,
+    (uint64_t)0x00059ed4611452bfU, (uint64_t)0x000691ec04ea09efU, (uint64_t)0x0003cbcb2700e984U,
+    (uint64_t)0x00071c43c4f5ba3cU, (uint64_t)0x00056df6fa9e74cdU, (uint64_t)0x00079c95e4cf56dfU,
+    (uint64_t)0x0007be643bc609e2U, (uint64_t)0x000149c12ad9e878U, (uint64_t)0x0005a758ca390c5fU,
+    (uint64_t)0x0000918b1d61dc94U, (uint64_t)0x0000d350260cd19cU, (uint64_t)0x0007a2ab4e37b4d9U,
+    (uint64_t)0x00021fea735414d7U, (uint64_t)0x0000a738027f639dU, (uint64_t)0x00072710d9462495U,
+    (uint64_t)0x00025aafaa007456U, (uint64_t)0x0002d21f28eaa31bU, (uint64_t)0x00017671ea005fd0U,
+    (uint64_t)0x0002dbae244b3eb7U, (uint64_t)0x00074a2f57ffe1ccU, (uint64_t)0x0001bc3073087301U,
+    (uint64_t)0x0007ec57f4019c34U, (uint64_t)0x00034e082e1fa524U, (uint64_t)0x0002698ca635126aU,
+    (uint64_t)0x0005702f5e3dd90eU, (uint64_t)0x00031c9a4a70c5c7U, (uint64_t)0x000136a5aa78fc24U,
+    (uint64_t)0x0001992f3b9f7b01U, (uint64_t)0x0003c004b0c4afa3U, (uint64_t)0x0005318832b0ba78U,
+    (uint64_t)0x0006f24b9ff17cecU, (uint64_t)0x0000a47f30e060c7U, (uint64_t)0x00058384540dc8d0U,
+    (uint64_t)0x0001fb43dcc49caeU, (uint64_t)0x000146ac06f4b82bU, (uint64_t)0x0004b500d89e7355U,
+    (uint64_t)0x0003351e1c728a12U, (uint64_t)0x00010b9f69932fe3U, (uint64_t)0x0006b43fd01cd1fdU,
+    (uint64_t)0x000742583e760ef3U, (uint64_t)0x00073dc1573216b8U, (uint64_t)0x0004ae48fdd7714aU,
+    (uint64_t)0x0004f85f8a13e103U, (uint64_t)0x00073420b2d6ff0dU, (uint64_t)0x00075d4b4697c544U,
+    (uint64_t)0x00011be1fff7f8f4U, (uint64_t)0x000119e16857f7e1U, (uint64_t)0x00038a14345cf5d5U,
+    (uint64_t)0x0005a68d7105b52fU, (uint64_t)0x0004f6cb9e851e06U, (uint64_t)0x000278c4471895e5U,
+    (uint64_t)0x0007efcdce3d64e4U, (uint64_t)0x00064f6d455c4b4cU, (uint64_t)0x0003db5632fea34bU,
+    (uint64_t)0x000190b1829825d5U, (uint64_t)0x0000e7d3513225c9U, (uint64_t)0x0001c12be3b7abaeU,
+    (uint64_t)0x00058777781e9ca6U, (uint64_t)0x00059197ea495df2U, (uint64_t)0x0006ee2bf75dd9d8U,
+    (uint64_t)0x0006c72ceb34be8dU, (uint64_t)0x000679c9cc345ec7U, (uint64_t)0x0007898df96898a4U,
+    (uint64_t)0x00004321adf49d75U, (uint64_t)0x00016019e4e55aaeU, (uint64_t)0x00074fc5f25d209cU,
+    (uint64_t)0x0004566a939ded0dU, (uint64_t)0x00066063e716e0b7U, (uint64_t)0x00045eafdc1f4d70U,
+    (uint64_t)0x00064624cfccb1edU, (uint64_t)0x000257ab8072b6c1U, (uint64_t)0x0000120725676f0aU,
+    (uint64_t)0x0004a018d04e8eeeU, (uint64_t)0x0003f73ceea5d56dU, (uint64_t)0x000401858045d72bU,
+    (uint64_t)0x000459e5e0ca2d30U, (uint64_t)0x000488b719308beaU, (uint64_t)0x00056f4a0d1b32b5U,
+    (uint64_t)0x0005a5eebc80362dU, (uint64_t)0x0007bfd10a4e8dc6U, (uint64_t)0x0007c899366736f4U,
+    (uint64_t)0x00055ebbeaf95c01U, (uint64_t)0x00046db060903f8aU, (uint64_t)0x0002605889126621U,
+    (uint64_t)0x00018e3cc676e542U, (uint64_t)0x00026079d995a990U, (uint64_t)0x00004a7c217908b2U,
+    (uint64_t)0x0001dc7603e6655aU, (uint64_t)0x0000dedfa10b2444U, (uint64_t)0x000704a68360ff04U,
+    (uint64_t)0x0003cecc3cde8b3eU, (uint64_t)0x00021cd5470f64ffU, (uint64_t)0x0006abc18d953989U,
+    (uint64_t)0x00054ad0c2e4e615U, (uint64_t)0x000367d5b82b522aU, (uint64_t)0x0000d3f4b83d7dc7U,
+    (uint64_t)0x0003067f4cdbc58dU, (uint64_t)0x00020452da697937U, (uint64_t)0x00062ecb2baa77a9U,
+    (uint64_t)0x00072836afb62874U, (uint64_t)0x0000af3c2094b240U, (uint64_t)0x0000c285297f357aU,
+    (uint64_t)0x0007cc2d5680d6e3U, (uint64_t)0x00061913d5075663U, (uint64_t)0x0005795261152b3dU,
+    (uint64_t)0x0007a1dbbafa3cbdU, (uint64_t)0x0005ad31c52588d5U, (uint64_t)0x00045f3a4164685cU,
+    (uint64_t)0x0002e59f919a966dU, (uint64_t)0x00062d361a3231daU, (uint64_t)0x00065284004e01b8U,
+    (uint64_t)0x000656533be91d60U, (uint64_t)0x0006ae016c00a89fU, (uint64_t)0x0003ddbc2a131c05U,
+    (uint64_t)0x000257a22796bb14U, (uint64_t)0x0006f360fb443e75U, (uint64_t)0x000680e47220eaeaU,
+    (uint64_t)0x0002fcf2a5f10c18U, (uint64_t)0x0005ee7fb38d8320U, (uint64_t)0x00040ff9ce5ec54bU,
+    (uint64_t)0x00057185e261b35bU, (uint64_t)0x0003e254540e70a9U, (uint64_t)0x0001b5814003e3f8U,
+    (uint64_t)0x00078968314ac04bU, (uint64_t)0x0005fdcb41446a8eU, (uint64_t)0x0005286926ff2a71U,
+    (uint64_t)0x0000f231e296b3f6U, (uint64_t)0x000684a357c84693U, (uint64_t)0x00061d0633c9bca0U,
+    (uint64_t)0x000328bcf8fc73dfU, (uint64_t)0x0003b4de06ff95b4U, (uint64_t)0x00030aa427ba11a5U,
+    (uint64_t)0x0005ee31bfda6d9cU, (uint64_t)0x0005b23ac2df8067U, (uint64_t)0x00044935ffdb2566U,
+    (uint64_t)0x00012f016d176c6eU, (uint64_t)0x0004fbb00f16f5aeU, (uint64_t)0x0003fab78d99402aU,
+    (uint64_t)0x0006e965fd847aedU, (uint64_t)0x0002b953ee80527bU, (uint64_t)0x00055f5bcdb1b35aU,
+    (uint64_t)0x00043a0b3fa23c66U, (uint64_t)0x00076e07388b820aU, (uint64_t)0x00079b9bbb9dd95dU,
+    (uint64_t)0x00017dae8e9f7374U, (uint64_t)0x000719f76102da33U, (uint64_t)0x0005117c2a80ca8bU,
+    (uint64_t)0x00041a66b65d0936U, (uint64_t)0x0001ba811460accbU, (uint64_t)0x000355406a3126c2U,
+    (uint64_t)0x00050d1918727d76U, (uint64_t)0x0006e5ea0b498e0eU, (uint64_t)0x0000a3b6063214f2U,
+    (uint64_t)0x0005065f158c9fd2U, (uint64_t)0x000169fb0c429954U, (uint64_t)0x00059aedd9ecee10U,
+    (uint64_t)0x00039916eb851802U, (uint64_t)0x00057917555cc538U, (uint64_t)0x0003981f39e58a4fU,
+    (uint64_t)0x0005dfa56de66fdeU, (uint64_t)0x0000058809075908U, (uint64_t)0x0006d3d8cb854a94U,
+    (uint64_t)0x0005b2f4e970b1e3U, (uint64_t)0x00030f4452edcbc1U, (uint64_t)0x00038a7559230a93U,
+    (uint64_t)0x00052c1cde8ba31fU, (uint64_t)0x0002a4f2d4745a3dU, (uint64_t)0x00007e9d42d4a28aU,
+    (uint64_t)0x00038dc083705acdU, (uint64_t)0x00052782c5759740U, (uint64_t)0x00053f3397d990adU,
+    (uint64_t)0x0003a939c7e84d15U, (uint64_t)0x000234c4227e39e0U, (uint64_t)0x000632d9a1a593f2U,
+    (uint64_t)0x0001fd11ed0c84a7U, (uint64_t)0x000021b3ed2757e1U, (uint64_t)0x00073e1de58fc1c6U,
+    (uint64_t)0x0005d110c84616abU, (uint64_t)0x0003a5a7df28af64U, (uint64_t)0x00036b15b807cba6U,
+    (uint64_t)0x0003f78a9e1afed7U, (uint64_t)0x0000a59c2c608f1fU, (uint64_t)0x00052bdd8ecb81b7U,
+    (uint64_t)0x0000b24f48847ed4U, (uint64_t)0x0002d4be511beac7U, (uint64_t)0x0006bda4d99e5b9bU,
+    (uint64_t)0x00017e6996914e01U, (uint64_t)0x0007b1f0ce7fcf80U, (uint64_t)0x00034fcf74475481U,
+    (uint64_t)0x00031dab78cfaa98U, (uint64_t)0x0004e3216e5e54b7U, (uint64_t)0x000249823973b689U,
+    (uint64_t)0x0002584984e48885U, (uint64_t)0x0000119a3042fb37U, (uint64_t)0x0007e04c789767caU,
+    (uint64_t)0x0001671b28cfb832U, (uint64_t)0x0007e57ea2e1c537U, (uint64_t)0x0001fbaaef444141U,
+    (uint64_t)0x0003d3bdc164dfa6U, (uint64_t)0x0002d89ce8c2177dU, (uint64_t)0x0006cd12ba182cf4U,
+    (uint64_t)0x00020a8ac19a7697U, (uint64_t)0x000539fab2cc72d9U, (uint64_t)0x00056c088f1ede20U,
+    (uint64_t)0x00035fac24f38f02U, (uint64_t)0x0007d75c6197ab03U, (uint64_t)0x00033e4bc2a42fa7U,
+    (uint64_t)0x0001c7cd10b48145U, (uint64_t)0x000038b7ea483590U, (uint64_t)0x00053d1110a86e17U,
+    (uint64_t)0x0006416eb65f466dU, (uint64_t)0x00041ca6235fce20U, (uint64_t)0x0005c3fc8a99bb12U,
+    (uint64_t)0x00009674c6b99108U, (uint64_t)0x0006f82199316ff8U, (uint64_t)0x00005d54f1a9f3e9U,
+    (uint64_t)0x0003bcc5d0bd274aU, (uint64_t)0x0005b284b8d2d5adU, (uint64_t)0x0006e5e31025969eU,
+    (uint64_t)0x0004fb0e63066222U, (uint64_t)0x000130f59747e660U, (uint64_t)0x000041868fecd41aU,
+    (uint64_t)0x0003105e8c923bc6U, (uint64_t)0x0003058ad43d1838U, (uint64_t)0x000462f587e593fbU,
+    (uint64_t)0x0003d94ba7ce362dU, (uint64_t)0x000330f9b52667b7U, (uint64_t)0x0005d45a48e0f00aU,
+    (uint64_t)0x00008f5114789a8dU, (uint64_t)0x00040ffde57663d0U, (uint64_t)0x00071445d4c20647U,
+    (uint64_t)0x0002653e68170f7cU, (uint64_t)0x00064cdee3c55ed6U, (uint64_t)0x00026549fa4efe3dU,
+    (uint64_t)0x00068549af3f666eU, (uint64_t)0x00009e2941d4bb68U, (uint64_t)0x0002e8311f5dff3cU,
+    (uint64_t)0x0006429ef91ffbd2U, (uint64_t)0x0003a10dfe132ce3U, (uint64_t)0x00055a461e6bf9d6U,
+    (uint64_t)0x00078eeef4b02e83U, (uint64_t)0x0001d34f648c16cfU, (uint64_t)0x00007fea2aba5132U,
+    (uint64_t)0x0001926e1dc6401eU, (uint64_t)0x00074e8aea17cea0U, (uint64_t)0x0000c743f83fbc0fU,
+    (uint64_t)0x0007cb03c4bf5455U, (uint64_t)0x00068a8ba9917e98U, (uint64_t)0x0001fa1d01d861e5U,
+    (uint64_t)0x0004ac00d1df94abU, (uint64_t)0x0003ba2101bd271bU, (uint64_t)0x0007578988b9c4afU,
+    (uint64_t)0x0000f2bf89f49f7eU, (uint64_t)0x00073fced18ee9a0U, (uint64_t)0x000055947d599832U,
+    (uint64_t)0x000346fe2aa41990U, (uint64_t)0x0000164c8079195bU, (uint64_t)0x000799ccfb7bba27U,
+    (uint64_t)0x000773563bc6a75cU, (uint64_t)0x0001e90863139cb3U, (uint64_t)0x0004f8b407d9a0d6U,
+    (uint64_t)0x00058e24ca924f69U, (uint64_t)0x0007a246bbe76456U, (uint64_t)0x0001f426b701b864U,
+    (uint64_t)0x000635c891a12552U, (uint64_t)0x00026aebd38ede2fU, (uint64_t)0x00066dc8faddae05U,
+    (uint64_t)0x00021c7d41a03786U, (uint64_t)0x0000b76bb1b3fa7eU, (uint64_t)0x0001264c41911c01U,
+    (uint64_t)0x000702f44584bdf9U, (uint64_t)0x00043c511fc68edeU, (uint64_t)0x0000482c3aed35f9U,
+    (uint64_t)0x0004e1af5271d31bU, (uint64_t)0x0000c1f97f92939bU, (uint64_t)0x00017a88956dc117U,
+    (uint64_t)0x0006ee005ef99dc7U, (uint64_t)0x0004aa9172b231ccU, (uint64_t)0x0007b6dd61eb772aU,
+    (uint64_t)0x0000abf9ab01d2c7U, (uint64_t)0x0003880287630ae6U, (uint64_t)0x00032eca045beddbU,
+    (uint64_t)0x00057f43365f32d0U, (uint64_t)0x00053fa9b659bff6U, (uint64_t)0x0005c1e850f33d92U,
+    (uint64_t)0x0001ec119ab9f6f5U, (uint64_t)0x0007f16f6de663e9U, (uint64_t)0x0007a7d6cb16dec6U,
+    (uint64_t)0x000703e9bceaf1d2U, (uint64_t)0x0004c8e994885455U, (uint64_t)0x0004ccb5da9cad82U,
+    (uint64_t)0x0003596bc610e975U, (uint64_t)0x0007a80c0ddb9f5eU, (uint64_t)0x000398d93e5c4c61U,
+    (uint64_t)0x00077c60d2e7e3f2U, (uint64_t)0x0004061051763870U, (uint64_t)0x00067bc4e0ecd2aaU,
+    (uint64_t)0x0002bb941f1373b9U, (uint64_t)0x000699c9c9002c30U, (uint64_t)0x0003d16733e248f3U,
+    (uint64_t)0x0000e2b7e14be389U, (uint64_t)0x00042c0ddaf6784aU, (uint64_t)0x000589ea1fc67850U,
+    (uint64_t)0x00053b09b5ddf191U, (uint64_t)0x0006a7235946f1ccU, (uint64_t)0x0006b99cbb2fbe60U,
+    (uint64_t)0x0006d3a5d6485c62U, (uint64_t)0x0004839466e923c0U, (uint64_t)0x00051caf30c6fcddU,
+    (uint64_t)0x0002f99a18ac54c7U, (uint64_t)0x000398a39661ee6fU, (uint64_t)0x000384331e40cde3U,
+    (uint64_t)0x0004cd15c4de19a6U, (uint64_t)0x00012ae29c189f8eU, (uint64_t)0x0003a7427674e00aU,
+    (uint64_t)0x0006142f4f7e74c1U, (uint64_t)0x0004cc93318c3a15U, (uint64_t)0x0006d51bac2b1ee7U,
+    (uint64_t)0x0005504aa292383fU, (uint64_t)0x0006c0cb1f0d01cfU, (uint64_t)0x000187469ef5d533U,
+    (uint64_t)0x00027138883747bfU, (uint64_t)0x0002f52ae53a90e8U, (uint64_t)0x0005fd14fe958ebaU,
+    (uint64_t)0x0002fe5ebf93cb8eU, (uint64_t)0x000226da8acbe788U, (uint64_t)0x00010883a2fb7ea1U,
+    (uint64_t)0x000094707842cf44U, (uint64_t)0x0007dd73f960725dU, (uint64_t)0x00042ddf2845ab2cU,
+    (uint64_t)0x0006214ffd3276bbU, (uint64_t)0x00000b8d181a5246U, (uint64_t)0x000268a6d579eb20U,
+    (uint64_t)0x000093ff26e58647U, (uint64_t)0x000524fe68059829U, (uint64_t)0x00065b75e47cb621U,
+    (uint64_t)0x00015eb0a5d5cc19U, (uint64_t)0x00005209b3929d5aU, (uint64_t)0x0002f59bcbc86b47U,
+    (uint64_t)0x0001d560b691c301U, (uint64_t)0x0007f5bafce3ce08U, (uint64_t)0x0004cd561614806cU,
+    (uint64_t)0x0004588b6170b188U, (uint64_t)0x0002aa55e3d01082U, (uint64_t)0x00047d429917135fU,
+    (uint64_t)0x0003eacfa07af070U, (uint64_t)0x0001deab46b46e44U, (uint64_t)0x0007a53f3ba46cdfU,
+    (uint64_t)0x0005458b42e2e51aU, (uint64_t)0x000192e60c07444fU, (uint64_t)0x0005ae8843a21daaU,
+    (uint64_t)0x0006d721910b1538U, (uint64_t)0x0003321a95a6417eU, (uint64_t)0x00013e9004a8a768U,
+    (uint64_t)0x000600c9193b877fU, (uint64_t)0x00021c1b8a0d7765U, (uint64_t)0x000379927fb38ea2U,
+    (uint64_t)0x00070d7679dbe01bU, (uint64_t)0x0005f46040898de9U, (uint64_t)0x00058845832fcedbU,
+    (uint64_t)0x000135cd7f0c6e73U, (uint64_t)0x00053ffbdfe8e35bU, (uint64_t)0x00022f195e06e55bU,
+    (uint64_t)0x00073937e8814bceU, (uint64_t)0x00037116297bf48dU, (uint64_t)0x00045a9e0d069720U,
+    (uint64_t)0x00025af71aa744ecU, (uint64_t)0x00041af0cb8aaba3U, (uint64_t)0x0002cf8a4e891d5eU,
+    (uint64_t)0x0005487e17d06ba2U, (uint64_t)0x0003872a032d6596U, (uint64_t)0x00065e28c09348e0U,
+    (uint64_t)0x00027b6bb2ce40c2U, (uint64_t)0x0007a6f7f2891d6aU, (uint64_t)0x0003fd8707110f67U,
+    (uint64_t)0x00026f8716a92db2U, (uint64_t)0x0001cdaa1b753027U, (uint64_t)0x000504be58b52661U,
+    (uint64_t)0x0002049bd6e58252U, (uint64_t)0x0001fd8d6a9aef49U, (uint64_t)0x0007cb67b7216fa1U,
+    (uint64_t)0x00067aff53c3b982U, (uint64_t)0x00020ea610da9628U, (uint64_t)0x0006011aadfc5459U,
+    (uint64_t)0x0006d0c802cbf890U, (uint64_t)0x000141bfed554c7bU, (uint64_t)0x0006dbb667ef4263U,
+    (uint64_t)0x00058f3126857edcU, (uint64_t)0x00069ce18b779340U, (uint64_t)0x0007926dcf95f83cU,
+    (uint64_t)0x00042e25120e2becU, (uint64_t)0x00063de96df1fa15U, (uint64_t)0x0004f06b50f3f9ccU,
+    (uint64_t)0x0006fc5cc1b0b62fU, (uint64_t)0x00075528b29879cbU, (uint64_t)0x00079a8fd2125a3dU,
+    (uint64_t)0x00027c8d4b746ab8U, (uint64_t)0x0000f8893f02210cU, (uint64_t)0x00015596b3ae5710U,
+    (uint64_t)0x000731167e5124caU, (uint64_t)0x00017b38e8bbe13fU, (uint64_t)0x0003d55b942f9056U,
+    (uint64_t)0x00009c1495be913fU, (uint64_t)0x0003aa4e241afb6dU, (uint64_t)0x000739d23f9179a2U,
+    (uint64_t)0x000632fadbb9e8c4U, (uint64_t)0x0007c8522bfe0c48U, (uint64_t)0x0006ed0983ef5aa9U,
+    (uint64_t)0x0000d2237687b5f4U, (uint64_t)0x000138bf2a3305f5U, (uint64_t)0x0001f45d24d86598U,
+    (uint64_t)0x0005274bad2160feU, (uint64_t)0x0001b6041d58d12aU, (uint64_t)0x00032fcaa6e4687aU,
+    (uint64_t)0x0007a4732787ccdfU, (uint64_t)0x00011e427c7f0640U, (uint64_t)0x00003659385f8c64U,
+    (uint64_t)0x0005f4ead9766bfbU, (uint64_t)0x000746f6336c2600U, (uint64_t)0x00056e8dc57d9af5U,
+    (uint64_t)0x0005b3be17be4f78U, (uint64_t)0x0003bf928cf82f4bU, (uint64_t)0x00052e55600a6f11U,
+    (uint64_t)0x0004627e9cefebd6U, (uint64_t)0x0002f345ab6c971cU, (uint64_t)0x000653286e63e7e9U,
+    (uint64_t)0x00051061b78a23adU, (uint64_t)0x00014999acb54501U, (uint64_t)0x0007b4917007ed66U,
+    (uint64_t)0x00041b28dd53a2ddU, (uint64_t)0x00037be85f87ea86U, (uint64_t)0x00074be3d2a85e41U,
+    (uint64_t)0x0001be87fac96ca6U, (uint64_t)0x0001d03620fe08cdU, (uint64_t)0x0005fb5cab84b064U,
+    (uint64_t)0x0002513e778285b0U, (uint64_t)0x000457383125e043U, (uint64_t)0x0006bda3b56e223dU,
+    (uint64_t)0x000122ba376f844fU, (uint64_t)0x000232cda2b4e554U, (uint64_t)0x0000422ba30ff840U,
+    (uint64_t)0x000751e7667b43f5U, (uint64_t)0x0006261755da5f3eU, (uint64_t)0x00002c70bf52b68eU,
+    (uint64_t)0x000532bf458d72e1U, (uint64_t)0x00040f96e796b59cU, (uint64_t)0x00022ef79d6f9da3U,
+    (uint64_t)0x000501ab67beca77U, (uint64_t)0x0006b0697e3feb43U, (uint64_t)0x0007ec4b5d0b2fbbU,
+    (uint64_t)0x000200e910595450U, (uint64_t)0x000742057105715eU, (uint64_t)0x0002f07022530f60U,
+    (uint64_t)0x00026334f0a409efU, (uint64_t)0x0000f04adf62a3c0U, (uint64_t)0x0005e0edb48bb6d9U,
+    (uint64_t)0x0007c34aa4fbc003U, (uint64_t)0x0007d74e4e5cac24U, (uint64_t)0x0001cc37f43441b2U,
+    (uint64_t)0x000656f1c9ceaeb9U, (uint64_t)0x0007031cacad5aecU, (uint64_t)0x0001308cd0716c57U,
+    (uint64_t)0x00041c1373941942U, (uint64_t)0x0003a346f772f196U, (uint64_t)0x0007565a5cc7324fU,
+    (uint64_t)0x00001ca0d5244a11U, (uint64_t)0x000116b067418713U, (uint64_t)0x0000a57d8c55edaeU,
+    (uint64_t)0x0006c6809c103803U, (uint64_t)0x00055112e2da6ac8U, (uint64_t)0x0006363d0a3dba5aU,
+    (uint64_t)0x000319c98ba6f40cU, (uint64_t)0x0002e84b03a36ec7U, (uint64_t)0x00005911b9f6ef7cU,
+    (uint64_t)0x0001acf3512eeaefU, (uint64_t)0x0002639839692a69U, (uint64_t)0x000669a234830507U,
+    (uint64_t)0x00068b920c0603d4U, (uint64_t)0x000555ef9d1c64b2U, (uint64_t)0x00039983f5df0ebbU,
+    (uint64_t)0x0001ea2589959826U, (uint64_t)0x0006ce638703cdd6U, (uint64_t)0x0006311678898505U,
+    (uint64_t)0x0006b3cecf9aa270U, (uint64_t)0x000770ba3b73bd08U, (uint64_t)0x00011475f7e186d4U,
+    (uint64_t)0x0000251bc9892bbcU, (uint64_t)0x00024eab9bffcc5aU, (uint64_t)0x000675f4de133817U,
+    (uint64_t)0x0007f6d93bdab31dU, (uint64_t)0x0001f3aca5bfd425U, (uint64_t)0x0002fa521c1c9760U,
+    (uint64_t)0x00062180ce27f9cdU, (uint64_t)0x00060f450b882cd3U, (uint64_t)0x000452036b1782fcU,
+    (uint64_t)0x00002d95b07681c5U, (uint64_t)0x0005901cf99205b2U, (uint64_t)0x000290686e5eecb4U,
+    (uint64_t)0x00013d99df70164cU, (uint64_t)0x00035ec321e5c0caU, (uint64_t)0x00013ae337f44029U,
+    (uint64_t)0x0004008e813f2da7U, (uint64_t)0x000640272f8e0c3aU, (uint64_t)0x0001c06de9e55edaU,
+    (uint64_t)0x00052b40ff6d69aaU, (uint64_t)0x00031b8809377ffaU, (uint64_t)0x000536625cd14c2cU,
+    (uint64_t)0x000516af252e17d1U, (uint64_t)0x00078096f8e7d32bU, (uint64_t)0x00077ad6a33ec4e2U,
+    (uint64_t)0x000717c5dc11d321U, (uint64_t)0x0004a114559823e4U, (uint64_t)0x000306ce50a1e2b1U,
+    (uint64_t)0x0004cf38a1fec2dbU, (uint64_t)0x0002aa650dfa5ce7U, (uint64_t)0x00054916a8f19415U,
+    (uint64_t)0x00000dc96fe71278U, (uint64_t)0x00055f2784e63eb8U, (uint64_t)0x000373cad3a26091U,
+    (uint64_t)0x0006a8fb89ddbbadU, (uint64_t)0x00078c35d5d97e37U, (uint64_t)0x00066e3674ef2cb2U,
+    (uint64_t)0x00034347ac53dd8fU, (uint64_t)0x00021547eda5112aU, (uint64_t)0x0004634d82c9f57cU,
+    (uint64_t)0x0004249268a6d652U, (uint64_t)0x0006336d687f2ff7U, (uint64_t)0x0004fe4f4e26d9a0U,
+    (uint64_t)0x0000040f3d945441U, (uint64_t)0x0005e939fd5986d3U, (uint64_t)0x00012a2147019bdfU,
+    (uint64_t)0x0004c466e7d09cb2U, (uint64_t)0x0006fa5b95d203ddU, (uint64_t)0x00063550a334a254U,
+    (uint64_t)0x0002584572547b49U, (uint64_t)0x00075c58811c1377U, (uint64_t)0x0004d3c637cc171bU,
+    (uint64_t)0x00033d30747d34e3U, (uint64_t)0x00039a92bafaa7d7U, (uint64_t)0x0007d6edb569cf37U,
+    (uint64_t)0x00060194a5dc2ca0U, (uint64_t)0x0005af59745e10a6U, (uint64_t)0x0007a8f53e004875U,
+    (uint64_t)0x0003eea62c7daf78U, (uint64_t)0x0004c713e693274eU, (uint64_t)0x0006ed1b7a6eb3a4U,
+    (uint64_t)0x00062ace697d8e15U, (uint64_t)0x000266b8292ab075U, (uint64_t)0x00068436a0665c9cU,
+    (uint64_t)0x0006d317e820107cU, (uint64_t)0x000090815d2ca3caU, (uint64_t)0x00003ff1eb1499a1U,
+    (uint64_t)0x00023960f050e319U, (uint64_t)0x0005373669c91611U, (uint64_t)0x000235e8202f3f27U,
+    (uint64_t)0x00044c9f2eb61780U, (uint64_t)0x000630905b1d7003U, (uint64_t)0x0004fcc8d274ead1U,
+    (uint64_t)0x00017b6e7f68ab78U, (uint64_t)0x000014ab9a0e5257U, (uint64_t)0x00009939567f8ba5U,
+    (uint64_t)0x0004b47b2a423c82U, (uint64_t)0x000688d7e57ac42dU, (uint64_t)0x0001cb4b5a678f87U,
+    (uint64_t)0x0004aa62a2a007e7U, (uint64_t)0x00061e0e38f62d6eU, (uint64_t)0x00002f888fcc4782U,
+    (uint64_t)0x0007562b83f21c00U, (uint64_t)0x0002dc0fd2d82ef6U, (uint64_t)0x0004c06b394afc6cU,
+    (uint64_t)0x0004931b4bf636ccU, (uint64_t)0x00072b60d0322378U, (uint64_t)0x00025127c6818b25U,
+    (uint64_t)0x000330bca78de743U, (uint64_t)0x0006ff841119744eU, (uint64_t)0x0002c560e8e49305U,
+    (uint64_t)0x0007254fefe5a57aU, (uint64_t)0x00067ae2c560a7dfU, (uint64_t)0x0003c31be1b369f1U,
+    (uint64_t)0x0000bc93f9cb4272U, (uint64_t)0x0003f8f9db73182dU, (uint64_t)0x0002b235eabae1c4U,
+    (uint64_t)0x0002ddbf8729551aU, (uint64_t)0x00041cec1097e7d5U, (uint64_t)0x0004864d08948aeeU,
+    (uint64_t)0x0005d237438df61eU, (uint64_t)0x0002b285601f7067U, (uint64_t)0x00025dbcbae6d753U,
+    (uint64_t)0x000330b61134262dU, (uint64_t)0x000619d7a26d808aU, (uint64_t)0x0003c3b3c2adbef2U,
+    (uint64_t)0x0006877c9eec7f52U, (uint64_t)0x0003beb9ebe1b66dU, (uint64_t)0x00026b44cd91f287U,
+    (uint64_t)0x0007f29362730383U, (uint64_t)0x0007fd7951459c36U, (uint64_t)0x0007504c512d49e7U,
+    (uint64_t)0x000087ed7e3bc55fU, (uint64_t)0x0007deb10149c726U, (uint64_t)0x000048478f387475U,
+    (uint64_t)0x00069397d9678a3eU, (uint64_t)0x00067c8156c976f3U, (uint64_t)0x0002eb4d5589226cU,
+    (uint64_t)0x0002c709e6c1c10aU, (uint64_t)0x0002af6a8766ee7aU, (uint64_t)0x00008aaa79a1d96cU,
+    (uint64_t)0x00042f92d59b2fb0U, (uint64_t)0x0001752c40009c07U, (uint64_t)0x00008e68e9ff62ceU,
+    (uint64_t)0x000509d50ab8f2f9U, (uint64_t)0x0001b8ab247be5e5U, (uint64_t)0x0005d9b2e6b2e486U,
+    (uint64_t)0x0004faa5479a1339U, (uint64_t)0x0004cb13bd738f71U, (uint64_t)0x0005500a4bc130adU,
+    (uint64_t)0x000127a17a938695U, (uint64_t)0x00002a26fa34e36dU, (uint64_t)0x000584d12e1ecc28U,
+    (uint64_t)0x0002f1f3f87eeba3U, (uint64_t)0x00048c75e515b64aU, (uint64_t)0x00075b6952071ef0U,
+    (uint64_t)0x0005d46d42965406U, (uint64_t)0x0007746106989f9fU, (uint64_t)0x00019a1e353c0ae2U,
+    (uint64_t)0x000172cdd596bdbdU, (uint64_t)0x0000731ddf881684U, (uint64_t)0x00010426d64f8115U,
+    (uint64_t)0x00071a4fd8a9a3daU, (uint64_t)0x000736bd3990266aU, (uint64_t)0x00047560bafa05c3U,
+    (uint64_t)0x000418dcabcc2fa3U, (uint64_t)0x00035991cecf8682U, (uint64_t)0x00024371a94b8c60U,
+    (uint64_t)0x00041546b11c20c3U, (uint64_t)0x00032d509334b3b4U, (uint64_t)0x00016c102cae70aaU,
+    (uint64_t)0x0001720dd51bf445U, (uint64_t)0x0005ae662faf9821U, (uint64_t)0x000412295a2b87faU,
+    (uint64_t)0x00055261e293eac6U, (uint64_t)0x00006426759b65ccU, (uint64_t)0x00040265ae116a48U,
+    (uint64_t)0x0006c02304bae5bcU, (uint64_t)0x0000760bb8d195adU, (uint64_t)0x00019b88f57ed6e9U,
+    (uint64_t)0x0004cdbf1904a339U, (uint64_t)0x00042b49cd4e4f2cU, (uint64_t)0x00071a2e771909d9U,
+    (uint64_t)0x00014e153ebb52d2U, (uint64_t)0x00061a17cde6818aU, (uint64_t)0x00053dad34108827U,
+    (uint64_t)0x00032b32c55c55b6U, (uint64_t)0x0002f9165f9347a3U, (uint64_t)0x0006b34be9bc33acU,
+    (uint64_t)0x000469656571f2d3U, (uint64_t)0x0000aa61ce6f423fU, (uint64_t)0x0003f940d71b27a1U,
+    (uint64_t)0x000185f19d73d16aU, (uint64_t)0x00001b9c7b62e6ddU, (uint64_t)0x00072f643a78c0b2U,
+    (uint64_t)0x0003de45c04f9e7bU, (uint64_t)0x000706d68d30fa5cU, (uint64_t)0x000696f63e8e2f24U,
+    (uint64_t)0x0002012c18f0922dU, (uint64_t)0x000355e55ac89d29U, (uint64_t)0x0003e8b414ec7101U,
+    (uint64_t)0x00039db07c520c90U, (uint64_t)0x0006f41e9b77efe1U, (uint64_t)0x00008af5b784e4baU,
+    (uint64_t)0x000314d289cc2c4bU, (uint64_t)0x00023450e2f1bc4eU, (uint64_t)0x0000cd93392f92f4U,
+    (uint64_t)0x0001370c6a946b7dU, (uint64_t)0x0006423c1d5afd98U, (uint64_t)0x000499dc881f2533U,
+    (uint64_t)0x00034ef26476c506U, (uint64_t)0x0004d107d2741497U, (uint64_t)0x000346c4bd6efdb3U,
+    (uint64_t)0x00032b79d71163a1U, (uint64_t)0x0005f8d9edfcb36aU, (uint64_t)0x0001e6e8dcbf3990U,
+    (uint64_t)0x0007974f348af30aU, (uint64_t)0x0006e6724ef19c7cU, (uint64_t)0x000480a5efbc13e2U,
+    (uint64_t)0x00014ce442ce221fU, (uint64_t)0x00018980a72516ccU, (uint64_t)0x000072f80db86677U,
+    (uint64_t)0x000703331fda526eU, (uint64_t)0x00024b31d47691c8U, (uint64_t)0x0001e70b01622071U,
+    (uint64_t)0x0001f163b5f8a16aU, (uint64_t)0x00056aaf341ad417U, (uint64_t)0x0007989635d830f7U,
+    (uint64_t)0x00047aa27600cb7bU, (uint64_t)0x00041eedc015f8c3U, (uint64_t)0x0007cf8d27ef854aU,
+    (uint64_t)0x000289e3584693f9U, (uint64_t)0x00004a7857b309a7U, (uint64_t)0x000545b585d14ddaU,
+    (uint64_t)0x0004e4d0e3b321e1U, (uint64_t)0x0007451fe3d2ac40U, (uint64_t)0x000666f678eea98dU,
+    (uint64_t)0x000038858667feadU, (uint64_t)0x0004d22dc3e64c8dU, (uint64_t)0x0007275ea0d43a0fU,
+    (uint64_t)0x000681137dd7ccf7U, (uint64_t)0x0001e79cbab79a38U, (uint64_t)0x00022a214489a66aU,
+    (uint64_t)0x0000f62f9c332ba5U, (uint64_t)0x00046589d63b5f39U, (uint64_t)0x0007eaf979ec3f96U,
+    (uint64_t)0x0004ebe81572b9a8U, (uint64_t)0x00021b7f5d61694aU, (uint64_t)0x0001c0fa01a36371U,
+    (uint64_t)0x00002b0e8c936a50U, (uint64_t)0x0006b83b58b6cd21U, (uint64_t)0x00037ed8d3e72680U,
+    (uint64_t)0x0000a037db9f2a62U, (uint64_t)0x0004005419b1d2bcU, (uint64_t)0x000604b622943dffU,
+    (uint64_t)0x0001c899f6741a58U, (uint64_t)0x00060219e2f232fbU, (uint64_t)0x00035fae92a7f9cbU,
+    (uint64_t)0x0000fa3614f3b1caU, (uint64_t)0x0003febdb9be82f0U, (uint64_t)0x0005e74895921400U,
+    (uint64_t)0x000553ea38822706U, (uint64_t)0x0005a17c24cfc88cU, (uint64_t)0x0001fba218aef40aU,
+    (uint64_t)0x000657043e7b0194U, (uint64_t)0x0005c11b55efe9e7U, (uint64_t)0x0007737bc6a074fbU,
+    (uint64_t)0x0000eae41ce355ccU, (uint64_t)0x0006c535d13ff776U, (uint64_t)0x00049448fac8f53eU,
+    (uint64_t)0x00034f74c6e8356aU, (uint64_t)0x0000ad780607dba2U, (uint64_t)0x0007213a7eb63eb6U,
+    (uint64_t)0x000392e3acaa8c86U, (uint64_t)0x000534e93e8a35afU, (uint64_t)0x00008b10fd02c997U,
+    (uint64_t)0x00026ac2acb81e05U, (uint64_t)0x00009d8c98ce3b79U, (uint64_t)0x00025e17fe4d50acU,
+    (uint64_t)0x00077ff576f121a7U, (uint64_t)0x0004e5f9b0fc722bU, (uint64_t)0x00046f949b0d28c8U,
+    (uint64_t)0x0004cde65d17ef26U, (uint64_t)0x0006bba828f89698U, (uint64_t)0x00009bd71e04f676U,
+    (uint64_t)0x00025ac841f2a145U, (uint64_t)0x0001a47eac823871U, (uint64_t)0x0001a8a8c36c581aU,
+    (uint64_t)0x000255751442a9fbU, (uint64_t)0x0001bc6690fe3901U, (uint64_t)0x000314132f5abc5aU,
+    (uint64_t)0x000611835132d528U, (uint64_t)0x0005f24b8eb48a57U, (uint64_t)0x000559d504f7f6b7U,
+    (uint64_t)0x000091e7f6d266fdU, (uint64_t)0x00036060ef037389U, (uint64_t)0x00018788ec1d1286U,
+    (uint64_t)0x000287441c478eb0U, (uint64_t)0x000123ea6a3354bdU, (uint64_t)0x00038378b3eb54d5U,
+    (uint64_t)0x0004d4aaa78f94eeU, (uint64_t)0x0004a002e875a74dU, (uint64_t)0x00010b851367b17cU,
+    (uint64_t)0x00001ab12d5807e3U, (uint64_t)0x0005189041e32d96U, (uint64_t)0x00005b062b090231U,
+    (uint64_t)0x0000c91766e7b78fU, (uint64_t)0x0000aa0f55a138ecU, (uint64_t)0x0004a3961e2c918aU,
+    (uint64_t)0x0007d644f3233f1eU, (uint64_t)0x0001c69f9e02c064U, (uint64_t)0x00036ae5e5266898U,
+    (uint64_t)0x00008fc1dad38b79U, (uint64_t)0x00068aceead9bd41U, (uint64_t)0x00043be0f8e6bba0U,
+    (uint64_t)0x00068fdffc614e3bU, (uint64_t)0x0004e91dab5b3be0U, (uint64_t)0x0003b1d4c9212ff0U,
+    (uint64_t)0x0002cd6bce3fb1dbU, (uint64_t)0x0004c90ef3d7c210U, (uint64_t)0x000496f5a0818716U,
+    (uint64_t)0x00079cf88cc239b8U, (uint64_t)0x0002cb9c306cf8dbU, (uint64_t)0x000595760d5b508fU,
+    (uint64_t)0x0002cbebfd022790U, (uint64_t)0x0000b8822aec1105U, (uint64_t)0x0004d1cfd226bcccU,
+    (uint64_t)0x000515b2fa4971beU, (uint64_t)0x0002cb2c5df54515U, (uint64_t)0x0001bfe104aa6397U,
+    (uint64_t)0x00011494ff996c25U, (uint64_t)0x00064251623e5800U, (uint64_t)0x0000d49fc5e044beU,
+    (uint64_t)0x000709fa43edcb29U, (uint64_t)0x00025d8c63fd2acaU, (uint64_t)0x0004c5cd29dffd61U,
+    (uint64_t)0x00032ec0eb48af05U, (uint64_t)0x00018f9391f9b77cU, (uint64_t)0x00070f029ecf0c81U,
+    (uint64_t)0x0002afaa5e10b0b9U, (uint64_t)0x00061de08355254dU, (uint64_t)0x0000eb587de3c28dU,
+    (uint64_t)0x0004f0bb9f7dbbd5U, (uint64_t)0x00044eca5a2a74bdU, (uint64_t)0x000307b32eed3e33U,
+    (uint64_t)0x0006748ab03ce8c2U, (uint64_t)0x00057c0d9ab810bcU, (uint64_t)0x00042c64a224e98cU,
+    (uint64_t)0x0000b7d5d8a6c314U, (uint64_t)0x000448327b95d543U, (uint64_t)0x0000146681e3a4baU,
+    (uint64_t)0x00038714adc34e0cU, (uint64_t)0x0004f26f0e298e30U, (uint64_t)0x000272224512c7deU,
+    (uint64_t)0x0003bb8a42a975fcU, (uint64_t)0x0006f2d5b46b17efU, (uint64_t)0x0007b6a9223170e5U,
+    (uint64_t)0x000053713fe3b7e6U, (uint64_t)0x00019735fd7f6bc2U, (uint64_t)0x000492af49c5342eU,
+    (uint64_t)0x0002365cdf5a0357U, (uint64_t)0x00032138a7ffbb60U, (uint64_t)0x0002a1f7d14646feU,
+    (uint64_t)0x00011b5df18a44ccU, (uint64_t)0x000390d042c84266U, (uint64_t)0x0001efe32a8fdc75U,
+    (uint64_t)0x0006925ee7ae1238U, (uint64_t)0x0004af9281d0e832U, (uint64_t)0x0000fef911191df8U
+  };
+
+static void point_add_precomp(uint64_t *out, uint64_t *p, uint64_t *q)
+{
+  uint64_t tmp[30U] = { 0U };
+  uint64_t *tmp1 = tmp;
+  uint64_t *tmp2 = tmp + (uint32_t)5U;
+  uint64_t *tmp3 = tmp + (uint32_t)10U;
+  uint64_t *tmp4 = tmp + (uint32_t)15U;
+  uint64_t *tmp5 = tmp + (uint32_t)20U;
+  uint64_t *tmp6 = tmp + (uint32_t)25U;
+  uint64_t *x1 = p;
+  uint64_t *y1 = p + (uint32_t)5U;
+  uint64_t *z1 = p + (uint32_t)10U;
+  uint64_t *t1 = p + (uint32_t)15U;
+  uint64_t *ypx2 = q;
+  uint64_t *ymx2 = q + (uint32_t)5U;
+  uint64_t *xy2d2 = q + (uint32_t)10U;
+  memcpy(tmp1, x1, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(tmp1, y1);
+  fmul0(tmp3, tmp1, ymx2);
+  memcpy(tmp1, y1, (uint32_t)5U * sizeof (uint64_t));
+  fsum(tmp1, x1);
+  fmul0(tmp4, tmp1, ypx2);
+  fmul0(tmp2, t1, xy2d2);
+  times_2(tmp5, z1);
+  memcpy(tmp1, tmp3, (uint32_t)5U * sizeof (uint64_t));
+  memcpy(tmp6, tmp2, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(tmp1, tmp4);
+  fdifference(tmp6, tmp5);
+  fsum(tmp5, tmp2);
+  fsum(tmp4, tmp3);
+  uint64_t *x3 = out;
+  uint64_t *y3 = out + (uint32_t)5U;
+  uint64_t *z3 = out + (uint32_t)10U;
+  uint64_t *t3 = out + (uint32_t)15U;
+  fmul0(x3, tmp1, tmp6);
+  fmul0(y3, tmp5, tmp4);
+  fmul0(t3, tmp1, tmp4);
+  fmul0(z3, tmp6, tmp5);
+}
+
+static void precomp_select(uint64_t *out, uint32_t row, int8_t b)
+{
+  uint64_t neg[5U] = { 0U };
+  uint8_t bneg = (uint8_t)b >> (uint32_t)7U;
+  uint8_t babs = (uint8_t)b - (((uint8_t)0U - bneg) & (uint8_t)b) * (uint8_t)2U;
+  memset(out, 0U, (uint32_t)15U * sizeof (uint64_t));
+  out[0U] = (uint64_t)1U;
+  out[5U] = (uint64_t)1U;
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
   {
-    uint64_t *nq1 = b;
-    uint64_t *nqpq1 = b + (uint32_t)20U;
-    uint64_t *nq2 = b + (uint32_t)40U;
-    uint64_t *nqpq2 = b + (uint32_t)60U;
-    uint32_t q1 = ((uint32_t)255U - i) >> (uint32_t)3U;
-    uint32_t r = ((uint32_t)255U - i) & (uint32_t)7U;
-    uint8_t kq = scalar[q1];
-    uint8_t i1 = kq >> r & (uint8_t)1U;
-    swap_conditional_inplace(nq1, nqpq1, (uint64_t)i1);
-    point_double(nq2, nq1);
-    point_add(nqpq2, nq1, nqpq1);
-    swap_conditional(nq1, nqpq1, nq2, nqpq2, (uint64_t)i1);
+    uint64_t mask = FStar_UInt64_eq_mask((uint64_t)babs, (uint64_t)(j + (uint32_t)1U));
+    const uint64_t *e = radix16_table_g + (row * (uint32_t)8U + j) * (uint32_t)15U;
+    for (uint32_t k = (uint32_t)0U; k < (uint32_t)15U; k++)
+    {
+      out[k] = out[k] ^ (mask & (out[k] ^ e[k]));
+    }
+  }
+  uint64_t mask = (uint64_t)0U - (uint64_t)bneg;
+  fnegate(neg, out + (uint32_t)10U);
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)5U; k++)
+  {
+    uint64_t x = (out[k] ^ out[k + (uint32_t)5U]) & mask;
+    out[k] = out[k] ^ x;
+    out[k + (uint32_t)5U] = out[k + (uint32_t)5U] ^ x;
+    out[k + (uint32_t)10U] = out[k + (uint32_t)10U] ^ (mask & (out[k + (uint32_t)10U] ^ neg[k]));
   }
-  memcpy(result, nq, (uint32_t)20U * sizeof (uint64_t));
 }
 
 static void point_mul_g(uint64_t *result, uint8_t *scalar)
 {
-  uint64_t g[20U] = { 0U };
-  uint64_t *gx = g;
-  uint64_t *gy = g + (uint32_t)5U;
-  uint64_t *gz = g + (uint32_t)10U;
-  uint64_t *gt = g + (uint32_t)15U;
-  gx[0U] = (uint64_t)0x00062d608f25d51aU;
-  gx[1U] = (uint64_t)0x000412a4b4f6592aU;
-  gx[2U] = (uint64_t)0x00075b7171a4b31dU;
-  gx[3U] = (uint64_t)0x0001ff60527118feU;
-  gx[4U] = (uint64_t)0x000216936d3cd6e5U;
-  gy[0U] = (uint64_t)0x0006666666666658U;
-  gy[1U] = (uint64_t)0x0004ccccccccccccU;
-  gy[2U] = (uint64_t)0x0001999999999999U;
-  gy[3U] = (uint64_t)0x0003333333333333U;
-  gy[4U] = (uint64_t)0x0006666666666666U;
-  gz[0U] = (uint64_t)1U;
-  gz[1U] = (uint64_t)0U;
-  gz[2U] = (uint64_t)0U;
-  gz[3U] = (uint64_t)0U;
-  gz[4U] = (uint64_t)0U;
-  gt[0U] = (uint64_t)0x00068ab3a5b7dda3U;
-  gt[1U] = (uint64_t)0x00000eea2a5eadbbU;
-  gt[2U] = (uint64_t)0x0002af8df483c27eU;
-  gt[3U] = (uint64_t)0x000332b375274732U;
-  gt[4U] = (uint64_t)0x00067875f0fd78b7U;
-  point_mul(result, scalar, g);
+  int8_t e[64U];
+  uint64_t t[15U] = { 0U };
+  int8_t carry = (int8_t)0;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)32U; i++)
+  {
+    e[(uint32_t)2U * i] = (int8_t)(scalar[i] & (uint8_t)15U);
+    e[(uint32_t)2U * i + (uint32_t)1U] = (int8_t)(scalar[i] >> (uint32_t)4U & (uint8_t)15U);
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)63U; i++)
+  {
+    e[i] = e[i] + carry;
+    carry = (int8_t)((e[i] + (int8_t)8) >> 4);
+    e[i] = e[i] - (int8_t)(carry * (int8_t)16);
+  }
+  e[63U] = e[63U] + carry;
+  point_identity(result);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)64U; i = i + (uint32_t)2U)
+  {
+    precomp_select(t, i >> (uint32_t)1U, e[i]);
+    point_add_precomp(result, result, t);
+  }
+  point_double(result, result);
+  point_double(result, result);
+  point_double(result, result);
+  point_double(result, result);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)64U; i = i + (uint32_t)2U)
+  {
+    precomp_select(t, i >> (uint32_t)1U, e[i]);
+    point_add_precomp(result, result, t);
+  }
 }
 
 static void point_compress(uint8_t *z, uint64_t *p)
@@ -2014,6 +3275,832 @@ static bool point_equal(uint64_t *p, uint64_t *q)
   return false;
 }
 
+static void point_negate_g(uint64_t *out)
+{
+  uint64_t *gx = out;
+  uint64_t *gy = out + (uint32_t)5U;
+  uint64_t *gz = out + (uint32_t)10U;
+  uint64_t *gt = out + (uint32_t)15U;
+  gx[0U] = (uint64_t)0x0001d29f70da2ad3U;
+  gx[1U] = (uint64_t)0x0003ed5b4b09a6d5U;
+  gx[2U] = (uint64_t)0x0000a48e8e5b4ce2U;
+  gx[3U] = (uint64_t)0x0006009fad8ee701U;
+  gx[4U] = (uint64_t)0x0005e96c92c3291aU;
+  gy[0U] = (uint64_t)0x0006666666666658U;
+  gy[1U] = (uint64_t)0x0004ccccccccccccU;
+  gy[2U] = (uint64_t)0x0001999999999999U;
+  gy[3U] = (uint64_t)0x0003333333333333U;
+  gy[4U] = (uint64_t)0x0006666666666666U;
+  gz[0U] = (uint64_t)1U;
+  gz[1U] = (uint64_t)0U;
+  gz[2U] = (uint64_t)0U;
+  gz[3U] = (uint64_t)0U;
+  gz[4U] = (uint64_t)0U;
+  gt[0U] = (uint64_t)0x0001754c5a48224aU;
+  gt[1U] = (uint64_t)0x0007f115d5a15244U;
+  gt[2U] = (uint64_t)0x000550720b7c3d81U;
+  gt[3U] = (uint64_t)0x0004cd4c8ad8b8cdU;
+  gt[4U] = (uint64_t)0x0001878a0f028748U;
+}
+
+static bool point_is_identity(uint64_t *p)
+{
+  uint64_t tmp[15U] = { 0U };
+  uint64_t *x = tmp;
+  uint64_t *y = tmp + (uint32_t)5U;
+  uint64_t *z = tmp + (uint32_t)10U;
+  memcpy(tmp, p, (uint32_t)15U * sizeof (uint64_t));
+  reduce(x);
+  reduce(y);
+  reduce(z);
+  return is_0(x) && eq(y, z);
+}
+
+static void point_negate(uint64_t *out, uint64_t *p)
+{
+  fnegate(out, p);
+  memcpy(out + (uint32_t)5U, p + (uint32_t)5U, (uint32_t)10U * sizeof (uint64_t));
+  fnegate(out + (uint32_t)15U, p + (uint32_t)15U);
+}
+
+/* Verification only handles public data, so it uses variable-time scalar multiplication:
+   [s]B - [h]A is computed with interleaved width-w NAFs, using the static table of
+   B, 3B, ..., 127B below and a table of A, 3A, ..., 15A built on the fly. */
+
+static const
+uint64_t
+odd_multiples_g[1280U] =
+  {
+    (uint64_t)0x00062d608f25d51aU, (uint64_t)0x000412a4b4f6592aU, (uint64_t)0x00075b7171a4b31dU,
+    (uint64_t)0x0001ff60527118feU, (uint64_t)0x000216936d3cd6e5U, (uint64_t)0x0006666666666658U,
+    (uint64_t)0x0004ccccccccccccU, (uint64_t)0x0001999999999999U, (uint64_t)0x0003333333333333U,
+    (uint64_t)0x0006666666666666U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x00068ab3a5b7dda3U, (uint64_t)0x00000eea2a5eadbbU, (uint64_t)0x0002af8df483c27eU,
+    (uint64_t)0x000332b375274732U, (uint64_t)0x00067875f0fd78b7U, (uint64_t)0x0002485fd3f8e25cU,
+    (uint64_t)0x0003302c4910d58cU, (uint64_t)0x00036b20e98d0e60U, (uint64_t)0x0007a48ffa573a1fU,
+    (uint64_t)0x00067ae9c4a22928U, (uint64_t)0x0003684878f5b4d4U, (uint64_t)0x0002ece480608058U,
+    (uint64_t)0x00009a7bde7c5bb0U, (uint64_t)0x0004d5d09350c730U, (uint64_t)0x0001267b1d177ee6U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x000108fa78b3a41aU,
+    (uint64_t)0x00017f62df8959bfU, (uint64_t)0x0006e4549d709cd6U, (uint64_t)0x00028875f79bc1d6U,
+    (uint64_t)0x0002a4d025cb1dd9U, (uint64_t)0x00009cc0322ef233U, (uint64_t)0x000727c37c34b228U,
+    (uint64_t)0x0004b6977970a067U, (uint64_t)0x00043dfe77be7be8U, (uint64_t)0x00049fda73eade35U,
+    (uint64_t)0x00021f83d676c8edU, (uint64_t)0x00015128616ba21aU, (uint64_t)0x0006491998c4a0bbU,
+    (uint64_t)0x000737f016370a44U, (uint64_t)0x0005f4825b298feaU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x000150bcf3e801d0U, (uint64_t)0x0000a00124d7ec83U,
+    (uint64_t)0x0004db1fe6bee53aU, (uint64_t)0x0006a618b0752843U, (uint64_t)0x000745c562c9c593U,
+    (uint64_t)0x0005981af50e4107U, (uint64_t)0x0006777e39d2ab0aU, (uint64_t)0x000476041e0fa027U,
+    (uint64_t)0x0006a774f1f70ca5U, (uint64_t)0x00014568685fcf4bU, (uint64_t)0x0004c4b59f4062b8U,
+    (uint64_t)0x0000def57e47a258U, (uint64_t)0x0004dab507c220adU, (uint64_t)0x000297c3e732346eU,
+    (uint64_t)0x00031c563e32b47dU, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x000545565587ed1bU, (uint64_t)0x000543d3549c8217U, (uint64_t)0x000756ead14a518cU,
+    (uint64_t)0x00070dcdf416e2c4U, (uint64_t)0x000119e77b11d165U, (uint64_t)0x000023065185715cU,
+    (uint64_t)0x000385c9c0529a7cU, (uint64_t)0x0006508ae21b6039U, (uint64_t)0x0000b28df99b7037U,
+    (uint64_t)0x000357cc970c8007U, (uint64_t)0x000644845522f1c0U, (uint64_t)0x0002646dc88618e9U,
+    (uint64_t)0x0003cb4bf47de240U, (uint64_t)0x0006fa595f7e74abU, (uint64_t)0x0007f3d23c2c2dd0U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0003386f88b2f465U,
+    (uint64_t)0x00041eee064fcb87U, (uint64_t)0x00051f35d05ecf52U, (uint64_t)0x0005fcedb33b56fbU,
+    (uint64_t)0x0005c70fc48ea87cU, (uint64_t)0x0007d2c1207cf3cbU, (uint64_t)0x000658b27aaa5fe5U,
+    (uint64_t)0x0001c490e34e0696U, (uint64_t)0x00020bdb6783c6ebU, (uint64_t)0x00014e528b1154beU,
+    (uint64_t)0x00072dc36a033713U, (uint64_t)0x000387938b1a8611U, (uint64_t)0x0003fc3f38496164U,
+    (uint64_t)0x0005cbad37be71a0U, (uint64_t)0x0002d9082313f21aU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0005cf2edb5beed4U, (uint64_t)0x0003bc31f906fd70U,
+    (uint64_t)0x00005ab6fd640007U, (uint64_t)0x0004511ce5535f79U, (uint64_t)0x0005ae6a565800f2U,
+    (uint64_t)0x0000e073b7c05fedU, (uint64_t)0x000511a456f706f0U, (uint64_t)0x0000b4c13e210f8fU,
+    (uint64_t)0x0003666d99d6f814U, (uint64_t)0x000107427e0d5f36U, (uint64_t)0x0007e1aeea401f80U,
+    (uint64_t)0x0006451344e470fdU, (uint64_t)0x00036a26e0dd033eU, (uint64_t)0x0005ba3c23301169U,
+    (uint64_t)0x00012dbb00ded538U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0004dccde8de2f53U, (uint64_t)0x00023d65d1df8a45U, (uint64_t)0x0005588ce16c52a9U,
+    (uint64_t)0x00023062e06eb0e6U, (uint64_t)0x000412806b917be6U, (uint64_t)0x00017f3e66a18dc1U,
+    (uint64_t)0x00068ee03139720cU, (uint64_t)0x000481067b658c4dU, (uint64_t)0x00021aee2d637caeU,
+    (uint64_t)0x0004f162deaec2ecU, (uint64_t)0x00054cc4ad2e5cdfU, (uint64_t)0x000314335354328dU,
+    (uint64_t)0x00034a4cc6b396bcU, (uint64_t)0x00017aa8b17b80b2U, (uint64_t)0x00012cbfb2d04ff2U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x00057f335c92bf29U,
+    (uint64_t)0x0001fc815cbea281U, (uint64_t)0x0005d8378be98edaU, (uint64_t)0x000248d5927e9120U,
+    (uint64_t)0x0005e33f00e36b77U, (uint64_t)0x00017853a876df6aU, (uint64_t)0x000370b44169b8abU,
+    (uint64_t)0x0003f5ca46365261U, (uint64_t)0x000374dc283a0f51U, (uint64_t)0x0007dc52d5a7db81U,
+    (uint64_t)0x0004fe9bec97be04U, (uint64_t)0x000647669f2039adU, (uint64_t)0x0002467edc5ec621U,
+    (uint64_t)0x00077cf9256122e6U, (uint64_t)0x0006f6d2bca60003U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0003b596c3b3053fU, (uint64_t)0x0004417537ed1fb7U,
+    (uint64_t)0x0001dbac02dcff6aU, (uint64_t)0x000253a2ac865570U, (uint64_t)0x00025031aba502c0U,
+    (uint64_t)0x00011a3a04a94472U, (uint64_t)0x0004a608d2dce9efU, (uint64_t)0x00058ee706c38a06U,
+    (uint64_t)0x000638117460a06bU, (uint64_t)0x0001d81f74a5ba45U, (uint64_t)0x00066102691d55b9U,
+    (uint64_t)0x000047e86be6107fU, (uint64_t)0x00075973d0b860c2U, (uint64_t)0x0001a3913e2ddb6eU,
+    (uint64_t)0x0003f185a93d95a4U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x00040427c5001131U, (uint64_t)0x0004a37ca6aa5178U, (uint64_t)0x000453fbe507cc27U,
+    (uint64_t)0x00006f3fd2467682U, (uint64_t)0x00066fd9c161a725U, (uint64_t)0x00063e7ef9365716U,
+    (uint64_t)0x0003bbc7a0e7988bU, (uint64_t)0x0001d507b7c94b2cU, (uint64_t)0x000743cac2c47ceaU,
+    (uint64_t)0x0006f0ac78e5eb90U, (uint64_t)0x00066051336d289eU, (uint64_t)0x0000b8fb14addff8U,
+    (uint64_t)0x0003e330d6b81b57U, (uint64_t)0x000572f991f2eefaU, (uint64_t)0x0006628d116b7975U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0003f0b078fc0a26U,
+    (uint64_t)0x0003042e7e1aa93dU, (uint64_t)0x0006e7e56d0ffce7U, (uint64_t)0x0001704eee838b66U,
+    (uint64_t)0x000471fb40987791U, (uint64_t)0x000798b2d2e14d95U, (uint64_t)0x0000bb36f985956aU,
+    (uint64_t)0x0000a8e46f2be47cU, (uint64_t)0x0005ab12c8af0291U, (uint64_t)0x0002188ac423c67dU,
+    (uint64_t)0x000579782b33c0eeU, (uint64_t)0x0003f4926d356cc7U, (uint64_t)0x00011b9414109decU,
+    (uint64_t)0x0003cd26fb4d11feU, (uint64_t)0x00023240c559c57bU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000fdc89f9d12dbU, (uint64_t)0x0007411c616236bcU,
+    (uint64_t)0x0004160dd48c981aU, (uint64_t)0x00053580a228db95U, (uint64_t)0x000494b54f636077U,
+    (uint64_t)0x0001362c36353455U, (uint64_t)0x0005d97045b80d63U, (uint64_t)0x0002e1e43f2a6154U,
+    (uint64_t)0x000758049c259b86U, (uint64_t)0x000794241471ed9cU, (uint64_t)0x0002bc68d311dcd0U,
+    (uint64_t)0x0001507e6f12246cU, (uint64_t)0x0003ba3e764b5e68U, (uint64_t)0x00053903bb97468cU,
+    (uint64_t)0x00071e918c03cdfcU, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000f270b57a6218U, (uint64_t)0x0004b17b69eb6bd2U, (uint64_t)0x0006d7b3298eb9dbU,
+    (uint64_t)0x0004fc647ae378b3U, (uint64_t)0x000484e314e6003cU, (uint64_t)0x00011d8f5a7f8079U,
+    (uint64_t)0x0006c1543a9ce52cU, (uint64_t)0x00041eeea4ea22d0U, (uint64_t)0x00062ed11e2e0290U,
+    (uint64_t)0x000163bc180c22dfU, (uint64_t)0x0001498677501939U, (uint64_t)0x00035f000709b75cU,
+    (uint64_t)0x00002953d8e32883U, (uint64_t)0x0003a2c0ca5cbb35U, (uint64_t)0x000631107a6ba83fU,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0002d774fa728050U,
+    (uint64_t)0x000365b131cce157U, (uint64_t)0x00066ac51bb93766U, (uint64_t)0x000230de42f41ddeU,
+    (uint64_t)0x000337ed9cc25beaU, (uint64_t)0x000663b5db0f7a5dU, (uint64_t)0x00016c34753cf3b6U,
+    (uint64_t)0x0002b38f68e242c9U, (uint64_t)0x0006d075bf1c81dcU, (uint64_t)0x00039a32a30f3eb1U,
+    (uint64_t)0x000203715d67c491U, (uint64_t)0x0005e68b04626dbaU, (uint64_t)0x000401177200f05aU,
+    (uint64_t)0x0000e4d0d7ce5000U, (uint64_t)0x0004d4c54675dc1fU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x000558acfa92d128U, (uint64_t)0x000107215c854b23U,
+    (uint64_t)0x0002f3639c43bf13U, (uint64_t)0x0002d6c1130ed133U, (uint64_t)0x0001dc74666facd2U,
+    (uint64_t)0x0000e4658efac0e9U, (uint64_t)0x000324be23ff2b1cU, (uint64_t)0x0005645455e134d6U,
+    (uint64_t)0x00018face19fe673U, (uint64_t)0x00038085391a0e28U, (uint64_t)0x000431944a19e62aU,
+    (uint64_t)0x00040cd3db232ab9U, (uint64_t)0x0007eb086cc38919U, (uint64_t)0x00024dab1a71a55bU,
+    (uint64_t)0x00042918001a829fU, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x00052629d89d6076U, (uint64_t)0x00038360ad400d86U, (uint64_t)0x00024e085750534dU,
+    (uint64_t)0x00046109213da288U, (uint64_t)0x0001d832bc1670ddU, (uint64_t)0x000153eeb75a32a1U,
+    (uint64_t)0x000694b23ee33d22U, (uint64_t)0x0000185d0d3c9156U, (uint64_t)0x0001affddddecd24U,
+    (uint64_t)0x0005e3573b049d61U, (uint64_t)0x0006e21a85892871U, (uint64_t)0x0005219b366facacU,
+    (uint64_t)0x00070683f0cef309U, (uint64_t)0x0004ed0882ea9cc1U, (uint64_t)0x00054bc665420c78U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x00016889c88cea3bU,
+    (uint64_t)0x00076fd9a9f0d136U, (uint64_t)0x0005e60338a701f1U, (uint64_t)0x00023e55f21446d7U,
+    (uint64_t)0x00064f20e09f4af1U, (uint64_t)0x0004e5b28270f6ebU, (uint64_t)0x0000772661791a8eU,
+    (uint64_t)0x00028d5fceb34bd7U, (uint64_t)0x00002fee07235ec0U, (uint64_t)0x0007ed068b25b82cU,
+    (uint64_t)0x0007b1db6a21b7d3U, (uint64_t)0x0007f2874d038772U, (uint64_t)0x000691895475c37dU,
+    (uint64_t)0x00066653826a32abU, (uint64_t)0x00001da83a187da8U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0004c643ad2709baU, (uint64_t)0x00052a681266a47dU,
+    (uint64_t)0x00015892f4b4159aU, (uint64_t)0x0001b1af17c37f60U, (uint64_t)0x000001c84c65d03bU,
+    (uint64_t)0x000151c6a14a0aa3U, (uint64_t)0x0007e296a2b5bc07U, (uint64_t)0x00042aad31521101U,
+    (uint64_t)0x0007b343088db932U, (uint64_t)0x00005ca3370e7516U, (uint64_t)0x00023611834c6903U,
+    (uint64_t)0x0005dc1239dcc023U, (uint64_t)0x000192e1a412fdeeU, (uint64_t)0x00013bcb373f87afU,
+    (uint64_t)0x0006f407fc537b95U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x00018fcee019d84aU, (uint64_t)0x0005f0cb020d5cc3U, (uint64_t)0x000709772349ee3bU,
+    (uint64_t)0x000772c8defe9df4U, (uint64_t)0x00032a375ad5f1aeU, (uint64_t)0x0000211f095ab9c3U,
+    (uint64_t)0x0006783260dd0f83U, (uint64_t)0x0002d4f2d762ceacU, (uint64_t)0x0005eb6de53cdc69U,
+    (uint64_t)0x000624cb312b698bU, (uint64_t)0x0005d0e5200bd8a3U, (uint64_t)0x0002177d4d6c3272U,
+    (uint64_t)0x00068890ed88a7dbU, (uint64_t)0x0003e3c9b98d64dcU, (uint64_t)0x0005b3336b2751e9U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x00055793aa0222e8U,
+    (uint64_t)0x000358452f60ba2dU, (uint64_t)0x000149ee37906584U, (uint64_t)0x0004b9700fda440eU,
+    (uint64_t)0x0003e32cc8618b44U, (uint64_t)0x00011a31a051b5f9U, (uint64_t)0x0005278e09b02436U,
+    (uint64_t)0x0001f3f2dd7a51f8U, (uint64_t)0x0001480d9a5bf27aU, (uint64_t)0x0001ddf6ece608feU,
+    (uint64_t)0x00052b52112ea94eU, (uint64_t)0x0005048da5d3089aU, (uint64_t)0x00073ecd3e5a851eU,
+    (uint64_t)0x0003a4e7294b6914U, (uint64_t)0x0005e2dc58e9a48aU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x00002594a910f33dU, (uint64_t)0x000038688f495c36U,
+    (uint64_t)0x0003cd245933f80eU, (uint64_t)0x000250b51cadb19fU, (uint64_t)0x0002cdadf05da1a6U,
+    (uint64_t)0x0005625f48c0e101U, (uint64_t)0x0003357b0262dc11U, (uint64_t)0x0002507af250638bU,
+    (uint64_t)0x0007e0301847dd8eU, (uint64_t)0x000396b384f3d61cU, (uint64_t)0x000261107e7ad644U,
+    (uint64_t)0x0001714c95106fc0U, (uint64_t)0x00069ea998633183U, (uint64_t)0x00065124b15d6139U,
+    (uint64_t)0x0007223e5f7b66d1U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0007f8a3afb74473U, (uint64_t)0x00056794f99d1b14U, (uint64_t)0x00033741f951d026U,
+    (uint64_t)0x0002680ac69cf0c9U, (uint64_t)0x0002e0677353c70dU, (uint64_t)0x0004ffe7890fbd50U,
+    (uint64_t)0x00002e2e1b792d2dU, (uint64_t)0x0000377a39dea672U, (uint64_t)0x0003bfd9c6baf256U,
+    (uint64_t)0x00053cc3dca34102U, (uint64_t)0x00037d23ececbbe1U, (uint64_t)0x0001411ec941481cU,
+    (uint64_t)0x0005756a866117d7U, (uint64_t)0x0006be34fa6f2346U, (uint64_t)0x0002592a3aafce64U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0001523837c2d716U,
+    (uint64_t)0x0003a69f1bcfc1c2U, (uint64_t)0x000706d09d269474U, (uint64_t)0x00063c07f97014b5U,
+    (uint64_t)0x00036517fc908a70U, (uint64_t)0x00037fc889cc1368U, (uint64_t)0x00002ada87b8aa17U,
+    (uint64_t)0x0007ff3517621a41U, (uint64_t)0x00076bbd94e9f566U, (uint64_t)0x00034705fe600f5aU,
+    (uint64_t)0x0002e158dbe3b01eU, (uint64_t)0x0000ec401ba959e8U, (uint64_t)0x000264f990be8e69U,
+    (uint64_t)0x000287fde64749a9U, (uint64_t)0x000299153c141a89U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0002d276a889d46aU, (uint64_t)0x0005b508d4ffecbdU,
+    (uint64_t)0x00039b22aeaeb968U, (uint64_t)0x00068e6ce44ed65cU, (uint64_t)0x0001822eb03d3b54U,
+    (uint64_t)0x0001c336b8504618U, (uint64_t)0x00014160c3f02319U, (uint64_t)0x0005e4ae8cc2853eU,
+    (uint64_t)0x00040dcc8fe74b58U, (uint64_t)0x0005969255bd0891U, (uint64_t)0x00021575bbb4d7a4U,
+    (uint64_t)0x0007c9563153ad94U, (uint64_t)0x0007ec451f4d5551U, (uint64_t)0x0001e150958c9a8bU,
+    (uint64_t)0x000680a805fa0ae9U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0003aef5c8008dbdU, (uint64_t)0x00004346970d9be8U, (uint64_t)0x0000f56d107e42dfU,
+    (uint64_t)0x00077aa71bd3f905U, (uint64_t)0x00050db591778c21U, (uint64_t)0x0002456c59918ecbU,
+    (uint64_t)0x00042c763fa93352U, (uint64_t)0x00010922cde409d4U, (uint64_t)0x00069ea296f8a5edU,
+    (uint64_t)0x00027d1d57fa8808U, (uint64_t)0x00009c7a1dff09c3U, (uint64_t)0x0005b7155b3b15c0U,
+    (uint64_t)0x00053fd8e6234c7fU, (uint64_t)0x0003ef4f41482785U, (uint64_t)0x0000a42f1c0f4c5dU,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0003b0f9dc4062c9U,
+    (uint64_t)0x0005bc7e7d9280daU, (uint64_t)0x0001bac024ab8c00U, (uint64_t)0x00034d57d246a17cU,
+    (uint64_t)0x000203614db4c547U, (uint64_t)0x000187ad703d9b8aU, (uint64_t)0x0005d87d59155505U,
+    (uint64_t)0x0006f39612a6e85eU, (uint64_t)0x000790a276ece7aaU, (uint64_t)0x0000811d14bfdfdcU,
+    (uint64_t)0x000746b68306376eU, (uint64_t)0x0004082b2408e188U, (uint64_t)0x00015257a95ab68bU,
+    (uint64_t)0x000706f8763be926U, (uint64_t)0x00042bea70d46f3eU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000758e51e81332U, (uint64_t)0x0002a2de1b93cb50U,
+    (uint64_t)0x00000e509f7850ebU, (uint64_t)0x000141231a0feca8U, (uint64_t)0x00006ed6a79fb4c3U,
+    (uint64_t)0x00003d905d527a4aU, (uint64_t)0x000233871cbba0a6U, (uint64_t)0x000552a399b40314U,
+    (uint64_t)0x0006587832814bf8U, (uint64_t)0x0004de090761b863U, (uint64_t)0x0006057b9772baa8U,
+    (uint64_t)0x0000313cc794d19eU, (uint64_t)0x0001f9fb7fef8f5cU, (uint64_t)0x0000e70cc518704fU,
+    (uint64_t)0x0005eef0efd10536U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x000079019d237bcfU, (uint64_t)0x0000c9fe10ac5d91U, (uint64_t)0x0001bb5d3b5fcc86U,
+    (uint64_t)0x00005e69749deed8U, (uint64_t)0x0007b42c369ac06aU, (uint64_t)0x000676bfb4fc4817U,
+    (uint64_t)0x00046e815daae1e7U, (uint64_t)0x0006adf83bcf726bU, (uint64_t)0x0002aab557702b75U,
+    (uint64_t)0x0001d45517858ce4U, (uint64_t)0x000044f0d4c5c699U, (uint64_t)0x000270c09d60bd07U,
+    (uint64_t)0x0006628fb1b86f04U, (uint64_t)0x00065826052f7bbbU, (uint64_t)0x0000b5a9d8fe8b7cU,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x00040bc9f10663afU,
+    (uint64_t)0x0003b9e4ca0afd00U, (uint64_t)0x000055bf03462e7cU, (uint64_t)0x00034e8283ff73e9U,
+    (uint64_t)0x0007bbb9318495c3U, (uint64_t)0x000639324b0eeafcU, (uint64_t)0x000567afe79c6e03U,
+    (uint64_t)0x00067ac751c841b1U, (uint64_t)0x000185570f7af720U, (uint64_t)0x0004285edbe9117fU,
+    (uint64_t)0x0007173eae04bdbdU, (uint64_t)0x0001fdb1b70fbdb8U, (uint64_t)0x0005308ad42c32a8U,
+    (uint64_t)0x0005e79605306427U, (uint64_t)0x000503aa6104a682U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0007b451d87b7b35U, (uint64_t)0x0006d4cc073d052fU,
+    (uint64_t)0x0004809ba361df91U, (uint64_t)0x0004587d21ffc4baU, (uint64_t)0x0001f4082e0455a5U,
+    (uint64_t)0x000480351f8687d6U, (uint64_t)0x00011b2372e07d43U, (uint64_t)0x0006d4aef3e95b40U,
+    (uint64_t)0x0003c81cd8db5ecdU, (uint64_t)0x0003ef830cbeff9bU, (uint64_t)0x00047553dc8ee4c8U,
+    (uint64_t)0x0002481ddac47325U, (uint64_t)0x000054bbe5cd2faaU, (uint64_t)0x00010b543a3b4f76U,
+    (uint64_t)0x00062349ff5d8dbdU, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000ed129cf5e85dU, (uint64_t)0x00022f4ba4bb2215U, (uint64_t)0x00063c2ede271c07U,
+    (uint64_t)0x0004d0ed6e1db602U, (uint64_t)0x0007223d44476a62U, (uint64_t)0x0002fa9830822c1aU,
+    (uint64_t)0x00007c5fa8c91d54U, (uint64_t)0x0003624a44d041f8U, (uint64_t)0x0005b0665a9349cfU,
+    (uint64_t)0x000649a996e6d4d3U, (uint64_t)0x00064cd1acedee9cU, (uint64_t)0x000206da48eb9912U,
+    (uint64_t)0x000148d706baa183U, (uint64_t)0x0004aea4950d672fU, (uint64_t)0x0001648311b942feU,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0005182f16609f9eU,
+    (uint64_t)0x000529be8eb485b7U, (uint64_t)0x0007fc27e8cf7f8cU, (uint64_t)0x0004cf43b0c22f92U,
+    (uint64_t)0x0004b4959d9c3ac5U, (uint64_t)0x00022c8be73f9d56U, (uint64_t)0x00070444e80a6974U,
+    (uint64_t)0x0005629d3d7f9ad2U, (uint64_t)0x000682868f6603aeU, (uint64_t)0x0003a95596d97770U,
+    (uint64_t)0x0004161a34c98fd7U, (uint64_t)0x000414f2ff07680bU, (uint64_t)0x000779aeb04da64fU,
+    (uint64_t)0x0003d4187d253a30U, (uint64_t)0x00015a80cdcc0331U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x000747fa8c0f0d02U, (uint64_t)0x0000874f075f5e8cU,
+    (uint64_t)0x0006680e59550d33U, (uint64_t)0x0004f609255c08bbU, (uint64_t)0x000216a2e847090bU,
+    (uint64_t)0x0001d831cbb76ce1U, (uint64_t)0x00057e1b3fb67e93U, (uint64_t)0x00050637bb16be21U,
+    (uint64_t)0x000481e549b42904U, (uint64_t)0x0002d265d3fe1c88U, (uint64_t)0x0002e60a84210b3cU,
+    (uint64_t)0x0004c4562b460bf6U, (uint64_t)0x000466bd29a87e55U, (uint64_t)0x000551104a43095aU,
+    (uint64_t)0x00008376fb0663d3U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x00067f96cc1061ddU, (uint64_t)0x000268e794db69ecU, (uint64_t)0x0006fbe6aba96768U,
+    (uint64_t)0x0007793adb64bf15U, (uint64_t)0x00048cfd55b628f4U, (uint64_t)0x00010ed5babb9385U,
+    (uint64_t)0x0001197d56bd614cU, (uint64_t)0x0006638ba8616b20U, (uint64_t)0x0003592c01f9f2b5U,
+    (uint64_t)0x000642cb15498d8cU, (uint64_t)0x0004b239abeaeb3eU, (uint64_t)0x00047ff4dc3b27beU,
+    (uint64_t)0x000464fa85b24265U, (uint64_t)0x0002d119a605f70aU, (uint64_t)0x00021b5ca5020a9eU,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x00018ca77a2c3d14U,
+    (uint64_t)0x00066cbc4247ba0aU, (uint64_t)0x0000222b83b5a36cU, (uint64_t)0x0003a92995f59e54U,
+    (uint64_t)0x0006231758c43d13U, (uint64_t)0x00020f68c6e79befU, (uint64_t)0x000575b5207576c4U,
+    (uint64_t)0x00004351174e59f8U, (uint64_t)0x0006e841150ce36bU, (uint64_t)0x00038e576301ff6cU,
+    (uint64_t)0x0000389eeb60eac0U, (uint64_t)0x000662d33f46d89fU, (uint64_t)0x0000d2442706c9bbU,
+    (uint64_t)0x00024a96940beed2U, (uint64_t)0x000458fe689e31a2U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0002b7b38a165294U, (uint64_t)0x0004f9e398b3110bU,
+    (uint64_t)0x0005d3df9a647935U, (uint64_t)0x0007ad3662317803U, (uint64_t)0x000250df0cb741d8U,
+    (uint64_t)0x00052678641780dbU, (uint64_t)0x0003c74f19591accU, (uint64_t)0x0001e429fc5707b0U,
+    (uint64_t)0x0000d0779119e684U, (uint64_t)0x000372bec78d7501U, (uint64_t)0x0006c97abdb538e8U,
+    (uint64_t)0x0002c555119df6cfU, (uint64_t)0x0003a8303211db4dU, (uint64_t)0x000309769f161003U,
+    (uint64_t)0x00032e9e47cf2f48U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x000518030cb981d2U, (uint64_t)0x0000b2e6f28c6148U, (uint64_t)0x0002f9e999668e86U,
+    (uint64_t)0x000422ef1fc3dd62U, (uint64_t)0x0007fbe85454d956U, (uint64_t)0x00023ca9ec4d1c77U,
+    (uint64_t)0x000333d6263e998dU, (uint64_t)0x000057759efee7ecU, (uint64_t)0x00075b2d7f71a705U,
+    (uint64_t)0x0001aa3756aabcc3U, (uint64_t)0x0005be03a49159aeU, (uint64_t)0x00008eb012ddc7b7U,
+    (uint64_t)0x0004d1f18f09b75aU, (uint64_t)0x0006b75a4d7c070bU, (uint64_t)0x00042333e27831adU,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0005248180ebc809U,
+    (uint64_t)0x000650e99570621aU, (uint64_t)0x0000c9898e3227ceU, (uint64_t)0x00066d29e5d2a65dU,
+    (uint64_t)0x00004a62d3684e33U, (uint64_t)0x0007975ac0537dc5U, (uint64_t)0x00049dda5cbcfba9U,
+    (uint64_t)0x00021afab7eeba46U, (uint64_t)0x0001ac86251b7101U, (uint64_t)0x00038db16447d79dU,
+    (uint64_t)0x0000a0f714f96daaU, (uint64_t)0x0000bbe550afe9deU, (uint64_t)0x00016ee9f7c5ce61U,
+    (uint64_t)0x000096743175388bU, (uint64_t)0x0001c48ccaed60ecU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x000206b44d20fddeU, (uint64_t)0x00002950de17e9ccU,
+    (uint64_t)0x00027b787e39f272U, (uint64_t)0x00026480108da889U, (uint64_t)0x0007ade2d06a404dU,
+    (uint64_t)0x000676b273212fb7U, (uint64_t)0x00058fad5e4315cfU, (uint64_t)0x0001aa63a547669eU,
+    (uint64_t)0x0006ef7c85d730ceU, (uint64_t)0x000176b78984cddfU, (uint64_t)0x00043f777db85852U,
+    (uint64_t)0x0004ecfd838b0c22U, (uint64_t)0x000784884aab614dU, (uint64_t)0x0001f9b3715093d5U,
+    (uint64_t)0x0007b5b93eda7744U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x00021742f577c701U, (uint64_t)0x00046477248bc3fcU, (uint64_t)0x00040a11d3490cb6U,
+    (uint64_t)0x000588027dd624ecU, (uint64_t)0x00057ea0e4a71ce9U, (uint64_t)0x0002d3e9d38bb0f6U,
+    (uint64_t)0x00069f0213d1c80aU, (uint64_t)0x00031af154ba9635U, (uint64_t)0x0003deb9c4bd7294U,
+    (uint64_t)0x000042d154bf7b4aU, (uint64_t)0x0002de120a71fc90U, (uint64_t)0x0000bd94bb1ff430U,
+    (uint64_t)0x0002e88329fb70c9U, (uint64_t)0x0004fcfbf74f1a38U, (uint64_t)0x00042d1831323e27U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x00015eb884d1bb80U,
+    (uint64_t)0x00016ca7d667a6edU, (uint64_t)0x0001f8188b26f96fU, (uint64_t)0x0000ed0eda6573fcU,
+    (uint64_t)0x00063a01f5ae7054U, (uint64_t)0x00016490c154e108U, (uint64_t)0x000152aa1adc6ea2U,
+    (uint64_t)0x000048110d2fd61dU, (uint64_t)0x0005468343db1358U, (uint64_t)0x0001f8d28dd4f286U,
+    (uint64_t)0x0005a9c43da98bb8U, (uint64_t)0x0001227288d6136aU, (uint64_t)0x00048e7e6f0b1858U,
+    (uint64_t)0x0007037a0babfea2U, (uint64_t)0x0001ce82e2360367U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x00005739dc41d103U, (uint64_t)0x00059e03f52c6b96U,
+    (uint64_t)0x00010dc7202995faU, (uint64_t)0x000310b2129859d1U, (uint64_t)0x0007180d571f3d3dU,
+    (uint64_t)0x00006362e248e5e5U, (uint64_t)0x0000fb3c4a8dedc8U, (uint64_t)0x0004230a27942c72U,
+    (uint64_t)0x0003b74d741ab5faU, (uint64_t)0x000613eb914c0150U, (uint64_t)0x000149e920b97353U,
+    (uint64_t)0x0001945100e2ad79U, (uint64_t)0x0005f48068bbc329U, (uint64_t)0x00077a550c592a09U,
+    (uint64_t)0x0003edbaafcd8c41U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x000372de96e93ed8U, (uint64_t)0x000107e7efa316f8U, (uint64_t)0x00032706e3f36478U,
+    (uint64_t)0x00047d0fb2a87946U, (uint64_t)0x0006df1fdaf7b562U, (uint64_t)0x0007f8e193cb03a9U,
+    (uint64_t)0x00029160912248d9U, (uint64_t)0x0003fde42875dea3U, (uint64_t)0x000085a59f1d202fU,
+    (uint64_t)0x00027bf43826bf03U, (uint64_t)0x000467037514f2eaU, (uint64_t)0x0002db615f4f69a9U,
+    (uint64_t)0x0005e0b0eaa961a7U, (uint64_t)0x00011a7df457ce7eU, (uint64_t)0x00016a24d749cc1dU,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000f4d5153e9a29U,
+    (uint64_t)0x0006bacb1f20c130U, (uint64_t)0x00056230fb0c2b41U, (uint64_t)0x000750aaafd58ac7U,
+    (uint64_t)0x0000639572e01bdcU, (uint64_t)0x0007714f57a675c2U, (uint64_t)0x0000107ffb3d11beU,
+    (uint64_t)0x0006d7d6b876f649U, (uint64_t)0x0005f56a0bdeece1U, (uint64_t)0x000769a6a59746d7U,
+    (uint64_t)0x000748335ec5da25U, (uint64_t)0x00020843e57bf6a0U, (uint64_t)0x00077d15866bda23U,
+    (uint64_t)0x00020e2c855dbee1U, (uint64_t)0x00022dc1267cfb2bU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0002fecae053b13bU, (uint64_t)0x0003b9579f9b29e8U,
+    (uint64_t)0x000780157bea4c4dU, (uint64_t)0x000097b35a90ac7cU, (uint64_t)0x0000077f066a9ea2U,
+    (uint64_t)0x0007f0b158c7224dU, (uint64_t)0x0006cb091d3bec77U, (uint64_t)0x00068a22736e50bdU,
+    (uint64_t)0x00020ca10ce92ea0U, (uint64_t)0x000795734ee4fcc2U, (uint64_t)0x000376f7100669b5U,
+    (uint64_t)0x00007c10909d49afU, (uint64_t)0x00058d285debc392U, (uint64_t)0x00013e9ce973cc83U,
+    (uint64_t)0x000756420ab5c711U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x00027ee06554f6a3U, (uint64_t)0x00005ddb0818d746U, (uint64_t)0x000745cd0385ed48U,
+    (uint64_t)0x0000f27bedb99383U, (uint64_t)0x0003793198bc4c4cU, (uint64_t)0x00066896aefbcf46U,
+    (uint64_t)0x0007ba5207e8d2b1U, (uint64_t)0x0001025c6a67f167U, (uint64_t)0x000562d75ac88ec1U,
+    (uint64_t)0x000644d12fc5e7fcU, (uint64_t)0x0004b572175216dcU, (uint64_t)0x0007f51f8a413991U,
+    (uint64_t)0x0005bdebb6b4bb84U, (uint64_t)0x00000b9740927f52U, (uint64_t)0x000173450789fcd4U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0006bfe5a984463dU,
+    (uint64_t)0x00072f0e8c8db050U, (uint64_t)0x0001e97289d7289aU, (uint64_t)0x00029042b8b396fdU,
+    (uint64_t)0x0006f42d1c40d5e5U, (uint64_t)0x00010679fd6c1110U, (uint64_t)0x0005dad0ea2d7ea4U,
+    (uint64_t)0x0002b47f3143a5e8U, (uint64_t)0x0004f46a79a8fae4U, (uint64_t)0x0005deca767ef17bU,
+    (uint64_t)0x00019d67898aa396U, (uint64_t)0x00064393c4f92a4bU, (uint64_t)0x0006805bccc1f395U,
+    (uint64_t)0x000380384044cc4eU, (uint64_t)0x0004ddf2207da12fU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0005ef380f6cd654U, (uint64_t)0x0002814739c8d92fU,
+    (uint64_t)0x0006410307b13d12U, (uint64_t)0x0007f6460c2c6905U, (uint64_t)0x0004e5f035a58983U,
+    (uint64_t)0x00054a689d9d2848U, (uint64_t)0x0000a17508e5b4b3U, (uint64_t)0x000725f2b3427f1cU,
+    (uint64_t)0x0002e81bd4a5f7c9U, (uint64_t)0x000296dcb24cb318U, (uint64_t)0x0003e1dd8b060f7bU,
+    (uint64_t)0x0003caf2eb7b32daU, (uint64_t)0x00056af32b25f342U, (uint64_t)0x00039c19fd5b9478U,
+    (uint64_t)0x0000b17dc85a4acfU, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x000529b40066f882U, (uint64_t)0x00027964d8393582U, (uint64_t)0x0001b3e5ffb9b495U,
+    (uint64_t)0x00062ac3f61cc4afU, (uint64_t)0x00030c5bad4740fdU, (uint64_t)0x00061c1a6cf1b93fU,
+    (uint64_t)0x00005b6f79e2bfbcU, (uint64_t)0x000037f051aaec40U, (uint64_t)0x0006ff4a7c7112daU,
+    (uint64_t)0x000408a3f1af2e77U, (uint64_t)0x0000fbcc0954e1c8U, (uint64_t)0x0003e094c281116dU,
+    (uint64_t)0x00041238bb254773U, (uint64_t)0x0002d43cf3e3c927U, (uint64_t)0x0004f01ec38854c1U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0006a1fb1668d299U,
+    (uint64_t)0x0002189188d6a438U, (uint64_t)0x00029f25cd28c862U, (uint64_t)0x0006e9407a083377U,
+    (uint64_t)0x0001f3721d5a7831U, (uint64_t)0x000790b8fafbbf07U, (uint64_t)0x0001c1532743cc49U,
+    (uint64_t)0x000314b1241df110U, (uint64_t)0x0006e4a41f053e2fU, (uint64_t)0x00007d2d9234970cU,
+    (uint64_t)0x0004511f703f2295U, (uint64_t)0x0000cddcf0634ac9U, (uint64_t)0x0005bb9ebfee898eU,
+    (uint64_t)0x0000571f03dc91cfU, (uint64_t)0x0006ac2190030c21U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0003ff2b5daaa417U, (uint64_t)0x0000a453722962c9U,
+    (uint64_t)0x000489a9a623ecb3U, (uint64_t)0x0007a6a71f2a2a39U, (uint64_t)0x0006a8917ad98392U,
+    (uint64_t)0x0005d93d58452873U, (uint64_t)0x0000d1f5262d12f2U, (uint64_t)0x000221f9037b7c46U,
+    (uint64_t)0x00011905544cdcdbU, (uint64_t)0x0002982d55300208U, (uint64_t)0x00026e980dc349b6U,
+    (uint64_t)0x000084bdc4ebb654U, (uint64_t)0x000516ab693b2a45U, (uint64_t)0x000431265687535fU,
+    (uint64_t)0x000215e16ca44797U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0004de8802a6dec8U, (uint64_t)0x0004441cae1598e9U, (uint64_t)0x00064c0628064c4fU,
+    (uint64_t)0x0005642bf4c75b0fU, (uint64_t)0x000759ee3cd9be57U, (uint64_t)0x0002a8d0e7b42d1aU,
+    (uint64_t)0x00034687dd6b47b5U, (uint64_t)0x000595a7971c47f8U, (uint64_t)0x000709b6944adb13U,
+    (uint64_t)0x0001d8649515cb49U, (uint64_t)0x0006c26c1bb7fb6cU, (uint64_t)0x000695f4bf87f97eU,
+    (uint64_t)0x000370446bced57cU, (uint64_t)0x00021d1f4f6198b6U, (uint64_t)0x0005b21e2f2978f3U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0004083c2e827437U,
+    (uint64_t)0x0007ba30a9399cd3U, (uint64_t)0x0003c2473577ebc5U, (uint64_t)0x0006c41cb943907fU,
+    (uint64_t)0x000171d8d681ab45U, (uint64_t)0x00013a23ee724a97U, (uint64_t)0x0007baa036a14ce4U,
+    (uint64_t)0x00072f7ff4df17abU, (uint64_t)0x0003c9ce6de026deU, (uint64_t)0x0005460df4d60714U,
+    (uint64_t)0x000416d71b9abcd8U, (uint64_t)0x00067332e739739bU, (uint64_t)0x0004d2e02ecc0c09U,
+    (uint64_t)0x00065a9243e9a558U, (uint64_t)0x00069dfc7004263cU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x00038bb4cf5474e5U, (uint64_t)0x0006a94853984d2fU,
+    (uint64_t)0x0001e8ed2b668b61U, (uint64_t)0x0001becd03d9d80bU, (uint64_t)0x000208b54aebd496U,
+    (uint64_t)0x00075486598125bbU, (uint64_t)0x000389a5689efd02U, (uint64_t)0x000348eafabd7b67U,
+    (uint64_t)0x0007a1650ad034bdU, (uint64_t)0x00024623476f0af9U, (uint64_t)0x0001849b8c042687U,
+    (uint64_t)0x000384565d975265U, (uint64_t)0x0004ffcebddf7685U, (uint64_t)0x0007188ca6e6f369U,
+    (uint64_t)0x0006aebe4a1a22d9U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x000705c8ae4f1e03U, (uint64_t)0x0007bcfe8bb6a6b2U, (uint64_t)0x0003e37fc5e076e8U,
+    (uint64_t)0x0001166546ace9a3U, (uint64_t)0x00028bdae94f16c1U, (uint64_t)0x0000de6a651dd538U,
+    (uint64_t)0x000503d780f925b4U, (uint64_t)0x0004ec5fe52ca445U, (uint64_t)0x0005420988bdd612U,
+    (uint64_t)0x00064e507a02bfd8U, (uint64_t)0x0007ab2d1caa03a4U, (uint64_t)0x00040a0fb08bdd2bU,
+    (uint64_t)0x0003eeb8d9640922U, (uint64_t)0x00031ed08857db09U, (uint64_t)0x000513ac992d72b4U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0007493a9c6166adU,
+    (uint64_t)0x0007bc2becea4534U, (uint64_t)0x0002899011e485fdU, (uint64_t)0x0007ca0e25981190U,
+    (uint64_t)0x0000aaec80320e9fU, (uint64_t)0x0006f894a654bf0eU, (uint64_t)0x000677020d13df5dU,
+    (uint64_t)0x00041a8f3376f011U, (uint64_t)0x0005f711851152ddU, (uint64_t)0x00047f3bd11324f6U,
+    (uint64_t)0x00060e4285c492beU, (uint64_t)0x0006461cf8eac300U, (uint64_t)0x000453aaa478b8bbU,
+    (uint64_t)0x00035f993046fe46U, (uint64_t)0x0007e05db9b3ff88U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0001d712f0d1de7eU, (uint64_t)0x00025cab1d3f605dU,
+    (uint64_t)0x0006b3fb9542da6eU, (uint64_t)0x00061f2990200cd2U, (uint64_t)0x0004e1825367e1f1U,
+    (uint64_t)0x000587b3e55c5e0fU, (uint64_t)0x000474e73512bc9fU, (uint64_t)0x0000b45a0e1750a5U,
+    (uint64_t)0x0002e816b2b00af5U, (uint64_t)0x0004a6d22703a704U, (uint64_t)0x0000d8cccf61776dU,
+    (uint64_t)0x0004bbdf6233750dU, (uint64_t)0x0003fe96d8dea1eaU, (uint64_t)0x0000228bcc728f8bU,
+    (uint64_t)0x0004c58d7a8c6dedU, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x000795e9f69bf873U, (uint64_t)0x00064f72584d5d19U, (uint64_t)0x00005cf1e45220d8U,
+    (uint64_t)0x000423a7ac23c2c2U, (uint64_t)0x00026e271016b418U, (uint64_t)0x0002f283ba368eb5U,
+    (uint64_t)0x0007098b36099d4fU, (uint64_t)0x00016605caa40e47U, (uint64_t)0x0004b9226bbcc4b2U,
+    (uint64_t)0x0003e22af70a5480U, (uint64_t)0x0002b5b6519a2968U, (uint64_t)0x00046d98507b7c52U,
+    (uint64_t)0x0006eef607752d66U, (uint64_t)0x00046f50cbe288cfU, (uint64_t)0x000689d8b7cda23bU,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x00045806fe512f61U,
+    (uint64_t)0x0007971267618ca9U, (uint64_t)0x0000f31d8d5e9837U, (uint64_t)0x0004ac5283ff8ec7U,
+    (uint64_t)0x00017b031d3e5587U, (uint64_t)0x0001a302bc065a10U, (uint64_t)0x000325a63fec6e86U,
+    (uint64_t)0x0001f06e2ee3f100U, (uint64_t)0x0006aabd9d17f843U, (uint64_t)0x00061a6ba2ca42d9U,
+    (uint64_t)0x000325579b63721dU, (uint64_t)0x000425437a7910a5U, (uint64_t)0x00042a32acb80954U,
+    (uint64_t)0x00022f5148ad12e7U, (uint64_t)0x00063d805f5a79f8U, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x000199507e152816U, (uint64_t)0x00066b7b32817519U,
+    (uint64_t)0x00027b81ee55c900U, (uint64_t)0x000590e934f3ebceU, (uint64_t)0x0006f20c04f509dbU,
+    (uint64_t)0x0006c8621e8cb414U, (uint64_t)0x00068d737430b109U, (uint64_t)0x0001e3bf3f485a30U,
+    (uint64_t)0x0002b744182fc8e2U, (uint64_t)0x00003d963eeae485U, (uint64_t)0x00047a9ec1e7e183U,
+    (uint64_t)0x0005e4990c67d57dU, (uint64_t)0x00003f6752348267U, (uint64_t)0x000256c631cb8ce9U,
+    (uint64_t)0x00074b75cc839a94U, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x000602ce8d1e424dU, (uint64_t)0x000647b1aee599e0U, (uint64_t)0x00065c18a8f2e9b0U,
+    (uint64_t)0x00057667ac242f32U, (uint64_t)0x00008596a58821d7U, (uint64_t)0x00052d6b93a58ae9U,
+    (uint64_t)0x00023fdb62fcfe42U, (uint64_t)0x0002237826816665U, (uint64_t)0x0007bda262c5881eU,
+    (uint64_t)0x0000f04da69e0202U, (uint64_t)0x00011070c800b8c4U, (uint64_t)0x0000fd5bc07068dfU,
+    (uint64_t)0x00077afe1ba00d96U, (uint64_t)0x00067ea37474800cU, (uint64_t)0x0001fbc1c9cd03c4U,
+    (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x000557e493cef8feU,
+    (uint64_t)0x0001982593dac0a4U, (uint64_t)0x00055cce97a79475U, (uint64_t)0x0000c9ba5c65b4fcU,
+    (uint64_t)0x00041d7a80b34727U, (uint64_t)0x00068cbc671a9cfeU, (uint64_t)0x000066ecdd013654U,
+    (uint64_t)0x000644eccef80642U, (uint64_t)0x0007686333357f88U, (uint64_t)0x000797899e488353U,
+    (uint64_t)0x0005ce424b8909ccU, (uint64_t)0x00008cd124cb7f30U, (uint64_t)0x00043985e7a1ad72U,
+    (uint64_t)0x0004259ff3307b83U, (uint64_t)0x0005dd70a33ff94aU, (uint64_t)0x0000000000000001U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0007e6e320b1beb0U, (uint64_t)0x0002700aae7eca6eU,
+    (uint64_t)0x0001199f051877a8U, (uint64_t)0x0005d0d59b2a8504U, (uint64_t)0x00048ea70d558697U,
+    (uint64_t)0x0003e68379f77cddU, (uint64_t)0x000375448487300dU, (uint64_t)0x0004fadfff712a83U,
+    (uint64_t)0x00032887273eabc1U, (uint64_t)0x000735b64bb87260U, (uint64_t)0x000287bc1a2bce2cU,
+    (uint64_t)0x00015e23befaeefaU, (uint64_t)0x0002167297b0c304U, (uint64_t)0x0005121b7e5b2c88U,
+    (uint64_t)0x000384aaaee3ca7bU, (uint64_t)0x0000000000000001U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U, (uint64_t)0x0000000000000000U,
+    (uint64_t)0x000325052953d265U, (uint64_t)0x0004b171655a5142U, (uint64_t)0x00017e6e8e2fcb2eU,
+    (uint64_t)0x000585732799aa14U, (uint64_t)0x000169ea362ca1ebU
+  };
+
+/* Width-w non-adjacent form of a scalar below 2^255: every non-zero digit is odd, lies in
+   (-2^(w-1), 2^(w-1)), and is followed by at least w - 1 zeros. */
+static void wnaf(int8_t *naf, uint8_t *scalar, uint32_t w)
+{
+  uint64_t x[5U] = { 0U };
+  uint64_t width = (uint64_t)1U << w;
+  uint64_t mask = width - (uint64_t)1U;
+  uint64_t carry = (uint64_t)0U;
+  uint32_t pos = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    x[i] = load64_le(scalar + i * (uint32_t)8U);
+  }
+  memset(naf, 0U, (uint32_t)256U * sizeof (int8_t));
+  while (pos < (uint32_t)256U)
+  {
+    uint32_t idx = pos >> (uint32_t)6U;
+    uint32_t bit = pos & (uint32_t)63U;
+    uint64_t buf;
+    if (bit < (uint32_t)64U - w)
+    {
+      buf = x[idx] >> bit;
+    }
+    else
+    {
+      buf = x[idx] >> bit | x[idx + (uint32_t)1U] << ((uint32_t)64U - bit);
+    }
+    uint64_t v = carry + (buf & mask);
+    if ((v & (uint64_t)1U) == (uint64_t)0U)
+    {
+      pos++;
+    }
+    else
+    {
+      if (v < width >> (uint32_t)1U)
+      {
+        carry = (uint64_t)0U;
+        naf[pos] = (int8_t)v;
+      }
+      else
+      {
+        carry = (uint64_t)1U;
+        naf[pos] = (int8_t)((int64_t)v - (int64_t)width);
+      }
+      pos = pos + w;
+    }
+  }
+}
+
+static void point_mul_double_g_vartime(uint64_t *out, uint8_t *s, uint8_t *h, uint64_t *a)
+{
+  int8_t naf_s[256U];
+  int8_t naf_h[256U];
+  uint64_t table_a[160U] = { 0U };
+  uint64_t tmp[20U] = { 0U };
+  wnaf(naf_s, s, (uint32_t)8U);
+  wnaf(naf_h, h, (uint32_t)5U);
+  memcpy(table_a, a, (uint32_t)20U * sizeof (uint64_t));
+  point_double(tmp, a);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)8U; i++)
+  {
+    point_add(table_a + i * (uint32_t)20U, table_a + (i - (uint32_t)1U) * (uint32_t)20U, tmp);
+  }
+  uint32_t top = (uint32_t)256U;
+  while (top > (uint32_t)0U && naf_s[top - (uint32_t)1U] == 0 && naf_h[top - (uint32_t)1U] == 0)
+  {
+    top--;
+  }
+  point_identity(out);
+  for (uint32_t i = top; i > (uint32_t)0U; i--)
+  {
+    int8_t ds = naf_s[i - (uint32_t)1U];
+    int8_t dh = naf_h[i - (uint32_t)1U];
+    point_double(out, out);
+    if (ds > 0)
+    {
+      point_add(out, out, (uint64_t *)odd_multiples_g + (uint32_t)(ds >> 1) * (uint32_t)20U);
+    }
+    else if (ds < 0)
+    {
+      point_negate(tmp, (uint64_t *)odd_multiples_g + (uint32_t)(-ds >> 1) * (uint32_t)20U);
+      point_add(out, out, tmp);
+    }
+    if (dh > 0)
+    {
+      point_negate(tmp, table_a + (uint32_t)(dh >> 1) * (uint32_t)20U);
+      point_add(out, out, tmp);
+    }
+    else if (dh < 0)
+    {
+      point_add(out, out, table_a + (uint32_t)(-dh >> 1) * (uint32_t)20U);
+    }
+  }
+}
+
+/* Batch verification: the multi-scalar multiplication below is variable-time, which is fine
+   since every input to a verification is public. */
+
+#define ED25519_BATCH ((uint32_t)64U)
+
+#define ED25519_MSM_MAX_WINDOW ((uint32_t)6U)
+
+static uint32_t msm_window(uint32_t len)
+{
+  if (len < (uint32_t)16U)
+  {
+    return (uint32_t)3U;
+  }
+  if (len < (uint32_t)48U)
+  {
+    return (uint32_t)4U;
+  }
+  if (len < (uint32_t)160U)
+  {
+    return (uint32_t)5U;
+  }
+  return ED25519_MSM_MAX_WINDOW;
+}
+
+static uint32_t scalar_window(uint8_t *scalar, uint32_t bit, uint32_t w)
+{
+  uint32_t q = bit >> (uint32_t)3U;
+  uint32_t r = bit & (uint32_t)7U;
+  uint32_t b = (uint32_t)scalar[q];
+  if (q + (uint32_t)1U < (uint32_t)32U)
+  {
+    b = b | (uint32_t)scalar[q + (uint32_t)1U] << (uint32_t)8U;
+  }
+  return b >> r & (((uint32_t)1U << w) - (uint32_t)1U);
+}
+
+/* Pippenger's bucket method: out = sum_i [scalars_i]points_i, for scalars below 2^253 stored as
+   32 little-endian bytes. Empty buckets and partial sums are tracked to avoid adding the
+   identity. */
+static void msm_vartime(uint64_t *out, uint32_t len, uint64_t *points, uint8_t *scalars)
+{
+  uint64_t buckets[((uint32_t)1U << ED25519_MSM_MAX_WINDOW) * (uint32_t)20U];
+  bool used[(uint32_t)1U << ED25519_MSM_MAX_WINDOW];
+  uint64_t run[20U] = { 0U };
+  uint64_t sum[20U] = { 0U };
+  uint32_t w = msm_window(len);
+  uint32_t nb = ((uint32_t)1U << w) - (uint32_t)1U;
+  uint32_t nw = ((uint32_t)253U + w - (uint32_t)1U) / w;
+  bool acc_set = false;
+  for (uint32_t j = nw; j > (uint32_t)0U; j--)
+  {
+    uint32_t bit = (j - (uint32_t)1U) * w;
+    if (acc_set)
+    {
+      for (uint32_t k = (uint32_t)0U; k < w; k++)
+      {
+        point_double(out, out);
+      }
+    }
+    memset(used, 0U, nb * sizeof (bool));
+    for (uint32_t i = (uint32_t)0U; i < len; i++)
+    {
+      uint32_t d = scalar_window(scalars + i * (uint32_t)32U, bit, w);
+      if (d != (uint32_t)0U)
+      {
+        uint64_t *b = buckets + (d - (uint32_t)1U) * (uint32_t)20U;
+        uint64_t *p = points + i * (uint32_t)20U;
+        if (used[d - (uint32_t)1U])
+        {
+          point_add(b, b, p);
+        }
+        else
+        {
+          memcpy(b, p, (uint32_t)20U * sizeof (uint64_t));
+          used[d - (uint32_t)1U] = true;
+        }
+      }
+    }
+    bool run_set = false;
+    bool sum_set = false;
+    for (uint32_t k = nb; k > (uint32_t)0U; k--)
+    {
+      if (used[k - (uint32_t)1U])
+      {
+        uint64_t *b = buckets + (k - (uint32_t)1U) * (uint32_t)20U;
+        if (run_set)
+        {
+          point_add(run, run, b);
+        }
+        else
+        {
+          memcpy(run, b, (uint32_t)20U * sizeof (uint64_t));
+          run_set = true;
+        }
+      }
+      if (run_set)
+      {
+        if (sum_set)
+        {
+          point_add(sum, sum, run);
+        }
+        else
+        {
+          memcpy(sum, run, (uint32_t)20U * sizeof (uint64_t));
+          sum_set = true;
+        }
+      }
+    }
+    if (sum_set)
+    {
+      if (acc_set)
+      {
+        point_add(out, out, sum);
+      }
+      else
+      {
+        memcpy(out, sum, (uint32_t)20U * sizeof (uint64_t));
+        acc_set = true;
+      }
+    }
+  }
+  if (!acc_set)
+  {
+    point_identity(out);
+  }
+}
+
+/* Checks one signature against the cofactored equation [8]([s]B - [h]A - R) = 0, which is what
+   the batch equation below checks for each of its signatures. */
+static bool verify_cofactored(uint8_t *pub, uint32_t len, uint8_t *msg, uint8_t *signature)
+{
+  uint64_t a_[20U] = { 0U };
+  uint64_t r_[20U] = { 0U };
+  uint64_t s[5U] = { 0U };
+  if (!(point_decompress(a_, pub) && point_decompress(r_, signature)))
+  {
+    return false;
+  }
+  load_32_bytes(s, signature + (uint32_t)32U);
+  if (gte_q(s))
+  {
+    return false;
+  }
+  uint64_t h[5U] = { 0U };
+  uint8_t h_[32U] = { 0U };
+  uint64_t sBmhA[20U] = { 0U };
+  uint64_t neg_r[20U] = { 0U };
+  sha512_modq_pre_pre2(h, signature, pub, len, msg);
+  store_56(h_, h);
+  point_mul_double_g_vartime(sBmhA, signature + (uint32_t)32U, h_, a_);
+  point_negate(neg_r, r_);
+  point_add(sBmhA, sBmhA, neg_r);
+  point_double(sBmhA, sBmhA);
+  point_double(sBmhA, sBmhA);
+  point_double(sBmhA, sBmhA);
+  return point_is_identity(sBmhA);
+}
+
+/* Checks [8]([-sum z_i s_i]B + sum [z_i]R_i + sum [z_i h_i]A_i) = 0 for random 128-bit z_i.
+   This is the cofactored equation: unlike Hacl_Ed25519_verify, it accepts signatures whose only
+   defect is a small-order component in R or A, which honest signers never produce. On failure,
+   each signature of the chunk is checked on its own with verify_cofactored, so that res[i] does
+   not depend on the other signatures of the batch. */
+static bool
+verify_batch_chunk(
+  uint32_t n,
+  uint8_t **pub,
+  uint32_t *len,
+  uint8_t **msg,
+  uint8_t **signature,
+  bool *res
+)
+{
+  uint64_t points[((uint32_t)2U * ED25519_BATCH + (uint32_t)1U) * (uint32_t)20U];
+  uint8_t scalars[((uint32_t)2U * ED25519_BATCH + (uint32_t)1U) * (uint32_t)32U];
+  uint8_t z[ED25519_BATCH * (uint32_t)16U];
+  uint64_t sum_zs[5U] = { 0U };
+  uint64_t result[20U] = { 0U };
+  if (!Lib_RandomBuffer_System_randombytes(z, n * (uint32_t)16U))
+  {
+    bool ok = true;
+    for (uint32_t i = (uint32_t)0U; i < n; i++)
+    {
+      res[i] = verify_cofactored(pub[i], len[i], msg[i], signature[i]);
+      ok = ok && res[i];
+    }
+    return ok;
+  }
+  memset(scalars, 0U, sizeof (scalars));
+  point_negate_g(points);
+  uint32_t k = (uint32_t)1U;
+  bool ok = true;
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    uint64_t *a_ = points + k * (uint32_t)20U;
+    uint64_t *r_ = points + (k + (uint32_t)1U) * (uint32_t)20U;
+    uint8_t *ha = scalars + k * (uint32_t)32U;
+    uint8_t *zr = scalars + (k + (uint32_t)1U) * (uint32_t)32U;
+    uint64_t s[5U] = { 0U };
+    bool b = point_decompress(a_, pub[i]) && point_decompress(r_, signature[i]);
+    if (b)
+    {
+      load_32_bytes(s, signature[i] + (uint32_t)32U);
+      b = !gte_q(s);
+    }
+    res[i] = b;
+    if (b)
+    {
+      uint64_t zq[5U] = { 0U };
+      uint64_t h[5U] = { 0U };
+      uint64_t t[5U] = { 0U };
+      memcpy(zr, z + i * (uint32_t)16U, (uint32_t)16U * sizeof (uint8_t));
+      load_32_bytes(zq, zr);
+      sha512_modq_pre_pre2(h, signature[i], pub[i], len[i], msg[i]);
+      mul_modq(t, zq, h);
+      store_56(ha, t);
+      mul_modq(t, zq, s);
+      add_modq(sum_zs, sum_zs, t);
+      k = k + (uint32_t)2U;
+    }
+    else
+    {
+      ok = false;
+    }
+  }
+  store_56(scalars, sum_zs);
+  msm_vartime(result, k, points, scalars);
+  point_double(result, result);
+  point_double(result, result);
+  point_double(result, result);
+  if (point_is_identity(result))
+  {
+    return ok;
+  }
+  ok = true;
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    if (res[i])
+    {
+      res[i] = verify_cofactored(pub[i], len[i], msg[i], signature[i]);
+    }
+    ok = ok && res[i];
+  }
+  return ok;
+}
+
 void Hacl_Ed25519_sign(uint8_t *signature, uint8_t *priv, uint32_t len, uint8_t *msg)
 {
   uint8_t tmp_bytes[352U] = { 0U };
@@ -2059,14 +4146,9 @@ bool Hacl_Ed25519_verify(uint8_t *pub, uint32_t len, uint8_t *msg, uint8_t *sign
         sha512_modq_pre_pre2(r_2, rs1, pub, len, msg);
         store_56(tmp_, r_2);
         uint8_t *uu____0 = signature + (uint32_t)32U;
-        uint64_t tmp1[60U] = { 0U };
-        uint64_t *hA = tmp1;
-        uint64_t *rhA = tmp1 + (uint32_t)20U;
-        uint64_t *sB = tmp1 + (uint32_t)40U;
-        point_mul_g(sB, uu____0);
-        point_mul(hA, tmp_, a_1);
-        point_add(rhA, r_1, hA);
-        bool b1 = point_equal(sB, rhA);
+        uint64_t sBmhA[20U] = { 0U };
+        point_mul_double_g_vartime(sBmhA, uu____0, tmp_, a_1);
+        bool b1 = point_equal(sBmhA, r_1);
         bool b10 = b1;
         res = b10;
       }
@@ -2113,3 +4195,44 @@ void Hacl_Ed25519_sign_expanded(uint8_t *signature, uint8_t *ks, uint32_t len, u
   memcpy(signature + (uint32_t)32U, s_, (uint32_t)32U * sizeof (uint8_t));
 }
 
+bool
+Hacl_Ed25519_verify_batch(
+  uint32_t n,
+  uint8_t **pub,
+  uint32_t *len,
+  uint8_t **msg,
+  uint8_t **signature,
+  bool *res
+)
+{
+  bool ok = true;
+  for (uint32_t i = (uint32_t)0U; i < n; i = i + ED25519_BATCH)
+  {
+    uint32_t m = n - i < ED25519_BATCH ? n - i : ED25519_BATCH;
+    bool b = verify_batch_chunk(m, pub + i, len + i, msg + i, signature + i, res + i);
+    ok = ok && b;
+  }
+  return ok;
+}
+
+void Hacl_Ed25519_point_mul_g_montgomery(uint8_t *out, uint8_t *scalar)
+{
+  uint64_t p[20U] = { 0U };
+  uint64_t tmp[15U] = { 0U };
+  uint64_t *num = tmp;
+  uint64_t *den = tmp + (uint32_t)5U;
+  uint64_t *u = tmp + (uint32_t)10U;
+  uint64_t *py = p + (uint32_t)5U;
+  uint64_t *pz = p + (uint32_t)10U;
+  point_mul_g(p, scalar);
+  memcpy(num, pz, (uint32_t)5U * sizeof (uint64_t));
+  fsum(num, py);
+  reduce_513(num);
+  memcpy(den, py, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(den, pz);
+  reduce_513(den);
+  inverse(u, den);
+  fmul0(u, u, num);
+  store_51(out, u);
+}
+
@@ -45,12 +45,29 @@ void Hacl_Ed25519_sign(uint8_t *signature, uint8_t *priv, uint32_t len, uint8_t
 
 bool Hacl_Ed25519_verify(uint8_t *pub, uint32_t len, uint8_t *msg, uint8_t *signature);
 
+/* Verifies n signatures: res[i] is set for signature i (public key pub[i], message msg[i] of
+   len[i] bytes), and the result is true iff every res[i] is. Signatures are checked with the
+   cofactored equation [8][s]B = [8]R + [8][h]A, so res[i] depends only on signature i. This
+   accepts every signature that Hacl_Ed25519_verify accepts, and also those whose R or A has a
+   small-order component, which Hacl_Ed25519_verify may reject. */
+bool
+Hacl_Ed25519_verify_batch(
+  uint32_t n,
+  uint8_t **pub,
+  uint32_t *len,
+  uint8_t **msg,
+  uint8_t **signature,
+  bool *res
+);
+
 void Hacl_Ed25519_secret_to_public(uint8_t *pub, uint8_t *priv);
 
 void Hacl_Ed25519_expand_keys(uint8_t *ks, uint8_t *priv);
 
 void Hacl_Ed25519_sign_expanded(uint8_t *signature, uint8_t *ks, uint32_t len, uint8_t *msg);
 
+void Hacl_Ed25519_point_mul_g_montgomery(uint8_t *out, uint8_t *scalar);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,213 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_Gf128_CT_256.h"
+
+/* GHASH without a carry-less multiplier: each lane multiplies one block by a
+   power of H, so that 4 blocks are absorbed with a single reduction. The
+   32x32-bit multiplications of the vector unit are made carry-less as in
+   Hacl_Gf128_CT_64, by spacing the bits of the operands four apart. */
+
+static inline void
+gf128_split(Lib_IntVector_Intrinsics_vec256 *p, Lib_IntVector_Intrinsics_vec256 x)
+{
+  p[0U] = Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x11111111U));
+  p[1U] = Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x22222222U));
+  p[2U] = Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x44444444U));
+  p[3U] = Lib_IntVector_Intrinsics_vec256_and(x, Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x88888888U));
+}
+
+/* The nine 32-bit operands of a two-level Karatsuba multiplication: for each
+   of the low half, the high half and their sum, its low word, its high word
+   and their sum. Only the low 32 bits of each lane are meaningful. */
+static inline void
+gf128_operands(
+  Lib_IntVector_Intrinsics_vec256 *o,
+  Lib_IntVector_Intrinsics_vec256 lo,
+  Lib_IntVector_Intrinsics_vec256 hi
+)
+{
+  Lib_IntVector_Intrinsics_vec256 a0 = lo;
+  Lib_IntVector_Intrinsics_vec256 a1 = Lib_IntVector_Intrinsics_vec256_shift_right64(lo, (uint32_t)32U);
+  Lib_IntVector_Intrinsics_vec256 a2 = hi;
+  Lib_IntVector_Intrinsics_vec256 a3 = Lib_IntVector_Intrinsics_vec256_shift_right64(hi, (uint32_t)32U);
+  o[0U] = a0;
+  o[1U] = a1;
+  o[2U] = Lib_IntVector_Intrinsics_vec256_xor(a0, a1);
+  o[3U] = a2;
+  o[4U] = a3;
+  o[5U] = Lib_IntVector_Intrinsics_vec256_xor(a2, a3);
+  o[6U] = Lib_IntVector_Intrinsics_vec256_xor(a0, a2);
+  o[7U] = Lib_IntVector_Intrinsics_vec256_xor(a1, a3);
+  o[8U] = Lib_IntVector_Intrinsics_vec256_xor(o[6U], o[7U]);
+}
+
+/* The table holds, split, the operands of H^4 .. H^1 (one per lane). */
+void Hacl_Gf128_CT_256_gcm_init(Lib_IntVector_Intrinsics_vec256 *tbl, uint64_t *ctx)
+{
+  uint64_t *h = ctx + (uint32_t)2U;
+  uint64_t p[2U] = { 0U };
+  p[0U] = h[0U];
+  p[1U] = h[1U];
+  uint8_t thi[8U * 4U] = { 0U };
+  uint8_t tlo[8U * 4U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    uint32_t l = (uint32_t)4U - (uint32_t)1U - i;
+    store64_le(thi + (uint32_t)8U * l, p[0U]);
+    store64_le(tlo + (uint32_t)8U * l, p[1U]);
+    Hacl_Gf128_CT_64_fmul(p, h);
+  }
+  Lib_IntVector_Intrinsics_vec256 o[9U];
+  gf128_operands(o,
+    Lib_IntVector_Intrinsics_vec256_load_le(tlo),
+    Lib_IntVector_Intrinsics_vec256_load_le(thi));
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)9U; k++)
+  {
+    gf128_split(tbl + (uint32_t)4U * k, o[k]);
+  }
+}
+
+static inline void
+gf128_update_batch(uint64_t *ctx, Lib_IntVector_Intrinsics_vec256 *tbl, uint8_t *text)
+{
+  uint8_t thi[8U * 4U] = { 0U };
+  uint8_t tlo[8U * 4U] = { 0U };
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+  {
+    uint64_t hi = load64_be(text + (uint32_t)16U * l);
+    uint64_t lo = load64_be(text + (uint32_t)16U * l + (uint32_t)8U);
+    if (l == (uint32_t)0U)
+    {
+      hi = hi ^ ctx[0U];
+      lo = lo ^ ctx[1U];
+    }
+    store64_le(thi + (uint32_t)8U * l, hi);
+    store64_le(tlo + (uint32_t)8U * l, lo);
+  }
+  Lib_IntVector_Intrinsics_vec256 o[9U];
+  gf128_operands(o,
+    Lib_IntVector_Intrinsics_vec256_load_le(tlo),
+    Lib_IntVector_Intrinsics_vec256_load_le(thi));
+  /* The nine products, each as four words of bits of equal index modulo 4;
+     the masks that drop the carries are applied once, at the end. */
+  Lib_IntVector_Intrinsics_vec256 p[36U];
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)9U; k++)
+  {
+    Lib_IntVector_Intrinsics_vec256 a[4U];
+    gf128_split(a, o[k]);
+    Lib_IntVector_Intrinsics_vec256 *b = tbl + (uint32_t)4U * k;
+    for (uint32_t r = (uint32_t)0U; r < (uint32_t)4U; r++)
+    {
+      Lib_IntVector_Intrinsics_vec256
+      z = Lib_IntVector_Intrinsics_vec256_mul64(a[0U], b[r]);
+      for (uint32_t m = (uint32_t)1U; m < (uint32_t)4U; m++)
+      {
+        z =
+          Lib_IntVector_Intrinsics_vec256_xor(z,
+            Lib_IntVector_Intrinsics_vec256_mul64(a[m], b[(r - m) & (uint32_t)3U]));
+      }
+      p[(uint32_t)4U * k + r] = z;
+    }
+  }
+  /* Karatsuba recombination, in 32-bit columns: z[s] is the 64-bit word at
+     bit 32 * s of the 256-bit product. */
+  Lib_IntVector_Intrinsics_vec256 z[28U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)28U; i++)
+  {
+    z[i] = Lib_IntVector_Intrinsics_vec256_zero;
+  }
+  for (uint32_t r = (uint32_t)0U; r < (uint32_t)4U; r++)
+  {
+    Lib_IntVector_Intrinsics_vec256 w[9U];
+    for (uint32_t x = (uint32_t)0U; x < (uint32_t)3U; x++)
+    {
+      Lib_IntVector_Intrinsics_vec256 lo = p[(uint32_t)4U * ((uint32_t)3U * x) + r];
+      Lib_IntVector_Intrinsics_vec256 hi = p[(uint32_t)4U * ((uint32_t)3U * x + (uint32_t)1U) + r];
+      Lib_IntVector_Intrinsics_vec256 mid = p[(uint32_t)4U * ((uint32_t)3U * x + (uint32_t)2U) + r];
+      w[(uint32_t)3U * x] = lo;
+      w[(uint32_t)3U * x + (uint32_t)1U] =
+        Lib_IntVector_Intrinsics_vec256_xor(mid, Lib_IntVector_Intrinsics_vec256_xor(lo, hi));
+      w[(uint32_t)3U * x + (uint32_t)2U] = hi;
+    }
+    for (uint32_t s = (uint32_t)0U; s < (uint32_t)3U; s++)
+    {
+      Lib_IntVector_Intrinsics_vec256 ll = w[s];
+      Lib_IntVector_Intrinsics_vec256 hh = w[(uint32_t)3U + s];
+      Lib_IntVector_Intrinsics_vec256
+      mm =
+        Lib_IntVector_Intrinsics_vec256_xor(w[(uint32_t)6U + s],
+          Lib_IntVector_Intrinsics_vec256_xor(ll, hh));
+      z[(uint32_t)4U * s + r] = Lib_IntVector_Intrinsics_vec256_xor(z[(uint32_t)4U * s + r], ll);
+      z[(uint32_t)4U * (s + (uint32_t)4U) + r] =
+        Lib_IntVector_Intrinsics_vec256_xor(z[(uint32_t)4U * (s + (uint32_t)4U) + r], hh);
+      z[(uint32_t)4U * (s + (uint32_t)2U) + r] =
+        Lib_IntVector_Intrinsics_vec256_xor(z[(uint32_t)4U * (s + (uint32_t)2U) + r], mm);
+    }
+  }
+  uint64_t t[7U] = { 0U };
+  for (uint32_t s = (uint32_t)0U; s < (uint32_t)7U; s++)
+  {
+    Lib_IntVector_Intrinsics_vec256
+    c =
+      Lib_IntVector_Intrinsics_vec256_and(z[(uint32_t)4U * s],
+        Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x1111111111111111U));
+    for (uint32_t r = (uint32_t)1U; r < (uint32_t)4U; r++)
+    {
+      c =
+        Lib_IntVector_Intrinsics_vec256_or(c,
+          Lib_IntVector_Intrinsics_vec256_and(z[(uint32_t)4U * s + r],
+            Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x1111111111111111U << r)));
+    }
+    uint8_t tmp[8U * 4U] = { 0U };
+    Lib_IntVector_Intrinsics_vec256_store_le(tmp, c);
+    for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+    {
+      t[s] = t[s] ^ load64_le(tmp + (uint32_t)8U * l);
+    }
+  }
+  uint64_t v[4U] = { 0U };
+  v[0U] = t[0U] ^ t[1U] << (uint32_t)32U;
+  v[1U] = (t[1U] >> (uint32_t)32U ^ t[2U]) ^ t[3U] << (uint32_t)32U;
+  v[2U] = (t[3U] >> (uint32_t)32U ^ t[4U]) ^ t[5U] << (uint32_t)32U;
+  v[3U] = t[5U] >> (uint32_t)32U ^ t[6U];
+  Hacl_Gf128_CT_64_reduce(ctx, v);
+}
+
+void
+Hacl_Gf128_CT_256_gcm_update_blocks(
+  uint64_t *ctx,
+  Lib_IntVector_Intrinsics_vec256 *tbl,
+  uint32_t len,
+  uint8_t *text
+)
+{
+  uint32_t nb = len / (uint32_t)64U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    gf128_update_batch(ctx, tbl, text + i * (uint32_t)64U);
+  }
+  Hacl_Gf128_CT_64_gcm_update_blocks(ctx, len - nb * (uint32_t)64U, text + nb * (uint32_t)64U);
+}
+
@@ -0,0 +1,202 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_Gf128_CT_64.h"
+
+/* Carry-less product of the low 64 bits of x and y, with ordinary integer
+   multiplications: each operand is split into four words that keep one bit in
+   four, so that the carries of the multiplications fall in the holes. */
+static inline uint64_t bmul64(uint64_t x, uint64_t y)
+{
+  uint64_t x0 = x & (uint64_t)0x1111111111111111U;
+  uint64_t x1 = x & (uint64_t)0x2222222222222222U;
+  uint64_t x2 = x & (uint64_t)0x4444444444444444U;
+  uint64_t x3 = x & (uint64_t)0x8888888888888888U;
+  uint64_t y0 = y & (uint64_t)0x1111111111111111U;
+  uint64_t y1 = y & (uint64_t)0x2222222222222222U;
+  uint64_t y2 = y & (uint64_t)0x4444444444444444U;
+  uint64_t y3 = y & (uint64_t)0x8888888888888888U;
+  uint64_t z0 = (x0 * y0 ^ x1 * y3 ^ x2 * y2 ^ x3 * y1) & (uint64_t)0x1111111111111111U;
+  uint64_t z1 = (x0 * y1 ^ x1 * y0 ^ x2 * y3 ^ x3 * y2) & (uint64_t)0x2222222222222222U;
+  uint64_t z2 = (x0 * y2 ^ x1 * y1 ^ x2 * y0 ^ x3 * y3) & (uint64_t)0x4444444444444444U;
+  uint64_t z3 = (x0 * y3 ^ x1 * y2 ^ x2 * y1 ^ x3 * y0) & (uint64_t)0x8888888888888888U;
+  return z0 | z1 | z2 | z3;
+}
+
+static inline uint64_t rev64(uint64_t x)
+{
+  uint64_t
+  x1 =
+    (x & (uint64_t)0x5555555555555555U)
+    << (uint32_t)1U
+    | (x >> (uint32_t)1U & (uint64_t)0x5555555555555555U);
+  uint64_t
+  x2 =
+    (x1 & (uint64_t)0x3333333333333333U)
+    << (uint32_t)2U
+    | (x1 >> (uint32_t)2U & (uint64_t)0x3333333333333333U);
+  uint64_t
+  x3 =
+    (x2 & (uint64_t)0x0f0f0f0f0f0f0f0fU)
+    << (uint32_t)4U
+    | (x2 >> (uint32_t)4U & (uint64_t)0x0f0f0f0f0f0f0f0fU);
+  uint64_t
+  x4 =
+    (x3 & (uint64_t)0x00ff00ff00ff00ffU)
+    << (uint32_t)8U
+    | (x3 >> (uint32_t)8U & (uint64_t)0x00ff00ff00ff00ffU);
+  uint64_t
+  x5 =
+    (x4 & (uint64_t)0x0000ffff0000ffffU)
+    << (uint32_t)16U
+    | (x4 >> (uint32_t)16U & (uint64_t)0x0000ffff0000ffffU);
+  return x5 << (uint32_t)32U | x5 >> (uint32_t)32U;
+}
+
+/* Reduces the 256-bit carry-less product v (least significant word first) of
+   two field elements in the bit-reflected GHASH representation. */
+void Hacl_Gf128_CT_64_reduce(uint64_t *y, uint64_t *v)
+{
+  uint64_t v0 = v[0U];
+  uint64_t v1 = v[1U];
+  uint64_t v2 = v[2U];
+  uint64_t v3 = v[3U];
+  v3 = v3 << (uint32_t)1U | v2 >> (uint32_t)63U;
+  v2 = v2 << (uint32_t)1U | v1 >> (uint32_t)63U;
+  v1 = v1 << (uint32_t)1U | v0 >> (uint32_t)63U;
+  v0 = v0 << (uint32_t)1U;
+  v2 = v2 ^ (v0 ^ v0 >> (uint32_t)1U ^ v0 >> (uint32_t)2U ^ v0 >> (uint32_t)7U);
+  v1 = v1 ^ (v0 << (uint32_t)63U ^ v0 << (uint32_t)62U ^ v0 << (uint32_t)57U);
+  v3 = v3 ^ (v1 ^ v1 >> (uint32_t)1U ^ v1 >> (uint32_t)2U ^ v1 >> (uint32_t)7U);
+  v2 = v2 ^ (v1 << (uint32_t)63U ^ v1 << (uint32_t)62U ^ v1 << (uint32_t)57U);
+  y[0U] = v3;
+  y[1U] = v2;
+}
+
+/* x = x * y, for elements held as two big-endian words, high word first. The
+   high halves of the 64-bit products are the bit-reversed low halves of the
+   products of the bit-reversed operands (Karatsuba over the two words). */
+void Hacl_Gf128_CT_64_fmul(uint64_t *x, uint64_t *y)
+{
+  uint64_t x1 = x[0U];
+  uint64_t x0 = x[1U];
+  uint64_t y1 = y[0U];
+  uint64_t y0 = y[1U];
+  uint64_t x2 = x0 ^ x1;
+  uint64_t y2 = y0 ^ y1;
+  uint64_t x0r = rev64(x0);
+  uint64_t x1r = rev64(x1);
+  uint64_t x2r = rev64(x2);
+  uint64_t y0r = rev64(y0);
+  uint64_t y1r = rev64(y1);
+  uint64_t y2r = rev64(y2);
+  uint64_t z0 = bmul64(x0, y0);
+  uint64_t z1 = bmul64(x1, y1);
+  uint64_t z2 = bmul64(x2, y2);
+  uint64_t z0h = bmul64(x0r, y0r);
+  uint64_t z1h = bmul64(x1r, y1r);
+  uint64_t z2h = bmul64(x2r, y2r);
+  z2 = z2 ^ (z0 ^ z1);
+  z2h = z2h ^ (z0h ^ z1h);
+  z0h = rev64(z0h) >> (uint32_t)1U;
+  z1h = rev64(z1h) >> (uint32_t)1U;
+  z2h = rev64(z2h) >> (uint32_t)1U;
+  uint64_t v[4U] = { 0U };
+  v[0U] = z0;
+  v[1U] = z0h ^ z2;
+  v[2U] = z1 ^ z2h;
+  v[3U] = z1h;
+  Hacl_Gf128_CT_64_reduce(x, v);
+}
+
+/* The context is the accumulator followed by H, as pairs of big-endian words. */
+void Hacl_Gf128_CT_64_gcm_init(uint64_t *ctx, uint8_t *key)
+{
+  ctx[0U] = (uint64_t)0U;
+  ctx[1U] = (uint64_t)0U;
+  ctx[2U] = load64_be(key);
+  ctx[3U] = load64_be(key + (uint32_t)8U);
+}
+
+void Hacl_Gf128_CT_64_gcm_update_blocks(uint64_t *ctx, uint32_t len, uint8_t *text)
+{
+  uint64_t *acc = ctx;
+  uint64_t *h = ctx + (uint32_t)2U;
+  uint32_t nb = len / (uint32_t)16U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    uint8_t *b = text + i * (uint32_t)16U;
+    acc[0U] = acc[0U] ^ load64_be(b);
+    acc[1U] = acc[1U] ^ load64_be(b + (uint32_t)8U);
+    Hacl_Gf128_CT_64_fmul(acc, h);
+  }
+}
+
+void Hacl_Gf128_CT_64_gcm_update_padded(uint64_t *ctx, uint32_t len, uint8_t *text)
+{
+  uint32_t len0 = len / (uint32_t)16U * (uint32_t)16U;
+  Hacl_Gf128_CT_64_gcm_update_blocks(ctx, len0, text);
+  uint32_t rem = len % (uint32_t)16U;
+  if (rem > (uint32_t)0U)
+  {
+    uint8_t b[16U] = { 0U };
+    memcpy(b, text + len0, rem * sizeof (uint8_t));
+    Hacl_Gf128_CT_64_gcm_update_blocks(ctx, (uint32_t)16U, b);
+  }
+}
+
+/* As Hacl_Gf128_NI_gcm_merge: the accumulator of ctx becomes
+   acc * H^n1 + acc1. */
+void Hacl_Gf128_CT_64_gcm_merge(uint64_t *ctx, uint64_t *ctx1, uint64_t n1)
+{
+  uint64_t p[2U] = { 0U };
+  /* 1 is the top bit in the reflected representation. */
+  p[0U] = (uint64_t)0x8000000000000000U;
+  for (uint32_t i = (uint32_t)64U; i > (uint32_t)0U; i--)
+  {
+    Hacl_Gf128_CT_64_fmul(p, p);
+    if ((n1 >> (i - (uint32_t)1U) & (uint64_t)1U) == (uint64_t)1U)
+    {
+      Hacl_Gf128_CT_64_fmul(p, ctx + (uint32_t)2U);
+    }
+  }
+  Hacl_Gf128_CT_64_fmul(ctx, p);
+  ctx[0U] = ctx[0U] ^ ctx1[0U];
+  ctx[1U] = ctx[1U] ^ ctx1[1U];
+}
+
+void Hacl_Gf128_CT_64_gcm_emit(uint8_t *tag, uint64_t *ctx)
+{
+  store64_be(tag, ctx[0U]);
+  store64_be(tag + (uint32_t)8U, ctx[1U]);
+}
+
+void Hacl_Gf128_CT_64_ghash(uint8_t *tag, uint32_t len, uint8_t *text, uint8_t *key)
+{
+  uint64_t ctx[4U] = { 0U };
+  Hacl_Gf128_CT_64_gcm_init(ctx, key);
+  Hacl_Gf128_CT_64_gcm_update_padded(ctx, len, text);
+  Hacl_Gf128_CT_64_gcm_emit(tag, ctx);
+}
+
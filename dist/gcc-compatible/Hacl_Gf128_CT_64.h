@@ -0,0 +1,63 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __Hacl_Gf128_CT_64_H
+#define __Hacl_Gf128_CT_64_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_Kremlib.h"
+
+void Hacl_Gf128_CT_64_reduce(uint64_t *y, uint64_t *v);
+
+void Hacl_Gf128_CT_64_fmul(uint64_t *x, uint64_t *y);
+
+void Hacl_Gf128_CT_64_gcm_init(uint64_t *ctx, uint8_t *key);
+
+void Hacl_Gf128_CT_64_gcm_update_blocks(uint64_t *ctx, uint32_t len, uint8_t *text);
+
+void Hacl_Gf128_CT_64_gcm_update_padded(uint64_t *ctx, uint32_t len, uint8_t *text);
+
+void Hacl_Gf128_CT_64_gcm_merge(uint64_t *ctx, uint64_t *ctx1, uint64_t n1);
+
+void Hacl_Gf128_CT_64_gcm_emit(uint8_t *tag, uint64_t *ctx);
+
+void Hacl_Gf128_CT_64_ghash(uint8_t *tag, uint32_t len, uint8_t *text, uint8_t *key);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_Gf128_CT_64_H_DEFINED
+#endif
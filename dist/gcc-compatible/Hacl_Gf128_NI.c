@@ -0,0 +1,235 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_Gf128_NI.h"
+
+static inline void
+clmul_wide(
+  Lib_IntVector_Intrinsics_vec128 *lo,
+  Lib_IntVector_Intrinsics_vec128 *mid,
+  Lib_IntVector_Intrinsics_vec128 *hi,
+  Lib_IntVector_Intrinsics_vec128 x,
+  Lib_IntVector_Intrinsics_vec128 y
+)
+{
+  Lib_IntVector_Intrinsics_vec128 lo0 = Lib_IntVector_Intrinsics_ni_clmul(x, y, (uint8_t)0x00U);
+  Lib_IntVector_Intrinsics_vec128 m1 = Lib_IntVector_Intrinsics_ni_clmul(x, y, (uint8_t)0x10U);
+  Lib_IntVector_Intrinsics_vec128 m2 = Lib_IntVector_Intrinsics_ni_clmul(x, y, (uint8_t)0x01U);
+  Lib_IntVector_Intrinsics_vec128 hi0 = Lib_IntVector_Intrinsics_ni_clmul(x, y, (uint8_t)0x11U);
+  lo[0U] = Lib_IntVector_Intrinsics_vec128_xor(lo[0U], lo0);
+  mid[0U] =
+    Lib_IntVector_Intrinsics_vec128_xor(mid[0U],
+      Lib_IntVector_Intrinsics_vec128_xor(m1, m2));
+  hi[0U] = Lib_IntVector_Intrinsics_vec128_xor(hi[0U], hi0);
+}
+
+/* Reduces a 256-bit product of a block and a power of H stored shifted left by
+   one bit (see gf128_shift_left1), folding the low half twice with the
+   reflected polynomial. */
+static inline Lib_IntVector_Intrinsics_vec128
+gf128_reduce(
+  Lib_IntVector_Intrinsics_vec128 lo,
+  Lib_IntVector_Intrinsics_vec128 mid,
+  Lib_IntVector_Intrinsics_vec128 hi
+)
+{
+  Lib_IntVector_Intrinsics_vec128
+  poly = Lib_IntVector_Intrinsics_vec128_load64s((uint64_t)0U, (uint64_t)0xc200000000000000U);
+  Lib_IntVector_Intrinsics_vec128
+  lo1 =
+    Lib_IntVector_Intrinsics_vec128_xor(lo,
+      Lib_IntVector_Intrinsics_vec128_shift_left(mid, (uint32_t)64U));
+  Lib_IntVector_Intrinsics_vec128
+  hi1 =
+    Lib_IntVector_Intrinsics_vec128_xor(hi,
+      Lib_IntVector_Intrinsics_vec128_shift_right(mid, (uint32_t)64U));
+  Lib_IntVector_Intrinsics_vec128
+  t0 = Lib_IntVector_Intrinsics_ni_clmul(lo1, poly, (uint8_t)0x10U);
+  Lib_IntVector_Intrinsics_vec128
+  lo2 =
+    Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right_lanes64(lo1,
+        (uint32_t)1U),
+      t0);
+  Lib_IntVector_Intrinsics_vec128
+  t1 = Lib_IntVector_Intrinsics_ni_clmul(lo2, poly, (uint8_t)0x10U);
+  Lib_IntVector_Intrinsics_vec128
+  lo3 =
+    Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right_lanes64(lo2,
+        (uint32_t)1U),
+      t1);
+  return Lib_IntVector_Intrinsics_vec128_xor(lo3, hi1);
+}
+
+static inline Lib_IntVector_Intrinsics_vec128
+gf128_mul(Lib_IntVector_Intrinsics_vec128 x, Lib_IntVector_Intrinsics_vec128 y)
+{
+  Lib_IntVector_Intrinsics_vec128 lo = Lib_IntVector_Intrinsics_vec128_zero;
+  Lib_IntVector_Intrinsics_vec128 mid = Lib_IntVector_Intrinsics_vec128_zero;
+  Lib_IntVector_Intrinsics_vec128 hi = Lib_IntVector_Intrinsics_vec128_zero;
+  clmul_wide(&lo, &mid, &hi, x, y);
+  return gf128_reduce(lo, mid, hi);
+}
+
+static inline Lib_IntVector_Intrinsics_vec128
+gf128_shift_left1(Lib_IntVector_Intrinsics_vec128 x)
+{
+  Lib_IntVector_Intrinsics_vec128
+  c = Lib_IntVector_Intrinsics_vec128_shift_right64(x, (uint32_t)63U);
+  Lib_IntVector_Intrinsics_vec128
+  x1 =
+    Lib_IntVector_Intrinsics_vec128_or(Lib_IntVector_Intrinsics_vec128_shift_left64(x,
+        (uint32_t)1U),
+      Lib_IntVector_Intrinsics_vec128_shift_left(c, (uint32_t)64U));
+  uint64_t top = (uint64_t)0U - Lib_IntVector_Intrinsics_vec128_extract64(c, (uint32_t)1U);
+  Lib_IntVector_Intrinsics_vec128
+  red =
+    Lib_IntVector_Intrinsics_vec128_load64s(top & (uint64_t)1U,
+      top & (uint64_t)0xc200000000000000U);
+  return Lib_IntVector_Intrinsics_vec128_xor(x1, red);
+}
+
+void Hacl_Gf128_NI_gcm_init(Lib_IntVector_Intrinsics_vec128 *ctx, uint8_t *key)
+{
+  Lib_IntVector_Intrinsics_vec128 *acc = ctx;
+  Lib_IntVector_Intrinsics_vec128 *pre = ctx + (uint32_t)1U;
+  Lib_IntVector_Intrinsics_vec128
+  h = gf128_shift_left1(Lib_IntVector_Intrinsics_vec128_load_be(key));
+  acc[0U] = Lib_IntVector_Intrinsics_vec128_zero;
+  pre[7U] = h;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)7U; i++)
+  {
+    pre[(uint32_t)6U - i] = gf128_mul(pre[(uint32_t)7U - i], h);
+  }
+}
+
+/* Absorbs n <= 8 blocks with a single reduction, using H^n .. H^1. */
+static inline void
+gf128_update_n(Lib_IntVector_Intrinsics_vec128 *ctx, uint32_t n, uint8_t *text)
+{
+  Lib_IntVector_Intrinsics_vec128 *acc = ctx;
+  Lib_IntVector_Intrinsics_vec128 *pre = ctx + (uint32_t)1U + (uint32_t)8U - n;
+  Lib_IntVector_Intrinsics_vec128 lo = Lib_IntVector_Intrinsics_vec128_zero;
+  Lib_IntVector_Intrinsics_vec128 mid = Lib_IntVector_Intrinsics_vec128_zero;
+  Lib_IntVector_Intrinsics_vec128 hi = Lib_IntVector_Intrinsics_vec128_zero;
+  Lib_IntVector_Intrinsics_vec128
+  b0 =
+    Lib_IntVector_Intrinsics_vec128_xor(acc[0U],
+      Lib_IntVector_Intrinsics_vec128_load_be(text));
+  clmul_wide(&lo, &mid, &hi, b0, pre[0U]);
+  for (uint32_t i = (uint32_t)1U; i < n; i++)
+  {
+    Lib_IntVector_Intrinsics_vec128
+    b = Lib_IntVector_Intrinsics_vec128_load_be(text + i * (uint32_t)16U);
+    clmul_wide(&lo, &mid, &hi, b, pre[i]);
+  }
+  acc[0U] = gf128_reduce(lo, mid, hi);
+}
+
+void
+Hacl_Gf128_NI_gcm_update_blocks(
+  Lib_IntVector_Intrinsics_vec128 *ctx,
+  uint32_t len,
+  uint8_t *text
+)
+{
+  uint32_t nb = len / (uint32_t)128U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    gf128_update_n(ctx, (uint32_t)8U, text + i * (uint32_t)128U);
+  }
+  uint32_t rem = len % (uint32_t)128U / (uint32_t)16U;
+  if (rem > (uint32_t)0U)
+  {
+    gf128_update_n(ctx, rem, text + nb * (uint32_t)128U);
+  }
+}
+
+void
+Hacl_Gf128_NI_gcm_update_padded(
+  Lib_IntVector_Intrinsics_vec128 *ctx,
+  uint32_t len,
+  uint8_t *text
+)
+{
+  uint32_t len0 = len / (uint32_t)16U * (uint32_t)16U;
+  Hacl_Gf128_NI_gcm_update_blocks(ctx, len0, text);
+  uint32_t rem = len % (uint32_t)16U;
+  if (rem > (uint32_t)0U)
+  {
+    uint8_t b[16U] = { 0U };
+    memcpy(b, text + len0, rem * sizeof (uint8_t));
+    Hacl_Gf128_NI_gcm_update_blocks(ctx, (uint32_t)16U, b);
+  }
+}
+
+/* Appends to the text absorbed by ctx the n1 blocks absorbed by ctx1, which
+   started from a zero accumulator with the same key: the accumulator of ctx
+   becomes acc * H^n1 + acc1. */
+void
+Hacl_Gf128_NI_gcm_merge(
+  Lib_IntVector_Intrinsics_vec128 *ctx,
+  Lib_IntVector_Intrinsics_vec128 *ctx1,
+  uint64_t n1
+)
+{
+  if (n1 == (uint64_t)0U)
+  {
+    ctx[0U] = Lib_IntVector_Intrinsics_vec128_xor(ctx[0U], ctx1[0U]);
+    return;
+  }
+  /* Powers of H kept shifted left by one bit are closed under gf128_mul. */
+  Lib_IntVector_Intrinsics_vec128 h = ctx[8U];
+  Lib_IntVector_Intrinsics_vec128 p = h;
+  uint32_t i = (uint32_t)63U;
+  while (n1 >> i == (uint64_t)0U)
+  {
+    i = i - (uint32_t)1U;
+  }
+  while (i > (uint32_t)0U)
+  {
+    i = i - (uint32_t)1U;
+    p = gf128_mul(p, p);
+    if ((n1 >> i & (uint64_t)1U) == (uint64_t)1U)
+    {
+      p = gf128_mul(p, h);
+    }
+  }
+  ctx[0U] = Lib_IntVector_Intrinsics_vec128_xor(gf128_mul(ctx[0U], p), ctx1[0U]);
+}
+
+void Hacl_Gf128_NI_gcm_emit(uint8_t *tag, Lib_IntVector_Intrinsics_vec128 *ctx)
+{
+  Lib_IntVector_Intrinsics_vec128_store_be(tag, ctx[0U]);
+}
+
+void Hacl_Gf128_NI_ghash(uint8_t *tag, uint32_t len, uint8_t *text, uint8_t *key)
+{
+  Lib_IntVector_Intrinsics_vec128 ctx[9U];
+  for (uint32_t _i = 0U; _i < (uint32_t)9U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec128_zero;
+  Hacl_Gf128_NI_gcm_init(ctx, key);
+  Hacl_Gf128_NI_gcm_update_padded(ctx, len, text);
+  Hacl_Gf128_NI_gcm_emit(tag, ctx);
+}
+
@@ -0,0 +1,453 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_Poly1305_512.h"
+
+static inline void
+fmul_nocarry_512(
+  Lib_IntVector_Intrinsics_vec512 *t,
+  Lib_IntVector_Intrinsics_vec512 *f,
+  Lib_IntVector_Intrinsics_vec512 *r,
+  Lib_IntVector_Intrinsics_vec512 *r5
+)
+{
+  Lib_IntVector_Intrinsics_vec512 f0 = f[0U];
+  Lib_IntVector_Intrinsics_vec512 f1 = f[1U];
+  Lib_IntVector_Intrinsics_vec512 f2 = f[2U];
+  Lib_IntVector_Intrinsics_vec512 f3 = f[3U];
+  Lib_IntVector_Intrinsics_vec512 f4 = f[4U];
+  Lib_IntVector_Intrinsics_vec512 r0 = r[0U];
+  Lib_IntVector_Intrinsics_vec512 r1 = r[1U];
+  Lib_IntVector_Intrinsics_vec512 r2 = r[2U];
+  Lib_IntVector_Intrinsics_vec512 r3 = r[3U];
+  Lib_IntVector_Intrinsics_vec512 r4 = r[4U];
+  Lib_IntVector_Intrinsics_vec512 r51 = r5[1U];
+  Lib_IntVector_Intrinsics_vec512 r52 = r5[2U];
+  Lib_IntVector_Intrinsics_vec512 r53 = r5[3U];
+  Lib_IntVector_Intrinsics_vec512 r54 = r5[4U];
+  Lib_IntVector_Intrinsics_vec512 a0 = Lib_IntVector_Intrinsics_vec512_mul64(f0, r0);
+  Lib_IntVector_Intrinsics_vec512 a1 = Lib_IntVector_Intrinsics_vec512_mul64(f0, r1);
+  Lib_IntVector_Intrinsics_vec512 a2 = Lib_IntVector_Intrinsics_vec512_mul64(f0, r2);
+  Lib_IntVector_Intrinsics_vec512 a3 = Lib_IntVector_Intrinsics_vec512_mul64(f0, r3);
+  Lib_IntVector_Intrinsics_vec512 a4 = Lib_IntVector_Intrinsics_vec512_mul64(f0, r4);
+  a0 = Lib_IntVector_Intrinsics_vec512_add64(a0, Lib_IntVector_Intrinsics_vec512_mul64(f1, r54));
+  a1 = Lib_IntVector_Intrinsics_vec512_add64(a1, Lib_IntVector_Intrinsics_vec512_mul64(f1, r0));
+  a2 = Lib_IntVector_Intrinsics_vec512_add64(a2, Lib_IntVector_Intrinsics_vec512_mul64(f1, r1));
+  a3 = Lib_IntVector_Intrinsics_vec512_add64(a3, Lib_IntVector_Intrinsics_vec512_mul64(f1, r2));
+  a4 = Lib_IntVector_Intrinsics_vec512_add64(a4, Lib_IntVector_Intrinsics_vec512_mul64(f1, r3));
+  a0 = Lib_IntVector_Intrinsics_vec512_add64(a0, Lib_IntVector_Intrinsics_vec512_mul64(f2, r53));
+  a1 = Lib_IntVector_Intrinsics_vec512_add64(a1, Lib_IntVector_Intrinsics_vec512_mul64(f2, r54));
+  a2 = Lib_IntVector_Intrinsics_vec512_add64(a2, Lib_IntVector_Intrinsics_vec512_mul64(f2, r0));
+  a3 = Lib_IntVector_Intrinsics_vec512_add64(a3, Lib_IntVector_Intrinsics_vec512_mul64(f2, r1));
+  a4 = Lib_IntVector_Intrinsics_vec512_add64(a4, Lib_IntVector_Intrinsics_vec512_mul64(f2, r2));
+  a0 = Lib_IntVector_Intrinsics_vec512_add64(a0, Lib_IntVector_Intrinsics_vec512_mul64(f3, r52));
+  a1 = Lib_IntVector_Intrinsics_vec512_add64(a1, Lib_IntVector_Intrinsics_vec512_mul64(f3, r53));
+  a2 = Lib_IntVector_Intrinsics_vec512_add64(a2, Lib_IntVector_Intrinsics_vec512_mul64(f3, r54));
+  a3 = Lib_IntVector_Intrinsics_vec512_add64(a3, Lib_IntVector_Intrinsics_vec512_mul64(f3, r0));
+  a4 = Lib_IntVector_Intrinsics_vec512_add64(a4, Lib_IntVector_Intrinsics_vec512_mul64(f3, r1));
+  a0 = Lib_IntVector_Intrinsics_vec512_add64(a0, Lib_IntVector_Intrinsics_vec512_mul64(f4, r51));
+  a1 = Lib_IntVector_Intrinsics_vec512_add64(a1, Lib_IntVector_Intrinsics_vec512_mul64(f4, r52));
+  a2 = Lib_IntVector_Intrinsics_vec512_add64(a2, Lib_IntVector_Intrinsics_vec512_mul64(f4, r53));
+  a3 = Lib_IntVector_Intrinsics_vec512_add64(a3, Lib_IntVector_Intrinsics_vec512_mul64(f4, r54));
+  a4 = Lib_IntVector_Intrinsics_vec512_add64(a4, Lib_IntVector_Intrinsics_vec512_mul64(f4, r0));
+  t[0U] = a0;
+  t[1U] = a1;
+  t[2U] = a2;
+  t[3U] = a3;
+  t[4U] = a4;
+}
+
+static inline void
+carry_wide_512(Lib_IntVector_Intrinsics_vec512 *out, Lib_IntVector_Intrinsics_vec512 *t)
+{
+  Lib_IntVector_Intrinsics_vec512
+  mask26 = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x3ffffffU);
+  Lib_IntVector_Intrinsics_vec512
+  z0 = Lib_IntVector_Intrinsics_vec512_shift_right64(t[0U], (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512
+  z1 = Lib_IntVector_Intrinsics_vec512_shift_right64(t[3U], (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512 x0 = Lib_IntVector_Intrinsics_vec512_and(t[0U], mask26);
+  Lib_IntVector_Intrinsics_vec512 x3 = Lib_IntVector_Intrinsics_vec512_and(t[3U], mask26);
+  Lib_IntVector_Intrinsics_vec512 x1 = Lib_IntVector_Intrinsics_vec512_add64(t[1U], z0);
+  Lib_IntVector_Intrinsics_vec512 x4 = Lib_IntVector_Intrinsics_vec512_add64(t[4U], z1);
+  Lib_IntVector_Intrinsics_vec512
+  z01 = Lib_IntVector_Intrinsics_vec512_shift_right64(x1, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512
+  z11 = Lib_IntVector_Intrinsics_vec512_shift_right64(x4, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512
+  t5 = Lib_IntVector_Intrinsics_vec512_shift_left64(z11, (uint32_t)2U);
+  Lib_IntVector_Intrinsics_vec512 z12 = Lib_IntVector_Intrinsics_vec512_add64(z11, t5);
+  Lib_IntVector_Intrinsics_vec512 x11 = Lib_IntVector_Intrinsics_vec512_and(x1, mask26);
+  Lib_IntVector_Intrinsics_vec512 x41 = Lib_IntVector_Intrinsics_vec512_and(x4, mask26);
+  Lib_IntVector_Intrinsics_vec512 x2 = Lib_IntVector_Intrinsics_vec512_add64(t[2U], z01);
+  Lib_IntVector_Intrinsics_vec512 x01 = Lib_IntVector_Intrinsics_vec512_add64(x0, z12);
+  Lib_IntVector_Intrinsics_vec512
+  z02 = Lib_IntVector_Intrinsics_vec512_shift_right64(x2, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512
+  z13 = Lib_IntVector_Intrinsics_vec512_shift_right64(x01, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512 x21 = Lib_IntVector_Intrinsics_vec512_and(x2, mask26);
+  Lib_IntVector_Intrinsics_vec512 x02 = Lib_IntVector_Intrinsics_vec512_and(x01, mask26);
+  Lib_IntVector_Intrinsics_vec512 x31 = Lib_IntVector_Intrinsics_vec512_add64(x3, z02);
+  Lib_IntVector_Intrinsics_vec512 x12 = Lib_IntVector_Intrinsics_vec512_add64(x11, z13);
+  Lib_IntVector_Intrinsics_vec512
+  z03 = Lib_IntVector_Intrinsics_vec512_shift_right64(x31, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512 x32 = Lib_IntVector_Intrinsics_vec512_and(x31, mask26);
+  Lib_IntVector_Intrinsics_vec512 x42 = Lib_IntVector_Intrinsics_vec512_add64(x41, z03);
+  out[0U] = x02;
+  out[1U] = x12;
+  out[2U] = x21;
+  out[3U] = x32;
+  out[4U] = x42;
+}
+
+static inline void
+fmul_r_512(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *f,
+  Lib_IntVector_Intrinsics_vec512 *r,
+  Lib_IntVector_Intrinsics_vec512 *r5
+)
+{
+  Lib_IntVector_Intrinsics_vec512 t[5U];
+  for (uint32_t _i = 0U; _i < (uint32_t)5U; ++_i)
+    t[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  fmul_nocarry_512(t, f, r, r5);
+  carry_wide_512(out, t);
+}
+
+static inline void
+precomp_r5_512(Lib_IntVector_Intrinsics_vec512 *r5, Lib_IntVector_Intrinsics_vec512 *r)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512 x = r[i];
+    r5[i] =
+      Lib_IntVector_Intrinsics_vec512_add64(x,
+        Lib_IntVector_Intrinsics_vec512_shift_left64(x, (uint32_t)2U));
+  }
+}
+
+static inline void
+load_felem_512(
+  Lib_IntVector_Intrinsics_vec512 *e,
+  Lib_IntVector_Intrinsics_vec512 lo,
+  Lib_IntVector_Intrinsics_vec512 hi
+)
+{
+  Lib_IntVector_Intrinsics_vec512
+  mask26 = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x3ffffffU);
+  e[0U] = Lib_IntVector_Intrinsics_vec512_and(lo, mask26);
+  e[1U] =
+    Lib_IntVector_Intrinsics_vec512_and(Lib_IntVector_Intrinsics_vec512_shift_right64(lo,
+        (uint32_t)26U),
+      mask26);
+  e[2U] =
+    Lib_IntVector_Intrinsics_vec512_or(Lib_IntVector_Intrinsics_vec512_shift_right64(lo,
+        (uint32_t)52U),
+      Lib_IntVector_Intrinsics_vec512_shift_left64(Lib_IntVector_Intrinsics_vec512_and(hi,
+          Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x3fffU)),
+        (uint32_t)12U));
+  e[3U] =
+    Lib_IntVector_Intrinsics_vec512_and(Lib_IntVector_Intrinsics_vec512_shift_right64(hi,
+        (uint32_t)14U),
+      mask26);
+  e[4U] = Lib_IntVector_Intrinsics_vec512_shift_right64(hi, (uint32_t)40U);
+}
+
+/* Loads 8 blocks: lane 2i holds block i and lane 2i+1 holds block i + 4. */
+static inline void load_blocks8_512(Lib_IntVector_Intrinsics_vec512 *e, uint8_t *b)
+{
+  Lib_IntVector_Intrinsics_vec512 lo = Lib_IntVector_Intrinsics_vec512_load_le(b);
+  Lib_IntVector_Intrinsics_vec512 hi = Lib_IntVector_Intrinsics_vec512_load_le(b + (uint32_t)64U);
+  Lib_IntVector_Intrinsics_vec512 t0 = Lib_IntVector_Intrinsics_vec512_interleave_low64(lo, hi);
+  Lib_IntVector_Intrinsics_vec512 t1 = Lib_IntVector_Intrinsics_vec512_interleave_high64(lo, hi);
+  load_felem_512(e, t0, t1);
+  e[4U] =
+    Lib_IntVector_Intrinsics_vec512_or(e[4U],
+      Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x1000000U));
+}
+
+void Hacl_Impl_Poly1305_Field32xN_512_load_acc8(Lib_IntVector_Intrinsics_vec512 *acc, uint8_t *b)
+{
+  Lib_IntVector_Intrinsics_vec512 e[5U];
+  for (uint32_t _i = 0U; _i < (uint32_t)5U; ++_i)
+    e[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  load_blocks8_512(e, b);
+  Lib_IntVector_Intrinsics_vec512
+  lane0 =
+    Lib_IntVector_Intrinsics_vec512_load64s((uint64_t)0xffffffffffffffffU,
+      (uint64_t)0U,
+      (uint64_t)0U,
+      (uint64_t)0U,
+      (uint64_t)0U,
+      (uint64_t)0U,
+      (uint64_t)0U,
+      (uint64_t)0U);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    acc[i] =
+      Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_and(acc[i], lane0),
+        e[i]);
+  }
+}
+
+void
+Hacl_Impl_Poly1305_Field32xN_512_fmul_r8_normalize(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *p
+)
+{
+  Lib_IntVector_Intrinsics_vec512 *r = p;
+  Lib_IntVector_Intrinsics_vec512 *r_5 = p + (uint32_t)5U;
+  Lib_IntVector_Intrinsics_vec512 *r8 = p + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec512 rn[40U];
+  for (uint32_t _i = 0U; _i < (uint32_t)40U; ++_i)
+    rn[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  Lib_IntVector_Intrinsics_vec512 rn5[5U];
+  for (uint32_t _i = 0U; _i < (uint32_t)5U; ++_i)
+    rn5[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  /* rn holds r^1 .. r^8, 5 limbs each. */
+  memcpy(rn, r, (uint32_t)5U * sizeof (Lib_IntVector_Intrinsics_vec512));
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)7U; i++)
+  {
+    fmul_r_512(rn + i * (uint32_t)5U, rn + (i - (uint32_t)1U) * (uint32_t)5U, r, r_5);
+  }
+  memcpy(rn + (uint32_t)35U, r8, (uint32_t)5U * sizeof (Lib_IntVector_Intrinsics_vec512));
+  /* Lane 2i is multiplied by r^(8-i) and lane 2i+1 by r^(4-i). */
+  Lib_IntVector_Intrinsics_vec512 pw[5U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512
+    q0 =
+      Lib_IntVector_Intrinsics_vec512_interleave_low64(rn[(uint32_t)35U + i],
+        rn[(uint32_t)15U + i]);
+    Lib_IntVector_Intrinsics_vec512
+    q1 =
+      Lib_IntVector_Intrinsics_vec512_interleave_low64(rn[(uint32_t)30U + i],
+        rn[(uint32_t)10U + i]);
+    Lib_IntVector_Intrinsics_vec512
+    q2 =
+      Lib_IntVector_Intrinsics_vec512_interleave_low64(rn[(uint32_t)25U + i], rn[(uint32_t)5U + i]);
+    Lib_IntVector_Intrinsics_vec512
+    q3 = Lib_IntVector_Intrinsics_vec512_interleave_low64(rn[(uint32_t)20U + i], rn[i]);
+    Lib_IntVector_Intrinsics_vec512 q01 = Lib_IntVector_Intrinsics_vec512_interleave_low128(q0, q1);
+    Lib_IntVector_Intrinsics_vec512 q23 = Lib_IntVector_Intrinsics_vec512_interleave_low128(q2, q3);
+    pw[i] = Lib_IntVector_Intrinsics_vec512_interleave_low256(q01, q23);
+  }
+  precomp_r5_512(rn5, pw);
+  Lib_IntVector_Intrinsics_vec512 t[5U];
+  for (uint32_t _i = 0U; _i < (uint32_t)5U; ++_i)
+    t[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  fmul_nocarry_512(t, out, pw, rn5);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512 a = t[i];
+    Lib_IntVector_Intrinsics_vec512
+    a1 =
+      Lib_IntVector_Intrinsics_vec512_add64(a,
+        Lib_IntVector_Intrinsics_vec512_interleave_high256(a, a));
+    Lib_IntVector_Intrinsics_vec512
+    a2 =
+      Lib_IntVector_Intrinsics_vec512_add64(a1,
+        Lib_IntVector_Intrinsics_vec512_interleave_high128(a1, a1));
+    Lib_IntVector_Intrinsics_vec512
+    a3 =
+      Lib_IntVector_Intrinsics_vec512_add64(a2,
+        Lib_IntVector_Intrinsics_vec512_interleave_high64(a2, a2));
+    t[i] = a3;
+  }
+  carry_wide_512(out, t);
+}
+
+uint32_t Hacl_Poly1305_512_blocklen = (uint32_t)16U;
+
+void Hacl_Poly1305_512_poly1305_init(Lib_IntVector_Intrinsics_vec512 *ctx, uint8_t *key)
+{
+  Lib_IntVector_Intrinsics_vec512 *acc = ctx;
+  Lib_IntVector_Intrinsics_vec512 *pre = ctx + (uint32_t)5U;
+  uint8_t *kr = key;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    acc[i] = Lib_IntVector_Intrinsics_vec512_zero;
+  }
+  uint64_t u0 = load64_le(kr);
+  uint64_t lo = u0;
+  uint64_t u = load64_le(kr + (uint32_t)8U);
+  uint64_t hi = u;
+  uint64_t mask0 = (uint64_t)0x0ffffffc0fffffffU;
+  uint64_t mask1 = (uint64_t)0x0ffffffc0ffffffcU;
+  uint64_t lo1 = lo & mask0;
+  uint64_t hi1 = hi & mask1;
+  Lib_IntVector_Intrinsics_vec512 *r = pre;
+  Lib_IntVector_Intrinsics_vec512 *r5 = pre + (uint32_t)5U;
+  Lib_IntVector_Intrinsics_vec512 *rn = pre + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec512 *rn_5 = pre + (uint32_t)15U;
+  load_felem_512(r,
+    Lib_IntVector_Intrinsics_vec512_load64(lo1),
+    Lib_IntVector_Intrinsics_vec512_load64(hi1));
+  precomp_r5_512(r5, r);
+  fmul_r_512(rn, r, r, r5);
+  precomp_r5_512(rn_5, rn);
+  fmul_r_512(rn, rn, rn, rn_5);
+  precomp_r5_512(rn_5, rn);
+  fmul_r_512(rn, rn, rn, rn_5);
+  precomp_r5_512(rn_5, rn);
+}
+
+static inline void
+update_block_512(Lib_IntVector_Intrinsics_vec512 *ctx, uint8_t *block, uint64_t b)
+{
+  Lib_IntVector_Intrinsics_vec512 *acc = ctx;
+  Lib_IntVector_Intrinsics_vec512 *pre = ctx + (uint32_t)5U;
+  Lib_IntVector_Intrinsics_vec512 e[5U];
+  for (uint32_t _i = 0U; _i < (uint32_t)5U; ++_i)
+    e[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  uint64_t u0 = load64_le(block);
+  uint64_t lo = u0;
+  uint64_t u = load64_le(block + (uint32_t)8U);
+  uint64_t hi = u;
+  load_felem_512(e,
+    Lib_IntVector_Intrinsics_vec512_load64(lo),
+    Lib_IntVector_Intrinsics_vec512_load64(hi));
+  e[4U] = Lib_IntVector_Intrinsics_vec512_or(e[4U], Lib_IntVector_Intrinsics_vec512_load64(b));
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    acc[i] = Lib_IntVector_Intrinsics_vec512_add64(acc[i], e[i]);
+  }
+  fmul_r_512(acc, acc, pre, pre + (uint32_t)5U);
+}
+
+void Hacl_Poly1305_512_poly1305_update1(Lib_IntVector_Intrinsics_vec512 *ctx, uint8_t *text)
+{
+  update_block_512(ctx, text, (uint64_t)0x1000000U);
+}
+
+void
+Hacl_Poly1305_512_poly1305_update(Lib_IntVector_Intrinsics_vec512 *ctx, uint32_t len, uint8_t *text)
+{
+  Lib_IntVector_Intrinsics_vec512 *pre = ctx + (uint32_t)5U;
+  Lib_IntVector_Intrinsics_vec512 *acc = ctx;
+  uint32_t sz_block = (uint32_t)128U;
+  uint32_t len0 = len / sz_block * sz_block;
+  uint8_t *t0 = text;
+  if (len0 > (uint32_t)0U)
+  {
+    uint32_t bs = (uint32_t)128U;
+    uint8_t *text0 = t0;
+    Hacl_Impl_Poly1305_Field32xN_512_load_acc8(acc, text0);
+    uint32_t len1 = len0 - bs;
+    uint8_t *text1 = t0 + bs;
+    uint32_t nb = len1 / bs;
+    for (uint32_t i = (uint32_t)0U; i < nb; i++)
+    {
+      uint8_t *block = text1 + i * bs;
+      Lib_IntVector_Intrinsics_vec512 e[5U];
+      for (uint32_t _i = 0U; _i < (uint32_t)5U; ++_i)
+        e[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+      load_blocks8_512(e, block);
+      fmul_r_512(acc, acc, pre + (uint32_t)10U, pre + (uint32_t)15U);
+      for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)5U; i0++)
+      {
+        acc[i0] = Lib_IntVector_Intrinsics_vec512_add64(acc[i0], e[i0]);
+      }
+    }
+    Hacl_Impl_Poly1305_Field32xN_512_fmul_r8_normalize(acc, pre);
+  }
+  uint32_t len1 = len - len0;
+  uint8_t *t1 = text + len0;
+  uint32_t nb = len1 / (uint32_t)16U;
+  uint32_t rem = len1 % (uint32_t)16U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    uint8_t *block = t1 + i * (uint32_t)16U;
+    update_block_512(ctx, block, (uint64_t)0x1000000U);
+  }
+  if (rem > (uint32_t)0U)
+  {
+    uint8_t *last = t1 + nb * (uint32_t)16U;
+    uint8_t tmp[16U] = { 0U };
+    memcpy(tmp, last, rem * sizeof (uint8_t));
+    tmp[rem] = (uint8_t)1U;
+    update_block_512(ctx, tmp, (uint64_t)0U);
+  }
+}
+
+void
+Hacl_Poly1305_512_poly1305_finish(uint8_t *tag, uint8_t *key, Lib_IntVector_Intrinsics_vec512 *ctx)
+{
+  Lib_IntVector_Intrinsics_vec512 *acc = ctx;
+  uint8_t *ks = key + (uint32_t)16U;
+  uint64_t f[5U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    uint64_t lanes[8U] = { 0U };
+    Lib_IntVector_Intrinsics_vec512_store_le((uint8_t *)lanes, acc[i]);
+    f[i] = lanes[0U];
+  }
+  uint64_t mask26 = (uint64_t)0x3ffffffU;
+  /* Three carry passes bring all limbs below 2^26, i.e. f below 2^130. */
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)3U; j++)
+  {
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+    {
+      f[i + (uint32_t)1U] = f[i + (uint32_t)1U] + (f[i] >> (uint32_t)26U);
+      f[i] = f[i] & mask26;
+    }
+    f[0U] = f[0U] + (uint64_t)5U * (f[4U] >> (uint32_t)26U);
+    f[4U] = f[4U] & mask26;
+  }
+  /* Subtract p if f >= p, in constant time. */
+  uint64_t g[5U] = { 0U };
+  uint64_t c = (uint64_t)5U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    uint64_t x = f[i] + c;
+    g[i] = x & mask26;
+    c = x >> (uint32_t)26U;
+  }
+  uint64_t mask = (uint64_t)0U - c;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    f[i] = (f[i] & ~mask) | (g[i] & mask);
+  }
+  uint64_t h0 = f[0U] | f[1U] << (uint32_t)26U | f[2U] << (uint32_t)52U;
+  uint64_t h1 = f[2U] >> (uint32_t)12U | f[3U] << (uint32_t)14U | f[4U] << (uint32_t)40U;
+  uint64_t s0 = load64_le(ks);
+  uint64_t s1 = load64_le(ks + (uint32_t)8U);
+  uint64_t r0 = h0 + s0;
+  uint64_t r1 = h1 + s1 + (r0 < s0);
+  store64_le(tag, r0);
+  store64_le(tag + (uint32_t)8U, r1);
+}
+
+void Hacl_Poly1305_512_poly1305_mac(uint8_t *tag, uint32_t len, uint8_t *text, uint8_t *key)
+{
+  Lib_IntVector_Intrinsics_vec512 ctx[25U];
+  for (uint32_t _i = 0U; _i < (uint32_t)25U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  Hacl_Poly1305_512_poly1305_init(ctx, key);
+  Hacl_Poly1305_512_poly1305_update(ctx, len, text);
+  Hacl_Poly1305_512_poly1305_finish(tag, key, ctx);
+}
+
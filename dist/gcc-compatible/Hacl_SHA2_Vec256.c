@@ -0,0 +1,652 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "Hacl_SHA2_Vec256.h"
+
+static const
+uint32_t
+h256[8U] =
+  {
+    (uint32_t)0x6a09e667U, (uint32_t)0xbb67ae85U, (uint32_t)0x3c6ef372U, (uint32_t)0xa54ff53aU,
+    (uint32_t)0x510e527fU, (uint32_t)0x9b05688cU, (uint32_t)0x1f83d9abU, (uint32_t)0x5be0cd19U
+  };
+
+static const
+uint32_t
+k224_256[64U] =
+  {
+    (uint32_t)0x428a2f98U, (uint32_t)0x71374491U, (uint32_t)0xb5c0fbcfU, (uint32_t)0xe9b5dba5U,
+    (uint32_t)0x3956c25bU, (uint32_t)0x59f111f1U, (uint32_t)0x923f82a4U, (uint32_t)0xab1c5ed5U,
+    (uint32_t)0xd807aa98U, (uint32_t)0x12835b01U, (uint32_t)0x243185beU, (uint32_t)0x550c7dc3U,
+    (uint32_t)0x72be5d74U, (uint32_t)0x80deb1feU, (uint32_t)0x9bdc06a7U, (uint32_t)0xc19bf174U,
+    (uint32_t)0xe49b69c1U, (uint32_t)0xefbe4786U, (uint32_t)0x0fc19dc6U, (uint32_t)0x240ca1ccU,
+    (uint32_t)0x2de92c6fU, (uint32_t)0x4a7484aaU, (uint32_t)0x5cb0a9dcU, (uint32_t)0x76f988daU,
+    (uint32_t)0x983e5152U, (uint32_t)0xa831c66dU, (uint32_t)0xb00327c8U, (uint32_t)0xbf597fc7U,
+    (uint32_t)0xc6e00bf3U, (uint32_t)0xd5a79147U, (uint32_t)0x06ca6351U, (uint32_t)0x14292967U,
+    (uint32_t)0x27b70a85U, (uint32_t)0x2e1b2138U, (uint32_t)0x4d2c6dfcU, (uint32_t)0x53380d13U,
+    (uint32_t)0x650a7354U, (uint32_t)0x766a0abbU, (uint32_t)0x81c2c92eU, (uint32_t)0x92722c85U,
+    (uint32_t)0xa2bfe8a1U, (uint32_t)0xa81a664bU, (uint32_t)0xc24b8b70U, (uint32_t)0xc76c51a3U,
+    (uint32_t)0xd192e819U, (uint32_t)0xd6990624U, (uint32_t)0xf40e3585U, (uint32_t)0x106aa070U,
+    (uint32_t)0x19a4c116U, (uint32_t)0x1e376c08U, (uint32_t)0x2748774cU, (uint32_t)0x34b0bcb5U,
+    (uint32_t)0x391c0cb3U, (uint32_t)0x4ed8aa4aU, (uint32_t)0x5b9cca4fU, (uint32_t)0x682e6ff3U,
+    (uint32_t)0x748f82eeU, (uint32_t)0x78a5636fU, (uint32_t)0x84c87814U, (uint32_t)0x8cc70208U,
+    (uint32_t)0x90befffaU, (uint32_t)0xa4506cebU, (uint32_t)0xbef9a3f7U, (uint32_t)0xc67178f2U
+  };
+
+static const
+uint64_t
+h384[8U] =
+  {
+    (uint64_t)0xcbbb9d5dc1059ed8U, (uint64_t)0x629a292a367cd507U, (uint64_t)0x9159015a3070dd17U,
+    (uint64_t)0x152fecd8f70e5939U, (uint64_t)0x67332667ffc00b31U, (uint64_t)0x8eb44a8768581511U,
+    (uint64_t)0xdb0c2e0d64f98fa7U, (uint64_t)0x47b5481dbefa4fa4U
+  };
+
+static const
+uint64_t
+h512[8U] =
+  {
+    (uint64_t)0x6a09e667f3bcc908U, (uint64_t)0xbb67ae8584caa73bU, (uint64_t)0x3c6ef372fe94f82bU,
+    (uint64_t)0xa54ff53a5f1d36f1U, (uint64_t)0x510e527fade682d1U, (uint64_t)0x9b05688c2b3e6c1fU,
+    (uint64_t)0x1f83d9abfb41bd6bU, (uint64_t)0x5be0cd19137e2179U
+  };
+
+static const
+uint64_t
+k384_512[80U] =
+  {
+    (uint64_t)0x428a2f98d728ae22U, (uint64_t)0x7137449123ef65cdU, (uint64_t)0xb5c0fbcfec4d3b2fU,
+    (uint64_t)0xe9b5dba58189dbbcU, (uint64_t)0x3956c25bf348b538U, (uint64_t)0x59f111f1b605d019U,
+    (uint64_t)0x923f82a4af194f9bU, (uint64_t)0xab1c5ed5da6d8118U, (uint64_t)0xd807aa98a3030242U,
+    (uint64_t)0x12835b0145706fbeU, (uint64_t)0x243185be4ee4b28cU, (uint64_t)0x550c7dc3d5ffb4e2U,
+    (uint64_t)0x72be5d74f27b896fU, (uint64_t)0x80deb1fe3b1696b1U, (uint64_t)0x9bdc06a725c71235U,
+    (uint64_t)0xc19bf174cf692694U, (uint64_t)0xe49b69c19ef14ad2U, (uint64_t)0xefbe4786384f25e3U,
+    (uint64_t)0x0fc19dc68b8cd5b5U, (uint64_t)0x240ca1cc77ac9c65U, (uint64_t)0x2de92c6f592b0275U,
+    (uint64_t)0x4a7484aa6ea6e483U, (uint64_t)0x5cb0a9dcbd41fbd4U, (uint64_t)0x76f988da831153b5U,
+    (uint64_t)0x983e5152ee66dfabU, (uint64_t)0xa831c66d2db43210U, (uint64_t)0xb00327c898fb213fU,
+    (uint64_t)0xbf597fc7beef0ee4U, (uint64_t)0xc6e00bf33da88fc2U, (uint64_t)0xd5a79147930aa725U,
+    (uint64_t)0x06ca6351e003826fU, (uint64_t)0x142929670a0e6e70U, (uint64_t)0x27b70a8546d22ffcU,
+    (uint64_t)0x2e1b21385c26c926U, (uint64_t)0x4d2c6dfc5ac42aedU, (uint64_t)0x53380d139d95b3dfU,
+    (uint64_t)0x650a73548baf63deU, (uint64_t)0x766a0abb3c77b2a8U, (uint64_t)0x81c2c92e47edaee6U,
+    (uint64_t)0x92722c851482353bU, (uint64_t)0xa2bfe8a14cf10364U, (uint64_t)0xa81a664bbc423001U,
+    (uint64_t)0xc24b8b70d0f89791U, (uint64_t)0xc76c51a30654be30U, (uint64_t)0xd192e819d6ef5218U,
+    (uint64_t)0xd69906245565a910U, (uint64_t)0xf40e35855771202aU, (uint64_t)0x106aa07032bbd1b8U,
+    (uint64_t)0x19a4c116b8d2d0c8U, (uint64_t)0x1e376c085141ab53U, (uint64_t)0x2748774cdf8eeb99U,
+    (uint64_t)0x34b0bcb5e19b48a8U, (uint64_t)0x391c0cb3c5c95a63U, (uint64_t)0x4ed8aa4ae3418acbU,
+    (uint64_t)0x5b9cca4f7763e373U, (uint64_t)0x682e6ff3d6b2b8a3U, (uint64_t)0x748f82ee5defb2fcU,
+    (uint64_t)0x78a5636f43172f60U, (uint64_t)0x84c87814a1f0ab72U, (uint64_t)0x8cc702081a6439ecU,
+    (uint64_t)0x90befffa23631e28U, (uint64_t)0xa4506cebde82bde9U, (uint64_t)0xbef9a3f7b2c67915U,
+    (uint64_t)0xc67178f2e372532bU, (uint64_t)0xca273eceea26619cU, (uint64_t)0xd186b8c721c0c207U,
+    (uint64_t)0xeada7dd6cde0eb1eU, (uint64_t)0xf57d4f7fee6ed178U, (uint64_t)0x06f067aa72176fbaU,
+    (uint64_t)0x0a637dc5a2c898a6U, (uint64_t)0x113f9804bef90daeU, (uint64_t)0x1b710b35131c471bU,
+    (uint64_t)0x28db77f523047d84U, (uint64_t)0x32caab7b40c72493U, (uint64_t)0x3c9ebe0a15c9bebcU,
+    (uint64_t)0x431d67c49c100d4cU, (uint64_t)0x4cc5d4becb3e42b6U, (uint64_t)0x597f299cfc657e2aU,
+    (uint64_t)0x5fcb6fab3ad6faecU, (uint64_t)0x6c44198c4a475817U
+  };
+
+static inline void transpose8x8(Lib_IntVector_Intrinsics_vec256 *v)
+{
+  Lib_IntVector_Intrinsics_vec256 v0 = v[0U];
+  Lib_IntVector_Intrinsics_vec256 v1 = v[1U];
+  Lib_IntVector_Intrinsics_vec256 v2 = v[2U];
+  Lib_IntVector_Intrinsics_vec256 v3 = v[3U];
+  Lib_IntVector_Intrinsics_vec256 v4 = v[4U];
+  Lib_IntVector_Intrinsics_vec256 v5 = v[5U];
+  Lib_IntVector_Intrinsics_vec256 v6 = v[6U];
+  Lib_IntVector_Intrinsics_vec256 v7 = v[7U];
+  Lib_IntVector_Intrinsics_vec256 v0_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v0, v1);
+  Lib_IntVector_Intrinsics_vec256 v1_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v0, v1);
+  Lib_IntVector_Intrinsics_vec256 v2_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v2, v3);
+  Lib_IntVector_Intrinsics_vec256 v3_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v2, v3);
+  Lib_IntVector_Intrinsics_vec256 v4_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v4, v5);
+  Lib_IntVector_Intrinsics_vec256 v5_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v4, v5);
+  Lib_IntVector_Intrinsics_vec256 v6_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v6, v7);
+  Lib_IntVector_Intrinsics_vec256 v7_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v6, v7);
+  Lib_IntVector_Intrinsics_vec256
+  v0__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v0_, v2_);
+  Lib_IntVector_Intrinsics_vec256
+  v1__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v0_, v2_);
+  Lib_IntVector_Intrinsics_vec256
+  v2__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v1_, v3_);
+  Lib_IntVector_Intrinsics_vec256
+  v3__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v1_, v3_);
+  Lib_IntVector_Intrinsics_vec256
+  v4__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v4_, v6_);
+  Lib_IntVector_Intrinsics_vec256
+  v5__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v4_, v6_);
+  Lib_IntVector_Intrinsics_vec256
+  v6__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v5_, v7_);
+  Lib_IntVector_Intrinsics_vec256
+  v7__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v5_, v7_);
+  v[0U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v0__, v4__);
+  v[4U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v0__, v4__);
+  v[1U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v1__, v5__);
+  v[5U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v1__, v5__);
+  v[2U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v2__, v6__);
+  v[6U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v2__, v6__);
+  v[3U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v3__, v7__);
+  v[7U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v3__, v7__);
+}
+
+static inline void init8(Lib_IntVector_Intrinsics_vec256 *hash)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    hash[i] = Lib_IntVector_Intrinsics_vec256_load32(h256[i]);
+  }
+}
+
+static inline void update8(Lib_IntVector_Intrinsics_vec256 *hash, uint8_t **b)
+{
+  Lib_IntVector_Intrinsics_vec256 hash1[8U];
+  for (uint32_t _i = 0U; _i < (uint32_t)8U; ++_i)
+    hash1[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  Lib_IntVector_Intrinsics_vec256 ws[64U];
+  for (uint32_t _i = 0U; _i < (uint32_t)64U; ++_i)
+    ws[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    ws[i] = Lib_IntVector_Intrinsics_vec256_load32_be(b[i]);
+    ws[i + (uint32_t)8U] = Lib_IntVector_Intrinsics_vec256_load32_be(b[i] + (uint32_t)32U);
+  }
+  transpose8x8(ws);
+  transpose8x8(ws + (uint32_t)8U);
+  for (uint32_t i = (uint32_t)16U; i < (uint32_t)64U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 t16 = ws[i - (uint32_t)16U];
+    Lib_IntVector_Intrinsics_vec256 t15 = ws[i - (uint32_t)15U];
+    Lib_IntVector_Intrinsics_vec256 t7 = ws[i - (uint32_t)7U];
+    Lib_IntVector_Intrinsics_vec256 t2 = ws[i - (uint32_t)2U];
+    Lib_IntVector_Intrinsics_vec256
+    s1 =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right32(t2,
+          (uint32_t)17U),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right32(t2,
+            (uint32_t)19U),
+          Lib_IntVector_Intrinsics_vec256_shift_right32(t2, (uint32_t)10U)));
+    Lib_IntVector_Intrinsics_vec256
+    s0 =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right32(t15,
+          (uint32_t)7U),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right32(t15,
+            (uint32_t)18U),
+          Lib_IntVector_Intrinsics_vec256_shift_right32(t15, (uint32_t)3U)));
+    ws[i] =
+      Lib_IntVector_Intrinsics_vec256_add32(Lib_IntVector_Intrinsics_vec256_add32(s1, t7),
+        Lib_IntVector_Intrinsics_vec256_add32(s0, t16));
+  }
+  memcpy(hash1, hash, (uint32_t)8U * sizeof (Lib_IntVector_Intrinsics_vec256));
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)64U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 a0 = hash1[0U];
+    Lib_IntVector_Intrinsics_vec256 b0 = hash1[1U];
+    Lib_IntVector_Intrinsics_vec256 c0 = hash1[2U];
+    Lib_IntVector_Intrinsics_vec256 d0 = hash1[3U];
+    Lib_IntVector_Intrinsics_vec256 e0 = hash1[4U];
+    Lib_IntVector_Intrinsics_vec256 f0 = hash1[5U];
+    Lib_IntVector_Intrinsics_vec256 g0 = hash1[6U];
+    Lib_IntVector_Intrinsics_vec256 h02 = hash1[7U];
+    Lib_IntVector_Intrinsics_vec256 k_e_t = Lib_IntVector_Intrinsics_vec256_load32(k224_256[i]);
+    Lib_IntVector_Intrinsics_vec256
+    sigma1 =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right32(e0,
+          (uint32_t)6U),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right32(e0,
+            (uint32_t)11U),
+          Lib_IntVector_Intrinsics_vec256_rotate_right32(e0, (uint32_t)25U)));
+    Lib_IntVector_Intrinsics_vec256
+    ch =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_and(e0, f0),
+        Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_lognot(e0), g0));
+    Lib_IntVector_Intrinsics_vec256
+    t1 =
+      Lib_IntVector_Intrinsics_vec256_add32(Lib_IntVector_Intrinsics_vec256_add32(h02, sigma1),
+        Lib_IntVector_Intrinsics_vec256_add32(ch,
+          Lib_IntVector_Intrinsics_vec256_add32(k_e_t, ws[i])));
+    Lib_IntVector_Intrinsics_vec256
+    sigma0 =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right32(a0,
+          (uint32_t)2U),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right32(a0,
+            (uint32_t)13U),
+          Lib_IntVector_Intrinsics_vec256_rotate_right32(a0, (uint32_t)22U)));
+    Lib_IntVector_Intrinsics_vec256
+    maj =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_and(a0, b0),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_and(a0, c0),
+          Lib_IntVector_Intrinsics_vec256_and(b0, c0)));
+    Lib_IntVector_Intrinsics_vec256 t2 = Lib_IntVector_Intrinsics_vec256_add32(sigma0, maj);
+    hash1[0U] = Lib_IntVector_Intrinsics_vec256_add32(t1, t2);
+    hash1[1U] = a0;
+    hash1[2U] = b0;
+    hash1[3U] = c0;
+    hash1[4U] = Lib_IntVector_Intrinsics_vec256_add32(d0, t1);
+    hash1[5U] = e0;
+    hash1[6U] = f0;
+    hash1[7U] = g0;
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    hash[i] = Lib_IntVector_Intrinsics_vec256_add32(hash[i], hash1[i]);
+  }
+}
+
+static inline void finish8(Lib_IntVector_Intrinsics_vec256 *hash, uint8_t **dst)
+{
+  Lib_IntVector_Intrinsics_vec256 hash1[8U];
+  memcpy(hash1, hash, (uint32_t)8U * sizeof (Lib_IntVector_Intrinsics_vec256));
+  transpose8x8(hash1);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256_store32_be(dst[i], hash1[i]);
+  }
+}
+
+void Hacl_SHA2_Vec256_sha256_compress8(uint8_t **blocks, uint8_t **dst)
+{
+  Lib_IntVector_Intrinsics_vec256 hash[8U];
+  init8(hash);
+  update8(hash, blocks);
+  finish8(hash, dst);
+}
+
+static inline void
+start_lane8(
+  uint8_t *pad,
+  uint32_t *nb,
+  uint32_t *full,
+  uint8_t *input,
+  uint32_t len
+)
+{
+  uint32_t rem = len % (uint32_t)64U;
+  full[0U] = len / (uint32_t)64U;
+  uint32_t npad;
+  if (rem + (uint32_t)9U <= (uint32_t)64U)
+  {
+    npad = (uint32_t)1U;
+  }
+  else
+  {
+    npad = (uint32_t)2U;
+  }
+  nb[0U] = full[0U] + npad;
+  memset(pad, 0U, (uint32_t)128U * sizeof (uint8_t));
+  memcpy(pad, input + full[0U] * (uint32_t)64U, rem * sizeof (uint8_t));
+  pad[rem] = (uint8_t)0x80U;
+  store64_be(pad + npad * (uint32_t)64U - (uint32_t)8U, (uint64_t)len << (uint32_t)3U);
+}
+
+void
+Hacl_SHA2_Vec256_sha256_multi(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst)
+{
+  Lib_IntVector_Intrinsics_vec256 hash[8U];
+  uint8_t st[256U] = { 0U };
+  uint8_t pad[1024U] = { 0U };
+  uint8_t zero[64U] = { 0U };
+  uint32_t msg[8U] = { 0U };
+  uint32_t blk[8U] = { 0U };
+  uint32_t nb[8U] = { 0U };
+  uint32_t full[8U] = { 0U };
+  uint8_t *bs[8U];
+  uint32_t next = (uint32_t)0U;
+  uint32_t active = (uint32_t)0U;
+  init8(hash);
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)8U; l++)
+  {
+    if (next < n)
+    {
+      msg[l] = next;
+      start_lane8(pad + l * (uint32_t)128U, nb + l, full + l, inputs[next], lens[next]);
+      next++;
+      active++;
+    }
+    else
+    {
+      msg[l] = n;
+    }
+  }
+  while (active > (uint32_t)0U)
+  {
+    for (uint32_t l = (uint32_t)0U; l < (uint32_t)8U; l++)
+    {
+      if (msg[l] == n)
+      {
+        bs[l] = zero;
+      }
+      else if (blk[l] < full[l])
+      {
+        bs[l] = inputs[msg[l]] + blk[l] * (uint32_t)64U;
+      }
+      else
+      {
+        bs[l] = pad + l * (uint32_t)128U + (blk[l] - full[l]) * (uint32_t)64U;
+      }
+    }
+    update8(hash, bs);
+    bool done = false;
+    for (uint32_t l = (uint32_t)0U; l < (uint32_t)8U; l++)
+    {
+      if (msg[l] < n)
+      {
+        blk[l]++;
+        done = done || blk[l] == nb[l];
+      }
+    }
+    if (done)
+    {
+      /* Lanes are only touched when a message ends: spill the state, write
+         out the finished digests, and restart those lanes on the next
+         messages. */
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+      {
+        Lib_IntVector_Intrinsics_vec256_store_le(st + i * (uint32_t)32U, hash[i]);
+      }
+      for (uint32_t l = (uint32_t)0U; l < (uint32_t)8U; l++)
+      {
+        if (msg[l] < n && blk[l] == nb[l])
+        {
+          for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+          {
+            uint8_t *w = st + i * (uint32_t)32U + l * (uint32_t)4U;
+            store32_be(dst[msg[l]] + i * (uint32_t)4U, load32_le(w));
+            store32_le(w, h256[i]);
+          }
+          blk[l] = (uint32_t)0U;
+          if (next < n)
+          {
+            msg[l] = next;
+            start_lane8(pad + l * (uint32_t)128U, nb + l, full + l, inputs[next], lens[next]);
+            next++;
+          }
+          else
+          {
+            msg[l] = n;
+            active--;
+          }
+        }
+      }
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+      {
+        hash[i] = Lib_IntVector_Intrinsics_vec256_load_le(st + i * (uint32_t)32U);
+      }
+    }
+  }
+}
+
+static inline void transpose4x4_64(Lib_IntVector_Intrinsics_vec256 *v)
+{
+  Lib_IntVector_Intrinsics_vec256 v0 = v[0U];
+  Lib_IntVector_Intrinsics_vec256 v1 = v[1U];
+  Lib_IntVector_Intrinsics_vec256 v2 = v[2U];
+  Lib_IntVector_Intrinsics_vec256 v3 = v[3U];
+  Lib_IntVector_Intrinsics_vec256 v0_ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v0, v1);
+  Lib_IntVector_Intrinsics_vec256 v1_ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v0, v1);
+  Lib_IntVector_Intrinsics_vec256 v2_ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v2, v3);
+  Lib_IntVector_Intrinsics_vec256 v3_ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v2, v3);
+  v[0U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v0_, v2_);
+  v[1U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v1_, v3_);
+  v[2U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v0_, v2_);
+  v[3U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v1_, v3_);
+}
+
+static inline void init4_512(const uint64_t *iv, Lib_IntVector_Intrinsics_vec256 *hash)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    hash[i] = Lib_IntVector_Intrinsics_vec256_load64(iv[i]);
+  }
+}
+
+static inline void update4_512(Lib_IntVector_Intrinsics_vec256 *hash, uint8_t **b)
+{
+  Lib_IntVector_Intrinsics_vec256 hash1[8U];
+  for (uint32_t _i = 0U; _i < (uint32_t)8U; ++_i)
+    hash1[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  Lib_IntVector_Intrinsics_vec256 ws[80U];
+  for (uint32_t _i = 0U; _i < (uint32_t)80U; ++_i)
+    ws[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
+  {
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+    {
+      ws[i0 * (uint32_t)4U + i] = Lib_IntVector_Intrinsics_vec256_load64_be(b[i] + i0 * (uint32_t)32U);
+    }
+    transpose4x4_64(ws + i0 * (uint32_t)4U);
+  }
+  for (uint32_t i = (uint32_t)16U; i < (uint32_t)80U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 t16 = ws[i - (uint32_t)16U];
+    Lib_IntVector_Intrinsics_vec256 t15 = ws[i - (uint32_t)15U];
+    Lib_IntVector_Intrinsics_vec256 t7 = ws[i - (uint32_t)7U];
+    Lib_IntVector_Intrinsics_vec256 t2 = ws[i - (uint32_t)2U];
+    Lib_IntVector_Intrinsics_vec256
+    s1 =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right64(t2, (uint32_t)19U),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right64(t2, (uint32_t)61U),
+          Lib_IntVector_Intrinsics_vec256_shift_right64(t2, (uint32_t)6U)));
+    Lib_IntVector_Intrinsics_vec256
+    s0 =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right64(t15, (uint32_t)1U),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right64(t15, (uint32_t)8U),
+          Lib_IntVector_Intrinsics_vec256_shift_right64(t15, (uint32_t)7U)));
+    ws[i] =
+      Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(s1, t7),
+        Lib_IntVector_Intrinsics_vec256_add64(s0, t16));
+  }
+  memcpy(hash1, hash, (uint32_t)8U * sizeof (Lib_IntVector_Intrinsics_vec256));
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)80U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256 a0 = hash1[0U];
+    Lib_IntVector_Intrinsics_vec256 b0 = hash1[1U];
+    Lib_IntVector_Intrinsics_vec256 c0 = hash1[2U];
+    Lib_IntVector_Intrinsics_vec256 d0 = hash1[3U];
+    Lib_IntVector_Intrinsics_vec256 e0 = hash1[4U];
+    Lib_IntVector_Intrinsics_vec256 f0 = hash1[5U];
+    Lib_IntVector_Intrinsics_vec256 g0 = hash1[6U];
+    Lib_IntVector_Intrinsics_vec256 h02 = hash1[7U];
+    Lib_IntVector_Intrinsics_vec256 k_e_t = Lib_IntVector_Intrinsics_vec256_load64(k384_512[i]);
+    Lib_IntVector_Intrinsics_vec256
+    sigma1 =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right64(e0, (uint32_t)14U),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right64(e0, (uint32_t)18U),
+          Lib_IntVector_Intrinsics_vec256_rotate_right64(e0, (uint32_t)41U)));
+    Lib_IntVector_Intrinsics_vec256
+    ch =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_and(e0, f0),
+        Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_lognot(e0), g0));
+    Lib_IntVector_Intrinsics_vec256
+    t1 =
+      Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(h02, sigma1),
+        Lib_IntVector_Intrinsics_vec256_add64(ch,
+          Lib_IntVector_Intrinsics_vec256_add64(k_e_t, ws[i])));
+    Lib_IntVector_Intrinsics_vec256
+    sigma0 =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right64(a0, (uint32_t)28U),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_rotate_right64(a0, (uint32_t)34U),
+          Lib_IntVector_Intrinsics_vec256_rotate_right64(a0, (uint32_t)39U)));
+    Lib_IntVector_Intrinsics_vec256
+    maj =
+      Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_and(a0, b0),
+        Lib_IntVector_Intrinsics_vec256_xor(Lib_IntVector_Intrinsics_vec256_and(a0, c0),
+          Lib_IntVector_Intrinsics_vec256_and(b0, c0)));
+    Lib_IntVector_Intrinsics_vec256 t2 = Lib_IntVector_Intrinsics_vec256_add64(sigma0, maj);
+    hash1[0U] = Lib_IntVector_Intrinsics_vec256_add64(t1, t2);
+    hash1[1U] = a0;
+    hash1[2U] = b0;
+    hash1[3U] = c0;
+    hash1[4U] = Lib_IntVector_Intrinsics_vec256_add64(d0, t1);
+    hash1[5U] = e0;
+    hash1[6U] = f0;
+    hash1[7U] = g0;
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    hash[i] = Lib_IntVector_Intrinsics_vec256_add64(hash[i], hash1[i]);
+  }
+}
+
+static inline void
+start_lane4_512(
+  uint8_t *pad,
+  uint32_t *nb,
+  uint32_t *full,
+  uint8_t *input,
+  uint32_t len
+)
+{
+  uint32_t rem = len % (uint32_t)128U;
+  full[0U] = len / (uint32_t)128U;
+  uint32_t npad;
+  if (rem + (uint32_t)17U <= (uint32_t)128U)
+  {
+    npad = (uint32_t)1U;
+  }
+  else
+  {
+    npad = (uint32_t)2U;
+  }
+  nb[0U] = full[0U] + npad;
+  memset(pad, 0U, (uint32_t)256U * sizeof (uint8_t));
+  memcpy(pad, input + full[0U] * (uint32_t)128U, rem * sizeof (uint8_t));
+  pad[rem] = (uint8_t)0x80U;
+  store64_be(pad + npad * (uint32_t)128U - (uint32_t)8U, (uint64_t)len << (uint32_t)3U);
+}
+
+static void
+multi4_512(
+  const uint64_t *iv,
+  uint32_t hlen,
+  uint32_t n,
+  uint8_t **inputs,
+  uint32_t *lens,
+  uint8_t **dst
+)
+{
+  Lib_IntVector_Intrinsics_vec256 hash[8U];
+  uint8_t st[256U] = { 0U };
+  uint8_t pad[1024U] = { 0U };
+  uint8_t zero[128U] = { 0U };
+  uint32_t msg[4U] = { 0U };
+  uint32_t blk[4U] = { 0U };
+  uint32_t nb[4U] = { 0U };
+  uint32_t full[4U] = { 0U };
+  uint8_t *bs[4U];
+  uint32_t next = (uint32_t)0U;
+  uint32_t active = (uint32_t)0U;
+  init4_512(iv, hash);
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+  {
+    if (next < n)
+    {
+      msg[l] = next;
+      start_lane4_512(pad + l * (uint32_t)256U, nb + l, full + l, inputs[next], lens[next]);
+      next++;
+      active++;
+    }
+    else
+    {
+      msg[l] = n;
+    }
+  }
+  while (active > (uint32_t)0U)
+  {
+    for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+    {
+      if (msg[l] == n)
+      {
+        bs[l] = zero;
+      }
+      else if (blk[l] < full[l])
+      {
+        bs[l] = inputs[msg[l]] + blk[l] * (uint32_t)128U;
+      }
+      else
+      {
+        bs[l] = pad + l * (uint32_t)256U + (blk[l] - full[l]) * (uint32_t)128U;
+      }
+    }
+    update4_512(hash, bs);
+    bool done = false;
+    for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+    {
+      if (msg[l] < n)
+      {
+        blk[l]++;
+        done = done || blk[l] == nb[l];
+      }
+    }
+    if (done)
+    {
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+      {
+        Lib_IntVector_Intrinsics_vec256_store_le(st + i * (uint32_t)32U, hash[i]);
+      }
+      for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+      {
+        if (msg[l] < n && blk[l] == nb[l])
+        {
+          for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+          {
+            uint8_t *w = st + i * (uint32_t)32U + l * (uint32_t)8U;
+            if (i < hlen / (uint32_t)8U)
+            {
+              store64_be(dst[msg[l]] + i * (uint32_t)8U, load64_le(w));
+            }
+            store64_le(w, iv[i]);
+          }
+          blk[l] = (uint32_t)0U;
+          if (next < n)
+          {
+            msg[l] = next;
+            start_lane4_512(pad + l * (uint32_t)256U, nb + l, full + l, inputs[next], lens[next]);
+            next++;
+          }
+          else
+          {
+            msg[l] = n;
+            active--;
+          }
+        }
+      }
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+      {
+        hash[i] = Lib_IntVector_Intrinsics_vec256_load_le(st + i * (uint32_t)32U);
+      }
+    }
+  }
+}
+
+void
+Hacl_SHA2_Vec256_sha384_multi(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst)
+{
+  multi4_512(h384, (uint32_t)48U, n, inputs, lens, dst);
+}
+
+void
+Hacl_SHA2_Vec256_sha512_multi(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst)
+{
+  multi4_512(h512, (uint32_t)64U, n, inputs, lens, dst);
+}
+
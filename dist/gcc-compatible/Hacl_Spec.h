@@ -71,6 +71,8 @@ typedef uint8_t Spec_Agile_Cipher_cipher_alg;
 #define Spec_Cipher_Expansion_Hacl_CHACHA20 0
 #define Spec_Cipher_Expansion_Vale_AES128 1
 #define Spec_Cipher_Expansion_Vale_AES256 2
+#define Spec_Cipher_Expansion_Hacl_AES128 3
+#define Spec_Cipher_Expansion_Hacl_AES256 4
 
 typedef uint8_t Spec_Cipher_Expansion_impl;
 
@@ -0,0 +1,67 @@
+#if __has_include("config.h")
+#include "config.h"
+#endif
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "Lib_Parallel.h"
+
+/* A minimal fork-join helper for the few places where we hash or encrypt
+   independent chunks of data. Workers (including the calling thread) claim
+   task indices from a shared counter until none are left, so that threads
+   which finish early pick up the remaining work. There is no persistent pool:
+   threads are created and joined for each call, which is negligible compared
+   to the chunks of work we hand out. */
+
+typedef struct {
+  void (*f)(void *ctx, uint32_t i);
+  void *ctx;
+  uint32_t ntasks;
+  uint32_t next;
+} job;
+
+static void run_tasks(job *j) {
+  uint32_t i;
+  while ((i = __atomic_fetch_add(&j->next, 1, __ATOMIC_RELAXED)) < j->ntasks)
+    j->f(j->ctx, i);
+}
+
+#ifndef _WIN32
+static void *worker(void *arg) {
+  run_tasks((job *) arg);
+  return NULL;
+}
+#endif
+
+void Lib_Parallel_run(uint32_t nthreads, uint32_t ntasks,
+  void (*f)(void *ctx, uint32_t i), void *ctx)
+{
+  job j = { .f = f, .ctx = ctx, .ntasks = ntasks, .next = 0 };
+  if (nthreads > ntasks)
+    nthreads = ntasks;
+
+#ifndef _WIN32
+  if (nthreads > 1) {
+    pthread_t *ts = malloc((nthreads - 1) * sizeof (pthread_t));
+    uint32_t started = 0;
+    if (ts != NULL)
+      for (; started < nthreads - 1; started++)
+        if (pthread_create(&ts[started], NULL, worker, &j) != 0)
+          break;
+    /* If we could not spawn some (or any) of the workers, the calling thread
+       simply ends up doing more of the tasks. */
+    run_tasks(&j);
+    for (uint32_t k = 0; k < started; k++)
+      pthread_join(ts[k], NULL);
+    free(ts);
+    return;
+  }
+#endif
+
+  run_tasks(&j);
+}
@@ -24,16 +24,241 @@
 
 #include "MerkleTree.h"
 
+#ifdef _WIN32
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/* Hashes are not allocated one by one: they are carved out of slabs, which are
+   MT_SLAB_SIZE-aligned blocks holding an mt_slab header followed by an array of
+   stride-byte slots. Consecutive allocations of one hash size (e.g. the nodes
+   of a level built by a batch insertion) thus occupy consecutive slots, with
+   no per-hash allocator overhead, and the slab of a hash is found by masking
+   its address. Each hash size has a pool that lists its slabs with a free
+   slot, so that a freed slot is reused whichever slab it is in. A slab is
+   released as soon as its last hash is freed, and a pool once its last slab
+   is: freeing every hash, e.g. with mt_free, returns all memory. Hashes too
+   large to share a slab get a slab of their own. */
+
+#define MT_SLAB_SIZE ((uintptr_t)64U * (uintptr_t)1024U)
+
+#define MT_SLAB_HEADER ((uint32_t)64U)
+
+typedef struct mt_slab_s
+{
+  struct mt_slab_pool_s *pool;
+  struct mt_slab_s *prev;
+  struct mt_slab_s *next;
+  uint32_t stride;
+  uint32_t nslots;
+  uint32_t top;
+  uint32_t live;
+  uint8_t *free;
+}
+mt_slab;
+
+typedef struct mt_slab_pool_s
+{
+  uint32_t stride;
+  uint32_t nslabs;
+  mt_slab *avail;
+  struct mt_slab_pool_s *next;
+}
+mt_slab_pool;
+
+static mt_slab_pool *mt_slab_pools = NULL;
+
+#ifdef _WIN32
+static SRWLOCK mt_slab_lock = SRWLOCK_INIT;
+
+static void slab_lock(void)
+{
+  AcquireSRWLockExclusive(&mt_slab_lock);
+}
+
+static void slab_unlock(void)
+{
+  ReleaseSRWLockExclusive(&mt_slab_lock);
+}
+#else
+static pthread_mutex_t mt_slab_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void slab_lock(void)
+{
+  pthread_mutex_lock(&mt_slab_lock);
+}
+
+static void slab_unlock(void)
+{
+  pthread_mutex_unlock(&mt_slab_lock);
+}
+#endif
+
+static mt_slab *slab_new(mt_slab_pool *pool, uint32_t stride, uintptr_t size)
+{
+  void *p;
+  #ifdef _WIN32
+  p = _aligned_malloc(size, MT_SLAB_SIZE);
+  #else
+  if (posix_memalign(&p, MT_SLAB_SIZE, size) != 0)
+    p = NULL;
+  #endif
+  if (p == NULL)
+    return NULL;
+  mt_slab *sl = p;
+  sl->pool = pool;
+  sl->prev = NULL;
+  sl->next = NULL;
+  sl->stride = stride;
+  sl->nslots = (uint32_t)((size - MT_SLAB_HEADER) / stride);
+  sl->top = (uint32_t)0U;
+  sl->live = (uint32_t)0U;
+  sl->free = NULL;
+  return sl;
+}
+
+static void slab_release(mt_slab *sl)
+{
+  #ifdef _WIN32
+  _aligned_free(sl);
+  #else
+  free(sl);
+  #endif
+}
+
+static bool slab_full(mt_slab *sl)
+{
+  return sl->free == NULL && sl->top == sl->nslots;
+}
+
+static uint8_t *slab_take(mt_slab *sl)
+{
+  uint8_t *v = sl->free;
+  if (v != NULL)
+    memcpy(&sl->free, v, sizeof (uint8_t *));
+  else
+  {
+    v = (uint8_t *)sl + MT_SLAB_HEADER + sl->top * sl->stride;
+    sl->top = sl->top + (uint32_t)1U;
+  }
+  sl->live = sl->live + (uint32_t)1U;
+  return v;
+}
+
+static void pool_link(mt_slab_pool *pool, mt_slab *sl)
+{
+  sl->prev = NULL;
+  sl->next = pool->avail;
+  if (pool->avail != NULL)
+    pool->avail->prev = sl;
+  pool->avail = sl;
+}
+
+static void pool_unlink(mt_slab_pool *pool, mt_slab *sl)
+{
+  if (sl->prev != NULL)
+    sl->prev->next = sl->next;
+  else
+    pool->avail = sl->next;
+  if (sl->next != NULL)
+    sl->next->prev = sl->prev;
+  sl->prev = NULL;
+  sl->next = NULL;
+}
+
+/* Called with the lock held, once pool has lost its last slab. */
+static void pool_drop(mt_slab_pool *pool)
+{
+  mt_slab_pool **pp = &mt_slab_pools;
+  while (*pp != pool)
+    pp = &(*pp)->next;
+  *pp = pool->next;
+  KRML_HOST_FREE(pool);
+}
+
 static uint8_t *hash_r_alloc(uint32_t s)
 {
   KRML_CHECK_SIZE(sizeof (uint8_t), s);
-  uint8_t *buf = KRML_HOST_CALLOC(s, sizeof (uint8_t));
-  return buf;
+  uint32_t a = (uint32_t)sizeof (uint8_t *);
+  if (s > (uint32_t)0xffff0000U)
+    return NULL;
+  uint32_t stride = s < a ? a : s + (a - s % a) % a;
+  uint8_t *v = NULL;
+  if (stride > (uint32_t)((MT_SLAB_SIZE - MT_SLAB_HEADER) / 4U))
+  {
+    uintptr_t size = (MT_SLAB_HEADER + (uintptr_t)stride + MT_SLAB_SIZE - 1U) & ~(MT_SLAB_SIZE - 1U);
+    mt_slab *sl = slab_new(NULL, stride, size);
+    if (sl != NULL)
+      v = slab_take(sl);
+  }
+  else
+  {
+    slab_lock();
+    mt_slab_pool *pool = mt_slab_pools;
+    while (pool != NULL && pool->stride != stride)
+      pool = pool->next;
+    if (pool == NULL && (pool = KRML_HOST_MALLOC(sizeof (mt_slab_pool))) != NULL)
+    {
+      pool->stride = stride;
+      pool->nslabs = (uint32_t)0U;
+      pool->avail = NULL;
+      pool->next = mt_slab_pools;
+      mt_slab_pools = pool;
+    }
+    if (pool != NULL)
+    {
+      mt_slab *sl = pool->avail;
+      if (sl == NULL && (sl = slab_new(pool, stride, MT_SLAB_SIZE)) != NULL)
+      {
+        pool->nslabs = pool->nslabs + (uint32_t)1U;
+        pool_link(pool, sl);
+      }
+      if (sl != NULL)
+      {
+        v = slab_take(sl);
+        if (slab_full(sl))
+          pool_unlink(pool, sl);
+      }
+      else if (pool->nslabs == (uint32_t)0U)
+        pool_drop(pool);
+    }
+    slab_unlock();
+  }
+  if (v != NULL)
+    memset(v, 0U, s);
+  return v;
 }
 
 static void hash_r_free(uint8_t *v)
 {
-  KRML_HOST_FREE(v);
+  if (v == NULL)
+    return;
+  mt_slab *sl = (mt_slab *)((uintptr_t)v & ~(MT_SLAB_SIZE - 1U));
+  mt_slab_pool *pool = sl->pool;
+  if (pool == NULL)
+  {
+    slab_release(sl);
+    return;
+  }
+  slab_lock();
+  if (slab_full(sl))
+    pool_link(pool, sl);
+  memcpy(v, &sl->free, sizeof (uint8_t *));
+  sl->free = v;
+  sl->live = sl->live - (uint32_t)1U;
+  bool dead = sl->live == (uint32_t)0U;
+  if (dead)
+  {
+    pool_unlink(pool, sl);
+    pool->nslabs = pool->nslabs - (uint32_t)1U;
+    if (pool->nslabs == (uint32_t)0U)
+      pool_drop(pool);
+  }
+  slab_unlock();
+  if (dead)
+    slab_release(sl);
 }
 
 static void hash_copy(uint32_t s, uint8_t *src, uint8_t *dst)
@@ -63,6 +288,10 @@ static void free___uint8_t_(MerkleTree_Low_Datastructures_hash_vec vec)
 
 static void hash_vec_r_free(MerkleTree_Low_Datastructures_hash_vec v)
 {
+  for (uint32_t k = (uint32_t)0U; k < v.sz; k++)
+  {
+    hash_r_free(v.vs[k]);
+  }
   free___uint8_t_(v);
 }
 
@@ -98,6 +327,19 @@ inline void mt_free_path(MerkleTree_Low_path *p)
   MerkleTree_Low_free_path(p);
 }
 
+/*
+  Clearing a path
+
+  @param[in] p Path
+
+  Note: The path keeps its storage, so it can be passed again to
+  mt_get_path or mt_get_multi_path without reallocation.
+*/
+inline void mt_clear_path(MerkleTree_Low_path *p)
+{
+  MerkleTree_Low_clear_path(p);
+}
+
 /*
   Length of a path
 
@@ -180,11 +422,58 @@ inline bool mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *v)
   return MerkleTree_Low_mt_insert_pre(mt, v);
 }
 
+/*
+  Batch insertion
+
+  @param[in]  mt  The Merkle tree
+  @param[in]  vs  Buffer of n consecutive hashes; the tree makes copies of them.
+  @param[in]  n   Number of hashes in vs
+
+ Note: Equivalent to n calls to mt_insert, but new internal nodes are computed
+ level by level, several at a time when the default hash function is used.
+*/
+inline void mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint8_t *vs, uint32_t n)
+{
+  MerkleTree_Low_mt_insert_batch(mt, vs, n);
+}
+
+/*
+  Precondition predicate for mt_insert_batch
+*/
+inline bool mt_insert_batch_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *vs, uint32_t n)
+{
+  return MerkleTree_Low_mt_insert_batch_pre(mt, vs, n);
+}
+
+/*
+  Parallel batch insertion
+
+  @param[in]  mt        The Merkle tree
+  @param[in]  vs        Buffer of n consecutive hashes; the tree makes copies of them.
+  @param[in]  n         Number of hashes in vs
+  @param[in]  nthreads  Maximum number of threads to use
+
+ Note: The lower levels are split into independent subtrees that are hashed
+ concurrently; the levels above them are completed on the calling thread. The
+ resulting tree is identical to the one produced by mt_insert_batch. Batches
+ that are too small to be worth splitting are inserted serially. The
+ precondition is mt_insert_batch_pre.
+*/
+inline void
+mt_insert_batch_par(MerkleTree_Low_merkle_tree *mt, uint8_t *vs, uint32_t n, uint32_t nthreads)
+{
+  MerkleTree_Low_mt_insert_batch_par(mt, vs, n, nthreads);
+}
+
 /*
   Getting the Merkle root
 
   @param[in]  mt   The Merkle tree
   @param[out] root The Merkle root
+
+  Note: The root is cached until the next modification. After an insertion,
+  only the right-hand side of the tree is recomputed, with one hash per level
+  whose node count is odd.
 */
 inline void mt_get_root(const MerkleTree_Low_merkle_tree *mt, uint8_t *root)
 {
@@ -240,6 +529,51 @@ mt_get_path_pre(
   return MerkleTree_Low_mt_get_path_pre(mt, idx, path1, root);
 }
 
+/*
+  Getting a Merkle multi-path
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  idxs The indices of the target hashes, in strictly increasing order
+  @param[in]  n    The number of indices in idxs
+  @param[out] path A resulting multi-path: the n target hashes, followed by
+                   the nodes needed to recompute the root from them
+  @param[out] root The Merkle root
+
+  return The number of elements in the tree
+
+  Notes:
+  - Nodes shared by the paths of several targets, and nodes that can be
+    recomputed from the targets themselves, appear only once, or not at all.
+  - As for mt_get_path, the resulting path contains pointers to hashes in the
+    tree, and path must be empty (see mt_clear_path).
+*/
+inline uint32_t
+mt_get_multi_path(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  MerkleTree_Low_path *path1,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_get_multi_path(mt, idxs, n, path1, root);
+}
+
+/*
+  Precondition predicate for mt_get_multi_path
+*/
+inline bool
+mt_get_multi_path_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_get_multi_path_pre(mt, idxs, n, path1, root);
+}
+
 /*
   Flush the Merkle tree
 
@@ -338,6 +672,49 @@ mt_verify_pre(
   return MerkleTree_Low_mt_verify_pre(mt, tgt, max, path1, root);
 }
 
+/*
+  Client-side verification of a multi-path
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  idxs The indices of the target hashes, in strictly increasing order
+  @param[in]  n    The number of indices in idxs
+  @param[in]  max  The maximum index + 1 of the tree when the path was generated
+  @param[in]  path The Merkle multi-path to verify
+  @param[in]  root
+
+  return true if the verification succeeded, false otherwise
+
+  Note: The root is recomputed in a single pass over the levels of the tree.
+*/
+inline bool
+mt_verify_multi(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  uint64_t max,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_verify_multi(mt, idxs, n, max, path1, root);
+}
+
+/*
+  Precondition predicate for mt_verify_multi
+*/
+inline bool
+mt_verify_multi_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  uint64_t max,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_verify_multi_pre(mt, idxs, n, max, path1, root);
+}
+
 /*
   Serialization size
 
@@ -419,6 +796,110 @@ inline MerkleTree_Low_path
   return MerkleTree_Low_Serialization_mt_deserialize_path(buf, len);
 }
 
+/*
+  Streaming Merkle tree serialization
+
+  @param[in]  mt    The Merkle tree
+  @param[in]  write Called with consecutive chunks of the serialized tree;
+                    returns false to abort
+  @param[in]  ctx   Passed to write
+
+  return the number of bytes written, or 0 if write failed
+
+  Note: Produces the same bytes as mt_serialize, without a buffer holding the
+  whole tree, and without its 4GB limit.
+*/
+inline uint64_t
+mt_serialize_stream(
+  const MerkleTree_Low_merkle_tree *mt,
+  bool (*write)(void *ctx, const uint8_t *buf, uint32_t len),
+  void *ctx
+)
+{
+  return MerkleTree_Low_Serialization_mt_serialize_stream(mt, write, ctx);
+}
+
+/*
+  Streaming Merkle tree deserialization
+
+  @param[in]  read     Fills up to len bytes of buf from the stream; returns
+                       the number of bytes read, or 0 at the end of the stream
+                       or on error
+  @param[in]  ctx      Passed to read
+  @param[in]  hash_fun Hash function
+
+  return pointer to the new tree if successful, NULL otherwise
+
+  Note: Reads the format of mt_serialize and mt_serialize_stream, and never
+  reads past the end of the tree.
+*/
+inline MerkleTree_Low_merkle_tree
+*mt_deserialize_stream(
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  return MerkleTree_Low_Serialization_mt_deserialize_stream(read, ctx, hash_fun);
+}
+
+/*
+  Delta serialization
+
+  @param[in]  mt    The Merkle tree
+  @param[in]  since The number of elements (offset + j) of the tree at the
+                    last checkpoint
+  @param[in]  write As for mt_serialize_stream
+  @param[in]  ctx   Passed to write
+
+  return the number of bytes written, or 0 if write failed
+
+  Note: Only the nodes added to each level since the checkpoint are written,
+  together with the current flush index and root. Levels are append-only
+  between a flush and the next retraction, so this is valid as long as the
+  tree was not retracted below since; otherwise, take a full checkpoint.
+*/
+inline uint64_t
+mt_serialize_delta(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint64_t since,
+  bool (*write)(void *ctx, const uint8_t *buf, uint32_t len),
+  void *ctx
+)
+{
+  return MerkleTree_Low_Serialization_mt_serialize_delta(mt, since, write, ctx);
+}
+
+/*
+  Precondition predicate for mt_serialize_delta
+*/
+inline bool mt_serialize_delta_pre(const MerkleTree_Low_merkle_tree *mt, uint64_t since)
+{
+  return MerkleTree_Low_Serialization_mt_serialize_delta_pre(mt, since);
+}
+
+/*
+  Applying a delta
+
+  @param[in]  mt   The Merkle tree restored from the checkpoint the delta was
+                   taken against
+  @param[in]  read As for mt_deserialize_stream
+  @param[in]  ctx  Passed to read
+
+  return true if successful; otherwise, the tree is left unchanged
+
+  Note: Nodes flushed by the writer since the checkpoint are flushed from mt.
+*/
+inline bool
+mt_deserialize_delta(
+  MerkleTree_Low_merkle_tree *mt,
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx
+)
+{
+  return MerkleTree_Low_Serialization_mt_deserialize_delta(mt, read, ctx);
+}
+
 /*
   Default hash function
 */
@@ -1055,24 +1536,318 @@ void MerkleTree_Low_mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v)
     );
 }
 
-MerkleTree_Low_merkle_tree
-*MerkleTree_Low_mt_create_custom(
+static void
+hash_pairs(
   uint32_t hsz,
-  uint8_t *init,
-  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2),
+  MerkleTree_Low_Datastructures_hash_vec lvhs,
+  uint32_t ofs,
+  uint32_t n,
+  uint8_t **dst
 )
 {
-  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun);
-  MerkleTree_Low_mt_insert(mt, init);
-  return mt;
+  uint32_t k = (uint32_t)0U;
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (hash_fun == mt_sha256_compress && hsz == (uint32_t)32U)
+  {
+    bool shaext = EverCrypt_AutoConfig2_has_shaext();
+    bool avx2 = EverCrypt_AutoConfig2_has_avx2();
+    bool avx = EverCrypt_AutoConfig2_has_avx();
+    bool vec256 = avx2 && !shaext;
+    bool vec128 = avx && !shaext;
+    uint8_t blocks[512U] = { 0U };
+    uint8_t *bs[8U];
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+    {
+      bs[i] = blocks + i * (uint32_t)64U;
+    }
+    if (vec256)
+    {
+      uint32_t nb = (n - k) / (uint32_t)8U;
+      for (uint32_t i0 = (uint32_t)0U; i0 < nb; i0++)
+      {
+        for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+        {
+          uint32_t c = ofs + (uint32_t)2U * (k + i);
+          memcpy(bs[i], lvhs.vs[c], (uint32_t)32U * sizeof (uint8_t));
+          memcpy(bs[i] + (uint32_t)32U, lvhs.vs[c + (uint32_t)1U], (uint32_t)32U * sizeof (uint8_t));
+        }
+        Hacl_SHA2_Vec256_sha256_compress8(bs, dst + k);
+        k = k + (uint32_t)8U;
+      }
+    }
+    if (vec256 || vec128)
+    {
+      uint32_t nb = (n - k) / (uint32_t)4U;
+      for (uint32_t i0 = (uint32_t)0U; i0 < nb; i0++)
+      {
+        for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+        {
+          uint32_t c = ofs + (uint32_t)2U * (k + i);
+          memcpy(bs[i], lvhs.vs[c], (uint32_t)32U * sizeof (uint8_t));
+          memcpy(bs[i] + (uint32_t)32U, lvhs.vs[c + (uint32_t)1U], (uint32_t)32U * sizeof (uint8_t));
+        }
+        Hacl_SHA2_Vec128_sha256_compress4(bs, dst + k);
+        k = k + (uint32_t)4U;
+      }
+    }
+  }
+  #endif
+  for (uint32_t i = k; i < n; i++)
+  {
+    uint32_t c = ofs + (uint32_t)2U * i;
+    hash_fun(lvhs.vs[c], lvhs.vs[c + (uint32_t)1U], dst[i]);
+  }
 }
 
-bool MerkleTree_Low_uu___is_Path(MerkleTree_Low_path projectee)
+static void
+insert_batch_(
+  uint32_t hsz,
+  uint32_t lv,
+  uint32_t i,
+  uint32_t j,
+  uint32_t nj,
+  MerkleTree_Low_Datastructures_hash_vv hs,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
 {
-  return true;
+  uint32_t lo = j / (uint32_t)2U;
+  uint32_t hi = nj / (uint32_t)2U;
+  if (lv + (uint32_t)1U < (uint32_t)32U && lo < hi)
+  {
+    uint32_t n = hi - lo;
+    KRML_CHECK_SIZE(sizeof (uint8_t *), n);
+    uint8_t **dst = KRML_HOST_MALLOC(sizeof (uint8_t *) * n);
+    for (uint32_t k = (uint32_t)0U; k < n; k++)
+    {
+      dst[k] = hash_r_alloc(hsz);
+    }
+    MerkleTree_Low_Datastructures_hash_vec
+    lvhs = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
+    hash_pairs(hsz, hash_fun, lvhs, (uint32_t)2U * lo - MerkleTree_Low_offset_of(i), n, dst);
+    MerkleTree_Low_Datastructures_hash_vec
+    ihv = index__LowStar_Vector_vector_str__uint8_t_(hs, lv + (uint32_t)1U);
+    for (uint32_t k = (uint32_t)0U; k < n; k++)
+    {
+      ihv = insert___uint8_t__uint32_t(ihv, dst[k]);
+    }
+    assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, lv + (uint32_t)1U, ihv);
+    KRML_HOST_FREE(dst);
+    insert_batch_(hsz,
+      lv + (uint32_t)1U,
+      i / (uint32_t)2U,
+      lo,
+      hi,
+      hs,
+      hash_fun);
+    return;
+  }
 }
 
-uint32_t MerkleTree_Low___proj__Path__item__hash_size(MerkleTree_Low_path projectee)
+bool
+MerkleTree_Low_mt_insert_batch_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint8_t *vs,
+  uint32_t n
+)
+{
+  MerkleTree_Low_merkle_tree mt1 = *(MerkleTree_Low_merkle_tree *)mt;
+  return
+    n
+    <= MerkleTree_Low_uint32_32_max - mt1.j
+    && MerkleTree_Low_uint64_max - mt1.offset >= (uint64_t)(mt1.j + n);
+}
+
+void MerkleTree_Low_mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint8_t *vs, uint32_t n)
+{
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  MerkleTree_Low_Datastructures_hash_vv hs = mtv.hs;
+  uint32_t hsz1 = mtv.hash_size;
+  MerkleTree_Low_Datastructures_hash_vec
+  ihv = index__LowStar_Vector_vector_str__uint8_t_(hs, (uint32_t)0U);
+  for (uint32_t k = (uint32_t)0U; k < n; k++)
+  {
+    ihv =
+      insert_copy___uint8_t__uint32_t((
+          (regional__uint32_t__uint8_t_){
+            .state = hsz1,
+            .dummy = NULL,
+            .r_alloc = hash_r_alloc,
+            .r_free = hash_r_free
+          }
+        ),
+        hash_copy,
+        ihv,
+        vs + k * hsz1);
+  }
+  assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, (uint32_t)0U, ihv);
+  insert_batch_(hsz1, (uint32_t)0U, mtv.i, mtv.j, mtv.j + n, hs, mtv.hash_fun);
+  *mt
+  =
+    (
+      (MerkleTree_Low_merkle_tree){
+        .hash_size = mtv.hash_size,
+        .offset = mtv.offset,
+        .i = mtv.i,
+        .j = mtv.j + n,
+        .hs = mtv.hs,
+        .rhs_ok = false,
+        .rhs = mtv.rhs,
+        .mroot = mtv.mroot,
+        .hash_fun = mtv.hash_fun
+      }
+    );
+}
+
+typedef struct insert_subtrees_s
+{
+  uint32_t hsz;
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2);
+  MerkleTree_Low_Datastructures_hash_vv hs;
+  uint32_t i;
+  uint32_t j;
+  uint32_t nj;
+  uint32_t lvs;
+  uint32_t first;
+}
+insert_subtrees;
+
+static void insert_subtree(void *ctx, uint32_t t)
+{
+  insert_subtrees *st = (insert_subtrees *)ctx;
+  uint32_t b = st->first + t;
+  for (uint32_t lv = (uint32_t)1U; lv <= st->lvs; lv++)
+  {
+    uint32_t w = st->lvs - lv;
+    uint32_t blo = b << w;
+    uint32_t bhi = blo + ((uint32_t)1U << w);
+    uint32_t lo = st->j >> lv;
+    uint32_t hi = st->nj >> lv;
+    if (blo > lo)
+    {
+      lo = blo;
+    }
+    if (bhi < hi)
+    {
+      hi = bhi;
+    }
+    if (lo < hi)
+    {
+      MerkleTree_Low_Datastructures_hash_vec
+      chv = index__LowStar_Vector_vector_str__uint8_t_(st->hs, lv - (uint32_t)1U);
+      MerkleTree_Low_Datastructures_hash_vec
+      lvhs = index__LowStar_Vector_vector_str__uint8_t_(st->hs, lv);
+      hash_pairs(st->hsz,
+        st->hash_fun,
+        chv,
+        (uint32_t)2U * lo - MerkleTree_Low_offset_of(st->i >> (lv - (uint32_t)1U)),
+        hi - lo,
+        lvhs.vs + lo - MerkleTree_Low_offset_of(st->i >> lv));
+    }
+  }
+}
+
+void
+MerkleTree_Low_mt_insert_batch_par(
+  MerkleTree_Low_merkle_tree *mt,
+  uint8_t *vs,
+  uint32_t n,
+  uint32_t nthreads
+)
+{
+  uint32_t lvs = (uint32_t)0U;
+  while (lvs < (uint32_t)16U && n >> (lvs + (uint32_t)1U) >= (uint32_t)4U * nthreads)
+  {
+    lvs = lvs + (uint32_t)1U;
+  }
+  if (nthreads <= (uint32_t)1U || lvs < (uint32_t)4U)
+  {
+    MerkleTree_Low_mt_insert_batch(mt, vs, n);
+    return;
+  }
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  MerkleTree_Low_Datastructures_hash_vv hs = mtv.hs;
+  uint32_t hsz1 = mtv.hash_size;
+  uint32_t j = mtv.j;
+  uint32_t nj = mtv.j + n;
+  MerkleTree_Low_Datastructures_hash_vec
+  ihv = index__LowStar_Vector_vector_str__uint8_t_(hs, (uint32_t)0U);
+  for (uint32_t k = (uint32_t)0U; k < n; k++)
+  {
+    ihv =
+      insert_copy___uint8_t__uint32_t((
+          (regional__uint32_t__uint8_t_){
+            .state = hsz1,
+            .dummy = NULL,
+            .r_alloc = hash_r_alloc,
+            .r_free = hash_r_free
+          }
+        ),
+        hash_copy,
+        ihv,
+        vs + k * hsz1);
+  }
+  assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, (uint32_t)0U, ihv);
+  for (uint32_t lv = (uint32_t)1U; lv <= lvs; lv++)
+  {
+    MerkleTree_Low_Datastructures_hash_vec
+    lvhs = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
+    for (uint32_t k = j >> lv; k < nj >> lv; k++)
+    {
+      lvhs = insert___uint8_t__uint32_t(lvhs, hash_r_alloc(hsz1));
+    }
+    assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, lv, lvhs);
+  }
+  insert_subtrees
+  st =
+    {
+      .hsz = hsz1,
+      .hash_fun = mtv.hash_fun,
+      .hs = hs,
+      .i = mtv.i,
+      .j = j,
+      .nj = nj,
+      .lvs = lvs,
+      .first = j >> lvs
+    };
+  uint32_t ntasks = ((nj - (uint32_t)1U) >> lvs) - (j >> lvs) + (uint32_t)1U;
+  Lib_Parallel_run(nthreads, ntasks, insert_subtree, &st);
+  insert_batch_(hsz1, lvs, mtv.i >> lvs, j >> lvs, nj >> lvs, hs, mtv.hash_fun);
+  *mt
+  =
+    (
+      (MerkleTree_Low_merkle_tree){
+        .hash_size = mtv.hash_size,
+        .offset = mtv.offset,
+        .i = mtv.i,
+        .j = nj,
+        .hs = mtv.hs,
+        .rhs_ok = false,
+        .rhs = mtv.rhs,
+        .mroot = mtv.mroot,
+        .hash_fun = mtv.hash_fun
+      }
+    );
+}
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_mt_create_custom(
+  uint32_t hsz,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun);
+  MerkleTree_Low_mt_insert(mt, init);
+  return mt;
+}
+
+bool MerkleTree_Low_uu___is_Path(MerkleTree_Low_path projectee)
+{
+  return true;
+}
+
+uint32_t MerkleTree_Low___proj__Path__item__hash_size(MerkleTree_Low_path projectee)
 {
   return projectee.hash_size;
 }
@@ -1128,19 +1903,6 @@ void MerkleTree_Low_free_path(MerkleTree_Low_path *p)
   KRML_HOST_FREE(p);
 }
 
-static void
-assign_copy___uint8_t__uint32_t(
-  regional__uint32_t__uint8_t_ rg,
-  void (*cp)(uint32_t x0, uint8_t *x1, uint8_t *x2),
-  MerkleTree_Low_Datastructures_hash_vec rv,
-  uint32_t i,
-  uint8_t *v
-)
-{
-  uint8_t *uu____0 = index___uint8_t_(rv, i);
-  cp(rg.state, v, uu____0);
-}
-
 static void
 construct_rhs(
   uint32_t hsz,
@@ -1154,57 +1916,29 @@ construct_rhs(
   void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
 )
 {
-  if (!(j == (uint32_t)0U))
+  while (!(j == (uint32_t)0U))
   {
-    uint32_t ofs = MerkleTree_Low_offset_of(i);
-    if (j % (uint32_t)2U == (uint32_t)0U)
+    while (j % (uint32_t)2U == (uint32_t)0U)
     {
-      construct_rhs(hsz,
-        lv + (uint32_t)1U,
-        hs,
-        rhs,
-        i / (uint32_t)2U,
-        j / (uint32_t)2U,
-        acc,
-        actd,
-        hash_fun);
-      return;
+      lv = lv + (uint32_t)1U;
+      i = i / (uint32_t)2U;
+      j = j / (uint32_t)2U;
     }
+    uint32_t ofs = MerkleTree_Low_offset_of(i);
+    uint8_t *lhs = index___uint8_t_(hs.vs[lv], j - (uint32_t)1U - ofs);
     if (actd)
     {
-      assign_copy___uint8_t__uint32_t((
-          (regional__uint32_t__uint8_t_){
-            .state = hsz,
-            .dummy = NULL,
-            .r_alloc = hash_r_alloc,
-            .r_free = hash_r_free
-          }
-        ),
-        hash_copy,
-        rhs,
-        lv,
-        acc);
-      hash_fun(index___uint8_t_(index__LowStar_Vector_vector_str__uint8_t_(hs, lv),
-          j - (uint32_t)1U - ofs),
-        acc,
-        acc);
+      hash_copy(hsz, acc, rhs.vs[lv]);
+      hash_fun(lhs, acc, acc);
     }
     else
     {
-      hash_copy(hsz,
-        index___uint8_t_(index__LowStar_Vector_vector_str__uint8_t_(hs, lv), j - (uint32_t)1U - ofs),
-        acc);
+      hash_copy(hsz, lhs, acc);
     }
-    construct_rhs(hsz,
-      lv + (uint32_t)1U,
-      hs,
-      rhs,
-      i / (uint32_t)2U,
-      j / (uint32_t)2U,
-      acc,
-      true,
-      hash_fun);
-    return;
+    actd = true;
+    lv = lv + (uint32_t)1U;
+    i = i / (uint32_t)2U;
+    j = j / (uint32_t)2U;
   }
 }
 
@@ -1794,6 +2528,275 @@ MerkleTree_Low_mt_verify(
   return r;
 }
 
+static uint32_t multi_parents(uint32_t *ks, uint32_t m)
+{
+  uint32_t w = (uint32_t)0U;
+  for (uint32_t t = (uint32_t)0U; t < m; t++)
+  {
+    uint32_t pk = ks[t] / (uint32_t)2U;
+    if (w == (uint32_t)0U || ks[w - (uint32_t)1U] != pk)
+    {
+      ks[w] = pk;
+      w = w + (uint32_t)1U;
+    }
+  }
+  return w;
+}
+
+static bool multi_sibling_needed(uint32_t *ks, uint32_t m, uint32_t t, uint32_t j, bool actd)
+{
+  uint32_t k = ks[t];
+  if (k % (uint32_t)2U == (uint32_t)1U)
+  {
+    return !(t > (uint32_t)0U && ks[t - (uint32_t)1U] == k - (uint32_t)1U);
+  }
+  if (j == k || (j == k + (uint32_t)1U && !actd))
+  {
+    return false;
+  }
+  return !(t + (uint32_t)1U < m && ks[t + (uint32_t)1U] == k + (uint32_t)1U);
+}
+
+static uint32_t mt_multi_path_length(uint32_t *ks, uint32_t m, uint32_t j)
+{
+  uint32_t len = (uint32_t)0U;
+  bool actd = false;
+  while (j != (uint32_t)0U)
+  {
+    for (uint32_t t = (uint32_t)0U; t < m; t++)
+    {
+      if (multi_sibling_needed(ks, m, t, j, actd))
+      {
+        len = len + (uint32_t)1U;
+      }
+    }
+    actd = actd || j % (uint32_t)2U == (uint32_t)1U;
+    j = j / (uint32_t)2U;
+    m = multi_parents(ks, m);
+  }
+  return len;
+}
+
+static bool multi_sorted(const uint64_t *idxs, uint32_t n)
+{
+  for (uint32_t t = (uint32_t)1U; t < n; t++)
+  {
+    if (!(idxs[t - (uint32_t)1U] < idxs[t]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+MerkleTree_Low_mt_get_multi_path_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  const MerkleTree_Low_path *p,
+  uint8_t *root
+)
+{
+  MerkleTree_Low_merkle_tree mtv = *(MerkleTree_Low_merkle_tree *)mt;
+  MerkleTree_Low_path pv = *(MerkleTree_Low_path *)p;
+  if (n == (uint32_t)0U || !multi_sorted(idxs, n))
+  {
+    return false;
+  }
+  uint64_t lo = idxs[0U];
+  uint64_t hi = idxs[n - (uint32_t)1U];
+  return
+    lo
+    >= mtv.offset
+    && hi - mtv.offset <= MerkleTree_Low_offset_range_limit
+    && pv.hash_size == mtv.hash_size
+    && mtv.i <= (uint32_t)(lo - mtv.offset)
+    && (uint32_t)(hi - mtv.offset) < mtv.j
+    && pv.hashes.sz == (uint32_t)0U;
+}
+
+uint32_t
+MerkleTree_Low_mt_get_multi_path(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  MerkleTree_Low_path *p,
+  uint8_t *root
+)
+{
+  MerkleTree_Low_mt_get_root(mt, root);
+  MerkleTree_Low_merkle_tree mtv = *(MerkleTree_Low_merkle_tree *)mt;
+  uint32_t hsz = mtv.hash_size;
+  MerkleTree_Low_Datastructures_hash_vv hs = mtv.hs;
+  KRML_CHECK_SIZE(sizeof (uint32_t), n);
+  uint32_t *ks = KRML_HOST_MALLOC(sizeof (uint32_t) * n);
+  MerkleTree_Low_Datastructures_hash_vec
+  lvhs = index__LowStar_Vector_vector_str__uint8_t_(hs, (uint32_t)0U);
+  uint32_t ofs = MerkleTree_Low_offset_of(mtv.i);
+  for (uint32_t t = (uint32_t)0U; t < n; t++)
+  {
+    ks[t] = (uint32_t)(idxs[t] - mtv.offset);
+    MerkleTree_Low_path_insert(hsz, p, index___uint8_t_(lvhs, ks[t] - ofs));
+  }
+  uint32_t m = n;
+  uint32_t i = mtv.i;
+  uint32_t j = mtv.j;
+  bool actd = false;
+  for (uint32_t lv = (uint32_t)0U; j != (uint32_t)0U; lv++)
+  {
+    lvhs = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
+    ofs = MerkleTree_Low_offset_of(i);
+    for (uint32_t t = (uint32_t)0U; t < m; t++)
+    {
+      uint32_t k = ks[t];
+      if (multi_sibling_needed(ks, m, t, j, actd))
+      {
+        if (k % (uint32_t)2U == (uint32_t)1U)
+        {
+          MerkleTree_Low_path_insert(hsz, p, index___uint8_t_(lvhs, k - (uint32_t)1U - ofs));
+        }
+        else if (k + (uint32_t)1U == j)
+        {
+          MerkleTree_Low_path_insert(hsz, p, index___uint8_t_(mtv.rhs, lv));
+        }
+        else
+        {
+          MerkleTree_Low_path_insert(hsz, p, index___uint8_t_(lvhs, k + (uint32_t)1U - ofs));
+        }
+      }
+    }
+    actd = actd || j % (uint32_t)2U == (uint32_t)1U;
+    i = i / (uint32_t)2U;
+    j = j / (uint32_t)2U;
+    m = multi_parents(ks, m);
+  }
+  KRML_HOST_FREE(ks);
+  return mtv.j;
+}
+
+bool
+MerkleTree_Low_mt_verify_multi_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  uint64_t j,
+  const MerkleTree_Low_path *p,
+  uint8_t *rt
+)
+{
+  MerkleTree_Low_merkle_tree mtv = *(MerkleTree_Low_merkle_tree *)mt;
+  MerkleTree_Low_path pv = *(MerkleTree_Low_path *)p;
+  if (n == (uint32_t)0U || !multi_sorted(idxs, n))
+  {
+    return false;
+  }
+  uint64_t lo = idxs[0U];
+  uint64_t hi = idxs[n - (uint32_t)1U];
+  if
+  (
+    !(hi
+    < j
+    && lo >= mtv.offset
+    && j >= mtv.offset && j - mtv.offset <= MerkleTree_Low_offset_range_limit
+    && mtv.hash_size == pv.hash_size
+    && pv.hashes.sz >= n)
+  )
+  {
+    return false;
+  }
+  KRML_CHECK_SIZE(sizeof (uint32_t), n);
+  uint32_t *ks = KRML_HOST_MALLOC(sizeof (uint32_t) * n);
+  for (uint32_t t = (uint32_t)0U; t < n; t++)
+  {
+    ks[t] = (uint32_t)(idxs[t] - mtv.offset);
+  }
+  uint32_t len = mt_multi_path_length(ks, n, (uint32_t)(j - mtv.offset));
+  KRML_HOST_FREE(ks);
+  return pv.hashes.sz == n + len;
+}
+
+bool
+MerkleTree_Low_mt_verify_multi(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  uint64_t j,
+  const MerkleTree_Low_path *p,
+  uint8_t *rt
+)
+{
+  MerkleTree_Low_merkle_tree mtv = *(MerkleTree_Low_merkle_tree *)mt;
+  MerkleTree_Low_path pv = *(MerkleTree_Low_path *)p;
+  uint32_t hsz = mtv.hash_size;
+  KRML_CHECK_SIZE(sizeof (uint32_t), n);
+  uint32_t *ks = KRML_HOST_MALLOC(sizeof (uint32_t) * n);
+  uint32_t *nks = KRML_HOST_MALLOC(sizeof (uint32_t) * n);
+  KRML_CHECK_SIZE(sizeof (uint8_t), n * hsz);
+  uint8_t *acc = KRML_HOST_MALLOC(sizeof (uint8_t) * n * hsz);
+  for (uint32_t t = (uint32_t)0U; t < n; t++)
+  {
+    ks[t] = (uint32_t)(idxs[t] - mtv.offset);
+    hash_copy(hsz, index___uint8_t_(pv.hashes, t), acc + t * hsz);
+  }
+  uint32_t m = n;
+  uint32_t ppos = n;
+  uint32_t j1 = (uint32_t)(j - mtv.offset);
+  bool actd = false;
+  while (j1 != (uint32_t)0U)
+  {
+    uint32_t w = (uint32_t)0U;
+    for (uint32_t t = (uint32_t)0U; t < m; t++)
+    {
+      uint32_t k = ks[t];
+      uint8_t *a = acc + t * hsz;
+      bool needed = multi_sibling_needed(ks, m, t, j1, actd);
+      if (k % (uint32_t)2U == (uint32_t)1U)
+      {
+        if (!needed)
+        {
+          /* Combined with its left sibling, at t - 1. */
+          continue;
+        }
+        mtv.hash_fun(index___uint8_t_(pv.hashes, ppos), a, a);
+        ppos = ppos + (uint32_t)1U;
+      }
+      else if (needed)
+      {
+        mtv.hash_fun(a, index___uint8_t_(pv.hashes, ppos), a);
+        ppos = ppos + (uint32_t)1U;
+      }
+      else if (t + (uint32_t)1U < m && ks[t + (uint32_t)1U] == k + (uint32_t)1U)
+      {
+        mtv.hash_fun(a, a + hsz, a);
+      }
+      nks[w] = k / (uint32_t)2U;
+      if (w != t)
+      {
+        hash_copy(hsz, a, acc + w * hsz);
+      }
+      w = w + (uint32_t)1U;
+    }
+    uint32_t *tmp = ks;
+    ks = nks;
+    nks = tmp;
+    m = w;
+    actd = actd || j1 % (uint32_t)2U == (uint32_t)1U;
+    j1 = j1 / (uint32_t)2U;
+  }
+  uint8_t res = (uint8_t)255U;
+  for (uint32_t i = (uint32_t)0U; i < hsz; i++)
+  {
+    uint8_t uu____0 = FStar_UInt8_eq_mask(acc[i], rt[i]);
+    res = uu____0 & res;
+  }
+  bool r = res == (uint8_t)255U;
+  KRML_HOST_FREE(ks);
+  KRML_HOST_FREE(nks);
+  KRML_HOST_FREE(acc);
+  return r;
+}
+
 typedef struct __bool_uint32_t_s
 {
   bool fst;
@@ -2643,6 +3646,427 @@ MerkleTree_Low_path
   return buf;
 }
 
+typedef struct stream_out_s
+{
+  bool (*write)(void *ctx, const uint8_t *buf, uint32_t len);
+  void *ctx;
+  bool ok;
+  uint32_t len;
+  uint64_t total;
+  uint8_t buf[4096U];
+}
+stream_out;
+
+static void stream_out_flush(stream_out *o)
+{
+  if (o->ok && o->len > (uint32_t)0U)
+  {
+    o->ok = o->write(o->ctx, o->buf, o->len);
+  }
+  o->total = o->total + (uint64_t)o->len;
+  o->len = (uint32_t)0U;
+}
+
+static void stream_out_bytes(stream_out *o, const uint8_t *b, uint32_t n)
+{
+  while (o->ok && n > (uint32_t)0U)
+  {
+    uint32_t k = (uint32_t)sizeof (o->buf) - o->len;
+    if (k > n)
+    {
+      k = n;
+    }
+    memcpy(o->buf + o->len, b, k * sizeof (uint8_t));
+    o->len = o->len + k;
+    b = b + k;
+    n = n - k;
+    if (o->len == (uint32_t)sizeof (o->buf))
+    {
+      stream_out_flush(o);
+    }
+  }
+}
+
+static void stream_out_be(stream_out *o, uint64_t x, uint32_t n)
+{
+  uint8_t b[8U];
+  for (uint32_t k = (uint32_t)0U; k < n; k++)
+  {
+    b[k] = (uint8_t)(x >> (uint32_t)8U * (n - (uint32_t)1U - k));
+  }
+  stream_out_bytes(o, b, n);
+}
+
+/* Nodes [from, sz) of a level vector, as in serialize_hash_vec. */
+static void
+stream_out_hash_vec(
+  stream_out *o,
+  uint32_t hsz,
+  MerkleTree_Low_Datastructures_hash_vec v,
+  uint32_t from
+)
+{
+  stream_out_be(o, (uint64_t)(v.sz - from), (uint32_t)4U);
+  for (uint32_t k = from; k < v.sz; k++)
+  {
+    stream_out_bytes(o, v.vs[k], hsz);
+  }
+}
+
+static void stream_out_tail(stream_out *o, MerkleTree_Low_merkle_tree mtv)
+{
+  stream_out_be(o, (uint64_t)mtv.rhs_ok, (uint32_t)1U);
+  stream_out_hash_vec(o, mtv.hash_size, mtv.rhs, (uint32_t)0U);
+  stream_out_bytes(o, mtv.mroot, mtv.hash_size);
+  stream_out_flush(o);
+}
+
+uint64_t
+MerkleTree_Low_Serialization_mt_serialize_stream(
+  const MerkleTree_Low_merkle_tree *mt,
+  bool (*write)(void *ctx, const uint8_t *buf, uint32_t len),
+  void *ctx
+)
+{
+  MerkleTree_Low_merkle_tree mtv = *(MerkleTree_Low_merkle_tree *)mt;
+  stream_out *o = KRML_HOST_MALLOC(sizeof (stream_out));
+  o->write = write;
+  o->ctx = ctx;
+  o->ok = true;
+  o->len = (uint32_t)0U;
+  o->total = (uint64_t)0U;
+  stream_out_be(o, (uint64_t)1U, (uint32_t)1U);
+  stream_out_be(o, (uint64_t)mtv.hash_size, (uint32_t)4U);
+  stream_out_be(o, mtv.offset, (uint32_t)8U);
+  stream_out_be(o, (uint64_t)mtv.i, (uint32_t)4U);
+  stream_out_be(o, (uint64_t)mtv.j, (uint32_t)4U);
+  stream_out_be(o, (uint64_t)mtv.hs.sz, (uint32_t)4U);
+  for (uint32_t lv = (uint32_t)0U; lv < mtv.hs.sz; lv++)
+  {
+    stream_out_hash_vec(o, mtv.hash_size, mtv.hs.vs[lv], (uint32_t)0U);
+  }
+  stream_out_tail(o, mtv);
+  uint64_t r = o->ok ? o->total : (uint64_t)0U;
+  KRML_HOST_FREE(o);
+  return r;
+}
+
+bool
+MerkleTree_Low_Serialization_mt_serialize_delta_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint64_t since
+)
+{
+  MerkleTree_Low_merkle_tree mtv = *(MerkleTree_Low_merkle_tree *)mt;
+  return
+    since
+    >= mtv.offset
+    && since - mtv.offset <= MerkleTree_Low_offset_range_limit
+    && mtv.i <= (uint32_t)(since - mtv.offset)
+    && (uint32_t)(since - mtv.offset) <= mtv.j;
+}
+
+uint64_t
+MerkleTree_Low_Serialization_mt_serialize_delta(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint64_t since,
+  bool (*write)(void *ctx, const uint8_t *buf, uint32_t len),
+  void *ctx
+)
+{
+  MerkleTree_Low_merkle_tree mtv = *(MerkleTree_Low_merkle_tree *)mt;
+  uint32_t j0 = (uint32_t)(since - mtv.offset);
+  stream_out *o = KRML_HOST_MALLOC(sizeof (stream_out));
+  o->write = write;
+  o->ctx = ctx;
+  o->ok = true;
+  o->len = (uint32_t)0U;
+  o->total = (uint64_t)0U;
+  stream_out_be(o, (uint64_t)2U, (uint32_t)1U);
+  stream_out_be(o, (uint64_t)mtv.hash_size, (uint32_t)4U);
+  stream_out_be(o, mtv.offset, (uint32_t)8U);
+  stream_out_be(o, (uint64_t)j0, (uint32_t)4U);
+  stream_out_be(o, (uint64_t)mtv.i, (uint32_t)4U);
+  stream_out_be(o, (uint64_t)mtv.j, (uint32_t)4U);
+  for (uint32_t lv = (uint32_t)0U; lv < mtv.hs.sz; lv++)
+  {
+    uint32_t ofs = MerkleTree_Low_offset_of(mtv.i >> lv);
+    stream_out_hash_vec(o, mtv.hash_size, mtv.hs.vs[lv], (j0 >> lv) - ofs);
+  }
+  stream_out_tail(o, mtv);
+  uint64_t r = o->ok ? o->total : (uint64_t)0U;
+  KRML_HOST_FREE(o);
+  return r;
+}
+
+static bool
+stream_in_bytes(
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx,
+  uint8_t *b,
+  uint32_t n
+)
+{
+  while (n > (uint32_t)0U)
+  {
+    uint32_t k = read(ctx, b, n);
+    if (k == (uint32_t)0U || k > n)
+    {
+      return false;
+    }
+    b = b + k;
+    n = n - k;
+  }
+  return true;
+}
+
+static bool
+stream_in_be(
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx,
+  uint64_t *x,
+  uint32_t n
+)
+{
+  uint8_t b[8U];
+  if (!stream_in_bytes(read, ctx, b, n))
+  {
+    return false;
+  }
+  uint64_t r = (uint64_t)0U;
+  for (uint32_t k = (uint32_t)0U; k < n; k++)
+  {
+    r = r << (uint32_t)8U | (uint64_t)b[k];
+  }
+  *x = r;
+  return true;
+}
+
+/* Reads a hash vector and appends its hashes to v. Hashes are read in chunks,
+   but never past the end of the vector, so that whatever follows it in the
+   stream is left to the caller. On failure, v is left unchanged. */
+static bool
+stream_in_hash_vec(
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx,
+  uint32_t hsz,
+  MerkleTree_Low_Datastructures_hash_vec *v
+)
+{
+  uint64_t n;
+  if (!stream_in_be(read, ctx, &n, (uint32_t)4U) || n > (uint64_t)(MerkleTree_Low_uint32_32_max - v->sz))
+  {
+    return false;
+  }
+  uint32_t sz0 = v->sz;
+  uint32_t per = (uint32_t)4096U / hsz;
+  if (per == (uint32_t)0U)
+  {
+    per = (uint32_t)1U;
+  }
+  uint8_t *chunk = KRML_HOST_MALLOC(sizeof (uint8_t) * per * hsz);
+  bool ok = true;
+  uint32_t left = (uint32_t)n;
+  while (ok && left > (uint32_t)0U)
+  {
+    uint32_t k = left < per ? left : per;
+    ok = stream_in_bytes(read, ctx, chunk, k * hsz);
+    for (uint32_t l = (uint32_t)0U; ok && l < k; l++)
+    {
+      uint8_t *h = hash_r_alloc(hsz);
+      hash_copy(hsz, chunk + l * hsz, h);
+      *v = insert___uint8_t_(*v, h);
+    }
+    left = left - k;
+  }
+  KRML_HOST_FREE(chunk);
+  if (!ok)
+  {
+    for (uint32_t k = sz0; k < v->sz; k++)
+    {
+      hash_r_free(v->vs[k]);
+    }
+    v->sz = sz0;
+  }
+  return ok;
+}
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_Serialization_mt_deserialize_stream(
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  uint64_t version;
+  uint64_t hsz;
+  uint64_t offset;
+  uint64_t i;
+  uint64_t j;
+  uint64_t nlv;
+  bool ok =
+    stream_in_be(read, ctx, &version, (uint32_t)1U)
+    && version == (uint64_t)1U
+    && stream_in_be(read, ctx, &hsz, (uint32_t)4U)
+    && hsz != (uint64_t)0U
+    && stream_in_be(read, ctx, &offset, (uint32_t)8U)
+    && stream_in_be(read, ctx, &i, (uint32_t)4U)
+    && stream_in_be(read, ctx, &j, (uint32_t)4U)
+    && j >= i
+    && MerkleTree_Low_uint64_max - offset >= j
+    && stream_in_be(read, ctx, &nlv, (uint32_t)4U)
+    && nlv == (uint64_t)32U;
+  if (!ok)
+  {
+    return NULL;
+  }
+  uint32_t hsz1 = (uint32_t)hsz;
+  MerkleTree_Low_Datastructures_hash_vv
+  hs = alloc_rid__LowStar_Vector_vector_str__uint8_t_((uint32_t)32U, hash_vec_r_alloc(hsz1));
+  for (uint32_t lv = (uint32_t)1U; lv < (uint32_t)32U; lv++)
+  {
+    hs.vs[lv] = hash_vec_r_alloc(hsz1);
+  }
+  MerkleTree_Low_Datastructures_hash_vec rhs = hash_vec_r_alloc(hsz1);
+  uint8_t *mroot = hash_r_alloc(hsz1);
+  uint64_t rhs_ok = (uint64_t)0U;
+  for (uint32_t lv = (uint32_t)0U; ok && lv < (uint32_t)32U; lv++)
+  {
+    ok = stream_in_hash_vec(read, ctx, hsz1, &hs.vs[lv]);
+  }
+  ok =
+    ok
+    && stream_in_be(read, ctx, &rhs_ok, (uint32_t)1U)
+    && stream_in_hash_vec(read, ctx, hsz1, &rhs)
+    && rhs.sz == (uint32_t)32U
+    && stream_in_bytes(read, ctx, mroot, hsz1);
+  if (!ok)
+  {
+    for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+    {
+      hash_vec_r_free(hs.vs[lv]);
+    }
+    KRML_HOST_FREE(hs.vs);
+    hash_vec_r_free(rhs);
+    hash_r_free(mroot);
+    return NULL;
+  }
+  KRML_CHECK_SIZE(sizeof (MerkleTree_Low_merkle_tree), (uint32_t)1U);
+  MerkleTree_Low_merkle_tree *buf = KRML_HOST_MALLOC(sizeof (MerkleTree_Low_merkle_tree));
+  buf[0U]
+  =
+    (
+      (MerkleTree_Low_merkle_tree){
+        .hash_size = hsz1,
+        .offset = offset,
+        .i = (uint32_t)i,
+        .j = (uint32_t)j,
+        .hs = hs,
+        .rhs_ok = rhs_ok != (uint64_t)0U,
+        .rhs = rhs,
+        .mroot = mroot,
+        .hash_fun = hash_fun
+      }
+    );
+  return buf;
+}
+
+bool
+MerkleTree_Low_Serialization_mt_deserialize_delta(
+  MerkleTree_Low_merkle_tree *mt,
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx
+)
+{
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  uint32_t hsz = mtv.hash_size;
+  uint64_t version;
+  uint64_t dhsz;
+  uint64_t offset;
+  uint64_t j0;
+  uint64_t i;
+  uint64_t j;
+  bool ok =
+    stream_in_be(read, ctx, &version, (uint32_t)1U)
+    && version == (uint64_t)2U
+    && stream_in_be(read, ctx, &dhsz, (uint32_t)4U)
+    && dhsz == (uint64_t)hsz
+    && stream_in_be(read, ctx, &offset, (uint32_t)8U)
+    && offset == mtv.offset
+    && stream_in_be(read, ctx, &j0, (uint32_t)4U)
+    && j0 == (uint64_t)mtv.j
+    && stream_in_be(read, ctx, &i, (uint32_t)4U)
+    && stream_in_be(read, ctx, &j, (uint32_t)4U)
+    && i <= j0
+    && i >= (uint64_t)mtv.i
+    && j >= j0
+    && MerkleTree_Low_uint64_max - offset >= j;
+  if (!ok)
+  {
+    return false;
+  }
+  uint32_t sz0[32U];
+  uint32_t lv = (uint32_t)0U;
+  for (; ok && lv < (uint32_t)32U; lv++)
+  {
+    sz0[lv] = mtv.hs.vs[lv].sz;
+    ok = stream_in_hash_vec(read, ctx, hsz, &mtv.hs.vs[lv]);
+    ok = ok && mtv.hs.vs[lv].sz == ((uint32_t)j >> lv) - MerkleTree_Low_offset_of(mtv.i >> lv);
+  }
+  uint64_t rhs_ok = (uint64_t)0U;
+  MerkleTree_Low_Datastructures_hash_vec rhs = hash_vec_r_alloc(hsz);
+  uint8_t *mroot = hash_r_alloc(hsz);
+  ok =
+    ok
+    && stream_in_be(read, ctx, &rhs_ok, (uint32_t)1U)
+    && stream_in_hash_vec(read, ctx, hsz, &rhs)
+    && rhs.sz == (uint32_t)32U
+    && stream_in_bytes(read, ctx, mroot, hsz);
+  if (!ok)
+  {
+    /* Undo the levels read so far. */
+    for (uint32_t l = (uint32_t)0U; l < lv; l++)
+    {
+      MerkleTree_Low_Datastructures_hash_vec *v = &mtv.hs.vs[l];
+      for (uint32_t k = sz0[l]; k < v->sz; k++)
+      {
+        hash_r_free(v->vs[k]);
+      }
+      v->sz = sz0[l];
+    }
+    hash_vec_r_free(rhs);
+    hash_r_free(mroot);
+    return false;
+  }
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)32U; l++)
+  {
+    hash_copy(hsz, rhs.vs[l], mtv.rhs.vs[l]);
+  }
+  hash_copy(hsz, mroot, mtv.mroot);
+  hash_vec_r_free(rhs);
+  hash_r_free(mroot);
+  *mt
+  =
+    (
+      (MerkleTree_Low_merkle_tree){
+        .hash_size = mtv.hash_size,
+        .offset = mtv.offset,
+        .i = mtv.i,
+        .j = (uint32_t)j,
+        .hs = mtv.hs,
+        .rhs_ok = rhs_ok != (uint64_t)0U,
+        .rhs = mtv.rhs,
+        .mroot = mtv.mroot,
+        .hash_fun = mtv.hash_fun
+      }
+    );
+  if ((uint32_t)i > mtv.i)
+  {
+    MerkleTree_Low_mt_flush_to(mt, mtv.offset + i);
+  }
+  return true;
+}
+
 uint8_t *MerkleTree_Low_Hashfunctions_init_hash(uint32_t hsz)
 {
   regional__uint32_t__uint8_t_
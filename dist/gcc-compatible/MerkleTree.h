@@ -40,6 +40,9 @@ extern "C" {
 #include "Hacl_Kremlib.h"
 #include "Hacl_Spec.h"
 #include "EverCrypt_Hash.h"
+#include "Hacl_SHA2_Vec256.h"
+#include "Hacl_SHA2_Vec128.h"
+#include "Lib_Parallel.h"
 
 typedef struct MerkleTree_Low_Datastructures_hash_vec_s
 {
@@ -102,7 +105,7 @@ typedef const MerkleTree_Low_merkle_tree *const_mt_p;
 uint8_t *mt_init_hash(uint32_t hash_size);
 
 /*
-  Destructor for hashes
+  Destructor for hashes, which must have been allocated by mt_init_hash
 */
 void mt_free_hash(uint8_t *h);
 
@@ -116,6 +119,16 @@ MerkleTree_Low_path *mt_init_path(uint32_t hash_size);
 */
 void mt_free_path(MerkleTree_Low_path *p);
 
+/*
+  Clearing a path
+
+  @param[in] p Path
+
+  Note: The path keeps its storage, so it can be passed again to
+  mt_get_path or mt_get_multi_path without reallocation.
+*/
+void mt_clear_path(MerkleTree_Low_path *p);
+
 /*
   Length of a path
 
@@ -177,11 +190,49 @@ void mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v);
 */
 bool mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *v);
 
+/*
+  Batch insertion
+
+  @param[in]  mt  The Merkle tree
+  @param[in]  vs  Buffer of n consecutive hashes; the tree makes copies of them.
+  @param[in]  n   Number of hashes in vs
+
+ Note: Equivalent to n calls to mt_insert, but new internal nodes are computed
+ level by level, several at a time when the default hash function is used.
+*/
+void mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint8_t *vs, uint32_t n);
+
+/*
+  Precondition predicate for mt_insert_batch
+*/
+bool mt_insert_batch_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *vs, uint32_t n);
+
+/*
+  Parallel batch insertion
+
+  @param[in]  mt        The Merkle tree
+  @param[in]  vs        Buffer of n consecutive hashes; the tree makes copies of them.
+  @param[in]  n         Number of hashes in vs
+  @param[in]  nthreads  Maximum number of threads to use
+
+ Note: The lower levels are split into independent subtrees that are hashed
+ concurrently; the levels above them are completed on the calling thread. The
+ resulting tree is identical to the one produced by mt_insert_batch. Batches
+ that are too small to be worth splitting are inserted serially. The
+ precondition is mt_insert_batch_pre.
+*/
+void
+mt_insert_batch_par(MerkleTree_Low_merkle_tree *mt, uint8_t *vs, uint32_t n, uint32_t nthreads);
+
 /*
   Getting the Merkle root
 
   @param[in]  mt   The Merkle tree
   @param[out] root The Merkle root
+
+  Note: The root is cached until the next modification. After an insertion,
+  only the right-hand side of the tree is recomputed, with one hash per level
+  whose node count is odd.
 */
 void mt_get_root(const MerkleTree_Low_merkle_tree *mt, uint8_t *root);
 
@@ -225,6 +276,45 @@ mt_get_path_pre(
   uint8_t *root
 );
 
+/*
+  Getting a Merkle multi-path
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  idxs The indices of the target hashes, in strictly increasing order
+  @param[in]  n    The number of indices in idxs
+  @param[out] path A resulting multi-path: the n target hashes, followed by
+                   the nodes needed to recompute the root from them
+  @param[out] root The Merkle root
+
+  return The number of elements in the tree
+
+  Notes:
+  - Nodes shared by the paths of several targets, and nodes that can be
+    recomputed from the targets themselves, appear only once, or not at all.
+  - As for mt_get_path, the resulting path contains pointers to hashes in the
+    tree, and path must be empty (see mt_clear_path).
+*/
+uint32_t
+mt_get_multi_path(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  MerkleTree_Low_path *path1,
+  uint8_t *root
+);
+
+/*
+  Precondition predicate for mt_get_multi_path
+*/
+bool
+mt_get_multi_path_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+);
+
 /*
   Flush the Merkle tree
 
@@ -299,6 +389,43 @@ mt_verify_pre(
   uint8_t *root
 );
 
+/*
+  Client-side verification of a multi-path
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  idxs The indices of the target hashes, in strictly increasing order
+  @param[in]  n    The number of indices in idxs
+  @param[in]  max  The maximum index + 1 of the tree when the path was generated
+  @param[in]  path The Merkle multi-path to verify
+  @param[in]  root
+
+  return true if the verification succeeded, false otherwise
+
+  Note: The root is recomputed in a single pass over the levels of the tree.
+*/
+bool
+mt_verify_multi(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  uint64_t max,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+);
+
+/*
+  Precondition predicate for mt_verify_multi
+*/
+bool
+mt_verify_multi_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  uint64_t max,
+  const MerkleTree_Low_path *path1,
+  uint8_t *root
+);
+
 /*
   Serialization size
 
@@ -364,6 +491,95 @@ uint64_t mt_serialize_path(const MerkleTree_Low_path *path1, uint8_t *buf, uint6
 */
 MerkleTree_Low_path *mt_deserialize_path(uint32_t hash_size, const uint8_t *buf, uint64_t len);
 
+/*
+  Streaming Merkle tree serialization
+
+  @param[in]  mt    The Merkle tree
+  @param[in]  write Called with consecutive chunks of the serialized tree;
+                    returns false to abort
+  @param[in]  ctx   Passed to write
+
+  return the number of bytes written, or 0 if write failed
+
+  Note: Produces the same bytes as mt_serialize, without a buffer holding the
+  whole tree, and without its 4GB limit.
+*/
+uint64_t
+mt_serialize_stream(
+  const MerkleTree_Low_merkle_tree *mt,
+  bool (*write)(void *ctx, const uint8_t *buf, uint32_t len),
+  void *ctx
+);
+
+/*
+  Streaming Merkle tree deserialization
+
+  @param[in]  read     Fills up to len bytes of buf from the stream; returns
+                       the number of bytes read, or 0 at the end of the stream
+                       or on error
+  @param[in]  ctx      Passed to read
+  @param[in]  hash_fun Hash function
+
+  return pointer to the new tree if successful, NULL otherwise
+
+  Note: Reads the format of mt_serialize and mt_serialize_stream, and never
+  reads past the end of the tree.
+*/
+MerkleTree_Low_merkle_tree
+*mt_deserialize_stream(
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+/*
+  Delta serialization
+
+  @param[in]  mt    The Merkle tree
+  @param[in]  since The number of elements (offset + j) of the tree at the
+                    last checkpoint
+  @param[in]  write As for mt_serialize_stream
+  @param[in]  ctx   Passed to write
+
+  return the number of bytes written, or 0 if write failed
+
+  Note: Only the nodes added to each level since the checkpoint are written,
+  together with the current flush index and root. Levels are append-only
+  between a flush and the next retraction, so this is valid as long as the
+  tree was not retracted below since; otherwise, take a full checkpoint.
+*/
+uint64_t
+mt_serialize_delta(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint64_t since,
+  bool (*write)(void *ctx, const uint8_t *buf, uint32_t len),
+  void *ctx
+);
+
+/*
+  Precondition predicate for mt_serialize_delta
+*/
+bool mt_serialize_delta_pre(const MerkleTree_Low_merkle_tree *mt, uint64_t since);
+
+/*
+  Applying a delta
+
+  @param[in]  mt   The Merkle tree restored from the checkpoint the delta was
+                   taken against
+  @param[in]  read As for mt_deserialize_stream
+  @param[in]  ctx  Passed to read
+
+  return true if successful; otherwise, the tree is left unchanged
+
+  Note: Nodes flushed by the writer since the checkpoint are flushed from mt.
+*/
+bool
+mt_deserialize_delta(
+  MerkleTree_Low_merkle_tree *mt,
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx
+);
+
 typedef MerkleTree_Low_merkle_tree *mt_p0;
 
 /*
@@ -442,6 +658,23 @@ bool MerkleTree_Low_mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t
 
 void MerkleTree_Low_mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v);
 
+bool
+MerkleTree_Low_mt_insert_batch_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint8_t *vs,
+  uint32_t n
+);
+
+void MerkleTree_Low_mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint8_t *vs, uint32_t n);
+
+void
+MerkleTree_Low_mt_insert_batch_par(
+  MerkleTree_Low_merkle_tree *mt,
+  uint8_t *vs,
+  uint32_t n,
+  uint32_t nthreads
+);
+
 MerkleTree_Low_merkle_tree
 *MerkleTree_Low_mt_create_custom(
   uint32_t hsz,
@@ -524,6 +757,44 @@ MerkleTree_Low_mt_verify(
   uint8_t *rt
 );
 
+bool
+MerkleTree_Low_mt_get_multi_path_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  const MerkleTree_Low_path *p,
+  uint8_t *root
+);
+
+uint32_t
+MerkleTree_Low_mt_get_multi_path(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  MerkleTree_Low_path *p,
+  uint8_t *root
+);
+
+bool
+MerkleTree_Low_mt_verify_multi_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  uint64_t j,
+  const MerkleTree_Low_path *p,
+  uint8_t *rt
+);
+
+bool
+MerkleTree_Low_mt_verify_multi(
+  const MerkleTree_Low_merkle_tree *mt,
+  const uint64_t *idxs,
+  uint32_t n,
+  uint64_t j,
+  const MerkleTree_Low_path *p,
+  uint8_t *rt
+);
+
 typedef uint8_t MerkleTree_Low_Serialization_uint8_t;
 
 typedef uint16_t MerkleTree_Low_Serialization_uint16_t;
@@ -562,6 +833,41 @@ MerkleTree_Low_Serialization_mt_serialize_path(
 MerkleTree_Low_path
 *MerkleTree_Low_Serialization_mt_deserialize_path(const uint8_t *input, uint64_t sz);
 
+uint64_t
+MerkleTree_Low_Serialization_mt_serialize_stream(
+  const MerkleTree_Low_merkle_tree *mt,
+  bool (*write)(void *ctx, const uint8_t *buf, uint32_t len),
+  void *ctx
+);
+
+bool
+MerkleTree_Low_Serialization_mt_serialize_delta_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint64_t since
+);
+
+uint64_t
+MerkleTree_Low_Serialization_mt_serialize_delta(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint64_t since,
+  bool (*write)(void *ctx, const uint8_t *buf, uint32_t len),
+  void *ctx
+);
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_Serialization_mt_deserialize_stream(
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+bool
+MerkleTree_Low_Serialization_mt_deserialize_delta(
+  MerkleTree_Low_merkle_tree *mt,
+  uint32_t (*read)(void *ctx, uint8_t *buf, uint32_t len),
+  void *ctx
+);
+
 uint8_t *MerkleTree_Low_Hashfunctions_init_hash(uint32_t hsz);
 
 void MerkleTree_Low_Hashfunctions_free_hash(uint8_t *h);
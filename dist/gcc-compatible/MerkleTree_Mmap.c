@@ -0,0 +1,730 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#if __has_include("config.h")
+#include "config.h"
+#endif
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "MerkleTree_Mmap.h"
+
+/* The level files are not verified code: this is a hand-written storage
+   backend that mirrors the algorithms of MerkleTree.c over flat arrays. Node k
+   of level lv (for offset_of(i >> lv) <= k < j >> lv) lives at byte
+   k * hash_size of level file lv.
+
+   In-memory trees (dir == NULL) use the same layout, with anonymous memory in
+   place of the level files: each level is one arena that is committed page by
+   page as it grows, and the header is heap-allocated. */
+
+#define MT_MMAP_LEVELS 32U
+#define MT_MMAP_VERSION 1U
+#define MT_MMAP_MIN_GROWTH (64U * 1024U)
+
+/* Number of leaf slots the address space reservation accounts for. On 32-bit
+   hosts we cannot reserve room for 2^32 leaves, so trees are smaller there. */
+#if UINTPTR_MAX > 0xffffffffU
+#define MT_MMAP_LOG_CAPACITY 32U
+#else
+#define MT_MMAP_LOG_CAPACITY 20U
+#endif
+
+static const uint8_t mt_mmap_magic[8U] = { 'H', 'A', 'C', 'L', 'M', 'T', 'M', 'M' };
+
+#ifndef _WIN32
+
+static inline uint8_t *node(const MerkleTree_Mmap_tree *mt, uint32_t lv, uint32_t k)
+{
+  return mt->levels[lv].base + (uint64_t)k * mt->hash_size;
+}
+
+static uint64_t page_size(void)
+{
+  long ps = sysconf(_SC_PAGESIZE);
+  return ps > 0 ? (uint64_t)ps : 4096U;
+}
+
+static uint64_t round_up(uint64_t n, uint64_t m)
+{
+  return (n + m - 1U) / m * m;
+}
+
+static char *level_path(const char *dir, const char *name)
+{
+  size_t len = strlen(dir) + strlen(name) + 2U;
+  char *p = KRML_HOST_MALLOC(len);
+  if (p != NULL)
+    snprintf(p, len, "%s/%s", dir, name);
+  return p;
+}
+
+static int open_file(const char *dir, const char *name, int flags)
+{
+  char *p = level_path(dir, name);
+  if (p == NULL)
+    return -1;
+  int fd = open(p, flags, 0644);
+  KRML_HOST_FREE(p);
+  return fd;
+}
+
+/* Reserves the address range of a level and maps the current contents of its
+   file at the start of it. */
+static bool level_map(MerkleTree_Mmap_level *l, uint32_t hash_size, uint32_t lv)
+{
+  struct stat st;
+  if (l->fd >= 0 && fstat(l->fd, &st) != 0)
+    return false;
+  uint64_t slots = (uint64_t)1U << (MT_MMAP_LOG_CAPACITY - lv);
+  l->reserved = round_up(slots * hash_size, page_size());
+  l->mapped = l->fd >= 0 ? (uint64_t)st.st_size : 0U;
+  if (l->mapped > l->reserved || l->mapped % page_size() != 0U)
+    return false;
+  void *base = mmap(NULL, l->reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (base == MAP_FAILED)
+    return false;
+  l->base = base;
+  if (l->mapped > 0U &&
+      mmap(l->base, l->mapped, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, l->fd, 0) == MAP_FAILED)
+  {
+    munmap(l->base, l->reserved);
+    l->base = NULL;
+    return false;
+  }
+  return true;
+}
+
+/* Makes sure that slots [0, n) of a level are backed by the file (or by
+   committed memory). The mapping only ever grows in place, so existing node
+   pointers remain valid. */
+static bool level_reserve(MerkleTree_Mmap_tree *mt, uint32_t lv, uint32_t n)
+{
+  MerkleTree_Mmap_level *l = &mt->levels[lv];
+  uint64_t need = (uint64_t)n * mt->hash_size;
+  if (need <= l->mapped)
+    return true;
+  uint64_t sz = l->mapped * 2U;
+  if (sz < MT_MMAP_MIN_GROWTH)
+    sz = MT_MMAP_MIN_GROWTH;
+  if (sz < need)
+    sz = need;
+  sz = round_up(sz, page_size());
+  if (sz > l->reserved)
+    sz = l->reserved;
+  if (need > sz)
+    return false;
+  if (l->fd < 0)
+  {
+    if (mprotect(l->base + l->mapped, sz - l->mapped, PROT_READ | PROT_WRITE) != 0)
+      return false;
+    l->mapped = sz;
+    return true;
+  }
+  if (ftruncate(l->fd, (off_t)sz) != 0)
+    return false;
+  if (mmap(l->base + l->mapped, sz - l->mapped, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_FIXED, l->fd, (off_t)l->mapped) == MAP_FAILED)
+    return false;
+  l->mapped = sz;
+  return true;
+}
+
+static MerkleTree_Mmap_tree *alloc_tree(uint32_t hash_size)
+{
+  MerkleTree_Mmap_tree *mt = KRML_HOST_CALLOC(1U, sizeof (MerkleTree_Mmap_tree));
+  if (mt == NULL)
+    return NULL;
+  mt->hash_size = hash_size;
+  mt->hdr_fd = -1;
+  for (uint32_t lv = 0U; lv < MT_MMAP_LEVELS; lv++)
+    mt->levels[lv].fd = -1;
+  mt->rhs = KRML_HOST_CALLOC(MT_MMAP_LEVELS, hash_size);
+  mt->mroot = KRML_HOST_CALLOC(1U, hash_size);
+  if (mt->rhs == NULL || mt->mroot == NULL)
+  {
+    KRML_HOST_FREE(mt->rhs);
+    KRML_HOST_FREE(mt->mroot);
+    KRML_HOST_FREE(mt);
+    return NULL;
+  }
+  return mt;
+}
+
+/* Opens (creating if needed) and maps the header and level files. */
+static bool map_files(MerkleTree_Mmap_tree *mt, const char *dir, bool create)
+{
+  int flags = O_RDWR | (create ? O_CREAT | O_TRUNC : 0);
+  mt->hdr_fd = open_file(dir, "header", flags);
+  if (mt->hdr_fd < 0)
+    return false;
+  if (create && ftruncate(mt->hdr_fd, sizeof (MerkleTree_Mmap_header)) != 0)
+    return false;
+  struct stat st;
+  if (fstat(mt->hdr_fd, &st) != 0 || (uint64_t)st.st_size < sizeof (MerkleTree_Mmap_header))
+    return false;
+  void *hdr = mmap(NULL, sizeof (MerkleTree_Mmap_header), PROT_READ | PROT_WRITE, MAP_SHARED,
+    mt->hdr_fd, 0);
+  if (hdr == MAP_FAILED)
+    return false;
+  mt->hdr = hdr;
+  for (uint32_t lv = 0U; lv < MT_MMAP_LEVELS; lv++)
+  {
+    char name[16U];
+    snprintf(name, sizeof name, "level.%02u", lv);
+    mt->levels[lv].fd = open_file(dir, name, O_RDWR | O_CREAT | (create ? O_TRUNC : 0));
+    if (mt->levels[lv].fd < 0 || !level_map(&mt->levels[lv], mt->hash_size, lv))
+      return false;
+  }
+  return true;
+}
+
+/* As map_files, for a tree that is not backed by files. */
+static bool map_anonymous(MerkleTree_Mmap_tree *mt)
+{
+  mt->hdr = KRML_HOST_CALLOC(1U, sizeof (MerkleTree_Mmap_header));
+  if (mt->hdr == NULL)
+    return false;
+  for (uint32_t lv = 0U; lv < MT_MMAP_LEVELS; lv++)
+    if (!level_map(&mt->levels[lv], mt->hash_size, lv))
+      return false;
+  return true;
+}
+
+void mt_mmap_close(MerkleTree_Mmap_tree *mt)
+{
+  if (mt == NULL)
+    return;
+  for (uint32_t lv = 0U; lv < MT_MMAP_LEVELS; lv++)
+  {
+    MerkleTree_Mmap_level *l = &mt->levels[lv];
+    if (l->base != NULL)
+      munmap(l->base, l->reserved);
+    if (l->fd >= 0)
+      close(l->fd);
+  }
+  if (mt->hdr_fd >= 0)
+  {
+    if (mt->hdr != NULL)
+      munmap(mt->hdr, sizeof (MerkleTree_Mmap_header));
+    close(mt->hdr_fd);
+  }
+  else
+    KRML_HOST_FREE(mt->hdr);
+  KRML_HOST_FREE(mt->rhs);
+  KRML_HOST_FREE(mt->mroot);
+  KRML_HOST_FREE(mt);
+}
+
+static MerkleTree_Mmap_tree
+*create_empty(
+  const char *dir,
+  uint32_t hash_size,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  if (hash_size == 0U || (dir != NULL && mkdir(dir, 0755) != 0 && errno != EEXIST))
+    return NULL;
+  MerkleTree_Mmap_tree *mt = alloc_tree(hash_size);
+  if (mt == NULL)
+    return NULL;
+  mt->hash_fun = hash_fun;
+  if (!(dir != NULL ? map_files(mt, dir, true) : map_anonymous(mt)))
+  {
+    mt_mmap_close(mt);
+    return NULL;
+  }
+  MerkleTree_Mmap_header *h = mt->hdr;
+  memcpy(h->magic, mt_mmap_magic, sizeof mt_mmap_magic);
+  h->version = MT_MMAP_VERSION;
+  h->hash_size = hash_size;
+  h->offset = 0U;
+  h->i = 0U;
+  h->j = 0U;
+  return mt;
+}
+
+MerkleTree_Mmap_tree
+*mt_mmap_create_custom(
+  const char *dir,
+  uint32_t hash_size,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  MerkleTree_Mmap_tree *mt = create_empty(dir, hash_size, hash_fun);
+  if (mt != NULL && !mt_mmap_insert(mt, init))
+  {
+    mt_mmap_close(mt);
+    return NULL;
+  }
+  return mt;
+}
+
+MerkleTree_Mmap_tree *mt_mmap_create(const char *dir, uint8_t *init)
+{
+  return mt_mmap_create_custom(dir, (uint32_t)32U, init, mt_sha256_compress);
+}
+
+MerkleTree_Mmap_tree
+*mt_mmap_create_from(
+  const char *dir,
+  const MerkleTree_Low_merkle_tree *mt,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  MerkleTree_Mmap_tree *r = create_empty(dir, mt->hash_size, hash_fun);
+  if (r == NULL)
+    return NULL;
+  for (uint32_t lv = 0U; lv < MT_MMAP_LEVELS; lv++)
+  {
+    MerkleTree_Low_Datastructures_hash_vec v = mt->hs.vs[lv];
+    uint32_t ofs = MerkleTree_Low_offset_of(mt->i >> lv);
+    if (v.sz > 0U && !level_reserve(r, lv, ofs + v.sz))
+    {
+      mt_mmap_close(r);
+      return NULL;
+    }
+    for (uint32_t k = 0U; k < v.sz; k++)
+      memcpy(node(r, lv, ofs + k), v.vs[k], mt->hash_size);
+  }
+  r->hdr->offset = mt->offset;
+  r->hdr->i = mt->i;
+  r->hdr->j = mt->j;
+  return r;
+}
+
+MerkleTree_Mmap_tree
+*mt_mmap_open(const char *dir, void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2))
+{
+  if (dir == NULL)
+    return NULL;
+  int fd = open_file(dir, "header", O_RDONLY);
+  if (fd < 0)
+    return NULL;
+  MerkleTree_Mmap_header h;
+  ssize_t r = read(fd, &h, sizeof h);
+  close(fd);
+  if (r != (ssize_t)sizeof h || memcmp(h.magic, mt_mmap_magic, sizeof mt_mmap_magic) != 0 ||
+      h.version != MT_MMAP_VERSION || h.hash_size == 0U || h.i > h.j)
+    return NULL;
+  MerkleTree_Mmap_tree *mt = alloc_tree(h.hash_size);
+  if (mt == NULL)
+    return NULL;
+  mt->hash_fun = hash_fun != NULL ? hash_fun : mt_sha256_compress;
+  bool ok = map_files(mt, dir, false);
+  /* Every level file must hold the nodes that the header claims it has. */
+  for (uint32_t lv = 0U; ok && lv < MT_MMAP_LEVELS; lv++)
+    ok = mt->levels[lv].mapped >= (uint64_t)(mt->hdr->j >> lv) * h.hash_size;
+  if (!ok)
+  {
+    mt_mmap_close(mt);
+    return NULL;
+  }
+  return mt;
+}
+
+bool mt_mmap_sync(MerkleTree_Mmap_tree *mt)
+{
+  if (mt->hdr_fd < 0)
+    return true;
+  bool ok = msync(mt->hdr, sizeof (MerkleTree_Mmap_header), MS_SYNC) == 0;
+  for (uint32_t lv = 0U; lv < MT_MMAP_LEVELS; lv++)
+  {
+    MerkleTree_Mmap_level *l = &mt->levels[lv];
+    if (l->mapped > 0U)
+      ok = msync(l->base, l->mapped, MS_SYNC) == 0 && ok;
+  }
+  return ok;
+}
+
+/* Storage for the nodes created by inserting leaves [j, nj). */
+static bool reserve_insert(MerkleTree_Mmap_tree *mt, uint32_t j, uint32_t nj)
+{
+  for (uint32_t lv = 0U; lv < MT_MMAP_LEVELS && (nj >> lv) > (j >> lv); lv++)
+    if (!level_reserve(mt, lv, nj >> lv))
+      return false;
+  return true;
+}
+
+bool mt_mmap_insert_pre(const MerkleTree_Mmap_tree *mt, uint8_t *v)
+{
+  return mt_mmap_insert_batch_pre(mt, v, 1U);
+}
+
+bool mt_mmap_insert(MerkleTree_Mmap_tree *mt, uint8_t *v)
+{
+  uint32_t j = mt->hdr->j;
+  if (!reserve_insert(mt, j, j + 1U))
+    return false;
+  memcpy(node(mt, 0U, j), v, mt->hash_size);
+  for (uint32_t lv = 0U; j % 2U == 1U; lv++, j = j / 2U)
+    mt->hash_fun(node(mt, lv, j - 1U), node(mt, lv, j), node(mt, lv + 1U, j / 2U));
+  mt->hdr->j = mt->hdr->j + 1U;
+  mt->rhs_ok = false;
+  return true;
+}
+
+/* Hashes the children of parents [lo, hi) of level lv + 1. Siblings are
+   adjacent in the level file, so each pair is already a contiguous 2 *
+   hash_size block and can be fed to the multi-buffer kernels in place. */
+static void hash_level(MerkleTree_Mmap_tree *mt, uint32_t lv, uint32_t lo, uint32_t hi)
+{
+  uint32_t k = lo;
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (mt->hash_fun == mt_sha256_compress && mt->hash_size == 32U)
+  {
+    bool shaext = EverCrypt_AutoConfig2_has_shaext();
+    bool vec256 = EverCrypt_AutoConfig2_has_avx2() && !shaext;
+    bool vec128 = EverCrypt_AutoConfig2_has_avx() && !shaext;
+    uint8_t *bs[8U];
+    uint8_t *ds[8U];
+    if (vec256)
+      for (; hi - k >= 8U; k += 8U)
+      {
+        for (uint32_t l = 0U; l < 8U; l++)
+        {
+          bs[l] = node(mt, lv, 2U * (k + l));
+          ds[l] = node(mt, lv + 1U, k + l);
+        }
+        Hacl_SHA2_Vec256_sha256_compress8(bs, ds);
+      }
+    if (vec256 || vec128)
+      for (; hi - k >= 4U; k += 4U)
+      {
+        for (uint32_t l = 0U; l < 4U; l++)
+        {
+          bs[l] = node(mt, lv, 2U * (k + l));
+          ds[l] = node(mt, lv + 1U, k + l);
+        }
+        Hacl_SHA2_Vec128_sha256_compress4(bs, ds);
+      }
+  }
+  #endif
+  for (; k < hi; k++)
+    mt->hash_fun(node(mt, lv, 2U * k), node(mt, lv, 2U * k + 1U), node(mt, lv + 1U, k));
+}
+
+bool mt_mmap_insert_batch_pre(const MerkleTree_Mmap_tree *mt, uint8_t *vs, uint32_t n)
+{
+  uint64_t nj = (uint64_t)mt->hdr->j + n;
+  return nj <= ((uint64_t)1U << MT_MMAP_LOG_CAPACITY) - 1U &&
+    MerkleTree_Low_uint64_max - mt->hdr->offset >= nj;
+}
+
+bool mt_mmap_insert_batch(MerkleTree_Mmap_tree *mt, uint8_t *vs, uint32_t n)
+{
+  uint32_t j = mt->hdr->j;
+  uint32_t nj = j + n;
+  if (!reserve_insert(mt, j, nj))
+    return false;
+  memcpy(node(mt, 0U, j), vs, (size_t)n * mt->hash_size);
+  for (uint32_t lv = 0U; lv + 1U < MT_MMAP_LEVELS && (nj >> (lv + 1U)) > (j >> (lv + 1U)); lv++)
+    hash_level(mt, lv, j >> (lv + 1U), nj >> (lv + 1U));
+  mt->hdr->j = nj;
+  mt->rhs_ok = false;
+  return true;
+}
+
+/* As construct_rhs in MerkleTree.c. */
+static void
+construct_rhs(
+  const MerkleTree_Mmap_tree *mt,
+  uint32_t lv,
+  uint32_t j,
+  uint8_t *acc,
+  bool actd
+)
+{
+  uint32_t hsz = mt->hash_size;
+  for (; j != 0U; lv++, j = j / 2U)
+  {
+    if (j % 2U == 0U)
+      continue;
+    if (actd)
+    {
+      memcpy(mt->rhs + lv * hsz, acc, hsz);
+      mt->hash_fun(node(mt, lv, j - 1U), acc, acc);
+    }
+    else
+      memcpy(acc, node(mt, lv, j - 1U), hsz);
+    actd = true;
+  }
+}
+
+void mt_mmap_get_root(const MerkleTree_Mmap_tree *mt, uint8_t *root)
+{
+  MerkleTree_Mmap_tree *ncmt = (MerkleTree_Mmap_tree *)mt;
+  if (!mt->rhs_ok)
+  {
+    construct_rhs(mt, 0U, mt->hdr->j, mt->mroot, false);
+    ncmt->rhs_ok = true;
+  }
+  memcpy(root, mt->mroot, mt->hash_size);
+}
+
+bool
+mt_mmap_get_path_pre(
+  const MerkleTree_Mmap_tree *mt,
+  uint64_t idx,
+  const MerkleTree_Low_path *path,
+  uint8_t *root
+)
+{
+  const MerkleTree_Mmap_header *h = mt->hdr;
+  return idx >= h->offset && idx - h->offset <= MerkleTree_Low_offset_range_limit &&
+    path->hash_size == mt->hash_size && h->i <= (uint32_t)(idx - h->offset) &&
+    (uint32_t)(idx - h->offset) < h->j && path->hashes.sz == 0U;
+}
+
+/* As mt_get_path_ in MerkleTree.c. */
+uint32_t
+mt_mmap_get_path(
+  const MerkleTree_Mmap_tree *mt,
+  uint64_t idx,
+  MerkleTree_Low_path *path,
+  uint8_t *root
+)
+{
+  uint32_t hsz = mt->hash_size;
+  mt_mmap_get_root(mt, root);
+  uint32_t j = mt->hdr->j;
+  uint32_t k = (uint32_t)(idx - mt->hdr->offset);
+  bool actd = false;
+  MerkleTree_Low_path_insert(hsz, path, node(mt, 0U, k));
+  for (uint32_t lv = 0U; j != 0U; lv++, j = j / 2U, k = k / 2U)
+  {
+    if (k % 2U == 1U)
+      MerkleTree_Low_path_insert(hsz, path, node(mt, lv, k - 1U));
+    else if (k + 1U == j)
+    {
+      if (actd)
+        MerkleTree_Low_path_insert(hsz, path, mt->rhs + lv * hsz);
+    }
+    else if (k != j)
+      MerkleTree_Low_path_insert(hsz, path, node(mt, lv, k + 1U));
+    actd = actd || j % 2U == 1U;
+  }
+  return mt->hdr->j;
+}
+
+bool mt_mmap_flush_to_pre(const MerkleTree_Mmap_tree *mt, uint64_t idx)
+{
+  const MerkleTree_Mmap_header *h = mt->hdr;
+  return idx >= h->offset && idx - h->offset <= MerkleTree_Low_offset_range_limit &&
+    (uint32_t)(idx - h->offset) >= h->i && (uint32_t)(idx - h->offset) < h->j;
+}
+
+void mt_mmap_flush_to(MerkleTree_Mmap_tree *mt, uint64_t idx)
+{
+  uint32_t i = (uint32_t)(idx - mt->hdr->offset);
+  mt->hdr->i = i;
+  uint64_t ps = page_size();
+  for (uint32_t lv = 0U; lv < MT_MMAP_LEVELS; lv++)
+  {
+    MerkleTree_Mmap_level *l = &mt->levels[lv];
+    uint64_t dead = (uint64_t)MerkleTree_Low_offset_of(i >> lv) * mt->hash_size / ps * ps;
+    if (dead > l->mapped)
+      dead = l->mapped;
+    if (dead == 0U)
+      continue;
+    if (l->fd < 0)
+      madvise(l->base, dead, MADV_DONTNEED);
+    #if defined(__linux__) && defined(FALLOC_FL_PUNCH_HOLE)
+    else
+      fallocate(l->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, 0, (off_t)dead);
+    #endif
+  }
+}
+
+bool mt_mmap_retract_to_pre(const MerkleTree_Mmap_tree *mt, uint64_t idx)
+{
+  const MerkleTree_Mmap_header *h = mt->hdr;
+  return h->offset <= idx && idx - h->offset <= MerkleTree_Low_offset_range_limit &&
+    h->i <= (uint32_t)(idx - h->offset) && (uint32_t)(idx - h->offset) < h->j;
+}
+
+void mt_mmap_retract_to(MerkleTree_Mmap_tree *mt, uint64_t idx)
+{
+  mt->hdr->j = (uint32_t)(idx - mt->hdr->offset) + 1U;
+  mt->rhs_ok = false;
+}
+
+bool
+mt_mmap_verify(
+  const MerkleTree_Mmap_tree *mt,
+  uint64_t tgt,
+  uint64_t max,
+  const MerkleTree_Low_path *path,
+  uint8_t *root
+)
+{
+  /* mt_verify only looks at the hash size, offset and hash function. */
+  MerkleTree_Low_merkle_tree shim = {
+    .hash_size = mt->hash_size,
+    .offset = mt->hdr->offset,
+    .hash_fun = mt->hash_fun
+  };
+  return MerkleTree_Low_mt_verify_pre(&shim, tgt, max, path, root) &&
+    MerkleTree_Low_mt_verify(&shim, tgt, max, path, root);
+}
+
+#else
+
+MerkleTree_Mmap_tree *mt_mmap_create(const char *dir, uint8_t *init)
+{
+  return NULL;
+}
+
+MerkleTree_Mmap_tree
+*mt_mmap_create_custom(
+  const char *dir,
+  uint32_t hash_size,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  return NULL;
+}
+
+MerkleTree_Mmap_tree
+*mt_mmap_create_from(
+  const char *dir,
+  const MerkleTree_Low_merkle_tree *mt,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  return NULL;
+}
+
+MerkleTree_Mmap_tree
+*mt_mmap_open(const char *dir, void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2))
+{
+  return NULL;
+}
+
+bool mt_mmap_sync(MerkleTree_Mmap_tree *mt)
+{
+  return false;
+}
+
+void mt_mmap_close(MerkleTree_Mmap_tree *mt)
+{
+
+}
+
+bool mt_mmap_insert_pre(const MerkleTree_Mmap_tree *mt, uint8_t *v)
+{
+  return false;
+}
+
+bool mt_mmap_insert(MerkleTree_Mmap_tree *mt, uint8_t *v)
+{
+  return false;
+}
+
+bool mt_mmap_insert_batch_pre(const MerkleTree_Mmap_tree *mt, uint8_t *vs, uint32_t n)
+{
+  return false;
+}
+
+bool mt_mmap_insert_batch(MerkleTree_Mmap_tree *mt, uint8_t *vs, uint32_t n)
+{
+  return false;
+}
+
+void mt_mmap_get_root(const MerkleTree_Mmap_tree *mt, uint8_t *root)
+{
+
+}
+
+bool
+mt_mmap_get_path_pre(
+  const MerkleTree_Mmap_tree *mt,
+  uint64_t idx,
+  const MerkleTree_Low_path *path,
+  uint8_t *root
+)
+{
+  return false;
+}
+
+uint32_t
+mt_mmap_get_path(
+  const MerkleTree_Mmap_tree *mt,
+  uint64_t idx,
+  MerkleTree_Low_path *path,
+  uint8_t *root
+)
+{
+  return 0U;
+}
+
+bool mt_mmap_flush_to_pre(const MerkleTree_Mmap_tree *mt, uint64_t idx)
+{
+  return false;
+}
+
+void mt_mmap_flush_to(MerkleTree_Mmap_tree *mt, uint64_t idx)
+{
+
+}
+
+bool mt_mmap_retract_to_pre(const MerkleTree_Mmap_tree *mt, uint64_t idx)
+{
+  return false;
+}
+
+void mt_mmap_retract_to(MerkleTree_Mmap_tree *mt, uint64_t idx)
+{
+
+}
+
+bool
+mt_mmap_verify(
+  const MerkleTree_Mmap_tree *mt,
+  uint64_t tgt,
+  uint64_t max,
+  const MerkleTree_Low_path *path,
+  uint8_t *root
+)
+{
+  return false;
+}
+
+#endif
@@ -0,0 +1,292 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __MerkleTree_Mmap_H
+#define __MerkleTree_Mmap_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "MerkleTree.h"
+
+/*
+  Out-of-core Merkle trees.
+
+  The tree lives in a directory holding a small header file and one file per
+  level. Level files are flat arrays of hash_size-byte slots: the node with
+  index k on a level is stored at byte offset k * hash_size, so a tree can be
+  opened without reading (or deserializing) any of its nodes, and pages are
+  only brought in when a node on them is used. Node indices, insertion and
+  path semantics are those of the in-memory merkle_tree, and both produce the
+  same roots and paths.
+
+  Each level is mapped into a fixed, reserved range of the address space that
+  grows with the file, so hashes returned in paths stay valid until the
+  corresponding nodes are flushed or the tree is closed.
+
+  Passing a NULL directory to the constructors gives an in-memory tree with
+  the same layout: each level is a single contiguous arena of hash_size-byte
+  slots in anonymous memory. Compared to merkle_tree, which allocates every
+  hash separately and keeps vectors of pointers to them, this saves the
+  per-hash allocation overhead and the pointer indirection on every insertion
+  and path step.
+*/
+
+typedef struct MerkleTree_Mmap_header_s
+{
+  uint8_t magic[8U];
+  uint32_t version;
+  uint32_t hash_size;
+  uint64_t offset;
+  uint32_t i;
+  uint32_t j;
+}
+MerkleTree_Mmap_header;
+
+typedef struct MerkleTree_Mmap_level_s
+{
+  int fd;
+  uint8_t *base;
+  uint64_t reserved;
+  uint64_t mapped;
+}
+MerkleTree_Mmap_level;
+
+typedef struct MerkleTree_Mmap_tree_s
+{
+  uint32_t hash_size;
+  int hdr_fd;
+  MerkleTree_Mmap_header *hdr;
+  MerkleTree_Mmap_level levels[32U];
+  bool rhs_ok;
+  uint8_t *rhs;
+  uint8_t *mroot;
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2);
+}
+MerkleTree_Mmap_tree;
+
+typedef MerkleTree_Mmap_tree *mt_mmap_p;
+
+typedef const MerkleTree_Mmap_tree *const_mt_mmap_p;
+
+/*
+  Construction
+
+  @param[in]  dir   Directory to store the tree in; created if it does not
+                    exist. NULL for an in-memory tree.
+  @param[in]  init  The initial hash
+
+  return The new Merkle tree, or NULL if the files could not be created
+
+  Note: An existing tree in dir is overwritten.
+*/
+MerkleTree_Mmap_tree *mt_mmap_create(const char *dir, uint8_t *init);
+
+/*
+  Construction with custom hash functions
+
+  @param[in]  dir       Directory to store the tree in, or NULL
+  @param[in]  hash_size Hash size (in bytes)
+  @param[in]  init      The initial hash
+  @param[in]  hash_fun  The hash function used for internal nodes
+*/
+MerkleTree_Mmap_tree
+*mt_mmap_create_custom(
+  const char *dir,
+  uint32_t hash_size,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+/*
+  Construction from an in-memory tree
+
+  @param[in]  dir       Directory to store the tree in, or NULL
+  @param[in]  mt        The Merkle tree to copy
+  @param[in]  hash_fun  The hash function of mt
+
+  return The new Merkle tree, holding the same (unflushed) nodes as mt
+*/
+MerkleTree_Mmap_tree
+*mt_mmap_create_from(
+  const char *dir,
+  const MerkleTree_Low_merkle_tree *mt,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+/*
+  Opening an existing tree
+
+  @param[in]  dir       Directory the tree was created in
+  @param[in]  hash_fun  The hash function the tree was created with, or NULL
+                        for the default (SHA-256 compression)
+
+  return The Merkle tree, or NULL if dir does not hold a valid tree
+
+  Note: This maps the level files; no node is read until it is used.
+*/
+MerkleTree_Mmap_tree
+*mt_mmap_open(const char *dir, void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2));
+
+/*
+  Flushing dirty pages to disk
+
+  return true if all levels were written back successfully
+
+  Note: This is a no-op for in-memory trees.
+*/
+bool mt_mmap_sync(MerkleTree_Mmap_tree *mt);
+
+/*
+  Closing (and destruction of the in-memory state)
+
+  Note: Does not sync; the files remain valid and can be re-opened.
+*/
+void mt_mmap_close(MerkleTree_Mmap_tree *mt);
+
+/*
+  Insertion
+
+  @param[in]  mt  The Merkle tree
+  @param[in]  v   The hash to insert; the tree makes a copy of it
+
+  return false if the level files could not be extended; the tree is then
+  left unchanged
+*/
+bool mt_mmap_insert(MerkleTree_Mmap_tree *mt, uint8_t *v);
+
+/*
+  Precondition predicate for mt_mmap_insert
+*/
+bool mt_mmap_insert_pre(const MerkleTree_Mmap_tree *mt, uint8_t *v);
+
+/*
+  Batch insertion
+
+  @param[in]  mt  The Merkle tree
+  @param[in]  vs  Buffer of n consecutive hashes
+  @param[in]  n   Number of hashes in vs
+
+  return false if the level files could not be extended; the tree is then
+  left unchanged
+*/
+bool mt_mmap_insert_batch(MerkleTree_Mmap_tree *mt, uint8_t *vs, uint32_t n);
+
+/*
+  Precondition predicate for mt_mmap_insert_batch
+*/
+bool mt_mmap_insert_batch_pre(const MerkleTree_Mmap_tree *mt, uint8_t *vs, uint32_t n);
+
+/*
+  Getting the Merkle root
+
+  @param[in]  mt   The Merkle tree
+  @param[out] root The Merkle root
+*/
+void mt_mmap_get_root(const MerkleTree_Mmap_tree *mt, uint8_t *root);
+
+/*
+  Getting a Merkle path
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  idx  The index of the target hash
+  @param[out] path A resulting Merkle path that contains the leaf hash.
+  @param[out] root The Merkle root
+
+  return The number of elements in the tree
+
+  Note: The hashes in path point into the tree and remain valid until the
+  corresponding nodes are flushed or the tree is closed.
+*/
+uint32_t
+mt_mmap_get_path(
+  const MerkleTree_Mmap_tree *mt,
+  uint64_t idx,
+  MerkleTree_Low_path *path,
+  uint8_t *root
+);
+
+/*
+  Precondition predicate for mt_mmap_get_path
+*/
+bool
+mt_mmap_get_path_pre(
+  const MerkleTree_Mmap_tree *mt,
+  uint64_t idx,
+  const MerkleTree_Low_path *path,
+  uint8_t *root
+);
+
+/*
+  Flush the Merkle tree up to a given index
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  idx  The index up to which to flush the tree
+
+  Note: The memory of flushed nodes is released, as is their storage where
+  the file system supports it.
+*/
+void mt_mmap_flush_to(MerkleTree_Mmap_tree *mt, uint64_t idx);
+
+/*
+  Precondition predicate for mt_mmap_flush_to
+*/
+bool mt_mmap_flush_to_pre(const MerkleTree_Mmap_tree *mt, uint64_t idx);
+
+/*
+  Retract the Merkle tree down to a given index
+
+  @param[in]  mt   The Merkle tree
+  @param[in]  idx  The index to retract the tree to
+
+ Note: The element and idx will remain in the tree.
+*/
+void mt_mmap_retract_to(MerkleTree_Mmap_tree *mt, uint64_t idx);
+
+/*
+  Precondition predicate for mt_mmap_retract_to
+*/
+bool mt_mmap_retract_to_pre(const MerkleTree_Mmap_tree *mt, uint64_t idx);
+
+/*
+  Client-side verification
+
+  Same as mt_verify, for paths obtained from an out-of-core tree.
+*/
+bool
+mt_mmap_verify(
+  const MerkleTree_Mmap_tree *mt,
+  uint64_t tgt,
+  uint64_t max,
+  const MerkleTree_Low_path *path,
+  uint8_t *root
+);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __MerkleTree_Mmap_H_DEFINED
+#endif
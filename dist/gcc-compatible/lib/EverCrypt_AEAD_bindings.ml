@@ -18,6 +18,16 @@ module Bindings(F:Cstubs.FOREIGN) =
         (spec_Agile_AEAD_alg @->
            ((ptr (ptr everCrypt_AEAD_state_s)) @->
               (ocaml_bytes @-> (returning everCrypt_Error_error_code))))
+    let everCrypt_AEAD_state_size =
+      foreign "EverCrypt_AEAD_state_size"
+        (spec_Agile_AEAD_alg @-> (returning uint32_t))
+    let everCrypt_AEAD_init_in_place =
+      foreign "EverCrypt_AEAD_init_in_place"
+        (spec_Agile_AEAD_alg @->
+           ((ptr uint8_t) @->
+              (ocaml_bytes @->
+                 ((ptr (ptr everCrypt_AEAD_state_s)) @->
+                    (returning everCrypt_Error_error_code)))))
     let everCrypt_AEAD_encrypt =
       foreign "EverCrypt_AEAD_encrypt"
         ((ptr everCrypt_AEAD_state_s) @->
@@ -140,6 +150,94 @@ module Bindings(F:Cstubs.FOREIGN) =
                                 (ocaml_bytes @->
                                    (ocaml_bytes @->
                                       (returning everCrypt_Error_error_code)))))))))))
+    type everCrypt_AEAD_stream_s = [ `everCrypt_AEAD_stream_s ] structure
+    let (everCrypt_AEAD_stream_s : [ `everCrypt_AEAD_stream_s ] structure typ)
+      = structure "EverCrypt_AEAD_stream_s_s"
+    let everCrypt_AEAD_stream_create_in =
+      foreign "EverCrypt_AEAD_stream_create_in"
+        ((ptr everCrypt_AEAD_state_s) @->
+           ((ptr (ptr everCrypt_AEAD_stream_s)) @->
+              (returning everCrypt_Error_error_code)))
+    let everCrypt_AEAD_stream_init =
+      foreign "EverCrypt_AEAD_stream_init"
+        ((ptr everCrypt_AEAD_stream_s) @->
+           (ocaml_bytes @->
+              (uint32_t @->
+                 (ocaml_bytes @->
+                    (uint32_t @-> (returning everCrypt_Error_error_code))))))
+    let everCrypt_AEAD_stream_encrypt_update =
+      foreign "EverCrypt_AEAD_stream_encrypt_update"
+        ((ptr everCrypt_AEAD_stream_s) @->
+           (ocaml_bytes @->
+              (uint32_t @->
+                 (ocaml_bytes @-> (returning everCrypt_Error_error_code)))))
+    let everCrypt_AEAD_stream_encrypt_finish =
+      foreign "EverCrypt_AEAD_stream_encrypt_finish"
+        ((ptr everCrypt_AEAD_stream_s) @->
+           (ocaml_bytes @-> (returning everCrypt_Error_error_code)))
+    let everCrypt_AEAD_stream_decrypt_update =
+      foreign "EverCrypt_AEAD_stream_decrypt_update"
+        ((ptr everCrypt_AEAD_stream_s) @->
+           (ocaml_bytes @->
+              (uint32_t @->
+                 (ocaml_bytes @-> (returning everCrypt_Error_error_code)))))
+    let everCrypt_AEAD_stream_decrypt_finish =
+      foreign "EverCrypt_AEAD_stream_decrypt_finish"
+        ((ptr everCrypt_AEAD_stream_s) @->
+           (ocaml_bytes @-> (returning everCrypt_Error_error_code)))
+    let everCrypt_AEAD_stream_decrypt_release =
+      foreign "EverCrypt_AEAD_stream_decrypt_release"
+        ((ptr everCrypt_AEAD_stream_s) @->
+           (ocaml_bytes @->
+              (uint32_t @->
+                 (ocaml_bytes @-> (returning everCrypt_Error_error_code)))))
+    let everCrypt_AEAD_stream_free =
+      foreign "EverCrypt_AEAD_stream_free"
+        ((ptr everCrypt_AEAD_stream_s) @-> (returning void))
+    type everCrypt_AEAD_record_s = [ `everCrypt_AEAD_record_s ] structure
+    let (everCrypt_AEAD_record_s : [ `everCrypt_AEAD_record_s ] structure typ)
+      = structure "EverCrypt_AEAD_record_s_s"
+    let everCrypt_AEAD_record_create_in =
+      foreign "EverCrypt_AEAD_record_create_in"
+        (spec_Agile_AEAD_alg @->
+           ((ptr (ptr everCrypt_AEAD_record_s)) @->
+              (ocaml_bytes @->
+                 (ocaml_bytes @-> (returning everCrypt_Error_error_code)))))
+    let everCrypt_AEAD_record_next_seq =
+      foreign "EverCrypt_AEAD_record_next_seq"
+        ((ptr everCrypt_AEAD_record_s) @-> (returning uint64_t))
+    let everCrypt_AEAD_record_seal_next =
+      foreign "EverCrypt_AEAD_record_seal_next"
+        ((ptr everCrypt_AEAD_record_s) @->
+           (ocaml_bytes @->
+              (uint32_t @->
+                 (ocaml_bytes @->
+                    (uint32_t @->
+                       (ocaml_bytes @->
+                          (ocaml_bytes @-> (returning everCrypt_Error_error_code))))))))
+    let everCrypt_AEAD_record_seal_at =
+      foreign "EverCrypt_AEAD_record_seal_at"
+        ((ptr everCrypt_AEAD_record_s) @->
+           (uint64_t @->
+              (ocaml_bytes @->
+                 (uint32_t @->
+                    (ocaml_bytes @->
+                       (uint32_t @->
+                          (ocaml_bytes @->
+                             (ocaml_bytes @-> (returning everCrypt_Error_error_code)))))))))
+    let everCrypt_AEAD_record_open_at =
+      foreign "EverCrypt_AEAD_record_open_at"
+        ((ptr everCrypt_AEAD_record_s) @->
+           (uint64_t @->
+              (ocaml_bytes @->
+                 (uint32_t @->
+                    (ocaml_bytes @->
+                       (uint32_t @->
+                          (ocaml_bytes @->
+                             (ocaml_bytes @-> (returning everCrypt_Error_error_code)))))))))
+    let everCrypt_AEAD_record_free =
+      foreign "EverCrypt_AEAD_record_free"
+        ((ptr everCrypt_AEAD_record_s) @-> (returning void))
     let everCrypt_AEAD_free =
       foreign "EverCrypt_AEAD_free"
         ((ptr everCrypt_AEAD_state_s) @-> (returning void))
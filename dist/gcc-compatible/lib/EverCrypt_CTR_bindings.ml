@@ -34,6 +34,17 @@ module Bindings(F:Cstubs.FOREIGN) =
       foreign "EverCrypt_CTR_update_block"
         ((ptr everCrypt_CTR_state_s) @->
            (ocaml_bytes @-> (ocaml_bytes @-> (returning void))))
+    let everCrypt_CTR_block_len =
+      foreign "EverCrypt_CTR_block_len"
+        ((ptr everCrypt_CTR_state_s) @-> (returning uint32_t))
+    let everCrypt_CTR_update_blocks =
+      foreign "EverCrypt_CTR_update_blocks"
+        ((ptr everCrypt_CTR_state_s) @->
+           (ocaml_bytes @-> (ocaml_bytes @-> (uint32_t @-> (returning void)))))
+    let everCrypt_CTR_update =
+      foreign "EverCrypt_CTR_update"
+        ((ptr everCrypt_CTR_state_s) @->
+           (ocaml_bytes @-> (ocaml_bytes @-> (uint32_t @-> (returning void)))))
     let everCrypt_CTR_free =
       foreign "EverCrypt_CTR_free"
         ((ptr everCrypt_CTR_state_s) @-> (returning void))
@@ -162,6 +162,136 @@ EverCrypt_AEAD_create_in(Spec_Agile_AEAD_alg a, EverCrypt_AEAD_state_s **dst, ui
   }
 }
 
+/* In caller-owned memory, the expanded key follows the state, at an offset
+   that keeps it 16-byte aligned. */
+static uint32_t state_hdr_len(void)
+{
+  return ((uint32_t)sizeof (EverCrypt_AEAD_state_s) + (uint32_t)15U) & ~(uint32_t)15U;
+}
+
+uint32_t EverCrypt_AEAD_state_size(Spec_Agile_AEAD_alg a)
+{
+  switch (a)
+  {
+    case Spec_Agile_AEAD_AES128_GCM:
+      {
+        return state_hdr_len() + (uint32_t)480U;
+      }
+    case Spec_Agile_AEAD_AES256_GCM:
+      {
+        return state_hdr_len() + (uint32_t)544U;
+      }
+    case Spec_Agile_AEAD_CHACHA20_POLY1305:
+      {
+        return state_hdr_len() + (uint32_t)32U;
+      }
+    default:
+      {
+        return (uint32_t)0U;
+      }
+  }
+}
+
+static EverCrypt_Error_error_code
+init_in_place_chacha20_poly1305(uint8_t *mem, uint8_t *k, EverCrypt_AEAD_state_s **dst)
+{
+  EverCrypt_AEAD_state_s *p = (EverCrypt_AEAD_state_s *)mem;
+  uint8_t *ek = mem + state_hdr_len();
+  memcpy(ek, k, (uint32_t)32U * sizeof (uint8_t));
+  p[0U] = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_Hacl_CHACHA20, .ek = ek });
+  *dst = p;
+  return EverCrypt_Error_Success;
+}
+
+static EverCrypt_Error_error_code
+init_in_place_aes128_gcm(uint8_t *mem, uint8_t *k, EverCrypt_AEAD_state_s **dst)
+{
+  bool has_aesni = EverCrypt_AutoConfig2_has_aesni();
+  bool has_pclmulqdq = EverCrypt_AutoConfig2_has_pclmulqdq();
+  bool has_avx = EverCrypt_AutoConfig2_has_avx();
+  bool has_sse = EverCrypt_AutoConfig2_has_sse();
+  bool has_movbe = EverCrypt_AutoConfig2_has_movbe();
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
+  {
+    EverCrypt_AEAD_state_s *p = (EverCrypt_AEAD_state_s *)mem;
+    uint8_t *ek = mem + state_hdr_len();
+    memset(ek, 0U, (uint32_t)480U * sizeof (uint8_t));
+    uint8_t *keys_b = ek;
+    uint8_t *hkeys_b = ek + (uint32_t)176U;
+    uint64_t scrut = aes128_key_expansion(k, keys_b);
+    uint64_t scrut0 = aes128_keyhash_init(keys_b, hkeys_b);
+    p[0U] = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_Vale_AES128, .ek = ek });
+    *dst = p;
+    return EverCrypt_Error_Success;
+  }
+  #endif
+  return EverCrypt_Error_UnsupportedAlgorithm;
+}
+
+static EverCrypt_Error_error_code
+init_in_place_aes256_gcm(uint8_t *mem, uint8_t *k, EverCrypt_AEAD_state_s **dst)
+{
+  bool has_aesni = EverCrypt_AutoConfig2_has_aesni();
+  bool has_pclmulqdq = EverCrypt_AutoConfig2_has_pclmulqdq();
+  bool has_avx = EverCrypt_AutoConfig2_has_avx();
+  bool has_sse = EverCrypt_AutoConfig2_has_sse();
+  bool has_movbe = EverCrypt_AutoConfig2_has_movbe();
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
+  {
+    EverCrypt_AEAD_state_s *p = (EverCrypt_AEAD_state_s *)mem;
+    uint8_t *ek = mem + state_hdr_len();
+    memset(ek, 0U, (uint32_t)544U * sizeof (uint8_t));
+    uint8_t *keys_b = ek;
+    uint8_t *hkeys_b = ek + (uint32_t)240U;
+    uint64_t scrut = aes256_key_expansion(k, keys_b);
+    uint64_t scrut0 = aes256_keyhash_init(keys_b, hkeys_b);
+    p[0U] = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_Vale_AES256, .ek = ek });
+    *dst = p;
+    return EverCrypt_Error_Success;
+  }
+  #endif
+  return EverCrypt_Error_UnsupportedAlgorithm;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_init_in_place(
+  Spec_Agile_AEAD_alg a,
+  uint8_t *mem,
+  uint8_t *k,
+  EverCrypt_AEAD_state_s **dst
+)
+{
+  if
+  (
+    EverCrypt_AEAD_state_size(a) != (uint32_t)0U
+    && (uintptr_t)mem % (uintptr_t)16U != (uintptr_t)0U
+  )
+  {
+    return EverCrypt_Error_InvalidKey;
+  }
+  switch (a)
+  {
+    case Spec_Agile_AEAD_AES128_GCM:
+      {
+        return init_in_place_aes128_gcm(mem, k, dst);
+      }
+    case Spec_Agile_AEAD_AES256_GCM:
+      {
+        return init_in_place_aes256_gcm(mem, k, dst);
+      }
+    case Spec_Agile_AEAD_CHACHA20_POLY1305:
+      {
+        return init_in_place_chacha20_poly1305(mem, k, dst);
+      }
+    default:
+      {
+        return EverCrypt_Error_UnsupportedAlgorithm;
+      }
+  }
+}
+
 static EverCrypt_Error_error_code
 encrypt_aes128_gcm(
   EverCrypt_AEAD_state_s *s,
@@ -1547,6 +1677,287 @@ EverCrypt_AEAD_decrypt_expand(
   }
 }
 
+typedef struct EverCrypt_AEAD_record_s_s
+{
+  EverCrypt_AEAD_state_s *s;
+  uint8_t static_iv[12U];
+  uint64_t seq;
+}
+EverCrypt_AEAD_record_s;
+
+/* The key state follows the record in the same allocation. */
+static uint32_t record_hdr_len(void)
+{
+  return ((uint32_t)sizeof (EverCrypt_AEAD_record_s) + (uint32_t)15U) & ~(uint32_t)15U;
+}
+
+/* The nonce of record seq: the static IV, with the last 8 bytes XORed with seq
+   in big-endian order (TLS 1.3, QUIC). */
+static void record_nonce(EverCrypt_AEAD_record_s *r, uint64_t seq, uint8_t *iv)
+{
+  memcpy(iv, r->static_iv, (uint32_t)12U * sizeof (uint8_t));
+  uint64_t x = load64_be(iv + (uint32_t)4U);
+  store64_be(iv + (uint32_t)4U, x ^ seq);
+}
+
+/* Records are processed in groups of at most RECORD_BATCH, which bounds the
+   nonces and pointer arrays kept on the stack. */
+#define RECORD_BATCH ((uint32_t)32U)
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_create_in(
+  Spec_Agile_AEAD_alg a,
+  EverCrypt_AEAD_record_s **dst,
+  uint8_t *k,
+  uint8_t *static_iv
+)
+{
+  uint32_t size = EverCrypt_AEAD_state_size(a);
+  if (size == (uint32_t)0U)
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  uint8_t *mem = KRML_HOST_MALLOC(record_hdr_len() + size);
+  EverCrypt_AEAD_record_s *r = (EverCrypt_AEAD_record_s *)mem;
+  EverCrypt_Error_error_code res = EverCrypt_AEAD_init_in_place(a, mem + record_hdr_len(), k, &r->s);
+  if (res != EverCrypt_Error_Success)
+  {
+    KRML_HOST_FREE(mem);
+    return res;
+  }
+  memcpy(r->static_iv, static_iv, (uint32_t)12U * sizeof (uint8_t));
+  r->seq = (uint64_t)0U;
+  *dst = r;
+  return EverCrypt_Error_Success;
+}
+
+uint64_t EverCrypt_AEAD_record_next_seq(EverCrypt_AEAD_record_s *r)
+{
+  return r->seq;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  uint8_t iv[12U];
+  record_nonce(r, seq, iv);
+  return EverCrypt_AEAD_encrypt(r->s, iv, (uint32_t)12U, ad, ad_len, plain, plain_len, cipher, tag);
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_next(
+  EverCrypt_AEAD_record_s *r,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  if (r->seq == (uint64_t)0xffffffffffffffffU)
+  {
+    return EverCrypt_Error_MaximumLengthExceeded;
+  }
+  EverCrypt_Error_error_code
+  res = EverCrypt_AEAD_record_seal_at(r, r->seq, ad, ad_len, plain, plain_len, cipher, tag);
+  if (res == EverCrypt_Error_Success)
+  {
+    r->seq = r->seq + (uint64_t)1U;
+  }
+  return res;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst
+)
+{
+  uint8_t iv[12U];
+  record_nonce(r, seq, iv);
+  return EverCrypt_AEAD_decrypt(r->s, iv, (uint32_t)12U, ad, ad_len, cipher, cipher_len, tag, dst);
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **plain,
+  uint32_t *plain_len,
+  uint8_t **cipher,
+  uint8_t **tag
+)
+{
+  uint64_t seq0 = r->seq;
+  if (seq == NULL && (uint64_t)num > (uint64_t)0xffffffffffffffffU - seq0)
+  {
+    return EverCrypt_Error_MaximumLengthExceeded;
+  }
+  uint8_t iv[RECORD_BATCH][12U];
+  uint8_t *k[RECORD_BATCH];
+  uint8_t *n[RECORD_BATCH];
+  for (uint32_t i = (uint32_t)0U; i < num; i = i + RECORD_BATCH)
+  {
+    uint32_t m = num - i < RECORD_BATCH ? num - i : RECORD_BATCH;
+    for (uint32_t j = (uint32_t)0U; j < m; j++)
+    {
+      uint64_t sj = seq == NULL ? seq0 + (uint64_t)(i + j) : seq[i + j];
+      record_nonce(r, sj, iv[j]);
+      k[j] = r->s->ek;
+      n[j] = iv[j];
+    }
+    if (r->s->impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+    {
+      EverCrypt_Chacha20Poly1305_aead_encrypt_multi(m,
+        k,
+        n,
+        ad_len + i,
+        ad + i,
+        plain_len + i,
+        plain + i,
+        cipher + i,
+        tag + i);
+    }
+    else
+    {
+      for (uint32_t j = (uint32_t)0U; j < m; j++)
+      {
+        uint32_t l = i + j;
+        EverCrypt_Error_error_code
+        res =
+          EverCrypt_AEAD_encrypt(r->s,
+            n[j],
+            (uint32_t)12U,
+            ad[l],
+            ad_len[l],
+            plain[l],
+            plain_len[l],
+            cipher[l],
+            tag[l]);
+        if (res != EverCrypt_Error_Success)
+        {
+          if (seq == NULL)
+          {
+            r->seq = seq0 + (uint64_t)l;
+          }
+          return res;
+        }
+      }
+    }
+  }
+  if (seq == NULL)
+  {
+    r->seq = seq0 + (uint64_t)num;
+  }
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **cipher,
+  uint32_t *cipher_len,
+  uint8_t **tag,
+  uint8_t **dst,
+  EverCrypt_Error_error_code *res
+)
+{
+  EverCrypt_Error_error_code all = EverCrypt_Error_Success;
+  uint8_t iv[RECORD_BATCH][12U];
+  uint8_t *k[RECORD_BATCH];
+  uint8_t *n[RECORD_BATCH];
+  uint32_t r1[RECORD_BATCH];
+  for (uint32_t i = (uint32_t)0U; i < num; i = i + RECORD_BATCH)
+  {
+    uint32_t m = num - i < RECORD_BATCH ? num - i : RECORD_BATCH;
+    for (uint32_t j = (uint32_t)0U; j < m; j++)
+    {
+      record_nonce(r, seq[i + j], iv[j]);
+      k[j] = r->s->ek;
+      n[j] = iv[j];
+    }
+    if (r->s->impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+    {
+      EverCrypt_Chacha20Poly1305_aead_decrypt_multi(m,
+        k,
+        n,
+        ad_len + i,
+        ad + i,
+        cipher_len + i,
+        dst + i,
+        cipher + i,
+        tag + i,
+        r1);
+      for (uint32_t j = (uint32_t)0U; j < m; j++)
+      {
+        if (r1[j] == (uint32_t)0U)
+        {
+          res[i + j] = EverCrypt_Error_Success;
+        }
+        else
+        {
+          res[i + j] = EverCrypt_Error_AuthenticationFailure;
+        }
+      }
+    }
+    else
+    {
+      for (uint32_t j = (uint32_t)0U; j < m; j++)
+      {
+        uint32_t l = i + j;
+        res[l] =
+          EverCrypt_AEAD_decrypt(r->s,
+            n[j],
+            (uint32_t)12U,
+            ad[l],
+            ad_len[l],
+            cipher[l],
+            cipher_len[l],
+            tag[l],
+            dst[l]);
+      }
+    }
+    for (uint32_t j = (uint32_t)0U; j < m; j++)
+    {
+      if (res[i + j] != EverCrypt_Error_Success)
+      {
+        all = EverCrypt_Error_AuthenticationFailure;
+      }
+    }
+  }
+  return all;
+}
+
+void EverCrypt_AEAD_record_free(EverCrypt_AEAD_record_s *r)
+{
+  Spec_Agile_AEAD_alg a = EverCrypt_AEAD_alg_of_state(r->s);
+  Lib_Memzero0_memzero((uint8_t *)r, record_hdr_len() + EverCrypt_AEAD_state_size(a));
+  KRML_HOST_FREE(r);
+}
+
 void EverCrypt_AEAD_free(EverCrypt_AEAD_state_s *s)
 {
   EverCrypt_AEAD_state_s scrut = *s;
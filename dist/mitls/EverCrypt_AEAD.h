@@ -43,6 +43,7 @@ extern "C" {
 #include "EverCrypt_AutoConfig2.h"
 #include "EverCrypt_Error.h"
 #include "Hacl_Spec.h"
+#include "Lib_Memzero0.h"
 
 typedef struct EverCrypt_AEAD_state_s_s EverCrypt_AEAD_state_s;
 
@@ -59,6 +60,27 @@ Spec_Agile_AEAD_alg EverCrypt_AEAD_alg_of_state(EverCrypt_AEAD_state_s *s);
 EverCrypt_Error_error_code
 EverCrypt_AEAD_create_in(Spec_Agile_AEAD_alg a, EverCrypt_AEAD_state_s **dst, uint8_t *k);
 
+/* The number of bytes that EverCrypt_AEAD_init_in_place needs for a state of
+   algorithm a, whatever implementation this CPU selects; 0 if a is not
+   supported. */
+uint32_t EverCrypt_AEAD_state_size(Spec_Agile_AEAD_alg a);
+
+/* Same as EverCrypt_AEAD_create_in, with the state and its expanded key laid
+   out in caller-owned memory: mem holds EverCrypt_AEAD_state_size(a) bytes and
+   is 16-byte aligned, and *dst is set to a state within mem that is valid as
+   long as mem is. Such a state is not passed to EverCrypt_AEAD_free; the
+   caller releases (and should zero) mem itself, and may call this function
+   again on the same memory to load another key. Returns
+   EverCrypt_Error_InvalidKey, leaving mem and *dst untouched, if mem is not
+   16-byte aligned. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_init_in_place(
+  Spec_Agile_AEAD_alg a,
+  uint8_t *mem,
+  uint8_t *k,
+  EverCrypt_AEAD_state_s **dst
+);
+
 EverCrypt_Error_error_code
 EverCrypt_AEAD_encrypt(
   EverCrypt_AEAD_state_s *s,
@@ -191,6 +213,103 @@ EverCrypt_AEAD_decrypt_expand(
   uint8_t *dst
 );
 
+/* Record protection, as in TLS 1.3 and QUIC: an object that owns an expanded
+   key, a 12-byte static IV and a sequence counter, starting at 0. The nonce of
+   record seq is the static IV with its last 8 bytes XORed with seq, in
+   big-endian order. Each call costs one nonce computation on top of
+   EverCrypt_AEAD_encrypt or EverCrypt_AEAD_decrypt, with no allocation. */
+typedef struct EverCrypt_AEAD_record_s_s EverCrypt_AEAD_record_s;
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_create_in(
+  Spec_Agile_AEAD_alg a,
+  EverCrypt_AEAD_record_s **dst,
+  uint8_t *k,
+  uint8_t *static_iv
+);
+
+/* The sequence number that the next EverCrypt_AEAD_record_seal_next uses. */
+uint64_t EverCrypt_AEAD_record_next_seq(EverCrypt_AEAD_record_s *r);
+
+/* Encrypts the next record and advances the counter. Fails with
+   EverCrypt_Error_MaximumLengthExceeded once the counter reaches 2^64 - 1. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_next(
+  EverCrypt_AEAD_record_s *r,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+/* Encrypts record seq, for protocols that choose their sequence numbers, such
+   as QUIC packet numbers. The counter is left unchanged; the caller must never
+   seal two records with the same seq. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+/* Decrypts record seq; see EverCrypt_AEAD_decrypt. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_at(
+  EverCrypt_AEAD_record_s *r,
+  uint64_t seq,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst
+);
+
+/* Encrypts num records: record i has sequence number seq[i], or, if seq is
+   NULL, the next num sequence numbers are taken from the counter.
+   ChaCha20-Poly1305 records are processed several at a time, one per vector
+   lane. Stops at the first record that fails to encrypt and returns its error:
+   the records before it are sealed, and the counter only moves past them. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_seal_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **plain,
+  uint32_t *plain_len,
+  uint8_t **cipher,
+  uint8_t **tag
+);
+
+/* Decrypts num records with sequence numbers seq[i]. res[i] is the result of
+   record i, as for EverCrypt_AEAD_record_open_at; returns
+   EverCrypt_Error_AuthenticationFailure unless all records authenticate. */
+EverCrypt_Error_error_code
+EverCrypt_AEAD_record_open_multi(
+  EverCrypt_AEAD_record_s *r,
+  uint32_t num,
+  uint64_t *seq,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **cipher,
+  uint32_t *cipher_len,
+  uint8_t **tag,
+  uint8_t **dst,
+  EverCrypt_Error_error_code *res
+);
+
+/* Zeroes and frees the record object, including its key. */
+void EverCrypt_AEAD_record_free(EverCrypt_AEAD_record_s *r);
+
 void EverCrypt_AEAD_free(EverCrypt_AEAD_state_s *s);
 
 #if defined(__cplusplus)
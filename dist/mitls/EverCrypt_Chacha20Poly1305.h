@@ -66,6 +66,44 @@ EverCrypt_Chacha20Poly1305_aead_decrypt(
   uint8_t *tag
 );
 
+/* Encrypts num independent messages: job i uses key k[i] and nonce n[i] to
+   encrypt the mlen[i] bytes at m[i] with additional data aad[i], writing the
+   ciphertext to cipher[i] and the tag to tag[i]. With AVX2 (resp. AVX), up to 8
+   (resp. 4) jobs share one pass of the ChaCha20 core, one job per vector lane,
+   and their tags are computed with a Poly1305 that holds one key per lane.
+   This is meant for many short records, e.g. QUIC packets, that each only
+   fill a fraction of the vectors of the single-message implementation. */
+void
+EverCrypt_Chacha20Poly1305_aead_encrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+);
+
+/* Decrypts num independent messages, see
+   EverCrypt_Chacha20Poly1305_aead_encrypt_multi. res[i] is set to 0 if job i
+   authenticated and to 1 otherwise, in which case m[i] is zeroed. Returns 0 if
+   all jobs authenticated, 1 otherwise. */
+uint32_t
+EverCrypt_Chacha20Poly1305_aead_decrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+);
+
 #if defined(__cplusplus)
 }
 #endif
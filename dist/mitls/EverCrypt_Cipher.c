@@ -39,3 +39,55 @@ EverCrypt_Cipher_chacha20(
   Hacl_Impl_Chacha20_chacha20_update(ctx, len, dst, src);
 }
 
+void
+EverCrypt_Cipher_chacha20_multi(
+  uint32_t num,
+  uint32_t *len,
+  uint8_t **dst,
+  uint8_t **src,
+  uint8_t **key,
+  uint8_t **iv,
+  uint32_t *ctr
+)
+{
+  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
+  bool avx = EverCrypt_AutoConfig2_has_avx();
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx2)
+  {
+    for (uint32_t i = (uint32_t)0U; i < num; i = i + (uint32_t)8U)
+    {
+      uint32_t k = num - i < (uint32_t)8U ? num - i : (uint32_t)8U;
+      Hacl_Chacha20_Vec256_chacha20_encrypt_multi_ctr_256(k,
+        len + i,
+        dst + i,
+        src + i,
+        key + i,
+        iv + i,
+        ctr + i);
+    }
+    return;
+  }
+  #endif
+  #if EVERCRYPT_TARGETCONFIG_X64
+  if (avx)
+  {
+    for (uint32_t i = (uint32_t)0U; i < num; i = i + (uint32_t)4U)
+    {
+      uint32_t k = num - i < (uint32_t)4U ? num - i : (uint32_t)4U;
+      Hacl_Chacha20_Vec128_chacha20_encrypt_multi_ctr_128(k,
+        len + i,
+        dst + i,
+        src + i,
+        key + i,
+        iv + i,
+        ctr + i);
+    }
+    return;
+  }
+  #endif
+  for (uint32_t i = (uint32_t)0U; i < num; i++)
+  {
+    EverCrypt_Cipher_chacha20(len[i], dst[i], src[i], key[i], iv[i], ctr[i]);
+  }
+}
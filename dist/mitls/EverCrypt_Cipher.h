@@ -37,7 +37,10 @@ extern "C" {
 #include "kremlin/internal/target.h"
 
 
+#include "EverCrypt_AutoConfig2.h"
 #include "Hacl_Chacha20.h"
+#include "Hacl_Chacha20_Vec128.h"
+#include "Hacl_Chacha20_Vec256.h"
 
 void
 EverCrypt_Cipher_chacha20(
@@ -49,6 +52,22 @@ EverCrypt_Cipher_chacha20(
   uint32_t ctr
 );
 
+/* Encrypts num independent messages: the len[i] bytes at src[i] are xored with
+   the ChaCha20 keystream for key[i], iv[i] and initial counter ctr[i], and
+   written to dst[i]. With AVX2 (resp. AVX), 8 (resp. 4) messages share one
+   pass of the ChaCha20 core, one message per vector lane; this is meant for
+   many short messages, e.g. QUIC header protection masks. */
+void
+EverCrypt_Cipher_chacha20_multi(
+  uint32_t num,
+  uint32_t *len,
+  uint8_t **dst,
+  uint8_t **src,
+  uint8_t **key,
+  uint8_t **iv,
+  uint32_t *ctr
+);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -907,22 +907,9 @@ poly1305_padded_256(Lib_IntVector_Intrinsics_vec256 *ctx, uint32_t len, uint8_t
 }
 
 static inline void
-poly1305_do_256(
-  uint8_t *k,
-  uint32_t aadlen,
-  uint8_t *aad,
-  uint32_t mlen,
-  uint8_t *m,
-  uint8_t *out
-)
+poly1305_lengths_256(Lib_IntVector_Intrinsics_vec256 *ctx, uint32_t aadlen, uint32_t mlen)
 {
-  Lib_IntVector_Intrinsics_vec256 ctx[25U];
-  for (uint32_t _i = 0U; _i < (uint32_t)25U; ++_i)
-    ctx[_i] = Lib_IntVector_Intrinsics_vec256_zero;
   uint8_t block[16U] = { 0U };
-  Hacl_Poly1305_256_poly1305_init(ctx, k);
-  poly1305_padded_256(ctx, aadlen, aad);
-  poly1305_padded_256(ctx, mlen, m);
   store64_le(block, (uint64_t)aadlen);
   store64_le(block + (uint32_t)8U, (uint64_t)mlen);
   Lib_IntVector_Intrinsics_vec256 *pre = ctx + (uint32_t)5U;
@@ -1132,7 +1119,43 @@ poly1305_do_256(
   acc[2U] = o2;
   acc[3U] = o3;
   acc[4U] = o4;
-  Hacl_Poly1305_256_poly1305_finish(out, k, ctx);
+}
+
+/* Below this length, encrypting and then MACing the whole message in two passes is faster than
+   the chunked single pass: on a machine with a 2 MiB L2, the chunked pass only wins from about
+   32 MiB on. Decryption always checks the tag before it writes any plaintext. */
+#define CHUNKED_MIN_LEN ((uint32_t)0x2000000U)
+
+/* Encrypts in 4 KiB chunks and MACs each chunk of ciphertext while it is still in cache. This
+   only pays off on messages much larger than the cache; see CHUNKED_MIN_LEN. */
+static inline void
+chacha20_poly1305_256(
+  Lib_IntVector_Intrinsics_vec256 *ctx,
+  uint8_t *k,
+  uint8_t *n,
+  uint32_t len,
+  uint8_t *out,
+  uint8_t *text
+)
+{
+  uint32_t nc = len / (uint32_t)4096U;
+  uint32_t rem = len % (uint32_t)4096U;
+  for (uint32_t i = (uint32_t)0U; i < nc; i++)
+  {
+    uint8_t *o = out + i * (uint32_t)4096U;
+    uint8_t *t = text + i * (uint32_t)4096U;
+    uint32_t ctr = (uint32_t)1U + i * (uint32_t)64U;
+    Hacl_Chacha20_Vec256_chacha20_encrypt_256((uint32_t)4096U, o, t, k, n, ctr);
+    poly1305_padded_256(ctx, (uint32_t)4096U, o);
+  }
+  if (rem > (uint32_t)0U)
+  {
+    uint8_t *o = out + nc * (uint32_t)4096U;
+    uint8_t *t = text + nc * (uint32_t)4096U;
+    uint32_t ctr = (uint32_t)1U + nc * (uint32_t)64U;
+    Hacl_Chacha20_Vec256_chacha20_encrypt_256(rem, o, t, k, n, ctr);
+    poly1305_padded_256(ctx, rem, o);
+  }
 }
 
 void
@@ -1147,11 +1170,25 @@ Hacl_Chacha20Poly1305_256_aead_encrypt(
   uint8_t *mac
 )
 {
-  Hacl_Chacha20_Vec256_chacha20_encrypt_256(mlen, cipher, m, k, n, (uint32_t)1U);
   uint8_t tmp[64U] = { 0U };
   Hacl_Chacha20_Vec256_chacha20_encrypt_256((uint32_t)64U, tmp, tmp, k, n, (uint32_t)0U);
   uint8_t *key = tmp;
-  poly1305_do_256(key, aadlen, aad, mlen, cipher, mac);
+  Lib_IntVector_Intrinsics_vec256 ctx[25U];
+  for (uint32_t _i = 0U; _i < (uint32_t)25U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  Hacl_Poly1305_256_poly1305_init(ctx, key);
+  poly1305_padded_256(ctx, aadlen, aad);
+  if (mlen >= CHUNKED_MIN_LEN)
+  {
+    chacha20_poly1305_256(ctx, k, n, mlen, cipher, m);
+  }
+  else
+  {
+    Hacl_Chacha20_Vec256_chacha20_encrypt_256(mlen, cipher, m, k, n, (uint32_t)1U);
+    poly1305_padded_256(ctx, mlen, cipher);
+  }
+  poly1305_lengths_256(ctx, aadlen, mlen);
+  Hacl_Poly1305_256_poly1305_finish(mac, key, ctx);
 }
 
 uint32_t
@@ -1170,7 +1207,14 @@ Hacl_Chacha20Poly1305_256_aead_decrypt(
   uint8_t tmp[64U] = { 0U };
   Hacl_Chacha20_Vec256_chacha20_encrypt_256((uint32_t)64U, tmp, tmp, k, n, (uint32_t)0U);
   uint8_t *key = tmp;
-  poly1305_do_256(key, aadlen, aad, mlen, cipher, computed_mac);
+  Lib_IntVector_Intrinsics_vec256 ctx[25U];
+  for (uint32_t _i = 0U; _i < (uint32_t)25U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  Hacl_Poly1305_256_poly1305_init(ctx, key);
+  poly1305_padded_256(ctx, aadlen, aad);
+  poly1305_padded_256(ctx, mlen, cipher);
+  poly1305_lengths_256(ctx, aadlen, mlen);
+  Hacl_Poly1305_256_poly1305_finish(computed_mac, key, ctx);
   uint8_t res = (uint8_t)255U;
   for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
   {
@@ -1186,3 +1230,487 @@ Hacl_Chacha20Poly1305_256_aead_decrypt(
   return (uint32_t)1U;
 }
 
+
+static inline void
+poly1305_padded_block_256(
+  uint8_t *b,
+  uint32_t i,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m
+)
+{
+  uint32_t na = (aadlen + (uint32_t)15U) / (uint32_t)16U;
+  uint32_t nm = (mlen + (uint32_t)15U) / (uint32_t)16U;
+  if (i < na)
+  {
+    uint32_t l = aadlen - i * (uint32_t)16U;
+    memcpy(b, aad + i * (uint32_t)16U, (l < (uint32_t)16U ? l : (uint32_t)16U) * sizeof (uint8_t));
+  }
+  else if (i < na + nm)
+  {
+    uint32_t l = mlen - (i - na) * (uint32_t)16U;
+    memcpy(b,
+      m + (i - na) * (uint32_t)16U,
+      (l < (uint32_t)16U ? l : (uint32_t)16U) * sizeof (uint8_t));
+  }
+  else
+  {
+    store64_le(b, (uint64_t)aadlen);
+    store64_le(b + (uint32_t)8U, (uint64_t)mlen);
+  }
+}
+
+static inline void
+poly1305_do_multi_256(
+  uint32_t num,
+  uint8_t **k,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **out
+)
+{
+  Lib_IntVector_Intrinsics_vec256 ctx[15U];
+  for (uint32_t _i = 0U; _i < (uint32_t)15U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  Lib_IntVector_Intrinsics_vec256 *acc = ctx;
+  Lib_IntVector_Intrinsics_vec256 *pre = ctx + (uint32_t)5U;
+  uint64_t rl[4U] = { 0U };
+  uint64_t rh[4U] = { 0U };
+  uint32_t nb[4U] = { 0U };
+  uint32_t nmax = (uint32_t)0U;
+  for (uint32_t j = (uint32_t)0U; j < num; j++)
+  {
+    uint64_t u0 = load64_le(k[j]);
+    uint64_t u = load64_le(k[j] + (uint32_t)8U);
+    rl[j] = u0 & (uint64_t)0x0ffffffc0fffffffU;
+    rh[j] = u & (uint64_t)0x0ffffffc0ffffffcU;
+    nb[j] =
+      (aadlen[j] + (uint32_t)15U)
+      / (uint32_t)16U
+      + (mlen[j] + (uint32_t)15U) / (uint32_t)16U
+      + (uint32_t)1U;
+    if (nb[j] > nmax)
+    {
+      nmax = nb[j];
+    }
+  }
+  Lib_IntVector_Intrinsics_vec256
+  r_vec0 = Lib_IntVector_Intrinsics_vec256_load64s(rl[0U], rl[1U], rl[2U], rl[3U]);
+  Lib_IntVector_Intrinsics_vec256
+  r_vec1 = Lib_IntVector_Intrinsics_vec256_load64s(rh[0U], rh[1U], rh[2U], rh[3U]);
+  Lib_IntVector_Intrinsics_vec256
+  fr0 =
+    Lib_IntVector_Intrinsics_vec256_and(r_vec0,
+      Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU));
+  Lib_IntVector_Intrinsics_vec256
+  fr1 =
+    Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_shift_right64(r_vec0,
+        (uint32_t)26U),
+      Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU));
+  Lib_IntVector_Intrinsics_vec256
+  fr2 =
+    Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(r_vec0,
+        (uint32_t)52U),
+      Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(r_vec1,
+          Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3fffU)),
+        (uint32_t)12U));
+  Lib_IntVector_Intrinsics_vec256
+  fr3 =
+    Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_shift_right64(r_vec1,
+        (uint32_t)14U),
+      Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU));
+  Lib_IntVector_Intrinsics_vec256
+  fr4 = Lib_IntVector_Intrinsics_vec256_shift_right64(r_vec1, (uint32_t)40U);
+  pre[0U] = fr0;
+  pre[1U] = fr1;
+  pre[2U] = fr2;
+  pre[3U] = fr3;
+  pre[4U] = fr4;
+  pre[5U] = Lib_IntVector_Intrinsics_vec256_smul64(fr0, (uint64_t)5U);
+  pre[6U] = Lib_IntVector_Intrinsics_vec256_smul64(fr1, (uint64_t)5U);
+  pre[7U] = Lib_IntVector_Intrinsics_vec256_smul64(fr2, (uint64_t)5U);
+  pre[8U] = Lib_IntVector_Intrinsics_vec256_smul64(fr3, (uint64_t)5U);
+  pre[9U] = Lib_IntVector_Intrinsics_vec256_smul64(fr4, (uint64_t)5U);
+  for (uint32_t i = (uint32_t)0U; i < nmax; i++)
+  {
+    uint8_t b[64U] = { 0U };
+    uint64_t hb[4U] = { 0U };
+    for (uint32_t j = (uint32_t)0U; j < num; j++)
+    {
+      if (i + nb[j] >= nmax)
+      {
+        poly1305_padded_block_256(b + j * (uint32_t)16U,
+          i + nb[j] - nmax,
+          aadlen[j],
+          aad[j],
+          mlen[j],
+          m[j]);
+        hb[j] = (uint64_t)0x1000000U;
+      }
+    }
+    Lib_IntVector_Intrinsics_vec256 e[5U];
+    for (uint32_t _i = 0U; _i < (uint32_t)5U; ++_i)
+      e[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+    Lib_IntVector_Intrinsics_vec256
+    f0 =
+      Lib_IntVector_Intrinsics_vec256_load64s(load64_le(b),
+        load64_le(b + (uint32_t)16U),
+        load64_le(b + (uint32_t)32U),
+        load64_le(b + (uint32_t)48U));
+    Lib_IntVector_Intrinsics_vec256
+    f1 =
+      Lib_IntVector_Intrinsics_vec256_load64s(load64_le(b + (uint32_t)8U),
+        load64_le(b + (uint32_t)24U),
+        load64_le(b + (uint32_t)40U),
+        load64_le(b + (uint32_t)56U));
+    Lib_IntVector_Intrinsics_vec256
+    f010 =
+      Lib_IntVector_Intrinsics_vec256_and(f0,
+        Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU));
+    Lib_IntVector_Intrinsics_vec256
+    f110 =
+      Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_shift_right64(f0,
+          (uint32_t)26U),
+        Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU));
+    Lib_IntVector_Intrinsics_vec256
+    f20 =
+      Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(f0,
+          (uint32_t)52U),
+        Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(f1,
+            Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3fffU)),
+          (uint32_t)12U));
+    Lib_IntVector_Intrinsics_vec256
+    f30 =
+      Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_shift_right64(f1,
+          (uint32_t)14U),
+        Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU));
+    Lib_IntVector_Intrinsics_vec256
+    f40 = Lib_IntVector_Intrinsics_vec256_shift_right64(f1, (uint32_t)40U);
+    Lib_IntVector_Intrinsics_vec256 f01 = f010;
+    Lib_IntVector_Intrinsics_vec256 f111 = f110;
+    Lib_IntVector_Intrinsics_vec256 f2 = f20;
+    Lib_IntVector_Intrinsics_vec256 f3 = f30;
+    Lib_IntVector_Intrinsics_vec256 f41 = f40;
+    e[0U] = f01;
+    e[1U] = f111;
+    e[2U] = f2;
+    e[3U] = f3;
+    e[4U] =
+      Lib_IntVector_Intrinsics_vec256_or(f41,
+        Lib_IntVector_Intrinsics_vec256_load64s(hb[0U], hb[1U], hb[2U], hb[3U]));
+    Lib_IntVector_Intrinsics_vec256 *r = pre;
+    Lib_IntVector_Intrinsics_vec256 *r5 = pre + (uint32_t)5U;
+    Lib_IntVector_Intrinsics_vec256 r0 = r[0U];
+    Lib_IntVector_Intrinsics_vec256 r1 = r[1U];
+    Lib_IntVector_Intrinsics_vec256 r2 = r[2U];
+    Lib_IntVector_Intrinsics_vec256 r3 = r[3U];
+    Lib_IntVector_Intrinsics_vec256 r4 = r[4U];
+    Lib_IntVector_Intrinsics_vec256 r51 = r5[1U];
+    Lib_IntVector_Intrinsics_vec256 r52 = r5[2U];
+    Lib_IntVector_Intrinsics_vec256 r53 = r5[3U];
+    Lib_IntVector_Intrinsics_vec256 r54 = r5[4U];
+    Lib_IntVector_Intrinsics_vec256 f10 = e[0U];
+    Lib_IntVector_Intrinsics_vec256 f11 = e[1U];
+    Lib_IntVector_Intrinsics_vec256 f12 = e[2U];
+    Lib_IntVector_Intrinsics_vec256 f13 = e[3U];
+    Lib_IntVector_Intrinsics_vec256 f14 = e[4U];
+    Lib_IntVector_Intrinsics_vec256 a0 = acc[0U];
+    Lib_IntVector_Intrinsics_vec256 a1 = acc[1U];
+    Lib_IntVector_Intrinsics_vec256 a2 = acc[2U];
+    Lib_IntVector_Intrinsics_vec256 a3 = acc[3U];
+    Lib_IntVector_Intrinsics_vec256 a4 = acc[4U];
+    Lib_IntVector_Intrinsics_vec256 a01 = Lib_IntVector_Intrinsics_vec256_add64(a0, f10);
+    Lib_IntVector_Intrinsics_vec256 a11 = Lib_IntVector_Intrinsics_vec256_add64(a1, f11);
+    Lib_IntVector_Intrinsics_vec256 a21 = Lib_IntVector_Intrinsics_vec256_add64(a2, f12);
+    Lib_IntVector_Intrinsics_vec256 a31 = Lib_IntVector_Intrinsics_vec256_add64(a3, f13);
+    Lib_IntVector_Intrinsics_vec256 a41 = Lib_IntVector_Intrinsics_vec256_add64(a4, f14);
+    Lib_IntVector_Intrinsics_vec256 a02 = Lib_IntVector_Intrinsics_vec256_mul64(r0, a01);
+    Lib_IntVector_Intrinsics_vec256 a12 = Lib_IntVector_Intrinsics_vec256_mul64(r1, a01);
+    Lib_IntVector_Intrinsics_vec256 a22 = Lib_IntVector_Intrinsics_vec256_mul64(r2, a01);
+    Lib_IntVector_Intrinsics_vec256 a32 = Lib_IntVector_Intrinsics_vec256_mul64(r3, a01);
+    Lib_IntVector_Intrinsics_vec256 a42 = Lib_IntVector_Intrinsics_vec256_mul64(r4, a01);
+    Lib_IntVector_Intrinsics_vec256
+    a03 =
+      Lib_IntVector_Intrinsics_vec256_add64(a02,
+        Lib_IntVector_Intrinsics_vec256_mul64(r54, a11));
+    Lib_IntVector_Intrinsics_vec256
+    a13 =
+      Lib_IntVector_Intrinsics_vec256_add64(a12,
+        Lib_IntVector_Intrinsics_vec256_mul64(r0, a11));
+    Lib_IntVector_Intrinsics_vec256
+    a23 =
+      Lib_IntVector_Intrinsics_vec256_add64(a22,
+        Lib_IntVector_Intrinsics_vec256_mul64(r1, a11));
+    Lib_IntVector_Intrinsics_vec256
+    a33 =
+      Lib_IntVector_Intrinsics_vec256_add64(a32,
+        Lib_IntVector_Intrinsics_vec256_mul64(r2, a11));
+    Lib_IntVector_Intrinsics_vec256
+    a43 =
+      Lib_IntVector_Intrinsics_vec256_add64(a42,
+        Lib_IntVector_Intrinsics_vec256_mul64(r3, a11));
+    Lib_IntVector_Intrinsics_vec256
+    a04 =
+      Lib_IntVector_Intrinsics_vec256_add64(a03,
+        Lib_IntVector_Intrinsics_vec256_mul64(r53, a21));
+    Lib_IntVector_Intrinsics_vec256
+    a14 =
+      Lib_IntVector_Intrinsics_vec256_add64(a13,
+        Lib_IntVector_Intrinsics_vec256_mul64(r54, a21));
+    Lib_IntVector_Intrinsics_vec256
+    a24 =
+      Lib_IntVector_Intrinsics_vec256_add64(a23,
+        Lib_IntVector_Intrinsics_vec256_mul64(r0, a21));
+    Lib_IntVector_Intrinsics_vec256
+    a34 =
+      Lib_IntVector_Intrinsics_vec256_add64(a33,
+        Lib_IntVector_Intrinsics_vec256_mul64(r1, a21));
+    Lib_IntVector_Intrinsics_vec256
+    a44 =
+      Lib_IntVector_Intrinsics_vec256_add64(a43,
+        Lib_IntVector_Intrinsics_vec256_mul64(r2, a21));
+    Lib_IntVector_Intrinsics_vec256
+    a05 =
+      Lib_IntVector_Intrinsics_vec256_add64(a04,
+        Lib_IntVector_Intrinsics_vec256_mul64(r52, a31));
+    Lib_IntVector_Intrinsics_vec256
+    a15 =
+      Lib_IntVector_Intrinsics_vec256_add64(a14,
+        Lib_IntVector_Intrinsics_vec256_mul64(r53, a31));
+    Lib_IntVector_Intrinsics_vec256
+    a25 =
+      Lib_IntVector_Intrinsics_vec256_add64(a24,
+        Lib_IntVector_Intrinsics_vec256_mul64(r54, a31));
+    Lib_IntVector_Intrinsics_vec256
+    a35 =
+      Lib_IntVector_Intrinsics_vec256_add64(a34,
+        Lib_IntVector_Intrinsics_vec256_mul64(r0, a31));
+    Lib_IntVector_Intrinsics_vec256
+    a45 =
+      Lib_IntVector_Intrinsics_vec256_add64(a44,
+        Lib_IntVector_Intrinsics_vec256_mul64(r1, a31));
+    Lib_IntVector_Intrinsics_vec256
+    a06 =
+      Lib_IntVector_Intrinsics_vec256_add64(a05,
+        Lib_IntVector_Intrinsics_vec256_mul64(r51, a41));
+    Lib_IntVector_Intrinsics_vec256
+    a16 =
+      Lib_IntVector_Intrinsics_vec256_add64(a15,
+        Lib_IntVector_Intrinsics_vec256_mul64(r52, a41));
+    Lib_IntVector_Intrinsics_vec256
+    a26 =
+      Lib_IntVector_Intrinsics_vec256_add64(a25,
+        Lib_IntVector_Intrinsics_vec256_mul64(r53, a41));
+    Lib_IntVector_Intrinsics_vec256
+    a36 =
+      Lib_IntVector_Intrinsics_vec256_add64(a35,
+        Lib_IntVector_Intrinsics_vec256_mul64(r54, a41));
+    Lib_IntVector_Intrinsics_vec256
+    a46 =
+      Lib_IntVector_Intrinsics_vec256_add64(a45,
+        Lib_IntVector_Intrinsics_vec256_mul64(r0, a41));
+    Lib_IntVector_Intrinsics_vec256 t0 = a06;
+    Lib_IntVector_Intrinsics_vec256 t1 = a16;
+    Lib_IntVector_Intrinsics_vec256 t2 = a26;
+    Lib_IntVector_Intrinsics_vec256 t3 = a36;
+    Lib_IntVector_Intrinsics_vec256 t4 = a46;
+    Lib_IntVector_Intrinsics_vec256
+    mask26 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU);
+    Lib_IntVector_Intrinsics_vec256
+    z0 = Lib_IntVector_Intrinsics_vec256_shift_right64(t0, (uint32_t)26U);
+    Lib_IntVector_Intrinsics_vec256
+    z1 = Lib_IntVector_Intrinsics_vec256_shift_right64(t3, (uint32_t)26U);
+    Lib_IntVector_Intrinsics_vec256 x0 = Lib_IntVector_Intrinsics_vec256_and(t0, mask26);
+    Lib_IntVector_Intrinsics_vec256 x3 = Lib_IntVector_Intrinsics_vec256_and(t3, mask26);
+    Lib_IntVector_Intrinsics_vec256 x1 = Lib_IntVector_Intrinsics_vec256_add64(t1, z0);
+    Lib_IntVector_Intrinsics_vec256 x4 = Lib_IntVector_Intrinsics_vec256_add64(t4, z1);
+    Lib_IntVector_Intrinsics_vec256
+    z01 = Lib_IntVector_Intrinsics_vec256_shift_right64(x1, (uint32_t)26U);
+    Lib_IntVector_Intrinsics_vec256
+    z11 = Lib_IntVector_Intrinsics_vec256_shift_right64(x4, (uint32_t)26U);
+    Lib_IntVector_Intrinsics_vec256
+    t = Lib_IntVector_Intrinsics_vec256_shift_left64(z11, (uint32_t)2U);
+    Lib_IntVector_Intrinsics_vec256 z12 = Lib_IntVector_Intrinsics_vec256_add64(z11, t);
+    Lib_IntVector_Intrinsics_vec256 x11 = Lib_IntVector_Intrinsics_vec256_and(x1, mask26);
+    Lib_IntVector_Intrinsics_vec256 x41 = Lib_IntVector_Intrinsics_vec256_and(x4, mask26);
+    Lib_IntVector_Intrinsics_vec256 x2 = Lib_IntVector_Intrinsics_vec256_add64(t2, z01);
+    Lib_IntVector_Intrinsics_vec256 x01 = Lib_IntVector_Intrinsics_vec256_add64(x0, z12);
+    Lib_IntVector_Intrinsics_vec256
+    z02 = Lib_IntVector_Intrinsics_vec256_shift_right64(x2, (uint32_t)26U);
+    Lib_IntVector_Intrinsics_vec256
+    z13 = Lib_IntVector_Intrinsics_vec256_shift_right64(x01, (uint32_t)26U);
+    Lib_IntVector_Intrinsics_vec256 x21 = Lib_IntVector_Intrinsics_vec256_and(x2, mask26);
+    Lib_IntVector_Intrinsics_vec256 x02 = Lib_IntVector_Intrinsics_vec256_and(x01, mask26);
+    Lib_IntVector_Intrinsics_vec256 x31 = Lib_IntVector_Intrinsics_vec256_add64(x3, z02);
+    Lib_IntVector_Intrinsics_vec256 x12 = Lib_IntVector_Intrinsics_vec256_add64(x11, z13);
+    Lib_IntVector_Intrinsics_vec256
+    z03 = Lib_IntVector_Intrinsics_vec256_shift_right64(x31, (uint32_t)26U);
+    Lib_IntVector_Intrinsics_vec256 x32 = Lib_IntVector_Intrinsics_vec256_and(x31, mask26);
+    Lib_IntVector_Intrinsics_vec256 x42 = Lib_IntVector_Intrinsics_vec256_add64(x41, z03);
+    Lib_IntVector_Intrinsics_vec256 o0 = x02;
+    Lib_IntVector_Intrinsics_vec256 o1 = x12;
+    Lib_IntVector_Intrinsics_vec256 o2 = x21;
+    Lib_IntVector_Intrinsics_vec256 o3 = x32;
+    Lib_IntVector_Intrinsics_vec256 o4 = x42;
+    acc[0U] = o0;
+    acc[1U] = o1;
+    acc[2U] = o2;
+    acc[3U] = o3;
+    acc[4U] = o4;
+  }
+  uint8_t tmp[160U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256_store_le(tmp + i * (uint32_t)32U, acc[i]);
+  }
+  for (uint32_t j = (uint32_t)0U; j < num; j++)
+  {
+    uint64_t ctx1[25U] = { 0U };
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+    {
+      ctx1[i] = load64_le(tmp + i * (uint32_t)32U + j * (uint32_t)8U);
+    }
+    Hacl_Poly1305_32_poly1305_finish(out[j], k[j], ctx1);
+  }
+}
+
+void
+Hacl_Chacha20Poly1305_256_aead_encrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **mac
+)
+{
+  for (uint32_t i = (uint32_t)0U; i < num; i = i + (uint32_t)8U)
+  {
+    uint32_t g = num - i < (uint32_t)8U ? num - i : (uint32_t)8U;
+    uint8_t tmp[512U] = { 0U };
+    uint8_t *key[8U] = { 0U };
+    uint32_t klen[8U] = { 0U };
+    for (uint32_t j = (uint32_t)0U; j < g; j++)
+    {
+      key[j] = tmp + j * (uint32_t)64U;
+      klen[j] = (uint32_t)64U;
+    }
+    Hacl_Chacha20_Vec256_chacha20_encrypt_multi_256(g,
+      klen,
+      key,
+      key,
+      k + i,
+      n + i,
+      (uint32_t)0U);
+    Hacl_Chacha20_Vec256_chacha20_encrypt_multi_256(g,
+      mlen + i,
+      cipher + i,
+      m + i,
+      k + i,
+      n + i,
+      (uint32_t)1U);
+    for (uint32_t j = (uint32_t)0U; j < g; j = j + (uint32_t)4U)
+    {
+      uint32_t h = g - j < (uint32_t)4U ? g - j : (uint32_t)4U;
+      poly1305_do_multi_256(h,
+        key + j,
+        aadlen + i + j,
+        aad + i + j,
+        mlen + i + j,
+        cipher + i + j,
+        mac + i + j);
+    }
+  }
+}
+
+uint32_t
+Hacl_Chacha20Poly1305_256_aead_decrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **mac,
+  uint32_t *res
+)
+{
+  uint32_t r = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < num; i = i + (uint32_t)8U)
+  {
+    uint32_t g = num - i < (uint32_t)8U ? num - i : (uint32_t)8U;
+    uint8_t tmp[512U] = { 0U };
+    uint8_t computed_mac[128U] = { 0U };
+    uint8_t *key[8U] = { 0U };
+    uint8_t *cmac[8U] = { 0U };
+    uint32_t klen[8U] = { 0U };
+    uint32_t dlen[8U] = { 0U };
+    for (uint32_t j = (uint32_t)0U; j < g; j++)
+    {
+      key[j] = tmp + j * (uint32_t)64U;
+      cmac[j] = computed_mac + j * (uint32_t)16U;
+      klen[j] = (uint32_t)64U;
+    }
+    Hacl_Chacha20_Vec256_chacha20_encrypt_multi_256(g,
+      klen,
+      key,
+      key,
+      k + i,
+      n + i,
+      (uint32_t)0U);
+    for (uint32_t j = (uint32_t)0U; j < g; j = j + (uint32_t)4U)
+    {
+      uint32_t h = g - j < (uint32_t)4U ? g - j : (uint32_t)4U;
+      poly1305_do_multi_256(h,
+        key + j,
+        aadlen + i + j,
+        aad + i + j,
+        mlen + i + j,
+        cipher + i + j,
+        cmac + j);
+    }
+    for (uint32_t j = (uint32_t)0U; j < g; j++)
+    {
+      uint8_t res0 = (uint8_t)255U;
+      for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)16U; i0++)
+      {
+        uint8_t uu____0 = FStar_UInt8_eq_mask(cmac[j][i0], mac[i + j][i0]);
+        res0 = uu____0 & res0;
+      }
+      if (res0 == (uint8_t)255U)
+      {
+        res[i + j] = (uint32_t)0U;
+        dlen[j] = mlen[i + j];
+      }
+      else
+      {
+        res[i + j] = (uint32_t)1U;
+        r = (uint32_t)1U;
+      }
+    }
+    Hacl_Chacha20_Vec256_chacha20_encrypt_multi_256(g,
+      dlen,
+      m + i,
+      cipher + i,
+      k + i,
+      n + i,
+      (uint32_t)1U);
+    for (uint32_t j = (uint32_t)0U; j < g; j++)
+    {
+      if (res[i + j] != (uint32_t)0U)
+      {
+        memset(m[i + j], 0U, mlen[i + j] * sizeof (uint8_t));
+      }
+    }
+  }
+  return r;
+}
@@ -40,6 +40,7 @@ extern "C" {
 #include "Hacl_Kremlib.h"
 #include "Hacl_Chacha20_Vec256.h"
 #include "Hacl_Poly1305_256.h"
+#include "Hacl_Poly1305_32.h"
 
 void
 Hacl_Chacha20Poly1305_256_aead_encrypt(
@@ -65,6 +66,33 @@ Hacl_Chacha20Poly1305_256_aead_decrypt(
   uint8_t *mac
 );
 
+void
+Hacl_Chacha20Poly1305_256_aead_encrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **mac
+);
+
+uint32_t
+Hacl_Chacha20Poly1305_256_aead_decrypt_multi(
+  uint32_t num,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **mac,
+  uint32_t *res
+);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -759,3 +759,249 @@ Hacl_Chacha20_Vec128_chacha20_decrypt_128(
   }
 }
 
+
+static inline void
+chacha20_core_multi_128(
+  Lib_IntVector_Intrinsics_vec128 *k,
+  Lib_IntVector_Intrinsics_vec128 *ctx,
+  uint32_t ctr
+)
+{
+  memcpy(k, ctx, (uint32_t)16U * sizeof (Lib_IntVector_Intrinsics_vec128));
+  Lib_IntVector_Intrinsics_vec128 cv = Lib_IntVector_Intrinsics_vec128_load32(ctr);
+  k[12U] = Lib_IntVector_Intrinsics_vec128_add32(k[12U], cv);
+  double_round_128(k);
+  double_round_128(k);
+  double_round_128(k);
+  double_round_128(k);
+  double_round_128(k);
+  double_round_128(k);
+  double_round_128(k);
+  double_round_128(k);
+  double_round_128(k);
+  double_round_128(k);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec128 *os = k;
+    Lib_IntVector_Intrinsics_vec128 x = Lib_IntVector_Intrinsics_vec128_add32(k[i], ctx[i]);
+    os[i] = x;
+  }
+  k[12U] = Lib_IntVector_Intrinsics_vec128_add32(k[12U], cv);
+}
+
+void
+Hacl_Chacha20_Vec128_chacha20_encrypt_multi_ctr_128(
+  uint32_t num,
+  uint32_t *len,
+  uint8_t **out,
+  uint8_t **text,
+  uint8_t **key,
+  uint8_t **n,
+  uint32_t *ctr
+)
+{
+  uint32_t st[64U] = { 0U };
+  uint32_t nb = (uint32_t)0U;
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    uint32_t l = j < num ? j : (uint32_t)0U;
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+    {
+      st[(uint32_t)4U * i + j] = Hacl_Impl_Chacha20_Vec_chacha20_constants[i];
+    }
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+    {
+      st[(uint32_t)4U * ((uint32_t)4U + i) + j] = load32_le(key[l] + i * (uint32_t)4U);
+    }
+    st[(uint32_t)48U + j] = ctr[l];
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)3U; i++)
+    {
+      st[(uint32_t)4U * ((uint32_t)13U + i) + j] = load32_le(n[l] + i * (uint32_t)4U);
+    }
+    if (j < num)
+    {
+      uint32_t nbj = (len[j] + (uint32_t)63U) / (uint32_t)64U;
+      if (nbj > nb)
+      {
+        nb = nbj;
+      }
+    }
+  }
+  Lib_IntVector_Intrinsics_vec128 ctx[16U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    uint32_t *sti = st + (uint32_t)4U * i;
+    ctx[i] = Lib_IntVector_Intrinsics_vec128_load32s(sti[0U], sti[1U], sti[2U], sti[3U]);
+  }
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    Lib_IntVector_Intrinsics_vec128 k[16U];
+    for (uint32_t _i = 0U; _i < (uint32_t)16U; ++_i)
+      k[_i] = Lib_IntVector_Intrinsics_vec128_zero;
+    chacha20_core_multi_128(k, ctx, i);
+    Lib_IntVector_Intrinsics_vec128 v00 = k[0U];
+    Lib_IntVector_Intrinsics_vec128 v16 = k[1U];
+    Lib_IntVector_Intrinsics_vec128 v20 = k[2U];
+    Lib_IntVector_Intrinsics_vec128 v30 = k[3U];
+    Lib_IntVector_Intrinsics_vec128
+    v0_ = Lib_IntVector_Intrinsics_vec128_interleave_low32(v00, v16);
+    Lib_IntVector_Intrinsics_vec128
+    v1_ = Lib_IntVector_Intrinsics_vec128_interleave_high32(v00, v16);
+    Lib_IntVector_Intrinsics_vec128
+    v2_ = Lib_IntVector_Intrinsics_vec128_interleave_low32(v20, v30);
+    Lib_IntVector_Intrinsics_vec128
+    v3_ = Lib_IntVector_Intrinsics_vec128_interleave_high32(v20, v30);
+    Lib_IntVector_Intrinsics_vec128
+    v0__ = Lib_IntVector_Intrinsics_vec128_interleave_low64(v0_, v2_);
+    Lib_IntVector_Intrinsics_vec128
+    v1__ = Lib_IntVector_Intrinsics_vec128_interleave_high64(v0_, v2_);
+    Lib_IntVector_Intrinsics_vec128
+    v2__ = Lib_IntVector_Intrinsics_vec128_interleave_low64(v1_, v3_);
+    Lib_IntVector_Intrinsics_vec128
+    v3__ = Lib_IntVector_Intrinsics_vec128_interleave_high64(v1_, v3_);
+    Lib_IntVector_Intrinsics_vec128 v0 = v0__;
+    Lib_IntVector_Intrinsics_vec128 v1 = v1__;
+    Lib_IntVector_Intrinsics_vec128 v2 = v2__;
+    Lib_IntVector_Intrinsics_vec128 v3 = v3__;
+    Lib_IntVector_Intrinsics_vec128 v010 = k[4U];
+    Lib_IntVector_Intrinsics_vec128 v110 = k[5U];
+    Lib_IntVector_Intrinsics_vec128 v210 = k[6U];
+    Lib_IntVector_Intrinsics_vec128 v310 = k[7U];
+    Lib_IntVector_Intrinsics_vec128
+    v0_0 = Lib_IntVector_Intrinsics_vec128_interleave_low32(v010, v110);
+    Lib_IntVector_Intrinsics_vec128
+    v1_0 = Lib_IntVector_Intrinsics_vec128_interleave_high32(v010, v110);
+    Lib_IntVector_Intrinsics_vec128
+    v2_0 = Lib_IntVector_Intrinsics_vec128_interleave_low32(v210, v310);
+    Lib_IntVector_Intrinsics_vec128
+    v3_0 = Lib_IntVector_Intrinsics_vec128_interleave_high32(v210, v310);
+    Lib_IntVector_Intrinsics_vec128
+    v0__0 = Lib_IntVector_Intrinsics_vec128_interleave_low64(v0_0, v2_0);
+    Lib_IntVector_Intrinsics_vec128
+    v1__0 = Lib_IntVector_Intrinsics_vec128_interleave_high64(v0_0, v2_0);
+    Lib_IntVector_Intrinsics_vec128
+    v2__0 = Lib_IntVector_Intrinsics_vec128_interleave_low64(v1_0, v3_0);
+    Lib_IntVector_Intrinsics_vec128
+    v3__0 = Lib_IntVector_Intrinsics_vec128_interleave_high64(v1_0, v3_0);
+    Lib_IntVector_Intrinsics_vec128 v4 = v0__0;
+    Lib_IntVector_Intrinsics_vec128 v5 = v1__0;
+    Lib_IntVector_Intrinsics_vec128 v6 = v2__0;
+    Lib_IntVector_Intrinsics_vec128 v7 = v3__0;
+    Lib_IntVector_Intrinsics_vec128 v011 = k[8U];
+    Lib_IntVector_Intrinsics_vec128 v111 = k[9U];
+    Lib_IntVector_Intrinsics_vec128 v211 = k[10U];
+    Lib_IntVector_Intrinsics_vec128 v311 = k[11U];
+    Lib_IntVector_Intrinsics_vec128
+    v0_1 = Lib_IntVector_Intrinsics_vec128_interleave_low32(v011, v111);
+    Lib_IntVector_Intrinsics_vec128
+    v1_1 = Lib_IntVector_Intrinsics_vec128_interleave_high32(v011, v111);
+    Lib_IntVector_Intrinsics_vec128
+    v2_1 = Lib_IntVector_Intrinsics_vec128_interleave_low32(v211, v311);
+    Lib_IntVector_Intrinsics_vec128
+    v3_1 = Lib_IntVector_Intrinsics_vec128_interleave_high32(v211, v311);
+    Lib_IntVector_Intrinsics_vec128
+    v0__1 = Lib_IntVector_Intrinsics_vec128_interleave_low64(v0_1, v2_1);
+    Lib_IntVector_Intrinsics_vec128
+    v1__1 = Lib_IntVector_Intrinsics_vec128_interleave_high64(v0_1, v2_1);
+    Lib_IntVector_Intrinsics_vec128
+    v2__1 = Lib_IntVector_Intrinsics_vec128_interleave_low64(v1_1, v3_1);
+    Lib_IntVector_Intrinsics_vec128
+    v3__1 = Lib_IntVector_Intrinsics_vec128_interleave_high64(v1_1, v3_1);
+    Lib_IntVector_Intrinsics_vec128 v8 = v0__1;
+    Lib_IntVector_Intrinsics_vec128 v9 = v1__1;
+    Lib_IntVector_Intrinsics_vec128 v10 = v2__1;
+    Lib_IntVector_Intrinsics_vec128 v11 = v3__1;
+    Lib_IntVector_Intrinsics_vec128 v01 = k[12U];
+    Lib_IntVector_Intrinsics_vec128 v120 = k[13U];
+    Lib_IntVector_Intrinsics_vec128 v21 = k[14U];
+    Lib_IntVector_Intrinsics_vec128 v31 = k[15U];
+    Lib_IntVector_Intrinsics_vec128
+    v0_2 = Lib_IntVector_Intrinsics_vec128_interleave_low32(v01, v120);
+    Lib_IntVector_Intrinsics_vec128
+    v1_2 = Lib_IntVector_Intrinsics_vec128_interleave_high32(v01, v120);
+    Lib_IntVector_Intrinsics_vec128
+    v2_2 = Lib_IntVector_Intrinsics_vec128_interleave_low32(v21, v31);
+    Lib_IntVector_Intrinsics_vec128
+    v3_2 = Lib_IntVector_Intrinsics_vec128_interleave_high32(v21, v31);
+    Lib_IntVector_Intrinsics_vec128
+    v0__2 = Lib_IntVector_Intrinsics_vec128_interleave_low64(v0_2, v2_2);
+    Lib_IntVector_Intrinsics_vec128
+    v1__2 = Lib_IntVector_Intrinsics_vec128_interleave_high64(v0_2, v2_2);
+    Lib_IntVector_Intrinsics_vec128
+    v2__2 = Lib_IntVector_Intrinsics_vec128_interleave_low64(v1_2, v3_2);
+    Lib_IntVector_Intrinsics_vec128
+    v3__2 = Lib_IntVector_Intrinsics_vec128_interleave_high64(v1_2, v3_2);
+    Lib_IntVector_Intrinsics_vec128 v12 = v0__2;
+    Lib_IntVector_Intrinsics_vec128 v13 = v1__2;
+    Lib_IntVector_Intrinsics_vec128 v14 = v2__2;
+    Lib_IntVector_Intrinsics_vec128 v15 = v3__2;
+    k[0U] = v0;
+    k[1U] = v4;
+    k[2U] = v8;
+    k[3U] = v12;
+    k[4U] = v1;
+    k[5U] = v5;
+    k[6U] = v9;
+    k[7U] = v13;
+    k[8U] = v2;
+    k[9U] = v6;
+    k[10U] = v10;
+    k[11U] = v14;
+    k[12U] = v3;
+    k[13U] = v7;
+    k[14U] = v11;
+    k[15U] = v15;
+    for (uint32_t j = (uint32_t)0U; j < num; j++)
+    {
+      if (i * (uint32_t)64U < len[j])
+      {
+        uint32_t rem = len[j] - i * (uint32_t)64U;
+        uint8_t *o = out[j] + i * (uint32_t)64U;
+        uint8_t *t = text[j] + i * (uint32_t)64U;
+        Lib_IntVector_Intrinsics_vec128 *kj = k + (uint32_t)4U * j;
+        if (rem >= (uint32_t)64U)
+        {
+          for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
+          {
+            Lib_IntVector_Intrinsics_vec128
+            x = Lib_IntVector_Intrinsics_vec128_load_le(t + i0 * (uint32_t)16U);
+            Lib_IntVector_Intrinsics_vec128 y = Lib_IntVector_Intrinsics_vec128_xor(x, kj[i0]);
+            Lib_IntVector_Intrinsics_vec128_store_le(o + i0 * (uint32_t)16U, y);
+          }
+        }
+        else
+        {
+          uint8_t plain[64U] = { 0U };
+          memcpy(plain, t, rem * sizeof (uint8_t));
+          for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
+          {
+            Lib_IntVector_Intrinsics_vec128
+            x = Lib_IntVector_Intrinsics_vec128_load_le(plain + i0 * (uint32_t)16U);
+            Lib_IntVector_Intrinsics_vec128 y = Lib_IntVector_Intrinsics_vec128_xor(x, kj[i0]);
+            Lib_IntVector_Intrinsics_vec128_store_le(plain + i0 * (uint32_t)16U, y);
+          }
+          memcpy(o, plain, rem * sizeof (uint8_t));
+        }
+      }
+    }
+  }
+}
+
+void
+Hacl_Chacha20_Vec128_chacha20_encrypt_multi_128(
+  uint32_t num,
+  uint32_t *len,
+  uint8_t **out,
+  uint8_t **text,
+  uint8_t **key,
+  uint8_t **n,
+  uint32_t ctr
+)
+{
+  uint32_t ctrs[4U];
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    ctrs[j] = ctr;
+  }
+  Hacl_Chacha20_Vec128_chacha20_encrypt_multi_ctr_128(num, len, out, text, key, n, ctrs);
+}
@@ -28,6 +28,7 @@
 
 #include "timing.h"
 #include "EverCrypt.h"
+#include "quic_provider.h"
 
 // How long to measure for KB/s figures
 #define MEASUREMENT_TIME 2
@@ -87,7 +88,7 @@ do {                                                                    \
     }                                                                   \
 } while( 0 )
 
-void bench_aead(Spec_AEAD_alg a, const unsigned char *alg, size_t plain_len)
+void bench_aead(Spec_Agile_AEAD_alg a, const unsigned char *alg, size_t plain_len)
 {
   unsigned char tag[16], key[32], iv[12];
   unsigned char *plain = malloc(65536);
@@ -99,13 +100,13 @@ void bench_aead(Spec_AEAD_alg a, const unsigned char *alg, size_t plain_len)
   sprintf(title, "ENC %s[%5d]", alg, plain_len);
 
   TIME_AND_TSC(title, plain_len,
-    EverCrypt_AEAD_encrypt(s, iv, "", 0, plain, plain_len, cipher, tag);
+    EverCrypt_AEAD_encrypt(s, iv, 12, "", 0, plain, plain_len, cipher, tag);
   );
 
   sprintf(title, "DEC %s[%5d]", alg, plain_len);
 
   TIME_AND_TSC(title, plain_len,
-    EverCrypt_AEAD_decrypt(s, iv, "", 0, cipher, plain_len, tag, plain);
+    EverCrypt_AEAD_decrypt(s, iv, 12, "", 0, cipher, plain_len, tag, plain);
   );
 
   EverCrypt_AEAD_free(s);
@@ -128,6 +129,72 @@ void bench_hash(Spec_Hash_Definitions_hash_alg a, const unsigned char *alg, size
   free(plain);
 }
 
+#define QUIC_PACKETS 64
+
+// Protects QUIC_PACKETS packets of plain_len bytes (AEAD encryption and header
+// protection mask), one at a time and then with the batch API.
+void bench_quic(mitls_aead a, const unsigned char *alg, size_t plain_len)
+{
+  unsigned char raw_key[32] = {0}, iv[12] = {0}, pne_key[32] = {0};
+  unsigned char hdr[20] = {0}, mask[5 * QUIC_PACKETS];
+  unsigned char *buf = malloc(plain_len);
+  unsigned char *cbuf = malloc(QUIC_PACKETS * (plain_len + 16));
+  unsigned char *cipher[QUIC_PACKETS];
+  const unsigned char *ad[QUIC_PACKETS], *plain[QUIC_PACKETS];
+  uint32_t ad_len[QUIC_PACKETS], plain_len_[QUIC_PACKETS], hp_offset[QUIC_PACKETS];
+  uint64_t sn[QUIC_PACKETS];
+  size_t total = QUIC_PACKETS * plain_len;
+  quic_key *key;
+  quic_crypto_create(&key, a, raw_key, iv, pne_key);
+
+  for(size_t i = 0; i < QUIC_PACKETS; i++)
+  {
+    cipher[i] = cbuf + i * (plain_len + 16);
+    sn[i] = i;
+    ad[i] = hdr;
+    ad_len[i] = sizeof(hdr);
+    plain[i] = buf;
+    plain_len_[i] = plain_len;
+    hp_offset[i] = 0;
+  }
+
+  char title[128];
+  sprintf(title, "QUIC %s[%5d]", alg, plain_len);
+
+  TIME_AND_TSC(title, total,
+    for(size_t i = 0; i < QUIC_PACKETS; i++)
+    {
+      quic_crypto_encrypt(key, cipher[i], sn[i], ad[i], ad_len[i], plain[i], plain_len_[i]);
+      quic_crypto_hp_mask(key, cipher[i], mask + 5 * i);
+    }
+  );
+
+  sprintf(title, "QUIC BATCH %s[%5d]", alg, plain_len);
+
+  TIME_AND_TSC(title, total,
+    quic_crypto_encrypt_batch(key, QUIC_PACKETS, cipher, sn, ad, ad_len, plain, plain_len_, hp_offset, mask)
+  );
+
+  quic_crypto_free_key(key);
+  free(buf);
+  free(cbuf);
+}
+
+void run_quic()
+{
+  EverCrypt_AutoConfig2_init();
+  size_t lens[] = { 64, 256, 1200 };
+
+  for(size_t i = 0; i < 3; i++)
+    bench_quic(TLS_aead_AES_128_GCM, "AES128-GCM", lens[i]);
+
+  for(size_t i = 0; i < 3; i++)
+    bench_quic(TLS_aead_AES_256_GCM, "AES256-GCM", lens[i]);
+
+  for(size_t i = 0; i < 3; i++)
+    bench_quic(TLS_aead_CHACHA20_POLY1305, "CHA20-P1305", lens[i]);
+}
+
 void run() //EverCrypt_AutoConfig_cfg cfg)
 {
   /*
@@ -153,13 +220,13 @@ void run() //EverCrypt_AutoConfig_cfg cfg)
   size_t i;
 
   for(i=4; i<=65536; i<<=1)
-    bench_aead(Spec_AEAD_AES128_GCM, "AES128-GCM", i);
+    bench_aead(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM", i);
 
   for(i=4; i<=65536; i<<=1)
-    bench_aead(Spec_AEAD_AES256_GCM, "AES256-GCM", i);
+    bench_aead(Spec_Agile_AEAD_AES256_GCM, "AES256-GCM", i);
 
   for(i=4; i<=65536; i<<=1)
-    bench_aead(Spec_AEAD_CHACHA20_POLY1305, "CHA20-P1305", i);
+    bench_aead(Spec_Agile_AEAD_CHACHA20_POLY1305, "CHA20-P1305", i);
 
   for(i=4; i<=65536; i<<=1)
     bench_hash(Spec_Hash_Definitions_SHA2_256, "SHA256", i);
@@ -298,6 +365,8 @@ int main(int argc, char **argv)
   run();
   printf("*** OpenSSL comparison ***\n\n");
   run_openssl();
+  printf("*** QUIC packet protection, %d packets ***\n\n", QUIC_PACKETS);
+  run_quic();
   return 0;
 }
 
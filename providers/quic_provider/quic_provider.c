@@ -13,10 +13,11 @@
 #include "EverCrypt.h"
 #include "quic_provider.h"
 
+// The AEAD key, static IV and packet number nonces are handled by an
+// EverCrypt record object.
 typedef struct quic_key {
   mitls_aead alg;
-  unsigned char key[32];
-  unsigned char static_iv[12];
+  EverCrypt_AEAD_record_s *rec;
   union {
     unsigned char case_chacha20[32];
     EverCrypt_aes128_key case_aes128;
@@ -205,6 +206,12 @@ int MITLS_CALLCONV quic_derive_initial_secrets(quic_secret *client_in, quic_secr
   return 1;
 }
 
+static inline Spec_Agile_AEAD_alg aead_alg(mitls_aead alg)
+{
+  return alg == TLS_aead_AES_128_GCM ? Spec_Agile_AEAD_AES128_GCM :
+    (alg == TLS_aead_AES_256_GCM ? Spec_Agile_AEAD_AES256_GCM : Spec_Agile_AEAD_CHACHA20_POLY1305);
+}
+
 int MITLS_CALLCONV quic_crypto_derive_key(quic_key **k, const quic_secret *secret)
 {
   quic_key *key = KRML_HOST_MALLOC(sizeof(quic_key));
@@ -215,17 +222,18 @@ int MITLS_CALLCONV quic_crypto_derive_key(quic_key **k, const quic_secret *secre
   uint32_t slen = (secret->hash == TLS_hash_SHA256 ? 32 : (secret->hash == TLS_hash_SHA384 ? 48 : 64));
 
   unsigned char info[259] = {0};
+  unsigned char aead_key[32], static_iv[12];
   unsigned char pnkey[32];
   size_t info_len;
 
   if(!quic_crypto_hkdf_label(secret->hash, info, &info_len, "key", klen))
     return 0;
-  if(!quic_crypto_hkdf_expand(secret->hash, key->key, klen, (uint8_t *) secret->secret, slen, info, info_len))
+  if(!quic_crypto_hkdf_expand(secret->hash, aead_key, klen, (uint8_t *) secret->secret, slen, info, info_len))
     return 0;
 
   if(!quic_crypto_hkdf_label(secret->hash, info, &info_len, "iv", 12))
     return 0;
-  if(!quic_crypto_hkdf_expand(secret->hash, key->static_iv, 12, (uint8_t *) secret->secret, slen, info, info_len))
+  if(!quic_crypto_hkdf_expand(secret->hash, static_iv, 12, (uint8_t *) secret->secret, slen, info, info_len))
     return 0;
 
   if(!quic_crypto_hkdf_label(secret->hash, info, &info_len, "pn", klen))
@@ -234,11 +242,14 @@ int MITLS_CALLCONV quic_crypto_derive_key(quic_key **k, const quic_secret *secre
     return 0;
 
 #if DEBUG
-   printf("KEY: "); dump(key->key, klen);
-   printf("IV: "); dump(key->static_iv, 12);
+   printf("KEY: "); dump(aead_key, klen);
+   printf("IV: "); dump(static_iv, 12);
    printf("PNE: "); dump(pnkey, klen);
 #endif
 
+   if(EverCrypt_AEAD_record_create_in(aead_alg(key->alg), &key->rec, aead_key, static_iv) != EverCrypt_Error_Success)
+     return 0;
+
    if(key->alg == TLS_aead_AES_128_GCM)
    {
      key->pne.case_aes128 = EverCrypt_aes128_create(pnkey);
@@ -256,21 +267,17 @@ int MITLS_CALLCONV quic_crypto_derive_key(quic_key **k, const quic_secret *secre
   return 1;
 }
 
-static inline void sn_to_iv(unsigned char *iv, uint64_t sn)
-{
-  for(int i = 4; i < 12; i++)
-    iv[i] ^= (sn >> (88-(i<<3))) & 255;
-}
-
 int MITLS_CALLCONV quic_crypto_create(quic_key **key, mitls_aead alg, const unsigned char *raw_key, const unsigned char *iv, const unsigned char *pne_key)
 {
   quic_key *k = KRML_HOST_MALLOC(sizeof(quic_key));
   if(!k) return 0;
-  uint32_t klen = (alg == TLS_aead_AES_128_GCM ? 16 : 32);
 
   k->alg = alg;
-  memcpy(k->key, raw_key, klen);
-  memcpy(k->static_iv, iv, 12);
+  if(EverCrypt_AEAD_record_create_in(aead_alg(alg), &k->rec, (uint8_t*)raw_key, (uint8_t*)iv) != EverCrypt_Error_Success)
+  {
+    KRML_HOST_FREE(k);
+    return 0;
+  }
 
   if(alg == TLS_aead_AES_128_GCM)
     k->pne.case_aes128 = EverCrypt_aes128_create((uint8_t*)pne_key);
@@ -286,68 +293,33 @@ int MITLS_CALLCONV quic_crypto_create(quic_key **key, mitls_aead alg, const unsi
 int MITLS_CALLCONV quic_crypto_encrypt(quic_key *key, unsigned char *cipher, uint64_t sn,
   const unsigned char *ad, uint32_t ad_len, const unsigned char *plain, uint32_t plain_len)
 {
-  unsigned char iv[12];
-  memcpy(iv, key->static_iv, 12);
-  sn_to_iv(iv, sn);
-
-  if(key->alg == TLS_aead_AES_128_GCM)
-  {
-    EverCrypt_aes128_gcm_encrypt(key->key, iv, (uint8_t*)ad, ad_len, (uint8_t*)plain, plain_len, cipher, (cipher+plain_len));
-  }
-  else if(key->alg == TLS_aead_AES_256_GCM)
-  {
-    EverCrypt_aes256_gcm_encrypt(key->key, iv, (uint8_t*)ad, ad_len, (uint8_t*)plain, plain_len, cipher, (cipher+plain_len));
-  }
-  else if(key->alg == TLS_aead_CHACHA20_POLY1305)
-  {
-    EverCrypt_Chacha20Poly1305_aead_encrypt(key->key, iv, ad_len, (uint8_t*)ad,
-        plain_len, (uint8_t*)plain, cipher, cipher + plain_len);
-  }
+  EverCrypt_Error_error_code r = EverCrypt_AEAD_record_seal_at(key->rec, sn, (uint8_t*)ad, ad_len,
+      (uint8_t*)plain, plain_len, cipher, cipher + plain_len);
 
 #if DEBUG
   printf("ENCRYPT %s\n", key->alg == TLS_aead_AES_128_GCM ? "AES128-GCM" : (key->alg == TLS_aead_AES_256_GCM ? "AES256-GCM" : "CHACHA20-POLY1305"));
-  printf("KEY="); dump(key->key, key->alg == TLS_aead_AES_128_GCM ? 16 : 32);
-  printf("NONCE="); dump(iv, 12);
-  printf("STATIC="); dump(key->static_iv, 12);
+  printf("SN=%llx\n", (unsigned long long)sn);
   printf("AD="); dump(ad, ad_len);
   printf("PLAIN="); dump(plain, plain_len);
   printf("CIPHER="); dump(cipher, plain_len + 16);
 #endif
 
-  return 1;
+  return r == EverCrypt_Error_Success;
 }
 
 int MITLS_CALLCONV quic_crypto_decrypt(quic_key *key, unsigned char *plain, uint64_t sn,
   const unsigned char *ad, uint32_t ad_len, const unsigned char *cipher, uint32_t cipher_len)
 {
-  unsigned char iv[12];
-  memcpy(iv, key->static_iv, 12);
-  sn_to_iv(iv, sn);
-
   if(cipher_len < quic_crypto_tag_length(key))
     return 0;
 
-  uint32_t r = 0, plain_len = cipher_len - quic_crypto_tag_length(key);
-
-  if(key->alg == TLS_aead_AES_128_GCM)
-  {
-    r = EverCrypt_aes128_gcm_decrypt(key->key, iv, (uint8_t*)ad, ad_len, plain, plain_len, (uint8_t*)cipher, (uint8_t*)(cipher+plain_len));
-  }
-  else if(key->alg == TLS_aead_AES_256_GCM)
-  {
-    r = EverCrypt_aes256_gcm_decrypt(key->key, iv, (uint8_t*)ad, ad_len, plain, plain_len, (uint8_t*)cipher, (uint8_t*)(cipher+plain_len));
-  }
-  else if(key->alg == TLS_aead_CHACHA20_POLY1305)
-  {
-    r = 1 - EverCrypt_Chacha20Poly1305_aead_decrypt(key->key, iv, ad_len, (uint8_t*)ad,
-        plain_len, (uint8_t*)plain, cipher, (uint8_t*)(cipher+plain_len));
-  }
+  uint32_t plain_len = cipher_len - quic_crypto_tag_length(key);
+  int r = EverCrypt_AEAD_record_open_at(key->rec, sn, (uint8_t*)ad, ad_len, (uint8_t*)cipher,
+      plain_len, (uint8_t*)cipher + plain_len, plain) == EverCrypt_Error_Success;
 
 #if DEBUG
   printf("DECRYPT %X->%X %s\n", cipher, plain, r?"OK":"BAD");
-  printf("KEY="); dump(key->key, key->alg == TLS_aead_AES_128_GCM ? 16 : 32);
-  printf("NONCE="); dump(iv, 12);
-  printf("STATIC="); dump(key->static_iv, 12);
+  printf("SN=%llx\n", (unsigned long long)sn);
   printf("AD="); dump(ad, ad_len);
   printf("CIPHER="); dump(cipher, cipher_len);
   printf("PLAIN="); dump(plain, plain_len);
@@ -386,6 +358,124 @@ int MITLS_CALLCONV quic_crypto_hp_mask(quic_key *key, const unsigned char *sampl
   return 0;
 }
 
+// Batches are processed in groups of at most BATCH packets, which bounds
+// the nonces and pointer arrays kept on the stack.
+#define BATCH 32
+
+int MITLS_CALLCONV quic_crypto_hp_mask_batch(quic_key *key, uint32_t n, const unsigned char **sample, unsigned char *mask)
+{
+  if(key->alg == TLS_aead_CHACHA20_POLY1305)
+  {
+    uint8_t zero[5] = {0};
+    uint32_t len[BATCH], ctr[BATCH];
+    uint8_t *dst[BATCH], *src[BATCH], *k[BATCH], *iv[BATCH];
+
+    for(uint32_t i = 0; i < n; i += BATCH)
+    {
+      uint32_t m = n - i < BATCH ? n - i : BATCH;
+      for(uint32_t j = 0; j < m; j++)
+      {
+        const unsigned char *s = sample[i+j];
+        len[j] = 5;
+        dst[j] = mask + 5 * (i+j);
+        src[j] = zero;
+        k[j] = key->pne.case_chacha20;
+        iv[j] = (uint8_t*)s + 4;
+        ctr[j] = s[0] + (s[1] << 8) + (s[2] << 16) + ((uint32_t)s[3] << 24);
+      }
+      EverCrypt_Cipher_chacha20_multi(m, len, dst, src, k, iv, ctr);
+    }
+    return 1;
+  }
+
+  // AES: the header protection key is expanded once, in quic_key, and
+  // each mask is a single block.
+  for(uint32_t i = 0; i < n; i++)
+    if(!quic_crypto_hp_mask(key, sample[i], mask + 5 * i))
+      return 0;
+  return 1;
+}
+
+int MITLS_CALLCONV quic_crypto_encrypt_batch(quic_key *key, uint32_t n, unsigned char **cipher,
+  const uint64_t *sn, const unsigned char **ad, const uint32_t *ad_len,
+  const unsigned char **plain, const uint32_t *plain_len, const uint32_t *hp_offset, unsigned char *mask)
+{
+  if(hp_offset != NULL)
+    for(uint32_t i = 0; i < n; i++)
+      if(hp_offset[i] > plain_len[i])
+        return 0;
+
+  uint8_t *tag[BATCH];
+  for(uint32_t i = 0; i < n; i += BATCH)
+  {
+    uint32_t m = n - i < BATCH ? n - i : BATCH;
+    for(uint32_t j = 0; j < m; j++)
+      tag[j] = cipher[i+j] + plain_len[i+j];
+    if(EverCrypt_AEAD_record_seal_multi(key->rec, m, (uint64_t*)sn + i, (uint8_t**)ad + i,
+        (uint32_t*)ad_len + i, (uint8_t**)plain + i, (uint32_t*)plain_len + i, cipher + i, tag)
+        != EverCrypt_Error_Success)
+      return 0;
+  }
+
+  if(hp_offset != NULL)
+  {
+    const unsigned char *sample[BATCH];
+    for(uint32_t i = 0; i < n; i += BATCH)
+    {
+      uint32_t m = n - i < BATCH ? n - i : BATCH;
+      for(uint32_t j = 0; j < m; j++)
+        sample[j] = cipher[i+j] + hp_offset[i+j];
+      if(!quic_crypto_hp_mask_batch(key, m, sample, mask + 5 * i))
+        return 0;
+    }
+  }
+
+  return 1;
+}
+
+int MITLS_CALLCONV quic_crypto_decrypt_batch(quic_key *key, uint32_t n, unsigned char **plain,
+  const uint64_t *sn, const unsigned char **ad, const uint32_t *ad_len,
+  const unsigned char **cipher, const uint32_t *cipher_len, int *ok)
+{
+  int r = 1;
+  uint64_t seq[BATCH];
+  uint8_t *p[BATCH], *c[BATCH], *a[BATCH], *tag[BATCH];
+  uint32_t alen[BATCH], plen[BATCH], idx[BATCH];
+  EverCrypt_Error_error_code res[BATCH];
+
+  for(uint32_t i = 0; i < n; i += BATCH)
+  {
+    uint32_t m = 0;
+    for(uint32_t j = 0; j < BATCH && i + j < n; j++)
+    {
+      // Packets too short to hold a tag are rejected up front
+      if(cipher_len[i+j] < quic_crypto_tag_length(key))
+      {
+        if(ok != NULL) ok[i+j] = 0;
+        r = 0;
+        continue;
+      }
+      seq[m] = sn[i+j];
+      a[m] = (uint8_t*)ad[i+j];
+      alen[m] = ad_len[i+j];
+      plen[m] = cipher_len[i+j] - quic_crypto_tag_length(key);
+      p[m] = plain[i+j];
+      c[m] = (uint8_t*)cipher[i+j];
+      tag[m] = c[m] + plen[m];
+      idx[m] = i + j;
+      m++;
+    }
+    EverCrypt_AEAD_record_open_multi(key->rec, m, seq, a, alen, c, plen, tag, p, res);
+    for(uint32_t j = 0; j < m; j++)
+    {
+      if(ok != NULL) ok[idx[j]] = res[j] == EverCrypt_Error_Success;
+      r &= res[j] == EverCrypt_Error_Success;
+    }
+  }
+
+  return r;
+}
+
 int MITLS_CALLCONV quic_crypto_free_key(quic_key *key)
 {
   if(key != NULL)
@@ -394,6 +484,7 @@ int MITLS_CALLCONV quic_crypto_free_key(quic_key *key)
       EverCrypt_aes128_free(key->pne.case_aes128);
     if(key->alg == TLS_aead_AES_256_GCM)
       EverCrypt_aes256_free(key->pne.case_aes256);
+    EverCrypt_AEAD_record_free(key->rec);
     KRML_HOST_FREE(key);
   }
   return 1;
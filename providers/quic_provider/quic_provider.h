@@ -73,6 +73,29 @@ int MITLS_CALLCONV quic_crypto_decrypt(quic_key *key, /*out*/ unsigned char *pla
 // 5 bytes will be written to *mask
 int MITLS_CALLCONV quic_crypto_hp_mask(quic_key *key, const unsigned char *sample, unsigned char *mask);
 
+// Batch versions of quic_crypto_encrypt and quic_crypto_decrypt, for n
+// packets protected with the same key. Packet i has counter sn[i] and
+// additional data ad[i] (ad_len[i] bytes); its payload is plain[i]
+// (plain_len[i] bytes) when encrypting and cipher[i] (cipher_len[i]
+// bytes) when decrypting. ChaCha20-Poly1305 packets are processed
+// several at a time, one per vector lane.
+//
+// If hp_offset is not NULL, quic_crypto_encrypt_batch also computes the
+// header protection mask of each packet from the 16-byte sample at
+// offset hp_offset[i] of cipher[i], which must not exceed plain_len[i],
+// and writes it to mask + 5*i. All masks are computed in one pass once
+// the packets are encrypted.
+int MITLS_CALLCONV quic_crypto_encrypt_batch(quic_key *key, uint32_t n, /*out*/ unsigned char **cipher, const uint64_t *sn, const unsigned char **ad, const uint32_t *ad_len, const unsigned char **plain, const uint32_t *plain_len, const uint32_t *hp_offset, /*out*/ unsigned char *mask);
+
+// Returns 1 if all packets are authentic. Otherwise returns 0, and if ok
+// is not NULL, ok[i] tells whether packet i was; the payload of a packet
+// that fails to authenticate is not released.
+int MITLS_CALLCONV quic_crypto_decrypt_batch(quic_key *key, uint32_t n, /*out*/ unsigned char **plain, const uint64_t *sn, const unsigned char **ad, const uint32_t *ad_len, const unsigned char **cipher, const uint32_t *cipher_len, /*out*/ int *ok);
+
+// Computes the header protection masks of n packets in one pass; each
+// sample[i] points to 16 bytes, and 5 bytes are written to mask + 5*i.
+int MITLS_CALLCONV quic_crypto_hp_mask_batch(quic_key *key, uint32_t n, const unsigned char **sample, /*out*/ unsigned char *mask);
+
 // Keys allocated by quic_crypto_derive_key and quic_crypto_create must be freed
 int MITLS_CALLCONV quic_crypto_free_key(quic_key *key);
 
@@ -481,6 +481,88 @@ void test_crypto(const quic_secret *secret, const unsigned char *expected_cipher
     printf("PASS\n");
 }
 
+#define BATCH_PACKETS 41
+#define BATCH_MAX_LEN 1300
+
+// Protects a batch of packets of various sizes with the batch functions and
+// compares with the one-packet functions; then forges one packet and checks
+// that only this packet is rejected.
+void test_batch(const quic_secret *secret)
+{
+    quic_key *key;
+    unsigned char *buf = malloc(BATCH_PACKETS * BATCH_MAX_LEN);
+    unsigned char *cbuf = malloc(BATCH_PACKETS * (BATCH_MAX_LEN + 16));
+    unsigned char *dbuf = malloc(BATCH_PACKETS * BATCH_MAX_LEN);
+    unsigned char hdr[BATCH_PACKETS][21];
+    unsigned char expected[BATCH_MAX_LEN + 16], mask[5 * BATCH_PACKETS], expected_mask[5];
+    unsigned char *pkt_cipher[BATCH_PACKETS], *decrypted[BATCH_PACKETS];
+    const unsigned char *pkt_ad[BATCH_PACKETS], *pkt_plain[BATCH_PACKETS], *pkt_cipher_in[BATCH_PACKETS];
+    uint32_t pkt_ad_len[BATCH_PACKETS], pkt_plain_len[BATCH_PACKETS], pkt_cipher_len[BATCH_PACKETS], pkt_hp_offset[BATCH_PACKETS];
+    uint64_t pkt_sn[BATCH_PACKETS];
+    int ok[BATCH_PACKETS];
+
+    printf("==== test_batch(%s,%s) ====\n",
+        hash_to_name[secret->hash], aead_to_name[secret->ae]);
+
+    if (!quic_crypto_derive_key(&key, secret)) {
+        printf("FAIL: quic_crypto_derive_key failed\n");
+        exit(1);
+    }
+
+    for (uint32_t i = 0; i < BATCH_PACKETS * BATCH_MAX_LEN; i++)
+        buf[i] = (unsigned char)(i * 17 + 3);
+    for (uint32_t i = 0; i < BATCH_PACKETS; i++) {
+        for (uint32_t j = 0; j < sizeof(hdr[i]); j++)
+            hdr[i][j] = (unsigned char)(i + j);
+        pkt_sn[i] = 0x1000 + i * 3;
+        pkt_ad[i] = hdr[i];
+        pkt_ad_len[i] = 1 + i % 21;
+        pkt_plain[i] = buf + i * BATCH_MAX_LEN;
+        pkt_plain_len[i] = i % 4 == 0 ? BATCH_MAX_LEN - 100 : (i * 97) % (BATCH_MAX_LEN - 16) + 16;
+        pkt_hp_offset[i] = i % 4;
+        pkt_cipher[i] = cbuf + i * (BATCH_MAX_LEN + 16);
+        pkt_cipher_in[i] = pkt_cipher[i];
+        pkt_cipher_len[i] = pkt_plain_len[i] + 16;
+        decrypted[i] = dbuf + i * BATCH_MAX_LEN;
+    }
+
+    if (!quic_crypto_encrypt_batch(key, BATCH_PACKETS, pkt_cipher, pkt_sn, pkt_ad, pkt_ad_len, pkt_plain, pkt_plain_len, pkt_hp_offset, mask)) {
+        printf("FAIL: quic_crypto_encrypt_batch failed\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i < BATCH_PACKETS; i++) {
+        quic_crypto_encrypt(key, expected, pkt_sn[i], pkt_ad[i], pkt_ad_len[i], pkt_plain[i], pkt_plain_len[i]);
+        check_result("quic_crypto_encrypt_batch", pkt_cipher[i], expected, pkt_cipher_len[i]);
+        quic_crypto_hp_mask(key, pkt_cipher[i] + pkt_hp_offset[i], expected_mask);
+        check_result("quic_crypto_encrypt_batch mask", mask + 5 * i, expected_mask, 5);
+    }
+
+    if (!quic_crypto_decrypt_batch(key, BATCH_PACKETS, decrypted, pkt_sn, pkt_ad, pkt_ad_len, pkt_cipher_in, pkt_cipher_len, ok)) {
+        printf("FAIL: quic_crypto_decrypt_batch failed\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i < BATCH_PACKETS; i++)
+        check_result("quic_crypto_decrypt_batch", decrypted[i], pkt_plain[i], pkt_plain_len[i]);
+
+    pkt_cipher[7][3] ^= 1;
+    if (quic_crypto_decrypt_batch(key, BATCH_PACKETS, decrypted, pkt_sn, pkt_ad, pkt_ad_len, pkt_cipher_in, pkt_cipher_len, ok)) {
+        printf("FAIL: quic_crypto_decrypt_batch accepted a forged packet\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i < BATCH_PACKETS; i++) {
+        if (ok[i] != (i != 7)) {
+            printf("FAIL: quic_crypto_decrypt_batch result %u\n", i);
+            exit(1);
+        }
+    }
+
+    quic_crypto_free_key(key);
+    free(buf);
+    free(cbuf);
+    free(dbuf);
+    printf("PASS\n");
+}
+
 const uint8_t expected_client_hs[] =  { // client_hs (draft 19)
 0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfe,0xf5,0x2b,0x9b,0x3a,0xe4,0x67,0x7a,
 0x63,0x67,0xa7,0x74,0x12,0xb1,0x9d,0xdb,0xf1,0x54,0xc9,0xa2,0x55,0xea,0xf8,0x77,
@@ -592,6 +674,7 @@ void exhaustive(void)
         secret.ae = testcombinations[i].ae;
 
         test_crypto(&secret, testcombinations[i].expected_cipher);
+        test_batch(&secret);
     }
 
     test_pn_encrypt();
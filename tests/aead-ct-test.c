@@ -0,0 +1,170 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "EverCrypt_AEAD.h"
+#include "EverCrypt_AutoConfig2.h"
+
+#include "test_helpers.h"
+
+#define MAX_LEN (5 << 20)
+#define NCASES  16
+
+static uint8_t key[32] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+static Spec_Agile_AEAD_alg algs[] = { Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM };
+
+static uint32_t lens[NCASES] = {
+  0, 1, 15, 16, 17, 63, 64, 65, 255, 256, 257, 1000, 4097, 65536, 70001, MAX_LEN - 5
+};
+
+static uint8_t *plain, *ad, *exp_cipher[2][NCASES], exp_tag[2][NCASES][16];
+
+static uint32_t iv_len_of(uint32_t c) {
+  return c % 3 == 2 ? 1 + c * 5 % 63 : 12;
+}
+
+static uint32_t ad_len_of(uint32_t c) {
+  return c * 37 % 300;
+}
+
+// Records the output of the default implementation, i.e. AES-NI and PCLMULQDQ
+// when available, for all test cases.
+static void record(void) {
+  uint8_t iv[64];
+  for (uint32_t i = 0; i < sizeof iv; i++)
+    iv[i] = (uint8_t)(i + 1);
+  for (uint32_t a = 0; a < 2; a++) {
+    EverCrypt_AEAD_state_s *s;
+    EverCrypt_AEAD_create_in(algs[a], &s, key);
+    for (uint32_t c = 0; c < NCASES; c++) {
+      exp_cipher[a][c] = malloc(lens[c] + 1);
+      EverCrypt_AEAD_encrypt(s, iv, iv_len_of(c), ad, ad_len_of(c), plain, lens[c],
+        exp_cipher[a][c], exp_tag[a][c]);
+    }
+    EverCrypt_AEAD_free(s);
+  }
+}
+
+// Runs all entry points of the bitsliced implementation against the recorded
+// outputs.
+static bool test_all(const char *name) {
+  uint8_t iv[64], tag[16];
+  uint8_t *out = malloc(MAX_LEN), *dec = malloc(MAX_LEN);
+  for (uint32_t i = 0; i < sizeof iv; i++)
+    iv[i] = (uint8_t)(i + 1);
+
+  bool ok = true;
+  for (uint32_t a = 0; a < 2; a++) {
+    EverCrypt_AEAD_state_s *s;
+    ok &= EverCrypt_AEAD_create_in(algs[a], &s, key) == EverCrypt_Error_Success;
+    EverCrypt_AEAD_stream_s *st;
+    ok &= EverCrypt_AEAD_stream_create_in(s, &st) == EverCrypt_Error_Success;
+    for (uint32_t c = 0; c < NCASES; c++) {
+      uint32_t len = lens[c], iv_len = iv_len_of(c), ad_len = ad_len_of(c);
+      uint8_t *exp = exp_cipher[a][c];
+
+      bool ok1 =
+        EverCrypt_AEAD_encrypt(s, iv, iv_len, ad, ad_len, plain, len, out, tag) ==
+          EverCrypt_Error_Success &&
+        memcmp(out, exp, len) == 0 && memcmp(tag, exp_tag[a][c], 16) == 0;
+      ok1 = ok1 &&
+        EverCrypt_AEAD_decrypt(s, iv, iv_len, ad, ad_len, exp, len, exp_tag[a][c], dec) ==
+          EverCrypt_Error_Success &&
+        memcmp(dec, plain, len) == 0;
+
+      memset(out, 0, len);
+      if (a == 0)
+        EverCrypt_AEAD_encrypt_expand_aes128_gcm(key, iv, iv_len, ad, ad_len, plain, len, out,
+          tag);
+      else
+        EverCrypt_AEAD_encrypt_expand_aes256_gcm(key, iv, iv_len, ad, ad_len, plain, len, out,
+          tag);
+      ok1 = ok1 && memcmp(out, exp, len) == 0 && memcmp(tag, exp_tag[a][c], 16) == 0;
+
+      // The stream, in chunks of 1000 bytes, i.e. ending in partial blocks.
+      memset(out, 0, len);
+      EverCrypt_AEAD_stream_init(st, iv, iv_len, ad, ad_len);
+      for (uint32_t off = 0; off < len; off += 1000) {
+        uint32_t k = len - off < 1000 ? len - off : 1000;
+        EverCrypt_AEAD_stream_encrypt_update(st, plain + off, k, out + off);
+      }
+      EverCrypt_AEAD_stream_encrypt_finish(st, tag);
+      ok1 = ok1 && memcmp(out, exp, len) == 0 && memcmp(tag, exp_tag[a][c], 16) == 0;
+
+      memset(out, 0, len);
+      ok1 = ok1 &&
+        EverCrypt_AEAD_encrypt_par(s, iv, iv_len, ad, ad_len, plain, len, out, tag, 3) ==
+          EverCrypt_Error_Success &&
+        memcmp(out, exp, len) == 0 && memcmp(tag, exp_tag[a][c], 16) == 0;
+
+      tag[c % 16] ^= 1;
+      ok1 = ok1 &&
+        EverCrypt_AEAD_decrypt(s, iv, iv_len, ad, ad_len, exp, len, tag, dec) ==
+          EverCrypt_Error_AuthenticationFailure;
+      if (!ok1)
+        printf("alg %d, iv_len %" PRIu32 ", ad_len %" PRIu32 ", len %" PRIu32 ": **FAILED**\n",
+          algs[a], iv_len, ad_len, len);
+      ok &= ok1;
+    }
+    EverCrypt_AEAD_stream_free(st);
+    EverCrypt_AEAD_free(s);
+  }
+  printf("AEAD bitsliced AES-GCM (%s): %s\n", name, ok ? "Success!" : "**FAILED**");
+  free(out);
+  free(dec);
+  return ok;
+}
+
+static void bench(Spec_Agile_AEAD_alg a, const char *name, uint32_t len) {
+  EverCrypt_AEAD_state_s *s;
+  if (EverCrypt_AEAD_create_in(a, &s, key) != EverCrypt_Error_Success)
+    return;
+  uint8_t *out = malloc(len);
+  uint8_t iv[12] = { 0 }, tag[16];
+
+  cycles c0, c1;
+  clock_t t1, t2;
+  t1 = clock();
+  c0 = cpucycles_begin();
+  EverCrypt_AEAD_encrypt(s, iv, 12, NULL, 0, plain, len, out, tag);
+  c1 = cpucycles_end();
+  t2 = clock();
+  printf("%s PERF:\n", name);
+  print_time(len, t2 - t1, c1 - c0);
+  EverCrypt_AEAD_free(s);
+  free(out);
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+
+  plain = malloc(MAX_LEN);
+  ad = malloc(300);
+  for (uint32_t i = 0; i < MAX_LEN; i++)
+    plain[i] = (uint8_t)(i * 7 + 5);
+  for (uint32_t i = 0; i < 300; i++)
+    ad[i] = (uint8_t)(i * 3 + 1);
+  record();
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM, AES-NI", MAX_LEN);
+
+  EverCrypt_AutoConfig2_disable_aesni();
+  EverCrypt_AutoConfig2_disable_pclmulqdq();
+  bool ok = test_all("avx2");
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM, bitsliced, avx2", MAX_LEN);
+  EverCrypt_AutoConfig2_disable_avx2();
+  ok &= test_all("avx");
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM, bitsliced, avx", MAX_LEN);
+  EverCrypt_AutoConfig2_disable_avx();
+  ok &= test_all("portable");
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM, bitsliced, portable", MAX_LEN);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
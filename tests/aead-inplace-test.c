@@ -0,0 +1,145 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "EverCrypt_AEAD.h"
+#include "EverCrypt_AutoConfig2.h"
+
+#include "test_helpers.h"
+
+#define NKEYS 4
+#define LEN   1200
+
+static Spec_Agile_AEAD_alg algs[] = {
+  Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM, Spec_Agile_AEAD_CHACHA20_POLY1305
+};
+
+// Keys are loaded in turn into the same memory, and each state is compared
+// with one from EverCrypt_AEAD_create_in, in both directions.
+static bool test_all(const char *name) {
+  uint8_t keys[NKEYS][32], iv[12] = { 3 }, ad[21], plain[LEN], exp[LEN], out[LEN], dec[LEN];
+  uint8_t exp_tag[16], tag[16];
+  for (uint32_t i = 0; i < NKEYS * 32; i++)
+    keys[i / 32][i % 32] = (uint8_t)(i * 11 + 7);
+  for (uint32_t i = 0; i < sizeof ad; i++)
+    ad[i] = (uint8_t)(i * 3 + 1);
+  for (uint32_t i = 0; i < LEN; i++)
+    plain[i] = (uint8_t)(i * 7 + 5);
+
+  bool ok = true;
+  for (uint32_t a = 0; a < 3; a++) {
+    uint32_t size = EverCrypt_AEAD_state_size(algs[a]);
+    uint8_t *mem = aligned_alloc(16, (size + 15) & ~15U);
+    for (uint32_t k = 0; k < NKEYS; k++) {
+      EverCrypt_AEAD_state_s *s, *p;
+      EverCrypt_AEAD_create_in(algs[a], &s, keys[k]);
+      memset(mem, 0xa5, size);
+      bool ok1 =
+        EverCrypt_AEAD_init_in_place(algs[a], mem, keys[k], &p) == EverCrypt_Error_Success &&
+        (uint8_t *)p == mem && EverCrypt_AEAD_alg_of_state(p) == algs[a];
+      for (uint32_t len = 0; ok1 && len <= LEN; len += 199) {
+        EverCrypt_AEAD_encrypt(s, iv, 12, ad, len % sizeof ad, plain, len, exp, exp_tag);
+        ok1 =
+          EverCrypt_AEAD_encrypt(p, iv, 12, ad, len % sizeof ad, plain, len, out, tag) ==
+            EverCrypt_Error_Success &&
+          memcmp(out, exp, len) == 0 && memcmp(tag, exp_tag, 16) == 0;
+        ok1 = ok1 &&
+          EverCrypt_AEAD_decrypt(p, iv, 12, ad, len % sizeof ad, out, len, tag, dec) ==
+            EverCrypt_Error_Success &&
+          memcmp(dec, plain, len) == 0;
+        tag[len % 16] ^= 1;
+        ok1 = ok1 &&
+          EverCrypt_AEAD_decrypt(p, iv, 12, ad, len % sizeof ad, out, len, tag, dec) ==
+            EverCrypt_Error_AuthenticationFailure;
+      }
+      if (!ok1)
+        printf("alg %d, key %" PRIu32 ": **FAILED**\n", algs[a], k);
+      ok &= ok1;
+      EverCrypt_AEAD_free(s);
+    }
+    free(mem);
+  }
+  printf("AEAD in place (%s): %s\n", name, ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+static void bench(Spec_Agile_AEAD_alg a, const char *name) {
+  uint32_t rounds = 100000;
+  uint8_t key[32] = { 1 }, iv[12] = { 0 }, plain[LEN], out[LEN], tag[16];
+  uint8_t *mem = aligned_alloc(16, (EverCrypt_AEAD_state_size(a) + 15) & ~15U);
+  memset(plain, 'P', LEN);
+
+  cycles c0, c1, c2, c3;
+  clock_t t0, t1, t2, t3;
+  t0 = clock();
+  c0 = cpucycles_begin();
+  for (uint32_t r = 0; r < rounds; r++) {
+    EverCrypt_AEAD_state_s *s;
+    key[0] = (uint8_t)r;
+    EverCrypt_AEAD_create_in(a, &s, key);
+    EverCrypt_AEAD_encrypt(s, iv, 12, NULL, 0, plain, LEN, out, tag);
+    EverCrypt_AEAD_free(s);
+  }
+  c1 = cpucycles_end();
+  t1 = clock();
+  t2 = clock();
+  c2 = cpucycles_begin();
+  for (uint32_t r = 0; r < rounds; r++) {
+    EverCrypt_AEAD_state_s *s;
+    key[0] = (uint8_t)r;
+    EverCrypt_AEAD_init_in_place(a, mem, key, &s);
+    EverCrypt_AEAD_encrypt(s, iv, 12, NULL, 0, plain, LEN, out, tag);
+  }
+  c3 = cpucycles_end();
+  t3 = clock();
+  uint64_t count = (uint64_t)rounds * LEN;
+  printf("%s, new key per %d-byte packet, create_in + free PERF:\n", name, LEN);
+  print_time(count, t1 - t0, c1 - c0);
+  printf("%s, new key per %d-byte packet, init_in_place PERF:\n", name, LEN);
+  print_time(count, t3 - t2, c3 - c2);
+  free(mem);
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+
+  bool ok = EverCrypt_AEAD_state_size(Spec_Agile_AEAD_AES128_CCM) == 0;
+  EverCrypt_AEAD_state_s *s;
+  uint8_t mem[1024], key[32] = { 0 };
+  ok &= EverCrypt_AEAD_init_in_place(Spec_Agile_AEAD_AES128_CCM, mem, key, &s) ==
+    EverCrypt_Error_UnsupportedAlgorithm;
+
+  // Misaligned memory is rejected before anything is written to it.
+  uint8_t *aligned = aligned_alloc(16, 1024);
+  for (uint32_t a = 0; a < 3; a++)
+    for (uint32_t off = 1; off < 16; off += 7) {
+      s = NULL;
+      memset(aligned, 0xa5, 1024);
+      bool ok1 = EverCrypt_AEAD_init_in_place(algs[a], aligned + off, key, &s) ==
+        EverCrypt_Error_InvalidKey && s == NULL;
+      for (uint32_t i = 0; ok1 && i < 1024; i++)
+        ok1 = aligned[i] == 0xa5;
+      if (!ok1)
+        printf("alg %d, misaligned by %" PRIu32 ": **FAILED**\n", algs[a], off);
+      ok &= ok1;
+    }
+  free(aligned);
+
+  ok &= test_all("default");
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM");
+  bench(Spec_Agile_AEAD_CHACHA20_POLY1305, "ChaCha20-Poly1305");
+  EverCrypt_AutoConfig2_disable_aesni();
+  EverCrypt_AutoConfig2_disable_pclmulqdq();
+  ok &= test_all("bitsliced");
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM, bitsliced");
+  EverCrypt_AutoConfig2_disable_avx2();
+  ok &= test_all("bitsliced, no avx2");
+  EverCrypt_AutoConfig2_disable_avx();
+  ok &= test_all("bitsliced, no avx");
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
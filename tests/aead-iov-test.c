@@ -0,0 +1,190 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "EverCrypt_AEAD.h"
+#include "EverCrypt_AutoConfig2.h"
+
+#include "test_helpers.h"
+
+#define MAX_LEN   1500
+#define MAX_FRAGS 64
+#define ROUNDS    4096
+
+static uint8_t key[32] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+static uint32_t seed = 1;
+
+static uint32_t next(uint32_t bound) {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % bound;
+}
+
+// Cuts len bytes at buf into at most MAX_FRAGS fragments of random lengths,
+// including empty ones and ones that end in the middle of a block.
+static uint32_t fragment(uint8_t *buf, uint32_t len, EverCrypt_AEAD_iovec *v) {
+  uint32_t n = 0, off = 0;
+  while (off < len && n < MAX_FRAGS - 1) {
+    uint32_t k = next(4) == 0 ? next(4) : next(len - off + 1);
+    if (k > len - off)
+      k = len - off;
+    v[n].base = buf + off;
+    v[n].len = k;
+    off += k;
+    n++;
+  }
+  v[n].base = buf + off;
+  v[n].len = len - off;
+  return n + 1;
+}
+
+static bool test_one(Spec_Agile_AEAD_alg a, uint32_t iv_len, uint32_t ad_len, uint32_t len,
+  bool in_place)
+{
+  EverCrypt_AEAD_state_s *s;
+  if (EverCrypt_AEAD_create_in(a, &s, key) != EverCrypt_Error_Success)
+    return true;
+
+  uint8_t iv[64], ad[MAX_LEN], plain[MAX_LEN], exp[MAX_LEN], exp_tag[16];
+  uint8_t out[MAX_LEN], dec[MAX_LEN], tag[16];
+  for (uint32_t i = 0; i < iv_len; i++)
+    iv[i] = (uint8_t)(i + 1);
+  for (uint32_t i = 0; i < MAX_LEN; i++) {
+    ad[i] = (uint8_t)(i * 3 + 1);
+    plain[i] = (uint8_t)(i * 7 + 5);
+  }
+  EverCrypt_AEAD_encrypt(s, iv, iv_len, ad, ad_len, plain, len, exp, exp_tag);
+
+  EverCrypt_AEAD_iovec ad_v[MAX_FRAGS], plain_v[MAX_FRAGS], out_v[MAX_FRAGS];
+  uint8_t *out_p[MAX_FRAGS], *dec_p[MAX_FRAGS];
+  uint32_t ad_cnt = fragment(ad, ad_len, ad_v);
+  uint32_t cnt;
+  if (in_place) {
+    memcpy(out, plain, len);
+    cnt = fragment(out, len, plain_v);
+  } else {
+    cnt = fragment(plain, len, plain_v);
+  }
+  // The ciphertext goes to a contiguous buffer, or back to the fragments.
+  uint32_t off = 0;
+  for (uint32_t i = 0; i < cnt; i++) {
+    out_p[i] = in_place ? plain_v[i].base : out + off;
+    off += plain_v[i].len;
+  }
+  EverCrypt_Error_error_code r =
+    EverCrypt_AEAD_encrypt_iov(s, iv, iv_len, ad_v, ad_cnt, plain_v, cnt, out_p, tag);
+  bool ok = r == EverCrypt_Error_Success && memcmp(out, exp, len) == 0 &&
+    memcmp(tag, exp_tag, 16) == 0;
+
+  // Decryption, with a different fragmentation of the ciphertext.
+  cnt = fragment(out, len, out_v);
+  off = 0;
+  for (uint32_t i = 0; i < cnt; i++) {
+    dec_p[i] = dec + off;
+    off += out_v[i].len;
+  }
+  r = EverCrypt_AEAD_decrypt_iov(s, iv, iv_len, ad_v, ad_cnt, out_v, cnt, tag, dec_p);
+  ok = ok && r == EverCrypt_Error_Success && memcmp(dec, plain, len) == 0;
+
+  // A forged tag is rejected, and no plaintext is released.
+  tag[len % 16] ^= 1;
+  memset(dec, 0xff, len);
+  r = EverCrypt_AEAD_decrypt_iov(s, iv, iv_len, ad_v, ad_cnt, out_v, cnt, tag, dec_p);
+  ok = ok && r == EverCrypt_Error_AuthenticationFailure;
+  for (uint32_t i = 0; i < len; i++)
+    ok = ok && dec[i] == 0;
+
+  if (!ok)
+    printf("alg %d, iv_len %" PRIu32 ", ad_len %" PRIu32 ", len %" PRIu32 "%s: **FAILED**\n",
+      a, iv_len, ad_len, len, in_place ? " (in place)" : "");
+  EverCrypt_AEAD_free(s);
+  return ok;
+}
+
+static bool test_all(const char *name) {
+  Spec_Agile_AEAD_alg algs[] = {
+    Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM, Spec_Agile_AEAD_CHACHA20_POLY1305
+  };
+  uint32_t lens[] = { 0, 1, 15, 16, 17, 63, 64, 65, 255, 256, 1024, MAX_LEN };
+  bool ok = true;
+  for (uint32_t a = 0; a < 3; a++)
+    for (uint32_t l = 0; l < sizeof lens / sizeof lens[0]; l++)
+      for (uint32_t r = 0; r < 8; r++) {
+        uint32_t ad_len = r == 0 ? 0 : next(64);
+        ok &= test_one(algs[a], 12, ad_len, lens[l], r % 2 == 1);
+        // GCM also takes IVs of other lengths.
+        if (a < 2)
+          ok &= test_one(algs[a], 1 + next(63), ad_len, lens[l], r % 2 == 0);
+      }
+  printf("AEAD iovec (%s): %s\n", name, ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+// Sealing a record held in n fragments: one call on the fragments, or
+// copying them into a staging buffer first.
+static void bench(Spec_Agile_AEAD_alg a, const char *name, uint32_t len, uint32_t n) {
+  EverCrypt_AEAD_state_s *s;
+  if (EverCrypt_AEAD_create_in(a, &s, key) != EverCrypt_Error_Success)
+    return;
+  uint8_t *frags = malloc(len), *staging = malloc(len), *out = malloc(len);
+  uint8_t iv[12] = { 0 }, ad[13] = { 0 }, tag[16];
+  memset(frags, 'P', len);
+  EverCrypt_AEAD_iovec ad_v[1] = { { ad, 13 } }, v[MAX_FRAGS];
+  uint8_t *out_p[MAX_FRAGS];
+  for (uint32_t i = 0; i < n; i++) {
+    v[i].base = frags + i * (len / n);
+    v[i].len = i == n - 1 ? len - i * (len / n) : len / n;
+    out_p[i] = out + i * (len / n);
+  }
+
+  cycles c0, c1;
+  clock_t t1, t2;
+  uint32_t rounds = ROUNDS * 16 / (len / 1024 + 1);
+  for (int iov = 0; iov < 2; iov++) {
+    t1 = clock();
+    c0 = cpucycles_begin();
+    for (uint32_t r = 0; r < rounds; r++) {
+      if (iov) {
+        EverCrypt_AEAD_encrypt_iov(s, iv, 12, ad_v, 1, v, n, out_p, tag);
+      } else {
+        for (uint32_t i = 0; i < n; i++)
+          memcpy(staging + i * (len / n), v[i].base, v[i].len);
+        EverCrypt_AEAD_encrypt(s, iv, 12, ad, 13, staging, len, out, tag);
+      }
+    }
+    c1 = cpucycles_end();
+    t2 = clock();
+    printf("%s, %" PRIu32 " bytes in %" PRIu32 " fragments, %s PERF:\n", name, len, n,
+      iov ? "encrypt_iov" : "copy + encrypt");
+    print_time((uint64_t)rounds * len, t2 - t1, c1 - c0);
+  }
+  EverCrypt_AEAD_free(s);
+  free(frags);
+  free(staging);
+  free(out);
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+
+  bool ok = test_all("default");
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM", 16384, 11);
+  bench(Spec_Agile_AEAD_AES256_GCM, "AES256-GCM", 16384, 11);
+  bench(Spec_Agile_AEAD_CHACHA20_POLY1305, "ChaCha20-Poly1305", 16384, 11);
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM", 1500, 3);
+  bench(Spec_Agile_AEAD_CHACHA20_POLY1305, "ChaCha20-Poly1305", 1500, 3);
+
+  EverCrypt_AutoConfig2_disable_avx2();
+  ok &= test_all("no avx2");
+  EverCrypt_AutoConfig2_disable_avx();
+  ok &= test_all("no avx");
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
@@ -0,0 +1,111 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "EverCrypt_AEAD.h"
+#include "EverCrypt_AutoConfig2.h"
+
+#include "test_helpers.h"
+
+#define MAX_LEN (37 << 20)
+
+static uint8_t key[32] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+// Compares the parallel functions with the serial ones, for lengths around the
+// segment size and texts that end with a partial block.
+static bool test_all(const char *name) {
+  Spec_Agile_AEAD_alg algs[] = {
+    Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM, Spec_Agile_AEAD_CHACHA20_POLY1305
+  };
+  uint32_t lens[] = { (2 << 20) - 1, 2 << 20, (2 << 20) + 1, (5 << 20) + 17, MAX_LEN - 3 };
+  uint32_t threads[] = { 2, 3, 8 };
+  uint8_t *plain = malloc(MAX_LEN), *exp = malloc(MAX_LEN);
+  uint8_t *out = malloc(MAX_LEN), *dec = malloc(MAX_LEN);
+  uint8_t iv[12] = { 7 }, ad[40], exp_tag[16], tag[16];
+  for (uint32_t i = 0; i < MAX_LEN; i++)
+    plain[i] = (uint8_t)(i * 7 + 5);
+  for (uint32_t i = 0; i < sizeof ad; i++)
+    ad[i] = (uint8_t)(i * 3 + 1);
+
+  bool ok = true;
+  for (uint32_t a = 0; a < 3; a++) {
+    EverCrypt_AEAD_state_s *s;
+    if (EverCrypt_AEAD_create_in(algs[a], &s, key) != EverCrypt_Error_Success)
+      continue;
+    for (uint32_t l = 0; l < sizeof lens / sizeof lens[0]; l++) {
+      uint32_t len = lens[l], ad_len = l * 7 % sizeof ad;
+      EverCrypt_AEAD_encrypt(s, iv, 12, ad, ad_len, plain, len, exp, exp_tag);
+      for (uint32_t t = 0; t < sizeof threads / sizeof threads[0]; t++) {
+        bool ok1 =
+          EverCrypt_AEAD_encrypt_par(s, iv, 12, ad, ad_len, plain, len, out, tag, threads[t]) ==
+            EverCrypt_Error_Success &&
+          memcmp(out, exp, len) == 0 && memcmp(tag, exp_tag, 16) == 0;
+        ok1 = ok1 &&
+          EverCrypt_AEAD_decrypt_par(s, iv, 12, ad, ad_len, out, len, tag, dec, threads[t]) ==
+            EverCrypt_Error_Success &&
+          memcmp(dec, plain, len) == 0;
+        tag[t] ^= 1;
+        ok1 = ok1 &&
+          EverCrypt_AEAD_decrypt_par(s, iv, 12, ad, ad_len, out, len, tag, dec, threads[t]) ==
+            EverCrypt_Error_AuthenticationFailure;
+        if (!ok1)
+          printf("alg %d, len %" PRIu32 ", %" PRIu32 " threads: **FAILED**\n", algs[a], len,
+            threads[t]);
+        ok &= ok1;
+      }
+    }
+    EverCrypt_AEAD_free(s);
+  }
+  printf("AEAD parallel (%s): %s\n", name, ok ? "Success!" : "**FAILED**");
+  free(plain);
+  free(exp);
+  free(out);
+  free(dec);
+  return ok;
+}
+
+static void bench(Spec_Agile_AEAD_alg a, const char *name, uint32_t len, uint32_t nthreads) {
+  EverCrypt_AEAD_state_s *s;
+  if (EverCrypt_AEAD_create_in(a, &s, key) != EverCrypt_Error_Success)
+    return;
+  uint8_t *plain = malloc(len), *out = malloc(len);
+  uint8_t iv[12] = { 0 }, tag[16];
+  memset(plain, 'P', len);
+  memset(out, 0, len);
+
+  cycles c0, c1;
+  clock_t t1, t2;
+  t1 = clock();
+  c0 = cpucycles_begin();
+  EverCrypt_AEAD_encrypt_par(s, iv, 12, NULL, 0, plain, len, out, tag, nthreads);
+  c1 = cpucycles_end();
+  t2 = clock();
+  printf("%s, %" PRIu32 " MB, %" PRIu32 " threads PERF:\n", name, len >> 20, nthreads);
+  print_time(len, t2 - t1, c1 - c0);
+  EverCrypt_AEAD_free(s);
+  free(plain);
+  free(out);
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+
+  bool ok = test_all("default");
+  for (uint32_t t = 1; t <= 8; t *= 2) {
+    bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM", 128 << 20, t);
+    bench(Spec_Agile_AEAD_CHACHA20_POLY1305, "ChaCha20-Poly1305", 128 << 20, t);
+  }
+  EverCrypt_AutoConfig2_disable_avx2();
+  ok &= test_all("no avx2");
+  EverCrypt_AutoConfig2_disable_avx();
+  ok &= test_all("no avx");
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
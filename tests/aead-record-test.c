@@ -0,0 +1,222 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "EverCrypt_AEAD.h"
+#include "EverCrypt_AutoConfig2.h"
+
+#include "test_helpers.h"
+
+#define NRECS   70
+#define MAX_LEN 1500
+
+static uint8_t key[32] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+static uint8_t static_iv[12] = {
+  0x1b, 0x13, 0xdd, 0x9f, 0x8d, 0x8f, 0x17, 0x09, 0x1d, 0x34, 0xb3, 0x49
+};
+
+static Spec_Agile_AEAD_alg algs[] = {
+  Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM, Spec_Agile_AEAD_CHACHA20_POLY1305
+};
+
+// The nonce of record seq, built by hand as TLS 1.3 specifies.
+static void nonce(uint64_t seq, uint8_t *iv) {
+  memcpy(iv, static_iv, 12);
+  for (int i = 0; i < 8; i++)
+    iv[11 - i] ^= (uint8_t)(seq >> (8 * i));
+}
+
+static uint8_t *buf(uint32_t len, uint32_t seed) {
+  uint8_t *b = malloc(len);
+  for (uint32_t i = 0; i < len; i++)
+    b[i] = (uint8_t)(i * 7 + seed);
+  return b;
+}
+
+// Every entry point is compared with EverCrypt_AEAD_encrypt and explicit
+// nonces, with records of all sizes up to an MTU and sequence numbers that
+// carry into the upper bytes.
+static bool test_all(const char *name) {
+  uint64_t seq[NRECS];
+  uint8_t *ad[NRECS], *plain[NRECS], *exp[NRECS], *cipher[NRECS], *dec[NRECS], *tag[NRECS],
+    *exp_tag[NRECS];
+  uint32_t ad_len[NRECS], len[NRECS];
+  EverCrypt_Error_error_code res[NRECS];
+  for (uint32_t i = 0; i < NRECS; i++) {
+    seq[i] = i % 3 == 0 ? 0x0123456789abcdefULL * i : i;
+    ad_len[i] = i * 5 % 22;
+    len[i] = i * 97 % (MAX_LEN + 1);
+    ad[i] = buf(ad_len[i] + 1, i);
+    plain[i] = buf(len[i] + 1, 3 * i);
+    exp[i] = malloc(len[i] + 1);
+    cipher[i] = malloc(len[i] + 1);
+    dec[i] = malloc(len[i] + 1);
+    tag[i] = malloc(16);
+    exp_tag[i] = malloc(16);
+  }
+
+  bool ok = true;
+  for (uint32_t a = 0; a < 3; a++) {
+    EverCrypt_AEAD_state_s *s;
+    EverCrypt_AEAD_record_s *r;
+    EverCrypt_AEAD_create_in(algs[a], &s, key);
+    bool ok1 = EverCrypt_AEAD_record_create_in(algs[a], &r, key, static_iv) ==
+      EverCrypt_Error_Success;
+
+    // seal_next, from 0.
+    for (uint32_t i = 0; i < NRECS; i++) {
+      uint8_t iv[12];
+      nonce(i, iv);
+      EverCrypt_AEAD_encrypt(s, iv, 12, ad[i], ad_len[i], plain[i], len[i], exp[i], exp_tag[i]);
+      ok1 = ok1 && EverCrypt_AEAD_record_next_seq(r) == i &&
+        EverCrypt_AEAD_record_seal_next(r, ad[i], ad_len[i], plain[i], len[i], cipher[i],
+          tag[i]) == EverCrypt_Error_Success &&
+        memcmp(cipher[i], exp[i], len[i]) == 0 && memcmp(tag[i], exp_tag[i], 16) == 0;
+      ok1 = ok1 &&
+        EverCrypt_AEAD_record_open_at(r, i, ad[i], ad_len[i], cipher[i], len[i], tag[i],
+          dec[i]) == EverCrypt_Error_Success &&
+        memcmp(dec[i], plain[i], len[i]) == 0;
+    }
+
+    // seal_multi, taking the next sequence numbers, then open_multi.
+    for (uint32_t i = 0; i < NRECS; i++) {
+      uint8_t iv[12];
+      nonce(NRECS + i, iv);
+      EverCrypt_AEAD_encrypt(s, iv, 12, ad[i], ad_len[i], plain[i], len[i], exp[i], exp_tag[i]);
+      seq[i] = NRECS + i;
+    }
+    ok1 = ok1 &&
+      EverCrypt_AEAD_record_seal_multi(r, NRECS, NULL, ad, ad_len, plain, len, cipher, tag) ==
+        EverCrypt_Error_Success &&
+      EverCrypt_AEAD_record_next_seq(r) == 2 * NRECS;
+    for (uint32_t i = 0; i < NRECS; i++)
+      ok1 = ok1 && memcmp(cipher[i], exp[i], len[i]) == 0 && memcmp(tag[i], exp_tag[i], 16) == 0;
+    ok1 = ok1 &&
+      EverCrypt_AEAD_record_open_multi(r, NRECS, seq, ad, ad_len, cipher, len, tag, dec, res) ==
+        EverCrypt_Error_Success;
+    for (uint32_t i = 0; i < NRECS; i++)
+      ok1 = ok1 && res[i] == EverCrypt_Error_Success && memcmp(dec[i], plain[i], len[i]) == 0;
+
+    // Explicit sequence numbers, out of order and far apart; the counter does
+    // not move.
+    for (uint32_t i = 0; i < NRECS; i++) {
+      uint8_t iv[12];
+      seq[i] = (NRECS - i) * 0x0123456789abcdefULL;
+      nonce(seq[i], iv);
+      EverCrypt_AEAD_encrypt(s, iv, 12, ad[i], ad_len[i], plain[i], len[i], exp[i], exp_tag[i]);
+    }
+    ok1 = ok1 &&
+      EverCrypt_AEAD_record_seal_multi(r, NRECS, seq, ad, ad_len, plain, len, cipher, tag) ==
+        EverCrypt_Error_Success &&
+      EverCrypt_AEAD_record_next_seq(r) == 2 * NRECS;
+    for (uint32_t i = 0; i < NRECS; i++) {
+      ok1 = ok1 && memcmp(cipher[i], exp[i], len[i]) == 0 && memcmp(tag[i], exp_tag[i], 16) == 0;
+      ok1 = ok1 &&
+        EverCrypt_AEAD_record_seal_at(r, seq[i], ad[i], ad_len[i], plain[i], len[i], dec[i],
+          exp_tag[i]) == EverCrypt_Error_Success &&
+        memcmp(dec[i], exp[i], len[i]) == 0 && memcmp(tag[i], exp_tag[i], 16) == 0;
+    }
+
+    // Forgeries and wrong sequence numbers fail their own record only.
+    for (uint32_t i = 0; i < NRECS; i += 4)
+      tag[i][i % 16] ^= 1;
+    seq[1] ^= 1;
+    ok1 = ok1 &&
+      EverCrypt_AEAD_record_open_multi(r, NRECS, seq, ad, ad_len, cipher, len, tag, dec, res) ==
+        EverCrypt_Error_AuthenticationFailure;
+    for (uint32_t i = 0; i < NRECS; i++) {
+      bool bad = i % 4 == 0 || i == 1;
+      ok1 = ok1 && (res[i] == EverCrypt_Error_AuthenticationFailure) == bad;
+      ok1 = ok1 && (bad || memcmp(dec[i], plain[i], len[i]) == 0);
+      ok1 = ok1 &&
+        (EverCrypt_AEAD_record_open_at(r, seq[i], ad[i], ad_len[i], cipher[i], len[i], tag[i],
+          dec[i]) == EverCrypt_Error_AuthenticationFailure) == bad;
+    }
+
+    if (!ok1)
+      printf("alg %d: **FAILED**\n", algs[a]);
+    ok &= ok1;
+    EverCrypt_AEAD_record_free(r);
+    EverCrypt_AEAD_free(s);
+  }
+  printf("AEAD record (%s): %s\n", name, ok ? "Success!" : "**FAILED**");
+  for (uint32_t i = 0; i < NRECS; i++) {
+    free(ad[i]);
+    free(plain[i]);
+    free(exp[i]);
+    free(cipher[i]);
+    free(dec[i]);
+    free(tag[i]);
+    free(exp_tag[i]);
+  }
+  return ok;
+}
+
+static void bench(Spec_Agile_AEAD_alg a, const char *name, uint32_t len) {
+  uint32_t num = 64, rounds = 10000000 / (num * len);
+  EverCrypt_AEAD_record_s *r;
+  EverCrypt_AEAD_record_create_in(a, &r, key, static_iv);
+  uint8_t *ad[64], *plain[64], *cipher[64], *tag[64];
+  uint32_t ad_len[64], plain_len[64];
+  uint8_t *mem = malloc(num * (16 + 16 + 2 * len));
+  memset(mem, 'P', num * (16 + 16 + 2 * len));
+  for (uint32_t i = 0; i < num; i++) {
+    ad[i] = mem + i * (32 + 2 * len);
+    tag[i] = ad[i] + 16;
+    plain[i] = tag[i] + 16;
+    cipher[i] = plain[i] + len;
+    ad_len[i] = 16;
+    plain_len[i] = len;
+  }
+
+  cycles c0, c1, c2, c3;
+  clock_t t0, t1, t2, t3;
+  t0 = clock();
+  c0 = cpucycles_begin();
+  for (uint32_t k = 0; k < rounds; k++)
+    for (uint32_t i = 0; i < num; i++)
+      EverCrypt_AEAD_record_seal_next(r, ad[i], 16, plain[i], len, cipher[i], tag[i]);
+  c1 = cpucycles_end();
+  t1 = clock();
+  t2 = clock();
+  c2 = cpucycles_begin();
+  for (uint32_t k = 0; k < rounds; k++)
+    EverCrypt_AEAD_record_seal_multi(r, num, NULL, ad, ad_len, plain, plain_len, cipher, tag);
+  c3 = cpucycles_end();
+  t3 = clock();
+  uint64_t count = (uint64_t)rounds * num * len;
+  printf("%s, %" PRIu32 " x %" PRIu32 " bytes, seal_next PERF:\n", name, num, len);
+  print_time(count, t1 - t0, c1 - c0);
+  printf("%s, %" PRIu32 " x %" PRIu32 " bytes, seal_multi PERF:\n", name, num, len);
+  print_time(count, t3 - t2, c3 - c2);
+  EverCrypt_AEAD_record_free(r);
+  free(mem);
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+
+  EverCrypt_AEAD_record_s *r;
+  bool ok = EverCrypt_AEAD_record_create_in(Spec_Agile_AEAD_AES128_CCM, &r, key, static_iv) ==
+    EverCrypt_Error_UnsupportedAlgorithm;
+  ok &= test_all("default");
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM", 64);
+  bench(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM", 1200);
+  bench(Spec_Agile_AEAD_CHACHA20_POLY1305, "ChaCha20-Poly1305", 64);
+  bench(Spec_Agile_AEAD_CHACHA20_POLY1305, "ChaCha20-Poly1305", 1200);
+  EverCrypt_AutoConfig2_disable_avx2();
+  ok &= test_all("no avx2");
+  EverCrypt_AutoConfig2_disable_aesni();
+  EverCrypt_AutoConfig2_disable_avx();
+  ok &= test_all("no avx, no aesni");
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
@@ -0,0 +1,198 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "EverCrypt_AEAD.h"
+#include "EverCrypt_AutoConfig2.h"
+
+#include "test_helpers.h"
+
+#define MAX_LEN 70000
+
+static uint8_t key[32] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+static uint32_t seed = 1;
+
+static uint32_t next(uint32_t bound) {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % bound;
+}
+
+// Chunk lengths: mostly short, unaligned ones, with the occasional long run.
+static uint32_t chunk(uint32_t rem) {
+  uint32_t k = next(8) == 0 ? next(20000) : next(100);
+  return k > rem ? rem : k;
+}
+
+static bool test_one(Spec_Agile_AEAD_alg a, uint32_t iv_len, uint32_t ad_len, uint32_t len,
+  uint8_t *plain, uint8_t *exp, uint8_t *out, uint8_t *dec)
+{
+  EverCrypt_AEAD_state_s *s;
+  if (EverCrypt_AEAD_create_in(a, &s, key) != EverCrypt_Error_Success)
+    return true;
+  EverCrypt_AEAD_stream_s *st;
+  EverCrypt_AEAD_stream_create_in(s, &st);
+
+  uint8_t iv[64], ad[256], exp_tag[16], tag[16];
+  for (uint32_t i = 0; i < iv_len; i++)
+    iv[i] = (uint8_t)(i + 1);
+  for (uint32_t i = 0; i < ad_len; i++)
+    ad[i] = (uint8_t)(i * 3 + 1);
+  EverCrypt_AEAD_encrypt(s, iv, iv_len, ad, ad_len, plain, len, exp, exp_tag);
+
+  bool ok = EverCrypt_AEAD_stream_init(st, iv, iv_len, ad, ad_len) == EverCrypt_Error_Success;
+  for (uint32_t off = 0, k; off < len; off += k) {
+    k = chunk(len - off);
+    ok = ok && EverCrypt_AEAD_stream_encrypt_update(st, plain + off, k, out + off) ==
+      EverCrypt_Error_Success;
+  }
+  EverCrypt_AEAD_stream_encrypt_finish(st, tag);
+  ok = ok && memcmp(out, exp, len) == 0 && memcmp(tag, exp_tag, 16) == 0;
+
+  // Single pass, with some chunks only authenticated.
+  memset(dec, 0, len);
+  EverCrypt_AEAD_stream_init(st, iv, iv_len, ad, ad_len);
+  for (uint32_t off = 0, k; off < len; off += k) {
+    k = chunk(len - off);
+    bool skip = next(4) == 0;
+    EverCrypt_AEAD_stream_decrypt_update(st, out + off, k, skip ? NULL : dec + off);
+    if (skip)
+      memcpy(dec + off, plain + off, k);
+  }
+  ok = ok && EverCrypt_AEAD_stream_decrypt_finish(st, tag) == EverCrypt_Error_Success &&
+    memcmp(dec, plain, len) == 0;
+
+  // Staged: authenticate everything, then release.
+  memset(dec, 0, len);
+  EverCrypt_AEAD_stream_init(st, iv, iv_len, ad, ad_len);
+  ok = ok && EverCrypt_AEAD_stream_decrypt_release(st, out, len, dec) ==
+    EverCrypt_Error_AuthenticationFailure;
+  for (uint32_t off = 0, k; off < len; off += k) {
+    k = chunk(len - off);
+    EverCrypt_AEAD_stream_decrypt_update(st, out + off, k, NULL);
+  }
+  ok = ok && EverCrypt_AEAD_stream_decrypt_finish(st, tag) == EverCrypt_Error_Success;
+  for (uint32_t off = 0, k; off < len; off += k) {
+    k = chunk(len - off);
+    ok = ok && EverCrypt_AEAD_stream_decrypt_release(st, out + off, k, dec + off) ==
+      EverCrypt_Error_Success;
+  }
+  ok = ok && memcmp(dec, plain, len) == 0;
+  ok = ok && EverCrypt_AEAD_stream_decrypt_release(st, out, 1, dec) ==
+    EverCrypt_Error_AuthenticationFailure;
+
+  // A forged tag is rejected, and nothing can be released.
+  tag[len % 16] ^= 1;
+  EverCrypt_AEAD_stream_init(st, iv, iv_len, ad, ad_len);
+  EverCrypt_AEAD_stream_decrypt_update(st, out, len, NULL);
+  ok = ok && EverCrypt_AEAD_stream_decrypt_finish(st, tag) == EverCrypt_Error_AuthenticationFailure;
+  ok = ok && (len == 0 || EverCrypt_AEAD_stream_decrypt_release(st, out, len, dec) ==
+    EverCrypt_Error_AuthenticationFailure);
+
+  if (!ok)
+    printf("alg %d, iv_len %" PRIu32 ", ad_len %" PRIu32 ", len %" PRIu32 ": **FAILED**\n",
+      a, iv_len, ad_len, len);
+  EverCrypt_AEAD_stream_free(st);
+  EverCrypt_AEAD_free(s);
+  return ok;
+}
+
+static bool test_all(const char *name) {
+  Spec_Agile_AEAD_alg algs[] = {
+    Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM, Spec_Agile_AEAD_CHACHA20_POLY1305
+  };
+  uint32_t lens[] = { 0, 1, 15, 16, 17, 64, 65, 511, 512, 513, 4097, 65536, MAX_LEN };
+  uint8_t *plain = malloc(MAX_LEN), *exp = malloc(MAX_LEN);
+  uint8_t *out = malloc(MAX_LEN), *dec = malloc(MAX_LEN);
+  for (uint32_t i = 0; i < MAX_LEN; i++)
+    plain[i] = (uint8_t)(i * 7 + 5);
+
+  bool ok = true;
+  for (uint32_t a = 0; a < 3; a++)
+    for (uint32_t l = 0; l < sizeof lens / sizeof lens[0]; l++)
+      for (uint32_t r = 0; r < 4; r++) {
+        uint32_t ad_len = r == 0 ? 0 : next(256);
+        ok &= test_one(algs[a], 12, ad_len, lens[l], plain, exp, out, dec);
+        if (a < 2)
+          ok &= test_one(algs[a], 1 + next(63), ad_len, lens[l], plain, exp, out, dec);
+      }
+  printf("AEAD stream (%s): %s\n", name, ok ? "Success!" : "**FAILED**");
+  free(plain);
+  free(exp);
+  free(out);
+  free(dec);
+  return ok;
+}
+
+// An object over the 4 GiB limit of the one-shot API, encrypted and decrypted
+// in lockstep, 1 MiB at a time.
+static bool test_large(Spec_Agile_AEAD_alg a, const char *name) {
+  EverCrypt_AEAD_state_s *s;
+  if (EverCrypt_AEAD_create_in(a, &s, key) != EverCrypt_Error_Success)
+    return true;
+  EverCrypt_AEAD_stream_s *enc, *dec;
+  EverCrypt_AEAD_stream_create_in(s, &enc);
+  EverCrypt_AEAD_stream_create_in(s, &dec);
+  uint32_t chunk_len = 1 << 20, n = (4 << 10) + 1;
+  uint8_t *plain = malloc(chunk_len), *out = malloc(chunk_len), *back = malloc(chunk_len);
+  uint8_t iv[12] = { 0 }, ad[13] = { 0 }, tag[16];
+  for (uint32_t i = 0; i < chunk_len; i++)
+    plain[i] = (uint8_t)(i * 7 + 5);
+
+  bool ok = true;
+  cycles c0, c1, c = 0;
+  clock_t t1, t2, t = 0;
+  EverCrypt_AEAD_stream_init(enc, iv, 12, ad, 13);
+  EverCrypt_AEAD_stream_init(dec, iv, 12, ad, 13);
+  for (uint32_t i = 0; ok && i < n; i++) {
+    t1 = clock();
+    c0 = cpucycles_begin();
+    EverCrypt_AEAD_stream_encrypt_update(enc, plain, chunk_len, out);
+    c1 = cpucycles_end();
+    t2 = clock();
+    c += c1 - c0;
+    t += t2 - t1;
+    EverCrypt_AEAD_stream_decrypt_update(dec, out, chunk_len, back);
+    ok = memcmp(plain, back, chunk_len) == 0;
+  }
+  EverCrypt_AEAD_stream_encrypt_finish(enc, tag);
+  ok = ok && EverCrypt_AEAD_stream_decrypt_finish(dec, tag) == EverCrypt_Error_Success;
+  printf("%s, 4 GiB + 1 MiB in 1 MiB chunks, stream_encrypt_update PERF:\n", name);
+  print_time((uint64_t)n * chunk_len, t, c);
+
+  // A truncated object is rejected.
+  EverCrypt_AEAD_stream_init(dec, iv, 12, ad, 13);
+  for (uint32_t i = 0; i < n - 1; i++)
+    EverCrypt_AEAD_stream_decrypt_update(dec, out, chunk_len, NULL);
+  ok = ok && EverCrypt_AEAD_stream_decrypt_finish(dec, tag) == EverCrypt_Error_AuthenticationFailure;
+
+  printf("AEAD stream, over 4 GiB (%s): %s\n", name, ok ? "Success!" : "**FAILED**");
+  EverCrypt_AEAD_stream_free(enc);
+  EverCrypt_AEAD_stream_free(dec);
+  EverCrypt_AEAD_free(s);
+  free(plain);
+  free(out);
+  free(back);
+  return ok;
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+
+  bool ok = test_all("default");
+  ok &= test_large(Spec_Agile_AEAD_AES128_GCM, "AES128-GCM");
+  ok &= test_large(Spec_Agile_AEAD_CHACHA20_POLY1305, "ChaCha20-Poly1305");
+  EverCrypt_AutoConfig2_disable_avx2();
+  ok &= test_all("no avx2");
+  EverCrypt_AutoConfig2_disable_avx();
+  ok &= test_all("no avx");
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
@@ -2,5 +2,6 @@
 #define _BENCH_AEAD_H_
 
 void bench_aead(const BenchmarkSettings & s);
+void bench_aead_large(const BenchmarkSettings & s);
 
 #endif
@@ -205,7 +205,7 @@ class OpenSSLVerify: public DSABenchmark
 
 void bench_ed25519(const BenchmarkSettings & s)
 {
-  size_t data_sizes[] = { 1024, 2048, 4096, 8192, 16384, 32768, 65536 };
+  size_t data_sizes[] = { 64, 256, 1024, 2048, 4096, 8192, 16384, 32768, 65536 };
 
   for (size_t ds: data_sizes)
   {
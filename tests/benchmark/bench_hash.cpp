@@ -124,6 +124,65 @@ template<> const int EverCryptHash<2, 512>::id = Spec_Hash_Definitions_SHA2_512;
 typedef EverCryptHash<0, 128> EverCryptMD5;
 typedef EverCryptHash<1, 160> EverCryptSHA1;
 
+// A batch of independent messages of the same length, hashed either one at a
+// time or with the multi-buffer implementations.
+class EverCryptHashBatch : public Benchmark
+{
+  protected:
+    uint8_t *src, *dst;
+    size_t src_sz, batch;
+    int id;
+    bool multi;
+    std::string alg_id;
+    std::vector<uint8_t*> inputs, outputs;
+    std::vector<uint32_t> lens;
+
+  public:
+    static std::string column_headers() { return "\"Provider\",\"Algorithm\",\"Size [b]\",\"Batch\"" + Benchmark::column_headers() + ",\"Avg Cycles/Byte\""; }
+
+    EverCryptHashBatch(size_t src_sz, size_t batch, int id, int N, bool multi) :
+      Benchmark(multi ? "EverCrypt-multi" : "EverCrypt"), src_sz(src_sz), batch(batch), id(id), multi(multi)
+    {
+      src = new uint8_t[src_sz * batch];
+      dst = new uint8_t[N/8 * batch];
+      for (size_t i = 0; i < batch; i++)
+      {
+        inputs.push_back(src + i * src_sz);
+        outputs.push_back(dst + i * N/8);
+        lens.push_back(src_sz);
+      }
+      alg_id = "SHA2-" + std::to_string(N);
+    }
+
+    virtual ~EverCryptHashBatch()
+    {
+      delete[](src);
+      delete[](dst);
+    }
+
+    virtual void bench_setup(const BenchmarkSettings & s)
+    {
+      Benchmark::bench_setup(s);
+      randomize((char*)src, src_sz * batch);
+    }
+
+    virtual void bench_func()
+    {
+      if (multi)
+        EverCrypt_Hash_hash_multi(id, batch, inputs.data(), lens.data(), outputs.data());
+      else
+        for (size_t i = 0; i < batch; i++)
+          EverCrypt_Hash_hash(id, outputs[i], inputs[i], src_sz);
+    }
+
+    virtual void report(std::ostream & rs, const BenchmarkSettings & s) const
+    {
+      rs << "\"" << name << "\"" << "," << "\"" << alg_id << "\"" << "," << src_sz << "," << batch;
+      Benchmark::report(rs, s);
+      rs << "," << (ctotal/(double)(src_sz * batch))/(double)s.samples << "\n";
+    }
+};
+
 #ifdef HAVE_OPENSSL
 template<int type, int N>
 class OpenSSLHash : public HashBenchmark
@@ -447,6 +506,59 @@ void bench_sha2(const BenchmarkSettings & s)
   bench_sha2_512(s);
 }
 
+void bench_hash_batch_alg(const BenchmarkSettings & s, const std::string & alg, int id, int N)
+{
+  size_t msg_sizes[] = { 64, 1024 };
+  size_t batch_sizes[] = { 1, 2, 4, 8, 16, 32, 64 };
+  std::string data_filename = "bench_hash_batch_" + alg + ".csv";
+
+  std::list<Benchmark*> todo;
+  for (size_t ms : msg_sizes)
+    for (size_t bs : batch_sizes)
+    {
+      todo.push_back(new EverCryptHashBatch(ms, bs, id, N, false));
+      todo.push_back(new EverCryptHashBatch(ms, bs, id, N, true));
+    }
+
+  Benchmark::run_batch(s, EverCryptHashBatch::column_headers(), data_filename, todo);
+
+  for (size_t ms : msg_sizes)
+  {
+    std::string mss = std::to_string(ms);
+    std::stringstream title;
+    title << alg << " batch performance (message length " << ms << " bytes)";
+
+    Benchmark::PlotSpec plot_specs;
+    plot_specs += Benchmark::histogram_line(filter(data_filename, "EverCrypt\\\",\\\"SHA2-" + std::to_string(N) + "\\\"," + mss + ","), "EverCrypt", "Avg Cycles/Byte", "strcol('Batch')", 2, true);
+    plot_specs += Benchmark::histogram_line(filter(data_filename, "EverCrypt-multi\\\",\\\"SHA2-" + std::to_string(N) + "\\\"," + mss + ","), "EverCrypt-multi", "Avg Cycles/Byte", "strcol('Batch')", 2, true);
+    Benchmark::add_label_offsets(plot_specs, 1.0);
+
+    std::stringstream extras;
+    extras << "set key top right inside\n";
+    extras << "set style histogram clustered gap 3 title\n";
+    extras << "set style data histograms\n";
+    extras << "set bmargin 5\n";
+
+    Benchmark::make_plot(s,
+                         "svg",
+                         title.str(),
+                         "Number of messages",
+                         "Avg. performance [CPU cycles/byte]",
+                         plot_specs,
+                         "bench_hash_batch_" + alg + "_" + mss + "_bytes.svg",
+                         extras.str(),
+                         {}, 0,
+                         true);
+  }
+}
+
+void bench_hash_batch(const BenchmarkSettings & s)
+{
+  bench_hash_batch_alg(s, "SHA2_256", Spec_Hash_Definitions_SHA2_256, 256);
+  bench_hash_batch_alg(s, "SHA2_384", Spec_Hash_Definitions_SHA2_384, 384);
+  bench_hash_batch_alg(s, "SHA2_512", Spec_Hash_Definitions_SHA2_512, 512);
+}
+
 void bench_sha3_224(const BenchmarkSettings & s)
 {
   size_t data_sizes[] = { 1024, 2048, 4096, 8192, 16384, 32768, 65536 };
@@ -526,6 +638,7 @@ void bench_hash(const BenchmarkSettings & s)
   bench_md5(s);
   bench_sha1(s);
   bench_sha2(s);
+  bench_hash_batch(s);
 
   int i = 0;
   for (size_t ds : data_sizes)
@@ -5,6 +5,7 @@ void bench_md5(const BenchmarkSettings & s);
 void bench_sha1(const BenchmarkSettings & s);
 void bench_sha2(const BenchmarkSettings & s);
 void bench_sha3(const BenchmarkSettings & s);
+void bench_hash_batch(const BenchmarkSettings & s);
 void bench_hash(const BenchmarkSettings & s);
 
 #endif
@@ -1,12 +1,26 @@
 #include <sys/time.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 #include <sstream>
 #include <algorithm>
+#include <thread>
 
 #include <benchmark.h>
 
 extern "C" {
 #include "MerkleTree.h"
+#include "MerkleTree_Mmap.h"
 }
 
 static const size_t hash_size = 32;
@@ -88,6 +102,62 @@ class MerkleInsert : public Benchmark
     }
 };
 
+class MerkleInsertBatch : public Benchmark
+{
+  protected:
+    size_t num_nodes = 0;
+    uint32_t num_threads = 1;
+    merkle_tree *tree;
+    uint8_t *leaves;
+
+  public:
+    static std::string column_headers() { return "\"Nodes\"" + Benchmark::column_headers(); }
+
+    MerkleInsertBatch(size_t num_nodes, uint32_t num_threads = 1) :
+      Benchmark(), num_nodes(num_nodes), num_threads(num_threads) { }
+
+    virtual ~MerkleInsertBatch() {}
+
+    virtual void bench_setup(const BenchmarkSettings & s)
+    {
+      Benchmark::bench_setup(s);
+      uint8_t *ih = mt_init_hash(hash_size);
+      tree = mt_create(ih);
+      mt_free_hash(ih);
+
+      leaves = new uint8_t[num_nodes * hash_size]();
+      for (uint64_t i = 0; i < num_nodes; i++)
+        for (size_t j = 0; j < 8; j++)
+           leaves[i * hash_size + j] = rand() % 8;
+    }
+
+    virtual void bench_func()
+    {
+      #ifdef _DEBUG
+      if (!mt_insert_batch_pre(tree, leaves, num_nodes))
+        throw std::logic_error("precondition violation");
+      #endif
+      if (num_threads > 1)
+        mt_insert_batch_par(tree, leaves, num_nodes, num_threads);
+      else
+        mt_insert_batch(tree, leaves, num_nodes);
+    }
+
+    virtual void bench_cleanup(const BenchmarkSettings & s)
+    {
+      delete[] leaves;
+      mt_free(tree);
+      Benchmark::bench_cleanup(s);
+    }
+
+    virtual void report(std::ostream & rs, const BenchmarkSettings & s) const
+    {
+      rs << num_nodes;
+      Benchmark::report(rs, s);
+      rs << "\n";
+    }
+};
+
 class MerklePathExtraction : public Benchmark
 {
   protected:
@@ -259,6 +329,376 @@ class MerklePathVerification : public Benchmark
     }
 };
 
+// Counts last-level cache misses of this thread, where the kernel lets us.
+class CacheMissCounter
+{
+  protected:
+    int fd = -1;
+
+  public:
+    CacheMissCounter()
+    {
+      #ifdef __linux__
+      struct perf_event_attr pe = {};
+      pe.type = PERF_TYPE_HARDWARE;
+      pe.size = sizeof(pe);
+      pe.config = PERF_COUNT_HW_CACHE_MISSES;
+      pe.disabled = 1;
+      pe.exclude_kernel = 1;
+      pe.exclude_hv = 1;
+      fd = syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0);
+      #endif
+    }
+
+    ~CacheMissCounter()
+    {
+      #ifdef __linux__
+      if (fd >= 0)
+        close(fd);
+      #endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start()
+    {
+      #ifdef __linux__
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+      #endif
+    }
+
+    uint64_t stop()
+    {
+      uint64_t count = 0;
+      #ifdef __linux__
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count))
+          count = 0;
+      }
+      #endif
+      return count;
+    }
+};
+
+static size_t heap_in_use()
+{
+  #if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  return mallinfo2().uordblks;
+  #else
+  return 0;
+  #endif
+}
+
+// Resident bytes of an address range, i.e. the touched pages of an arena.
+static size_t resident(uint8_t *base, size_t len)
+{
+  size_t r = 0;
+  #ifndef _WIN32
+  size_t ps = sysconf(_SC_PAGESIZE);
+  std::vector<unsigned char> v((len + ps - 1) / ps);
+  if (len > 0 && mincore(base, len, v.data()) == 0)
+    for (unsigned char c : v)
+      r += (c & 1) ? ps : 0;
+  #endif
+  return r;
+}
+
+// Compares the pointer-vector merkle_tree with the contiguous arena layout of
+// an in-memory mt_mmap tree: memory per leaf, and cache misses per operation.
+class MerkleLayout : public Benchmark
+{
+  public:
+    enum Op { INSERT, GET_PATH };
+
+  protected:
+    size_t num_nodes = 0;
+    bool arena;
+    Op op;
+    merkle_tree *tree = NULL;
+    mt_mmap_p atree = NULL;
+    uint8_t *leaves = NULL;
+    std::vector<uint64_t> idxs;
+    std::vector<MerkleTree_Low_path*> paths;
+    uint8_t *root = NULL;
+    size_t heap_before = 0, bytes = 0;
+    uint64_t misses = 0;
+    CacheMissCounter counter;
+
+    void build()
+    {
+      if (arena)
+        mt_mmap_insert_batch(atree, leaves + hash_size, num_nodes - 1);
+      else
+        for (uint64_t i = 1; i < num_nodes; i++)
+          mt_insert(tree, leaves + i * hash_size);
+    }
+
+    void measure()
+    {
+      if (arena) {
+        bytes = 0;
+        for (size_t lv = 0; lv < 32; lv++)
+          bytes += resident(atree->levels[lv].base, atree->levels[lv].mapped);
+      }
+      else
+        bytes = heap_in_use() - heap_before;
+    }
+
+  public:
+    static std::string column_headers() { return "\"Layout\",\"Nodes\",\"Bytes/leaf\",\"Misses/op\"" + Benchmark::column_headers(); }
+
+    MerkleLayout(size_t num_nodes, bool arena, Op op) :
+      Benchmark(), num_nodes(num_nodes), arena(arena), op(op) { }
+
+    virtual ~MerkleLayout() {}
+
+    virtual void bench_setup(const BenchmarkSettings & s)
+    {
+      Benchmark::bench_setup(s);
+      leaves = new uint8_t[num_nodes * hash_size]();
+      for (uint64_t i = 0; i < num_nodes; i++)
+        for (size_t j = 0; j < 8; j++)
+           leaves[i * hash_size + j] = rand() % 8;
+      root = mt_init_hash(hash_size);
+
+      heap_before = heap_in_use();
+      if (arena)
+        atree = mt_mmap_create(NULL, leaves);
+      else
+        tree = mt_create(leaves);
+
+      if (op == GET_PATH) {
+        build();
+        measure();
+        // Random targets, so that successive paths share few cache lines.
+        idxs.resize(num_nodes);
+        paths.resize(num_nodes);
+        for (uint64_t i = 0; i < num_nodes; i++) {
+          idxs[i] = rand() % num_nodes;
+          paths[i] = mt_init_path(hash_size);
+        }
+      }
+      counter.start();
+    }
+
+    virtual void bench_func()
+    {
+      if (op == INSERT)
+      {
+        if (arena)
+          for (uint64_t i = 1; i < num_nodes; i++)
+            mt_mmap_insert(atree, leaves + i * hash_size);
+        else
+          build();
+      }
+      else
+        for (uint64_t i = 0; i < num_nodes; i++)
+          if (arena)
+            mt_mmap_get_path(atree, idxs[i], paths[i], root);
+          else
+            mt_get_path(tree, idxs[i], paths[i], root);
+    }
+
+    virtual void bench_cleanup(const BenchmarkSettings & s)
+    {
+      misses += counter.stop();
+      if (op == INSERT)
+        measure();
+      for (MerkleTree_Low_path *p : paths)
+        mt_free_path(p);
+      paths.clear();
+      if (arena)
+        mt_mmap_close(atree);
+      else
+        mt_free(tree);
+      mt_free_hash(root);
+      delete[] leaves;
+      Benchmark::bench_cleanup(s);
+    }
+
+    virtual void report(std::ostream & rs, const BenchmarkSettings & s) const
+    {
+      rs << "\"" << (arena ? "arena" : "pointers") << "\""
+         << "," << num_nodes
+         << "," << (double)bytes / num_nodes;
+      if (counter.available())
+        rs << "," << (double)misses / (s.samples + s.warmup_samples) / num_nodes;
+      else
+        rs << ",";
+      Benchmark::report(rs, s);
+      rs << "\n";
+    }
+};
+
+// Proofs for a sorted batch of leaves: one multi-path, or one path per leaf.
+class MerkleMultiPath : public Benchmark
+{
+  protected:
+    size_t num_nodes = 0, batch = 0;
+    bool multi;
+    merkle_tree *tree;
+    uint8_t *root;
+    std::vector<uint64_t> idxs;
+    MerkleTree_Low_path *path;
+    size_t proof_hashes = 0;
+
+  public:
+    static std::string column_headers() { return "\"Proof\",\"Nodes\",\"Batch\",\"Hashes\"" + Benchmark::column_headers(); }
+
+    MerkleMultiPath(size_t num_nodes, size_t batch, bool multi) :
+      Benchmark(), num_nodes(num_nodes), batch(batch), multi(multi) { }
+
+    virtual ~MerkleMultiPath() {}
+
+    virtual void bench_setup(const BenchmarkSettings & s)
+    {
+      Benchmark::bench_setup(s);
+      uint8_t *leaves = new uint8_t[num_nodes * hash_size]();
+      for (uint64_t i = 0; i < num_nodes; i++)
+        for (size_t j = 0; j < 8; j++)
+           leaves[i * hash_size + j] = rand() % 8;
+      tree = mt_create(leaves);
+      mt_insert_batch(tree, leaves + hash_size, num_nodes - 1);
+      delete[] leaves;
+
+      idxs.clear();
+      for (uint64_t i = 0; i < batch; i++)
+        idxs.push_back(rand() % num_nodes);
+      std::sort(idxs.begin(), idxs.end());
+      idxs.erase(std::unique(idxs.begin(), idxs.end()), idxs.end());
+
+      root = mt_init_hash(hash_size);
+      path = mt_init_path(hash_size);
+    }
+
+    virtual void bench_func()
+    {
+      bool ok = true;
+      if (multi)
+      {
+        mt_clear_path(path);
+        uint32_t j = mt_get_multi_path(tree, idxs.data(), idxs.size(), path, root);
+        ok = mt_verify_multi(tree, idxs.data(), idxs.size(), j, path, root);
+        proof_hashes = mt_get_path_length(path);
+      }
+      else
+      {
+        proof_hashes = 0;
+        for (uint64_t k: idxs)
+        {
+          mt_clear_path(path);
+          uint32_t j = mt_get_path(tree, k, path, root);
+          ok = ok && mt_verify(tree, k, j, path, root);
+          proof_hashes += mt_get_path_length(path);
+        }
+      }
+      if (!ok)
+        throw std::logic_error("verification failed");
+    }
+
+    virtual void bench_cleanup(const BenchmarkSettings & s)
+    {
+      mt_free_path(path);
+      mt_free_hash(root);
+      mt_free(tree);
+      Benchmark::bench_cleanup(s);
+    }
+
+    virtual void report(std::ostream & rs, const BenchmarkSettings & s) const
+    {
+      rs << "\"" << (multi ? "multi-path" : "paths") << "\""
+         << "," << num_nodes
+         << "," << idxs.size()
+         << "," << proof_hashes;
+      Benchmark::report(rs, s);
+      rs << "\n";
+    }
+};
+
+static uint64_t num_hashes = 0;
+
+static void counting_sha256(uint8_t *src1, uint8_t *src2, uint8_t *dst)
+{
+  num_hashes++;
+  mt_sha256_compress(src1, src2, dst);
+}
+
+// One root read after every insertion, as when each transaction is committed.
+class MerkleInsertRoot : public Benchmark
+{
+  protected:
+    size_t num_nodes = 0;
+    bool arena;
+    merkle_tree *tree = NULL;
+    mt_mmap_p atree = NULL;
+    uint8_t *leaves, *root;
+    uint64_t hashes = 0;
+
+  public:
+    static std::string column_headers() { return "\"Layout\",\"Nodes\",\"Hashes/op\"" + Benchmark::column_headers(); }
+
+    MerkleInsertRoot(size_t num_nodes, bool arena) : Benchmark(), num_nodes(num_nodes), arena(arena) { }
+
+    virtual ~MerkleInsertRoot() {}
+
+    virtual void bench_setup(const BenchmarkSettings & s)
+    {
+      Benchmark::bench_setup(s);
+      leaves = new uint8_t[num_nodes * hash_size]();
+      for (uint64_t i = 0; i < num_nodes; i++)
+        for (size_t j = 0; j < 8; j++)
+           leaves[i * hash_size + j] = rand() % 8;
+      root = mt_init_hash(hash_size);
+      if (arena)
+        atree = mt_mmap_create_custom(NULL, hash_size, leaves, counting_sha256);
+      else
+        tree = mt_create_custom(hash_size, leaves, counting_sha256);
+      num_hashes = 0;
+    }
+
+    virtual void bench_func()
+    {
+      for (uint64_t i = 1; i < num_nodes; i++)
+      {
+        if (arena)
+        {
+          mt_mmap_insert(atree, leaves + i * hash_size);
+          mt_mmap_get_root(atree, root);
+        }
+        else
+        {
+          mt_insert(tree, leaves + i * hash_size);
+          mt_get_root(tree, root);
+        }
+      }
+    }
+
+    virtual void bench_cleanup(const BenchmarkSettings & s)
+    {
+      hashes += num_hashes;
+      if (arena)
+        mt_mmap_close(atree);
+      else
+        mt_free(tree);
+      mt_free_hash(root);
+      delete[] leaves;
+      Benchmark::bench_cleanup(s);
+    }
+
+    virtual void report(std::ostream & rs, const BenchmarkSettings & s) const
+    {
+      rs << "\"" << (arena ? "arena" : "pointers") << "\""
+         << "," << num_nodes
+         << "," << (double)hashes / (s.samples + s.warmup_samples) / (num_nodes - 1);
+      Benchmark::report(rs, s);
+      rs << "\n";
+    }
+};
+
 void bench_merkle_insert(const BenchmarkSettings & s)
 {
   size_t data_sizes[] = { 1024, 2048, 4096, 8192, 16384, 32768, 65536, 131072, 262144, 524288, 1048576 };
@@ -303,6 +743,42 @@ void bench_merkle_insert(const BenchmarkSettings & s)
                   extras.str());
 }
 
+void bench_merkle_insert_batch(const BenchmarkSettings & s, uint32_t num_threads)
+{
+  size_t data_sizes[] = { 1024, 2048, 4096, 8192, 16384, 32768, 65536, 131072, 262144, 524288, 1048576 };
+  std::string suffix = num_threads > 1 ? "_par" : "";
+  std::string data_filename = "bench_merkle_insert_batch" + suffix + ".csv";
+
+  std::list<Benchmark*> todo;
+  for (size_t ds: data_sizes)
+    todo.push_back(new MerkleInsertBatch(ds, num_threads));
+
+  Benchmark::run_batch(s, MerkleInsertBatch::column_headers(), data_filename, todo);
+
+  std::stringstream extras;
+  extras << "set boxwidth 0.8\n";
+  extras << "set key off\n";
+  extras << "set style histogram clustered gap 3 title\n";
+  extras << "set style data histograms\n";
+  extras << "set bmargin 5\n";
+
+  std::string X = "((" + std::to_string(s.samples) + " * column('Nodes'))/(column('CPUexcl')/1000000000))";
+  std::string lbls = "sprintf(\"%dk\", column('Nodes')/1024)";
+  Benchmark::PlotSpec plot_specs_timed = {
+    std::make_pair(data_filename, "using " + X + ":xticlabels(" + lbls + ") with boxes"),
+    std::make_pair("", "using 0:" + X + ":xticlabels(" + lbls + "):(sprintf(\"%0.0f\", " + X + ")) with labels font \"Courier,8\" offset char 0,.5 center notitle"),
+  };
+
+  Benchmark::make_plot(s,
+                  "svg",
+                  "Merkle tree batch insertion performance (" + std::to_string(num_threads) + " threads)",
+                  "# tree nodes",
+                  "Avg. performance [insertion/sec]",
+                  plot_specs_timed,
+                  "bench_merkle_insert_batch" + suffix + "_timed.svg",
+                  extras.str());
+}
+
 void bench_merkle_get_path(const BenchmarkSettings & s)
 {
   size_t data_sizes[] = { 1024, 2048, 4096, 8192, 16384, 32768, 65536, 131072, 262144, 524288, 1048576 };
@@ -391,6 +867,155 @@ void bench_merkle_verify(const BenchmarkSettings & s)
                   extras.str());
 }
 
+static std::string filter(const std::string & data_filename, const std::string & layout)
+{
+  return "< grep -e \"^\\\"" + layout + "\" -e \"^\\\"Layout\" " + data_filename;
+}
+
+void bench_merkle_layout(const BenchmarkSettings & s, MerkleLayout::Op op)
+{
+  size_t data_sizes[] = { 1024, 4096, 16384, 65536, 262144, 1048576 };
+  std::string op_name = op == MerkleLayout::INSERT ? "insert" : "get_path";
+  std::string data_filename = "bench_merkle_layout_" + op_name + ".csv";
+
+  std::list<Benchmark*> todo;
+  for (bool arena: { false, true })
+    for (size_t ds: data_sizes)
+      todo.push_back(new MerkleLayout(ds, arena, op));
+
+  Benchmark::run_batch(s, MerkleLayout::column_headers(), data_filename, todo);
+
+  std::stringstream extras;
+  extras << "set boxwidth 0.8\n";
+  extras << "set key top left inside\n";
+  extras << "set style histogram clustered gap 3 title\n";
+  extras << "set style data histograms\n";
+  extras << "set bmargin 5\n";
+
+  std::string lbls = "sprintf(\"%dk\", column('Nodes')/1024)";
+  std::pair<std::string, std::string> plots[] = {
+    { "Avg", "Avg. performance [CPU cycles/" + op_name + " of all nodes]" },
+    { "Misses/op", "Cache misses [misses/" + op_name + "]" },
+    { "Bytes/leaf", "Memory [bytes/leaf]" },
+  };
+  std::string files[] = { "cycles", "misses", "memory" };
+
+  for (size_t i = 0; i < 3; i++)
+  {
+    Benchmark::PlotSpec plot_specs;
+    plot_specs += Benchmark::histogram_line(filter(data_filename, "pointers"), "pointers", plots[i].first, lbls, 1);
+    plot_specs += Benchmark::histogram_line(filter(data_filename, "arena"), "arena", plots[i].first, lbls, 1);
+    Benchmark::add_label_offsets(plot_specs);
+
+    Benchmark::make_plot(s,
+                    "svg",
+                    "Merkle tree " + op_name + " by node layout",
+                    "# tree nodes",
+                    plots[i].second,
+                    plot_specs,
+                    "bench_merkle_layout_" + op_name + "_" + files[i] + ".svg",
+                    extras.str(),
+                    {}, 0, true);
+  }
+}
+
+void bench_merkle_multi_path(const BenchmarkSettings & s)
+{
+  size_t batch_sizes[] = { 16, 64, 256, 1024, 4096, 16384 };
+  size_t num_nodes = 1048576;
+  std::string data_filename = "bench_merkle_multi_path.csv";
+
+  std::list<Benchmark*> todo;
+  for (bool multi: { false, true })
+    for (size_t bs: batch_sizes)
+      todo.push_back(new MerkleMultiPath(num_nodes, bs, multi));
+
+  Benchmark::run_batch(s, MerkleMultiPath::column_headers(), data_filename, todo);
+
+  std::stringstream extras;
+  extras << "set boxwidth 0.8\n";
+  extras << "set key top left inside\n";
+  extras << "set style histogram clustered gap 3 title\n";
+  extras << "set style data histograms\n";
+  extras << "set bmargin 5\n";
+
+  std::string filter_paths = "< grep -e \"^\\\"paths\" -e \"^\\\"Proof\" " + data_filename;
+  std::string filter_multi = "< grep -e \"^\\\"multi-path\" -e \"^\\\"Proof\" " + data_filename;
+
+  Benchmark::PlotSpec plot_specs;
+  plot_specs += Benchmark::histogram_line(filter_paths, "paths", "Avg", "strcol('Batch')", 0);
+  plot_specs += Benchmark::histogram_line(filter_multi, "multi-path", "Avg", "strcol('Batch')", 0);
+  Benchmark::add_label_offsets(plot_specs);
+
+  Benchmark::make_plot(s,
+                  "svg",
+                  "Merkle proof generation and verification (1M nodes)",
+                  "# proven leaves",
+                  "Avg. performance [CPU cycles/batch]",
+                  plot_specs,
+                  "bench_merkle_multi_path_cycles.svg",
+                  extras.str(),
+                  {}, 0, true);
+
+  Benchmark::PlotSpec size_specs;
+  size_specs += Benchmark::histogram_line(filter_paths, "paths", "Hashes", "strcol('Batch')", 0);
+  size_specs += Benchmark::histogram_line(filter_multi, "multi-path", "Hashes", "strcol('Batch')", 0);
+  Benchmark::add_label_offsets(size_specs);
+
+  Benchmark::make_plot(s,
+                  "svg",
+                  "Merkle proof size (1M nodes)",
+                  "# proven leaves",
+                  "Proof size [hashes]",
+                  size_specs,
+                  "bench_merkle_multi_path_size.svg",
+                  extras.str(),
+                  {}, 0, true);
+}
+
+void bench_merkle_insert_root(const BenchmarkSettings & s)
+{
+  size_t data_sizes[] = { 1024, 4096, 16384, 65536, 262144, 1048576 };
+  std::string data_filename = "bench_merkle_insert_root.csv";
+
+  std::list<Benchmark*> todo;
+  for (bool arena: { false, true })
+    for (size_t ds: data_sizes)
+      todo.push_back(new MerkleInsertRoot(ds, arena));
+
+  Benchmark::run_batch(s, MerkleInsertRoot::column_headers(), data_filename, todo);
+
+  std::stringstream extras;
+  extras << "set boxwidth 0.8\n";
+  extras << "set key top left inside\n";
+  extras << "set style histogram clustered gap 3 title\n";
+  extras << "set style data histograms\n";
+  extras << "set bmargin 5\n";
+
+  std::string lbls = "sprintf(\"%dk\", column('Nodes')/1024)";
+  std::string X = "((" + std::to_string(s.samples) + " * column('Nodes'))/(column('CPUexcl')/1000000000))";
+  Benchmark::PlotSpec plot_specs;
+  for (std::string layout: { "pointers", "arena" })
+  {
+    std::string f = "< grep -e \"^\\\"" + layout + "\" -e \"^\\\"Layout\" " + data_filename;
+    plot_specs += {
+      std::make_pair(f, "using " + X + ":xticlabels(" + lbls + ") title '" + layout + "'"),
+      std::make_pair("", "using 0:" + X + ":xticlabels(" + lbls + "):(sprintf(\"%0.0f\", " + X + ")) with labels font \"Courier,8\" notitle"),
+    };
+  }
+  Benchmark::add_label_offsets(plot_specs);
+
+  Benchmark::make_plot(s,
+                  "svg",
+                  "Merkle tree insertion with a root read after each",
+                  "# tree nodes",
+                  "Avg. performance [insertion+root/sec]",
+                  plot_specs,
+                  "bench_merkle_insert_root_timed.svg",
+                  extras.str(),
+                  {}, 0, true);
+}
+
 void bench_merkle(const BenchmarkSettings & s)
 {
   // These amortize over a number of tree nodes, so shouldn't need many samples.
@@ -399,6 +1024,12 @@ void bench_merkle(const BenchmarkSettings & s)
   s_local.warmup_samples = 0;
 
   bench_merkle_insert(s_local);
+  bench_merkle_insert_root(s_local);
+  bench_merkle_insert_batch(s_local, 1);
+  bench_merkle_insert_batch(s_local, std::max<unsigned>(std::thread::hardware_concurrency(), 1u));
   bench_merkle_get_path(s_local);
   bench_merkle_verify(s_local);
+  bench_merkle_multi_path(s_local);
+  bench_merkle_layout(s_local, MerkleLayout::INSERT);
+  bench_merkle_layout(s_local, MerkleLayout::GET_PATH);
 }
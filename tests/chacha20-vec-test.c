@@ -12,7 +12,9 @@
 #include "Hacl_Chacha20_Vec32.h"
 #include "Hacl_Chacha20_Vec128.h"
 #include "Hacl_Chacha20_Vec256.h"
+#include "Hacl_Chacha20_Vec512.h"
 #include "EverCrypt_AutoConfig2.h"
+#include "EverCrypt_Cipher.h"
 
 #include "test_helpers.h"
 #include "chacha20_vectors.h"
@@ -42,9 +44,93 @@ bool print_test(int in_len, uint8_t* in, uint8_t* key, uint8_t* nonce, uint8_t*
     printf("Chacha20 (256-bit) Result:\n");
     ok = ok && print_result(in_len,comp,exp);
   }
+
+  if (EverCrypt_AutoConfig2_has_avx512()) {
+    Hacl_Chacha20_Vec512_chacha20_encrypt_512(in_len,comp,in,key,nonce,1);
+    printf("Chacha20 (512-bit) Result:\n");
+    ok = ok && print_result(in_len,comp,exp);
+  }
+  return ok;
+}
+
+
+// Compares the 512-bit implementation with the 32-bit one around the 1024
+// bytes it processes per iteration, with counters that wrap within a batch.
+bool test_512(void) {
+  uint32_t lens[] = { 0, 1, 63, 64, 65, 511, 1023, 1024, 1025, 2047, 3000, 8192 };
+  uint32_t ctrs[] = { 0, 1, 0xfffffff8U };
+  uint8_t key[32], nonce[12];
+  uint8_t *in = malloc(8192), *out = malloc(8192), *exp = malloc(8192);
+  for (uint32_t i = 0; i < 32; i++)
+    key[i] = (uint8_t)(i * 7 + 1);
+  for (uint32_t i = 0; i < 12; i++)
+    nonce[i] = (uint8_t)(i * 13 + 5);
+  for (uint32_t i = 0; i < 8192; i++)
+    in[i] = (uint8_t)(i * 29 + 3);
+
+  bool ok = true;
+  for (uint32_t l = 0; l < sizeof lens / sizeof lens[0]; l++)
+    for (uint32_t c = 0; c < sizeof ctrs / sizeof ctrs[0]; c++) {
+      Hacl_Chacha20_Vec32_chacha20_encrypt_32(lens[l], exp, in, key, nonce, ctrs[c]);
+      Hacl_Chacha20_Vec512_chacha20_encrypt_512(lens[l], out, in, key, nonce, ctrs[c]);
+      if (memcmp(out, exp, lens[l]) != 0) {
+        printf("Chacha20 (512-bit) %" PRIu32 " bytes, counter %" PRIu32 " differs\n", lens[l],
+          ctrs[c]);
+        ok = false;
+      }
+    }
+  printf("Chacha20 (512-bit) lengths: %s\n", ok ? "Success!" : "**FAILED**");
+  free(in);
+  free(out);
+  free(exp);
   return ok;
 }
+#define MAX_MSGS 41
+
+// Encrypts batches of messages, each with its own key, nonce and counter, and
+// compares with the one-message implementation. Lengths include 5 bytes, the
+// size of a QUIC header protection mask.
+bool test_multi(const char *name) {
+  uint8_t *buf = malloc(MAX_MSGS * 300);
+  uint8_t *out = malloc(MAX_MSGS * 300);
+  uint8_t exp[300];
+  uint8_t keys[MAX_MSGS * 32], nonces[MAX_MSGS * 12];
+  uint8_t *src[MAX_MSGS], *dst[MAX_MSGS], *k[MAX_MSGS], *n[MAX_MSGS];
+  uint32_t lens[MAX_MSGS], ctrs[MAX_MSGS];
+  for (uint32_t i = 0; i < MAX_MSGS * 300; i++)
+    buf[i] = (uint8_t)(i * 29 + 3);
+  for (uint32_t i = 0; i < MAX_MSGS * 32; i++)
+    keys[i] = (uint8_t)(i * 7 + 1);
+  for (uint32_t i = 0; i < MAX_MSGS * 12; i++)
+    nonces[i] = (uint8_t)(i * 13 + 5);
 
+  bool ok = true;
+  uint32_t ns[] = { 0, 1, 3, 4, 5, 8, 9, MAX_MSGS };
+  for (uint32_t t = 0; t < sizeof ns / sizeof ns[0]; t++) {
+    uint32_t num = ns[t];
+    for (uint32_t i = 0; i < num; i++) {
+      lens[i] = t % 2 == 0 ? 5 : (i * 67 + t * 11) % 300;
+      ctrs[i] = i * 0x01010101U + t;
+      src[i] = buf + i * 300;
+      dst[i] = out + i * 300;
+      k[i] = keys + i * 32;
+      n[i] = nonces + i * 12;
+    }
+    memset(out, 0, MAX_MSGS * 300);
+    EverCrypt_Cipher_chacha20_multi(num, lens, dst, src, k, n, ctrs);
+    for (uint32_t i = 0; i < num; i++) {
+      EverCrypt_Cipher_chacha20(lens[i], exp, src[i], k[i], n[i], ctrs[i]);
+      if (memcmp(exp, dst[i], lens[i]) != 0) {
+        printf("Chacha20 multi (%s) message %" PRIu32 "/%" PRIu32 " differs\n", name, i, num);
+        ok = false;
+      }
+    }
+  }
+  printf("Chacha20 multi (%s): %s\n", name, ok ? "Success!" : "**FAILED**");
+  free(buf);
+  free(out);
+  return ok;
+}
 
 int main() {
   EverCrypt_AutoConfig2_init();
@@ -53,6 +139,15 @@ int main() {
     ok &= print_test(vectors[i].input_len,vectors[i].input,vectors[i].key,vectors[i].nonce,vectors[i].cipher);
   }
 
+  if (EverCrypt_AutoConfig2_has_avx512())
+    ok &= test_512();
+  ok &= test_multi("default");
+  EverCrypt_AutoConfig2_disable_avx2();
+  ok &= test_multi("no avx2");
+  EverCrypt_AutoConfig2_disable_avx();
+  ok &= test_multi("no avx");
+  EverCrypt_AutoConfig2_init();
+
   uint64_t len = SIZE;
   uint8_t plain[SIZE];
   uint8_t key[16];
@@ -118,12 +213,36 @@ int main() {
   double diff3 = t2 - t1;
   uint64_t cyc3 = b - a;
 
+
+  memset(plain,'P',SIZE);
+  memset(key,'K',16);
+  memset(nonce,'N',12);
+
+  if (EverCrypt_AutoConfig2_has_avx512()) {
+    for (int j = 0; j < ROUNDS; j++) {
+      Hacl_Chacha20_Vec512_chacha20_encrypt_512(SIZE,plain,plain,key,nonce,1);
+    }
+
+    t1 = clock();
+    a = cpucycles_begin();
+    for (int j = 0; j < ROUNDS; j++) {
+      Hacl_Chacha20_Vec512_chacha20_encrypt_512(SIZE,plain,plain,key,nonce,1);
+    }
+    b = cpucycles_end();
+    t2 = clock();
+  }
+  double diff4 = t2 - t1;
+  uint64_t cyc4 = b - a;
+
   uint64_t count = ROUNDS * SIZE;
   printf("32-bit Chacha20\n"); print_time(count,diff1,cyc1);
   printf("128-bit Chacha20\n"); print_time(count,diff2,cyc2);
   if (EverCrypt_AutoConfig2_has_avx2()) {
     printf("256-bit Chacha20\n"); print_time(count,diff3,cyc3);
   }
+  if (EverCrypt_AutoConfig2_has_avx512()) {
+    printf("512-bit Chacha20\n"); print_time(count,diff4,cyc4);
+  }
 
   if (ok) return EXIT_SUCCESS;
   else return EXIT_FAILURE;
@@ -12,11 +12,15 @@
 #include "Hacl_Chacha20Poly1305_32.h"
 #include "Hacl_Chacha20Poly1305_128.h"
 #include "Hacl_Chacha20Poly1305_256.h"
+#include "Hacl_Chacha20Poly1305_512.h"
 #include "EverCrypt_AutoConfig2.h"
+#include "EverCrypt_Chacha20Poly1305.h"
 
 #include "test_helpers.h"
 #include "chacha20poly1305_vectors.h"
 
+#include <openssl/evp.h>
+
 #define ROUNDS 100000
 #define SIZE   16384
 
@@ -68,9 +72,220 @@ bool print_test(int in_len, uint8_t* in, uint8_t* key, uint8_t* nonce, int aad_l
     ok = ok && print_result(in_len,plaintext,in);
   }
 
+  if (EverCrypt_AutoConfig2_has_avx512()) {
+    Hacl_Chacha20Poly1305_512_aead_encrypt(key, nonce, aad_len, aad, in_len, in, ciphertext, mac);
+    printf("Chacha20Poly1305 (512-bit) Result (chacha20):\n");
+    ok = ok && print_result(in_len,ciphertext,exp_cipher);
+    printf("(poly1305):\n");
+    ok = ok && print_result(16,mac,exp_mac);
+
+    res = Hacl_Chacha20Poly1305_512_aead_decrypt(key, nonce, aad_len, aad, in_len, plaintext, exp_cipher, exp_mac);
+    if (res != 0) printf("AEAD Decrypt (Chacha20/Poly1305) failed \n.");
+    ok = ok && (res == 0);
+    ok = ok && print_result(in_len,plaintext,in);
+  }
+
+  return ok;
+}
+
+typedef void (*aead_encrypt_fn)(uint8_t *k, uint8_t *n, uint32_t aadlen, uint8_t *aad, uint32_t mlen,
+  uint8_t *m, uint8_t *cipher, uint8_t *mac);
+typedef uint32_t (*aead_decrypt_fn)(uint8_t *k, uint8_t *n, uint32_t aadlen, uint8_t *aad, uint32_t mlen,
+  uint8_t *m, uint8_t *cipher, uint8_t *mac);
+
+static void ossl_encrypt(uint8_t *key, uint8_t *nonce, uint32_t aad_len, uint8_t *aad, uint32_t len,
+  uint8_t *plain, uint8_t *cipher, uint8_t *tag)
+{
+  int olen;
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  EVP_EncryptInit_ex(ctx, EVP_chacha20_poly1305(), NULL, key, nonce);
+  EVP_EncryptUpdate(ctx, NULL, &olen, aad, aad_len);
+  EVP_EncryptUpdate(ctx, cipher, &olen, plain, len);
+  EVP_EncryptFinal_ex(ctx, cipher + olen, &olen);
+  EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, 16, tag);
+  EVP_CIPHER_CTX_free(ctx);
+}
+
+// Messages on both sides of the length from which encryption interleaves
+// ChaCha20 and Poly1305 over chunks, checked against OpenSSL, in place and out
+// of place.
+static bool test_large(const char *name, aead_encrypt_fn enc, aead_decrypt_fn dec) {
+  uint32_t sizes[] = { 4095, 4096, 4097, 3 * 4096 + 17, 65536 + 512, 1000000, (1 << 25) + 4097 };
+  uint8_t key[32], nonce[12], aad[29], tag[16], exp_tag[16];
+  for (int i = 0; i < 32; i++) key[i] = (uint8_t)(i * 7);
+  for (int i = 0; i < 12; i++) nonce[i] = (uint8_t)(i + 100);
+  for (int i = 0; i < 29; i++) aad[i] = (uint8_t)(i * 3);
+
+  bool ok = true;
+  for (size_t t = 0; t < sizeof sizes / sizeof sizes[0]; t++) {
+    uint32_t len = sizes[t];
+    uint8_t *plain = malloc(len), *cipher = malloc(len), *exp = malloc(len), *buf = malloc(len);
+    for (uint32_t i = 0; i < len; i++)
+      plain[i] = (uint8_t)(i * 13 + t);
+    ossl_encrypt(key, nonce, 29, aad, len, plain, exp, exp_tag);
+
+    enc(key, nonce, 29, aad, len, plain, cipher, tag);
+    bool r = memcmp(cipher, exp, len) == 0 && memcmp(tag, exp_tag, 16) == 0;
+    r = r && dec(key, nonce, 29, aad, len, buf, cipher, tag) == 0 && memcmp(buf, plain, len) == 0;
+
+    memcpy(buf, plain, len);
+    enc(key, nonce, 29, aad, len, buf, buf, tag);
+    r = r && memcmp(buf, exp, len) == 0 && memcmp(tag, exp_tag, 16) == 0;
+    r = r && dec(key, nonce, 29, aad, len, buf, buf, tag) == 0 && memcmp(buf, plain, len) == 0;
+
+    // The tag is checked before any plaintext is written: a forgery leaves
+    // the output untouched, and an in-place forgery keeps its ciphertext.
+    cipher[len - 1] ^= 1;
+    memset(buf, 0xff, len);
+    r = r && dec(key, nonce, 29, aad, len, buf, cipher, tag) == 1;
+    for (uint32_t i = 0; r && i < len; i++)
+      r = buf[i] == 0xff;
+    memcpy(buf, cipher, len);
+    r = r && dec(key, nonce, 29, aad, len, buf, buf, tag) == 1 && memcmp(buf, cipher, len) == 0;
+
+    if (!r)
+      printf("Chacha20Poly1305 (%s) %" PRIu32 " bytes: **FAILED**\n", name, len);
+    ok = ok && r;
+    free(plain);
+    free(cipher);
+    free(exp);
+    free(buf);
+  }
+  printf("Chacha20Poly1305 (%s) large messages: %s\n", name, ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+typedef void (*aead_encrypt_multi_fn)(uint32_t num, uint8_t **k, uint8_t **n, uint32_t *aadlen,
+  uint8_t **aad, uint32_t *mlen, uint8_t **m, uint8_t **cipher, uint8_t **mac);
+typedef uint32_t (*aead_decrypt_multi_fn)(uint32_t num, uint8_t **k, uint8_t **n, uint32_t *aadlen,
+  uint8_t **aad, uint32_t *mlen, uint8_t **m, uint8_t **cipher, uint8_t **mac, uint32_t *res);
+
+#define MAX_JOBS 41
+#define MAX_LEN  1300
+
+// Batches of independent packets with distinct keys and nonces, and lengths
+// that are equal, spread over a full MTU, or short, compared with the
+// single-message implementation.
+static bool test_multi(const char *name, aead_encrypt_multi_fn enc, aead_decrypt_multi_fn dec) {
+  uint8_t *buf = malloc(MAX_JOBS * (32 + 12 + 40 + 4 * MAX_LEN + 32));
+  uint8_t *k[MAX_JOBS], *n[MAX_JOBS], *aad[MAX_JOBS], *m[MAX_JOBS], *c[MAX_JOBS], *d[MAX_JOBS],
+    *exp[MAX_JOBS], *tag[MAX_JOBS], *exp_tag[MAX_JOBS];
+  uint32_t aadlen[MAX_JOBS], mlen[MAX_JOBS], res[MAX_JOBS];
+  uint8_t *p = buf;
+  for (uint32_t j = 0; j < MAX_JOBS; j++) {
+    k[j] = p; p += 32;
+    n[j] = p; p += 12;
+    aad[j] = p; p += 40;
+    m[j] = p; p += MAX_LEN;
+    c[j] = p; p += MAX_LEN;
+    d[j] = p; p += MAX_LEN;
+    exp[j] = p; p += MAX_LEN;
+    tag[j] = p; p += 16;
+    exp_tag[j] = p; p += 16;
+  }
+  for (uint8_t *q = buf; q < p; q++)
+    *q = (uint8_t)((q - buf) * 29 + 3);
+
+  bool ok = true;
+  uint32_t nums[] = { 0, 1, 3, 4, 5, 8, 9, 16, MAX_JOBS };
+  for (uint32_t t = 0; t < sizeof nums / sizeof nums[0]; t++) {
+    for (uint32_t shape = 0; shape < 3; shape++) {
+      uint32_t num = nums[t];
+      for (uint32_t j = 0; j < num; j++) {
+        aadlen[j] = (j * 5 + t) % 41;
+        mlen[j] = shape == 0 ? 1200 : shape == 1 ? (j * 97 + t * 31) % (MAX_LEN + 1) : (j * 7 + t) % 80;
+        Hacl_Chacha20Poly1305_32_aead_encrypt(k[j], n[j], aadlen[j], aad[j], mlen[j], m[j], exp[j],
+          exp_tag[j]);
+      }
+      bool r = true;
+      enc(num, k, n, aadlen, aad, mlen, m, c, tag);
+      for (uint32_t j = 0; j < num; j++)
+        r = r && memcmp(c[j], exp[j], mlen[j]) == 0 && memcmp(tag[j], exp_tag[j], 16) == 0;
+      r = r && dec(num, k, n, aadlen, aad, mlen, d, c, tag, res) == 0;
+      for (uint32_t j = 0; j < num; j++)
+        r = r && res[j] == 0 && memcmp(d[j], m[j], mlen[j]) == 0;
+
+      // In place.
+      for (uint32_t j = 0; j < num; j++)
+        memcpy(d[j], m[j], mlen[j]);
+      enc(num, k, n, aadlen, aad, mlen, d, d, tag);
+      for (uint32_t j = 0; j < num; j++)
+        r = r && memcmp(d[j], exp[j], mlen[j]) == 0;
+      r = r && dec(num, k, n, aadlen, aad, mlen, d, d, tag, res) == 0;
+      for (uint32_t j = 0; j < num; j++)
+        r = r && memcmp(d[j], m[j], mlen[j]) == 0;
+
+      // Forgeries only fail their own job, whose output is zeroed.
+      for (uint32_t j = 0; j < num; j += 3)
+        tag[j][j % 16] ^= 0x80;
+      for (uint32_t j = 0; j < num; j++)
+        memset(d[j], 0xff, mlen[j]);
+      r = r && dec(num, k, n, aadlen, aad, mlen, d, c, tag, res) == (num > 0 ? 1 : 0);
+      for (uint32_t j = 0; j < num; j++) {
+        r = r && res[j] == (j % 3 == 0 ? 1 : 0);
+        for (uint32_t i = 0; r && i < mlen[j]; i++)
+          r = d[j][i] == (j % 3 == 0 ? 0 : m[j][i]);
+      }
+      if (!r)
+        printf("Chacha20Poly1305 multi (%s) %" PRIu32 " jobs, shape %" PRIu32 ": **FAILED**\n",
+          name, num, shape);
+      ok = ok && r;
+    }
+  }
+  printf("Chacha20Poly1305 multi (%s): %s\n", name, ok ? "Success!" : "**FAILED**");
+  free(buf);
   return ok;
 }
 
+static void bench_multi(const char *name, uint32_t num, uint32_t len) {
+  uint8_t *buf = malloc(num * (32 + 12 + 16 + 16 + 2 * len));
+  uint8_t *k[64], *n[64], *aad[64], *m[64], *c[64], *tag[64];
+  uint32_t aadlen[64], mlen[64];
+  uint8_t *p = buf;
+  for (uint32_t j = 0; j < num; j++) {
+    k[j] = p; p += 32;
+    n[j] = p; p += 12;
+    aad[j] = p; p += 16;
+    tag[j] = p; p += 16;
+    m[j] = p; p += len;
+    c[j] = p; p += len;
+    aadlen[j] = 16;
+    mlen[j] = len;
+  }
+  memset(buf, 'P', p - buf);
+
+  uint32_t rounds = 20000000 / (num * (len + 64));
+  cycles a, b, c1, d;
+  clock_t t1, t2, t3, t4;
+  t1 = clock();
+  a = cpucycles_begin();
+  for (uint32_t r = 0; r < rounds; r++)
+    for (uint32_t j = 0; j < num; j++)
+      EverCrypt_Chacha20Poly1305_aead_encrypt(k[j], n[j], aadlen[j], aad[j], mlen[j], m[j], c[j], tag[j]);
+  b = cpucycles_end();
+  t2 = clock();
+  t3 = clock();
+  c1 = cpucycles_begin();
+  for (uint32_t r = 0; r < rounds; r++)
+    EverCrypt_Chacha20Poly1305_aead_encrypt_multi(num, k, n, aadlen, aad, mlen, m, c, tag);
+  d = cpucycles_end();
+  t4 = clock();
+  uint64_t count = (uint64_t)rounds * num * len;
+  printf("Chacha20Poly1305 Encrypt (%s), %" PRIu32 " x %" PRIu32 " bytes, one at a time PERF:\n",
+    name, num, len);
+  print_time(count, t2 - t1, b - a);
+  printf("Chacha20Poly1305 Encrypt (%s), %" PRIu32 " x %" PRIu32 " bytes, aead_encrypt_multi PERF:\n",
+    name, num, len);
+  print_time(count, t4 - t3, d - c1);
+  free(buf);
+}
+
+static void bench_multi_all(const char *name) {
+  uint32_t lens[] = { 64, 256, 1200 };
+  for (uint32_t i = 0; i < sizeof lens / sizeof lens[0]; i++)
+    bench_multi(name, 64, lens[i]);
+}
+
 int main(){
   EverCrypt_AutoConfig2_init();
 
@@ -78,6 +293,13 @@ int main(){
   for (int i = 0; i < sizeof(vectors)/sizeof(chacha20poly1305_test_vector); ++i) {
     ok &= print_test(vectors[i].input_len,vectors[i].input,vectors[i].key,vectors[i].nonce,vectors[i].aad_len,vectors[i].aad,vectors[i].tag,vectors[i].cipher);
   }
+  ok &= test_large("32-bit", Hacl_Chacha20Poly1305_32_aead_encrypt, Hacl_Chacha20Poly1305_32_aead_decrypt);
+  ok &= test_large("128-bit", Hacl_Chacha20Poly1305_128_aead_encrypt, Hacl_Chacha20Poly1305_128_aead_decrypt);
+  if (EverCrypt_AutoConfig2_has_avx2())
+    ok &= test_large("256-bit", Hacl_Chacha20Poly1305_256_aead_encrypt, Hacl_Chacha20Poly1305_256_aead_decrypt);
+  if (EverCrypt_AutoConfig2_has_avx512())
+    ok &= test_large("512-bit", Hacl_Chacha20Poly1305_512_aead_encrypt, Hacl_Chacha20Poly1305_512_aead_decrypt);
+  ok &= test_large("EverCrypt", EverCrypt_Chacha20Poly1305_aead_encrypt, EverCrypt_Chacha20Poly1305_aead_decrypt);
 
   uint8_t plain[SIZE];
   uint8_t cipher[SIZE];
@@ -147,6 +369,26 @@ int main(){
   cycles cdiff3 = b - a;
 
 
+  if (EverCrypt_AutoConfig2_has_avx512()) {
+    memset(plain,'P',SIZE);
+    memset(aead_key,'K',32);
+    for (int j = 0; j < ROUNDS; j++) {
+      Hacl_Chacha20Poly1305_512_aead_encrypt(aead_key, aead_nonce, aad_len, aead_aad, SIZE, plain, cipher, tag);
+    }
+
+    t1 = clock();
+    a = cpucycles_begin();
+    for (int j = 0; j < ROUNDS; j++) {
+      Hacl_Chacha20Poly1305_512_aead_encrypt(aead_key, aead_nonce, aad_len, aead_aad, SIZE, plain, cipher, tag);
+      res ^= tag[0] ^ tag[15];
+    }
+    b = cpucycles_end();
+    t2 = clock();
+  }
+  clock_t tdiff7 = t2 - t1;
+  cycles cdiff7 = b - a;
+
+
   int res1 = 0;
   for (int j = 0; j < ROUNDS; j++) {
     res1 = Hacl_Chacha20Poly1305_32_aead_decrypt(aead_key, aead_nonce, aad_len, aead_aad, SIZE, plain, cipher, tag);
@@ -216,12 +458,34 @@ int main(){
   if (EverCrypt_AutoConfig2_has_avx2()) {
     printf("Chacha20Poly1305 Encrypt (256-bit) PERF:\n"); print_time(count,tdiff3,cdiff3);
   }
+  if (EverCrypt_AutoConfig2_has_avx512()) {
+    printf("Chacha20Poly1305 Encrypt (512-bit) PERF:\n"); print_time(count,tdiff7,cdiff7);
+  }
   printf("Chacha20Poly1305 Decrypt (32-bit) PERF:\n");  print_time(count,tdiff4,cdiff4);
   printf("Chacha20Poly1305 Decrypt (128-bit) PERF:\n"); print_time(count,tdiff5,cdiff5);
   if (EverCrypt_AutoConfig2_has_avx2()) {
     printf("Chacha20Poly1305 Decrypt (256-bit) PERF:\n"); print_time(count,tdiff6,cdiff6);
   }
 
+  ok &= test_multi("128-bit", Hacl_Chacha20Poly1305_128_aead_encrypt_multi,
+    Hacl_Chacha20Poly1305_128_aead_decrypt_multi);
+  if (EverCrypt_AutoConfig2_has_avx2())
+    ok &= test_multi("256-bit", Hacl_Chacha20Poly1305_256_aead_encrypt_multi,
+      Hacl_Chacha20Poly1305_256_aead_decrypt_multi);
+  ok &= test_multi("EverCrypt", EverCrypt_Chacha20Poly1305_aead_encrypt_multi,
+    EverCrypt_Chacha20Poly1305_aead_decrypt_multi);
+  bench_multi_all("default");
+  EverCrypt_AutoConfig2_disable_avx512();
+  ok &= test_large("EverCrypt, no avx512", EverCrypt_Chacha20Poly1305_aead_encrypt,
+    EverCrypt_Chacha20Poly1305_aead_decrypt);
+  EverCrypt_AutoConfig2_disable_avx2();
+  ok &= test_multi("EverCrypt, no avx2", EverCrypt_Chacha20Poly1305_aead_encrypt_multi,
+    EverCrypt_Chacha20Poly1305_aead_decrypt_multi);
+  bench_multi_all("no avx2");
+  EverCrypt_AutoConfig2_disable_avx();
+  ok &= test_multi("EverCrypt, no avx", EverCrypt_Chacha20Poly1305_aead_encrypt_multi,
+    EverCrypt_Chacha20Poly1305_aead_decrypt_multi);
+
   if (ok) return EXIT_SUCCESS;
   else return EXIT_FAILURE;
 }
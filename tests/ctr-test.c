@@ -0,0 +1,123 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "EverCrypt_CTR.h"
+#include "EverCrypt_AutoConfig2.h"
+
+#include "test_helpers.h"
+
+#define ROUNDS 4096
+#define SIZE   (1024*1024)
+
+static uint8_t key[32] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+// Reference: one call to update_block per block, as before.
+static void ctr_by_block(Spec_Agile_Cipher_cipher_alg a, uint8_t *iv, uint32_t iv_len, uint32_t c,
+  uint32_t len, uint8_t *out, uint8_t *in)
+{
+  EverCrypt_CTR_state_s *s;
+  EverCrypt_CTR_create_in(a, &s, key, iv, iv_len, c);
+  uint32_t bl = EverCrypt_CTR_block_len(s);
+  for (uint32_t i = 0; i < len / bl; i++)
+    EverCrypt_CTR_update_block(s, out + i * bl, in + i * bl);
+  EverCrypt_CTR_free(s);
+}
+
+static bool test_blocks(const char *name, Spec_Agile_Cipher_cipher_alg a, uint8_t *iv, uint32_t iv_len,
+  uint32_t c, uint32_t len)
+{
+  uint8_t *in = malloc(len), *exp = malloc(len), *comp = malloc(len);
+  for (uint32_t i = 0; i < len; i++)
+    in[i] = (uint8_t)(i * 7 + 3);
+  ctr_by_block(a, iv, iv_len, c, len, exp, in);
+
+  EverCrypt_CTR_state_s *s;
+  EverCrypt_CTR_create_in(a, &s, key, iv, iv_len, c);
+  EverCrypt_CTR_update_blocks(s, comp, in, len);
+  bool ok = memcmp(comp, exp, len) == 0;
+
+  // Same stream, fed in irregular chunks through the streaming API.
+  EverCrypt_CTR_init(s, key, iv, iv_len, c);
+  memset(comp, 0, len);
+  uint32_t chunks[] = { 1, 15, 17, 64, 3, 129, 250, 31, 1000 };
+  uint32_t off = 0;
+  for (uint32_t i = 0; off < len; i++) {
+    uint32_t n = chunks[i % (sizeof chunks / sizeof chunks[0])];
+    if (n > len - off)
+      n = len - off;
+    EverCrypt_CTR_update(s, comp + off, in + off, n);
+    off += n;
+  }
+  ok = ok && memcmp(comp, exp, len) == 0;
+  EverCrypt_CTR_free(s);
+
+  printf("CTR %s (%" PRIu32 " bytes, ctr=%" PRIu32 "): %s\n", name, len, c, ok ? "Success!" : "**FAILED**");
+  free(in);
+  free(exp);
+  free(comp);
+  return ok;
+}
+
+static void bench(const char *name, Spec_Agile_Cipher_cipher_alg a, uint8_t *iv, bool blocks) {
+  uint8_t *plain = malloc(SIZE);
+  memset(plain, 'P', SIZE);
+  EverCrypt_CTR_state_s *s;
+  EverCrypt_CTR_create_in(a, &s, key, iv, 12, 0);
+  uint32_t bl = EverCrypt_CTR_block_len(s);
+
+  cycles a0, b0;
+  clock_t t1, t2;
+  t1 = clock();
+  a0 = cpucycles_begin();
+  for (int j = 0; j < ROUNDS / 16; j++) {
+    if (blocks)
+      EverCrypt_CTR_update_blocks(s, plain, plain, SIZE);
+    else
+      for (uint32_t i = 0; i < SIZE / bl; i++)
+        EverCrypt_CTR_update_block(s, plain + i * bl, plain + i * bl);
+  }
+  b0 = cpucycles_end();
+  t2 = clock();
+  printf("CTR %s (%s) PERF:\n", name, blocks ? "update_blocks" : "update_block");
+  print_time((uint64_t)ROUNDS / 16 * SIZE, t2 - t1, b0 - a0);
+  EverCrypt_CTR_free(s);
+  free(plain);
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+  bool ok = true;
+
+  uint8_t iv[16] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab };
+  // The low 32 bits of the counter block wrap after two blocks.
+  uint8_t iv_wrap[16] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    0xa8, 0xa9, 0xaa, 0xab, 0xff, 0xff, 0xff, 0xfe };
+
+  bool aes = EverCrypt_AutoConfig2_has_aesni() && EverCrypt_AutoConfig2_has_pclmulqdq() &&
+    EverCrypt_AutoConfig2_has_avx() && EverCrypt_AutoConfig2_has_sse();
+  if (aes) {
+    ok &= test_blocks("AES128", Spec_Agile_Cipher_AES128, iv, 12, 0, 16 * 1031);
+    ok &= test_blocks("AES256", Spec_Agile_Cipher_AES256, iv, 12, 5, 16 * 1031);
+    ok &= test_blocks("AES128 (inc32 wrap)", Spec_Agile_Cipher_AES128, iv_wrap, 16, 0, 16 * 9);
+    ok &= test_blocks("AES256 (ctr wrap)", Spec_Agile_Cipher_AES256, iv, 12, 0xfffffffd, 16 * 9);
+  }
+  ok &= test_blocks("CHACHA20", Spec_Agile_Cipher_CHACHA20, iv, 12, 1, 64 * 1031);
+  ok &= test_blocks("CHACHA20 (ctr wrap)", Spec_Agile_Cipher_CHACHA20, iv, 12, 0xfffffffd, 64 * 9);
+
+  if (aes) {
+    bench("AES128", Spec_Agile_Cipher_AES128, iv, false);
+    bench("AES128", Spec_Agile_Cipher_AES128, iv, true);
+  }
+  bench("CHACHA20", Spec_Agile_Cipher_CHACHA20, iv, false);
+  bench("CHACHA20", Spec_Agile_Cipher_CHACHA20, iv, true);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
@@ -0,0 +1,119 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "EverCrypt_AutoConfig2.h"
+#include "EverCrypt_Curve25519.h"
+#include "Hacl_Curve25519_256.h"
+#include "Hacl_Curve25519_51.h"
+
+#include "test_helpers.h"
+#include "curve25519_vectors.h"
+
+#define ROUNDS 10000
+#define BATCH  64
+
+
+// Every lane of the batch must agree with the 51-bit ladder, for batch sizes
+// that leave partial groups and for u-coordinates that are not reduced.
+bool test_batch(void){
+  static uint8_t priv[BATCH][32], pub[BATCH][32], comp[BATCH][32];
+  uint8_t *privs[BATCH], *pubs[BATCH], *comps[BATCH];
+  uint8_t exp[32];
+  bool ok = true;
+  for (int i = 0; i < BATCH; i++) {
+    for (int j = 0; j < 32; j++) {
+      priv[i][j] = (uint8_t)(i * 97 + j * 31 + (i >> 3) * j);
+      pub[i][j] = (uint8_t)(i * 13 + j * 59 + (i >> 2) * j + 1);
+    }
+    privs[i] = priv[i];
+    pubs[i] = pub[i];
+    comps[i] = comp[i];
+  }
+  memset(priv[0], 0, 32);
+  memset(priv[1], 0xff, 32);
+  memset(pub[2], 0xff, 32);
+  memset(pub[3], 0, 32);
+  memset(pub[5], 0xff, 32);
+  pub[5][0] = 0xec;
+  pub[5][31] = 0x7f;
+  for (int n = 0; n <= BATCH; n++) {
+    memset(comp, 0, sizeof comp);
+    Hacl_Curve25519_256_batch_scalarmult(n, comps, privs, pubs);
+    for (int i = 0; i < n; i++) {
+      Hacl_Curve25519_51_scalarmult(exp, priv[i], pub[i]);
+      ok &= memcmp(comp[i], exp, 32) == 0;
+    }
+  }
+  for (int i = 0; i < sizeof(vectors)/sizeof(curve25519_test_vector); ++i) {
+    uint8_t *s = vectors[i].scalar, *p = vectors[i].public;
+    uint8_t *c = comp[0];
+    EverCrypt_Curve25519_batch_scalarmult(1, &c, &s, &p);
+    ok &= memcmp(comp[0], vectors[i].secret, 32) == 0;
+  }
+  printf("Curve25519 (4-way AVX2) batch_scalarmult: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+  if (!EverCrypt_AutoConfig2_has_avx2())
+    return EXIT_SUCCESS;
+
+  bool ok = test_batch();
+
+  static uint8_t pub[BATCH][32], priv[BATCH][32], key[BATCH][32];
+  uint8_t *pubs[BATCH], *privs[BATCH], *keys[BATCH];
+  uint64_t res = 0;
+  cycles a,b;
+  clock_t t1,t2;
+
+  for (int i = 0; i < BATCH; i++) {
+    memset(pub[i],'P' + i,32);
+    memset(priv[i],'S' + i,32);
+    pubs[i] = pub[i];
+    privs[i] = priv[i];
+    keys[i] = key[i];
+  }
+  for (int j = 0; j < ROUNDS / BATCH; j++) {
+    Hacl_Curve25519_256_batch_scalarmult(BATCH, pubs, privs, pubs);
+  }
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS / BATCH; j++) {
+    Hacl_Curve25519_256_batch_scalarmult(BATCH, keys, privs, pubs);
+    res ^= key[0][0] ^ key[BATCH - 1][15];
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  clock_t tdiff1 = t2 - t1;
+  cycles cdiff1 = b - a;
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS / BATCH; j++) {
+    for (int i = 0; i < BATCH; i++)
+      EverCrypt_Curve25519_scalarmult(key[i], priv[i], pub[i]);
+    res ^= key[0][0] ^ key[BATCH - 1][15];
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  clock_t tdiff2 = t2 - t1;
+  cycles cdiff2 = b - a;
+
+  uint64_t count = ROUNDS / BATCH * BATCH;
+  printf("Curve25519 (4-way AVX2) batch PERF:\n"); print_time(count,tdiff1,cdiff1);
+  printf("EverCrypt Curve25519 scalarmult PERF:\n"); print_time(count,tdiff2,cdiff2);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
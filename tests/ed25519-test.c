@@ -0,0 +1,287 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "Hacl_Ed25519.h"
+
+#include "test_helpers.h"
+
+#define NSIGS   150
+#define MAX_LEN 300
+#define ROUNDS  20
+
+typedef struct {
+  uint8_t secret[32];
+  uint8_t public[32];
+  uint32_t msg_len;
+  uint8_t msg[2];
+  uint8_t sig[64];
+} ed25519_test_vector;
+
+// RFC 8032, Section 7.1, tests 1 to 3.
+static ed25519_test_vector vectors[] = {
+  {
+    .secret = {
+      0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60, 0xba, 0x84, 0x4a, 0xf4, 0x92, 0xec, 0x2c, 0xc4,
+      0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32, 0x69, 0x19, 0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60
+    },
+    .public = {
+      0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a,
+      0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a
+    },
+    .msg_len = 0,
+    .msg = { 0 },
+    .sig = {
+      0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72, 0x90, 0x86, 0xe2, 0xcc, 0x80, 0x6e, 0x82, 0x8a,
+      0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5, 0xd9, 0x74, 0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55,
+      0x5f, 0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac, 0xc6, 0x1e, 0x39, 0x70, 0x1c, 0xf9, 0xb4, 0x6b,
+      0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe, 0x24, 0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b
+    }
+  },
+  {
+    .secret = {
+      0x4c, 0xcd, 0x08, 0x9b, 0x28, 0xff, 0x96, 0xda, 0x9d, 0xb6, 0xc3, 0x46, 0xec, 0x11, 0x4e, 0x0f,
+      0x5b, 0x8a, 0x31, 0x9f, 0x35, 0xab, 0xa6, 0x24, 0xda, 0x8c, 0xf6, 0xed, 0x4f, 0xb8, 0xa6, 0xfb
+    },
+    .public = {
+      0x3d, 0x40, 0x17, 0xc3, 0xe8, 0x43, 0x89, 0x5a, 0x92, 0xb7, 0x0a, 0xa7, 0x4d, 0x1b, 0x7e, 0xbc,
+      0x9c, 0x98, 0x2c, 0xcf, 0x2e, 0xc4, 0x96, 0x8c, 0xc0, 0xcd, 0x55, 0xf1, 0x2a, 0xf4, 0x66, 0x0c
+    },
+    .msg_len = 1,
+    .msg = { 0x72 },
+    .sig = {
+      0x92, 0xa0, 0x09, 0xa9, 0xf0, 0xd4, 0xca, 0xb8, 0x72, 0x0e, 0x82, 0x0b, 0x5f, 0x64, 0x25, 0x40,
+      0xa2, 0xb2, 0x7b, 0x54, 0x16, 0x50, 0x3f, 0x8f, 0xb3, 0x76, 0x22, 0x23, 0xeb, 0xdb, 0x69, 0xda,
+      0x08, 0x5a, 0xc1, 0xe4, 0x3e, 0x15, 0x99, 0x6e, 0x45, 0x8f, 0x36, 0x13, 0xd0, 0xf1, 0x1d, 0x8c,
+      0x38, 0x7b, 0x2e, 0xae, 0xb4, 0x30, 0x2a, 0xee, 0xb0, 0x0d, 0x29, 0x16, 0x12, 0xbb, 0x0c, 0x00
+    }
+  },
+  {
+    .secret = {
+      0xc5, 0xaa, 0x8d, 0xf4, 0x3f, 0x9f, 0x83, 0x7b, 0xed, 0xb7, 0x44, 0x2f, 0x31, 0xdc, 0xb7, 0xb1,
+      0x66, 0xd3, 0x85, 0x35, 0x07, 0x6f, 0x09, 0x4b, 0x85, 0xce, 0x3a, 0x2e, 0x0b, 0x44, 0x58, 0xf7
+    },
+    .public = {
+      0xfc, 0x51, 0xcd, 0x8e, 0x62, 0x18, 0xa1, 0xa3, 0x8d, 0xa4, 0x7e, 0xd0, 0x02, 0x30, 0xf0, 0x58,
+      0x08, 0x16, 0xed, 0x13, 0xba, 0x33, 0x03, 0xac, 0x5d, 0xeb, 0x91, 0x15, 0x48, 0x90, 0x80, 0x25
+    },
+    .msg_len = 2,
+    .msg = { 0xaf, 0x82 },
+    .sig = {
+      0x62, 0x91, 0xd6, 0x57, 0xde, 0xec, 0x24, 0x02, 0x48, 0x27, 0xe6, 0x9c, 0x3a, 0xbe, 0x01, 0xa3,
+      0x0c, 0xe5, 0x48, 0xa2, 0x84, 0x74, 0x3a, 0x44, 0x5e, 0x36, 0x80, 0xd7, 0xdb, 0x5a, 0xc3, 0xac,
+      0x18, 0xff, 0x9b, 0x53, 0x8d, 0x16, 0xf2, 0x90, 0xae, 0x67, 0xf7, 0x60, 0x98, 0x4d, 0xc6, 0x59,
+      0x4a, 0x7c, 0x15, 0xe9, 0x71, 0x6e, 0xd2, 0x8d, 0xc0, 0x27, 0xbe, 0xce, 0xea, 0x1e, 0xc4, 0x0a
+    }
+  }
+};
+
+static bool test_vector(ed25519_test_vector *v) {
+  uint8_t pub[32], sig[64];
+  Hacl_Ed25519_secret_to_public(pub, v->secret);
+  bool ok = compare_and_print(32, pub, v->public);
+  Hacl_Ed25519_sign(sig, v->secret, v->msg_len, v->msg);
+  ok = compare_and_print(64, sig, v->sig) && ok;
+  ok = Hacl_Ed25519_verify(v->public, v->msg_len, v->msg, v->sig) && ok;
+  // Any flipped bit in R, in s or in the key must be rejected.
+  for (uint32_t i = 0; i < 512; i += 13) {
+    sig[i / 8] ^= (uint8_t)(1 << (i % 8));
+    ok = !Hacl_Ed25519_verify(v->public, v->msg_len, v->msg, sig) && ok;
+    sig[i / 8] ^= (uint8_t)(1 << (i % 8));
+  }
+  for (uint32_t i = 0; i < 256; i += 13) {
+    pub[i / 8] ^= (uint8_t)(1 << (i % 8));
+    ok = !Hacl_Ed25519_verify(pub, v->msg_len, v->msg, v->sig) && ok;
+    pub[i / 8] ^= (uint8_t)(1 << (i % 8));
+  }
+  uint8_t *pubs[1] = { v->public }, *msgs[1] = { v->msg }, *sigs[1] = { v->sig };
+  uint32_t lens[1] = { v->msg_len };
+  bool res[1] = { false };
+  ok = Hacl_Ed25519_verify_batch(1, pubs, lens, msgs, sigs, res) && res[0] && ok;
+  return ok;
+}
+
+static uint8_t *pub[NSIGS], *msg[NSIGS], *sig[NSIGS];
+static uint32_t len[NSIGS];
+
+static void setup(void) {
+  for (uint32_t i = 0; i < NSIGS; i++) {
+    uint8_t secret[32];
+    for (uint32_t j = 0; j < 32; j++)
+      secret[j] = (uint8_t)(i * 31 + j * 7 + 1);
+    len[i] = i * 37 % (MAX_LEN + 1);
+    pub[i] = malloc(32);
+    sig[i] = malloc(64);
+    msg[i] = malloc(len[i] + 1);
+    for (uint32_t j = 0; j < len[i]; j++)
+      msg[i][j] = (uint8_t)(i + j * 3);
+    Hacl_Ed25519_secret_to_public(pub[i], secret);
+    Hacl_Ed25519_sign(sig[i], secret, len[i], msg[i]);
+  }
+}
+
+// The batch must agree with Hacl_Ed25519_verify signature by signature, across
+// several chunks, and only report success when every signature is valid.
+static bool check_batch(const char *name, uint32_t n, bool expected) {
+  bool res[NSIGS];
+  memset(res, 0, sizeof(res));
+  bool all = Hacl_Ed25519_verify_batch(n, pub, len, msg, sig, res);
+  bool ok = all == expected;
+  for (uint32_t i = 0; i < n; i++) {
+    bool exp = Hacl_Ed25519_verify(pub[i], len[i], msg[i], sig[i]);
+    if (res[i] != exp) {
+      printf("signature %" PRIu32 ": batch says %d, verify says %d\n", i, res[i], exp);
+      ok = false;
+    }
+  }
+  printf("%s: %s\n", name, ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+static bool test_batch(void) {
+  bool ok = check_batch("empty batch", 0, true);
+  ok = check_batch("valid batch", NSIGS, true) && ok;
+
+  // A wrong message, a wrong key, a non-canonical s, an R that does not
+  // decode, and two signatures swapped: the batch fails and the fallback
+  // pinpoints each one.
+  msg[3][0] ^= 0x01;
+  uint8_t *p = pub[70]; pub[70] = pub[71]; pub[71] = p;
+  uint8_t s100[32], r[32];
+  memcpy(s100, sig[100] + 32, 32);
+  memset(sig[100] + 32, 0xff, 32);
+  memcpy(r, sig[130], 32);
+  memset(sig[130], 0, 32);
+  sig[130][0] = 2;
+  uint8_t *s = sig[148]; sig[148] = sig[149]; sig[149] = s;
+  ok = check_batch("invalid batch", NSIGS, false) && ok;
+  ok = check_batch("invalid first chunk", 64, false) && ok;
+
+  msg[3][0] ^= 0x01;
+  p = pub[70]; pub[70] = pub[71]; pub[71] = p;
+  ok = check_batch("valid first chunk", 64, true) && ok;
+  ok = check_batch("invalid last chunk", NSIGS, false) && ok;
+  memcpy(sig[100] + 32, s100, 32);
+  memcpy(sig[130], r, 32);
+  s = sig[148]; sig[148] = sig[149]; sig[149] = s;
+  return ok;
+}
+
+// Adds the point of order 2, (0, -1), to an encoded point: (x, y) becomes
+// (-x, -y), so y is replaced with p - y and the sign of x is flipped.
+static void add_order_2(uint8_t *out, uint8_t *in) {
+  uint8_t y[32];
+  memcpy(y, in, 32);
+  uint8_t sign = y[31] & 0x80;
+  y[31] &= 0x7f;
+  int borrow = 0;
+  for (int i = 0; i < 32; i++) {
+    int pi = i == 0 ? 0xed : i == 31 ? 0x7f : 0xff;
+    int d = pi - y[i] - borrow;
+    borrow = d < 0;
+    out[i] = (uint8_t)d;
+  }
+  out[31] |= (uint8_t)(sign ^ 0x80);
+}
+
+// A signature under a public key with a small-order component: the cofactored
+// equation accepts it, Hacl_Ed25519_verify rejects it when h is odd. The batch
+// must give it the same answer whether the rest of its batch passes or not.
+static bool test_torsion(void) {
+  uint8_t secret[32], ks[96], tpub[32], tsig[64], tmsg[8];
+  bool found = false;
+  for (uint32_t j = 0; j < 64 && !found; j++) {
+    memset(secret, 'T', 32);
+    secret[0] = (uint8_t)j;
+    memset(tmsg, (int)j, sizeof(tmsg));
+    Hacl_Ed25519_expand_keys(ks, secret);
+    add_order_2(ks, ks);
+    memcpy(tpub, ks, 32);
+    Hacl_Ed25519_sign_expanded(tsig, ks, sizeof(tmsg), tmsg);
+    found = !Hacl_Ed25519_verify(tpub, sizeof(tmsg), tmsg, tsig);
+  }
+  bool ok = found;
+  uint8_t *p5 = pub[5], *m5 = msg[5], *s5 = sig[5];
+  uint32_t l5 = len[5];
+  pub[5] = tpub; msg[5] = tmsg; sig[5] = tsig; len[5] = sizeof(tmsg);
+  bool res[64];
+
+  memset(res, 0, sizeof(res));
+  ok = Hacl_Ed25519_verify_batch(64, pub, len, msg, sig, res) && res[5] && ok;
+
+  msg[3][0] ^= 0x01;
+  memset(res, 0, sizeof(res));
+  ok = !Hacl_Ed25519_verify_batch(64, pub, len, msg, sig, res) && res[5] && !res[3] && ok;
+  msg[3][0] ^= 0x01;
+
+  pub[5] = p5; msg[5] = m5; sig[5] = s5; len[5] = l5;
+  printf("torsion component: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+static void perf(void) {
+  bool res[NSIGS];
+  uint8_t secret[32], out[64];
+  cycles a, b;
+  clock_t t1, t2;
+  bool ok = true;
+  memset(secret, 'S', 32);
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    for (uint32_t i = 0; i < 128; i++)
+      Hacl_Ed25519_secret_to_public(out, secret);
+  b = cpucycles_end();
+  t2 = clock();
+  printf("secret_to_public: %.0f cycles/key, %.1f us/key\n",
+    (double)(b - a) / (ROUNDS * 128), (double)(t2 - t1) * 1e6 / CLOCKS_PER_SEC / (ROUNDS * 128));
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    for (uint32_t i = 0; i < 128; i++)
+      Hacl_Ed25519_sign(out, secret, len[i], msg[i]);
+  b = cpucycles_end();
+  t2 = clock();
+  printf("sign: %.0f cycles/signature, %.1f us/signature\n",
+    (double)(b - a) / (ROUNDS * 128), (double)(t2 - t1) * 1e6 / CLOCKS_PER_SEC / (ROUNDS * 128));
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    for (uint32_t i = 0; i < 128; i++)
+      ok &= Hacl_Ed25519_verify(pub[i], len[i], msg[i], sig[i]);
+  b = cpucycles_end();
+  t2 = clock();
+  printf("verify: %.0f cycles/signature, %.1f us/signature\n",
+    (double)(b - a) / (ROUNDS * 128), (double)(t2 - t1) * 1e6 / CLOCKS_PER_SEC / (ROUNDS * 128));
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    ok &= Hacl_Ed25519_verify_batch(128, pub, len, msg, sig, res);
+  b = cpucycles_end();
+  t2 = clock();
+  printf("verify_batch: %.0f cycles/signature, %.1f us/signature\n",
+    (double)(b - a) / (ROUNDS * 128), (double)(t2 - t1) * 1e6 / CLOCKS_PER_SEC / (ROUNDS * 128));
+  if (!ok)
+    printf("**FAILED**\n");
+}
+
+int main() {
+  bool ok = true;
+  for (int i = 0; i < sizeof(vectors)/sizeof(ed25519_test_vector); ++i)
+    ok &= test_vector(&vectors[i]);
+
+  setup();
+  ok &= test_batch();
+  ok &= test_torsion();
+  perf();
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
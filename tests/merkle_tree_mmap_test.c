@@ -0,0 +1,213 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "EverCrypt_AutoConfig2.h"
+#include "MerkleTree.h"
+#include "MerkleTree_Mmap.h"
+
+#include "test_helpers.h"
+
+static const uint32_t hash_size = 32;
+
+// Compares the root and a sample of paths of an in-memory tree and an
+// out-of-core tree holding the same leaves.
+static bool same_tree(const char *what, mt_p mt, mt_mmap_p mm, uint64_t from, uint64_t to) {
+  uint8_t *r1 = mt_init_hash(hash_size);
+  uint8_t *r2 = mt_init_hash(hash_size);
+  mt_get_root(mt, r1);
+  mt_mmap_get_root(mm, r2);
+  bool ok = memcmp(r1, r2, hash_size) == 0;
+
+  for (uint64_t k = from; ok && k < to; k += 1 + (to - from) / 97) {
+    MerkleTree_Low_path *p1 = mt_init_path(hash_size);
+    MerkleTree_Low_path *p2 = mt_init_path(hash_size);
+    uint32_t j1 = mt_get_path(mt, k, p1, r1);
+    if (!mt_mmap_get_path_pre(mm, k, p2, r2)) {
+      ok = false;
+    } else {
+      uint32_t j2 = mt_mmap_get_path(mm, k, p2, r2);
+      ok = j1 == j2 && mt_get_path_length(p1) == mt_get_path_length(p2);
+      for (uint32_t l = 0; ok && l < mt_get_path_length(p1); l++)
+        ok = memcmp(mt_get_path_step(p1, l), mt_get_path_step(p2, l), hash_size) == 0;
+      ok = ok && mt_mmap_verify(mm, k, j2, p2, r2);
+    }
+    mt_free_path(p1);
+    mt_free_path(p2);
+  }
+
+  printf("Out-of-core tree (%s): %s\n", what, ok ? "Success!" : "**FAILED**");
+  mt_free_hash(r1);
+  mt_free_hash(r2);
+  return ok;
+}
+
+static bool run_test(const char *impl) {
+  bool ok = true;
+  printf("== %s ==\n", impl);
+
+  char dir[] = "/tmp/merkle_tree_mmap_test.XXXXXX";
+  if (mkdtemp(dir) == NULL) {
+    printf("Cannot create a temporary directory\n");
+    return false;
+  }
+
+  uint32_t n = 20000;
+  uint8_t *leaves = malloc(n * hash_size);
+  for (uint32_t i = 0; i < n * hash_size; i++)
+    leaves[i] = (uint8_t)(i * 11 + 5);
+
+  mt_p mt = mt_create(leaves);
+  mt_mmap_p mm = mt_mmap_create(dir, leaves);
+  if (mm == NULL) {
+    printf("mt_mmap_create failed\n");
+    return false;
+  }
+
+  // Single insertions, then batches.
+  for (uint32_t i = 1; i < 1001; i++) {
+    uint8_t *h = mt_init_hash(hash_size);
+    memcpy(h, leaves + i * hash_size, hash_size);
+    mt_insert(mt, h);
+    mt_free_hash(h);
+    ok &= mt_mmap_insert_pre(mm, leaves + i * hash_size) &&
+      mt_mmap_insert(mm, leaves + i * hash_size);
+  }
+  ok &= same_tree("insert", mt, mm, 0, 1001);
+
+  mt_insert_batch(mt, leaves + 1001 * hash_size, 9000);
+  ok &= mt_mmap_insert_batch_pre(mm, leaves + 1001 * hash_size, 9000) &&
+    mt_mmap_insert_batch(mm, leaves + 1001 * hash_size, 9000);
+  ok &= same_tree("insert_batch", mt, mm, 0, 10001);
+
+  // Flushing, then re-opening from disk.
+  mt_flush_to(mt, 4321);
+  mt_mmap_flush_to(mm, 4321);
+  ok &= same_tree("flush_to", mt, mm, 4321, 10001);
+  ok &= mt_mmap_sync(mm);
+  mt_mmap_close(mm);
+
+  mm = mt_mmap_open(dir, NULL);
+  if (mm == NULL) {
+    printf("mt_mmap_open failed\n");
+    return false;
+  }
+  ok &= same_tree("reopen", mt, mm, 4321, 10001);
+
+  mt_insert_batch(mt, leaves + 10001 * hash_size, n - 10001);
+  ok &= mt_mmap_insert_batch(mm, leaves + 10001 * hash_size, n - 10001);
+  ok &= same_tree("insert after reopen", mt, mm, 4321, n);
+
+  mt_retract_to(mt, 15000);
+  mt_mmap_retract_to(mm, 15000);
+  ok &= same_tree("retract_to", mt, mm, 4321, 15001);
+  mt_mmap_close(mm);
+
+  // Conversion of an in-memory tree.
+  char dir2[sizeof dir + 5];
+  snprintf(dir2, sizeof dir2, "%s/copy", dir);
+  mm = mt_mmap_create_from(dir2, mt, mt_sha256_compress);
+  ok &= mm != NULL && same_tree("create_from", mt, mm, 4321, 15001);
+
+  // Opening a large tree is independent of its size.
+  {
+    uint8_t *r = mt_init_hash(hash_size);
+    cycles a, b;
+    clock_t t1, t2;
+    t1 = clock();
+    a = cpucycles_begin();
+    mt_mmap_p m2 = mt_mmap_open(dir2, NULL);
+    mt_mmap_get_root(m2, r);
+    b = cpucycles_end();
+    t2 = clock();
+    printf("Open + root of a %u-leaf tree: %" PRIu64 " cycles, %f ms\n", 15001,
+      (uint64_t)(b - a), (double)(t2 - t1) * 1000.0 / CLOCKS_PER_SEC);
+    mt_mmap_close(m2);
+    mt_free_hash(r);
+  }
+
+  mt_mmap_close(mm);
+
+  // A level file that is shorter than the header claims is rejected.
+  {
+    char lv0[sizeof dir2 + 16];
+    snprintf(lv0, sizeof lv0, "%s/level.00", dir2);
+    bool rejected = truncate(lv0, 0) == 0 && mt_mmap_open(dir2, NULL) == NULL;
+    printf("Out-of-core tree (truncated level): %s\n", rejected ? "Success!" : "**FAILED**");
+    ok &= rejected;
+  }
+
+  mt_free(mt);
+  free(leaves);
+
+  char cmd[sizeof dir + 16];
+  snprintf(cmd, sizeof cmd, "rm -rf %s", dir);
+  if (system(cmd) != 0)
+    printf("Could not remove %s\n", dir);
+
+  return ok;
+}
+
+// Same operations on a tree that lives in anonymous memory.
+static bool run_test_in_memory(void) {
+  bool ok = true;
+  uint32_t n = 20000;
+  uint8_t *leaves = malloc(n * hash_size);
+  for (uint32_t i = 0; i < n * hash_size; i++)
+    leaves[i] = (uint8_t)(i * 13 + 1);
+
+  mt_p mt = mt_create(leaves);
+  mt_mmap_p mm = mt_mmap_create(NULL, leaves);
+  if (mm == NULL) {
+    printf("mt_mmap_create(NULL) failed\n");
+    return false;
+  }
+
+  for (uint32_t i = 1; i < 777; i++) {
+    uint8_t *h = mt_init_hash(hash_size);
+    memcpy(h, leaves + i * hash_size, hash_size);
+    mt_insert(mt, h);
+    mt_free_hash(h);
+    ok &= mt_mmap_insert(mm, leaves + i * hash_size);
+  }
+  ok &= same_tree("in-memory insert", mt, mm, 0, 777);
+
+  mt_insert_batch(mt, leaves + 777 * hash_size, n - 777);
+  ok &= mt_mmap_insert_batch(mm, leaves + 777 * hash_size, n - 777);
+  ok &= same_tree("in-memory insert_batch", mt, mm, 0, n);
+
+  // Flushing releases the arena pages below the new offset.
+  mt_flush_to(mt, 12345);
+  mt_mmap_flush_to(mm, 12345);
+  ok &= mt_mmap_sync(mm) && same_tree("in-memory flush_to", mt, mm, 12345, n);
+
+  mt_retract_to(mt, 17000);
+  mt_mmap_retract_to(mm, 17000);
+  ok &= same_tree("in-memory retract_to", mt, mm, 12345, 17001);
+  mt_mmap_close(mm);
+
+  mm = mt_mmap_create_from(NULL, mt, mt_sha256_compress);
+  ok &= mm != NULL && same_tree("in-memory create_from", mt, mm, 12345, 17001);
+  ok &= mt_mmap_open(NULL, NULL) == NULL;
+
+  mt_mmap_close(mm);
+  mt_free(mt);
+  free(leaves);
+  return ok;
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+  bool ok = run_test("default");
+  // Also exercise the multi-buffer kernels, which hash sibling pairs in place.
+  EverCrypt_AutoConfig2_disable_shaext();
+  ok = ok && run_test("no shaext");
+  ok = ok && run_test_in_memory();
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
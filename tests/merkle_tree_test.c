@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <assert.h>
+#include <unistd.h>
 
 #include "EverCrypt_AutoConfig2.h"
 #include "MerkleTree.h"
@@ -32,6 +33,366 @@ void print_tree(const mt_p mt, size_t num_elts) {
   }
 }
 
+// Checks that mt_insert_batch builds the same tree as repeated mt_insert.
+bool test_insert_batch(const char *impl) {
+  uint32_t batch_elts = 1000;
+  uint8_t *leaves = malloc(batch_elts * hash_size);
+  for (uint32_t i = 0; i < batch_elts * hash_size; i++)
+    leaves[i] = (uint8_t)(i * 13 + 7);
+
+  uint8_t *init = mt_init_hash(hash_size);
+  mt_p seq = mt_create(init);
+  mt_p bat = mt_create(init);
+  mt_free_hash(init);
+
+  uint8_t *rs = mt_init_hash(hash_size);
+  uint8_t *rb = mt_init_hash(hash_size);
+  uint32_t chunks[] = { 1, 2, 3, 8, 17, 64, 5, 129, 33, 0, 250 };
+  uint32_t off = 0;
+  for (uint32_t c = 0; off < batch_elts; c++) {
+    uint32_t n = chunks[c % (sizeof chunks / sizeof chunks[0])];
+    if (n > batch_elts - off)
+      n = batch_elts - off;
+    for (uint32_t k = 0; k < n; k++) {
+      uint8_t *h = mt_init_hash(hash_size);
+      memcpy(h, leaves + (off + k) * hash_size, hash_size);
+      mt_insert(seq, h);
+      mt_free_hash(h);
+    }
+    if (!mt_insert_batch_pre(bat, leaves + off * hash_size, n)) {
+      printf("ERROR: Precondition for mt_insert_batch does not hold; exiting.\n");
+      exit(1);
+    }
+    mt_insert_batch(bat, leaves + off * hash_size, n);
+    off += n;
+
+    // Exercise insertion into partially flushed trees as well.
+    if (c == 5) {
+      mt_flush_to(seq, off / 2 + 1);
+      mt_flush_to(bat, off / 2 + 1);
+    }
+
+    mt_get_root(seq, rs);
+    mt_get_root(bat, rb);
+    if (memcmp(rs, rb, hash_size) != 0) {
+      printf("Batch insertion root mismatch after %u elements!\n", off);
+      return false;
+    }
+  }
+
+  for (uint64_t k = off / 2 + 1; k < batch_elts + 1; k += 37) {
+    MerkleTree_Low_path *cur_path = mt_init_path(hash_size);
+    uint32_t j = mt_get_path(bat, k, cur_path, rb);
+    if (!mt_verify(bat, k, j, cur_path, rb)) {
+      printf("Batch insertion path verification failed for k=%lu!\n", k);
+      return false;
+    }
+    mt_free_path(cur_path);
+  }
+  printf("Batch insertion (%s) matches sequential insertion: %s\n", impl, hash_to_string(rb));
+
+  mt_free_hash(rs);
+  mt_free_hash(rb);
+  mt_free(seq);
+  mt_free(bat);
+  free(leaves);
+
+  return true;
+}
+
+// Checks that mt_insert_batch_par builds the same tree as mt_insert_batch.
+bool test_insert_batch_par(uint32_t nthreads) {
+  uint32_t batch_elts = 20005;
+  uint8_t *leaves = malloc(batch_elts * hash_size);
+  for (uint32_t i = 0; i < batch_elts * hash_size; i++)
+    leaves[i] = (uint8_t)(i * 29 + 3);
+
+  uint8_t *init = mt_init_hash(hash_size);
+  mt_p bat = mt_create(init);
+  mt_p par = mt_create(init);
+  mt_free_hash(init);
+
+  // Start from an unaligned, partially flushed tree.
+  mt_insert_batch(bat, leaves, 5);
+  mt_insert_batch(par, leaves, 5);
+  mt_flush_to(bat, 3);
+  mt_flush_to(par, 3);
+
+  uint8_t *rb = mt_init_hash(hash_size);
+  uint8_t *rp = mt_init_hash(hash_size);
+  uint32_t sizes[] = { batch_elts - 1005, 1000 };
+  uint32_t off = 5;
+  bool ok = true;
+  for (uint32_t c = 0; c < 2; c++) {
+    mt_insert_batch(bat, leaves + off * hash_size, sizes[c]);
+    mt_insert_batch_par(par, leaves + off * hash_size, sizes[c], nthreads);
+    off += sizes[c];
+    mt_get_root(bat, rb);
+    mt_get_root(par, rp);
+    ok = ok && memcmp(rb, rp, hash_size) == 0;
+  }
+  printf("Parallel batch insertion (%u threads): %s\n", nthreads, ok ? "Success!" : "**FAILED**");
+
+  mt_free_hash(rb);
+  mt_free_hash(rp);
+  mt_free(bat);
+  mt_free(par);
+  free(leaves);
+  return ok;
+}
+
+bool test_multi_path() {
+  bool ok = true;
+  uint32_t sizes[] = { 1, 2, 3, 7, 8, 33, 100, 257, 1000 };
+  uint32_t flushes[] = { 0, 1, 5, 64 };
+  uint8_t *root = mt_init_hash(hash_size);
+  uint8_t *root2 = mt_init_hash(hash_size);
+  MerkleTree_Low_path *path = mt_init_path(hash_size);
+  MerkleTree_Low_path *single = mt_init_path(hash_size);
+  uint64_t *idxs = malloc(1000 * sizeof(uint64_t));
+
+  for (size_t si = 0; si < sizeof sizes / sizeof sizes[0]; si++) {
+    uint32_t n = sizes[si];
+    uint8_t *leaves = malloc(n * hash_size);
+    for (uint32_t i = 0; i < n * hash_size; i++)
+      leaves[i] = (uint8_t)(i * 3 + si);
+
+    for (size_t fi = 0; fi < sizeof flushes / sizeof flushes[0]; fi++) {
+      uint32_t from = flushes[fi];
+      if (from >= n)
+        continue;
+      mt_p mt = mt_create(leaves);
+      mt_insert_batch(mt, leaves + hash_size, n - 1);
+      if (from > 0)
+        mt_flush_to(mt, from);
+      mt_get_root(mt, root2);
+
+      for (uint32_t pattern = 0; pattern < 5; pattern++) {
+        // Index sets: single leaves, all leaves, every third leaf, adjacent
+        // pairs and the rightmost leaves.
+        uint32_t m = 0;
+        for (uint64_t k = from; k < n; k++) {
+          bool take =
+            pattern == 0 ? k == from + (n - from) / 2 :
+            pattern == 1 ? true :
+            pattern == 2 ? k % 3 == 1 :
+            pattern == 3 ? k % 8 < 2 :
+            k + 3 >= n;
+          if (take)
+            idxs[m++] = k;
+        }
+        if (m == 0)
+          continue;
+
+        mt_clear_path(path);
+        if (!mt_get_multi_path_pre(mt, idxs, m, path, root)) {
+          ok = false;
+          continue;
+        }
+        uint32_t j = mt_get_multi_path(mt, idxs, m, path, root);
+        bool r = j == n && memcmp(root, root2, hash_size) == 0;
+        r = r && mt_verify_multi_pre(mt, idxs, m, j, path, root) &&
+          mt_verify_multi(mt, idxs, m, j, path, root);
+
+        // No larger than the single paths, and equal to one for one index.
+        uint32_t total = 0;
+        for (uint32_t t = 0; t < m; t++) {
+          mt_clear_path(single);
+          mt_get_path(mt, idxs[t], single, root);
+          total += mt_get_path_length(single);
+        }
+        r = r && mt_get_path_length(path) <= total;
+        if (m == 1) {
+          r = r && mt_get_path_length(path) == total;
+          for (uint32_t l = 0; r && l < total; l++)
+            r = mt_get_path_step(path, l) == mt_get_path_step(single, l);
+        }
+
+        // A wrong root or a modified leaf must not verify.
+        root[0] ^= 1;
+        r = r && !mt_verify_multi(mt, idxs, m, j, path, root);
+        root[0] ^= 1;
+        uint8_t *leaf = mt_get_path_step(path, m - 1);
+        leaf[hash_size - 1] ^= 0x80;
+        r = r && !mt_verify_multi(mt, idxs, m, j, path, root);
+        leaf[hash_size - 1] ^= 0x80;
+
+        if (!r)
+          printf("Multi-path (n=%u, from=%u, pattern=%u, %u targets): **FAILED**\n",
+            n, from, pattern, m);
+        ok = ok && r;
+      }
+      mt_free(mt);
+    }
+    free(leaves);
+  }
+
+  free(idxs);
+  mt_free_path(single);
+  mt_free_path(path);
+  mt_free_hash(root2);
+  mt_free_hash(root);
+  printf("Multi-path: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+// In-memory stream for the serialization callbacks; a read limit simulates
+// truncated input.
+typedef struct {
+  uint8_t *buf;
+  uint64_t len, pos, cap, limit;
+} mem_stream;
+
+static bool mem_write(void *ctx, const uint8_t *buf, uint32_t len) {
+  mem_stream *s = ctx;
+  if (s->len + len > s->cap)
+    return false;
+  memcpy(s->buf + s->len, buf, len);
+  s->len += len;
+  return true;
+}
+
+static uint32_t mem_read(void *ctx, uint8_t *buf, uint32_t len) {
+  mem_stream *s = ctx;
+  uint64_t end = s->len < s->limit ? s->len : s->limit;
+  uint32_t n = end - s->pos < len ? (uint32_t)(end - s->pos) : len;
+  memcpy(buf, s->buf + s->pos, n);
+  s->pos += n;
+  return n;
+}
+
+static bool fd_write(void *ctx, const uint8_t *buf, uint32_t len) {
+  int fd = *(int *)ctx;
+  while (len > 0) {
+    ssize_t r = write(fd, buf, len);
+    if (r <= 0)
+      return false;
+    buf += r;
+    len -= (uint32_t)r;
+  }
+  return true;
+}
+
+static uint32_t fd_read(void *ctx, uint8_t *buf, uint32_t len) {
+  ssize_t r = read(*(int *)ctx, buf, len);
+  return r < 0 ? 0 : (uint32_t)r;
+}
+
+static bool same_paths(mt_p a, mt_p b, uint64_t from, uint64_t to) {
+  uint8_t *r1 = mt_init_hash(hash_size);
+  uint8_t *r2 = mt_init_hash(hash_size);
+  mt_get_root(a, r1);
+  mt_get_root(b, r2);
+  bool ok = memcmp(r1, r2, hash_size) == 0;
+  for (uint64_t k = from; ok && k < to; k += 1 + (to - from) / 61) {
+    MerkleTree_Low_path *p1 = mt_init_path(hash_size);
+    MerkleTree_Low_path *p2 = mt_init_path(hash_size);
+    ok = mt_get_path_pre(b, k, p2, r2);
+    uint32_t j1 = mt_get_path(a, k, p1, r1);
+    uint32_t j2 = ok ? mt_get_path(b, k, p2, r2) : 0;
+    ok = ok && j1 == j2 && mt_get_path_length(p1) == mt_get_path_length(p2);
+    for (uint32_t l = 0; ok && l < mt_get_path_length(p1); l++)
+      ok = memcmp(mt_get_path_step(p1, l), mt_get_path_step(p2, l), hash_size) == 0;
+    ok = ok && mt_verify(b, k, j2, p2, r2);
+    mt_free_path(p1);
+    mt_free_path(p2);
+  }
+  mt_free_hash(r1);
+  mt_free_hash(r2);
+  return ok;
+}
+
+bool test_stream_serialization() {
+  bool ok = true;
+  uint32_t n = 5000;
+  uint8_t *leaves = malloc(n * hash_size);
+  for (uint32_t i = 0; i < n * hash_size; i++)
+    leaves[i] = (uint8_t)(i * 5 + 7);
+
+  mt_p mt = mt_create(leaves);
+  mt_insert_batch(mt, leaves + hash_size, 1233);
+  mt_flush_to(mt, 100);
+
+  // The full stream has the same bytes as mt_serialize.
+  uint64_t sz = mt_serialize_size(mt);
+  uint8_t *flat = malloc(sz);
+  mem_stream s = { malloc(2 * sz), 0, 0, 2 * sz, UINT64_MAX };
+  ok = ok && mt_serialize(mt, flat, sz) == sz;
+  ok = ok && mt_serialize_stream(mt, mem_write, &s) == sz;
+  ok = ok && s.len == sz && memcmp(s.buf, flat, sz) == 0;
+
+  mt_p base = mt_deserialize_stream(mem_read, &s, mt_sha256_compress);
+  ok = ok && base != NULL && s.pos == sz && same_paths(mt, base, 100, 1234);
+  printf("Stream serialization: %s\n", ok ? "Success!" : "**FAILED**");
+
+  // Deltas: insertions and a flush on the writer, applied to the checkpoint.
+  uint64_t since = 1234;
+  for (uint32_t round = 0; ok && round < 3; round++) {
+    uint32_t from = (uint32_t)since, m = round == 0 ? 1 : round == 1 ? 777 : 2000;
+    for (uint32_t i = 0; i < m; i++) {
+      uint8_t *h = mt_init_hash(hash_size);
+      memcpy(h, leaves + (from + i) * hash_size, hash_size);
+      mt_insert(mt, h);
+      mt_free_hash(h);
+    }
+    uint64_t flushed = 100 + round * 400;
+    if (round > 0)
+      mt_flush_to(mt, flushed);
+    else
+      flushed = 100;
+
+    s.len = s.pos = 0;
+    ok = ok && mt_serialize_delta_pre(mt, since);
+    uint64_t dsz = ok ? mt_serialize_delta(mt, since, mem_write, &s) : 0;
+    ok = ok && dsz == s.len && dsz > 0;
+    // Only new nodes are written: about two hashes per inserted leaf.
+    ok = ok && dsz < mt_serialize_size(mt) && dsz < (2 * m + 64) * (hash_size + 1) + 64;
+
+    // A truncated delta fails and leaves the tree unchanged.
+    s.limit = dsz - hash_size - 1;
+    ok = ok && !mt_deserialize_delta(base, mem_read, &s);
+    ok = ok && same_paths(base, base, flushed, since);
+    s.pos = 0;
+    s.limit = UINT64_MAX;
+
+    ok = ok && mt_deserialize_delta(base, mem_read, &s) && s.pos == dsz;
+    since += m;
+    ok = ok && same_paths(mt, base, flushed, since);
+    ok = ok && mt_serialize_size(mt) == mt_serialize_size(base);
+  }
+
+  // Applying a delta to the wrong base fails.
+  s.len = s.pos = 0;
+  ok = ok && mt_serialize_delta(mt, since - 1, mem_write, &s) > 0;
+  ok = ok && !mt_deserialize_delta(base, mem_read, &s);
+  ok = ok && !mt_serialize_delta_pre(mt, since + 1);
+  printf("Delta checkpoints: %s\n", ok ? "Success!" : "**FAILED**");
+
+  // Streaming to and from a file descriptor.
+  char name[] = "/tmp/merkle_tree_test.XXXXXX";
+  int fd = mkstemp(name);
+  ok = ok && fd >= 0;
+  if (fd >= 0) {
+    unlink(name);
+    uint64_t w = mt_serialize_stream(mt, fd_write, &fd);
+    ok = ok && w == mt_serialize_size(mt) && lseek(fd, 0, SEEK_SET) == 0;
+    mt_p mtf = mt_deserialize_stream(fd_read, &fd, mt_sha256_compress);
+    ok = ok && mtf != NULL && same_paths(mt, mtf, 900, since);
+    if (mtf != NULL)
+      mt_free(mtf);
+    close(fd);
+  }
+  printf("Stream serialization (fd): %s\n", ok ? "Success!" : "**FAILED**");
+
+  if (base != NULL)
+    mt_free(base);
+  mt_free(mt);
+  free(s.buf);
+  free(flat);
+  free(leaves);
+  return ok;
+}
+
 int main(int argc, char *argv[]) {
 
   uint64_t num_elts = 1;
@@ -203,6 +564,23 @@ int main(int argc, char *argv[]) {
     mt_free_path(cur_path);
   }
 
+  printf("Testing batch insertion...\n");
+  bool batch_ok = test_insert_batch("default");
+  EverCrypt_AutoConfig2_disable_shaext();
+  batch_ok = batch_ok && test_insert_batch("no shaext");
+  EverCrypt_AutoConfig2_disable_avx2();
+  batch_ok = batch_ok && test_insert_batch("no avx2");
+  EverCrypt_AutoConfig2_disable_avx();
+  batch_ok = batch_ok && test_insert_batch("no avx");
+  EverCrypt_AutoConfig2_init();
+  batch_ok = batch_ok && test_insert_batch_par(1);
+  batch_ok = batch_ok && test_insert_batch_par(4);
+  batch_ok = batch_ok && test_insert_batch_par(7);
+  batch_ok = batch_ok && test_multi_path();
+  batch_ok = batch_ok && test_stream_serialization();
+  if (!batch_ok)
+    return 1;
+
   // Free
   mt_free(mt);
   mt_free_hash(root);
@@ -12,6 +12,7 @@
 #include "Hacl_Poly1305_32.h"
 #include "Hacl_Poly1305_128.h"
 #include "Hacl_Poly1305_256.h"
+#include "Hacl_Poly1305_512.h"
 #include "EverCrypt_AutoConfig2.h"
 
 #include "test_helpers.h"
@@ -40,6 +41,35 @@ bool print_test(int in_len, uint8_t* in, uint8_t* key, uint8_t* exp){
     printf("Poly1305 (256-bit) Result:\n");
     ok = ok && print_result(comp, exp);
   }
+
+  if (EverCrypt_AutoConfig2_has_avx512()) {
+    Hacl_Poly1305_512_poly1305_mac(comp,in_len,in,key);
+    printf("Poly1305 (512-bit) Result:\n");
+    ok = ok && print_result(comp, exp);
+  }
+  return ok;
+}
+
+// Compares the 512-bit implementation with the 32-bit one for all lengths up to
+// a few 128-byte batches, with keys that push the limbs to their maximum.
+bool test_512(void) {
+  uint8_t in[600], key[32], tag[16], exp[16];
+  bool ok = true;
+  for (uint32_t k = 0; k < 3; k++) {
+    for (uint32_t i = 0; i < sizeof in; i++)
+      in[i] = k == 2 ? 0xff : (uint8_t)(i * 29 + k);
+    for (uint32_t i = 0; i < 32; i++)
+      key[i] = k == 2 ? 0xff : (uint8_t)(i * 7 + k);
+    for (uint32_t len = 0; len <= sizeof in; len++) {
+      Hacl_Poly1305_32_poly1305_mac(exp,len,in,key);
+      Hacl_Poly1305_512_poly1305_mac(tag,len,in,key);
+      if (memcmp(tag, exp, 16) != 0) {
+        printf("Poly1305 (512-bit) key %" PRIu32 ", %" PRIu32 " bytes differs\n", k, len);
+        ok = false;
+      }
+    }
+  }
+  printf("Poly1305 (512-bit) lengths: %s\n", ok ? "Success!" : "**FAILED**");
   return ok;
 }
 
@@ -50,6 +80,8 @@ int main() {
   for (int i = 0; i < sizeof(vectors)/sizeof(poly1305_test_vector); ++i) {
     ok &= print_test(vectors[i].input_len,vectors[i].input,vectors[i].key,vectors[i].tag);
   }
+  if (EverCrypt_AutoConfig2_has_avx512())
+    ok &= test_512();
 
   uint8_t plain[SIZE];
   uint8_t key[32];
@@ -113,12 +145,35 @@ int main() {
   clock_t tdiff3 = t2 - t1;
   cycles cdiff3 = b - a;
 
+
+  if (EverCrypt_AutoConfig2_has_avx512()) {
+    memset(plain,'P',SIZE);
+    memset(key,'K',16);
+    for (int j = 0; j < ROUNDS; j++) {
+      Hacl_Poly1305_512_poly1305_mac(plain,SIZE,plain,key);
+    }
+
+    t1 = clock();
+    a = cpucycles_begin();
+    for (int j = 0; j < ROUNDS; j++) {
+      Hacl_Poly1305_512_poly1305_mac(tag,SIZE,plain,key);
+      res ^= tag[0] ^ tag[15];
+    }
+    b = cpucycles_end();
+    t2 = clock();
+  }
+  clock_t tdiff4 = t2 - t1;
+  cycles cdiff4 = b - a;
+
   uint64_t count = ROUNDS * SIZE;
   printf("Poly1305 (32-bit) PERF: %d\n",(int)res); print_time(count,tdiff1,cdiff1);
   printf("Poly1305 (128-bit) PERF:\n"); print_time(count,tdiff2,cdiff2);
   if (EverCrypt_AutoConfig2_has_avx2()) {
     printf("Poly1305 (256-bit) PERF:\n"); print_time(count,tdiff3,cdiff3);
   }
+  if (EverCrypt_AutoConfig2_has_avx512()) {
+    printf("Poly1305 (512-bit) PERF:\n"); print_time(count,tdiff4,cdiff4);
+  }
 
   if (ok) return EXIT_SUCCESS;
   else return EXIT_FAILURE;
@@ -0,0 +1,145 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "EverCrypt_AutoConfig2.h"
+#include "EverCrypt_Hash.h"
+#include "Hacl_Hash.h"
+
+#include "test_helpers.h"
+
+#define MAX_MSGS 41
+#define ROUNDS   4096
+
+typedef void (*multi_fn)(uint32_t n, uint8_t **inputs, uint32_t *lens, uint8_t **dst);
+typedef void (*hash_fn)(uint8_t *input, uint32_t len, uint8_t *dst);
+
+// Hashes batches of messages whose lengths cross the one- and two-block
+// padding boundaries, and compares with the single-message implementation.
+static bool test_multi(const char *alg, const char *name, multi_fn f, hash_fn ref, uint32_t hlen,
+  uint32_t bsize)
+{
+  uint8_t *buf = malloc(MAX_MSGS * 300);
+  uint8_t *inputs[MAX_MSGS], *dst[MAX_MSGS];
+  uint8_t out[MAX_MSGS * 64], exp[64];
+  uint32_t lens[MAX_MSGS];
+  for (uint32_t i = 0; i < MAX_MSGS * 300; i++)
+    buf[i] = (uint8_t)(i * 31 + 17);
+
+  bool ok = true;
+  uint32_t ns[] = { 0, 1, 2, 3, 4, 5, 8, 9, 16, MAX_MSGS };
+  for (uint32_t t = 0; t < sizeof ns / sizeof ns[0]; t++) {
+    for (uint32_t shape = 0; shape < 3; shape++) {
+      uint32_t n = ns[t];
+      for (uint32_t i = 0; i < n; i++) {
+        // Equal lengths, lengths around the padding boundaries, and widely
+        // varying lengths.
+        lens[i] = shape == 0 ? bsize : shape == 1 ? bsize - 20 + (i * 3) % 24 : (i * 97 + t * 13) % 300;
+        inputs[i] = buf + i * 300;
+        dst[i] = out + i * hlen;
+      }
+      memset(out, 0, sizeof out);
+      f(n, inputs, lens, dst);
+      for (uint32_t i = 0; i < n; i++) {
+        ref(inputs[i], lens[i], exp);
+        if (memcmp(exp, dst[i], hlen) != 0) {
+          printf("%s multi (%s) message %" PRIu32 "/%" PRIu32 " (%" PRIu32 " bytes) differs\n",
+            alg, name, i, n, lens[i]);
+          ok = false;
+        }
+      }
+    }
+  }
+  printf("%s multi (%s): %s\n", alg, name, ok ? "Success!" : "**FAILED**");
+  free(buf);
+  return ok;
+}
+
+static void bench(Spec_Hash_Definitions_hash_alg a, const char *name, bool multi, uint32_t n,
+  uint32_t len)
+{
+  uint8_t *buf = malloc(n * len);
+  uint8_t *out = malloc(n * 64);
+  uint8_t *inputs[64], *dst[64];
+  uint32_t lens[64];
+  memset(buf, 'P', n * len);
+  for (uint32_t i = 0; i < n; i++) {
+    inputs[i] = buf + i * len;
+    dst[i] = out + i * 64;
+    lens[i] = len;
+  }
+
+  cycles c0, c1;
+  clock_t t1, t2;
+  uint32_t rounds = ROUNDS * 64 / len;
+  t1 = clock();
+  c0 = cpucycles_begin();
+  for (uint32_t r = 0; r < rounds; r++) {
+    if (multi)
+      EverCrypt_Hash_hash_multi(a, n, inputs, lens, dst);
+    else
+      for (uint32_t i = 0; i < n; i++)
+        EverCrypt_Hash_hash(a, dst[i], inputs[i], lens[i]);
+  }
+  c1 = cpucycles_end();
+  t2 = clock();
+  printf("%s %s, %s, %" PRIu32 " x %" PRIu32 " bytes PERF:\n", EverCrypt_Hash_string_of_alg(a),
+    name, multi ? "hash_multi" : "hash", n, len);
+  print_time((uint64_t)rounds * n * len, t2 - t1, c1 - c0);
+  free(buf);
+  free(out);
+}
+
+static void bench_all(const char *name) {
+  Spec_Hash_Definitions_hash_alg algs[] = { Spec_Hash_Definitions_SHA2_256, Spec_Hash_Definitions_SHA2_512 };
+  uint32_t lens[] = { 64, 1024 };
+  for (uint32_t a = 0; a < 2; a++)
+    for (uint32_t i = 0; i < 2; i++) {
+      bench(algs[a], name, false, 64, lens[i]);
+      bench(algs[a], name, true, 64, lens[i]);
+    }
+}
+
+static bool test_all(const char *name, bool direct) {
+  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
+  bool avx = EverCrypt_AutoConfig2_has_avx();
+  bool ok = true;
+  ok &= test_multi("SHA2-256", name, EverCrypt_Hash_hash_256_multi, Hacl_Hash_SHA2_hash_256, 32, 64);
+  ok &= test_multi("SHA2-384", name, EverCrypt_Hash_hash_384_multi, Hacl_Hash_SHA2_hash_384, 48, 128);
+  ok &= test_multi("SHA2-512", name, EverCrypt_Hash_hash_512_multi, Hacl_Hash_SHA2_hash_512, 64, 128);
+  if (direct && avx2) {
+    ok &= test_multi("SHA2-256", "vec256", Hacl_SHA2_Vec256_sha256_multi, Hacl_Hash_SHA2_hash_256, 32, 64);
+    ok &= test_multi("SHA2-384", "vec256", Hacl_SHA2_Vec256_sha384_multi, Hacl_Hash_SHA2_hash_384, 48, 128);
+    ok &= test_multi("SHA2-512", "vec256", Hacl_SHA2_Vec256_sha512_multi, Hacl_Hash_SHA2_hash_512, 64, 128);
+  }
+  if (direct && avx) {
+    ok &= test_multi("SHA2-256", "vec128", Hacl_SHA2_Vec128_sha256_multi, Hacl_Hash_SHA2_hash_256, 32, 64);
+    ok &= test_multi("SHA2-384", "vec128", Hacl_SHA2_Vec128_sha384_multi, Hacl_Hash_SHA2_hash_384, 48, 128);
+    ok &= test_multi("SHA2-512", "vec128", Hacl_SHA2_Vec128_sha512_multi, Hacl_Hash_SHA2_hash_512, 64, 128);
+  }
+  return ok;
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+
+  bool ok = test_all("default", true);
+  bench_all("default");
+
+  // Without SHA extensions, EverCrypt_Hash_hash_256_multi switches to the
+  // vectorized engines.
+  EverCrypt_AutoConfig2_disable_shaext();
+  ok &= test_all("no shaext", false);
+  bench_all("no shaext");
+  EverCrypt_AutoConfig2_disable_avx2();
+  ok &= test_all("no avx2", false);
+  bench_all("no avx2");
+  EverCrypt_AutoConfig2_disable_avx();
+  ok &= test_all("no avx", false);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}